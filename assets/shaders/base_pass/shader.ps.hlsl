@@ -1,3 +1,9 @@
+// Alpha handling is selected by the including variant:
+// ALPHA_MODE_MASK - alpha test with discard, ALPHA_MODE_BLEND - alpha is written for blending
+// (neither - opaque, alpha ignored)
+
+#include "../bindless_material.hlsli"
+
 #define PI 3.14159265
 
 struct PSInput
@@ -9,6 +15,7 @@ struct PSInput
     float3 Bitangent : BITANGENT4;
     float4 Color : COLOR5;
     float3 WorldPos : TEXCOORD0;
+    nointerpolation uint MaterialIndex : MATERIAL_INDEX;
 };
 
 struct ViewUniformBuffer
@@ -67,22 +74,7 @@ StructuredBuffer<DirectionalLightData> directionalLights : register(t1, space2);
 StructuredBuffer<PointLightData> pointLights : register(t2, space2);
 StructuredBuffer<SpotLightData> spotLights : register(t3, space2);
 
-struct MaterialParams
-{
-    float4 baseColor;
-    float metallic;
-    float roughness;
-    float opacity;
-    float padding;
-};
-cbuffer MaterialBuffer : register(b0, space3)
-{
-    MaterialParams material;
-}
-
-Texture2D<float4> DiffuseTexture : register(t1, space3);
-Texture2D<float4> NormalTexture : register(t2, space3);
-Texture2D<float4> MetallicRoughnessTexture : register(t3, space3);
+BINDLESS_MATERIAL_TABLE(space3);
 SamplerState DefaultSampler : register(s0, space4);
 
 float D_GGX(float3 N, float3 H, float roughness)
@@ -205,17 +197,21 @@ float3 CalcSpot(SpotLightData light, float3 N, float3 V, float3 worldPos,
 // PBR
 float4 main(PSInput input) : SV_TARGET
 {
-    float4 diffuseSample = DiffuseTexture.Sample(DefaultSampler, input.TexCoord);
-    float3 albedo = diffuseSample.rgb * material.baseColor.rgb;
-    float alpha = diffuseSample.a * material.opacity;
-    
-    clip(alpha - 0.1);
-    
-    float2 mr = MetallicRoughnessTexture.Sample(DefaultSampler, input.TexCoord).gb;
-    float roughness = saturate(mr.x * material.roughness);
-    float metallic = saturate(mr.y * material.metallic);
-
-    float3 Nmap = NormalTexture.Sample(DefaultSampler, input.TexCoord).rgb * 2.0 - 1.0;
+    MaterialRecord material = Materials[input.MaterialIndex];
+
+    float4 diffuseSample = SAMPLE_MATERIAL_TEXTURE(material.AlbedoTexture, DefaultSampler, input.TexCoord);
+    float3 albedo = diffuseSample.rgb * material.BaseColor.rgb;
+    float alpha = diffuseSample.a * material.Opacity;
+
+#if defined(ALPHA_MODE_MASK)
+    clip(alpha - material.AlphaCutoff);
+#endif
+
+    float2 mr = SAMPLE_MATERIAL_TEXTURE(material.MetallicRoughnessTexture, DefaultSampler, input.TexCoord).gb;
+    float roughness = saturate(mr.x * material.Roughness);
+    float metallic = saturate(mr.y * material.Metallic);
+
+    float3 Nmap = SAMPLE_MATERIAL_TEXTURE(material.NormalTexture, DefaultSampler, input.TexCoord).rgb * 2.0 - 1.0;
     float3 T = normalize(input.Tangent);
     float3 B = normalize(input.Bitangent);
     float3 N = normalize(input.Normal);
@@ -240,6 +236,10 @@ float4 main(PSInput input) : SV_TARGET
 
     color += albedo * 0.03;
 
-    return float4(color, material.opacity);
+#if defined(ALPHA_MODE_BLEND)
+    return float4(color, alpha);
+#else
+    return float4(color, 1.0);
+#endif
 }
 
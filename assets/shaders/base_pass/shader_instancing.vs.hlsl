@@ -1,14 +1,14 @@
 #include "../shader_semantics.hlsli"
+#include "../push_constants.hlsli"
 
 struct VSInput
 {
-    VERTEX_ATTR(POSITION,  float3,   Position);
-    VERTEX_ATTR(TEXCOORD,  float2,   TexCoord);
-    VERTEX_ATTR(NORMAL,    float3,   Normal);
-    VERTEX_ATTR(TANGENT,   float3,   Tangent);
-    VERTEX_ATTR(BITANGENT, float3,   Bitangent);
-    VERTEX_ATTR(COLOR,     float4,   Color);
-    VERTEX_ATTR(INSTANCE,  float4x4, Instance);
+    VERTEX_ATTR(POSITION,  float3, Position);
+    VERTEX_ATTR(TEXCOORD,  float2, TexCoord);
+    VERTEX_ATTR(NORMAL,    float3, Normal);
+    VERTEX_ATTR(TANGENT,   float3, Tangent);
+    VERTEX_ATTR(BITANGENT, float3, Bitangent);
+    VERTEX_ATTR(COLOR,     float4, Color);
 };
 
 struct ViewUniformBuffer
@@ -28,14 +28,26 @@ cbuffer ViewParam : register(b0, space0)
     ViewUniformBuffer ViewParam;
 }
 
-struct ModelUniformBuffer
+// Columns of the row-vector world matrix and of its normal matrix (see InstanceTransform on the C++ side),
+// Normal[0].w holds the bindless material index of the instance
+struct InstanceTransform
 {
-    float4x4 ModelMatrix;
+    float4 World[3];
+    float4 Normal[3];
 };
-cbuffer ModelParam : register(b0, space1)
+StructuredBuffer<InstanceTransform> InstanceTransforms : register(t0, space1);
+
+// Indices into InstanceTransforms - identity for CPU-built draws, the compacted visible instances of each draw
+// when GPU culling produced the draw arguments
+StructuredBuffer<uint> InstanceIndices : register(t1, space1);
+
+// Start of the draw's instance range in InstanceIndices. Indirect draws push 0 - the offset comes with the
+// draw arguments: DirectX writes it into InstanceOffset, Vulkan adds it to SV_InstanceID as firstInstance
+struct DrawConstants
 {
-    ModelUniformBuffer ModelParam;
-}
+    uint InstanceOffset;
+};
+PUSH_CONSTANTS(DrawConstants, DrawParam);
 
 struct VSOutput
 {
@@ -46,41 +58,41 @@ struct VSOutput
     float3 Bitangent : BITANGENT4;
     float4 Color : COLOR5;
     float3 WorldPos : TEXCOORD0; 
+    nointerpolation uint MaterialIndex : MATERIAL_INDEX;
 };
 
-VSOutput main(VSInput input)
+VSOutput main(VSInput input, uint instanceId : SV_InstanceID)
 {
     VSOutput output = (VSOutput) 0;
 
-#ifdef __spirv__
-    float4x4 worldMatrix = mul(ModelParam.ModelMatrix, input.Instance);
-    float4 worldPos = mul(float4(input.Position, 1.0), worldMatrix);
-#else
-    float4x4 worldMatrix = mul(input.Instance, ModelParam.ModelMatrix);
-    float4 worldPos = mul(worldMatrix, float4(input.Position, 1.0));
-#endif
+    InstanceTransform instance = InstanceTransforms[InstanceIndices[DrawParam.InstanceOffset + instanceId]];
+
+    // dot products do not depend on the API matrix layout, so no __spirv__ branch is needed
+    precise float4 localPos = float4(input.Position, 1.0);
+    precise float4 worldPos = float4(dot(localPos, instance.World[0]),
+                                     dot(localPos, instance.World[1]),
+                                     dot(localPos, instance.World[2]),
+                                     1.0);
 
     output.WorldPos = worldPos.xyz;
 
-    output.Position = mul(ViewParam.VP, worldPos);
+    // precise: must match the depth pre-pass bit for bit (depth EQUAL test)
+    precise float4 clipPos = mul(ViewParam.VP, worldPos);
+    output.Position = clipPos;
 
-    float3x3 normalMat =
-    {
-        normalize(worldMatrix[0].xyz),
-        normalize(worldMatrix[1].xyz),
-        normalize(worldMatrix[2].xyz)
-    };
-#ifdef __spirv__
-    output.Normal    = normalize(mul(input.Normal,    normalMat));
-    output.Tangent   = normalize(mul(input.Tangent,   normalMat));
-    output.Bitangent = normalize(mul(input.Bitangent, normalMat));
-#else
-    output.Normal = normalize(mul(normalMat, input.Normal));
-    output.Tangent = normalize(mul(normalMat, input.Tangent));
-    output.Bitangent = normalize(mul(normalMat, input.Bitangent));
-#endif
+    // tangent frame follows the world matrix, the normal its inverse transpose (correct under non-uniform scale)
+    output.Normal = normalize(float3(dot(input.Normal, instance.Normal[0].xyz),
+                                     dot(input.Normal, instance.Normal[1].xyz),
+                                     dot(input.Normal, instance.Normal[2].xyz)));
+    output.Tangent = normalize(float3(dot(input.Tangent, instance.World[0].xyz),
+                                      dot(input.Tangent, instance.World[1].xyz),
+                                      dot(input.Tangent, instance.World[2].xyz)));
+    output.Bitangent = normalize(float3(dot(input.Bitangent, instance.World[0].xyz),
+                                        dot(input.Bitangent, instance.World[1].xyz),
+                                        dot(input.Bitangent, instance.World[2].xyz)));
 
     output.TexCoord = input.TexCoord;
     output.Color = input.Color;
+    output.MaterialIndex = asuint(instance.Normal[0].w);
     return output;
 }
@@ -0,0 +1,2 @@
+#define ALPHA_MODE_MASK
+#include "shader.ps.hlsl"
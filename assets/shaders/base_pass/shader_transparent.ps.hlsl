@@ -0,0 +1,2 @@
+#define ALPHA_MODE_BLEND
+#include "shader.ps.hlsl"
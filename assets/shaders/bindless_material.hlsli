@@ -0,0 +1,31 @@
+#ifndef BINDLESS_MATERIAL_HLSLI
+#define BINDLESS_MATERIAL_HLSLI
+
+// Bindless material table - one set with all material records and textures (BindlessMaterialTable on the C++ side)
+// The material index of an instance comes from the instance transform, records reference textures by index.
+// Instances of one draw may use different materials, so texture indices are non-uniform
+
+#define BINDLESS_TEXTURE_CAPACITY 1024  // must match rhi::kMaxBindlessDescriptors
+
+struct MaterialRecord
+{
+    float4 BaseColor;
+    float Metallic;
+    float Roughness;
+    float Opacity;
+    float AlphaCutoff;
+    uint AlbedoTexture;
+    uint NormalTexture;
+    uint MetallicRoughnessTexture;
+    uint Padding;
+};
+
+// The table is a descriptor set of its own, space is the set index used by the pass
+#define BINDLESS_MATERIAL_TABLE(space) \
+    StructuredBuffer<MaterialRecord> Materials : register(t0, space); \
+    Texture2D<float4> MaterialTextures[BINDLESS_TEXTURE_CAPACITY] : register(t1, space)
+
+#define SAMPLE_MATERIAL_TEXTURE(textureIndex, samplerState, uv) \
+    MaterialTextures[NonUniformResourceIndex(textureIndex)].Sample(samplerState, uv)
+
+#endif // BINDLESS_MATERIAL_HLSLI
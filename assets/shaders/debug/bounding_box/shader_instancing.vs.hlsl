@@ -47,15 +47,6 @@ cbuffer ViewParam : register(b0, space0)
     ViewUniformBuffer ViewParam;
 }
 
-struct ModelUniformBuffer
-{
-    float4x4 ModelMatrix;
-};
-cbuffer ModelParam : register(b0, space1)
-{
-    ModelUniformBuffer ModelParam;
-}
-
 struct VSOutput
 {
     float4 Position : SV_POSITION;
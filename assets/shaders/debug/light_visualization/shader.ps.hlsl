@@ -53,19 +53,19 @@ struct SpotLightData
     float padding3;
 };
 
-cbuffer LightCounts : register(b0, space2)
+cbuffer LightCounts : register(b0, space1)
 {
     uint directionalLightCount;
     uint pointLightCount;
     uint spotLightCount;
     uint padding;
 }
-StructuredBuffer<DirectionalLightData> directionalLights : register(t1, space2);
-StructuredBuffer<PointLightData> pointLights : register(t2, space2);
-StructuredBuffer<SpotLightData> spotLights : register(t3, space2);
+StructuredBuffer<DirectionalLightData> directionalLights : register(t1, space1);
+StructuredBuffer<PointLightData> pointLights : register(t2, space1);
+StructuredBuffer<SpotLightData> spotLights : register(t3, space1);
 
-Texture2D<float4> NormalTexture : register(t0, space3);
-SamplerState DefaultSampler : register(s0, space4);
+Texture2D<float4> NormalTexture : register(t0, space2);
+SamplerState DefaultSampler : register(s0, space3);
 
 float4 main(PSInput input) : SV_TARGET
 {
@@ -1,4 +1,5 @@
 #include "../../shader_semantics.hlsli"
+#include "../../push_constants.hlsli"
 
 struct VSInput
 {
@@ -24,14 +25,11 @@ cbuffer ViewParam : register(b0, space0)
     ViewUniformBuffer ViewParam;
 }
 
-struct ModelUniformBuffer
+struct ModelConstants
 {
     float4x4 ModelMatrix;
 };
-cbuffer ModelParam : register(b0, space1)
-{
-    ModelUniformBuffer ModelParam;
-}
+PUSH_CONSTANTS(ModelConstants, ModelParam);
 
 struct HighlightParamsBuffer
 {
@@ -39,7 +37,7 @@ struct HighlightParamsBuffer
     float Thickness;
     float3 Padding;
 };
-cbuffer HighlightParams : register(b0, space2)
+cbuffer HighlightParams : register(b0, space1)
 {
     HighlightParamsBuffer HighlightParams;
 }
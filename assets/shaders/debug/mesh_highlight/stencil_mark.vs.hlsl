@@ -1,5 +1,6 @@
 
 #include "../../shader_semantics.hlsli"
+#include "../../push_constants.hlsli"
 
 struct VSInput
 {
@@ -25,14 +26,11 @@ cbuffer ViewParam : register(b0, space0)
     ViewUniformBuffer ViewParam;
 }
 
-struct ModelUniformBuffer
+struct ModelConstants
 {
     float4x4 ModelMatrix;
 };
-cbuffer ModelParam : register(b0, space1)
-{
-    ModelUniformBuffer ModelParam;
-}
+PUSH_CONSTANTS(ModelConstants, ModelParam);
 
 struct VSOutput
 {
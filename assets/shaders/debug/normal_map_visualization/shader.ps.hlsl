@@ -7,9 +7,9 @@ struct PSInput
     float3 Bitangent : BITANGENT4;
 };
 
-Texture2D<float4> NormalTexture : register(t0, space2);
+Texture2D<float4> NormalTexture : register(t0, space1);
 
-SamplerState DefaultSampler : register(s0, space3);
+SamplerState DefaultSampler : register(s0, space2);
 
 float4 main(PSInput input) : SV_TARGET
 {
@@ -1,3 +1,5 @@
+#include "../../push_constants.hlsli"
+
 struct ViewUniformBuffer
 {
     float4x4 V;
@@ -15,15 +17,11 @@ cbuffer ViewParam : register(b0, space0)
     ViewUniformBuffer ViewParam;
 }
 
-struct ModelUniformBuffer
+struct ModelConstants
 {
     float4x4 ModelMatrix;
 };
-
-cbuffer ModelParam : register(b0, space1)
-{
-    ModelUniformBuffer ModelParam;
-}
+PUSH_CONSTANTS(ModelConstants, ModelParam);
 
 #include "../../shader_semantics.hlsli"
 
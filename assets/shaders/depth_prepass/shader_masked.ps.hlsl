@@ -0,0 +1,20 @@
+#include "../bindless_material.hlsli"
+
+struct PSInput
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD1;
+    nointerpolation uint MaterialIndex : MATERIAL_INDEX;
+};
+
+BINDLESS_MATERIAL_TABLE(space2);
+SamplerState DefaultSampler : register(s0, space3);
+
+// depth only - discards the same texels as base_pass/shader_masked.ps.hlsl
+void main(PSInput input)
+{
+    MaterialRecord material = Materials[input.MaterialIndex];
+
+    float alpha = SAMPLE_MATERIAL_TEXTURE(material.AlbedoTexture, DefaultSampler, input.TexCoord).a * material.Opacity;
+    clip(alpha - material.AlphaCutoff);
+}
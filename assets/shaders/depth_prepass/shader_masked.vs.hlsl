@@ -0,0 +1,75 @@
+#include "../shader_semantics.hlsli"
+#include "../push_constants.hlsli"
+
+// Alpha-tested variant of the depth pre-pass vertex shader (passes texture coordinates to the clip shader)
+
+struct VSInput
+{
+    VERTEX_ATTR(POSITION,  float3, Position);
+    VERTEX_ATTR(TEXCOORD,  float2, TexCoord);
+};
+
+struct ViewUniformBuffer
+{
+    float4x4 V;
+    float4x4 P;
+    float4x4 VP;
+    float4x4 InvV;
+    float4x4 InvP;
+    float4x4 InvVP;
+    float3 EyeWorld;
+    float padding0;
+};
+
+cbuffer ViewParam : register(b0, space0)
+{
+    ViewUniformBuffer ViewParam;
+}
+
+// Columns of the row-vector world matrix and of its normal matrix (see InstanceTransform on the C++ side),
+// Normal[0].w holds the bindless material index of the instance
+struct InstanceTransform
+{
+    float4 World[3];
+    float4 Normal[3];
+};
+StructuredBuffer<InstanceTransform> InstanceTransforms : register(t0, space1);
+
+// Indices into InstanceTransforms - identity for CPU-built draws, the compacted visible instances of each draw
+// when GPU culling produced the draw arguments
+StructuredBuffer<uint> InstanceIndices : register(t1, space1);
+
+// Start of the draw's instance range in InstanceIndices. Indirect draws push 0 - the offset comes with the
+// draw arguments: DirectX writes it into InstanceOffset, Vulkan adds it to SV_InstanceID as firstInstance
+struct DrawConstants
+{
+    uint InstanceOffset;
+};
+PUSH_CONSTANTS(DrawConstants, DrawParam);
+
+struct VSOutput
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD1;
+    nointerpolation uint MaterialIndex : MATERIAL_INDEX;
+};
+
+VSOutput main(VSInput input, uint instanceId : SV_InstanceID)
+{
+    VSOutput output = (VSOutput) 0;
+
+    InstanceTransform instance = InstanceTransforms[InstanceIndices[DrawParam.InstanceOffset + instanceId]];
+
+    // dot products do not depend on the API matrix layout, so no __spirv__ branch is needed
+    precise float4 localPos = float4(input.Position, 1.0);
+    precise float4 worldPos = float4(dot(localPos, instance.World[0]),
+                                     dot(localPos, instance.World[1]),
+                                     dot(localPos, instance.World[2]),
+                                     1.0);
+
+    precise float4 clipPos = mul(ViewParam.VP, worldPos);
+    output.Position = clipPos;
+    output.TexCoord = input.TexCoord;
+    output.MaterialIndex = asuint(instance.Normal[0].w);
+    return output;
+}
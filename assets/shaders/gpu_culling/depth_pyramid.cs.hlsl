@@ -0,0 +1,66 @@
+#include "../push_constants.hlsli"
+
+// Depth pyramid for occlusion culling (GpuCulling on the C++ side) - every texel holds the farthest depth of the
+// texels it covers. Mips are stored one after another in one buffer, mip 0 has half the depth buffer resolution.
+// One dispatch writes one mip: the first reads the depth buffer, the others the previous mip
+
+Texture2D<float> DepthTexture : register(t0, space0);
+RWStructuredBuffer<float> DepthPyramid : register(u1, space0);
+
+struct PyramidConstants
+{
+    uint SrcOffset;          // first texel of the source mip in DepthPyramid (unused for the depth buffer)
+    uint SrcWidth;
+    uint SrcHeight;
+    uint DstOffset;
+    uint DstWidth;
+    uint DstHeight;
+    uint FromDepthTexture;
+    uint Padding;
+};
+PUSH_CONSTANTS(PyramidConstants, PyramidParam);
+
+float LoadSource(uint2 texel)
+{
+    if (PyramidParam.FromDepthTexture != 0)
+    {
+        return DepthTexture.Load(int3(texel, 0));
+    }
+
+    return DepthPyramid[PyramidParam.SrcOffset + texel.y * PyramidParam.SrcWidth + texel.x];
+}
+
+[numthreads(8, 8, 1)]
+void main(uint3 dispatchId : SV_DispatchThreadID)
+{
+    if (dispatchId.x >= PyramidParam.DstWidth || dispatchId.y >= PyramidParam.DstHeight)
+    {
+        return;
+    }
+
+    // 2x2 footprint, the last row / column also covers the texel an odd source size leaves over
+    uint2 srcSize = uint2(PyramidParam.SrcWidth, PyramidParam.SrcHeight);
+    uint2 first   = dispatchId.xy * 2;
+    uint2 last    = min(first + 1, srcSize - 1);
+
+    if (dispatchId.x == PyramidParam.DstWidth - 1)
+    {
+        last.x = srcSize.x - 1;
+    }
+
+    if (dispatchId.y == PyramidParam.DstHeight - 1)
+    {
+        last.y = srcSize.y - 1;
+    }
+
+    float maxDepth = 0.0;
+    for (uint y = first.y; y <= last.y; ++y)
+    {
+        for (uint x = first.x; x <= last.x; ++x)
+        {
+            maxDepth = max(maxDepth, LoadSource(uint2(x, y)));
+        }
+    }
+
+    DepthPyramid[PyramidParam.DstOffset + dispatchId.y * PyramidParam.DstWidth + dispatchId.x] = maxDepth;
+}
@@ -0,0 +1,156 @@
+// Instance culling for the indirect base pass (GpuCulling on the C++ side). One thread per instance tests its world
+// bounds against the view frustum and the depth pyramid of the previous frame. Visible instances are appended to the
+// draw of their batch: the instance count of the draw arguments is bumped atomically and the instance index is
+// written to the draw's range of VisibleInstances, which the vertex shaders read as InstanceIndices
+
+#define CULL_GROUP_SIZE 64
+#define MAX_PYRAMID_MIPS 16                  // must match GpuCulling::kMaxPyramidMips
+#define INVALID_PACKET 0xFFFFFFFF            // batch is not drawn this frame
+#define CULL_INSTANCE_ALWAYS_VISIBLE 1       // instance without valid bounds
+
+struct CullConstants
+{
+    float4 FrustumPlanes[6];                 // inside: dot(plane.xyz, p) + plane.w >= 0
+    float4x4 PyramidViewProjection;          // view projection of the frame the pyramid was built from
+    uint InstanceCount;
+    uint OcclusionEnabled;
+    uint PyramidMipCount;
+    uint Padding0;
+    uint2 DepthSize;                         // resolution of the depth buffer the pyramid was built from
+    uint2 Padding1;
+    uint4 PyramidMips[MAX_PYRAMID_MIPS];     // x - first texel in DepthPyramid, y / z - size of the mip
+};
+
+cbuffer CullParam : register(b0, space0)
+{
+    CullConstants CullParam;
+}
+
+struct CullInstance
+{
+    float3 Center;
+    uint BatchIndex;
+    float3 Extents;
+    uint Flags;
+};
+
+// DrawIndexedIndirectCommand on the C++ side
+struct DrawArguments
+{
+    uint DrawConstant;
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int VertexOffset;
+    uint FirstInstance;
+};
+
+StructuredBuffer<CullInstance> CullInstances : register(t0, space1);
+StructuredBuffer<uint> BatchPackets : register(t1, space1);
+StructuredBuffer<float> DepthPyramid : register(t2, space1);
+RWStructuredBuffer<DrawArguments> DrawArgs : register(u3, space1);
+RWStructuredBuffer<uint> VisibleInstances : register(u4, space1);
+
+bool IsInsideFrustum(float3 center, float3 extents)
+{
+    [unroll]
+    for (uint i = 0; i < 6; ++i)
+    {
+        float4 plane = CullParam.FrustumPlanes[i];
+        if (dot(plane.xyz, center) + dot(abs(plane.xyz), extents) + plane.w < 0.0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IsOccluded(float3 center, float3 extents)
+{
+    float3 ndcMin = float3(1.0e30, 1.0e30, 1.0e30);
+    float3 ndcMax = -ndcMin;
+
+    [unroll]
+    for (uint corner = 0; corner < 8; ++corner)
+    {
+        float3 direction = float3((corner & 1) ? 1.0 : -1.0, (corner & 2) ? 1.0 : -1.0, (corner & 4) ? 1.0 : -1.0);
+        float4 clipPos   = mul(CullParam.PyramidViewProjection, float4(center + extents * direction, 1.0));
+
+        // the box crosses the camera plane of the pyramid view, its screen rectangle is unbounded
+        if (clipPos.w <= 0.0)
+        {
+            return false;
+        }
+
+        float3 ndc = clipPos.xyz / clipPos.w;
+        ndcMin     = min(ndcMin, ndc);
+        ndcMax     = max(ndcMax, ndc);
+    }
+
+    // NDC y points up, texel rows go down
+    float2 uvMin = saturate(float2(ndcMin.x, -ndcMax.y) * 0.5 + 0.5);
+    float2 uvMax = saturate(float2(ndcMax.x, -ndcMin.y) * 0.5 + 0.5);
+
+    uint2 firstPixel = min(uint2(uvMin * CullParam.DepthSize), CullParam.DepthSize - 1);
+    uint2 lastPixel  = min(uint2(uvMax * CullParam.DepthSize), CullParam.DepthSize - 1);
+
+    // texel x of mip m covers depth pixels from x << (m + 1) on, the mip is chosen so the box covers at most 2x2
+    uint2 span  = lastPixel - firstPixel + 1;
+    uint  mip   = (uint)max(ceil(log2((float)max(span.x, span.y))) - 1.0, 0.0);
+    mip         = min(mip, CullParam.PyramidMipCount - 1);
+
+    uint4 level     = CullParam.PyramidMips[mip];
+    uint2 levelSize = level.yz;
+    uint2 first     = min(firstPixel >> (mip + 1), levelSize - 1);
+    uint2 last      = min(lastPixel >> (mip + 1), levelSize - 1);
+
+    float maxDepth = 0.0;
+    for (uint y = first.y; y <= last.y; ++y)
+    {
+        for (uint x = first.x; x <= last.x; ++x)
+        {
+            maxDepth = max(maxDepth, DepthPyramid[level.x + y * levelSize.x + x]);
+        }
+    }
+
+    // nearest point of the box is behind everything that was drawn there
+    return ndcMin.z > maxDepth;
+}
+
+[numthreads(CULL_GROUP_SIZE, 1, 1)]
+void main(uint3 dispatchId : SV_DispatchThreadID)
+{
+    uint instanceIndex = dispatchId.x;
+    if (instanceIndex >= CullParam.InstanceCount)
+    {
+        return;
+    }
+
+    CullInstance instance = CullInstances[instanceIndex];
+
+    uint packet = BatchPackets[instance.BatchIndex];
+    if (packet == INVALID_PACKET)
+    {
+        return;
+    }
+
+    if ((instance.Flags & CULL_INSTANCE_ALWAYS_VISIBLE) == 0)
+    {
+        if (!IsInsideFrustum(instance.Center, instance.Extents))
+        {
+            return;
+        }
+
+        if (CullParam.OcclusionEnabled != 0 && IsOccluded(instance.Center, instance.Extents))
+        {
+            return;
+        }
+    }
+
+    uint slot;
+    InterlockedAdd(DrawArgs[packet].InstanceCount, 1, slot);
+
+    // FirstInstance is the start of the batch's instance range, the range has room for every instance of the batch
+    VisibleInstances[DrawArgs[packet].FirstInstance + slot] = instanceIndex;
+}
@@ -0,0 +1,13 @@
+#ifndef PUSH_CONSTANTS_HLSLI
+#define PUSH_CONSTANTS_HLSLI
+
+// Push constants - small per-draw data set with CommandBuffer::pushConstants()
+// One block per pipeline (all stages share it), at most 128 bytes (kMaxPushConstantSize on the C++ side)
+// DirectX uses root constants in a dedicated register space that must match kPushConstantRegisterSpace
+#ifdef __spirv__
+  #define PUSH_CONSTANTS(type, name) [[vk::push_constant]] ConstantBuffer<type> name
+#else
+  #define PUSH_CONSTANTS(type, name) ConstantBuffer<type> name : register(b0, space100)
+#endif
+
+#endif // PUSH_CONSTANTS_HLSLI
@@ -41,6 +41,9 @@
 #include "utils/material/material_loader_manager.h"
 #include "utils/material/material_manager.h"
 #include "utils/math/math_util.h"
+#include "utils/memory/allocation_tracker.h"
+#include "utils/memory/heap_allocation_counter.h"
+#include "utils/memory/linear_allocator.h"
 #include "utils/model/mesh_manager.h"
 #include "utils/model/model_manager.h"
 #include "utils/model/render_geometry_mesh_manager.h"
@@ -90,6 +93,11 @@ Engine::~Engine() {
   ServiceLocator::s_remove<BufferManager>();
   ServiceLocator::s_remove<gpu::GpuProfiler>();
 
+  // released before the leak report, in the order of member destruction
+  m_editor_.reset();
+  m_renderer_.reset();
+  AllocationTracker::s_reportLeaks();
+
   GlobalLogger::Shutdown();
 }
 
@@ -101,8 +109,9 @@ auto Engine::initialize() -> bool {
   auto consoleLogger = std::make_unique<ConsoleLogger>("console_logger");
   GlobalLogger::AddLogger(std::move(consoleLogger));
 
-  // auto memoryLogger = std::make_unique<MemoryLogger>("memory_logger");
-  // GlobalLogger::AddLogger(std::move(memoryLogger));
+  // entries of the editor log window
+  auto memoryLogger = std::make_unique<MemoryLogger>("memory_logger");
+  GlobalLogger::AddLogger(std::move(memoryLogger));
 
   // auto fileLogger = std::make_unique<FileLogger>("file_logger");
   // GlobalLogger::AddLogger(std::move(fileLogger));
@@ -355,6 +364,9 @@ auto Engine::initialize() -> bool {
   systemManager->addSystem(std::make_unique<ecs::MousePickingSystem>(viewportContext));
   systemManager->addSystem(std::make_unique<ecs::LightSystem>(device, m_renderer_->getResourceManager()));
 
+  config->registerConverter<ecs::SystemBudgets>(&ecs::g_getSystemBudgetsFromConfig);
+  systemManager->setBudgets(config->get<ecs::SystemBudgets>("systemBudgets"));
+
   // editor
   // ------------------------------------------------------------------------
   m_editor_ = std::make_unique<Editor>();
@@ -397,10 +409,16 @@ void Engine::render() {
   CPU_ZONE_NC("Engine::render", color::CYAN);
   auto windowSize = m_window_->getSize();
   if (windowSize.width() == 0 || windowSize.height() == 0 || m_window_->isMinimized()) {
+    // the sleep would show up as a hitch
+    ServiceLocator::s_get<TimingManager>()->getFrameStatistics().discardFrame();
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     return;
   }
 
+  // the fence wait and the submission are separate phases nested in it
+  ScopedFramePhase framePhase(FramePhase::RenderRecord);
+  MemoryTagScope   memoryTag(MemoryTag::Renderer);
+
   if (m_applicationMode == ApplicationMode::Editor) {
     renderEditor_();
   } else {
@@ -430,16 +448,19 @@ void Engine::run() {
 
     {
       CPU_ZONE_N("Event Processing");
+      ScopedFramePhase framePhase(FramePhase::Events);
       processEvents_();
     }
 
     {
       CPU_ZONE_N("Input Processing");
+      ScopedFramePhase framePhase(FramePhase::Update);
       m_application_->processInput();
     }
 
     {
       CPU_ZONE_N("Game Update");
+      ScopedFramePhase framePhase(FramePhase::Update);
       update_(timingManager->getDeltaTime());
     }
 
@@ -447,8 +468,14 @@ void Engine::run() {
 
     frameManager->advanceFrame();
 
+    // transient allocations of the frame are released at once, the heap allocation count of the frame is published
+    g_getFrameAllocator().reset();
+    HeapAllocationCounter::s_endFrame();
+    AllocationTracker::s_endFrame();
+
     PROFILE_PLOT("FPS", timingManager->getFPS());
     PROFILE_PLOT("Frame Time (ms)", timingManager->getFrameTime());
+    PROFILE_PLOT("Heap Allocations", static_cast<int64_t>(HeapAllocationCounter::s_getFrameAllocationCount()));
   }
 }
 
@@ -466,6 +493,7 @@ void Engine::processEvents_() {
 
 void Engine::update_(float deltaTime) {
   if (m_applicationMode == ApplicationMode::Editor) {
+    MemoryTagScope memoryTag(MemoryTag::Editor);
     m_editor_->update(deltaTime);
   }
 
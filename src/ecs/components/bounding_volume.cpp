@@ -72,9 +72,6 @@ BoundingBox transformAABB(const BoundingBox& aabb, const math::Matrix4f<>& trans
     return aabb;
   }
 
-  std::vector<math::Vector3f> transformedCorners;
-  transformedCorners.reserve(8);
-
   std::array<math::Vector3f, 8> corners = {
     {math::Vector3f(aabb.min.x(), aabb.min.y(), aabb.min.z()),
      math::Vector3f(aabb.max.x(), aabb.min.y(), aabb.min.z()),
@@ -86,14 +83,15 @@ BoundingBox transformAABB(const BoundingBox& aabb, const math::Matrix4f<>& trans
      math::Vector3f(aabb.max.x(), aabb.max.y(), aabb.max.z())}
   };
 
-  for (const auto& corner : corners) {
+  // transformed in place, called per instance so it stays off the heap
+  for (auto& corner : corners) {
     math::Vector4f homogeneous(corner.x(), corner.y(), corner.z(), 1.0f);
     math::Vector4f transformed  = homogeneous;
     transformed                *= transform;
-    transformedCorners.emplace_back(transformed.x(), transformed.y(), transformed.z());
+    corner                      = math::Vector3f(transformed.x(), transformed.y(), transformed.z());
   }
 
-  return calculateAABBFromRange(transformedCorners.begin(), transformedCorners.end());
+  return calculateAABBFromRange(corners.begin(), corners.end());
 }
 
 BoundingBox combineAABBs(const std::vector<BoundingBox>& boxes) {
@@ -2,9 +2,12 @@
 #define ARISE_MATERIAL_H
 
 #include "gfx/rhi/interface/texture.h"
+#include "utils/handle/handle.h"
+#include "utils/string_id/string_id_map.h"
 
 #include <math_library/vector.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <unordered_map>
@@ -12,11 +15,23 @@
 namespace arise {
 namespace ecs {
 
+/**
+ * How the base color alpha is interpreted (matches glTF alphaMode)
+ */
+enum class AlphaMode : uint8_t {
+  Opaque,  // alpha ignored
+  Mask,    // alpha tested against alphaCutoff, no blending
+  Blend,   // alpha blended
+};
+
 struct Material {
   std::string materialName;
 
   std::filesystem::path filePath;
 
+  AlphaMode alphaMode   = AlphaMode::Opaque;
+  float     alphaCutoff = 0.5f;
+
   // TODO: consider adding tags to materials (so we can set specific
   // characteristics of material (e.g. "PBR", "transparent", etc.)
   // std::set<std::string> tags;
@@ -28,9 +43,12 @@ struct Material {
   std::unordered_map<std::string, math::Vector4f> vectorParameters;
 
   // Textures associated with the material
-  // Keyed by texture name (e.g., "albedo", "normal")
+  // Keyed by the id of the texture name (e.g., "albedo"_sid, "normal_map"_sid)
   // TODO: consider create enum class and use it as key
-  std::unordered_map<std::string, gfx::rhi::Texture*> textures;
+  StringIdMap<gfx::rhi::Texture*> textures;
+
+  // assigned by MaterialManager, key for per-material data of the renderer (stale once the material is removed)
+  Handle<Material> handle;
 };
 
 }  // namespace ecs
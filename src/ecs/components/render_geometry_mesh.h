@@ -1,6 +1,7 @@
 #ifndef ARISE_RENDER_GEOMETRY_MESH_H
 #define ARISE_RENDER_GEOMETRY_MESH_H
 
+#include "ecs/components/bounding_volume.h"
 #include "gfx/rhi/interface/buffer.h"
 
 #include <cstdint>
@@ -15,6 +16,8 @@ struct RenderGeometryMesh {
   gfx::rhi::Buffer* vertexBuffer;
   gfx::rhi::Buffer* indexBuffer;
 
+  BoundingBox boundingBox = bounds::createInvalid();  // in mesh local space (vertex positions), for GPU culling
+
   // TODO
   // for convenience
   // uint32_t vertexCount = 0;
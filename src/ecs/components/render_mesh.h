@@ -2,8 +2,11 @@
 #define ARISE_RENDER_MESH_H
 
 #include "ecs/components/material.h"
+#include "ecs/components/mesh.h"
 #include "ecs/components/render_geometry_mesh.h"
 
+#include <math_library/matrix.h>
+
 #include <memory>
 
 namespace arise {
@@ -12,7 +15,8 @@ namespace ecs {
 struct RenderMesh {
   RenderGeometryMesh* gpuMesh;
   Material*           material;
-  gfx::rhi::Buffer*   transformMatrixBuffer = nullptr;
+  math::Matrix4f<>    transformMatrix = math::Matrix4f<>::Identity();  // mesh local transform
+  const Mesh*         sourceMesh      = nullptr;  // CPU geometry (software occlusion culling)
 };
 
 }  // namespace ecs
@@ -3,6 +3,7 @@
 
 #include "gfx/rhi/interface/buffer.h"
 #include "render_mesh.h"
+#include "utils/handle/handle.h"
 
 #include <filesystem>
 #include <memory>
@@ -14,6 +15,9 @@ namespace ecs {
 struct RenderModel {
   std::filesystem::path    filePath;
   std::vector<RenderMesh*> renderMeshes;
+
+  // assigned by RenderModelManager, key for per-model data of the renderer (stale once the model is removed)
+  Handle<RenderModel> handle;
 };
 
 }  // namespace ecs
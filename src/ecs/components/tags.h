@@ -10,6 +10,9 @@ struct ModelLoadingTag {
   std::filesystem::path modelPath;
 };
 
+// model is always rendered into the software occlusion buffer, regardless of its screen size
+struct OccluderTag {};
+
 }  // namespace ecs
 }  // namespace arise
 
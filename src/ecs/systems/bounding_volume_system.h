@@ -17,6 +17,8 @@ class BoundingVolumeSystem : public IUpdatableSystem {
 
   void update(Scene* scene, float deltaTime) override;
 
+  const char* getName() const override { return "BoundingVolumeSystem"; }
+
   private:
   void updateEntityWorldBounds_(entt::entity entity, Scene* scene);
 };
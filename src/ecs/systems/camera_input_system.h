@@ -23,6 +23,8 @@ class CameraInputSystem : public IUpdatableSystem {
 
   void update(Scene* scene, float dt) override;
 
+  const char* getName() const override { return "CameraInputSystem"; }
+
   private:
   void handleMovement(const InputActions& actions, Movement& movement, entt::entity entity, Registry& registry);
   void handleMouseLook(MouseInput& mouse, Transform& transform);
@@ -3,6 +3,8 @@
 
 #include "scene/scene.h"
 
+#include <cstdint>
+
 namespace arise {
 namespace ecs {
 
@@ -13,14 +15,48 @@ namespace ecs {
  * - ILifecycleSystem: For systems that manage entity lifecycles
  **/
 
+// how often SystemManager runs a system
+struct UpdateFrequency {
+  enum class Mode : uint8_t {
+    EveryFrame,
+    Interval,    // every count frames, deltaTime is the time since the previous run
+    TimeSliced,  // every frame, one of count slices of the work (IUpdatableSystem::updateSlice)
+  };
+
+  static constexpr UpdateFrequency s_everyFrame() { return UpdateFrequency{}; }
+
+  static constexpr UpdateFrequency s_everyNFrames(uint32_t frames) { return UpdateFrequency{Mode::Interval, frames}; }
+
+  static constexpr UpdateFrequency s_timeSliced(uint32_t slices) { return UpdateFrequency{Mode::TimeSliced, slices}; }
+
+  Mode     mode  = Mode::EveryFrame;
+  uint32_t count = 1;
+};
+
 class IUpdatableSystem {
   public:
   virtual ~IUpdatableSystem() = default;
 
   virtual void update(Scene* scene, float deltaTime) = 0;
+
+  // name in the editor, in the budget warnings and in the "systemBudgets" of the engine settings
+  virtual const char* getName() const = 0;
+
+  // queried every frame
+  virtual UpdateFrequency getUpdateFrequency() const { return UpdateFrequency::s_everyFrame(); }
+
+  /**
+   * Called instead of update() by a TimeSliced system, slice cycles through [0, sliceCount) - one slice per frame.
+   * Runs the whole update on slice 0 by default.
+   */
+  virtual void updateSlice(Scene* scene, float deltaTime, uint32_t slice, uint32_t sliceCount) {
+    if (slice == 0) {
+      update(scene, deltaTime);
+    }
+  }
 };
 
 }  // namespace ecs
 }  // namespace arise
 
-#endif  // ARISE_I_UPDATABLE_SYSTEM_H
\ No newline at end of file
+#endif  // ARISE_I_UPDATABLE_SYSTEM_H
@@ -49,8 +49,8 @@ void LightSystem::collectDirectionalLights_(Scene* scene) {
 
   m_dirLightData.clear();
 
-  bool                             anyLightChanged = false;
-  std::unordered_set<entt::entity> currentEntities;
+  bool anyLightChanged = false;
+  m_currentLightEntities.clear();
 
   for (auto entity : view) {
     auto& light = view.get<Light>(entity);
@@ -74,14 +74,14 @@ void LightSystem::collectDirectionalLights_(Scene* scene) {
     data.padding   = 0.0f;
 
     m_dirLightData.push_back(data);
-    currentEntities.insert(entity);
+    m_currentLightEntities.push_back(entity);
 
     light.isDirty    = false;
     dirLight.isDirty = false;
   }
 
-  bool setChanged        = (m_prevDirLightEntities != currentEntities);
-  m_prevDirLightEntities = std::move(currentEntities);
+  bool setChanged = (m_prevDirLightEntities != m_currentLightEntities);
+  m_prevDirLightEntities.swap(m_currentLightEntities);
 
   m_dirLightsChanged = anyLightChanged || setChanged;
 
@@ -94,8 +94,8 @@ void LightSystem::collectPointLights_(Scene* scene) {
 
   m_pointLightData.clear();
 
-  bool                             anyLightChanged = false;
-  std::unordered_set<entt::entity> currentEntities;
+  bool anyLightChanged = false;
+  m_currentLightEntities.clear();
 
   for (auto entity : view) {
     auto& light = view.get<Light>(entity);
@@ -120,14 +120,14 @@ void LightSystem::collectPointLights_(Scene* scene) {
     data.position  = transform.translation;
 
     m_pointLightData.push_back(data);
-    currentEntities.insert(entity);
+    m_currentLightEntities.push_back(entity);
 
     light.isDirty      = false;
     pointLight.isDirty = false;
   }
 
-  bool setChanged          = (m_prevPointLightEntities != currentEntities);
-  m_prevPointLightEntities = std::move(currentEntities);
+  bool setChanged = (m_prevPointLightEntities != m_currentLightEntities);
+  m_prevPointLightEntities.swap(m_currentLightEntities);
 
   m_pointLightsChanged = anyLightChanged || setChanged;
 
@@ -140,8 +140,8 @@ void LightSystem::collectSpotLights_(Scene* scene) {
 
   m_spotLightData.clear();
 
-  bool                             anyLightChanged = false;
-  std::unordered_set<entt::entity> currentEntities;
+  bool anyLightChanged = false;
+  m_currentLightEntities.clear();
 
   for (auto entity : view) {
     auto& light = view.get<Light>(entity);
@@ -180,14 +180,14 @@ void LightSystem::collectSpotLights_(Scene* scene) {
     data.padding3 = 0.0f;
 
     m_spotLightData.push_back(data);
-    currentEntities.insert(entity);
+    m_currentLightEntities.push_back(entity);
 
     light.isDirty     = false;
     spotLight.isDirty = false;
   }
 
-  bool setChanged         = (m_prevSpotLightEntities != currentEntities);
-  m_prevSpotLightEntities = std::move(currentEntities);
+  bool setChanged = (m_prevSpotLightEntities != m_currentLightEntities);
+  m_prevSpotLightEntities.swap(m_currentLightEntities);
 
   m_spotLightsChanged = anyLightChanged || setChanged;
 
@@ -7,7 +7,6 @@
 #include "gfx/rhi/interface/buffer.h"
 #include "gfx/rhi/interface/descriptor.h"
 
-#include <unordered_set>
 #include <vector>
 
 namespace arise::gfx {
@@ -30,6 +29,8 @@ class LightSystem : public IUpdatableSystem {
   void initialize();
   void update(Scene* scene, float deltaTime) override;
 
+  const char* getName() const override { return "LightSystem"; }
+
   gfx::rhi::DescriptorSet*       getLightDescriptorSet() const { return m_lightDescriptorSet; }
   gfx::rhi::DescriptorSetLayout* getLightDescriptorSetLayout() const { return m_lightLayout; }
 
@@ -96,9 +97,12 @@ class LightSystem : public IUpdatableSystem {
   std::vector<PointLightData>       m_pointLightData;
   std::vector<SpotLightData>        m_spotLightData;
 
-  std::unordered_set<entt::entity> m_prevDirLightEntities;
-  std::unordered_set<entt::entity> m_prevPointLightEntities;
-  std::unordered_set<entt::entity> m_prevSpotLightEntities;
+  // light entities of the previous update in view order (a reordered set counts as changed), vectors so the
+  // per-frame rebuild reuses their capacity
+  std::vector<entt::entity> m_prevDirLightEntities;
+  std::vector<entt::entity> m_prevPointLightEntities;
+  std::vector<entt::entity> m_prevSpotLightEntities;
+  std::vector<entt::entity> m_currentLightEntities;
 
   gfx::rhi::Buffer* m_dirLightBuffer   = nullptr;
   gfx::rhi::Buffer* m_pointLightBuffer = nullptr;
@@ -25,6 +25,8 @@ class MousePickingSystem : public IUpdatableSystem {
 
   void update(Scene* scene, float deltaTime) override;
 
+  const char* getName() const override { return "MousePickingSystem"; }
+
   void setViewportContext(ViewportContext* viewportContext) { m_viewportContext = viewportContext; }
 
   entt::entity handleMousePick(Scene* scene, int mouseX, int mouseY);
@@ -11,6 +11,8 @@ namespace ecs {
 class MovementSystem : public IUpdatableSystem {
   public:
   void update(Scene* scene, float deltaTime) override;
+
+  const char* getName() const override { return "MovementSystem"; }
 };
 
 }  // namespace ecs
@@ -9,6 +9,8 @@ namespace ecs {
 class RenderSystem : public IUpdatableSystem {
   public:
   void update(Scene* scene, float deltaTime) override;
+
+  const char* getName() const override { return "RenderSystem"; }
 };
 
 }  // namespace ecs
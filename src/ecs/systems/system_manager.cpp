@@ -1,16 +1,159 @@
 #include "ecs/systems/system_manager.h"
 
+#include "utils/memory/allocation_tracker.h"
+#include "utils/time/stopwatch.h"
+
+#include <algorithm>
+
 namespace arise {
 namespace ecs {
 
+SystemBudgets g_getSystemBudgetsFromConfig(const ConfigValue& value) {
+  SystemBudgets budgets;
+
+  for (const auto& member : value.GetObject()) {
+    if (!member.value.IsNumber()) {
+      LOG_WARN("Budget of system \"{}\" is not a number", member.name.GetString());
+      continue;
+    }
+    budgets[member.name.GetString()] = member.value.GetFloat();
+  }
+
+  return budgets;
+}
+
 void SystemManager::addSystem(std::unique_ptr<IUpdatableSystem> system) {
-  m_systems_.push_back(std::move(system));
+  SystemEntry entry;
+
+  auto budget = m_budgets_.find(system->getName());
+  if (budget != m_budgets_.end()) {
+    entry.budget = budget->second;
+  }
+
+  entry.system = std::move(system);
+  m_systems_.push_back(std::move(entry));
 }
 
 void SystemManager::updateSystems(Scene* scene, float deltaTime) {
-  for (const auto& system : m_systems_) {
-    system->update(scene, deltaTime);
+  MemoryTagScope memoryTag(MemoryTag::Ecs);
+
+  for (auto& entry : m_systems_) {
+    ElapsedTime timer;
+    timer.start();
+
+    const bool ran = runSystem_(entry, scene, deltaTime);
+
+    recordTime_(entry, ran ? timer.elapsedTime<ElapsedTime::DurationFloat<std::milli>>() : 0.0f, ran);
+  }
+
+  ++m_frameIndex_;
+}
+
+bool SystemManager::runSystem_(SystemEntry& entry, Scene* scene, float deltaTime) {
+  const UpdateFrequency frequency = entry.system->getUpdateFrequency();
+  const uint32_t        count     = std::max(frequency.count, 1u);
+
+  switch (frequency.mode) {
+    case UpdateFrequency::Mode::EveryFrame:
+      entry.system->update(scene, deltaTime);
+      return true;
+
+    case UpdateFrequency::Mode::Interval:
+      entry.timeSinceUpdate += deltaTime;
+      // the system runs on its first frame, so it's initialized before it's used
+      if (entry.framesUntilUpdate > 0) {
+        --entry.framesUntilUpdate;
+        return false;
+      }
+      entry.system->update(scene, entry.timeSinceUpdate);
+      entry.framesUntilUpdate = count - 1;
+      entry.timeSinceUpdate   = 0.0f;
+      return true;
+
+    case UpdateFrequency::Mode::TimeSliced:
+      // the slice count may have changed since the last frame
+      entry.nextSlice %= count;
+      entry.system->updateSlice(scene, deltaTime, entry.nextSlice, count);
+      entry.nextSlice = (entry.nextSlice + 1) % count;
+      return true;
   }
+
+  return false;
+}
+
+void SystemManager::recordTime_(SystemEntry& entry, float milliseconds, bool ran) {
+  float& sample    = entry.samples[m_frameIndex_ % kStatsWindow];
+  entry.sampleSum += static_cast<double>(milliseconds) - static_cast<double>(sample);
+  sample           = milliseconds;
+  entry.lastTime   = milliseconds;
+
+  if (!ran || entry.budget <= 0.0f || milliseconds <= entry.budget) {
+    return;
+  }
+
+  ++entry.overBudgetRuns;
+  ++entry.pendingWarnings;
+
+  if (entry.hasWarned && m_frameIndex_ - entry.lastWarningFrame < kBudgetWarningInterval) {
+    return;
+  }
+
+  LOG_WARN("System {} took {:.3f} ms, over its budget of {:.3f} ms ({} runs over budget since the last warning)",
+           entry.system->getName(),
+           milliseconds,
+           entry.budget,
+           entry.pendingWarnings);
+
+  entry.pendingWarnings  = 0;
+  entry.lastWarningFrame = m_frameIndex_;
+  entry.hasWarned        = true;
+}
+
+void SystemManager::setBudget(const std::string& systemName, float milliseconds) {
+  milliseconds = std::max(milliseconds, 0.0f);
+
+  if (milliseconds > 0.0f) {
+    m_budgets_[systemName] = milliseconds;
+  } else {
+    m_budgets_.erase(systemName);
+  }
+
+  for (auto& entry : m_systems_) {
+    if (systemName == entry.system->getName()) {
+      entry.budget = milliseconds;
+    }
+  }
+}
+
+void SystemManager::setBudgets(const SystemBudgets& budgets) {
+  for (const auto& [systemName, milliseconds] : budgets) {
+    setBudget(systemName, milliseconds);
+  }
+}
+
+std::vector<SystemStats> SystemManager::getSystemStats() const {
+  std::vector<SystemStats> stats;
+  stats.reserve(m_systems_.size());
+
+  const size_t sampleCount = static_cast<size_t>(std::min<uint64_t>(m_frameIndex_, kStatsWindow));
+
+  for (const auto& entry : m_systems_) {
+    SystemStats systemStats;
+    systemStats.name           = entry.system->getName();
+    systemStats.frequency      = entry.system->getUpdateFrequency();
+    systemStats.lastTime       = entry.lastTime;
+    systemStats.budget         = entry.budget;
+    systemStats.overBudgetRuns = entry.overBudgetRuns;
+
+    if (sampleCount > 0) {
+      systemStats.averageTime = static_cast<float>(std::max(entry.sampleSum, 0.0) / static_cast<double>(sampleCount));
+      systemStats.maxTime     = *std::max_element(entry.samples.begin(), entry.samples.begin() + sampleCount);
+    }
+
+    stats.push_back(systemStats);
+  }
+
+  return stats;
 }
 
 }  // namespace ecs
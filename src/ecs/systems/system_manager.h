@@ -1,12 +1,35 @@
 #ifndef ARISE_SYSTEM_MANAGER_H
 #define ARISE_SYSTEM_MANAGER_H
 
+#include "config/config.h"
 #include "ecs/systems/i_updatable_system.h"
 #include "utils/logger/log.h"
 
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace arise {
 namespace ecs {
 
+// budget in milliseconds of one run per system name
+using SystemBudgets = std::unordered_map<std::string, float>;
+
+// "systemBudgets" object of the engine settings, e.g. { "LightSystem": 0.5 }
+SystemBudgets g_getSystemBudgetsFromConfig(const ConfigValue& value);
+
+// timing of a system over the last SystemManager::kStatsWindow frames, in milliseconds
+struct SystemStats {
+  const char*     name = nullptr;
+  UpdateFrequency frequency;
+  float           lastTime       = 0.0f;  // of the last frame, 0 if the system didn't run
+  float           averageTime    = 0.0f;  // per frame, frames without a run count as 0
+  float           maxTime        = 0.0f;
+  float           budget         = 0.0f;  // 0 if the system has none
+  uint32_t        overBudgetRuns = 0;     // since the start
+};
+
 // TODO: In future, when other than UpdatableSystems will be introduced,
 // consider to separate SystemManager to SubSystems like UpdatableSystemManager,
 // ReactiveSystemManager, EventSystemManager, LifecycleSystemManager etc.
@@ -18,17 +41,23 @@ namespace ecs {
  * @details
  * - User should avoid adding duplicate systems.
  * - Systems should not overlap in functionality to prevent unintended behavior.
+ * - Every run of a system is timed. A run longer than the budget of the system is reported (at most once per
+ *   kBudgetWarningInterval frames per system).
+ * - Systems are run as their UpdateFrequency declares.
  */
 class SystemManager {
   public:
+  static constexpr size_t   kStatsWindow           = 120;
+  static constexpr uint64_t kBudgetWarningInterval = 300;
+
   void addSystem(std::unique_ptr<IUpdatableSystem> system);
 
   // TODO: add removeSystem method
 
   template <typename T>
   T* getSystem() const {
-    for (const auto& system : m_systems_) {
-      T* typedSystem = dynamic_cast<T*>(system.get());
+    for (const auto& entry : m_systems_) {
+      T* typedSystem = dynamic_cast<T*>(entry.system.get());
       if (typedSystem) {
         return typedSystem;
       }
@@ -39,7 +68,7 @@ class SystemManager {
   template <typename T, typename... Args>
   bool replaceSystem(Args&&... args) {
     for (auto it = m_systems_.begin(); it != m_systems_.end(); ++it) {
-      if (dynamic_cast<T*>(it->get())) {
+      if (dynamic_cast<T*>(it->system.get())) {
         m_systems_.erase(it);
 
         auto newSystem = std::make_unique<T>(std::forward<Args>(args)...);
@@ -54,8 +83,43 @@ class SystemManager {
 
   void updateSystems(Scene* scene, float deltaTime);
 
+  // budget in milliseconds of one run of the system, 0 removes it (kept for systems added later)
+  void setBudget(const std::string& systemName, float milliseconds);
+  void setBudgets(const SystemBudgets& budgets);
+
+  // in the order the systems run
+  std::vector<SystemStats> getSystemStats() const;
+
   private:
-  std::vector<std::unique_ptr<IUpdatableSystem>> m_systems_;
+  struct SystemEntry {
+    std::unique_ptr<IUpdatableSystem> system;
+
+    // scheduling
+    float    timeSinceUpdate   = 0.0f;
+    uint32_t framesUntilUpdate = 0;
+    uint32_t nextSlice         = 0;
+
+    // timing
+    std::array<float, kStatsWindow> samples{};  // circular, per frame
+    double                          sampleSum      = 0.0;
+    float                           lastTime       = 0.0f;
+    float                           budget         = 0.0f;
+    uint32_t                        overBudgetRuns = 0;
+
+    // budget warnings
+    uint32_t pendingWarnings  = 0;  // runs over budget since the last warning
+    uint64_t lastWarningFrame = 0;
+    bool     hasWarned        = false;
+  };
+
+  // runs the system if it's due, returns whether it ran
+  bool runSystem_(SystemEntry& entry, Scene* scene, float deltaTime);
+
+  void recordTime_(SystemEntry& entry, float milliseconds, bool ran);
+
+  std::vector<SystemEntry> m_systems_;
+  SystemBudgets            m_budgets_;
+  uint64_t                 m_frameIndex_ = 0;
 };
 
 }  // namespace ecs
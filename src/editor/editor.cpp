@@ -15,7 +15,9 @@
 #include "ecs/components/viewport_tag.h"
 #include "ecs/systems/mouse_picking_system.h"
 #include "ecs/systems/system_manager.h"
+#include "file_loader/file_system_manager.h"
 #include "gfx/renderer/renderer.h"
+#include "gfx/renderer/software_occlusion.h"
 #include "input/actions.h"
 #include "input/editor_input_processor.h"
 #include "input/input_manager.h"
@@ -25,6 +27,10 @@
 #include "scene/scene_manager.h"
 #include "scene/scene_saver.h"
 #include "utils/asset/asset_loader.h"
+#include "utils/logger/log.h"
+#include "utils/memory/allocation_tracker.h"
+#include "utils/memory/heap_allocation_counter.h"
+#include "utils/memory/linear_allocator.h"
 #include "utils/model/render_model_manager.h"
 #include "utils/path_manager/path_manager.h"
 #include "utils/service/service_locator.h"
@@ -34,6 +40,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <set>
 
 namespace arise {
@@ -69,6 +76,8 @@ bool Editor::initialize(Window*                        window,
   m_notificationTimer.stop();
   m_sceneSaveTimer.stop();
 
+  m_memoryLogger = dynamic_cast<MemoryLogger*>(GlobalLogger::GetLogger("memory_logger"));
+
   setupInputHandlers_();
 
   LOG_INFO("Editor initialized successfully");
@@ -77,6 +86,7 @@ bool Editor::initialize(Window*                        window,
 
 void Editor::render(gfx::renderer::RenderContext& context) {
   CPU_ZONE_NC("Editor::render", color::ORANGE);
+  MemoryTagScope memoryTag(MemoryTag::Editor);
 
   if (!m_imguiContext) {
     return;
@@ -88,24 +98,26 @@ void Editor::render(gfx::renderer::RenderContext& context) {
   m_sceneStats.instancesRendered = context.statistics.instancesRendered;
   m_sceneStats.setPassCalls      = context.statistics.setPassCalls;
   m_sceneStats.batches           = context.statistics.batches;
+  m_sceneStats.mergedMeshes      = context.statistics.mergedMeshes;
+  m_sceneStats.occludedInstances = context.statistics.occludedInstances;
+  m_sceneStats.occluderMeshes    = context.statistics.occluderMeshes;
 
   if (m_pendingViewportResize) {
     resizeViewport(context);
     m_pendingViewportResize = false;
   }
 
+  // the render targets were reallocated (also without a resize event, when a smaller bucket fits the viewport)
+  if (m_viewportTextureGeneration != m_frameResources->getRenderTargetGeneration()) {
+    clearViewportTextureIDs();
+    m_viewportTextureGeneration = m_frameResources->getRenderTargetGeneration();
+  }
+
   uint32_t currentIndex = context.currentImageIndex;
 
+  // the render graph leaves the scene color in ShaderReadOnly layout (its final layout in editor mode)
   auto colorBufferTexture = m_frameResources->getRenderTargets(currentIndex).colorBuffer.get();
 
-  if (colorBufferTexture->getCurrentLayoutType() != gfx::rhi::ResourceLayout::ShaderReadOnly) {
-    gfx::rhi::ResourceBarrierDesc colorBarrier;
-    colorBarrier.texture   = colorBufferTexture;
-    colorBarrier.oldLayout = colorBufferTexture->getCurrentLayoutType();
-    colorBarrier.newLayout = gfx::rhi::ResourceLayout::ShaderReadOnly;
-    context.commandBuffer->resourceBarrier(colorBarrier);
-  }
-
   if (!m_viewportTextureIDs[currentIndex]) {
     m_viewportTextureIDs[currentIndex] = m_imguiContext->createTextureID(colorBufferTexture, currentIndex);
   }
@@ -129,6 +141,7 @@ void Editor::render(gfx::renderer::RenderContext& context) {
     renderGizmoControlsWindow();
     renderControlsWindow();
     renderApiWindow();
+    renderLogWindow();
 
     renderNotifications();
   }
@@ -164,11 +177,8 @@ void Editor::resizeViewport(const gfx::renderer::RenderContext& context) {
     return;
   }
 
-  m_device->waitIdle();
-
-  clearViewportTextureIDs();
-
-  // We'll create new texture IDs on-demand in the render method
+  // The render targets are resized by the renderer (onViewportResize) without draining the GPU, the texture IDs are
+  // recreated in render() once the targets are reallocated
 }
 
 void Editor::renderMainMenu() {
@@ -260,6 +270,19 @@ void Editor::renderPerformanceWindow() {
   ImGui::Text("FPS: %.1f", fps);
   ImGui::Text("Frame Time: %.1f ms", frameTime);
 
+  if (HeapAllocationCounter::s_isEnabled()) {
+    ImGui::Text("Heap Allocations: %llu (%.1f KB) per frame",
+                static_cast<unsigned long long>(HeapAllocationCounter::s_getFrameAllocationCount()),
+                HeapAllocationCounter::s_getFrameAllocatedBytes() / 1024.0f);
+  }
+
+  // main thread frame allocator, the peak since the start against the reserved memory
+  const LinearAllocator& frameAllocator = g_getFrameAllocator();
+  ImGui::Text("Frame Allocator: %.1f / %.1f KB (%llu block allocations)",
+              frameAllocator.getPeakBytes() / 1024.0f,
+              frameAllocator.getCapacity() / 1024.0f,
+              static_cast<unsigned long long>(frameAllocator.getBlockAllocationCount()));
+
   static constexpr float graphTimeWindow = 5.0f;    // Show last 5 seconds of data
   static constexpr float bucketSize      = 0.025f;  // 25ms buckets (40 samples per second)
   static constexpr int   maxBuckets      = static_cast<int>(graphTimeWindow / bucketSize);
@@ -332,18 +355,17 @@ void Editor::renderPerformanceWindow() {
     }
   }
 
-  int   totalFrames  = 0;
-  float totalHitches = 0;
+  int totalFrames = 0;
   for (const auto& bucket : buckets) {
     totalFrames += bucket.frameCount;
-    if (bucket.maxFrameTime > bucket.avgFrameTime * 2.0f) {
-      totalHitches++;
-    }
   }
 
   ImGui::Text(
       "Time Window: %.1fs | Buckets: %d | Bucket Size: %.0fms", graphTimeWindow, validBuckets, bucketSize * 1000.0f);
-  ImGui::Text("Total Frames: %d | Hitches Detected: %.0f | Bucket: %d", totalFrames, totalHitches, currentBucket);
+  ImGui::Text("Total Frames: %d | Hitches Detected: %u | Bucket: %d",
+              totalFrames,
+              timingManager->getFrameStatistics().getHitchCount(),
+              currentBucket);
 
   static int metricType = 0;  // 0 = avg, 1 = max
   ImGui::RadioButton("Average", &metricType, 0);
@@ -368,9 +390,359 @@ void Editor::renderPerformanceWindow() {
     ImGui::Text("Accumulating data...");
   }
 
+  ImGui::Spacing();
+  renderFrameStatistics_(timingManager->getFrameStatistics());
+  renderCpuProfiler_();
+  renderSystemCosts_();
+  renderMemoryTags_();
+
   ImGui::End();
 }
 
+void Editor::renderFrameStatistics_(FrameStatistics& statistics) {
+  if (!ImGui::CollapsingHeader("Frame Statistics")) {
+    return;
+  }
+
+  static int windowIndex = 0;  // 0 = short, 1 = long
+  ImGui::RadioButton("Last 300 frames", &windowIndex, 0);
+  ImGui::SameLine();
+  ImGui::RadioButton("Last 3600 frames", &windowIndex, 1);
+
+  const auto window     = windowIndex == 0 ? FrameStatistics::Window::Short : FrameStatistics::Window::Long;
+  const auto frameCount = statistics.getFrameCount(window);
+  if (frameCount == 0) {
+    ImGui::Text("Accumulating data...");
+    return;
+  }
+
+  auto toMs = [](uint64_t microseconds) { return static_cast<double>(microseconds) / 1000.0; };
+
+  if (ImGui::BeginTable("FrameStatisticsTable",
+                        5,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+    ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+    ImGui::TableSetupColumn("p50", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("p95", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("p99", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableHeadersRow();
+
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("Frame");
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%.2f", toMs(statistics.getPercentile(window, 50.0)));
+    ImGui::TableSetColumnIndex(2);
+    ImGui::Text("%.2f", toMs(statistics.getPercentile(window, 95.0)));
+    ImGui::TableSetColumnIndex(3);
+    ImGui::Text("%.2f", toMs(statistics.getPercentile(window, 99.0)));
+    ImGui::TableSetColumnIndex(4);
+    ImGui::Text("%.2f", toMs(statistics.getMax(window)));
+
+    for (size_t i = 0; i < kFramePhaseCount; ++i) {
+      const auto phase = static_cast<FramePhase>(i);
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::Text("%s", g_getFramePhaseName(phase));
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%.2f", toMs(statistics.getPhasePercentile(window, phase, 50.0)));
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%.2f", toMs(statistics.getPhasePercentile(window, phase, 95.0)));
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%.2f", toMs(statistics.getPhasePercentile(window, phase, 99.0)));
+      ImGui::TableSetColumnIndex(4);
+      ImGui::Text("%.2f", toMs(statistics.getPhaseMax(window, phase)));
+    }
+
+    ImGui::EndTable();
+  }
+
+  // 0.5 ms bins up to 50 ms, the last bin holds the slower frames
+  static std::array<float, 100> distribution{};
+  statistics.getHistogram(window).getDistribution(500, distribution);
+  ImGui::PlotHistogram("Frame Time Distribution (0-50 ms)",
+                       distribution.data(),
+                       static_cast<int>(distribution.size()),
+                       0,
+                       nullptr,
+                       0.0f,
+                       FLT_MAX,
+                       ImVec2(0, 80));
+
+  float hitchMinimumTime = statistics.getHitchMinimumTime();
+  if (ImGui::DragFloat("Hitch Minimum (ms)", &hitchMinimumTime, 0.5f, 1.0f, 1000.0f, "%.1f")) {
+    statistics.setHitchMinimumTime(hitchMinimumTime);
+  }
+
+  float hitchMedianFactor = statistics.getHitchMedianFactor();
+  if (ImGui::DragFloat("Hitch Median Factor", &hitchMedianFactor, 0.05f, 1.0f, 20.0f, "%.2f")) {
+    statistics.setHitchMedianFactor(hitchMedianFactor);
+  }
+
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip("A frame is a hitch if it exceeds the minimum and this factor times the median frame time.");
+  }
+
+  const auto& lastCapture = statistics.getLastHitchCapture();
+  ImGui::Text("Hitches: %u | Last capture: %s",
+              statistics.getHitchCount(),
+              lastCapture.empty() ? "none" : lastCapture.filename().string().c_str());
+}
+
+void Editor::renderCpuProfiler_() {
+  if (!ImGui::CollapsingHeader("CPU Zones")) {
+    return;
+  }
+
+#ifdef ARISE_USE_BUILTIN_CPU_PROFILING
+  auto& profiler = cpu::CpuProfiler::s_get();
+
+  bool paused = profiler.isPaused();
+  if (ImGui::Checkbox("Pause", &paused)) {
+    profiler.setPaused(paused);
+  }
+
+  ImGui::SameLine();
+  if (ImGui::Button("Export CPU trace")) {
+    auto debugPath = PathManager::s_getDebugPath();
+    std::filesystem::create_directories(debugPath);
+
+    if (FileSystemManager::writeFile(debugPath / "cpu_trace.json", profiler.exportChromeTrace())) {
+      LOG_INFO("CPU trace exported to {}", debugPath.string());
+    } else {
+      LOG_ERROR("Failed to export the CPU trace to {}", debugPath.string());
+    }
+  }
+
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip("Writes the zones of the last %zu frames to cpu_trace.json (chrome://tracing, Perfetto).",
+                      cpu::CpuProfiler::kFrameWindow);
+  }
+
+  const size_t   frameCount   = profiler.getFrameCount();
+  const uint64_t droppedCount = profiler.getDroppedCount();
+  ImGui::Text("Frames: %zu | Dropped zones: %llu", frameCount, static_cast<unsigned long long>(droppedCount));
+
+  if (frameCount == 0) {
+    ImGui::Text("Accumulating data...");
+    return;
+  }
+
+  // averages per frame over the window
+  profiler.getWindowSummary(m_cpuZones);
+  const double nanosecondsToMs = 1.0 / (1'000'000.0 * static_cast<double>(frameCount));
+
+  if (ImGui::BeginTable("CpuZonesTable",
+                        4,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable
+                            | ImGuiTableFlags_ScrollY,
+                        ImVec2(0, 300.0f))) {
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Inclusive (ms)", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+    ImGui::TableSetupColumn("Exclusive (ms)", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+    ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+    ImGui::TableHeadersRow();
+
+    // nodes are in pre-order, returns the index after the subtree
+    auto renderZone = [&](auto& self, size_t index) -> size_t {
+      const auto&  zone     = m_cpuZones[index];
+      const size_t next     = index + zone.subtreeSize;
+      const bool   isThread = zone.depth == 0;
+      const bool   isLeaf   = zone.subtreeSize == 1;
+
+      ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+      if (isThread) {
+        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+      }
+      if (isLeaf) {
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+      }
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      const std::string label = isThread ? profiler.getThreadName(zone.threadId) : zone.name;
+      const bool        open  = ImGui::TreeNodeEx(label.c_str(), flags);
+
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%.3f", zone.inclusiveTime * nanosecondsToMs);
+      if (!isThread) {
+        ImGui::TableSetColumnIndex(2);
+        ImGui::Text("%.3f", zone.exclusiveTime * nanosecondsToMs);
+        ImGui::TableSetColumnIndex(3);
+        ImGui::Text("%.1f", static_cast<double>(zone.callCount) / frameCount);
+      }
+
+      if (open && !isLeaf) {
+        for (size_t child = index + 1; child < next;) {
+          child = self(self, child);
+        }
+        ImGui::TreePop();
+      }
+      return next;
+    };
+
+    for (size_t index = 0; index < m_cpuZones.size();) {
+      index = renderZone(renderZone, index);
+    }
+
+    ImGui::EndTable();
+  }
+#else
+  ImGui::TextDisabled("Built-in CPU profiler is disabled (USE_BUILTIN_CPU_PROFILING)");
+#endif
+}
+
+void Editor::renderSystemCosts_() {
+  if (!ImGui::CollapsingHeader("Systems")) {
+    return;
+  }
+
+  auto systemManager = ServiceLocator::s_get<ecs::SystemManager>();
+  if (!systemManager) {
+    ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "SystemManager not available");
+    return;
+  }
+
+  const auto systemStats = systemManager->getSystemStats();
+
+  ImGui::Text("Per frame over the last %zu frames, budgets apply to a single run", ecs::SystemManager::kStatsWindow);
+
+  if (ImGui::BeginTable("SystemCostsTable",
+                        7,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+    ImGui::TableSetupColumn("System", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Last (ms)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("Avg (ms)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("Max (ms)", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("Budget (ms)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("Over", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+    ImGui::TableSetupColumn("Frequency", ImGuiTableColumnFlags_WidthFixed, 110.0f);
+    ImGui::TableHeadersRow();
+
+    const ImVec4 overBudgetColor(1.0f, 0.4f, 0.4f, 1.0f);
+
+    for (const auto& stats : systemStats) {
+      const bool hasBudget = stats.budget > 0.0f;
+
+      ImGui::PushID(stats.name);
+      ImGui::TableNextRow();
+
+      ImGui::TableSetColumnIndex(0);
+      ImGui::Text("%s", stats.name);
+
+      ImGui::TableSetColumnIndex(1);
+      if (hasBudget && stats.lastTime > stats.budget) {
+        ImGui::TextColored(overBudgetColor, "%.3f", stats.lastTime);
+      } else {
+        ImGui::Text("%.3f", stats.lastTime);
+      }
+
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%.3f", stats.averageTime);
+
+      ImGui::TableSetColumnIndex(3);
+      if (hasBudget && stats.maxTime > stats.budget) {
+        ImGui::TextColored(overBudgetColor, "%.3f", stats.maxTime);
+      } else {
+        ImGui::Text("%.3f", stats.maxTime);
+      }
+
+      // 0 removes the budget
+      ImGui::TableSetColumnIndex(4);
+      float budget = stats.budget;
+      ImGui::SetNextItemWidth(-FLT_MIN);
+      if (ImGui::DragFloat("##Budget", &budget, 0.01f, 0.0f, 100.0f, hasBudget ? "%.2f" : "none")) {
+        systemManager->setBudget(stats.name, budget);
+      }
+
+      ImGui::TableSetColumnIndex(5);
+      ImGui::Text("%u", stats.overBudgetRuns);
+
+      ImGui::TableSetColumnIndex(6);
+      switch (stats.frequency.mode) {
+        case ecs::UpdateFrequency::Mode::EveryFrame:
+          ImGui::Text("Every frame");
+          break;
+        case ecs::UpdateFrequency::Mode::Interval:
+          ImGui::Text("Every %u frames", stats.frequency.count);
+          break;
+        case ecs::UpdateFrequency::Mode::TimeSliced:
+          ImGui::Text("%u slices", stats.frequency.count);
+          break;
+      }
+
+      ImGui::PopID();
+    }
+
+    ImGui::EndTable();
+  }
+}
+
+void Editor::renderMemoryTags_() {
+  if (!ImGui::CollapsingHeader("Memory")) {
+    return;
+  }
+
+  if (!AllocationTracker::s_isEnabled()) {
+    ImGui::TextDisabled("Allocation tracking is disabled (USE_ALLOCATION_TRACKING)");
+    return;
+  }
+
+  if (ImGui::Button("Dump memory report")) {
+    auto debugPath = PathManager::s_getDebugPath();
+    std::filesystem::create_directories(debugPath);
+
+    if (FileSystemManager::writeFile(debugPath / "memory_report.txt", AllocationTracker::s_createReport())) {
+      LOG_INFO("Memory report written to {}", debugPath.string());
+    } else {
+      LOG_ERROR("Failed to write the memory report to {}", debugPath.string());
+    }
+  }
+
+  if (ImGui::BeginTable("MemoryTagsTable",
+                        6,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+    ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Live (MB)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableSetupColumn("Peak (MB)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableSetupColumn("Live allocs", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableSetupColumn("Allocs/frame", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("KB/frame", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableHeadersRow();
+
+    constexpr float kBytesPerMegabyte = 1024.0f * 1024.0f;
+
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+      const MemoryTagStats stats = AllocationTracker::s_getStats(static_cast<MemoryTag>(i));
+
+      ImGui::TableNextRow();
+
+      ImGui::TableSetColumnIndex(0);
+      ImGui::Text("%s", g_getMemoryTagName(stats.tag));
+
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%.2f", stats.liveBytes / kBytesPerMegabyte);
+
+      ImGui::TableSetColumnIndex(2);
+      ImGui::Text("%.2f", stats.peakBytes / kBytesPerMegabyte);
+
+      ImGui::TableSetColumnIndex(3);
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.liveAllocations));
+
+      ImGui::TableSetColumnIndex(4);
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.frameAllocations));
+
+      ImGui::TableSetColumnIndex(5);
+      ImGui::Text("%.1f", stats.frameAllocatedBytes / 1024.0f);
+    }
+
+    ImGui::EndTable();
+  }
+}
+
 void Editor::renderSceneStatsWindow() {
   ImGui::Begin("Scene Statistics");
 
@@ -565,6 +937,18 @@ void Editor::renderSceneStatsWindow() {
     ImGui::TableSetColumnIndex(1);
     ImGui::Text("%u", m_sceneStats.batches);
 
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("Merged Meshes");
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%u", m_sceneStats.mergedMeshes);
+
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("Occluded");
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%u instances (%u occluders)", m_sceneStats.occludedInstances, m_sceneStats.occluderMeshes);
+
     ImGui::TableNextRow();
     ImGui::TableSetColumnIndex(0);
     ImGui::Text("SetPass");
@@ -617,7 +1001,15 @@ void Editor::renderViewportWindow(gfx::renderer::RenderContext& context) {
   }
 
   if (currentTextureID) {
-    ImGui::Image(currentTextureID, renderWindow);
+    // the viewport covers the top-left part of the (bucketed) render target
+    auto         colorBuffer = m_frameResources->getRenderTargets(currentIndex).colorBuffer.get();
+    const ImVec2 uvMax(static_cast<float>(context.viewportDimension.width()) / colorBuffer->getWidth(),
+                       static_cast<float>(context.viewportDimension.height()) / colorBuffer->getHeight());
+    ImGui::Image(currentTextureID, renderWindow, ImVec2(0.0f, 0.0f), uvMax);
+
+    if (m_renderParams.softwareOcclusionView && context.softwareOcclusion) {
+      renderOcclusionOverlay_(*context.softwareOcclusion, viewportPos, renderWindow);
+    }
 
     renderGizmo(newDimension, viewportPos);
 
@@ -650,6 +1042,57 @@ void Editor::renderViewportWindow(gfx::renderer::RenderContext& context) {
   ImGui::End();
 }
 
+void Editor::renderOcclusionOverlay_(const gfx::renderer::SoftwareOcclusion& occlusion,
+                                     const ImVec2&                           viewportPos,
+                                     const ImVec2&                           viewportSize) {
+  using gfx::renderer::SoftwareOcclusion;
+
+  // one rect per 2x2 pixels, a quarter of the viewport width at most
+  constexpr uint32_t kBlockSize = 2;
+  constexpr float    kMargin    = 8.0f;
+
+  const float scale = std::min(viewportSize.x * 0.25f / SoftwareOcclusion::kWidth, 2.0f);
+  if (scale <= 0.0f) {
+    return;
+  }
+
+  const ImVec2 size(SoftwareOcclusion::kWidth * scale, SoftwareOcclusion::kHeight * scale);
+  const ImVec2 origin(viewportPos.x + kMargin, viewportPos.y + viewportSize.y - size.y - kMargin);
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+  drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(0, 0, 0, 160));
+
+  const auto& depthBuffer = occlusion.getDepthBuffer();
+  for (uint32_t y = 0; y < SoftwareOcclusion::kHeight; y += kBlockSize) {
+    for (uint32_t x = 0; x < SoftwareOcclusion::kWidth; x += kBlockSize) {
+      float nearestDepth = 1.0f;
+      for (uint32_t blockY = y; blockY < y + kBlockSize; ++blockY) {
+        for (uint32_t blockX = x; blockX < x + kBlockSize; ++blockX) {
+          nearestDepth = std::min(nearestDepth, depthBuffer[blockY * SoftwareOcclusion::kWidth + blockX]);
+        }
+      }
+
+      if (nearestDepth >= 1.0f) {
+        continue;
+      }
+
+      // depth is close to 1 for most of the view, a log scale keeps distant occluders apart
+      const float   distance  = std::clamp(-std::log10(1.0f - nearestDepth) / 4.0f, 0.0f, 1.0f);
+      const uint8_t intensity = static_cast<uint8_t>((1.0f - distance * 0.8f) * 255.0f);
+
+      const ImVec2 min(origin.x + x * scale, origin.y + y * scale);
+      const ImVec2 max(min.x + kBlockSize * scale, min.y + kBlockSize * scale);
+      drawList->AddRectFilled(min, max, IM_COL32(intensity, intensity, intensity, 255));
+    }
+  }
+
+  drawList->AddRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(255, 255, 255, 200));
+
+  const std::string label = "Occluders: " + std::to_string(occlusion.getOccluderCount()) + " ("
+                          + std::to_string(occlusion.getOccluderTriangleCount()) + " triangles)";
+  drawList->AddText(ImVec2(origin.x + 4.0f, origin.y + 2.0f), IM_COL32(255, 200, 0, 255), label.c_str());
+}
+
 void Editor::renderModeSelectionWindow() {
   ImGui::Begin("Render Mode");
 
@@ -701,6 +1144,97 @@ void Editor::renderModeSelectionWindow() {
 
   ImGui::Separator();
 
+  ImGui::Checkbox("Depth pre-pass", &m_renderParams.depthPrePass);
+
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip(
+        "Renders opaque and alpha-tested geometry depth first,\n"
+        "so the base pass shades each pixel only once (depth EQUAL).");
+  }
+
+  ImGui::Checkbox("Indirect draw", &m_renderParams.indirectDraw);
+
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip(
+        "Writes the draw arguments of all batches into one indirect buffer\n"
+        "and submits each pipeline with a single multi-draw call.");
+  }
+
+  ImGui::BeginDisabled(!m_renderParams.indirectDraw);
+  ImGui::Checkbox("GPU culling", &m_renderParams.gpuCulling);
+
+  if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+    ImGui::SetTooltip(
+        "Culls instances against the view frustum in a compute pass,\n"
+        "draws only read the visible ones (requires indirect draw).");
+  }
+
+  ImGui::BeginDisabled(!m_renderParams.gpuCulling);
+  ImGui::Checkbox("GPU occlusion culling", &m_renderParams.gpuOcclusionCulling);
+
+  if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+    ImGui::SetTooltip(
+        "Also culls instances hidden behind the depth of the previous frame\n"
+        "(depth pyramid built after the base pass).");
+  }
+
+  ImGui::Checkbox("Verify GPU culling", &m_renderParams.gpuCullingVerify);
+
+  if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+    ImGui::SetTooltip(
+        "Reads the culling results back and compares them with a CPU frustum test,\n"
+        "mismatches are logged.");
+  }
+  ImGui::EndDisabled();
+  ImGui::EndDisabled();
+
+  ImGui::Checkbox("Software occlusion culling", &m_renderParams.softwareOcclusion);
+
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip(
+        "Rasterizes large occluders into a low resolution depth buffer on the CPU\n"
+        "and skips instances hidden behind them (not used while GPU culling runs).");
+  }
+
+  ImGui::BeginDisabled(!m_renderParams.softwareOcclusion);
+  ImGui::Checkbox("Show occlusion buffer", &m_renderParams.softwareOcclusionView);
+
+  if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+    ImGui::SetTooltip("Draws the CPU occlusion buffer in the corner of the viewport.");
+  }
+  ImGui::EndDisabled();
+
+  if (auto* renderGraph = m_renderer->getRenderGraph()) {
+    const auto& statistics = renderGraph->getStatistics();
+
+    ImGui::Separator();
+    ImGui::Text("Render graph: %u passes (%u culled), %u barriers in %u batches",
+                statistics.passCount,
+                statistics.culledPassCount,
+                statistics.barrierCount,
+                statistics.barrierBatchCount);
+    ImGui::Text("Transient textures: %u, %.2f MB (%.2f MB without aliasing)",
+                statistics.transientTextureCount,
+                statistics.transientMemory / (1024.0 * 1024.0),
+                statistics.transientMemoryTotal / (1024.0 * 1024.0));
+
+    if (ImGui::Button("Export render graph")) {
+      auto debugPath = PathManager::s_getDebugPath();
+      std::filesystem::create_directories(debugPath);
+
+      if (FileSystemManager::writeFile(debugPath / "render_graph.dot", renderGraph->exportDot())
+          && FileSystemManager::writeFile(debugPath / "render_graph.json", renderGraph->exportJson())) {
+        LOG_INFO("Render graph exported to {}", debugPath.string());
+      } else {
+        LOG_ERROR("Failed to export the render graph to {}", debugPath.string());
+      }
+    }
+
+    if (ImGui::IsItemHovered()) {
+      ImGui::SetTooltip("Writes the graph of the last frame to render_graph.dot and render_graph.json.");
+    }
+  }
+
   bool preserveMode = m_preserveRenderModeOnSelection;
   if (ImGui::Checkbox("Preserve render mode on selection", &preserveMode)) {
     m_preserveRenderModeOnSelection = preserveMode;
@@ -1034,6 +1568,19 @@ void Editor::renderInspectorWindow() {
         ImGui::Text("File: %s", model->filePath.string().c_str());
         ImGui::Text("Meshes: %zu", model->renderMeshes.size());
 
+        bool occluder = registry.all_of<ecs::OccluderTag>(m_selectedEntity);
+        if (ImGui::Checkbox("Occluder", &occluder)) {
+          if (occluder) {
+            registry.emplace<ecs::OccluderTag>(m_selectedEntity);
+          } else {
+            registry.remove<ecs::OccluderTag>(m_selectedEntity);
+          }
+        }
+
+        if (ImGui::IsItemHovered()) {
+          ImGui::SetTooltip("Always rendered into the software occlusion buffer, regardless of its screen size.");
+        }
+
         for (size_t i = 0; i < model->renderMeshes.size(); i++) {
           if (ImGui::TreeNode(("Mesh " + std::to_string(i)).c_str())) {
             auto* renderMesh = model->renderMeshes[i];
@@ -1043,7 +1590,7 @@ void Editor::renderInspectorWindow() {
 
               if (!renderMesh->material->textures.empty() && ImGui::TreeNode("Textures")) {
                 for (const auto& [name, texture] : renderMesh->material->textures) {
-                  ImGui::Text("%s: %p", name.c_str(), texture);
+                  ImGui::Text("%s: %p", name.toString().c_str(), texture);
                 }
                 ImGui::TreePop();
               }
@@ -1235,6 +1782,76 @@ void Editor::renderApiWindow() {
   ImGui::End();
 }
 
+void Editor::renderLogWindow() {
+  ImGui::Begin("Log");
+
+  if (!m_memoryLogger) {
+    ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Memory logger not available");
+    ImGui::End();
+    return;
+  }
+
+  const char* levelItems[] = {"Trace", "Debug", "Info", "Warning", "Error", "Fatal"};
+  ImGui::SetNextItemWidth(100.0f);
+  ImGui::Combo("##LogLevel", &m_logMinLevel, levelItems, IM_ARRAYSIZE(levelItems));
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(250.0f);
+  ImGui::InputTextWithHint("##LogFilter", "Filter messages...", m_logFilterBuffer, sizeof(m_logFilterBuffer));
+  ImGui::SameLine();
+  if (ImGui::Button("Clear")) {
+    m_memoryLogger->clear();
+  }
+  ImGui::SameLine();
+  ImGui::Checkbox("Auto-scroll", &m_logAutoScroll);
+
+  // only the entries logged since the last frame are filtered (the whole log after a filter change)
+  m_logView.setFilter(static_cast<LogLevel>(m_logMinLevel), m_logFilterBuffer);
+  m_memoryLogger->updateView(m_logView);
+
+  ImGui::Separator();
+  ImGui::BeginChild("##LogEntries", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(m_logView.getSize()));
+  while (clipper.Step()) {
+    m_memoryLogger->visitEntries(
+        m_logView, clipper.DisplayStart, clipper.DisplayEnd - clipper.DisplayStart, [](const LogEntry& entry) {
+          ImVec4 color(0.8f, 0.8f, 0.8f, 1.0f);
+          switch (entry.callSite->level) {
+            case LogLevel::Trace:
+            case LogLevel::Debug:
+              color = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+              break;
+            case LogLevel::Warning:
+              color = ImVec4(1.0f, 0.8f, 0.3f, 1.0f);
+              break;
+            case LogLevel::Error:
+            case LogLevel::Fatal:
+              color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
+              break;
+            default:
+              break;
+          }
+
+          ImGui::TextColored(color,
+                             "%s:%u | %s() | %.*s",
+                             entry.callSite->file.c_str(),
+                             entry.callSite->line,
+                             entry.callSite->function.c_str(),
+                             static_cast<int>(entry.message.size()),
+                             entry.message.data());
+        });
+  }
+  clipper.End();
+
+  if (m_logAutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
+    ImGui::SetScrollHereY(1.0f);
+  }
+
+  ImGui::EndChild();
+  ImGui::End();
+}
+
 void Editor::renderGizmo(const math::Dimension2i& viewportSize, const ImVec2& viewportPos) {
   if (!shouldRenderGizmo_()) {
     return;
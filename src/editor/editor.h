@@ -4,6 +4,9 @@
 #include "gfx/renderer/renderer.h"
 #include "gfx/rhi/common/rhi_enums.h"
 #include "input/actions.h"
+#include "profiler/backends/cpu_profiler.h"
+#include "utils/logger/memory_logger.h"
+#include "utils/time/frame_statistics.h"
 #include "utils/time/stopwatch.h"
 #include "utils/ui/imgui_rhi_context.h"
 
@@ -75,8 +78,23 @@ class Editor {
   void renderNotifications();
   void renderControlsWindow();
   void renderApiWindow();
+  void renderLogWindow();
+
+  // percentiles, distribution and hitch settings of the TimingManager statistics (Performance window)
+  void renderFrameStatistics_(FrameStatistics& statistics);
+  // zones of the built-in CPU profiler (Performance window)
+  void renderCpuProfiler_();
+  // per system timing and budgets of the SystemManager (Performance window)
+  void renderSystemCosts_();
+  // heap memory per MemoryTag of the AllocationTracker (Performance window)
+  void renderMemoryTags_();
 
   void renderGizmo(const math::Dimension2i& viewportSize, const ImVec2& viewportPos);
+
+  // CPU occlusion buffer in the corner of the viewport (RenderSettings::softwareOcclusionView)
+  void renderOcclusionOverlay_(const gfx::renderer::SoftwareOcclusion& occlusion,
+                               const ImVec2&                           viewportPos,
+                               const ImVec2&                           viewportSize);
   void handleGizmoInput(EditorAction action);
   void renderGizmoControlsWindow();
 
@@ -136,6 +154,7 @@ class Editor {
 
   std::unique_ptr<gfx::ImGuiRHIContext> m_imguiContext;
   std::vector<ImTextureID>              m_viewportTextureIDs;
+  uint32_t                              m_viewportTextureGeneration = 0;  // render targets of m_viewportTextureIDs
 
   bool m_pendingViewportResize = true;
 
@@ -162,6 +181,14 @@ class Editor {
 
   bool m_showControlsWindow = false;
 
+  MemoryLogger* m_memoryLogger = nullptr;  // entries of the log window (null if no memory logger was added)
+  LogFilterView m_logView;
+  int           m_logMinLevel          = static_cast<int>(LogLevel::Trace);
+  char          m_logFilterBuffer[256] = "";
+  bool          m_logAutoScroll        = true;
+
+  std::vector<cpu::ZoneNode> m_cpuZones;  // window summary of the built-in CPU profiler, reused every frame
+
   char m_hierarchySearchBuffer[256] = "";
   enum class SortOrder {
     None,
@@ -199,6 +226,9 @@ class Editor {
     uint32_t instancesRendered = 0;
     uint32_t setPassCalls = 0;
     uint32_t batches = 0;
+    uint32_t mergedMeshes = 0;
+    uint32_t occludedInstances = 0;
+    uint32_t occluderMeshes = 0;
     
     bool isDirty = true;
   };
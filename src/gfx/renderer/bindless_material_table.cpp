@@ -0,0 +1,321 @@
+#include "gfx/renderer/bindless_material_table.h"
+
+#include "ecs/components/material.h"
+#include "gfx/renderer/render_resource_manager.h"
+#include "utils/logger/log.h"
+
+#include <algorithm>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+//-------------------------------------------------------------------------
+// SlotAllocator implementation
+//-------------------------------------------------------------------------
+
+void BindlessMaterialTable::SlotAllocator::reset(uint32_t capacity) {
+  m_freeSlots_.clear();
+  m_retiredSlots_.clear();
+  m_capacity_ = capacity;
+  m_next_     = 0;
+}
+
+uint32_t BindlessMaterialTable::SlotAllocator::allocate() {
+  if (!m_freeSlots_.empty()) {
+    uint32_t slot = m_freeSlots_.back();
+    m_freeSlots_.pop_back();
+    return slot;
+  }
+
+  if (m_next_ < m_capacity_) {
+    return m_next_++;
+  }
+
+  return kInvalidIndex;
+}
+
+void BindlessMaterialTable::SlotAllocator::release(uint32_t slot, uint64_t frame) {
+  m_retiredSlots_.push_back({slot, frame});
+}
+
+std::span<const uint32_t> BindlessMaterialTable::SlotAllocator::recycle(uint64_t retireFrame) {
+  const size_t recycledBegin = m_freeSlots_.size();
+
+  // slots are released in frame order, so the retired ones form a prefix
+  auto firstPending = std::find_if(m_retiredSlots_.begin(),
+                                   m_retiredSlots_.end(),
+                                   [retireFrame](const RetiredSlot& retired) { return retired.frame > retireFrame; });
+
+  for (auto it = m_retiredSlots_.begin(); it != firstPending; ++it) {
+    m_freeSlots_.push_back(it->slot);
+  }
+  m_retiredSlots_.erase(m_retiredSlots_.begin(), firstPending);
+
+  return std::span<const uint32_t>(m_freeSlots_).subspan(recycledBegin);
+}
+
+void BindlessMaterialTable::SlotAllocator::recycleAll() {
+  for (const auto& retired : m_retiredSlots_) {
+    m_freeSlots_.push_back(retired.slot);
+  }
+  m_retiredSlots_.clear();
+}
+
+//-------------------------------------------------------------------------
+// BindlessMaterialTable implementation
+//-------------------------------------------------------------------------
+
+BindlessMaterialTable::BindlessMaterialTable(rhi::Device* device, RenderResourceManager* resourceManager)
+    : m_device_(device)
+    , m_resourceManager_(resourceManager) {
+}
+
+bool BindlessMaterialTable::initialize(uint32_t      framesInFlight,
+                                       rhi::Texture* defaultWhiteTexture,
+                                       rhi::Texture* defaultNormalTexture,
+                                       rhi::Texture* defaultBlackTexture) {
+  if (framesInFlight == 0 || !defaultWhiteTexture || !defaultNormalTexture || !defaultBlackTexture) {
+    LOG_ERROR("Invalid bindless material table parameters");
+    return false;
+  }
+
+  m_framesInFlight_       = framesInFlight;
+  m_frameNumber_          = 0;
+  m_defaultWhiteTexture_  = defaultWhiteTexture;
+  m_defaultNormalTexture_ = defaultNormalTexture;
+  m_defaultBlackTexture_  = defaultBlackTexture;
+
+  // binding 0 - material records, binding 1 - texture array (register t0 / t1... in HLSL)
+  rhi::DescriptorSetLayoutDesc        layoutDesc;
+  rhi::DescriptorSetLayoutBindingDesc recordBindingDesc;
+  recordBindingDesc.binding    = 0;
+  recordBindingDesc.type       = rhi::ShaderBindingType::BufferSrv;
+  recordBindingDesc.stageFlags = rhi::ShaderStageFlag::Fragment;
+  layoutDesc.bindings.push_back(recordBindingDesc);
+
+  rhi::DescriptorSetLayoutBindingDesc textureBindingDesc;
+  textureBindingDesc.binding         = 1;
+  textureBindingDesc.type            = rhi::ShaderBindingType::TextureSrv;
+  textureBindingDesc.descriptorCount = kMaxTextures;
+  textureBindingDesc.stageFlags      = rhi::ShaderStageFlag::Fragment;
+  layoutDesc.bindings.push_back(textureBindingDesc);
+
+  auto layout = m_device_->createDescriptorSetLayout(layoutDesc);
+  m_descriptorSetLayout_ = m_resourceManager_->addDescriptorSetLayout(std::move(layout), "bindless_material_layout");
+
+  rhi::BufferDesc bufferDesc;
+  bufferDesc.size        = kMaxMaterials * sizeof(MaterialRecord);
+  bufferDesc.createFlags = rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ShaderResource;
+  bufferDesc.type        = rhi::BufferType::Dynamic;
+  bufferDesc.stride      = sizeof(MaterialRecord);
+  bufferDesc.debugName   = "bindless_material_buffer";
+
+  auto buffer = m_device_->createBuffer(bufferDesc);
+  if (!buffer) {
+    LOG_ERROR("Failed to create bindless material buffer");
+    return false;
+  }
+  m_materialBuffer_ = m_resourceManager_->addBuffer(std::move(buffer), "bindless_material_buffer");
+
+  auto descriptorSet = m_device_->createDescriptorSet(m_descriptorSetLayout_);
+  descriptorSet->setStorageBuffer(0, m_materialBuffer_);
+  m_descriptorSet_ = m_resourceManager_->addDescriptorSet(std::move(descriptorSet), "bindless_material_descriptor_set");
+
+  m_materialSlots_.reset(kMaxMaterials);
+  m_textureSlots_.reset(kMaxTextures);
+
+  // default textures hold a reference for the lifetime of the table
+  for (rhi::Texture* texture : {m_defaultWhiteTexture_, m_defaultNormalTexture_, m_defaultBlackTexture_}) {
+    acquireTexture_(texture, nullptr);
+  }
+
+  return true;
+}
+
+void BindlessMaterialTable::cleanup() {
+  // layout, set and buffer are owned by the resource manager
+  m_materials_.clear();
+  m_textures_.clear();
+  m_materialSlots_.reset(0);
+  m_textureSlots_.reset(0);
+
+  m_descriptorSetLayout_  = nullptr;
+  m_descriptorSet_        = nullptr;
+  m_materialBuffer_       = nullptr;
+  m_defaultWhiteTexture_  = nullptr;
+  m_defaultNormalTexture_ = nullptr;
+  m_defaultBlackTexture_  = nullptr;
+  m_framesInFlight_       = 0;
+  m_frameNumber_          = 0;
+}
+
+void BindlessMaterialTable::beginFrame() {
+  ++m_frameNumber_;
+
+  // the fence of this frame slot was waited on - every frame up to (current - framesInFlight) has completed
+  if (m_frameNumber_ >= m_framesInFlight_) {
+    const uint64_t retireFrame = m_frameNumber_ - m_framesInFlight_;
+    m_materialSlots_.recycle(retireFrame);
+
+    // no frame in flight samples these slots anymore, so the views of released textures can be dropped
+    for (uint32_t slot : m_textureSlots_.recycle(retireFrame)) {
+      m_descriptorSet_->setTextureArrayElement(1, slot, m_defaultWhiteTexture_);
+    }
+  }
+}
+
+uint32_t BindlessMaterialTable::getOrCreateMaterial(ecs::Material* material) {
+  if (!material || !m_descriptorSet_) {
+    return kInvalidIndex;
+  }
+
+  if (!material->handle.isValid()) {
+    LOG_ERROR("Material '{}' is not owned by MaterialManager", material->materialName);
+    return kInvalidIndex;
+  }
+
+  if (auto entry = m_materials_.find(material->handle)) {
+    return entry->slot;
+  }
+
+  // the material that used the handle slot before was removed without being released
+  if (auto staleEntry = m_materials_.findStale(material->handle)) {
+    LOG_DEBUG("Releasing bindless material slot {} of a removed material", staleEntry->value.slot);
+    releaseMaterialEntry_(staleEntry->value);
+    m_materials_.erase(staleEntry->handle);
+  }
+
+  const uint32_t slot = m_materialSlots_.allocate();
+  if (slot == kInvalidIndex) {
+    if (!m_overflowReported_) {
+      LOG_ERROR("Bindless material table is full ({} materials)", kMaxMaterials);
+      m_overflowReported_ = true;
+    }
+    return kInvalidIndex;
+  }
+
+  auto findTexture = [material](StringId name) -> rhi::Texture* {
+    auto texture = material->textures.find(name);
+    return texture ? *texture : nullptr;
+  };
+
+  MaterialEntry entry;
+  entry.slot        = slot;
+  entry.textures[0] = findTexture("albedo"_sid);
+  entry.textures[1] = findTexture("normal_map"_sid);
+  entry.textures[2] = findTexture("metallic_roughness"_sid);
+
+  MaterialRecord record           = {};
+  record.albedoTexture            = acquireTexture_(entry.textures[0], m_defaultWhiteTexture_);
+  record.normalTexture            = acquireTexture_(entry.textures[1], m_defaultNormalTexture_);
+  record.metallicRoughnessTexture = acquireTexture_(entry.textures[2], m_defaultBlackTexture_);
+
+  auto colorIt     = material->vectorParameters.find("base_color");
+  record.baseColor
+      = colorIt != material->vectorParameters.end() ? colorIt->second : math::Vector4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+  auto metallicIt = material->scalarParameters.find("metallic");
+  record.metallic = metallicIt != material->scalarParameters.end() ? metallicIt->second : 0.0f;
+
+  auto roughnessIt = material->scalarParameters.find("roughness");
+  record.roughness = roughnessIt != material->scalarParameters.end() ? roughnessIt->second : 1.0f;
+
+  auto opacityIt = material->scalarParameters.find("opacity");
+  record.opacity = opacityIt != material->scalarParameters.end() ? opacityIt->second : 1.0f;
+
+  record.alphaCutoff = material->alphaCutoff;
+
+  // the slot is either fresh or retired, no frame in flight reads it
+  m_device_->updateBuffer(m_materialBuffer_, &record, sizeof(record), slot * sizeof(MaterialRecord));
+
+  m_materials_[material->handle] = entry;
+  return slot;
+}
+
+void BindlessMaterialTable::releaseMaterial(ecs::Material* material) {
+  if (!material) {
+    return;
+  }
+
+  auto entry = m_materials_.find(material->handle);
+  if (!entry) {
+    return;
+  }
+
+  releaseMaterialEntry_(*entry);
+  m_materials_.erase(material->handle);
+}
+
+void BindlessMaterialTable::releaseUnusedMaterials(const FrameUnorderedSet<Handle<ecs::Material>>& activeMaterials) {
+  for (auto& [handle, entry] : m_materials_) {
+    if (!activeMaterials.contains(handle)) {
+      LOG_DEBUG("Releasing bindless material slot {} of deleted material with handle: {:#x}",
+                entry.slot,
+                handle.getValue());
+      releaseMaterialEntry_(entry);
+      m_materials_.erase(handle);
+    }
+  }
+}
+
+void BindlessMaterialTable::clear() {
+  for (const auto& [handle, entry] : m_materials_) {
+    releaseMaterialEntry_(entry);
+  }
+  m_materials_.clear();
+
+  m_materialSlots_.recycleAll();
+  m_textureSlots_.recycleAll();
+  m_overflowReported_ = false;
+}
+
+uint32_t BindlessMaterialTable::acquireTexture_(rhi::Texture*& texture, rhi::Texture* fallback) {
+  if (!texture) {
+    texture = fallback;
+  }
+
+  auto it = m_textures_.find(texture);
+  if (it != m_textures_.end()) {
+    it->second.refCount++;
+    return it->second.slot;
+  }
+
+  const uint32_t slot = m_textureSlots_.allocate();
+  if (slot == kInvalidIndex) {
+    LOG_WARN("Bindless texture table is full ({} textures), using fallback texture", kMaxTextures);
+    // fallbacks are default textures, which are registered first and never released
+    texture         = fallback ? fallback : m_defaultWhiteTexture_;
+    auto fallbackIt = m_textures_.find(texture);
+    fallbackIt->second.refCount++;
+    return fallbackIt->second.slot;
+  }
+
+  m_descriptorSet_->setTextureArrayElement(1, slot, texture);
+
+  m_textures_.emplace(texture, TextureEntry{slot, 1});
+  return slot;
+}
+
+void BindlessMaterialTable::releaseTexture_(rhi::Texture* texture) {
+  auto it = m_textures_.find(texture);
+  if (it == m_textures_.end() || --it->second.refCount > 0) {
+    return;
+  }
+
+  // frames in flight may still sample the slot - it's reset once recycled in beginFrame()
+  m_textureSlots_.release(it->second.slot, m_frameNumber_);
+  m_textures_.erase(it);
+}
+
+void BindlessMaterialTable::releaseMaterialEntry_(const MaterialEntry& entry) {
+  for (rhi::Texture* texture : entry.textures) {
+    releaseTexture_(texture);
+  }
+
+  m_materialSlots_.release(entry.slot, m_frameNumber_);
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
@@ -0,0 +1,175 @@
+#ifndef ARISE_BINDLESS_MATERIAL_TABLE_H
+#define ARISE_BINDLESS_MATERIAL_TABLE_H
+
+#include "gfx/rhi/interface/buffer.h"
+#include "gfx/rhi/interface/descriptor.h"
+#include "gfx/rhi/interface/device.h"
+#include "gfx/rhi/interface/texture.h"
+#include "utils/handle/handle_side_table.h"
+#include "utils/math/math_util.h"
+#include "utils/memory/linear_allocator.h"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace arise {
+namespace ecs {
+struct Material;
+}  // namespace ecs
+}  // namespace arise
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+class RenderResourceManager;
+
+/**
+ * Bindless material data: one structured buffer of packed material records and one descriptor array with all
+ * textures the records reference (Materials / MaterialTextures in bindless_material.hlsli).
+ *
+ * The table is a single descriptor set that is bound once per pipeline, shaders fetch the record by material
+ * index and sample MaterialTextures[record.albedoTexture] etc. Switching materials between draws (or between
+ * instances of one draw) therefore changes no GPU state.
+ *
+ * Material and texture slots are stable while in use. Textures are reference counted by the materials that
+ * use them. Released slots are recycled only after every frame in flight that could still read them completed
+ * (see beginFrame()).
+ */
+class BindlessMaterialTable {
+  public:
+  static constexpr uint32_t kMaxMaterials = 4096;
+  static constexpr uint32_t kMaxTextures  = rhi::kMaxBindlessDescriptors;
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  // GPU layout of one element of the material record buffer (MaterialRecord in HLSL)
+  struct MaterialRecord {
+    math::Vector4f baseColor;
+    float          metallic;
+    float          roughness;
+    float          opacity;
+    float          alphaCutoff;
+    uint32_t       albedoTexture;  // indices into the texture array
+    uint32_t       normalTexture;
+    uint32_t       metallicRoughnessTexture;
+    uint32_t       padding;
+  };
+
+  static_assert(sizeof(MaterialRecord) == 12 * sizeof(float), "MaterialRecord must match the HLSL layout");
+
+  BindlessMaterialTable(rhi::Device* device, RenderResourceManager* resourceManager);
+
+  /**
+   * Default textures are used for texture slots a material does not provide and occupy the first slots
+   */
+  bool initialize(uint32_t      framesInFlight,
+                  rhi::Texture* defaultWhiteTexture,
+                  rhi::Texture* defaultNormalTexture,
+                  rhi::Texture* defaultBlackTexture);
+
+  void cleanup();
+
+  /**
+   * Advances the frame counter and recycles slots released at least framesInFlight frames ago.
+   * Call it after the fence of the new frame was waited on
+   */
+  void beginFrame();
+
+  /**
+   * @return index of the material record, allocated (and its textures registered) on first use;
+   *         kInvalidIndex if the table is full
+   */
+  uint32_t getOrCreateMaterial(ecs::Material* material);
+
+  void releaseMaterial(ecs::Material* material);
+
+  void releaseUnusedMaterials(const FrameUnorderedSet<Handle<ecs::Material>>& activeMaterials);
+
+  /**
+   * Releases all materials at once and recycles their slots immediately - the GPU must be idle
+   */
+  void clear();
+
+  rhi::DescriptorSet*       getDescriptorSet() const { return m_descriptorSet_; }
+  rhi::DescriptorSetLayout* getDescriptorSetLayout() const { return m_descriptorSetLayout_; }
+
+  uint32_t getMaterialCount() const { return static_cast<uint32_t>(m_materials_.size()); }
+  uint32_t getTextureCount() const { return static_cast<uint32_t>(m_textures_.size()); }
+
+  private:
+  /**
+   * Free list of table slots. Released slots wait until the GPU can no longer read them
+   */
+  class SlotAllocator {
+    public:
+    void reset(uint32_t capacity);
+
+    uint32_t allocate();
+
+    void release(uint32_t slot, uint64_t frame);
+
+    // moves slots released before retireFrame (inclusive) back to the free list, returns them (valid until the next
+    // allocate())
+    std::span<const uint32_t> recycle(uint64_t retireFrame);
+
+    void recycleAll();
+
+    private:
+    struct RetiredSlot {
+      uint32_t slot;
+      uint64_t frame;
+    };
+
+    std::vector<uint32_t>    m_freeSlots_;
+    std::vector<RetiredSlot> m_retiredSlots_;
+    uint32_t                 m_capacity_ = 0;
+    uint32_t                 m_next_     = 0;  // slots below were handed out at least once
+  };
+
+  struct TextureEntry {
+    uint32_t slot     = kInvalidIndex;
+    uint32_t refCount = 0;
+  };
+
+  struct MaterialEntry {
+    uint32_t      slot = kInvalidIndex;
+    rhi::Texture* textures[3]{};  // albedo, normal map, metallic roughness (or their fallbacks)
+  };
+
+  // texture is replaced by the texture that actually holds the reference (fallback when null or table is full)
+  uint32_t acquireTexture_(rhi::Texture*& texture, rhi::Texture* fallback);
+  void     releaseTexture_(rhi::Texture* texture);
+
+  void releaseMaterialEntry_(const MaterialEntry& entry);
+
+  rhi::Device*           m_device_          = nullptr;
+  RenderResourceManager* m_resourceManager_ = nullptr;
+
+  rhi::DescriptorSetLayout* m_descriptorSetLayout_ = nullptr;
+  rhi::DescriptorSet*       m_descriptorSet_       = nullptr;
+  rhi::Buffer*              m_materialBuffer_      = nullptr;
+
+  rhi::Texture* m_defaultWhiteTexture_  = nullptr;
+  rhi::Texture* m_defaultNormalTexture_ = nullptr;
+  rhi::Texture* m_defaultBlackTexture_  = nullptr;
+
+  SlotAllocator m_materialSlots_;
+  SlotAllocator m_textureSlots_;
+
+  // keyed by the material handle, an entry left by a removed material is never returned for a new one
+  HandleSideTable<ecs::Material, MaterialEntry>   m_materials_;
+  std::unordered_map<rhi::Texture*, TextureEntry> m_textures_;
+
+  uint32_t m_framesInFlight_ = 0;
+  uint64_t m_frameNumber_    = 0;
+
+  bool m_overflowReported_ = false;
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_BINDLESS_MATERIAL_TABLE_H
@@ -53,7 +53,10 @@ void BoundingBoxVisualizationStrategy::resize(const math::Dimension2i& newDimens
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffers_(newDimension);
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffers_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void BoundingBoxVisualizationStrategy::prepareFrame(const RenderContext& context) {
@@ -97,7 +100,8 @@ void BoundingBoxVisualizationStrategy::prepareFrame(const RenderContext& context
   }
 
   for (auto& [model, boundingBoxDataList] : currentFrameInstances) {
-    auto& cache = m_instanceBufferCache[model];
+    auto& cache = m_instanceBufferCache[model->handle];
+    cache.model = model;
 
     bool needsUpdate = cache.instanceBuffer == nullptr ||              // Buffer not created yet
                        boundingBoxDataList.size() > cache.capacity ||  // Need more space
@@ -122,7 +126,7 @@ void BoundingBoxVisualizationStrategy::render(const RenderContext& context) {
   }
 
   uint32_t currentIndex = context.currentImageIndex;
-  if (currentIndex >= m_framebuffers.size()) {
+  if (currentIndex >= m_framebuffers.size() || !m_framebuffers[currentIndex]) {
     LOG_ERROR("Invalid framebuffer index");
     return;
   }
@@ -155,13 +159,7 @@ void BoundingBoxVisualizationStrategy::render(const RenderContext& context) {
 
       if (drawData.pipeline->hasBindingSlot(0)) {
         if (auto* viewSet = m_frameResources->getViewDescriptorSet()) {
-          commandBuffer->bindDescriptorSet(0, viewSet);
-        }
-      }
-
-      if (drawData.pipeline->hasBindingSlot(1)) {
-        if (drawData.modelMatrixDescriptorSet) {
-          commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
+          commandBuffer->bindDescriptorSet(0, viewSet, {m_frameResources->getViewDynamicOffset()});
         }
       }
 
@@ -242,11 +240,16 @@ void BoundingBoxVisualizationStrategy::createFramebuffers_(const math::Dimension
 
     auto& renderTargets = m_frameResources->getRenderTargets(i);
 
+    if (!renderTargets.depthBuffer) {
+      m_framebuffers.push_back(nullptr);
+      continue;
+    }
+
     rhi::FramebufferDesc framebufferDesc;
     framebufferDesc.width  = dimension.width();
     framebufferDesc.height = dimension.height();
     framebufferDesc.colorAttachments.push_back(renderTargets.colorBuffer.get());
-    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer.get();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
     framebufferDesc.hasDepthStencil        = true;
     framebufferDesc.renderPass             = m_renderPass;
 
@@ -260,12 +263,12 @@ void BoundingBoxVisualizationStrategy::createFramebuffers_(const math::Dimension
 void BoundingBoxVisualizationStrategy::prepareDrawCalls_(const RenderContext& context) {
   m_drawData.clear();
 
-  for (const auto& [model, cache] : m_instanceBufferCache) {
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
     if (cache.count == 0) {
       continue;
     }
 
-    std::string pipelineKey = "bounding_box_pipeline";
+    constexpr StringId pipelineKey = "bounding_box_pipeline"_sid;
 
     rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
 
@@ -318,7 +321,8 @@ void BoundingBoxVisualizationStrategy::prepareDrawCalls_(const RenderContext& co
         shaders.push_back(m_pixelShader);
       }
 
-      rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+      rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+          shaders, {FrameResources::kViewUniformBufferBinding});
 
       auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
       pipelineDesc.setLayouts = layoutPtrs;
@@ -337,14 +341,13 @@ void BoundingBoxVisualizationStrategy::prepareDrawCalls_(const RenderContext& co
       continue;
     }
 
-    if (!model->renderMeshes.empty()) {
-      auto renderMesh = model->renderMeshes[0];
+    if (!cache.model->renderMeshes.empty()) {
+      auto renderMesh = cache.model->renderMeshes[0];
 
       DrawData drawData;
-      drawData.pipeline                 = pipeline;
-      drawData.modelMatrixDescriptorSet = m_frameResources->getOrCreateModelMatrixDescriptorSet(renderMesh);
-      drawData.instanceBuffer           = cache.instanceBuffer;
-      drawData.instanceCount            = cache.count;
+      drawData.pipeline       = pipeline;
+      drawData.instanceBuffer = cache.instanceBuffer;
+      drawData.instanceCount  = cache.count;
 
       m_drawData.push_back(drawData);
     }
@@ -357,7 +360,7 @@ void BoundingBoxVisualizationStrategy::updateInstanceBuffer_(ecs::RenderModel*
   if (!cache.instanceBuffer || boundingBoxData.size() > cache.capacity) {
     uint32_t newCapacity = std::max(static_cast<uint32_t>(boundingBoxData.size() * 1.5), 8u);
 
-    std::string bufferKey = "bounding_box_instance_buffer_" + std::to_string(reinterpret_cast<uintptr_t>(model));
+    std::string bufferKey = "bounding_box_instance_buffer_" + std::to_string(model->handle.getValue());
 
     rhi::BufferDesc bufferDesc;
     bufferDesc.size        = newCapacity * sizeof(BoundingBoxData);
@@ -381,17 +384,12 @@ void BoundingBoxVisualizationStrategy::updateInstanceBuffer_(ecs::RenderModel*
 
 void BoundingBoxVisualizationStrategy::cleanupUnusedBuffers_(
     const std::unordered_map<ecs::RenderModel*, std::vector<BoundingBoxData>>& currentFrameInstances) {
-  std::vector<ecs::RenderModel*> modelsToRemove;
-
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (!currentFrameInstances.contains(model)) {
-      modelsToRemove.push_back(model);
+  // the model is only dereferenced while it is in the frame, entries of removed models are dropped
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
+    if (!currentFrameInstances.contains(cache.model) || cache.model->handle != handle) {
+      m_instanceBufferCache.erase(handle);
     }
   }
-
-  for (auto model : modelsToRemove) {
-    m_instanceBufferCache.erase(model);
-  }
 }
 
 void BoundingBoxVisualizationStrategy::createBoundingBoxGeometry_() {
@@ -3,6 +3,7 @@
 
 #include "gfx/renderer/debug_strategies/debug_draw_strategy.h"
 #include "gfx/rhi/shader_reflection/pipeline_layout_manager.h"
+#include "utils/handle/handle_side_table.h"
 
 #include <unordered_map>
 #include <vector>
@@ -60,16 +61,16 @@ class BoundingBoxVisualizationStrategy : public DebugDrawStrategy {
   };
 
   struct ModelBufferCache {
-    rhi::Buffer* instanceBuffer = nullptr;
-    uint32_t     capacity       = 0;
-    uint32_t     count          = 0;
+    ecs::RenderModel* model          = nullptr;
+    rhi::Buffer*      instanceBuffer = nullptr;
+    uint32_t          capacity       = 0;
+    uint32_t          count          = 0;
   };
 
   struct DrawData {
-    rhi::GraphicsPipeline* pipeline                 = nullptr;
-    rhi::DescriptorSet*    modelMatrixDescriptorSet = nullptr;
-    rhi::Buffer*           instanceBuffer           = nullptr;
-    uint32_t               instanceCount            = 0;
+    rhi::GraphicsPipeline* pipeline       = nullptr;
+    rhi::Buffer*           instanceBuffer = nullptr;
+    uint32_t               instanceCount  = 0;
   };
 
   void setupRenderPass_();
@@ -98,13 +99,14 @@ class BoundingBoxVisualizationStrategy : public DebugDrawStrategy {
 
   rhi::RenderPass*               m_renderPass = nullptr;
   std::vector<rhi::Framebuffer*> m_framebuffers;
+  uint32_t                       m_renderTargetGeneration = 0;
 
   // Geometry for unit cube wireframe (will be scaled by bounding box)
   rhi::Buffer* m_cubeVertexBuffer = nullptr;
   rhi::Buffer* m_cubeIndexBuffer  = nullptr;
 
-  std::unordered_map<ecs::RenderModel*, ModelBufferCache> m_instanceBufferCache;
-  std::vector<DrawData>                                   m_drawData;
+  HandleSideTable<ecs::RenderModel, ModelBufferCache> m_instanceBufferCache;
+  std::vector<DrawData>                               m_drawData;
 
   rhi::PipelineLayoutManager m_layoutManager;
 };
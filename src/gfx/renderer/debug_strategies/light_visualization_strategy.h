@@ -4,6 +4,9 @@
 #include "gfx/renderer/debug_strategies/debug_draw_strategy.h"
 #include "gfx/rhi/interface/render_pass.h"
 #include "gfx/rhi/shader_reflection/pipeline_layout_manager.h"
+#include "utils/handle/handle_side_table.h"
+
+#include <math_library/matrix.h>
 
 #include <unordered_map>
 #include <vector>
@@ -49,20 +52,21 @@ class LightVisualizationStrategy : public DebugDrawStrategy {
 
   private:
   struct ModelBufferCache {
-    rhi::Buffer* instanceBuffer = nullptr;
-    uint32_t     capacity       = 0;
-    uint32_t     count          = 0;
+    ecs::RenderModel* model          = nullptr;
+    rhi::Buffer*      instanceBuffer = nullptr;
+    uint32_t          capacity       = 0;
+    uint32_t          count          = 0;
   };
 
   struct DrawData {
-    rhi::GraphicsPipeline* pipeline                 = nullptr;
-    rhi::DescriptorSet*    modelMatrixDescriptorSet = nullptr;
-    rhi::DescriptorSet*    materialDescriptorSet    = nullptr;
-    rhi::Buffer*           vertexBuffer             = nullptr;
-    rhi::Buffer*           indexBuffer              = nullptr;
-    rhi::Buffer*           instanceBuffer           = nullptr;
-    uint32_t               indexCount               = 0;
-    uint32_t               instanceCount            = 0;
+    rhi::GraphicsPipeline* pipeline              = nullptr;
+    math::Matrix4f<>       modelMatrix           = math::Matrix4f<>::Identity();  // pushed as ModelParam
+    rhi::DescriptorSet*    materialDescriptorSet = nullptr;
+    rhi::Buffer*           vertexBuffer          = nullptr;
+    rhi::Buffer*           indexBuffer           = nullptr;
+    rhi::Buffer*           instanceBuffer        = nullptr;
+    uint32_t               indexCount            = 0;
+    uint32_t               instanceCount         = 0;
   };
 
   rhi::DescriptorSet* getOrCreateMaterialDescriptorSet_(ecs::Material* material);
@@ -92,15 +96,16 @@ class LightVisualizationStrategy : public DebugDrawStrategy {
 
   rhi::RenderPass*               m_renderPass = nullptr;
   std::vector<rhi::Framebuffer*> m_framebuffers;
+  uint32_t                       m_renderTargetGeneration = 0;
 
-  std::unordered_map<ecs::RenderModel*, ModelBufferCache> m_instanceBufferCache;
-  std::vector<DrawData>                                   m_drawData;
+  HandleSideTable<ecs::RenderModel, ModelBufferCache> m_instanceBufferCache;
+  std::vector<DrawData>                               m_drawData;
 
   struct MaterialCache {
     rhi::DescriptorSet* descriptorSet = nullptr;
   };
 
-  std::unordered_map<ecs::Material*, MaterialCache> m_materialCache;
+  HandleSideTable<ecs::Material, MaterialCache> m_materialCache;
   rhi::DescriptorSetLayout*                         m_materialDescriptorSetLayout = nullptr;
 
   rhi::PipelineLayoutManager m_layoutManager;
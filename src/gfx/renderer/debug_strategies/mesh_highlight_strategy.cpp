@@ -62,7 +62,10 @@ void MeshHighlightStrategy::resize(const math::Dimension2i& newDimension) {
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffers_(newDimension);
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffers_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void MeshHighlightStrategy::prepareFrame(const RenderContext& context) {
@@ -95,7 +98,8 @@ void MeshHighlightStrategy::prepareFrame(const RenderContext& context) {
   }
 
   for (auto& [model, matrices] : currentFrameInstances) {
-    auto& cache = m_instanceBufferCache[model];
+    auto& cache = m_instanceBufferCache[model->handle];
+    cache.model = model;
 
     bool needsUpdate = cache.instanceBuffer == nullptr || matrices.size() > cache.capacity
                     || matrices.size() != cache.count || modelDirtyFlags[model];
@@ -116,7 +120,7 @@ void MeshHighlightStrategy::render(const RenderContext& context) {
   }
 
   uint32_t currentIndex = context.currentImageIndex;
-  if (currentIndex >= m_framebuffers.size()) {
+  if (currentIndex >= m_framebuffers.size() || !m_framebuffers[currentIndex]) {
     LOG_ERROR("Invalid framebuffer index");
     return;
   }
@@ -146,11 +150,10 @@ void MeshHighlightStrategy::render(const RenderContext& context) {
     commandBuffer->setPipeline(drawData.stencilMarkPipeline);
 
     if (drawData.stencilMarkPipeline->hasBindingSlot(0) && m_frameResources->getViewDescriptorSet()) {
-      commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
-    }
-    if (drawData.stencilMarkPipeline->hasBindingSlot(1) && drawData.modelMatrixDescriptorSet) {
-      commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
+      commandBuffer->bindDescriptorSet(
+          0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
     }
+    commandBuffer->pushConstants(drawData.modelMatrix);
 
     commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
     commandBuffer->bindVertexBuffer(1, drawData.instanceBuffer);
@@ -164,13 +167,12 @@ void MeshHighlightStrategy::render(const RenderContext& context) {
     commandBuffer->setPipeline(drawData.outlinePipeline);
 
     if (drawData.outlinePipeline->hasBindingSlot(0) && m_frameResources->getViewDescriptorSet()) {
-      commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
-    }
-    if (drawData.outlinePipeline->hasBindingSlot(1) && drawData.modelMatrixDescriptorSet) {
-      commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
+      commandBuffer->bindDescriptorSet(
+          0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
     }
-    if (drawData.outlinePipeline->hasBindingSlot(2) && drawData.highlightParamsDescriptorSet) {
-      commandBuffer->bindDescriptorSet(2, drawData.highlightParamsDescriptorSet);
+    commandBuffer->pushConstants(drawData.modelMatrix);
+    if (drawData.outlinePipeline->hasBindingSlot(1) && drawData.highlightParamsDescriptorSet) {
+      commandBuffer->bindDescriptorSet(1, drawData.highlightParamsDescriptorSet);
     }
 
     commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
@@ -250,11 +252,16 @@ void MeshHighlightStrategy::createFramebuffers_(const math::Dimension2i& dimensi
 
     auto& renderTargets = m_frameResources->getRenderTargets(i);
 
+    if (!renderTargets.depthBuffer) {
+      m_framebuffers.push_back(nullptr);
+      continue;
+    }
+
     rhi::FramebufferDesc framebufferDesc;
     framebufferDesc.width  = dimension.width();
     framebufferDesc.height = dimension.height();
     framebufferDesc.colorAttachments.push_back(renderTargets.colorBuffer.get());
-    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer.get();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
     framebufferDesc.hasDepthStencil        = true;
     framebufferDesc.renderPass             = m_renderPass;
 
@@ -271,7 +278,7 @@ void MeshHighlightStrategy::updateInstanceBuffer_(ecs::RenderModel*
   if (!cache.instanceBuffer || matrices.size() > cache.capacity) {
     uint32_t newCapacity = std::max(static_cast<uint32_t>(matrices.size() * 1.5), 8u);
 
-    std::string bufferKey = "highlight_instance_buffer_" + std::to_string(reinterpret_cast<uintptr_t>(model));
+    std::string bufferKey = "highlight_instance_buffer_" + std::to_string(model->handle.getValue());
 
     rhi::BufferDesc bufferDesc;
     bufferDesc.size        = newCapacity * sizeof(math::Matrix4f<>);
@@ -333,13 +340,13 @@ rhi::DescriptorSet* MeshHighlightStrategy::getOrCreateHighlightParamsDescriptorS
   return descriptorSetPtr;
 }
 
-rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateStencilMarkPipeline_(const std::string& pipelineKey) {
+rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateStencilMarkPipeline_(StringId pipelineKey) {
   auto& cache = m_pipelineCache[pipelineKey];
   if (cache.stencilMarkPipeline) {
     return cache.stencilMarkPipeline;
   }
 
-  std::string stencilPipelineKey = pipelineKey + "_stencil_mark";
+  const StringId stencilPipelineKey = pipelineKey.combine("stencil_mark"_sid);
 
   rhi::GraphicsPipelineDesc pipelineDesc;
 
@@ -405,7 +412,8 @@ rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateStencilMarkPipeline_(co
     shaders.push_back(m_pixelShader);
   }
 
-  rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+  rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+      shaders, {FrameResources::kViewUniformBufferBinding});
 
   auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
   pipelineDesc.setLayouts = layoutPtrs;
@@ -421,8 +429,8 @@ rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateStencilMarkPipeline_(co
   return cache.stencilMarkPipeline;
 }
 
-rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateOutlinePipeline_(const std::string& pipelineKey, bool xRay) {
-  std::string fullPipelineKey = pipelineKey + (xRay ? "_outline_xray" : "_outline_normal");
+rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateOutlinePipeline_(StringId pipelineKey, bool xRay) {
+  const StringId fullPipelineKey = pipelineKey.combine(xRay ? "outline_xray"_sid : "outline_normal"_sid);
 
   auto& cache = m_pipelineCache[fullPipelineKey];
   if (cache.outlinePipeline) {
@@ -502,8 +510,8 @@ rhi::GraphicsPipeline* MeshHighlightStrategy::getOrCreateOutlinePipeline_(const
     outlineShaders.push_back(m_pixelShader);
   }
 
-  rhi::PipelineLayoutDesc outlineReflectionLayout
-      = rhi::pipeline_utils::generatePipelineLayoutFromShaders(outlineShaders);
+  rhi::PipelineLayoutDesc outlineReflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+      outlineShaders, {FrameResources::kViewUniformBufferBinding});
 
   auto outlineLayoutPtrs  = m_layoutManager.createAndManageLayouts(m_device, outlineReflectionLayout);
   pipelineDesc.setLayouts = outlineLayoutPtrs;
@@ -529,18 +537,16 @@ void MeshHighlightStrategy::prepareDrawCalls_(const RenderContext& context) {
     auto& selectedComp = view.get<ecs::Selected>(entity);
     auto* renderModel  = view.get<ecs::RenderModel*>(entity);
 
-    auto it = m_instanceBufferCache.find(renderModel);
-    if (it == m_instanceBufferCache.end() || it->second.count == 0) {
+    auto cache = m_instanceBufferCache.find(renderModel->handle);
+    if (!cache || cache->count == 0) {
       continue;
     }
 
-    auto& cache = it->second;
-
     auto* highlightParamsDescriptorSet = getOrCreateHighlightParamsDescriptorSet_(
         selectedComp.highlightColor, selectedComp.outlineThickness, selectedComp.xRay);
 
     for (const auto& renderMesh : renderModel->renderMeshes) {
-      std::string pipelineKey = "highlight_pipeline";
+      constexpr StringId pipelineKey = "highlight_pipeline"_sid;
 
       rhi::GraphicsPipeline* stencilMarkPipeline = getOrCreateStencilMarkPipeline_(pipelineKey);
       rhi::GraphicsPipeline* outlinePipeline     = getOrCreateOutlinePipeline_(pipelineKey, selectedComp.xRay);
@@ -553,13 +559,13 @@ void MeshHighlightStrategy::prepareDrawCalls_(const RenderContext& context) {
       DrawData drawData;
       drawData.stencilMarkPipeline          = stencilMarkPipeline;
       drawData.outlinePipeline              = outlinePipeline;
-      drawData.modelMatrixDescriptorSet     = m_frameResources->getOrCreateModelMatrixDescriptorSet(renderMesh);
+      drawData.modelMatrix                  = renderMesh->transformMatrix;
       drawData.highlightParamsDescriptorSet = highlightParamsDescriptorSet;
       drawData.vertexBuffer                 = renderMesh->gpuMesh->vertexBuffer;
       drawData.indexBuffer                  = renderMesh->gpuMesh->indexBuffer;
-      drawData.instanceBuffer               = cache.instanceBuffer;
+      drawData.instanceBuffer               = cache->instanceBuffer;
       drawData.indexCount                   = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
-      drawData.instanceCount                = cache.count;
+      drawData.instanceCount                = cache->count;
 
       m_drawData.push_back(drawData);
     }
@@ -568,17 +574,12 @@ void MeshHighlightStrategy::prepareDrawCalls_(const RenderContext& context) {
 
 void MeshHighlightStrategy::cleanupUnusedBuffers_(
     const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances) {
-  std::vector<ecs::RenderModel*> modelsToRemove;
-
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (!currentFrameInstances.contains(model)) {
-      modelsToRemove.push_back(model);
+  // the model is only dereferenced while it is in the frame, entries of removed models are dropped
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
+    if (!currentFrameInstances.contains(cache.model) || cache.model->handle != handle) {
+      m_instanceBufferCache.erase(handle);
     }
   }
-
-  for (auto model : modelsToRemove) {
-    m_instanceBufferCache.erase(model);
-  }
 }
 
 }  // namespace renderer
@@ -3,6 +3,10 @@
 
 #include "gfx/renderer/debug_strategies/debug_draw_strategy.h"
 #include "gfx/rhi/shader_reflection/pipeline_layout_manager.h"
+#include "utils/handle/handle_side_table.h"
+#include "utils/string_id/string_id_map.h"
+
+#include <math_library/matrix.h>
 
 #include <unordered_map>
 #include <vector>
@@ -47,9 +51,10 @@ class MeshHighlightStrategy : public DebugDrawStrategy {
 
   private:
   struct ModelBufferCache {
-    rhi::Buffer* instanceBuffer = nullptr;
-    uint32_t     capacity       = 0;
-    uint32_t     count          = 0;
+    ecs::RenderModel* model          = nullptr;
+    rhi::Buffer*      instanceBuffer = nullptr;
+    uint32_t          capacity       = 0;
+    uint32_t          count          = 0;
   };
 
   struct HighlightParams {
@@ -62,7 +67,7 @@ class MeshHighlightStrategy : public DebugDrawStrategy {
   struct DrawData {
     rhi::GraphicsPipeline* stencilMarkPipeline          = nullptr;
     rhi::GraphicsPipeline* outlinePipeline              = nullptr;
-    rhi::DescriptorSet*    modelMatrixDescriptorSet     = nullptr;
+    math::Matrix4f<>       modelMatrix                  = math::Matrix4f<>::Identity();  // pushed as ModelParam
     rhi::DescriptorSet*    highlightParamsDescriptorSet = nullptr;
     rhi::Buffer*           vertexBuffer                 = nullptr;
     rhi::Buffer*           indexBuffer                  = nullptr;
@@ -80,8 +85,8 @@ class MeshHighlightStrategy : public DebugDrawStrategy {
   void cleanupUnusedBuffers_(
       const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances);
   rhi::DescriptorSet* getOrCreateHighlightParamsDescriptorSet_(const math::Vector4f& color, float thickness, bool xRay);
-  rhi::GraphicsPipeline* getOrCreateStencilMarkPipeline_(const std::string& pipelineKey);
-  rhi::GraphicsPipeline* getOrCreateOutlinePipeline_(const std::string& pipelineKey, bool xRay);
+  rhi::GraphicsPipeline* getOrCreateStencilMarkPipeline_(StringId pipelineKey);
+  rhi::GraphicsPipeline* getOrCreateOutlinePipeline_(StringId pipelineKey, bool xRay);
 
   const std::string m_stencilMarkVertexShaderPath_ = "assets/shaders/debug/mesh_highlight/stencil_mark.vs.hlsl";
   const std::string m_outlineVertexShaderPath_     = "assets/shaders/debug/mesh_highlight/shader_instancing.vs.hlsl";
@@ -101,9 +106,10 @@ class MeshHighlightStrategy : public DebugDrawStrategy {
 
   rhi::RenderPass*               m_renderPass = nullptr;
   std::vector<rhi::Framebuffer*> m_framebuffers;
+  uint32_t                       m_renderTargetGeneration = 0;
 
-  std::unordered_map<ecs::RenderModel*, ModelBufferCache> m_instanceBufferCache;
-  std::vector<DrawData>                                   m_drawData;
+  HandleSideTable<ecs::RenderModel, ModelBufferCache> m_instanceBufferCache;
+  std::vector<DrawData>                               m_drawData;
 
   rhi::DescriptorSetLayout*                                                  m_highlightParamsLayout = nullptr;
   std::unordered_map<uint64_t, std::pair<rhi::Buffer*, rhi::DescriptorSet*>> m_highlightParamsCache;
@@ -113,7 +119,7 @@ class MeshHighlightStrategy : public DebugDrawStrategy {
     rhi::GraphicsPipeline* outlinePipeline     = nullptr;
   };
 
-  std::unordered_map<std::string, PipelineCache> m_pipelineCache;
+  StringIdMap<PipelineCache> m_pipelineCache;
 
   rhi::PipelineLayoutManager m_layoutManager;
 };
@@ -62,7 +62,10 @@ void NormalMapVisualizationStrategy::resize(const math::Dimension2i& newDimensio
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffers_(newDimension);
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffers_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void NormalMapVisualizationStrategy::prepareFrame(const RenderContext& context) {
@@ -78,7 +81,8 @@ void NormalMapVisualizationStrategy::prepareFrame(const RenderContext& context)
   }
 
   for (auto& [model, matrices] : currentFrameInstances) {
-    auto& cache = m_instanceBufferCache[model];
+    auto& cache = m_instanceBufferCache[model->handle];
+    cache.model = model;
 
     bool needsUpdate = cache.instanceBuffer == nullptr ||   // Buffer not created yet
                        matrices.size() > cache.capacity ||  // Need more space
@@ -101,7 +105,7 @@ void NormalMapVisualizationStrategy::render(const RenderContext& context) {
   }
 
   uint32_t currentIndex = context.currentImageIndex;
-  if (currentIndex >= m_framebuffers.size()) {
+  if (currentIndex >= m_framebuffers.size() || !m_framebuffers[currentIndex]) {
     LOG_ERROR("Invalid framebuffer index");
     return;
   }
@@ -131,19 +135,18 @@ void NormalMapVisualizationStrategy::render(const RenderContext& context) {
     commandBuffer->setPipeline(drawData.pipeline);
 
     if (drawData.pipeline->hasBindingSlot(0) && m_frameResources->getViewDescriptorSet()) {
-      commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
+      commandBuffer->bindDescriptorSet(
+          0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
     }
 
-    if (drawData.pipeline->hasBindingSlot(1) && drawData.modelMatrixDescriptorSet) {
-      commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
-    }
+    commandBuffer->pushConstants(drawData.modelMatrix);
 
-    if (drawData.pipeline->hasBindingSlot(2) && drawData.materialDescriptorSet) {
-      commandBuffer->bindDescriptorSet(2, drawData.materialDescriptorSet);
+    if (drawData.pipeline->hasBindingSlot(1) && drawData.materialDescriptorSet) {
+      commandBuffer->bindDescriptorSet(1, drawData.materialDescriptorSet);
     }
 
-    if (drawData.pipeline->hasBindingSlot(3) && m_frameResources->getDefaultSamplerDescriptorSet()) {
-      commandBuffer->bindDescriptorSet(3, m_frameResources->getDefaultSamplerDescriptorSet());
+    if (drawData.pipeline->hasBindingSlot(2) && m_frameResources->getDefaultSamplerDescriptorSet()) {
+      commandBuffer->bindDescriptorSet(2, m_frameResources->getDefaultSamplerDescriptorSet());
     }
 
     commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
@@ -218,11 +221,16 @@ void NormalMapVisualizationStrategy::createFramebuffers_(const math::Dimension2i
 
     auto& renderTargets = m_frameResources->getRenderTargets(i);
 
+    if (!renderTargets.depthBuffer) {
+      m_framebuffers.push_back(nullptr);
+      continue;
+    }
+
     rhi::FramebufferDesc framebufferDesc;
     framebufferDesc.width  = dimension.width();
     framebufferDesc.height = dimension.height();
     framebufferDesc.colorAttachments.push_back(renderTargets.colorBuffer.get());
-    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer.get();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
     framebufferDesc.hasDepthStencil        = true;
     framebufferDesc.renderPass             = m_renderPass;
 
@@ -242,7 +250,7 @@ void NormalMapVisualizationStrategy::updateInstanceBuffer_(ecs::RenderModel*
     // Create a new buffer with some growth room
     uint32_t newCapacity = std::max(static_cast<uint32_t>(matrices.size() * 1.5), 8u);
 
-    std::string bufferKey = "normal_map_instance_buffer_" + std::to_string(reinterpret_cast<uintptr_t>(model));
+    std::string bufferKey = "normal_map_instance_buffer_" + std::to_string(model->handle.getValue());
 
     rhi::BufferDesc bufferDesc;
     bufferDesc.size        = newCapacity * sizeof(math::Matrix4f<>);
@@ -266,19 +274,19 @@ void NormalMapVisualizationStrategy::updateInstanceBuffer_(ecs::RenderModel*
 void NormalMapVisualizationStrategy::prepareDrawCalls_(const RenderContext& context) {
   m_drawData.clear();
 
-  for (const auto& [model, cache] : m_instanceBufferCache) {
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
     if (cache.count == 0) {
       continue;
     }
 
-    for (const auto& renderMesh : model->renderMeshes) {
+    for (const auto& renderMesh : cache.model->renderMeshes) {
       rhi::DescriptorSet* materialDescriptorSet = getOrCreateMaterialDescriptorSet_(renderMesh->material);
       if (!materialDescriptorSet) {
         LOG_WARN("Could not create material descriptor set for normal map visualization");
         continue;
       }
 
-      std::string pipelineKey = "normal_map_pipeline";
+      constexpr StringId pipelineKey = "normal_map_pipeline"_sid;
 
       rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
 
@@ -333,7 +341,8 @@ void NormalMapVisualizationStrategy::prepareDrawCalls_(const RenderContext& cont
           shaders.push_back(m_pixelShader);
         }
 
-        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+            shaders, {FrameResources::kViewUniformBufferBinding});
 
         auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
         pipelineDesc.setLayouts = layoutPtrs;
@@ -348,14 +357,14 @@ void NormalMapVisualizationStrategy::prepareDrawCalls_(const RenderContext& cont
       }
 
       DrawData drawData;
-      drawData.pipeline                 = pipeline;
-      drawData.modelMatrixDescriptorSet = m_frameResources->getOrCreateModelMatrixDescriptorSet(renderMesh);
-      drawData.materialDescriptorSet    = materialDescriptorSet;
-      drawData.vertexBuffer             = renderMesh->gpuMesh->vertexBuffer;
-      drawData.indexBuffer              = renderMesh->gpuMesh->indexBuffer;
-      drawData.instanceBuffer           = cache.instanceBuffer;
-      drawData.indexCount               = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
-      drawData.instanceCount            = cache.count;
+      drawData.pipeline              = pipeline;
+      drawData.modelMatrix           = renderMesh->transformMatrix;
+      drawData.materialDescriptorSet = materialDescriptorSet;
+      drawData.vertexBuffer          = renderMesh->gpuMesh->vertexBuffer;
+      drawData.indexBuffer           = renderMesh->gpuMesh->indexBuffer;
+      drawData.instanceBuffer        = cache.instanceBuffer;
+      drawData.indexCount            = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
+      drawData.instanceCount         = cache.count;
 
       m_drawData.push_back(drawData);
     }
@@ -364,39 +373,30 @@ void NormalMapVisualizationStrategy::prepareDrawCalls_(const RenderContext& cont
 
 void NormalMapVisualizationStrategy::cleanupUnusedBuffers_(
     const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances) {
-  std::vector<ecs::RenderModel*> modelsToRemove;
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (!currentFrameInstances.contains(model)) {
-      modelsToRemove.push_back(model);
+  // the model is only dereferenced while it is in the frame, entries of removed models are dropped
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
+    if (!currentFrameInstances.contains(cache.model) || cache.model->handle != handle) {
+      m_instanceBufferCache.erase(handle);
     }
   }
 
-  for (auto model : modelsToRemove) {
-    m_instanceBufferCache.erase(model);
-  }
-
-  std::unordered_set<ecs::Material*> activeMaterials;
+  std::unordered_set<Handle<ecs::Material>> activeMaterials;
 
   for (const auto& [model, matrices] : currentFrameInstances) {
     for (const auto& renderMesh : model->renderMeshes) {
       if (renderMesh->material) {
-        activeMaterials.insert(renderMesh->material);
+        activeMaterials.insert(renderMesh->material->handle);
       }
     }
   }
 
-  std::vector<ecs::Material*> materialsToRemove;
-  for (const auto& [material, cache] : m_materialCache) {
-    if (!activeMaterials.contains(material)) {
-      materialsToRemove.push_back(material);
+  for (const auto& [handle, cache] : m_materialCache) {
+    if (!activeMaterials.contains(handle)) {
+      LOG_DEBUG("Normal map visualization: Removing cached descriptor set of deleted material (handle: {:#x})",
+                handle.getValue());
+      m_materialCache.erase(handle);
     }
   }
-
-  for (auto material : materialsToRemove) {
-    LOG_DEBUG("Normal map visualization: Removing cached material descriptor set for deleted material at address: {}",
-              reinterpret_cast<uintptr_t>(material));
-    m_materialCache.erase(material);
-  }
 }
 
 rhi::DescriptorSet* NormalMapVisualizationStrategy::getOrCreateMaterialDescriptorSet_(ecs::Material* material) {
@@ -405,12 +405,12 @@ rhi::DescriptorSet* NormalMapVisualizationStrategy::getOrCreateMaterialDescripto
     return nullptr;
   }
 
-  auto it = m_materialCache.find(material);
-  if (it != m_materialCache.end() && it->second.descriptorSet) {
-    return it->second.descriptorSet;
+  auto cache = m_materialCache.find(material->handle);
+  if (cache && cache->descriptorSet) {
+    return cache->descriptorSet;
   }
 
-  std::string descriptorKey = "normal_map_material_" + std::to_string(reinterpret_cast<uintptr_t>(material));
+  std::string descriptorKey = "normal_map_material_" + std::to_string(material->handle.getValue());
 
   auto descriptorSetPtr = m_resourceManager->getDescriptorSet(descriptorKey);
   if (!descriptorSetPtr) {
@@ -418,9 +418,9 @@ rhi::DescriptorSet* NormalMapVisualizationStrategy::getOrCreateMaterialDescripto
 
     // Update the descriptor set BEFORE adding it to the resource manager
     rhi::Texture* normalMapTexture = nullptr;
-    auto          normalMapIt      = material->textures.find("normal_map");
-    if (normalMapIt != material->textures.end() && normalMapIt->second) {
-      normalMapTexture = normalMapIt->second;
+    auto          normalMap        = material->textures.find("normal_map"_sid);
+    if (normalMap && *normalMap) {
+      normalMapTexture = *normalMap;
     } else {
       normalMapTexture = m_frameResources->getDefaultNormalTexture();
 
@@ -432,7 +432,7 @@ rhi::DescriptorSet* NormalMapVisualizationStrategy::getOrCreateMaterialDescripto
     descriptorSetPtr = m_resourceManager->addDescriptorSet(std::move(descriptorSet), descriptorKey);
   }
 
-  m_materialCache[material].descriptorSet = descriptorSetPtr;
+  m_materialCache[material->handle].descriptorSet = descriptorSetPtr;
 
   return descriptorSetPtr;
 }
@@ -47,7 +47,10 @@ void ShaderOverdrawStrategy::resize(const math::Dimension2i& newDimension) {
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffers_(newDimension);
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffers_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void ShaderOverdrawStrategy::prepareFrame(const RenderContext& context) {
@@ -63,7 +66,8 @@ void ShaderOverdrawStrategy::prepareFrame(const RenderContext& context) {
   }
 
   for (auto& [model, matrices] : currentFrameInstances) {
-    auto& cache = m_instanceBufferCache[model];
+    auto& cache = m_instanceBufferCache[model->handle];
+    cache.model = model;
 
     bool needsUpdate = cache.instanceBuffer == nullptr ||   // Buffer not created yet
                        matrices.size() > cache.capacity ||  // Need more space
@@ -111,12 +115,11 @@ void ShaderOverdrawStrategy::render(const RenderContext& context) {
     commandBuffer->setPipeline(drawData.pipeline);
 
     if (drawData.pipeline->hasBindingSlot(0) && m_frameResources->getViewDescriptorSet()) {
-      commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
+      commandBuffer->bindDescriptorSet(
+          0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
     }
 
-    if (drawData.pipeline->hasBindingSlot(1) && drawData.modelMatrixDescriptorSet) {
-      commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
-    }
+    commandBuffer->pushConstants(drawData.modelMatrix);
 
     commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
     commandBuffer->bindVertexBuffer(1, drawData.instanceBuffer);
@@ -200,7 +203,7 @@ void ShaderOverdrawStrategy::updateInstanceBuffer_(ecs::RenderModel*
     // Create a new buffer with some growth room
     uint32_t newCapacity = std::max(static_cast<uint32_t>(matrices.size() * 1.5), 8u);
 
-    std::string bufferKey = "overdraw_instance_buffer_" + std::to_string(reinterpret_cast<uintptr_t>(model));
+    std::string bufferKey = "overdraw_instance_buffer_" + std::to_string(model->handle.getValue());
 
     rhi::BufferDesc bufferDesc;
     bufferDesc.size        = newCapacity * sizeof(math::Matrix4f<>);
@@ -224,13 +227,13 @@ void ShaderOverdrawStrategy::updateInstanceBuffer_(ecs::RenderModel*
 void ShaderOverdrawStrategy::prepareDrawCalls_(const RenderContext& context) {
   m_drawData.clear();
 
-  for (const auto& [model, cache] : m_instanceBufferCache) {
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
     if (cache.count == 0) {
       continue;
     }
 
-    for (const auto& renderMesh : model->renderMeshes) {
-      std::string pipelineKey = "overdraw_pipeline";
+    for (const auto& renderMesh : cache.model->renderMeshes) {
+      constexpr StringId pipelineKey = "overdraw_pipeline"_sid;
 
       rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
 
@@ -290,7 +293,8 @@ void ShaderOverdrawStrategy::prepareDrawCalls_(const RenderContext& context) {
           shaders.push_back(m_pixelShader);
         }
 
-        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+            shaders, {FrameResources::kViewUniformBufferBinding});
 
         auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
         pipelineDesc.setLayouts = layoutPtrs;
@@ -305,13 +309,13 @@ void ShaderOverdrawStrategy::prepareDrawCalls_(const RenderContext& context) {
       }
 
       DrawData drawData;
-      drawData.pipeline                 = pipeline;
-      drawData.modelMatrixDescriptorSet = m_frameResources->getOrCreateModelMatrixDescriptorSet(renderMesh);
-      drawData.vertexBuffer             = renderMesh->gpuMesh->vertexBuffer;
-      drawData.indexBuffer              = renderMesh->gpuMesh->indexBuffer;
-      drawData.instanceBuffer           = cache.instanceBuffer;
-      drawData.indexCount               = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
-      drawData.instanceCount            = cache.count;
+      drawData.pipeline       = pipeline;
+      drawData.modelMatrix    = renderMesh->transformMatrix;
+      drawData.vertexBuffer   = renderMesh->gpuMesh->vertexBuffer;
+      drawData.indexBuffer    = renderMesh->gpuMesh->indexBuffer;
+      drawData.instanceBuffer = cache.instanceBuffer;
+      drawData.indexCount     = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
+      drawData.instanceCount  = cache.count;
 
       m_drawData.push_back(drawData);
     }
@@ -320,17 +324,12 @@ void ShaderOverdrawStrategy::prepareDrawCalls_(const RenderContext& context) {
 
 void ShaderOverdrawStrategy::cleanupUnusedBuffers_(
     const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances) {
-  std::vector<ecs::RenderModel*> modelsToRemove;
-
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (!currentFrameInstances.contains(model)) {
-      modelsToRemove.push_back(model);
+  // the model is only dereferenced while it is in the frame, entries of removed models are dropped
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
+    if (!currentFrameInstances.contains(cache.model) || cache.model->handle != handle) {
+      m_instanceBufferCache.erase(handle);
     }
   }
-
-  for (auto model : modelsToRemove) {
-    m_instanceBufferCache.erase(model);
-  }
 }
 }  // namespace renderer
 }  // namespace gfx
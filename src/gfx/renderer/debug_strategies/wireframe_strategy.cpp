@@ -48,7 +48,10 @@ void WireframeStrategy::resize(const math::Dimension2i& newDimension) {
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffers_(newDimension);
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffers_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void WireframeStrategy::prepareFrame(const RenderContext& context) {
@@ -64,7 +67,8 @@ void WireframeStrategy::prepareFrame(const RenderContext& context) {
   }
 
   for (auto& [model, matrices] : currentFrameInstances) {
-    auto& cache = m_instanceBufferCache[model];
+    auto& cache = m_instanceBufferCache[model->handle];
+    cache.model = model;
 
     bool needsUpdate = cache.instanceBuffer == nullptr ||   // Buffer not created yet
                        matrices.size() > cache.capacity ||  // Need more space
@@ -89,7 +93,7 @@ void WireframeStrategy::render(const RenderContext& context) {
   }
 
   uint32_t currentIndex = context.currentImageIndex;
-  if (currentIndex >= m_framebuffers.size()) {
+  if (currentIndex >= m_framebuffers.size() || !m_framebuffers[currentIndex]) {
     LOG_ERROR("Invalid framebuffer index");
     return;
   }
@@ -121,12 +125,11 @@ void WireframeStrategy::render(const RenderContext& context) {
       commandBuffer->setPipeline(drawData.pipeline);
 
       if (drawData.pipeline->hasBindingSlot(0) && m_frameResources->getViewDescriptorSet()) {
-        commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
+        commandBuffer->bindDescriptorSet(
+            0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
       }
 
-      if (drawData.pipeline->hasBindingSlot(1) && drawData.modelMatrixDescriptorSet) {
-        commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
-      }
+      commandBuffer->pushConstants(drawData.modelMatrix);
 
       commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
       commandBuffer->bindVertexBuffer(1, drawData.instanceBuffer);
@@ -200,11 +203,16 @@ void WireframeStrategy::createFramebuffers_(const math::Dimension2i& dimension)
 
     auto& renderTargets = m_frameResources->getRenderTargets(i);
 
+    if (!renderTargets.depthBuffer) {
+      m_framebuffers.push_back(nullptr);
+      continue;
+    }
+
     rhi::FramebufferDesc framebufferDesc;
     framebufferDesc.width  = dimension.width();
     framebufferDesc.height = dimension.height();
     framebufferDesc.colorAttachments.push_back(renderTargets.colorBuffer.get());
-    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer.get();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
     framebufferDesc.hasDepthStencil        = true;
     framebufferDesc.renderPass             = m_renderPass;
 
@@ -224,7 +232,7 @@ void WireframeStrategy::updateInstanceBuffer_(ecs::RenderModel*
     // Create a new buffer with some growth room
     uint32_t newCapacity = std::max(static_cast<uint32_t>(matrices.size() * 1.5), 8u);
 
-    std::string bufferKey = "wireframe_instance_buffer_" + std::to_string(reinterpret_cast<uintptr_t>(model));
+    std::string bufferKey = "wireframe_instance_buffer_" + std::to_string(model->handle.getValue());
 
     rhi::BufferDesc bufferDesc;
     bufferDesc.size        = newCapacity * sizeof(math::Matrix4f<>);
@@ -248,13 +256,13 @@ void WireframeStrategy::updateInstanceBuffer_(ecs::RenderModel*
 void WireframeStrategy::prepareDrawCalls_(const RenderContext& context) {
   m_drawData.clear();
 
-  for (const auto& [model, cache] : m_instanceBufferCache) {
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
     if (cache.count == 0) {
       continue;
     }
 
-    for (const auto& renderMesh : model->renderMeshes) {
-      std::string pipelineKey = "wireframe_pipeline";
+    for (const auto& renderMesh : cache.model->renderMeshes) {
+      constexpr StringId pipelineKey = "wireframe_pipeline"_sid;
 
       rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
 
@@ -308,7 +316,8 @@ void WireframeStrategy::prepareDrawCalls_(const RenderContext& context) {
           shaders.push_back(m_pixelShader);
         }
 
-        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+            shaders, {FrameResources::kViewUniformBufferBinding});
 
         auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
         pipelineDesc.setLayouts = layoutPtrs;
@@ -323,13 +332,13 @@ void WireframeStrategy::prepareDrawCalls_(const RenderContext& context) {
       }
 
       DrawData drawData;
-      drawData.pipeline                 = pipeline;
-      drawData.modelMatrixDescriptorSet = m_frameResources->getOrCreateModelMatrixDescriptorSet(renderMesh);
-      drawData.vertexBuffer             = renderMesh->gpuMesh->vertexBuffer;
-      drawData.indexBuffer              = renderMesh->gpuMesh->indexBuffer;
-      drawData.instanceBuffer           = cache.instanceBuffer;
-      drawData.indexCount               = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
-      drawData.instanceCount            = cache.count;
+      drawData.pipeline       = pipeline;
+      drawData.modelMatrix    = renderMesh->transformMatrix;
+      drawData.vertexBuffer   = renderMesh->gpuMesh->vertexBuffer;
+      drawData.indexBuffer    = renderMesh->gpuMesh->indexBuffer;
+      drawData.instanceBuffer = cache.instanceBuffer;
+      drawData.indexCount     = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
+      drawData.instanceCount  = cache.count;
 
       m_drawData.push_back(drawData);
     }
@@ -338,17 +347,12 @@ void WireframeStrategy::prepareDrawCalls_(const RenderContext& context) {
 
 void WireframeStrategy::cleanupUnusedBuffers_(
     const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances) {
-  std::vector<ecs::RenderModel*> modelsToRemove;
-
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (!currentFrameInstances.contains(model)) {
-      modelsToRemove.push_back(model);
+  // the model is only dereferenced while it is in the frame, entries of removed models are dropped
+  for (const auto& [handle, cache] : m_instanceBufferCache) {
+    if (!currentFrameInstances.contains(cache.model) || cache.model->handle != handle) {
+      m_instanceBufferCache.erase(handle);
     }
   }
-
-  for (auto model : modelsToRemove) {
-    m_instanceBufferCache.erase(model);
-  }
 }
 
 }  // namespace renderer
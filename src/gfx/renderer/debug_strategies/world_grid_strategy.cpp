@@ -47,7 +47,10 @@ void WorldGridStrategy::resize(const math::Dimension2i& newDimension) {
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffers_(newDimension);
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffers_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void WorldGridStrategy::prepareFrame(const RenderContext& context) {
@@ -61,7 +64,7 @@ void WorldGridStrategy::render(const RenderContext& context) {
   }
 
   uint32_t currentIndex = context.currentImageIndex;
-  if (currentIndex >= m_framebuffers.size()) {
+  if (currentIndex >= m_framebuffers.size() || !m_framebuffers[currentIndex]) {
     LOG_ERROR("Invalid framebuffer index");
     return;
   }
@@ -89,7 +92,8 @@ void WorldGridStrategy::render(const RenderContext& context) {
   commandBuffer->setPipeline(m_pipeline);
 
   if (m_pipeline->hasBindingSlot(0) && m_frameResources->getViewDescriptorSet()) {
-    commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
+    commandBuffer->bindDescriptorSet(
+        0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
   }
 
   // commandBuffer->bindDescriptorSet(0, m_gridDescriptorSet);
@@ -161,11 +165,16 @@ void WorldGridStrategy::createFramebuffers_(const math::Dimension2i& dimension)
 
     auto& renderTargets = m_frameResources->getRenderTargets(i);
 
+    if (!renderTargets.depthBuffer) {
+      m_framebuffers.push_back(nullptr);
+      continue;
+    }
+
     rhi::FramebufferDesc framebufferDesc;
     framebufferDesc.width  = dimension.width();
     framebufferDesc.height = dimension.height();
     framebufferDesc.colorAttachments.push_back(renderTargets.colorBuffer.get());
-    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer.get();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
     framebufferDesc.hasDepthStencil        = true;
     framebufferDesc.renderPass             = m_renderPass;
 
@@ -217,7 +226,8 @@ void WorldGridStrategy::createPipeline_() {
     shaders.push_back(m_pixelShader);
   }
 
-  rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+  rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+      shaders, {FrameResources::kViewUniformBufferBinding});
 
   auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
   pipelineDesc.setLayouts = layoutPtrs;
@@ -65,6 +65,7 @@ class WorldGridStrategy : public DebugDrawStrategy {
 
   rhi::RenderPass*               m_renderPass = nullptr;
   std::vector<rhi::Framebuffer*> m_framebuffers;
+  uint32_t                       m_renderTargetGeneration = 0;
 
   // rhi::Buffer*              m_gridParametersBuffer = nullptr;
   // rhi::DescriptorSetLayout* m_gridLayout           = nullptr;
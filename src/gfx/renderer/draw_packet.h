@@ -0,0 +1,105 @@
+#ifndef ARISE_DRAW_PACKET_H
+#define ARISE_DRAW_PACKET_H
+
+#include "utils/sort/radix_sort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+/**
+ * Highest bits of the sort key - layers are submitted in this order
+ */
+enum class RenderLayer : uint8_t {
+  Opaque      = 0,
+  Masked      = 1,  // alpha tested, drawn after opaque so cheap occluders fill depth first
+  Transparent = 2,
+};
+
+/**
+ * One draw call referenced by a 64-bit sort key.
+ *
+ * Opaque / masked key layout (state first, then front-to-back for early-Z):
+ *   [63..60] layer | [59..48] pipeline | [47..24] geometry | [23..0] depth
+ *
+ * Transparent key layout (back-to-front is required for correct blending, state only breaks ties):
+ *   [63..60] layer | [59..36] inverted depth | [35..24] pipeline | [23..0] geometry
+ *
+ * Materials are bindless (each instance carries its material index) and batches mix materials, so there is no
+ * material state to group by and the key has no material field.
+ */
+struct DrawPacket {
+  static constexpr uint32_t kLayerBits    = 4;
+  static constexpr uint32_t kPipelineBits = 12;
+  static constexpr uint32_t kGeometryBits = 24;
+  static constexpr uint32_t kDepthBits    = 24;  // 2^24 - 1 is exact in float (see quantizeDepth())
+
+  static_assert(kLayerBits + kPipelineBits + kGeometryBits + kDepthBits == 64);
+
+  uint64_t sortKey   = 0;
+  uint32_t drawIndex = 0;  // index into the pass' own draw data
+
+  /**
+   * Maps linear view depth to [0, 2^kDepthBits - 1], values outside [nearClip, farClip] are clamped
+   */
+  static uint32_t quantizeDepth(float viewDepth, float nearClip, float farClip) {
+    constexpr uint32_t kMaxDepth = (1u << kDepthBits) - 1;
+
+    const float range      = std::max(farClip - nearClip, 1e-6f);
+    const float normalized = std::clamp((viewDepth - nearClip) / range, 0.0f, 1.0f);
+    return static_cast<uint32_t>(normalized * kMaxDepth);
+  }
+
+  static uint64_t makeKey(RenderLayer layer, uint32_t pipelineId, uint32_t geometryId, uint32_t depth) {
+    const uint64_t layerBits    = static_cast<uint64_t>(layer) & mask_(kLayerBits);
+    const uint64_t pipelineBits = pipelineId & mask_(kPipelineBits);
+    const uint64_t geometryBits = geometryId & mask_(kGeometryBits);
+    const uint64_t depthBits    = depth & mask_(kDepthBits);
+
+    if (layer == RenderLayer::Transparent) {
+      const uint64_t invertedDepth = mask_(kDepthBits) - depthBits;
+      return (layerBits << 60) | (invertedDepth << 36) | (pipelineBits << 24) | geometryBits;
+    }
+
+    return (layerBits << 60) | (pipelineBits << 48) | (geometryBits << 24) | depthBits;
+  }
+
+  private:
+  static constexpr uint64_t mask_(uint32_t bits) { return (uint64_t(1) << bits) - 1; }
+};
+
+/**
+ * Per-frame list of draw packets, sorted by key before submission
+ */
+class DrawPacketList {
+  public:
+  void clear() { m_packets.clear(); }
+
+  void reserve(size_t count) { m_packets.reserve(count); }
+
+  void add(uint64_t sortKey, uint32_t drawIndex) { m_packets.push_back({sortKey, drawIndex}); }
+
+  void sort() {
+    radixSort64(m_packets, m_scratch, [](const DrawPacket& packet) { return packet.sortKey; });
+  }
+
+  const std::vector<DrawPacket>& getPackets() const { return m_packets; }
+
+  size_t size() const { return m_packets.size(); }
+
+  bool empty() const { return m_packets.empty(); }
+
+  private:
+  std::vector<DrawPacket> m_packets;
+  std::vector<DrawPacket> m_scratch;
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_DRAW_PACKET_H
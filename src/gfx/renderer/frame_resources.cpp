@@ -2,20 +2,27 @@
 
 #include "ecs/components/camera.h"
 #include "ecs/components/light.h"
+#include "ecs/components/tags.h"
 #include "ecs/systems/light_system.h"
 #include "ecs/systems/system_manager.h"
 #include "gfx/renderer/render_resource_manager.h"
 #include "profiler/profiler.h"
 #include "utils/memory/align.h"
+#include "utils/memory/linear_allocator.h"
+#include "utils/resource/resource_deletion_manager.h"
 #include "utils/service/service_locator.h"
 
+#include <algorithm>
+
 namespace arise {
 namespace gfx {
 namespace renderer {
 
 FrameResources::FrameResources(rhi::Device* device, RenderResourceManager* resourceManager)
     : m_device(device)
-    , m_resourceManager(resourceManager) {
+    , m_resourceManager(resourceManager)
+    , m_uploadRing(device, resourceManager)
+    , m_bindlessMaterials(device, resourceManager) {
 }
 
 void FrameResources::initialize(uint32_t framesCount) {
@@ -23,20 +30,24 @@ void FrameResources::initialize(uint32_t framesCount) {
     return;
   }
 
+  m_uploadRing.initialize(framesCount);
+
   createViewDescriptorSetLayout_();
-  createModelMatrixDescriptorSetLayout_();
-  createMaterialDescriptorSetLayout_();
+  createInstanceTransformDescriptorSetLayout_();
   createDefaultTextures_();
 
+  m_bindlessMaterials.initialize(framesCount, m_defaultWhiteTexture, m_defaultNormalTexture, m_defaultBlackTexture);
+
   createDefaultSampler_();
   createSamplerDescriptorSet_();
 
   m_renderTargetsPerFrame.resize(framesCount);
+  m_instanceFrames.resize(framesCount);
 
   m_initialized = true;
 }
 
-void FrameResources::resize(const math::Dimension2i& newDimension) {
+bool FrameResources::resize(const math::Dimension2i& newDimension) {
   m_viewport.x        = 0.0f;
   m_viewport.y        = 0.0f;
   m_viewport.width    = static_cast<float>(newDimension.width());
@@ -49,13 +60,51 @@ void FrameResources::resize(const math::Dimension2i& newDimension) {
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
+  if (!m_renderTargetPool.update(newDimension)) {
+    return false;
+  }
+
+  // frames in flight still render into the previous targets, the render graph retires its depth buffers the same way
   for (auto& target : m_renderTargetsPerFrame) {
-    createRenderTargets_(target, newDimension);
+    RenderTargetPool::s_retire(std::move(target.colorBuffer));
+    target.depthBuffer = nullptr;
+    createRenderTargets_(target, m_renderTargetPool.getAllocatedDimension());
   }
+  ++m_renderTargetGeneration;
+
+  return true;
+}
+
+rhi::TextureDesc FrameResources::getDepthBufferDesc() const {
+  const auto& dimension = m_renderTargetPool.getAllocatedDimension();
+
+  rhi::TextureDesc depthDesc;
+  depthDesc.width       = dimension.width() != 0 ? dimension.width() : 1;
+  depthDesc.height      = dimension.height() != 0 ? dimension.height() : 1;
+  depthDesc.format      = rhi::TextureFormat::D24S8;
+  depthDesc.createFlags = rhi::TextureCreateFlag::Dsv;
+  depthDesc.debugName   = "depth_buffer";
+  return depthDesc;
+}
+
+bool FrameResources::setDepthBuffer(uint32_t frameIndex, rhi::Texture* depthBuffer) {
+  auto& targets = getRenderTargets(frameIndex);
+  if (targets.depthBuffer == depthBuffer) {
+    return false;
+  }
+
+  targets.depthBuffer = depthBuffer;
+  ++m_renderTargetGeneration;
+  return true;
 }
 
 void FrameResources::updatePerFrameResources(const RenderContext& context) {
   CPU_ZONE_NC("FrameResources::updatePerFrameResources", color::YELLOW);
+
+  // the fence of this frame was waited on, its instance buffers are no longer read by the GPU
+  m_currentFrameIndex = m_instanceFrames.empty() ? 0 : context.currentFrameIndex % m_instanceFrames.size();
+  syncInstanceTransforms_();
+
   if (!m_lightSystem) {
     auto systemManager = ServiceLocator::s_get<ecs::SystemManager>();
     m_lightSystem      = systemManager->getSystem<ecs::LightSystem>();
@@ -76,23 +125,30 @@ void FrameResources::updatePerFrameResources(const RenderContext& context) {
 void FrameResources::clearSceneResources() {
   m_modelsMap.clear();
   m_sortedModels.clear();
-  m_modelMatrixCache.clear();
-  m_materialParamCache.clear();
+  m_bindlessMaterials.clear();
   LOG_INFO("Frame resources cleared for scene switch");
 }
 
 void FrameResources::cleanup() {
   m_renderTargetsPerFrame.clear();
+  m_renderTargetPool.reset();
 
   m_viewDescriptorSet       = nullptr;
   m_viewDescriptorSetLayout = nullptr;
-  m_viewUniformBuffer       = nullptr;
+  m_viewDynamicOffset       = 0;
+
+  m_uploadRing.cleanup();
 
   m_defaultSamplerDescriptorSet = nullptr;
   m_defaultSampler              = nullptr;
 
-  m_modelMatrixCache.clear();
-  m_materialParamCache.clear();
+  m_instanceTransformDescriptorSetLayout = nullptr;
+  m_instanceFrames.clear();
+  m_instanceTransforms.clear();
+  m_instanceTransformVersion = 0;
+  m_currentFrameIndex        = 0;
+
+  m_bindlessMaterials.cleanup();
 
   m_sortedModels.clear();
   m_modelsMap.clear();
@@ -104,95 +160,99 @@ rhi::DescriptorSet* FrameResources::getLightDescriptorSet() const {
   return m_lightSystem->getLightDescriptorSet();
 }
 
-rhi::DescriptorSet* FrameResources::getOrCreateModelMatrixDescriptorSet(ecs::RenderMesh* renderMesh) {
-  auto it = m_modelMatrixCache.find(renderMesh);
-  if (it != m_modelMatrixCache.end() && it->second.descriptorSet) {
-    return it->second.descriptorSet;
-  }
-
-  if (!renderMesh->transformMatrixBuffer) {
-    LOG_WARN("RenderMesh has no model matrix buffer");
-    return nullptr;
-  }
+rhi::DescriptorSetLayout* FrameResources::getLightDescriptorSetLayout() const {
+  return m_lightSystem->getLightDescriptorSetLayout();
+}
 
-  auto descriptorSet = m_device->createDescriptorSet(m_modelMatrixDescriptorSetLayout);
-  descriptorSet->setUniformBuffer(0, renderMesh->transformMatrixBuffer);
+void FrameResources::updateInstanceTransforms(std::span<const InstanceTransform> transforms) {
+  m_instanceTransforms.assign(transforms.begin(), transforms.end());
+  ++m_instanceTransformVersion;
 
-  std::string setKey           = "mesh_model_matrix_set_" + std::to_string(reinterpret_cast<uintptr_t>(renderMesh));
-  auto        descriptorSetPtr = m_resourceManager->addDescriptorSet(std::move(descriptorSet), setKey);
+  syncInstanceTransforms_();
+}
 
-  m_modelMatrixCache[renderMesh].descriptorSet = descriptorSetPtr;
-  return descriptorSetPtr;
+rhi::DescriptorSet* FrameResources::getInstanceTransformDescriptorSet() const {
+  return m_instanceFrames.empty() ? nullptr : m_instanceFrames[m_currentFrameIndex].descriptorSet.get();
 }
 
-rhi::DescriptorSetLayout* FrameResources::getLightDescriptorSetLayout() const {
-  return m_lightSystem->getLightDescriptorSetLayout();
+rhi::Buffer* FrameResources::getInstanceTransformBuffer() const {
+  return m_instanceFrames.empty() ? nullptr : m_instanceFrames[m_currentFrameIndex].transformBuffer.get();
 }
 
-rhi::Buffer* FrameResources::getOrCreateMaterialParamBuffer(ecs::Material* material) {
-  if (!material) {
-    LOG_WARN("Material is null");
-    return nullptr;
+void FrameResources::syncInstanceTransforms_() {
+  if (m_instanceFrames.empty()) {
+    return;
   }
 
-  auto it = m_materialParamCache.find(material);
-  if (it != m_materialParamCache.end() && it->second.paramBuffer) {
-    return it->second.paramBuffer;
+  auto& frame = m_instanceFrames[m_currentFrameIndex];
+  if (frame.transformBuffer && frame.version == m_instanceTransformVersion) {
+    return;
   }
 
-  std::string bufferKey = "material_params_" + std::to_string(reinterpret_cast<uintptr_t>(material));
-
-  rhi::BufferDesc bufferDesc;
-  bufferDesc.size        = alignConstantBufferSize(sizeof(MaterialParametersData));
-  bufferDesc.createFlags = rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ConstantBuffer;
-  bufferDesc.type        = rhi::BufferType::Dynamic;
-  bufferDesc.debugName   = bufferKey;
-
-  auto buffer    = m_device->createBuffer(bufferDesc);
-  auto bufferPtr = m_resourceManager->addBuffer(std::move(buffer), bufferKey);
-
-  MaterialParametersData paramData = {};
-
-  auto colorIt = material->vectorParameters.find("base_color");
-  if (colorIt != material->vectorParameters.end()) {
-    paramData.baseColor = colorIt->second;
-  } else {
-    paramData.baseColor = math::Vector4f(1.0f, 1.0f, 1.0f, 1.0f);
+  if (!frame.transformBuffer || m_instanceTransforms.size() > frame.capacity) {
+    growInstanceBuffers_(frame, m_instanceTransforms.size());
   }
 
-  auto metallicIt = material->scalarParameters.find("metallic");
-  if (metallicIt != material->scalarParameters.end()) {
-    paramData.metallic = metallicIt->second;
-  } else {
-    paramData.metallic = 0.0f;
+  if (!m_instanceTransforms.empty()) {
+    m_device->updateBuffer(frame.transformBuffer.get(),
+                           m_instanceTransforms.data(),
+                           m_instanceTransforms.size() * sizeof(InstanceTransform));
   }
+  frame.version = m_instanceTransformVersion;
+}
 
-  auto roughnessIt = material->scalarParameters.find("roughness");
-  if (roughnessIt != material->scalarParameters.end()) {
-    paramData.roughness = roughnessIt->second;
-  } else {
-    paramData.roughness = 1.0f;
-  }
+void FrameResources::growInstanceBuffers_(InstanceFrameData& frame, size_t instanceCount) {
+  // Create new buffers with some growth room
+  const uint32_t newCapacity = std::max(static_cast<uint32_t>(instanceCount * 1.5), 8u);
 
-  auto opacityIt = material->scalarParameters.find("opacity");
-  if (opacityIt != material->scalarParameters.end()) {
-    paramData.opacity = opacityIt->second;
-  } else {
-    paramData.opacity = 1.0f;
+  // the previous buffers are retired with the frame delay, like the render targets
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (deletionManager) {
+    deletionManager->enqueueForDeletion(std::move(frame.transformBuffer));
+    deletionManager->enqueueForDeletion(std::move(frame.indexBuffer));
   }
 
-  m_device->updateBuffer(bufferPtr, &paramData, sizeof(paramData));
+  rhi::BufferDesc transformDesc;
+  transformDesc.size        = newCapacity * sizeof(InstanceTransform);
+  transformDesc.createFlags = rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ShaderResource;
+  transformDesc.type        = rhi::BufferType::Dynamic;
+  transformDesc.stride      = sizeof(InstanceTransform);
+  transformDesc.debugName   = "instance_transform_buffer";
+
+  frame.transformBuffer = m_device->createBuffer(transformDesc);
+
+  // identity instance indices - draws read transform (offset + SV_InstanceID) directly, GPU culling binds its
+  // compacted list of visible instances here instead
+  rhi::BufferDesc indexDesc;
+  indexDesc.size        = newCapacity * sizeof(uint32_t);
+  indexDesc.createFlags = rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ShaderResource;
+  indexDesc.type        = rhi::BufferType::Dynamic;
+  indexDesc.stride      = sizeof(uint32_t);
+  indexDesc.debugName   = "instance_index_buffer";
+
+  frame.indexBuffer = m_device->createBuffer(indexDesc);
+
+  std::vector<uint32_t> identity(newCapacity);
+  for (uint32_t i = 0; i < newCapacity; ++i) {
+    identity[i] = i;
+  }
+  m_device->updateBuffer(frame.indexBuffer.get(), identity.data(), identity.size() * sizeof(uint32_t));
 
-  m_materialParamCache[material].paramBuffer = bufferPtr;
+  frame.capacity = newCapacity;
 
-  return bufferPtr;
+  // only this frame binds the set and its previous submission has completed, so it can be rewritten in place
+  if (!frame.descriptorSet) {
+    frame.descriptorSet = m_device->createDescriptorSet(m_instanceTransformDescriptorSetLayout);
+  }
+  frame.descriptorSet->setStorageBuffer(0, frame.transformBuffer.get());
+  frame.descriptorSet->setStorageBuffer(1, frame.indexBuffer.get());
 }
 
 void FrameResources::createViewDescriptorSetLayout_() {
   rhi::DescriptorSetLayoutDesc        viewLayoutDesc;
   rhi::DescriptorSetLayoutBindingDesc viewBindingDesc;
-  viewBindingDesc.binding    = 0;
-  viewBindingDesc.type       = rhi::ShaderBindingType::Uniformbuffer;
+  viewBindingDesc.binding    = kViewUniformBufferBinding.binding;
+  viewBindingDesc.type       = rhi::ShaderBindingType::UniformbufferDynamic;
   viewBindingDesc.stageFlags = rhi::ShaderStageFlag::Vertex | rhi::ShaderStageFlag::Fragment;
   viewLayoutDesc.bindings.push_back(viewBindingDesc);
 
@@ -200,42 +260,24 @@ void FrameResources::createViewDescriptorSetLayout_() {
   m_viewDescriptorSetLayout = m_resourceManager->addDescriptorSetLayout(std::move(viewSetLayout), "view_set_layout");
 }
 
-void FrameResources::createModelMatrixDescriptorSetLayout_() {
+void FrameResources::createInstanceTransformDescriptorSetLayout_() {
+  // binding 0 - instance transforms, binding 1 - instance indices (register t0 / t1 in HLSL)
   rhi::DescriptorSetLayoutDesc        layoutDesc;
-  rhi::DescriptorSetLayoutBindingDesc bindingDesc;
-  bindingDesc.binding    = 0;
-  bindingDesc.type       = rhi::ShaderBindingType::Uniformbuffer;
-  bindingDesc.stageFlags = rhi::ShaderStageFlag::Vertex;
-  layoutDesc.bindings.push_back(bindingDesc);
+  rhi::DescriptorSetLayoutBindingDesc transformBindingDesc;
+  transformBindingDesc.binding    = 0;
+  transformBindingDesc.type       = rhi::ShaderBindingType::BufferSrv;
+  transformBindingDesc.stageFlags = rhi::ShaderStageFlag::Vertex;
+  layoutDesc.bindings.push_back(transformBindingDesc);
+
+  rhi::DescriptorSetLayoutBindingDesc indexBindingDesc;
+  indexBindingDesc.binding    = 1;
+  indexBindingDesc.type       = rhi::ShaderBindingType::BufferSrv;
+  indexBindingDesc.stageFlags = rhi::ShaderStageFlag::Vertex;
+  layoutDesc.bindings.push_back(indexBindingDesc);
 
   auto layout = m_device->createDescriptorSetLayout(layoutDesc);
-  m_modelMatrixDescriptorSetLayout
-      = m_resourceManager->addDescriptorSetLayout(std::move(layout), "model_matrix_layout");
-}
-
-void FrameResources::createMaterialDescriptorSetLayout_() {
-  rhi::DescriptorSetLayoutDesc materialLayoutDesc;
-
-  rhi::DescriptorSetLayoutBindingDesc paramsBindingDesc;
-  paramsBindingDesc.binding    = 0;
-  paramsBindingDesc.type       = rhi::ShaderBindingType::Uniformbuffer;
-  paramsBindingDesc.stageFlags = rhi::ShaderStageFlag::Fragment;
-  materialLayoutDesc.bindings.push_back(paramsBindingDesc);
-
-  std::vector<std::string> textureNames = {"albedo", "normal_map", "metallic_roughness"};
-  uint32_t                 binding      = 1;
-
-  for (const auto& textureName : textureNames) {
-    rhi::DescriptorSetLayoutBindingDesc textureBindingDesc;
-    textureBindingDesc.binding    = binding++;
-    textureBindingDesc.type       = rhi::ShaderBindingType::TextureSrv;
-    textureBindingDesc.stageFlags = rhi::ShaderStageFlag::Fragment;
-    materialLayoutDesc.bindings.push_back(textureBindingDesc);
-  }
-
-  auto materialSetLayout = m_device->createDescriptorSetLayout(materialLayoutDesc);
-  m_materialDescriptorSetLayout
-      = m_resourceManager->addDescriptorSetLayout(std::move(materialSetLayout), "material_layout");
+  m_instanceTransformDescriptorSetLayout
+      = m_resourceManager->addDescriptorSetLayout(std::move(layout), "instance_transform_layout");
 }
 
 void FrameResources::createDefaultTextures_() {
@@ -340,16 +382,6 @@ void FrameResources::createRenderTargets_(RenderTargets& targets, const math::Di
   colorDesc.debugName     = "color_buffer";
 
   targets.colorBuffer = m_device->createTexture(colorDesc);
-
-  rhi::TextureDesc depthDesc;
-  depthDesc.width         = width;
-  depthDesc.height        = height;
-  depthDesc.format        = rhi::TextureFormat::D24S8;
-  depthDesc.createFlags   = rhi::TextureCreateFlag::Dsv;
-  depthDesc.initialLayout = rhi::ResourceLayout::DepthStencilAttachment;
-  depthDesc.debugName     = "depth_buffer";
-
-  targets.depthBuffer = m_device->createTexture(depthDesc);
 }
 
 void FrameResources::updateViewResources_(const RenderContext& context) {
@@ -365,22 +397,12 @@ void FrameResources::updateViewResources_(const RenderContext& context) {
   auto  entity       = *view.begin();
   auto& transform    = view.get<ecs::Transform>(entity);
   auto& cameraMatrix = view.get<ecs::CameraMatrices>(entity);
+  auto& camera       = view.get<ecs::Camera>(entity);
 
-  if (!m_viewUniformBuffer) {
-    rhi::BufferDesc viewUboDesc;
-    viewUboDesc.size = alignConstantBufferSize(sizeof(math::Matrix4f<>) * 6 + sizeof(math::Vector3f) + sizeof(float));
-    viewUboDesc.createFlags = rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ConstantBuffer;
-    viewUboDesc.type        = rhi::BufferType::Dynamic;
-    viewUboDesc.debugName   = "view_buffer";
-
-    auto viewBuffer     = m_device->createBuffer(viewUboDesc);
-    m_viewUniformBuffer = m_resourceManager->addBuffer(std::move(viewBuffer), "view_buffer");
-
-    // Create descriptor set as well
-    auto viewDescriptorSet = m_device->createDescriptorSet(m_viewDescriptorSetLayout);
-    viewDescriptorSet->setUniformBuffer(0, m_viewUniformBuffer);
-    m_viewDescriptorSet = m_resourceManager->addDescriptorSet(std::move(viewDescriptorSet), "view_descriptor_set");
-  }
+  m_viewMatrix           = cameraMatrix.view;
+  m_viewProjectionMatrix = cameraMatrix.view * cameraMatrix.projection;
+  m_nearClip             = camera.nearClip;
+  m_farClip              = camera.farClip;
 
   struct ViewData {
     math::Matrix4f<> view;
@@ -395,20 +417,35 @@ void FrameResources::updateViewResources_(const RenderContext& context) {
 
   viewData.view              = cameraMatrix.view;
   viewData.projection        = cameraMatrix.projection;
-  viewData.viewProjection    = cameraMatrix.view * cameraMatrix.projection;
+  viewData.viewProjection    = m_viewProjectionMatrix;
   viewData.invView           = cameraMatrix.view.inverse();
   viewData.invProjection     = cameraMatrix.projection.inverse();
   viewData.invViewProjection = viewData.viewProjection.inverse();
   viewData.eyePosition       = transform.translation;
   viewData.padding           = 0.0f;
 
-  m_device->updateBuffer(m_viewUniformBuffer, &viewData, sizeof(viewData));
+  // every frame in flight gets its own copy, so updating the view never races with the GPU reading it
+  auto allocation = m_uploadRing.upload(viewData);
+  if (!allocation.isValid()) {
+    return;
+  }
+
+  if (!m_viewDescriptorSet) {
+    auto viewDescriptorSet = m_device->createDescriptorSet(m_viewDescriptorSetLayout);
+    viewDescriptorSet->setUniformBuffer(0, allocation.buffer, 0, alignConstantBufferSize(sizeof(ViewData)));
+    m_viewDescriptorSet = m_resourceManager->addDescriptorSet(std::move(viewDescriptorSet), "view_descriptor_set");
+  }
+
+  m_viewDynamicOffset = allocation.offset;
 }
 
 void FrameResources::updateModelList_(const RenderContext& context) {
-  bool                               needRebuildRenderArray = false;
-  std::unordered_set<entt::entity>   currentEntityIds;
-  std::unordered_set<ecs::Material*> activeMaterials;
+  // rebuilt every frame, the sets live on the frame allocator
+  LinearAllocatorScope scope;
+
+  bool                                     needRebuildRenderArray = false;
+  FrameUnorderedSet<entt::entity>          currentEntityIds;
+  FrameUnorderedSet<Handle<ecs::Material>> activeMaterials;
 
   auto& registry = context.scene->getEntityRegistry();
   auto  view     = registry.view<ecs::Transform, ecs::RenderModel*>();
@@ -420,12 +457,16 @@ void FrameResources::updateModelList_(const RenderContext& context) {
 
     for (const auto& renderMesh : renderModel->renderMeshes) {
       if (renderMesh->material) {
-        activeMaterials.insert(renderMesh->material);
+        activeMaterials.insert(renderMesh->material->handle);
       }
     }
 
+    const bool occluder = registry.all_of<ecs::OccluderTag>(entity);
+
     auto it = m_modelsMap.find(entity);
     if (it != m_modelsMap.end()) {
+      it->second.occluder = occluder;
+
       if (transform.isDirty) {
         it->second.transform   = transform;
         it->second.modelMatrix = ecs::calculateTransformMatrix(transform);
@@ -437,10 +478,11 @@ void FrameResources::updateModelList_(const RenderContext& context) {
       instance.transform   = transform;
       instance.modelMatrix = ecs::calculateTransformMatrix(transform);
       instance.entityId    = entity;
+      instance.occluder    = occluder;
       instance.isDirty     = true;
 
       if (!renderModel->renderMeshes.empty() && renderModel->renderMeshes[0]->material) {
-        instance.materialId = reinterpret_cast<uintptr_t>(renderModel->renderMeshes[0]->material);
+        instance.materialId = renderModel->renderMeshes[0]->material->handle.getValue();
       }
 
       m_modelsMap[entity]    = instance;
@@ -457,18 +499,8 @@ void FrameResources::updateModelList_(const RenderContext& context) {
     }
   }
 
-  std::vector<ecs::Material*> materialsToRemove;
-  for (const auto& [material, cache] : m_materialParamCache) {
-    if (!activeMaterials.contains(material)) {
-      materialsToRemove.push_back(material);
-    }
-  }
-
-  for (auto material : materialsToRemove) {
-    LOG_DEBUG("Removing cached material parameters for deleted material at address: "
-              + std::to_string(reinterpret_cast<uintptr_t>(material)));
-    m_materialParamCache.erase(material);
-  }
+  // slots of removed materials are recycled once the frames in flight no longer read them
+  m_bindlessMaterials.releaseUnusedMaterials(activeMaterials);
 
   if (needRebuildRenderArray) {
     m_sortedModels.clear();
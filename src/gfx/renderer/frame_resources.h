@@ -3,15 +3,21 @@
 
 #include "ecs/components/render_model.h"
 #include "ecs/components/transform.h"
+#include "gfx/renderer/bindless_material_table.h"
+#include "gfx/renderer/instance_transform.h"
 #include "gfx/renderer/render_context.h"
+#include "gfx/renderer/render_target_pool.h"
+#include "gfx/renderer/upload_ring.h"
 #include "gfx/rhi/interface/buffer.h"
 #include "gfx/rhi/interface/descriptor.h"
 #include "gfx/rhi/interface/device.h"
 #include "gfx/rhi/interface/sampler.h"
 #include "gfx/rhi/interface/texture.h"
+#include "gfx/rhi/shader_reflection/shader_reflection_types.h"
 #include "utils/math/math_util.h"
 
 #include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -39,9 +45,12 @@ class FrameResources {
   void initialize(uint32_t framesCount);
 
   /**
-   * Resize resources when viewport (window / editor viewport) changes
+   * Fits the render targets to the viewport (window / editor viewport), called every frame.
+   * The viewport covers the top-left part of the targets, they are reallocated only as RenderTargetPool decides
+   *
+   * @return true if the targets were reallocated - framebuffers referencing them have to be recreated
    */
-  void resize(const math::Dimension2i& newDimension);
+  bool resize(const math::Dimension2i& newDimension);
 
   void updatePerFrameResources(const RenderContext& context);
 
@@ -50,8 +59,8 @@ class FrameResources {
 
   struct RenderTargets {
     std::unique_ptr<rhi::Texture> colorBuffer;
-    std::unique_ptr<rhi::Texture> depthBuffer;
-    rhi::Texture*                 backBuffer = nullptr;
+    rhi::Texture*                 depthBuffer = nullptr;  // transient texture of the render graph (setDepthBuffer())
+    rhi::Texture*                 backBuffer  = nullptr;
   };
 
   RenderTargets& getRenderTargets(uint32_t frameIndex) {
@@ -60,16 +69,72 @@ class FrameResources {
 
   uint32_t getFramesCount() const { return m_renderTargetsPerFrame.size(); }
 
+  // size of the render targets, the viewport may be smaller
+  const math::Dimension2i& getRenderTargetDimension() const { return m_renderTargetPool.getAllocatedDimension(); }
+
+  // incremented whenever the render targets are reallocated
+  uint32_t getRenderTargetGeneration() const { return m_renderTargetGeneration; }
+
+  // desc of the scene depth buffer, created by the render graph with the size of the render targets
+  rhi::TextureDesc getDepthBufferDesc() const;
+
+  /**
+   * The render graph places the depth buffer of a frame slot when the slot is compiled, resize() drops the depth
+   * buffers of all slots (passes skip framebuffers of slots without one)
+   *
+   * @return true if the depth buffer of the slot changed - framebuffers referencing it have to be recreated
+   */
+  bool setDepthBuffer(uint32_t frameIndex, rhi::Texture* depthBuffer);
+
   const rhi::Viewport&    getViewport() const { return m_viewport; }
   const rhi::ScissorRect& getScissor() const { return m_scissor; }
 
   rhi::DescriptorSet* getViewDescriptorSet() const { return m_viewDescriptorSet; }
+
+  /**
+   * View constants live in the upload ring, bind the view set with this offset:
+   * bindDescriptorSet(0, getViewDescriptorSet(), {getViewDynamicOffset()})
+   */
+  uint32_t getViewDynamicOffset() const { return m_viewDynamicOffset; }
+
+  // pipelines that bind the view set request it with generatePipelineLayoutFromShaders(shaders, {this binding})
+  static constexpr rhi::DynamicUniformBufferBinding kViewUniformBufferBinding{0, 0};
+
   rhi::DescriptorSet* getDefaultSamplerDescriptorSet() const { return m_defaultSamplerDescriptorSet; }
   rhi::DescriptorSet* getLightDescriptorSet() const;
-  rhi::DescriptorSet* getOrCreateModelMatrixDescriptorSet(ecs::RenderMesh* renderMesh);
+
+  /**
+   * Writes all instance transforms of the frame into one structured buffer (single contiguous update).
+   * A draw addresses its range by pushing the start index (DrawConstants::InstanceOffset), the shader adds
+   * SV_InstanceID to it and reads the transform through the instance index buffer (identity here).
+   *
+   * Every frame in flight has its own buffers and descriptor set, the other frames copy the transforms when
+   * updatePerFrameResources() reaches them, so the GPU never reads a buffer that is being rewritten
+   */
+  void updateInstanceTransforms(std::span<const InstanceTransform> transforms);
+
+  // of the current frame
+  rhi::DescriptorSet* getInstanceTransformDescriptorSet() const;
+  rhi::Buffer*        getInstanceTransformBuffer() const;
 
   rhi::Sampler* getDefaultSampler() const { return m_defaultSampler; }
 
+  /**
+   * Transient constant data that is rewritten every frame (recycled once the frame's fence is signaled)
+   */
+  UploadRing* getUploadRing() { return &m_uploadRing; }
+
+  /**
+   * Material records and textures of all materials in the scene, indexed by material index in shaders
+   */
+  BindlessMaterialTable* getBindlessMaterials() { return &m_bindlessMaterials; }
+
+  // Main camera data of the current frame (used for CPU-side depth sorting)
+  const math::Matrix4f<>& getViewMatrix() const { return m_viewMatrix; }
+  const math::Matrix4f<>& getViewProjectionMatrix() const { return m_viewProjectionMatrix; }
+  float                   getNearClip() const { return m_nearClip; }
+  float                   getFarClip() const { return m_farClip; }
+
   struct ModelInstance {
     ecs::RenderModel* model;
     ecs::Transform    transform;
@@ -78,7 +143,8 @@ class FrameResources {
 
     uint32_t materialId = 0;  // for sorting
 
-    bool isDirty = false;
+    bool occluder = false;  // flagged with ecs::OccluderTag
+    bool isDirty  = false;
   };
 
   /**
@@ -88,11 +154,11 @@ class FrameResources {
   const std::vector<ModelInstance*>& getModels() const { return m_sortedModels; }
 
   rhi::DescriptorSetLayout* getViewDescriptorSetLayout() const { return m_viewDescriptorSetLayout; }
-  rhi::DescriptorSetLayout* getModelMatrixDescriptorSetLayout() const { return m_modelMatrixDescriptorSetLayout; }
   rhi::DescriptorSetLayout* getLightDescriptorSetLayout() const;
-  rhi::DescriptorSetLayout* getMaterialDescriptorSetLayout() const { return m_materialDescriptorSetLayout; }
 
-  rhi::Buffer* getOrCreateMaterialParamBuffer(ecs::Material* material);
+  rhi::DescriptorSetLayout* getInstanceTransformDescriptorSetLayout() const {
+    return m_instanceTransformDescriptorSetLayout;
+  }
 
   rhi::Texture* getDefaultWhiteTexture() const { return m_defaultWhiteTexture; }
   rhi::Texture* getDefaultNormalTexture() const { return m_defaultNormalTexture; }
@@ -100,8 +166,7 @@ class FrameResources {
 
   private:
   void createViewDescriptorSetLayout_();
-  void createModelMatrixDescriptorSetLayout_();
-  void createMaterialDescriptorSetLayout_();
+  void createInstanceTransformDescriptorSetLayout_();
   void createDefaultTextures_();
   void createDefaultSampler_();
   void createSamplerDescriptorSet_();
@@ -115,6 +180,19 @@ class FrameResources {
   void clearInternalDirtyFlags_();
   void clearEntityDirtyFlags_(const RenderContext& context);
 
+  // frame-global instance data of one frame in flight, grown on demand
+  struct InstanceFrameData {
+    std::unique_ptr<rhi::Buffer>        transformBuffer;
+    std::unique_ptr<rhi::Buffer>        indexBuffer;
+    std::unique_ptr<rhi::DescriptorSet> descriptorSet;
+    uint32_t                            capacity = 0;
+    uint64_t                            version  = 0;  // of m_instanceTransforms the buffer holds
+  };
+
+  // brings the buffers of the current frame up to the latest transforms
+  void syncInstanceTransforms_();
+  void growInstanceBuffers_(InstanceFrameData& frame, size_t instanceCount);
+
   rhi::Device*           m_device          = nullptr;
   RenderResourceManager* m_resourceManager = nullptr;
   FrameResources*        m_frameResources  = nullptr;
@@ -125,15 +203,29 @@ class FrameResources {
   rhi::ScissorRect m_scissor;
 
   std::vector<RenderTargets> m_renderTargetsPerFrame;
+  RenderTargetPool           m_renderTargetPool;
+  uint32_t                   m_renderTargetGeneration = 0;
 
   rhi::DescriptorSet* m_viewDescriptorSet           = nullptr;
   rhi::DescriptorSet* m_defaultSamplerDescriptorSet = nullptr;
 
-  rhi::DescriptorSetLayout* m_viewDescriptorSetLayout        = nullptr;
-  rhi::DescriptorSetLayout* m_modelMatrixDescriptorSetLayout = nullptr;
-  rhi::DescriptorSetLayout* m_materialDescriptorSetLayout    = nullptr;
+  rhi::DescriptorSetLayout* m_viewDescriptorSetLayout              = nullptr;
+  rhi::DescriptorSetLayout* m_instanceTransformDescriptorSetLayout = nullptr;
+
+  std::vector<InstanceFrameData> m_instanceFrames;  // indexed by the frame in flight
+  std::vector<InstanceTransform> m_instanceTransforms;
+  uint64_t                       m_instanceTransformVersion = 0;
+  uint32_t                       m_currentFrameIndex        = 0;
+
+  UploadRing m_uploadRing;
+  uint32_t   m_viewDynamicOffset = 0;
 
-  rhi::Buffer* m_viewUniformBuffer = nullptr;
+  BindlessMaterialTable m_bindlessMaterials;
+
+  math::Matrix4f<> m_viewMatrix           = math::Matrix4f<>::Identity();
+  math::Matrix4f<> m_viewProjectionMatrix = math::Matrix4f<>::Identity();
+  float            m_nearClip             = 0.1f;
+  float            m_farClip              = 1000.0f;
 
   rhi::Texture* m_defaultWhiteTexture  = nullptr;
   rhi::Texture* m_defaultNormalTexture = nullptr;
@@ -141,26 +233,6 @@ class FrameResources {
 
   rhi::Sampler* m_defaultSampler = nullptr;
 
-  struct ModelMatrixCache {
-    rhi::DescriptorSet* descriptorSet = nullptr;
-  };
-
-  std::unordered_map<ecs::RenderMesh*, ModelMatrixCache> m_modelMatrixCache;
-
-  struct MaterialParametersData {
-    math::Vector4f baseColor;
-    float          metallic;
-    float          roughness;
-    float          opacity;
-    float          padding;
-  };
-
-  struct MaterialParamCache {
-    rhi::Buffer* paramBuffer = nullptr;
-  };
-
-  std::unordered_map<ecs::Material*, MaterialParamCache> m_materialParamCache;
-
   std::unordered_map<entt::entity, ModelInstance> m_modelsMap;
   std::vector<ModelInstance*>                     m_sortedModels;
 
@@ -0,0 +1,701 @@
+#include "gfx/renderer/gpu_culling.h"
+
+#include "gfx/renderer/frame_resources.h"
+#include "gfx/renderer/render_context.h"
+#include "gfx/renderer/render_resource_manager.h"
+#include "gfx/rhi/shader_manager.h"
+#include "profiler/profiler.h"
+#include "utils/logger/log.h"
+#include "utils/memory/align.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+namespace {
+
+constexpr uint32_t kCullGroupSize    = 64;  // numthreads of instance_cull.cs.hlsl
+constexpr uint32_t kPyramidGroupSize = 8;   // numthreads of depth_pyramid.cs.hlsl (per dimension)
+
+}  // namespace
+
+GpuCulling::GpuCulling(rhi::Device* device, RenderResourceManager* resourceManager)
+    : m_device_(device)
+    , m_resourceManager_(resourceManager) {
+}
+
+bool GpuCulling::initialize(rhi::ShaderManager* shaderManager, FrameResources* frameResources) {
+  m_frameResources_ = frameResources;
+
+  if (!shaderManager || !frameResources) {
+    LOG_ERROR("GPU culling requires a shader manager and frame resources");
+    return false;
+  }
+
+  if (!createPipelines_(shaderManager)) {
+    return false;
+  }
+
+  // every binding of the sets has a buffer from the start, even before the first scene or depth pyramid
+  const rhi::BufferCreateFlag readWrite = rhi::BufferCreateFlag::Uav | rhi::BufferCreateFlag::ShaderResource;
+
+  m_batchPacketBuffer_ = reserveBuffer_(nullptr,
+                                        sizeof(uint32_t),
+                                        sizeof(uint32_t),
+                                        rhi::BufferType::Static,
+                                        rhi::BufferCreateFlag::ShaderResource,
+                                        "gpu_cull_batch_packet_buffer");
+  m_drawArgumentBuffer_ = reserveBuffer_(nullptr,
+                                         sizeof(rhi::DrawIndexedIndirectCommand),
+                                         sizeof(rhi::DrawIndexedIndirectCommand),
+                                         rhi::BufferType::Static,
+                                         rhi::BufferCreateFlag::Uav | rhi::BufferCreateFlag::IndirectCommand,
+                                         "gpu_cull_draw_argument_buffer");
+  m_visibleInstanceBuffer_ = reserveBuffer_(nullptr,
+                                            sizeof(uint32_t),
+                                            sizeof(uint32_t),
+                                            rhi::BufferType::Static,
+                                            readWrite,
+                                            "gpu_cull_visible_instance_buffer");
+  m_pyramidBuffer_ = reserveBuffer_(
+      nullptr, sizeof(float), sizeof(float), rhi::BufferType::Static, readWrite, "gpu_cull_depth_pyramid_buffer");
+
+  return m_batchPacketBuffer_ && m_drawArgumentBuffer_ && m_visibleInstanceBuffer_ && m_pyramidBuffer_;
+}
+
+void GpuCulling::updateInstances(const std::vector<InstanceBounds>& instances) {
+  // frames in flight may still read their instance buffers, each frame uploads the new bounds in prepare()
+  m_instances_ = instances;
+  ++m_instanceVersion_;
+
+  if (instances.empty()) {
+    return;
+  }
+
+  // every instance may be visible, so each draw's range of the visible list is as large as its batch
+  m_visibleInstanceBuffer_ = reserveBuffer_(m_visibleInstanceBuffer_,
+                                            instances.size() * sizeof(uint32_t),
+                                            sizeof(uint32_t),
+                                            rhi::BufferType::Static,
+                                            rhi::BufferCreateFlag::Uav | rhi::BufferCreateFlag::ShaderResource,
+                                            "gpu_cull_visible_instance_buffer");
+}
+
+bool GpuCulling::prepare(const RenderContext&          context,
+                         const UploadRing::Allocation& arguments,
+                         uint32_t                      packetCount,
+                         const std::vector<uint32_t>&  batchPackets) {
+  CPU_ZONE_NC("GpuCulling::prepare", color::YELLOW);
+
+  m_packetCount_   = 0;
+  m_frameReadback_ = nullptr;
+
+  // results of this frame slot are complete - its fence was waited before the frame started
+  if (context.currentFrameIndex >= m_readbacks_.size()) {
+    m_readbacks_.resize(context.currentFrameIndex + 1);
+  }
+  PendingReadback& readback = m_readbacks_[context.currentFrameIndex];
+  if (readback.pending) {
+    verifyReadback_(readback);
+    readback.pending = false;
+  }
+
+  // the pyramid is valid for one frame only, buildDepthPyramid() of this frame renews it
+  const bool pyramidValid = m_pyramidValid_;
+  m_pyramidValid_         = false;
+
+  if (!m_cullPipeline_ || !arguments.isValid() || packetCount == 0 || m_instances_.empty()
+      || !m_frameResources_->getInstanceTransformBuffer()) {
+    return false;
+  }
+
+  // the fence of this frame slot was waited on, so its buffers and descriptor sets can be rewritten
+  FrameData* frame = acquireFrame_(context.currentFrameIndex);
+  if (!frame || !syncInstances_(*frame, context.currentFrameIndex)) {
+    return false;
+  }
+  m_frameIndex_ = context.currentFrameIndex;
+
+  UploadRing* uploadRing = m_frameResources_->getUploadRing();
+  m_batchPackets_        = uploadRing->allocate(batchPackets.size() * sizeof(uint32_t));
+  m_constants_           = uploadRing->allocate(sizeof(CullConstants));
+  if (!m_batchPackets_.isValid() || !m_constants_.isValid()) {
+    return false;
+  }
+
+  m_drawArgumentBuffer_ = reserveBuffer_(m_drawArgumentBuffer_,
+                                         packetCount * sizeof(rhi::DrawIndexedIndirectCommand),
+                                         sizeof(rhi::DrawIndexedIndirectCommand),
+                                         rhi::BufferType::Static,
+                                         rhi::BufferCreateFlag::Uav | rhi::BufferCreateFlag::IndirectCommand,
+                                         "gpu_cull_draw_argument_buffer");
+  m_batchPacketBuffer_  = reserveBuffer_(m_batchPacketBuffer_,
+                                        batchPackets.size() * sizeof(uint32_t),
+                                        sizeof(uint32_t),
+                                        rhi::BufferType::Static,
+                                        rhi::BufferCreateFlag::ShaderResource,
+                                        "gpu_cull_batch_packet_buffer");
+  if (!m_drawArgumentBuffer_ || !m_batchPacketBuffer_ || !m_visibleInstanceBuffer_) {
+    return false;
+  }
+
+  std::memcpy(m_batchPackets_.cpuAddress, batchPackets.data(), batchPackets.size() * sizeof(uint32_t));
+
+  // the shader counts the visible instances of each draw
+  auto* commands = static_cast<rhi::DrawIndexedIndirectCommand*>(arguments.cpuAddress);
+  for (uint32_t packetIndex = 0; packetIndex < packetCount; ++packetIndex) {
+    commands[packetIndex].instanceCount = 0;
+  }
+
+  CullConstants constants;
+  computeFrustumPlanes_(m_frameResources_->getViewProjectionMatrix(), constants.frustumPlanes);
+  constants.instanceCount = static_cast<uint32_t>(m_instances_.size());
+
+  const bool occlusion = context.renderSettings.gpuOcclusionCulling && pyramidValid && !m_pyramidMips_.empty();
+  if (occlusion) {
+    constants.pyramidViewProjection = m_pyramidViewProjection_;
+    constants.occlusionEnabled      = 1;
+    constants.pyramidMipCount       = static_cast<uint32_t>(m_pyramidMips_.size());
+    constants.depthWidth            = m_pyramidDepthWidth_;
+    constants.depthHeight           = m_pyramidDepthHeight_;
+    for (size_t mip = 0; mip < m_pyramidMips_.size(); ++mip) {
+      constants.pyramidMips[mip][0] = m_pyramidMips_[mip].offset;
+      constants.pyramidMips[mip][1] = m_pyramidMips_[mip].width;
+      constants.pyramidMips[mip][2] = m_pyramidMips_[mip].height;
+    }
+  }
+
+  std::memcpy(m_constants_.cpuAddress, &constants, sizeof(CullConstants));
+
+  if (context.renderSettings.gpuCullingVerify) {
+    if (readback.name.empty()) {
+      readback.name = "gpu_cull_readback_buffer_" + std::to_string(context.currentFrameIndex);
+    }
+
+    // draw arguments followed by the visible instance list
+    readback.buffer = reserveBuffer_(readback.buffer,
+                                     packetCount * sizeof(rhi::DrawIndexedIndirectCommand)
+                                         + m_instances_.size() * sizeof(uint32_t),
+                                     0,
+                                     rhi::BufferType::Static,
+                                     rhi::BufferCreateFlag::Readback,
+                                     readback.name);
+
+    if (readback.buffer) {
+      readback.occlusion     = occlusion;
+      readback.packetCount   = packetCount;
+      readback.instanceCount = constants.instanceCount;
+      readback.expectedVisible.clear();
+
+      for (uint32_t instanceIndex = 0; instanceIndex < m_instances_.size(); ++instanceIndex) {
+        const InstanceBounds& instance = m_instances_[instanceIndex];
+        if (instance.batchIndex >= batchPackets.size() || batchPackets[instance.batchIndex] == kInvalidPacket) {
+          continue;
+        }
+
+        if ((instance.flags & kAlwaysVisible) || isInsideFrustum_(instance, constants.frustumPlanes)) {
+          readback.expectedVisible.push_back(instanceIndex);
+        }
+      }
+
+      m_frameReadback_ = &readback;
+    }
+  }
+
+  updateDescriptorSets_(*frame);
+
+  m_arguments_   = arguments;
+  m_packetCount_ = packetCount;
+  m_batchCount_  = static_cast<uint32_t>(batchPackets.size());
+  return true;
+}
+
+void GpuCulling::cull(rhi::CommandBuffer* commandBuffer) {
+  if (!commandBuffer || m_packetCount_ == 0) {
+    return;
+  }
+
+  GPU_ZONE_NC(commandBuffer, "GPU Culling", color::ORANGE);
+
+  const uint64_t argumentBytes = uint64_t(m_packetCount_) * sizeof(rhi::DrawIndexedIndirectCommand);
+  const uint32_t instanceCount = static_cast<uint32_t>(m_instances_.size());
+
+  // the previous frame may still draw from the arguments / read the tables
+  transition_(
+      commandBuffer, m_drawArgumentBuffer_, rhi::ResourceLayout::IndirectArgument, rhi::ResourceLayout::TransferDst);
+  transition_(
+      commandBuffer, m_batchPacketBuffer_, rhi::ResourceLayout::ShaderReadOnly, rhi::ResourceLayout::TransferDst);
+
+  commandBuffer->copyBuffer(m_arguments_.buffer, m_drawArgumentBuffer_, m_arguments_.offset, 0, argumentBytes);
+  commandBuffer->copyBuffer(m_batchPackets_.buffer,
+                            m_batchPacketBuffer_,
+                            m_batchPackets_.offset,
+                            0,
+                            uint64_t(m_batchCount_) * sizeof(uint32_t));
+
+  transition_(commandBuffer, m_drawArgumentBuffer_, rhi::ResourceLayout::TransferDst, rhi::ResourceLayout::Uav);
+  transition_(
+      commandBuffer, m_batchPacketBuffer_, rhi::ResourceLayout::TransferDst, rhi::ResourceLayout::ShaderReadOnly);
+  transition_(commandBuffer, m_visibleInstanceBuffer_, rhi::ResourceLayout::ShaderReadOnly, rhi::ResourceLayout::Uav);
+
+  const FrameData& frame = m_frames_[m_frameIndex_];
+
+  commandBuffer->setPipeline(m_cullPipeline_);
+  commandBuffer->bindDescriptorSet(0, frame.constantsDescriptorSet, {m_constants_.offset});
+  commandBuffer->bindDescriptorSet(1, frame.cullDescriptorSet);
+  commandBuffer->dispatch((instanceCount + kCullGroupSize - 1) / kCullGroupSize);
+
+  if (m_frameReadback_) {
+    transition_(commandBuffer, m_drawArgumentBuffer_, rhi::ResourceLayout::Uav, rhi::ResourceLayout::TransferSrc);
+    transition_(commandBuffer, m_visibleInstanceBuffer_, rhi::ResourceLayout::Uav, rhi::ResourceLayout::TransferSrc);
+
+    commandBuffer->copyBuffer(m_drawArgumentBuffer_, m_frameReadback_->buffer, 0, 0, argumentBytes);
+    commandBuffer->copyBuffer(m_visibleInstanceBuffer_,
+                              m_frameReadback_->buffer,
+                              0,
+                              argumentBytes,
+                              uint64_t(instanceCount) * sizeof(uint32_t));
+
+    transition_(
+        commandBuffer, m_drawArgumentBuffer_, rhi::ResourceLayout::TransferSrc, rhi::ResourceLayout::IndirectArgument);
+    transition_(
+        commandBuffer, m_visibleInstanceBuffer_, rhi::ResourceLayout::TransferSrc, rhi::ResourceLayout::ShaderReadOnly);
+
+    m_frameReadback_->pending = true;
+  } else {
+    transition_(commandBuffer, m_drawArgumentBuffer_, rhi::ResourceLayout::Uav, rhi::ResourceLayout::IndirectArgument);
+    transition_(commandBuffer, m_visibleInstanceBuffer_, rhi::ResourceLayout::Uav, rhi::ResourceLayout::ShaderReadOnly);
+  }
+
+  m_packetCount_   = 0;
+  m_frameReadback_ = nullptr;
+}
+
+void GpuCulling::buildDepthPyramid(rhi::CommandBuffer* commandBuffer, rhi::Texture* depthBuffer, uint32_t imageIndex) {
+  if (!commandBuffer || !depthBuffer || !m_pyramidPipeline_) {
+    return;
+  }
+
+  // the viewport covers the top-left part of the depth buffer (render targets are allocated in size buckets)
+  const auto&    viewport    = m_frameResources_->getViewport();
+  const uint32_t depthWidth  = std::clamp(static_cast<uint32_t>(viewport.width), 1u, depthBuffer->getWidth());
+  const uint32_t depthHeight = std::clamp(static_cast<uint32_t>(viewport.height), 1u, depthBuffer->getHeight());
+
+  // mip 0 has half the depth resolution, the chain ends at 1x1; mips are stored one after another
+  std::vector<PyramidMip> mips;
+  uint32_t                texelCount = 0;
+  uint32_t                width      = std::max(depthWidth / 2, 1u);
+  uint32_t                height     = std::max(depthHeight / 2, 1u);
+  while (mips.size() < kMaxPyramidMips) {
+    mips.push_back({texelCount, width, height});
+    texelCount += width * height;
+
+    if (width == 1 && height == 1) {
+      break;
+    }
+    width  = std::max(width / 2, 1u);
+    height = std::max(height / 2, 1u);
+  }
+
+  m_pyramidBuffer_ = reserveBuffer_(m_pyramidBuffer_,
+                                    uint64_t(texelCount) * sizeof(float),
+                                    sizeof(float),
+                                    rhi::BufferType::Static,
+                                    rhi::BufferCreateFlag::Uav | rhi::BufferCreateFlag::ShaderResource,
+                                    "gpu_cull_depth_pyramid_buffer");
+  if (!m_pyramidBuffer_) {
+    return;
+  }
+
+  if (imageIndex >= m_pyramidDescriptorSets_.size()) {
+    m_pyramidDescriptorSets_.resize(imageIndex + 1, nullptr);
+    m_pyramidDepthBuffers_.resize(imageIndex + 1, nullptr);
+    m_pyramidSetBuffers_.resize(imageIndex + 1, nullptr);
+  }
+
+  if (!m_pyramidDescriptorSets_[imageIndex]) {
+    auto descriptorSet = m_device_->createDescriptorSet(m_pyramidLayout_);
+    m_pyramidDescriptorSets_[imageIndex] = m_resourceManager_->addDescriptorSet(
+        std::move(descriptorSet), "gpu_cull_depth_pyramid_descriptor_set_" + std::to_string(imageIndex));
+  }
+
+  // depth buffers are recreated on resize, the pyramid buffer when it grows
+  rhi::DescriptorSet* descriptorSet = m_pyramidDescriptorSets_[imageIndex];
+  if (m_pyramidDepthBuffers_[imageIndex] != depthBuffer || m_pyramidSetBuffers_[imageIndex] != m_pyramidBuffer_) {
+    descriptorSet->setTexture(0, depthBuffer);
+    descriptorSet->setStorageBuffer(1, m_pyramidBuffer_);
+    m_pyramidDepthBuffers_[imageIndex] = depthBuffer;
+    m_pyramidSetBuffers_[imageIndex]   = m_pyramidBuffer_;
+  }
+
+  GPU_ZONE_NC(commandBuffer, "Depth Pyramid", color::ORANGE);
+
+  // the current frame's culling read the previous pyramid
+  transition_(commandBuffer, m_pyramidBuffer_, rhi::ResourceLayout::ShaderReadOnly, rhi::ResourceLayout::Uav);
+
+  commandBuffer->setPipeline(m_pyramidPipeline_);
+  commandBuffer->bindDescriptorSet(0, descriptorSet);
+
+  for (size_t mip = 0; mip < mips.size(); ++mip) {
+    PyramidConstants constants;
+    constants.srcOffset        = mip == 0 ? 0 : mips[mip - 1].offset;
+    constants.srcWidth         = mip == 0 ? depthWidth : mips[mip - 1].width;
+    constants.srcHeight        = mip == 0 ? depthHeight : mips[mip - 1].height;
+    constants.dstOffset        = mips[mip].offset;
+    constants.dstWidth         = mips[mip].width;
+    constants.dstHeight        = mips[mip].height;
+    constants.fromDepthTexture = mip == 0 ? 1 : 0;
+
+    commandBuffer->pushConstants(constants);
+    commandBuffer->dispatch((mips[mip].width + kPyramidGroupSize - 1) / kPyramidGroupSize,
+                            (mips[mip].height + kPyramidGroupSize - 1) / kPyramidGroupSize);
+
+    // the next mip reads this one
+    transition_(commandBuffer, m_pyramidBuffer_, rhi::ResourceLayout::Uav, rhi::ResourceLayout::Uav);
+  }
+
+  transition_(commandBuffer, m_pyramidBuffer_, rhi::ResourceLayout::Uav, rhi::ResourceLayout::ShaderReadOnly);
+
+  m_pyramidMips_           = std::move(mips);
+  m_pyramidViewProjection_ = m_frameResources_->getViewProjectionMatrix();
+  m_pyramidDepthWidth_     = depthWidth;
+  m_pyramidDepthHeight_    = depthHeight;
+  m_pyramidValid_          = true;
+}
+
+void GpuCulling::clear() {
+  // buffers and descriptor sets are owned by the resource manager and reused by the next scene
+  m_instances_.clear();
+  m_pyramidMips_.clear();
+  m_pyramidValid_  = false;
+  m_packetCount_   = 0;
+  m_frameReadback_ = nullptr;
+
+  for (auto& readback : m_readbacks_) {
+    readback.pending = false;
+    readback.expectedVisible.clear();
+  }
+}
+
+void GpuCulling::cleanup() {
+  clear();
+  m_readbacks_.clear();
+  m_frames_.clear();
+  m_frameIndex_      = 0;
+  m_instanceVersion_ = 0;
+
+  m_pyramidDescriptorSets_.clear();
+  m_pyramidDepthBuffers_.clear();
+  m_pyramidSetBuffers_.clear();
+
+  m_cullPipeline_    = nullptr;
+  m_pyramidPipeline_ = nullptr;
+  m_constantsLayout_ = nullptr;
+  m_cullLayout_      = nullptr;
+  m_pyramidLayout_   = nullptr;
+
+  m_batchPacketBuffer_     = nullptr;
+  m_drawArgumentBuffer_    = nullptr;
+  m_visibleInstanceBuffer_ = nullptr;
+  m_pyramidBuffer_         = nullptr;
+  m_frameResources_        = nullptr;
+}
+
+rhi::DescriptorSet* GpuCulling::getInstanceDescriptorSet() const {
+  return m_frameIndex_ < m_frames_.size() ? m_frames_[m_frameIndex_].instanceDescriptorSet : nullptr;
+}
+
+bool GpuCulling::createPipelines_(rhi::ShaderManager* shaderManager) {
+  rhi::Shader* cullShader    = shaderManager->getShader(m_cullShaderPath_);
+  rhi::Shader* pyramidShader = shaderManager->getShader(m_pyramidShaderPath_);
+  if (!cullShader || !pyramidShader) {
+    LOG_ERROR("GPU culling shaders are not available");
+    return false;
+  }
+
+  // set 0 - cull constants (dynamic offset into the upload ring), a separate set so DirectX binds a root CBV
+  rhi::DescriptorSetLayoutDesc        constantsLayoutDesc;
+  rhi::DescriptorSetLayoutBindingDesc constantsBindingDesc;
+  constantsBindingDesc.binding    = 0;
+  constantsBindingDesc.type       = rhi::ShaderBindingType::UniformbufferDynamic;
+  constantsBindingDesc.stageFlags = rhi::ShaderStageFlag::Compute;
+  constantsLayoutDesc.bindings.push_back(constantsBindingDesc);
+
+  auto constantsLayout = m_device_->createDescriptorSetLayout(constantsLayoutDesc);
+  m_constantsLayout_
+      = m_resourceManager_->addDescriptorSetLayout(std::move(constantsLayout), "gpu_cull_constants_layout");
+
+  // set 1 - instances, batch packets, depth pyramid (t0 - t2), draw arguments, visible instances (u3, u4)
+  rhi::DescriptorSetLayoutDesc cullLayoutDesc;
+  for (uint32_t binding = 0; binding < 5; ++binding) {
+    rhi::DescriptorSetLayoutBindingDesc bindingDesc;
+    bindingDesc.binding    = binding;
+    bindingDesc.type       = binding < 3 ? rhi::ShaderBindingType::BufferSrv : rhi::ShaderBindingType::BufferUav;
+    bindingDesc.stageFlags = rhi::ShaderStageFlag::Compute;
+    cullLayoutDesc.bindings.push_back(bindingDesc);
+  }
+
+  auto cullLayout = m_device_->createDescriptorSetLayout(cullLayoutDesc);
+  m_cullLayout_   = m_resourceManager_->addDescriptorSetLayout(std::move(cullLayout), "gpu_cull_layout");
+
+  // depth buffer (t0) and pyramid (u1)
+  rhi::DescriptorSetLayoutDesc        pyramidLayoutDesc;
+  rhi::DescriptorSetLayoutBindingDesc depthBindingDesc;
+  depthBindingDesc.binding    = 0;
+  depthBindingDesc.type       = rhi::ShaderBindingType::TextureSrv;
+  depthBindingDesc.stageFlags = rhi::ShaderStageFlag::Compute;
+  pyramidLayoutDesc.bindings.push_back(depthBindingDesc);
+
+  rhi::DescriptorSetLayoutBindingDesc pyramidBindingDesc;
+  pyramidBindingDesc.binding    = 1;
+  pyramidBindingDesc.type       = rhi::ShaderBindingType::BufferUav;
+  pyramidBindingDesc.stageFlags = rhi::ShaderStageFlag::Compute;
+  pyramidLayoutDesc.bindings.push_back(pyramidBindingDesc);
+
+  auto pyramidLayout = m_device_->createDescriptorSetLayout(pyramidLayoutDesc);
+  m_pyramidLayout_
+      = m_resourceManager_->addDescriptorSetLayout(std::move(pyramidLayout), "gpu_cull_depth_pyramid_layout");
+
+  rhi::ComputePipelineDesc cullPipelineDesc;
+  cullPipelineDesc.shader     = cullShader;
+  cullPipelineDesc.setLayouts = {m_constantsLayout_, m_cullLayout_};
+
+  auto cullPipeline = m_device_->createComputePipeline(cullPipelineDesc);
+  m_cullPipeline_   = m_resourceManager_->addComputePipeline(std::move(cullPipeline), "gpu_cull_pipeline");
+
+  rhi::ComputePipelineDesc pyramidPipelineDesc;
+  pyramidPipelineDesc.shader     = pyramidShader;
+  pyramidPipelineDesc.setLayouts = {m_pyramidLayout_};
+
+  auto pyramidPipeline = m_device_->createComputePipeline(pyramidPipelineDesc);
+  m_pyramidPipeline_
+      = m_resourceManager_->addComputePipeline(std::move(pyramidPipeline), "gpu_cull_depth_pyramid_pipeline");
+
+  if (!m_cullPipeline_ || !m_pyramidPipeline_) {
+    LOG_ERROR("Failed to create GPU culling pipelines");
+    return false;
+  }
+
+  shaderManager->registerPipelineForShader(m_cullPipeline_, m_cullShaderPath_);
+  shaderManager->registerPipelineForShader(m_pyramidPipeline_, m_pyramidShaderPath_);
+  return true;
+}
+
+GpuCulling::FrameData* GpuCulling::acquireFrame_(uint32_t frameIndex) {
+  if (frameIndex >= m_frames_.size()) {
+    m_frames_.resize(frameIndex + 1);
+  }
+
+  FrameData& frame = m_frames_[frameIndex];
+  if (frame.cullDescriptorSet) {
+    return &frame;
+  }
+
+  const std::string suffix = "_" + std::to_string(frameIndex);
+
+  auto constantsDescriptorSet  = m_device_->createDescriptorSet(m_constantsLayout_);
+  frame.constantsDescriptorSet = m_resourceManager_->addDescriptorSet(std::move(constantsDescriptorSet),
+                                                                      "gpu_cull_constants_descriptor_set" + suffix);
+
+  auto cullDescriptorSet  = m_device_->createDescriptorSet(m_cullLayout_);
+  frame.cullDescriptorSet = m_resourceManager_->addDescriptorSet(std::move(cullDescriptorSet),
+                                                                 "gpu_cull_descriptor_set" + suffix);
+
+  // same layout as the instance transform set of FrameResources, so draws can bind either one
+  auto instanceLayout         = m_frameResources_->getInstanceTransformDescriptorSetLayout();
+  auto instanceDescriptorSet  = m_device_->createDescriptorSet(instanceLayout);
+  frame.instanceDescriptorSet = m_resourceManager_->addDescriptorSet(std::move(instanceDescriptorSet),
+                                                                     "gpu_cull_instance_descriptor_set" + suffix);
+
+  if (!frame.constantsDescriptorSet || !frame.cullDescriptorSet || !frame.instanceDescriptorSet) {
+    LOG_ERROR("Failed to create GPU culling descriptor sets of frame {}", frameIndex);
+    frame.cullDescriptorSet = nullptr;
+    return nullptr;
+  }
+
+  return &frame;
+}
+
+bool GpuCulling::syncInstances_(FrameData& frame, uint32_t frameIndex) {
+  if (frame.instanceBuffer && frame.instanceVersion == m_instanceVersion_) {
+    return true;
+  }
+
+  frame.instanceBuffer = reserveBuffer_(frame.instanceBuffer,
+                                        m_instances_.size() * sizeof(InstanceBounds),
+                                        sizeof(InstanceBounds),
+                                        rhi::BufferType::Dynamic,
+                                        rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ShaderResource,
+                                        "gpu_cull_instance_buffer_" + std::to_string(frameIndex));
+  if (!frame.instanceBuffer) {
+    return false;
+  }
+
+  m_device_->updateBuffer(frame.instanceBuffer, m_instances_.data(), m_instances_.size() * sizeof(InstanceBounds));
+  frame.instanceVersion = m_instanceVersion_;
+  return true;
+}
+
+rhi::Buffer* GpuCulling::reserveBuffer_(rhi::Buffer*          buffer,
+                                        uint64_t              size,
+                                        uint32_t              stride,
+                                        rhi::BufferType       type,
+                                        rhi::BufferCreateFlag createFlag,
+                                        const std::string&    name) {
+  if (buffer && buffer->getDesc().size >= size && buffer->getDesc().stride == stride) {
+    return buffer;
+  }
+
+  // growth room, so instances added one by one don't recreate the buffers every time
+  rhi::BufferDesc bufferDesc;
+  bufferDesc.size        = std::max<uint64_t>(size + size / 2, 64 * std::max<uint64_t>(stride, 1));
+  bufferDesc.createFlags = createFlag;
+  bufferDesc.type        = type;
+  bufferDesc.stride      = stride;
+  bufferDesc.debugName   = name;
+
+  auto newBuffer = m_device_->createBuffer(bufferDesc);
+  if (!newBuffer) {
+    LOG_ERROR("Failed to create {}", name);
+    return nullptr;
+  }
+
+  ++m_bufferGeneration_;
+
+  // frames in flight may still use the replaced buffer, it's retired instead of destroyed by addBuffer()
+  m_resourceManager_->removeBuffer(name);
+  return m_resourceManager_->addBuffer(std::move(newBuffer), name);
+}
+
+void GpuCulling::updateDescriptorSets_(FrameData& frame) {
+  rhi::Buffer* transformBuffer = m_frameResources_->getInstanceTransformBuffer();
+  rhi::Buffer* ringBuffer      = m_frameResources_->getUploadRing()->getBuffer();
+
+  if (frame.boundBufferGeneration == m_bufferGeneration_ && frame.boundTransformBuffer == transformBuffer
+      && frame.boundRingBuffer == ringBuffer) {
+    return;
+  }
+
+  frame.constantsDescriptorSet->setUniformBuffer(0, ringBuffer, 0, alignConstantBufferSize(sizeof(CullConstants)));
+
+  frame.cullDescriptorSet->setStorageBuffer(0, frame.instanceBuffer);
+  frame.cullDescriptorSet->setStorageBuffer(1, m_batchPacketBuffer_);
+  frame.cullDescriptorSet->setStorageBuffer(2, m_pyramidBuffer_);
+  frame.cullDescriptorSet->setStorageBuffer(3, m_drawArgumentBuffer_);
+  frame.cullDescriptorSet->setStorageBuffer(4, m_visibleInstanceBuffer_);
+
+  frame.instanceDescriptorSet->setStorageBuffer(0, transformBuffer);
+  frame.instanceDescriptorSet->setStorageBuffer(1, m_visibleInstanceBuffer_);
+
+  frame.boundBufferGeneration = m_bufferGeneration_;
+  frame.boundTransformBuffer  = transformBuffer;
+  frame.boundRingBuffer       = ringBuffer;
+}
+
+void GpuCulling::computeFrustumPlanes_(const math::Matrix4f<>& viewProjection, math::Vector4f planes[6]) const {
+  // row vectors: clip = p * viewProjection, so clip.x is the dot product with column 0 etc.
+  // zero-to-one depth - the near plane is z >= 0
+  const math::Vector4f column0 = viewProjection.getColumn<0>();
+  const math::Vector4f column1 = viewProjection.getColumn<1>();
+  const math::Vector4f column2 = viewProjection.getColumn<2>();
+  const math::Vector4f column3 = viewProjection.getColumn<3>();
+
+  planes[0] = column3 + column0;  // left
+  planes[1] = column3 - column0;  // right
+  planes[2] = column3 + column1;  // bottom
+  planes[3] = column3 - column1;  // top
+  planes[4] = column2;            // near
+  planes[5] = column3 - column2;  // far
+}
+
+bool GpuCulling::isInsideFrustum_(const InstanceBounds& instance, const math::Vector4f planes[6]) const {
+  // same test as IsInsideFrustum in instance_cull.cs.hlsl
+  for (uint32_t planeIndex = 0; planeIndex < 6; ++planeIndex) {
+    const math::Vector4f& plane = planes[planeIndex];
+
+    const float distance = plane.x() * instance.center.x() + plane.y() * instance.center.y()
+                         + plane.z() * instance.center.z() + plane.w();
+    const float radius   = std::abs(plane.x()) * instance.extents.x() + std::abs(plane.y()) * instance.extents.y()
+                         + std::abs(plane.z()) * instance.extents.z();
+
+    if (distance + radius < 0.0f) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void GpuCulling::verifyReadback_(PendingReadback& readback) const {
+  const auto* data = static_cast<const uint8_t*>(readback.buffer ? readback.buffer->getMappedData() : nullptr);
+  if (!data) {
+    return;
+  }
+
+  const auto* commands = reinterpret_cast<const rhi::DrawIndexedIndirectCommand*>(data);
+  const auto* visible  = reinterpret_cast<const uint32_t*>(
+      data + uint64_t(readback.packetCount) * sizeof(rhi::DrawIndexedIndirectCommand));
+
+  std::vector<uint32_t> gpuVisible;
+  for (uint32_t packetIndex = 0; packetIndex < readback.packetCount; ++packetIndex) {
+    const rhi::DrawIndexedIndirectCommand& command = commands[packetIndex];
+    if (uint64_t(command.firstInstance) + command.instanceCount > readback.instanceCount) {
+      LOG_WARN("GPU culling: draw {} has {} instances past the instance list", packetIndex, command.instanceCount);
+      return;
+    }
+
+    gpuVisible.insert(
+        gpuVisible.end(), visible + command.firstInstance, visible + command.firstInstance + command.instanceCount);
+  }
+  std::sort(gpuVisible.begin(), gpuVisible.end());
+
+  // instances exactly on a frustum plane may end up on different sides due to rounding
+  std::vector<uint32_t> gpuOnly;
+  std::vector<uint32_t> cpuOnly;
+  std::set_difference(gpuVisible.begin(),
+                      gpuVisible.end(),
+                      readback.expectedVisible.begin(),
+                      readback.expectedVisible.end(),
+                      std::back_inserter(gpuOnly));
+  std::set_difference(readback.expectedVisible.begin(),
+                      readback.expectedVisible.end(),
+                      gpuVisible.begin(),
+                      gpuVisible.end(),
+                      std::back_inserter(cpuOnly));
+
+  // the CPU has no depth pyramid - with occlusion culling instances missing on the GPU side are expected
+  const size_t occluded   = readback.occlusion ? cpuOnly.size() : 0;
+  const size_t mismatches = gpuOnly.size() + (readback.occlusion ? 0 : cpuOnly.size());
+
+  if (mismatches > 0) {
+    LOG_WARN("GPU culling mismatch: {} visible on the GPU only, {} on the CPU only (of {} instances)",
+             gpuOnly.size(),
+             cpuOnly.size(),
+             readback.instanceCount);
+  } else {
+    LOG_DEBUG("GPU culling verified: {} of {} instances visible, {} occluded",
+              gpuVisible.size(),
+              readback.instanceCount,
+              occluded);
+  }
+}
+
+void GpuCulling::transition_(rhi::CommandBuffer* commandBuffer,
+                             rhi::Buffer*        buffer,
+                             rhi::ResourceLayout oldLayout,
+                             rhi::ResourceLayout newLayout) const {
+  rhi::ResourceBarrierDesc barrier;
+  barrier.buffer    = buffer;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  commandBuffer->resourceBarrier(barrier);
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
@@ -0,0 +1,254 @@
+#ifndef ARISE_GPU_CULLING_H
+#define ARISE_GPU_CULLING_H
+
+#include "gfx/renderer/upload_ring.h"
+#include "gfx/rhi/interface/buffer.h"
+#include "gfx/rhi/interface/command_buffer.h"
+#include "gfx/rhi/interface/descriptor.h"
+#include "gfx/rhi/interface/device.h"
+#include "gfx/rhi/interface/pipeline.h"
+#include "gfx/rhi/interface/texture.h"
+#include "utils/math/math_util.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arise::gfx::rhi {
+class ShaderManager;
+}  // namespace arise::gfx::rhi
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+class FrameResources;
+class RenderResourceManager;
+struct RenderContext;
+
+/**
+ * Culls the instances of indirect base pass draws in a compute pass (instance_cull.cs.hlsl).
+ *
+ * Each instance is tested against the view frustum and, optionally, against a depth pyramid built from the depth
+ * buffer of the previous frame (farthest depth per texel, see buildDepthPyramid()). Surviving instances are
+ * appended to the draw of their batch: the shader increments instanceCount of the draw arguments and writes the
+ * instance index into the draw's range of the visible instance buffer, which the vertex shaders read in place of
+ * the identity instance indices (getInstanceDescriptorSet()).
+ *
+ * The draw arguments are written by the CPU as usual (with zero instance counts) and copied to a GPU buffer, so
+ * the draw count and order stay CPU-driven and only the instance counts come from the GPU.
+ *
+ * Results can be read back and compared with a CPU frustum test a few frames later (RenderSettings::
+ * gpuCullingVerify) - the readback of a frame slot is checked once its fence was waited.
+ *
+ * Buffers the CPU writes (instance bounds) and the descriptor sets have a copy per frame in flight, buffers only the
+ * GPU writes are shared and ordered by barriers. Grown buffers are retired with the frame delay.
+ */
+class GpuCulling {
+  public:
+  static constexpr uint32_t kInvalidPacket  = UINT32_MAX;  // batch without a draw this frame
+  static constexpr uint32_t kMaxPyramidMips = 16;
+
+  // flags of InstanceBounds
+  static constexpr uint32_t kAlwaysVisible = 1;  // no valid bounds - never culled
+
+  // world space bounds of one instance, in instance transform buffer order (CullInstance in HLSL)
+  struct InstanceBounds {
+    math::Vector3f center;
+    uint32_t       batchIndex = 0;
+    math::Vector3f extents;
+    uint32_t       flags = 0;
+  };
+
+  static_assert(sizeof(InstanceBounds) == 8 * sizeof(float), "InstanceBounds must match the HLSL layout");
+
+  GpuCulling(rhi::Device* device, RenderResourceManager* resourceManager);
+
+  bool initialize(rhi::ShaderManager* shaderManager, FrameResources* frameResources);
+
+  /**
+   * Sets the bounds of all instances - call when the instance transforms changed. Each frame in flight uploads
+   * them to its own buffer in prepare()
+   */
+  void updateInstances(const std::vector<InstanceBounds>& instances);
+
+  /**
+   * Sets up the culling of the current frame. The instance counts of the given draw arguments are reset (the
+   * shader fills them in), batchPackets maps each batch to the index of its draw or kInvalidPacket.
+   *
+   * @return false if the frame can't be culled on the GPU - draws must use the CPU arguments then
+   */
+  bool prepare(const RenderContext&          context,
+               const UploadRing::Allocation& arguments,
+               uint32_t                      packetCount,
+               const std::vector<uint32_t>&  batchPackets);
+
+  /**
+   * Records the culling dispatch - call outside of a render pass, before the draws read getDrawArguments()
+   */
+  void cull(rhi::CommandBuffer* commandBuffer);
+
+  /**
+   * Records the depth pyramid build from the finished depth buffer, the next frame culls against it.
+   * Call outside of a render pass, the depth buffer is expected in ShaderReadOnly layout (the render graph pass
+   * reading it places the transition)
+   */
+  void buildDepthPyramid(rhi::CommandBuffer* commandBuffer, rhi::Texture* depthBuffer, uint32_t imageIndex);
+
+  // forgets the depth pyramid and pending readbacks (scene switch)
+  void clear();
+
+  void cleanup();
+
+  // arguments of all draws in packet order (rhi::DrawIndexedIndirectCommand), valid after cull()
+  rhi::Buffer* getDrawArguments() const { return m_drawArgumentBuffer_; }
+
+  // replaces the instance transform set of the draws (binding 1 - visible instances instead of identity indices),
+  // of the frame set up by prepare()
+  rhi::DescriptorSet* getInstanceDescriptorSet() const;
+
+  private:
+  // constants of the cull dispatch (CullConstants in HLSL)
+  struct CullConstants {
+    math::Vector4f   frustumPlanes[6];
+    math::Matrix4f<> pyramidViewProjection;
+    uint32_t         instanceCount    = 0;
+    uint32_t         occlusionEnabled = 0;
+    uint32_t         pyramidMipCount  = 0;
+    uint32_t         padding0         = 0;
+    uint32_t         depthWidth       = 0;
+    uint32_t         depthHeight      = 0;
+    uint32_t         padding1[2]      = {};
+
+    // offset (first texel in the pyramid buffer), width, height, unused
+    uint32_t pyramidMips[kMaxPyramidMips][4] = {};
+  };
+
+  static_assert(sizeof(CullConstants) == 112 * sizeof(float), "CullConstants must match the HLSL layout");
+
+  // push constants of depth_pyramid.cs.hlsl
+  struct PyramidConstants {
+    uint32_t srcOffset        = 0;
+    uint32_t srcWidth         = 0;
+    uint32_t srcHeight        = 0;
+    uint32_t dstOffset        = 0;
+    uint32_t dstWidth         = 0;
+    uint32_t dstHeight        = 0;
+    uint32_t fromDepthTexture = 0;
+    uint32_t padding          = 0;
+  };
+
+  struct PyramidMip {
+    uint32_t offset = 0;
+    uint32_t width  = 0;
+    uint32_t height = 0;
+  };
+
+  // results of one frame slot waiting to be compared with the CPU frustum test
+  struct PendingReadback {
+    rhi::Buffer*          buffer = nullptr;
+    std::string           name;
+    bool                  pending       = false;
+    bool                  occlusion     = false;
+    uint32_t              packetCount   = 0;
+    uint32_t              instanceCount = 0;
+    std::vector<uint32_t> expectedVisible;  // sorted instance indices inside the frustum
+  };
+
+  // resources of one frame in flight
+  struct FrameData {
+    rhi::Buffer*        instanceBuffer         = nullptr;
+    rhi::DescriptorSet* constantsDescriptorSet = nullptr;
+    rhi::DescriptorSet* cullDescriptorSet      = nullptr;
+    rhi::DescriptorSet* instanceDescriptorSet  = nullptr;
+    uint64_t            instanceVersion        = 0;  // of m_instances_ the instance buffer holds
+
+    // buffers the descriptor sets were written with
+    uint64_t     boundBufferGeneration = 0;
+    rhi::Buffer* boundTransformBuffer  = nullptr;
+    rhi::Buffer* boundRingBuffer       = nullptr;
+  };
+
+  bool createPipelines_(rhi::ShaderManager* shaderManager);
+
+  // creates the descriptor sets of the frame on first use
+  FrameData* acquireFrame_(uint32_t frameIndex);
+
+  // uploads the instance bounds to the buffer of the frame if it holds an older version
+  bool syncInstances_(FrameData& frame, uint32_t frameIndex);
+
+  // (re)creates a buffer if it is smaller than size, the old one is retired with the frame delay
+  rhi::Buffer* reserveBuffer_(rhi::Buffer*          buffer,
+                              uint64_t              size,
+                              uint32_t              stride,
+                              rhi::BufferType       type,
+                              rhi::BufferCreateFlag createFlag,
+                              const std::string&    name);
+
+  // rewrites the sets of the frame if a buffer changed - the previous submission of the frame has completed
+  void updateDescriptorSets_(FrameData& frame);
+
+  void computeFrustumPlanes_(const math::Matrix4f<>& viewProjection, math::Vector4f planes[6]) const;
+
+  bool isInsideFrustum_(const InstanceBounds& instance, const math::Vector4f planes[6]) const;
+
+  void verifyReadback_(PendingReadback& readback) const;
+
+  void transition_(rhi::CommandBuffer* commandBuffer,
+                   rhi::Buffer*        buffer,
+                   rhi::ResourceLayout oldLayout,
+                   rhi::ResourceLayout newLayout) const;
+
+  const std::string m_cullShaderPath_    = "assets/shaders/gpu_culling/instance_cull.cs.hlsl";
+  const std::string m_pyramidShaderPath_ = "assets/shaders/gpu_culling/depth_pyramid.cs.hlsl";
+
+  rhi::Device*           m_device_          = nullptr;
+  RenderResourceManager* m_resourceManager_ = nullptr;
+  FrameResources*        m_frameResources_  = nullptr;
+
+  rhi::ComputePipeline*     m_cullPipeline_    = nullptr;
+  rhi::ComputePipeline*     m_pyramidPipeline_ = nullptr;
+  rhi::DescriptorSetLayout* m_constantsLayout_ = nullptr;  // set 0 of the cull shader
+  rhi::DescriptorSetLayout* m_cullLayout_      = nullptr;  // set 1 of the cull shader
+  rhi::DescriptorSetLayout* m_pyramidLayout_   = nullptr;
+
+  // one set per swap chain image - each reads its own depth buffer
+  std::vector<rhi::DescriptorSet*> m_pyramidDescriptorSets_;
+  std::vector<rhi::Texture*>       m_pyramidDepthBuffers_;
+  std::vector<rhi::Buffer*>        m_pyramidSetBuffers_;
+
+  rhi::Buffer* m_batchPacketBuffer_     = nullptr;
+  rhi::Buffer* m_drawArgumentBuffer_    = nullptr;
+  rhi::Buffer* m_visibleInstanceBuffer_ = nullptr;
+  rhi::Buffer* m_pyramidBuffer_         = nullptr;
+  uint64_t     m_bufferGeneration_      = 0;  // incremented whenever reserveBuffer_() creates a buffer
+
+  std::vector<FrameData> m_frames_;  // one per frame in flight
+  uint32_t               m_frameIndex_ = 0;
+
+  std::vector<InstanceBounds> m_instances_;  // uploaded by every frame, also used for verification
+  uint64_t                    m_instanceVersion_ = 0;
+
+  // depth pyramid of the previous frame
+  std::vector<PyramidMip> m_pyramidMips_;
+  math::Matrix4f<>        m_pyramidViewProjection_ = math::Matrix4f<>::Identity();
+  uint32_t                m_pyramidDepthWidth_     = 0;
+  uint32_t                m_pyramidDepthHeight_    = 0;
+  bool                    m_pyramidValid_          = false;
+
+  std::vector<PendingReadback> m_readbacks_;  // one per frame in flight
+
+  // state of the frame between prepare() and cull()
+  UploadRing::Allocation m_arguments_;
+  UploadRing::Allocation m_batchPackets_;
+  UploadRing::Allocation m_constants_;
+  uint32_t               m_packetCount_   = 0;
+  uint32_t               m_batchCount_    = 0;
+  PendingReadback*       m_frameReadback_ = nullptr;  // readback recorded by cull(), null without verification
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_GPU_CULLING_H
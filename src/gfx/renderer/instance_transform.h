@@ -0,0 +1,76 @@
+#ifndef ARISE_INSTANCE_TRANSFORM_H
+#define ARISE_INSTANCE_TRANSFORM_H
+
+#include "utils/math/math_util.h"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+/**
+ * GPU layout of one element of the frame-global instance transform buffer (InstanceTransforms in HLSL).
+ *
+ * Matrices are stored as columns of the row-vector matrix, so the shader transforms with three dot products
+ * and the result does not depend on the matrix multiplication order of the target API:
+ *   worldPos.j    = dot(float4(position, 1), world[j])
+ *   worldNormal.j = dot(normal, normal[j].xyz)
+ * The last column of an affine world matrix is always (0, 0, 0, 1) and is not stored.
+ *
+ * The unused w of normal[0] carries the bindless material index of the instance (asuint in HLSL), so
+ * instances of one draw may use different materials.
+ */
+struct InstanceTransform {
+  math::Vector4f world[3];   // columns 0..2 of the world matrix (3x4)
+  math::Vector4f normal[3];  // columns of the inverse transpose of the upper 3x3, w - see above
+
+  static InstanceTransform fromMatrix(const math::Matrix4f<>& matrix, uint32_t materialIndex = 0) {
+    InstanceTransform transform;
+
+    for (int column = 0; column < 3; ++column) {
+      transform.world[column]
+          = math::Vector4f(matrix(0, column), matrix(1, column), matrix(2, column), matrix(3, column));
+    }
+
+    // inverse transpose of the upper 3x3 is its cofactor matrix divided by the determinant
+    float cofactor[3][3];
+    for (int row = 0; row < 3; ++row) {
+      const int row1 = (row + 1) % 3;
+      const int row2 = (row + 2) % 3;
+      for (int column = 0; column < 3; ++column) {
+        const int column1     = (column + 1) % 3;
+        const int column2     = (column + 2) % 3;
+        cofactor[row][column] = matrix(row1, column1) * matrix(row2, column2)
+                              - matrix(row1, column2) * matrix(row2, column1);
+      }
+    }
+
+    const float determinant
+        = matrix(0, 0) * cofactor[0][0] + matrix(0, 1) * cofactor[0][1] + matrix(0, 2) * cofactor[0][2];
+
+    // degenerate (zero scale) matrices keep the cofactors, the shader normalizes the result anyway
+    const float invDeterminant = std::abs(determinant) > 1e-12f ? 1.0f / determinant : 1.0f;
+
+    for (int column = 0; column < 3; ++column) {
+      transform.normal[column] = math::Vector4f(cofactor[0][column] * invDeterminant,
+                                                cofactor[1][column] * invDeterminant,
+                                                cofactor[2][column] * invDeterminant,
+                                                0.0f);
+    }
+
+    transform.normal[0].w() = std::bit_cast<float>(materialIndex);
+
+    return transform;
+  }
+};
+
+static_assert(sizeof(InstanceTransform) == 6 * 4 * sizeof(float), "InstanceTransform must match the HLSL layout");
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_INSTANCE_TRANSFORM_H
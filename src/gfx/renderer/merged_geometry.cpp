@@ -0,0 +1,192 @@
+#include "gfx/renderer/merged_geometry.h"
+
+#include "gfx/renderer/render_resource_manager.h"
+#include "utils/logger/log.h"
+#include "utils/third_party/xxhash_util.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+MergedGeometry::MergedGeometry(rhi::Device* device, RenderResourceManager* resourceManager)
+    : m_device_(device)
+    , m_resourceManager_(resourceManager) {
+}
+
+size_t MergedGeometry::GeometryHasher::operator()(const Geometry& geometry) const {
+  return static_cast<size_t>(XXH64(geometry.indexBuffer, XXH64(geometry.vertexBuffer)));
+}
+
+bool MergedGeometry::update(const std::vector<Geometry>& geometries) {
+  // the result of a failed layout is kept too, so unmergeable geometry is not re-examined every frame
+  if (!geometries.empty() && geometries == m_geometries_) {
+    return m_isValid_;
+  }
+
+  m_geometries_ = geometries;
+  m_entries_.clear();
+  m_entryIndices_.clear();
+  m_isValid_      = false;
+  m_vertexStride_ = 0;
+
+  uint64_t vertexBytes = 0;
+  uint64_t indexBytes  = 0;
+
+  for (const auto& geometry : geometries) {
+    if (!geometry.vertexBuffer || !geometry.indexBuffer) {
+      continue;
+    }
+
+    const uint32_t stride = geometry.vertexBuffer->getDesc().stride;
+    if (m_vertexStride_ == 0) {
+      m_vertexStride_ = stride;
+    }
+
+    if (stride == 0 || stride != m_vertexStride_) {
+      LOG_WARN("Geometry with vertex stride {} can't be merged with stride {}", stride, m_vertexStride_);
+      return false;
+    }
+
+    auto [it, inserted] = m_entryIndices_.try_emplace(geometry, static_cast<uint32_t>(m_entries_.size()));
+    if (!inserted) {
+      continue;
+    }
+
+    Entry entry;
+    entry.geometry           = geometry;
+    entry.range.firstIndex   = static_cast<uint32_t>(indexBytes / sizeof(uint32_t));
+    entry.range.indexCount   = static_cast<uint32_t>(geometry.indexBuffer->getDesc().size / sizeof(uint32_t));
+    entry.range.vertexOffset = static_cast<int32_t>(vertexBytes / stride);
+    m_entries_.push_back(entry);
+
+    vertexBytes += geometry.vertexBuffer->getDesc().size;
+    indexBytes  += uint64_t(entry.range.indexCount) * sizeof(uint32_t);
+  }
+
+  if (m_entries_.empty()) {
+    return false;
+  }
+
+  m_vertexBuffer_ = reserveBuffer_(
+      m_vertexBuffer_, vertexBytes, m_vertexStride_, rhi::BufferCreateFlag::VertexBuffer, "merged_vertex_buffer");
+  m_indexBuffer_ = reserveBuffer_(
+      m_indexBuffer_, indexBytes, sizeof(uint32_t), rhi::BufferCreateFlag::IndexBuffer, "merged_index_buffer");
+
+  if (!m_vertexBuffer_ || !m_indexBuffer_) {
+    return false;
+  }
+
+  LOG_DEBUG("Merged {} geometries ({} vertex bytes, {} index bytes)", m_entries_.size(), vertexBytes, indexBytes);
+
+  m_isValid_     = true;
+  m_needsUpload_ = true;
+  return true;
+}
+
+void MergedGeometry::upload(rhi::CommandBuffer* commandBuffer) {
+  if (!m_isValid_ || !m_needsUpload_ || !commandBuffer) {
+    return;
+  }
+
+  auto transition = [commandBuffer](rhi::Buffer* buffer, rhi::ResourceLayout oldLayout, rhi::ResourceLayout newLayout) {
+    rhi::ResourceBarrierDesc barrier;
+    barrier.buffer    = buffer;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    commandBuffer->resourceBarrier(barrier);
+  };
+
+  // mesh buffers may be shared between geometries
+  std::vector<rhi::Buffer*>        sourceBuffers;
+  std::unordered_set<rhi::Buffer*> uniqueSourceBuffers;
+  for (const auto& entry : m_entries_) {
+    for (rhi::Buffer* buffer : {entry.geometry.vertexBuffer, entry.geometry.indexBuffer}) {
+      if (uniqueSourceBuffers.insert(buffer).second) {
+        sourceBuffers.push_back(buffer);
+      }
+    }
+  }
+
+  // the merged buffers may still be read by the previous frame - the barrier orders the copies after it
+  transition(m_vertexBuffer_, rhi::ResourceLayout::ReadOnly, rhi::ResourceLayout::TransferDst);
+  transition(m_indexBuffer_, rhi::ResourceLayout::ReadOnly, rhi::ResourceLayout::TransferDst);
+  for (rhi::Buffer* buffer : sourceBuffers) {
+    transition(buffer, rhi::ResourceLayout::ReadOnly, rhi::ResourceLayout::TransferSrc);
+  }
+
+  for (const auto& entry : m_entries_) {
+    const Range& range = entry.range;
+    commandBuffer->copyBuffer(entry.geometry.vertexBuffer,
+                              m_vertexBuffer_,
+                              0,
+                              uint64_t(range.vertexOffset) * m_vertexStride_,
+                              entry.geometry.vertexBuffer->getDesc().size);
+    commandBuffer->copyBuffer(entry.geometry.indexBuffer,
+                              m_indexBuffer_,
+                              0,
+                              uint64_t(range.firstIndex) * sizeof(uint32_t),
+                              uint64_t(range.indexCount) * sizeof(uint32_t));
+  }
+
+  // combined read state - covers vertex / index input, so mesh buffers can still be drawn directly
+  transition(m_vertexBuffer_, rhi::ResourceLayout::TransferDst, rhi::ResourceLayout::ReadOnly);
+  transition(m_indexBuffer_, rhi::ResourceLayout::TransferDst, rhi::ResourceLayout::ReadOnly);
+  for (rhi::Buffer* buffer : sourceBuffers) {
+    transition(buffer, rhi::ResourceLayout::TransferSrc, rhi::ResourceLayout::ReadOnly);
+  }
+
+  m_needsUpload_ = false;
+}
+
+void MergedGeometry::clear() {
+  // buffers are owned by the resource manager and reused by the next update()
+  m_geometries_.clear();
+  m_entries_.clear();
+  m_entryIndices_.clear();
+  m_isValid_     = false;
+  m_needsUpload_ = false;
+}
+
+const MergedGeometry::Range* MergedGeometry::findRange(const Geometry& geometry) const {
+  if (!m_isValid_) {
+    return nullptr;
+  }
+
+  auto it = m_entryIndices_.find(geometry);
+  return it != m_entryIndices_.end() ? &m_entries_[it->second].range : nullptr;
+}
+
+rhi::Buffer* MergedGeometry::reserveBuffer_(rhi::Buffer*          buffer,
+                                            uint64_t              size,
+                                            uint32_t              stride,
+                                            rhi::BufferCreateFlag createFlag,
+                                            const std::string&    name) {
+  if (buffer && buffer->getDesc().size >= size && buffer->getDesc().stride == stride) {
+    return buffer;
+  }
+
+  // growth room, so meshes streamed in one by one don't recreate the buffers every time
+  rhi::BufferDesc bufferDesc;
+  bufferDesc.size        = std::max<uint64_t>(size + size / 2, 64 * 1024);
+  bufferDesc.createFlags = createFlag;
+  bufferDesc.type        = rhi::BufferType::Static;
+  bufferDesc.stride      = stride;
+  bufferDesc.debugName   = name;
+
+  auto newBuffer = m_device_->createBuffer(bufferDesc);
+  if (!newBuffer) {
+    LOG_ERROR("Failed to create {}", name);
+    return nullptr;
+  }
+
+  // the replaced buffer is retired instead of being destroyed by addBuffer(), frames in flight may still draw from it
+  m_resourceManager_->removeBuffer(name);
+  return m_resourceManager_->addBuffer(std::move(newBuffer), name);
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
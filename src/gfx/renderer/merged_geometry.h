@@ -0,0 +1,109 @@
+#ifndef ARISE_MERGED_GEOMETRY_H
+#define ARISE_MERGED_GEOMETRY_H
+
+#include "gfx/rhi/interface/buffer.h"
+#include "gfx/rhi/interface/command_buffer.h"
+#include "gfx/rhi/interface/device.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+class RenderResourceManager;
+
+/**
+ * Vertex and index data of many meshes copied into one vertex and one index buffer (32-bit indices).
+ *
+ * Meshes own separate geometry buffers, so each of them needs its own bind and its own draw call. Once merged,
+ * draws of different meshes only differ in firstIndex / vertexOffset and a whole pipeline bucket can be
+ * submitted with a single multi-draw indirect call.
+ *
+ * update() lays out the geometry on the CPU, upload() records the GPU copies - the merged buffers are valid
+ * for drawing after it (isReady()). The buffers grow on demand and are rewritten in place otherwise.
+ */
+class MergedGeometry {
+  public:
+  // geometry of one mesh, as referenced by RenderGeometryMesh
+  struct Geometry {
+    rhi::Buffer* vertexBuffer = nullptr;
+    rhi::Buffer* indexBuffer  = nullptr;
+
+    bool operator==(const Geometry& other) const = default;
+  };
+
+  // draw arguments addressing a geometry inside the merged buffers
+  struct Range {
+    uint32_t firstIndex   = 0;
+    uint32_t indexCount   = 0;
+    int32_t  vertexOffset = 0;
+  };
+
+  MergedGeometry(rhi::Device* device, RenderResourceManager* resourceManager);
+
+  /**
+   * Lays out the given geometries (duplicates are stored once). Does nothing if the list did not change since the
+   * previous call.
+   *
+   * @return false if the geometries can't share buffers (different vertex strides) - draws must bind mesh buffers
+   */
+  bool update(const std::vector<Geometry>& geometries);
+
+  /**
+   * Records the copies of the last update() - call outside of a render pass, before the merged buffers are drawn
+   */
+  void upload(rhi::CommandBuffer* commandBuffer);
+
+  void clear();
+
+  // true after a successful update(), the buffers hold the data once upload() was recorded
+  bool isValid() const { return m_isValid_; }
+  bool isReady() const { return m_isValid_ && !m_needsUpload_; }
+
+  // nullptr if the geometry was not part of the last update()
+  const Range* findRange(const Geometry& geometry) const;
+
+  rhi::Buffer* getVertexBuffer() const { return m_vertexBuffer_; }
+  rhi::Buffer* getIndexBuffer() const { return m_indexBuffer_; }
+
+  private:
+  struct GeometryHasher {
+    size_t operator()(const Geometry& geometry) const;
+  };
+
+  struct Entry {
+    Geometry geometry;
+    Range    range;
+  };
+
+  // (re)creates a merged buffer if it is smaller than size, the old one is released by the resource manager
+  rhi::Buffer* reserveBuffer_(rhi::Buffer*          buffer,
+                              uint64_t              size,
+                              uint32_t              stride,
+                              rhi::BufferCreateFlag createFlag,
+                              const std::string&    name);
+
+  rhi::Device*           m_device_          = nullptr;
+  RenderResourceManager* m_resourceManager_ = nullptr;
+
+  rhi::Buffer* m_vertexBuffer_ = nullptr;
+  rhi::Buffer* m_indexBuffer_  = nullptr;
+  uint32_t     m_vertexStride_ = 0;
+
+  std::vector<Geometry>                                  m_geometries_;  // input of the last update()
+  std::vector<Entry>                                     m_entries_;     // unique geometries in buffer order
+  std::unordered_map<Geometry, uint32_t, GeometryHasher> m_entryIndices_;
+
+  bool m_isValid_     = false;
+  bool m_needsUpload_ = false;
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_MERGED_GEOMETRY_H
@@ -16,9 +16,12 @@
 #include "gfx/rhi/shader_reflection/vertex_input_builder.h"
 #include "profiler/profiler.h"
 #include "utils/logger/log.h"
+#include "utils/memory/linear_allocator.h"
+#include "utils/third_party/xxhash_util.h"
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace arise {
 namespace gfx {
@@ -33,13 +36,29 @@ void BasePass::initialize(rhi::Device*           device,
   m_shaderManager   = shaderManager;
 
   if (shaderManager) {
-    m_vertexShader = shaderManager->getShader(m_vertexShaderPath_);
-    m_pixelShader  = shaderManager->getShader(m_pixelShaderPath_);
+    m_vertexShader           = shaderManager->getShader(m_vertexShaderPath_);
+    m_pixelShader            = shaderManager->getShader(m_pixelShaderPath_);
+    m_maskedPixelShader      = shaderManager->getShader(m_maskedPixelShaderPath_);
+    m_transparentPixelShader = shaderManager->getShader(m_transparentPixelShaderPath_);
+
+    m_depthPrePassVertexShader       = shaderManager->getShader(m_depthPrePassVertexShaderPath_);
+    m_depthPrePassMaskedVertexShader = shaderManager->getShader(m_depthPrePassMaskedVertexShaderPath_);
+    m_depthPrePassMaskedPixelShader  = shaderManager->getShader(m_depthPrePassMaskedPixelShaderPath_);
   } else {
     LOG_ERROR("ShaderManager not found");
   }
 
+  m_mergedGeometry = std::make_unique<MergedGeometry>(device, resourceManager);
+
+  // without its pipelines the indirect mode keeps drawing every instance
+  m_gpuCulling = std::make_unique<GpuCulling>(device, resourceManager);
+  if (!m_gpuCulling->initialize(shaderManager, frameResources)) {
+    LOG_WARN("GPU culling is not available");
+    m_gpuCulling.reset();
+  }
+
   setupRenderPass_();
+  setupDepthPrePass_();
 }
 
 void BasePass::resize(const math::Dimension2i& newDimension) {
@@ -55,40 +74,56 @@ void BasePass::resize(const math::Dimension2i& newDimension) {
   m_scissor.width  = newDimension.width();
   m_scissor.height = newDimension.height();
 
-  createFramebuffer_(newDimension);
+  // framebuffers reference the render targets, which usually outlive a viewport change
+  if (m_renderTargetGeneration != m_frameResources->getRenderTargetGeneration()) {
+    createFramebuffer_(m_frameResources->getRenderTargetDimension());
+    m_renderTargetGeneration = m_frameResources->getRenderTargetGeneration();
+  }
 }
 
 void BasePass::prepareFrame(const RenderContext& context) {
   CPU_ZONE_NC("BasePass::prepareFrame", color::YELLOW);
 
-  std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>> currentFrameInstances;
-  std::unordered_map<ecs::RenderModel*, bool>                          modelDirtyFlags;
-
-  for (const auto& instance : m_frameResources->getModels()) {
-    currentFrameInstances[instance->model].push_back(instance->modelMatrix);
+  const auto& models = m_frameResources->getModels();
 
+  bool needsRebuild = !std::equal(models.begin(), models.end(), m_batchedInstances.begin(), m_batchedInstances.end());
+  for (const auto& instance : models) {
     if (instance->isDirty) {
-      modelDirtyFlags[instance->model] = true;
+      needsRebuild = true;
+      break;
     }
   }
 
-  for (auto& [model, matrices] : currentFrameInstances) {
-    auto& cache = m_instanceBufferCache[model];
+  if (needsRebuild) {
+    CPU_ZONE_NC("Build Instance Batches", color::YELLOW);
+    buildInstanceBatches_();
+    m_batchedInstances.assign(models.begin(), models.end());
+    m_mergedGeometryDirty = true;
+    m_cullBoundsDirty     = true;
+  }
 
-    bool needsUpdate = cache.instanceBuffer == nullptr ||   // Buffer not created yet
-                       matrices.size() > cache.capacity ||  // Need more space
-                       matrices.size() != cache.count ||    // Count changed
-                       modelDirtyFlags[model];              // Model was modified
+  // merged geometry is kept up to date only while the indirect mode is used. Indirect draws address their instances
+  // through firstInstance, without device support the frame is drawn directly
+  const bool indirectDraw = context.renderSettings.indirectDraw && m_device->isDrawIndirectFirstInstanceSupported()
+                         && updateMergedGeometry_();
 
-    if (needsUpdate) {
-      CPU_ZONE_NC("Update Instance Buffers", color::YELLOW);
-      updateInstanceBuffer_(model, matrices, cache);
-    }
+  // GPU culling maps each batch to a single draw, CPU occlusion results would split batches into several
+  const bool gpuCulling = indirectDraw && context.renderSettings.gpuCulling && m_gpuCulling;
+  if (context.renderSettings.softwareOcclusion && !gpuCulling) {
+    cullOccludedInstances_();
   }
 
-  cleanupUnusedBuffers_(currentFrameInstances);
+  prepareDrawCalls_(context, indirectDraw);
+
+  buildDrawPackets_();
 
-  prepareDrawCalls_(context);
+  // arguments of the previous frame must not be reused once the frame falls back to direct draws
+  m_indirectArguments = {};
+  m_gpuCulled         = false;
+  if (indirectDraw) {
+    writeIndirectArguments_();
+    m_gpuCulled = context.renderSettings.gpuCulling && prepareGpuCulling_(context);
+  }
 }
 
 void BasePass::render(RenderContext& context) {
@@ -99,6 +134,21 @@ void BasePass::render(RenderContext& context) {
     return;
   }
 
+  // newly merged geometry is copied before the first draw (copies can't be recorded inside a render pass)
+  if (m_mergedGeometry) {
+    m_mergedGeometry->upload(commandBuffer);
+  }
+
+  // instance counts of the indirect draws, recorded before the pre-pass reads them
+  if (m_gpuCulled) {
+    m_gpuCulling->cull(commandBuffer);
+  }
+
+  const bool depthPrePass = context.renderSettings.depthPrePass && m_depthPrePassRenderPass && m_depthLoadRenderPass;
+  if (depthPrePass) {
+    renderDepthPrePass_(context);
+  }
+
   GPU_ZONE_NC(commandBuffer, "Base Pass", color::ORANGE);
 
   std::vector<rhi::ClearValue> clearValues;
@@ -116,77 +166,245 @@ void BasePass::render(RenderContext& context) {
   clearValues.push_back(depthClear);
 
   uint32_t currentIndex = context.currentImageIndex;
-  if (currentIndex >= m_framebuffers.size()) {
+  if (currentIndex >= m_framebuffers.size() || !m_framebuffers[currentIndex]) {
     LOG_ERROR("Invalid framebuffer index");
     return;
   }
 
   rhi::Framebuffer* currentFramebuffer = m_framebuffers[currentIndex];
 
-  commandBuffer->beginRenderPass(m_renderPass, currentFramebuffer, clearValues);
+  // after the pre-pass depth is loaded instead of cleared (color is still cleared)
+  rhi::RenderPass* renderPass = depthPrePass ? m_depthLoadRenderPass : m_renderPass;
+
+  commandBuffer->beginRenderPass(renderPass, currentFramebuffer, clearValues);
 
   commandBuffer->setViewport(m_viewport);
   commandBuffer->setScissor(m_scissor);
 
+  if (m_occlusionCulled) {
+    context.statistics.occludedInstances += m_occludedInstanceCount;
+    context.statistics.occluderMeshes    += m_softwareOcclusion.getOccluderCount();
+    context.softwareOcclusion             = &m_softwareOcclusion;
+  }
+
   {
     CPU_ZONE_NC("Draw Models", color::GREEN);
-    
-    rhi::GraphicsPipeline* lastPipeline = nullptr;
-    rhi::DescriptorSet* lastMaterialDescriptorSet = nullptr;
-    
-    for (const auto& drawData : m_drawData) {
+
+    rhi::GraphicsPipeline* lastPipeline     = nullptr;
+    rhi::Buffer*           lastVertexBuffer = nullptr;
+    rhi::Buffer*           lastIndexBuffer  = nullptr;
+
+    const auto& packets      = m_drawPackets.getPackets();
+    const bool  indirectDraw = m_indirectArguments.isValid();
+
+    uint64_t            argumentOffset        = 0;
+    rhi::Buffer*        argumentBuffer        = getIndirectArguments_(argumentOffset);
+    rhi::DescriptorSet* instanceDescriptorSet = getInstanceDescriptorSet_();
+
+    // packets are sorted by state, so redundant binds between neighbouring draws are skipped
+    for (size_t packetIndex = 0; packetIndex < packets.size();) {
+      const auto& drawData = m_drawData[packets[packetIndex].drawIndex];
+
       // render statistics - pipeline switches
       if (drawData.pipeline != lastPipeline) {
         commandBuffer->setPipeline(drawData.pipeline);
         context.statistics.setPassCalls++;
         lastPipeline = drawData.pipeline;
+
+        // pipeline change may reset the bound root signature / layout
+        if (m_frameResources->getViewDescriptorSet()) {
+          commandBuffer->bindDescriptorSet(
+              0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
+        }
+
+        if (instanceDescriptorSet) {
+          commandBuffer->bindDescriptorSet(1, instanceDescriptorSet);
+        }
+
+        if (m_frameResources->getLightDescriptorSet()) {
+          commandBuffer->bindDescriptorSet(2, m_frameResources->getLightDescriptorSet());
+        }
+
+        // all materials at once - draws index it with the material index of their instances
+        if (m_frameResources->getBindlessMaterials()->getDescriptorSet()) {
+          commandBuffer->bindDescriptorSet(3, m_frameResources->getBindlessMaterials()->getDescriptorSet());
+        }
+
+        if (m_frameResources->getDefaultSamplerDescriptorSet()) {
+          commandBuffer->bindDescriptorSet(4, m_frameResources->getDefaultSamplerDescriptorSet());
+        }
       }
-      
-      // render statistics - material batches (using descriptor set as proxy for material)
-      if (drawData.materialDescriptorSet != lastMaterialDescriptorSet) {
-        context.statistics.batches++;
-        lastMaterialDescriptorSet = drawData.materialDescriptorSet;
+
+      if (drawData.vertexBuffer != lastVertexBuffer) {
+        commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
+        lastVertexBuffer = drawData.vertexBuffer;
       }
 
-      if (m_frameResources->getViewDescriptorSet()) {
-        commandBuffer->bindDescriptorSet(0, m_frameResources->getViewDescriptorSet());
+      if (drawData.indexBuffer != lastIndexBuffer) {
+        commandBuffer->bindIndexBuffer(drawData.indexBuffer, 0, true);
+        lastIndexBuffer = drawData.indexBuffer;
       }
 
-      if (drawData.modelMatrixDescriptorSet) {
-        commandBuffer->bindDescriptorSet(1, drawData.modelMatrixDescriptorSet);
+      // indirect mode submits the whole run of packets that share pipeline and geometry with one call
+      const uint32_t drawCount = indirectDraw ? getIndirectDrawRun_(packetIndex, &DrawData::pipeline) : 1;
+
+      if (indirectDraw) {
+        commandBuffer->pushConstants(DrawConstants{0});
+        commandBuffer->multiDrawIndexedIndirect(
+            argumentBuffer, argumentOffset + packetIndex * sizeof(rhi::DrawIndexedIndirectCommand), drawCount);
+      } else {
+        // instance range of the draw in the frame-global transform buffer
+        commandBuffer->pushConstants(DrawConstants{drawData.instanceOffset});
+        commandBuffer->drawIndexedInstanced(
+            drawData.indexCount, drawData.instanceCount, drawData.firstIndex, drawData.vertexOffset);
       }
 
-      if (m_frameResources->getLightDescriptorSet()) {
-        commandBuffer->bindDescriptorSet(2, m_frameResources->getLightDescriptorSet());
+      // render statistics (with GPU culling the instance counts are the ones before culling)
+      context.statistics.drawCalls++;
+      for (size_t runIndex = packetIndex; runIndex < packetIndex + drawCount; ++runIndex) {
+        const auto& runDrawData = m_drawData[packets[runIndex].drawIndex];
+        context.statistics.batches++;
+        context.statistics.mergedMeshes      += runDrawData.sourceMeshCount - 1;
+        context.statistics.instancesRendered += runDrawData.instanceCount;
+        context.statistics.trianglesRendered += (runDrawData.indexCount / 3) * runDrawData.instanceCount;
       }
 
-      if (drawData.materialDescriptorSet) {
-        commandBuffer->bindDescriptorSet(3, drawData.materialDescriptorSet);
+      packetIndex += drawCount;
+    }
+  }
+  commandBuffer->endRenderPass();
+}
+
+void BasePass::renderDepthPyramid(RenderContext& context, rhi::Texture* depthBuffer) {
+  CPU_ZONE_NC("BasePass::renderDepthPyramid", color::ORANGE);
+
+  if (!m_gpuCulling) {
+    return;
+  }
+  m_gpuCulling->buildDepthPyramid(context.commandBuffer.get(), depthBuffer, context.currentImageIndex);
+}
+
+void BasePass::renderDepthPrePass_(RenderContext& context) {
+  CPU_ZONE_NC("BasePass::renderDepthPrePass", color::ORANGE);
+
+  auto commandBuffer = context.commandBuffer.get();
+
+  uint32_t currentIndex = context.currentImageIndex;
+  if (currentIndex >= m_depthPrePassFramebuffers.size() || !m_depthPrePassFramebuffers[currentIndex]) {
+    LOG_ERROR("Invalid depth pre-pass framebuffer index");
+    return;
+  }
+
+  GPU_ZONE_NC(commandBuffer, "Depth Pre-Pass", color::ORANGE);
+
+  std::vector<rhi::ClearValue> clearValues;
+
+  rhi::ClearValue depthClear;
+  depthClear.depthStencil.depth   = 1.0f;
+  depthClear.depthStencil.stencil = 0;
+  clearValues.push_back(depthClear);
+
+  commandBuffer->beginRenderPass(m_depthPrePassRenderPass, m_depthPrePassFramebuffers[currentIndex], clearValues);
+
+  commandBuffer->setViewport(m_viewport);
+  commandBuffer->setScissor(m_scissor);
+
+  rhi::GraphicsPipeline* lastPipeline          = nullptr;
+  rhi::Buffer*           lastVertexBuffer      = nullptr;
+  rhi::Buffer*           lastIndexBuffer       = nullptr;
+  rhi::DescriptorSet*    materialDescriptorSet = m_frameResources->getBindlessMaterials()->getDescriptorSet();
+  rhi::DescriptorSet*    samplerDescriptorSet  = m_frameResources->getDefaultSamplerDescriptorSet();
+
+  const auto& packets      = m_drawPackets.getPackets();
+  const bool  indirectDraw = m_indirectArguments.isValid();
+
+  uint64_t            argumentOffset        = 0;
+  rhi::Buffer*        argumentBuffer        = getIndirectArguments_(argumentOffset);
+  rhi::DescriptorSet* instanceDescriptorSet = getInstanceDescriptorSet_();
+
+  // same front-to-back packet order as the base pass
+  for (size_t packetIndex = 0; packetIndex < packets.size();) {
+    const auto& drawData = m_drawData[packets[packetIndex].drawIndex];
+    if (!drawData.depthPrePassPipeline) {
+      ++packetIndex;
+      continue;
+    }
+
+    if (drawData.depthPrePassPipeline != lastPipeline) {
+      commandBuffer->setPipeline(drawData.depthPrePassPipeline);
+      context.statistics.setPassCalls++;
+      lastPipeline = drawData.depthPrePassPipeline;
+
+      if (m_frameResources->getViewDescriptorSet()) {
+        commandBuffer->bindDescriptorSet(
+            0, m_frameResources->getViewDescriptorSet(), {m_frameResources->getViewDynamicOffset()});
       }
 
-      if (m_frameResources->getDefaultSamplerDescriptorSet()) {
-        commandBuffer->bindDescriptorSet(4, m_frameResources->getDefaultSamplerDescriptorSet());
+      if (instanceDescriptorSet) {
+        commandBuffer->bindDescriptorSet(1, instanceDescriptorSet);
       }
 
+      // only the alpha-tested pipeline reads materials
+      if (drawData.layer == RenderLayer::Masked && materialDescriptorSet && samplerDescriptorSet) {
+        commandBuffer->bindDescriptorSet(2, materialDescriptorSet);
+        commandBuffer->bindDescriptorSet(3, samplerDescriptorSet);
+      }
+    }
+
+    if (drawData.vertexBuffer != lastVertexBuffer) {
       commandBuffer->bindVertexBuffer(0, drawData.vertexBuffer);
-      commandBuffer->bindVertexBuffer(1, drawData.instanceBuffer);
+      lastVertexBuffer = drawData.vertexBuffer;
+    }
+
+    if (drawData.indexBuffer != lastIndexBuffer) {
       commandBuffer->bindIndexBuffer(drawData.indexBuffer, 0, true);
+      lastIndexBuffer = drawData.indexBuffer;
+    }
 
-      commandBuffer->drawIndexedInstanced(drawData.indexCount, drawData.instanceCount, 0, 0, 0);
-      
-      // render statistics
-      context.statistics.drawCalls++;
-      context.statistics.instancesRendered += drawData.instanceCount;
-      context.statistics.trianglesRendered += (drawData.indexCount / 3) * drawData.instanceCount;
+    const uint32_t drawCount = indirectDraw ? getIndirectDrawRun_(packetIndex, &DrawData::depthPrePassPipeline) : 1;
+
+    if (indirectDraw) {
+      commandBuffer->pushConstants(DrawConstants{0});
+      commandBuffer->multiDrawIndexedIndirect(
+          argumentBuffer, argumentOffset + packetIndex * sizeof(rhi::DrawIndexedIndirectCommand), drawCount);
+    } else {
+      commandBuffer->pushConstants(DrawConstants{drawData.instanceOffset});
+      commandBuffer->drawIndexedInstanced(
+          drawData.indexCount, drawData.instanceCount, drawData.firstIndex, drawData.vertexOffset);
     }
+
+    context.statistics.drawCalls++;
+    packetIndex += drawCount;
   }
+
   commandBuffer->endRenderPass();
 }
 
 void BasePass::clearSceneResources() {
-  m_instanceBufferCache.clear();
-  m_materialCache.clear();
+  m_instanceBatches.clear();
+  m_batchedInstances.clear();
   m_drawData.clear();
+  m_drawPackets.clear();
+  m_pipelineSortIds.clear();
+  m_geometrySortIds.clear();
+  m_indirectArguments = {};
+  m_gpuCulled         = false;
+  m_occlusionCulled   = false;
+  m_instanceVisibility.clear();
+
+  // cached occluder geometry points to the meshes of the old scene
+  m_softwareOcclusion.clear();
+
+  // mesh buffers of the old scene are about to be released
+  if (m_mergedGeometry) {
+    m_mergedGeometry->clear();
+  }
+  m_mergedGeometryDirty = true;
+
+  if (m_gpuCulling) {
+    m_gpuCulling->clear();
+  }
+  m_cullBoundsDirty = true;
   LOG_INFO("Base pass resources cleared for scene switch");
 }
 
@@ -194,11 +412,27 @@ void BasePass::cleanup() {
   clearSceneResources();
 
   m_framebuffers.clear();
+  m_depthPrePassFramebuffers.clear();
 
-  m_renderPass = nullptr;
+  m_renderPass             = nullptr;
+  m_depthPrePassRenderPass = nullptr;
+  m_depthLoadRenderPass    = nullptr;
 
-  m_vertexShader = nullptr;
-  m_pixelShader  = nullptr;
+  m_vertexShader           = nullptr;
+  m_pixelShader            = nullptr;
+  m_maskedPixelShader      = nullptr;
+  m_transparentPixelShader = nullptr;
+
+  m_depthPrePassVertexShader       = nullptr;
+  m_depthPrePassMaskedVertexShader = nullptr;
+  m_depthPrePassMaskedPixelShader  = nullptr;
+
+  m_mergedGeometry.reset();
+
+  if (m_gpuCulling) {
+    m_gpuCulling->cleanup();
+    m_gpuCulling.reset();
+  }
 
   m_layoutManager.cleanup();
 }
@@ -230,6 +464,45 @@ void BasePass::setupRenderPass_() {
   m_renderPass    = m_resourceManager->addRenderPass(std::move(renderPass), "base_pass_render_pass");
 }
 
+void BasePass::setupDepthPrePass_() {
+  // Depth-only render pass
+  rhi::RenderPassDesc prePassDesc;
+
+  rhi::RenderPassAttachmentDesc depthAttachmentDesc;
+  depthAttachmentDesc.format             = rhi::TextureFormat::D24S8;
+  depthAttachmentDesc.samples            = rhi::MSAASamples::Count1;
+  depthAttachmentDesc.loadStoreOp        = rhi::AttachmentLoadStoreOp::ClearStore;
+  depthAttachmentDesc.stencilLoadStoreOp = rhi::AttachmentLoadStoreOp::ClearStore;
+  depthAttachmentDesc.initialLayout      = rhi::ResourceLayout::DepthStencilAttachment;
+  depthAttachmentDesc.finalLayout        = rhi::ResourceLayout::DepthStencilAttachment;
+  prePassDesc.depthStencilAttachment     = depthAttachmentDesc;
+  prePassDesc.hasDepthStencil            = true;
+
+  auto prePassRenderPass = m_device->createRenderPass(prePassDesc);
+  m_depthPrePassRenderPass
+      = m_resourceManager->addRenderPass(std::move(prePassRenderPass), "depth_prepass_render_pass");
+
+  // Base pass variant that keeps the pre-pass depth
+  rhi::RenderPassDesc depthLoadDesc;
+
+  rhi::RenderPassAttachmentDesc colorAttachmentDesc;
+  colorAttachmentDesc.format        = rhi::TextureFormat::Bgra8;
+  colorAttachmentDesc.samples       = rhi::MSAASamples::Count1;
+  colorAttachmentDesc.loadStoreOp   = rhi::AttachmentLoadStoreOp::ClearStore;
+  colorAttachmentDesc.initialLayout = rhi::ResourceLayout::ColorAttachment;
+  colorAttachmentDesc.finalLayout   = rhi::ResourceLayout::ColorAttachment;
+  depthLoadDesc.colorAttachments.push_back(colorAttachmentDesc);
+
+  depthAttachmentDesc.loadStoreOp        = rhi::AttachmentLoadStoreOp::LoadStore;
+  depthAttachmentDesc.stencilLoadStoreOp = rhi::AttachmentLoadStoreOp::LoadStore;
+  depthLoadDesc.depthStencilAttachment   = depthAttachmentDesc;
+  depthLoadDesc.hasDepthStencil          = true;
+
+  auto depthLoadRenderPass = m_device->createRenderPass(depthLoadDesc);
+  m_depthLoadRenderPass
+      = m_resourceManager->addRenderPass(std::move(depthLoadRenderPass), "base_pass_depth_load_render_pass");
+}
+
 void BasePass::createFramebuffer_(const math::Dimension2i& dimension) {
   if (!m_renderPass) {
     LOG_ERROR("Render pass must be created before framebuffer");
@@ -250,11 +523,16 @@ void BasePass::createFramebuffer_(const math::Dimension2i& dimension) {
 
     auto& renderTargets = m_frameResources->getRenderTargets(i);
 
+    if (!renderTargets.depthBuffer) {
+      m_framebuffers.push_back(nullptr);
+      continue;
+    }
+
     rhi::FramebufferDesc framebufferDesc;
     framebufferDesc.width  = dimension.width();
     framebufferDesc.height = dimension.height();
     framebufferDesc.colorAttachments.push_back(renderTargets.colorBuffer.get());
-    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer.get();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
     framebufferDesc.hasDepthStencil        = true;
     framebufferDesc.renderPass             = m_renderPass;
 
@@ -263,263 +541,609 @@ void BasePass::createFramebuffer_(const math::Dimension2i& dimension) {
 
     m_framebuffers.push_back(framebufferPtr);
   }
-}
 
-void BasePass::updateInstanceBuffer_(ecs::RenderModel*                    model,
-                                     const std::vector<math::Matrix4f<>>& matrices,
-                                     ModelBufferCache&                    cache) {
-  if (!cache.instanceBuffer || matrices.size() > cache.capacity) {
-    // If we already have a buffer, we'll let the resource manager handle freeing it
+  if (!m_depthPrePassRenderPass) {
+    return;
+  }
 
-    // Create a new buffer with some growth room
-    uint32_t newCapacity = std::max(static_cast<uint32_t>(matrices.size() * 1.5), 8u);
+  m_depthPrePassFramebuffers.clear();
 
-    std::string bufferKey = "instance_buffer_" + std::to_string(reinterpret_cast<uintptr_t>(model));
+  for (uint32_t i = 0; i < framesCount; i++) {
+    std::string framebufferKey = "depth_prepass_framebuffer_" + std::to_string(i);
 
-    rhi::BufferDesc bufferDesc;
-    bufferDesc.size        = newCapacity * sizeof(math::Matrix4f<>);
-    bufferDesc.createFlags = rhi::BufferCreateFlag::InstanceBuffer;
-    bufferDesc.type        = rhi::BufferType::Dynamic;
-    bufferDesc.stride      = sizeof(math::Matrix4f<>);
-    bufferDesc.debugName   = bufferKey;
+    if (m_resourceManager->getFramebuffer(framebufferKey)) {
+      m_resourceManager->removeFramebuffer(framebufferKey);
+    }
 
-    auto buffer          = m_device->createBuffer(bufferDesc);
-    cache.instanceBuffer = m_resourceManager->addBuffer(std::move(buffer), bufferKey);
-    cache.capacity       = newCapacity;
-  }
+    auto& renderTargets = m_frameResources->getRenderTargets(i);
 
-  if (cache.instanceBuffer && !matrices.empty()) {
-    m_device->updateBuffer(cache.instanceBuffer, matrices.data(), matrices.size() * sizeof(math::Matrix4f<>));
+    if (!renderTargets.depthBuffer) {
+      m_depthPrePassFramebuffers.push_back(nullptr);
+      continue;
+    }
+
+    rhi::FramebufferDesc framebufferDesc;
+    framebufferDesc.width                  = dimension.width();
+    framebufferDesc.height                 = dimension.height();
+    framebufferDesc.depthStencilAttachment = renderTargets.depthBuffer;
+    framebufferDesc.hasDepthStencil        = true;
+    framebufferDesc.renderPass             = m_depthPrePassRenderPass;
+
+    auto framebuffer    = m_device->createFramebuffer(framebufferDesc);
+    auto framebufferPtr = m_resourceManager->addFramebuffer(std::move(framebuffer), framebufferKey);
+
+    m_depthPrePassFramebuffers.push_back(framebufferPtr);
   }
+}
 
-  cache.count = static_cast<uint32_t>(matrices.size());
+size_t BasePass::BatchKeyHasher::operator()(const BatchKey& key) const {
+  // field by field - the key has padding bytes after the layer
+  uint64_t hash = XXH64(key.vertexBuffer);
+  hash          = XXH64(key.indexBuffer, hash);
+  return static_cast<size_t>(XXH64(key.layer, hash));
 }
 
-void BasePass::prepareDrawCalls_(const RenderContext& context) {
-  m_drawData.clear();
+void BasePass::buildInstanceBatches_() {
+  m_instanceBatches.clear();
 
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (cache.count == 0) {
-      continue;
-    }
+  LinearAllocatorScope scope;
 
-    for (const auto& renderMesh : model->renderMeshes) {
+  FrameUnorderedMap<BatchKey, size_t, BatchKeyHasher> batchIndices;
+  FrameUnorderedSet<ecs::RenderMesh*>                 mergedMeshes;
+
+  BindlessMaterialTable* materialTable = m_frameResources->getBindlessMaterials();
+
+  for (const auto& instance : m_frameResources->getModels()) {
+    for (const auto& renderMesh : instance->model->renderMeshes) {
       if (!renderMesh->material) {
         LOG_DEBUG("RenderMesh has null material, skipping");
         continue;
       }
 
-      rhi::DescriptorSet* materialDescriptorSet = getOrCreateMaterialDescriptorSet_(renderMesh->material);
+      if (!renderMesh->gpuMesh) {
+        continue;
+      }
 
-      if (!materialDescriptorSet) {
-        LOG_DEBUG("Could not create valid material descriptor set, skipping");
+      const uint32_t materialIndex = materialTable->getOrCreateMaterial(renderMesh->material);
+      if (materialIndex == BindlessMaterialTable::kInvalidIndex) {
         continue;
       }
 
-      std::string pipelineKey = "base_pipeline";
+      BatchKey key;
+      key.vertexBuffer = renderMesh->gpuMesh->vertexBuffer;
+      key.indexBuffer  = renderMesh->gpuMesh->indexBuffer;
+      key.layer        = getRenderLayer_(renderMesh->material);
 
-      rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
+      auto [it, inserted] = batchIndices.try_emplace(key, m_instanceBatches.size());
+      if (inserted) {
+        m_instanceBatches.emplace_back();
+        m_instanceBatches.back().renderMesh = renderMesh;
+        m_instanceBatches.back().layer      = key.layer;
+      }
 
-      if (!pipeline) {
-        rhi::GraphicsPipelineDesc pipelineDesc;
+      auto& batch = m_instanceBatches[it->second];
+      if (mergedMeshes.insert(renderMesh).second) {
+        batch.sourceMeshCount++;
+      }
 
-        pipelineDesc.shaders.push_back(m_vertexShader);
-        pipelineDesc.shaders.push_back(m_pixelShader);
+      // local transform goes into the instance data, so meshes of different models can share a draw
+      const math::Matrix4f<> matrix = renderMesh->transformMatrix * instance->modelMatrix;
+      batch.matrices.push_back(matrix);
+      batch.materialIndices.push_back(materialIndex);
+      batch.modelInstances.push_back(instance);
 
-        if (m_vertexShader && !m_vertexShader->getMeta().vertexInputs.empty()) {
-          rhi::VertexInputBuilder::createFromReflection(m_vertexShader->getMeta().vertexInputs,
-                                                        pipelineDesc.vertexBindings,
-                                                        pipelineDesc.vertexAttributes,
-                                                        m_device->getApiType(),
-                                                        sizeof(ecs::Vertex),
-                                                        sizeof(math::Matrix4f<>));
+      // bounds for culling (GPU culling and software occlusion)
+      const ecs::BoundingBox& localBounds = renderMesh->gpuMesh->boundingBox;
+      batch.worldBounds.push_back(
+          ecs::bounds::isValid(localBounds) ? ecs::bounds::transformAABB(localBounds, matrix) : localBounds);
+    }
+  }
 
-          LOG_INFO("Generated vertex input from shader reflection: {} bindings, {} attributes",
-                   pipelineDesc.vertexBindings.size(),
-                   pipelineDesc.vertexAttributes.size());
-        } else {
-          LOG_ERROR("Shader reflection vertex inputs not available - cannot create pipeline");
-          continue;
-        }
+  // batches occupy consecutive ranges of the frame-global transform buffer, written in one update
+  FrameVector<InstanceTransform> instanceTransforms;
+  for (auto& batch : m_instanceBatches) {
+    batch.instanceOffset = static_cast<uint32_t>(instanceTransforms.size());
+    for (size_t i = 0; i < batch.matrices.size(); ++i) {
+      instanceTransforms.push_back(InstanceTransform::fromMatrix(batch.matrices[i], batch.materialIndices[i]));
+    }
+  }
 
-        pipelineDesc.inputAssembly.topology               = rhi::PrimitiveType::Triangles;
-        pipelineDesc.inputAssembly.primitiveRestartEnable = false;
-
-        pipelineDesc.rasterization.polygonMode     = rhi::PolygonMode::Fill;
-        pipelineDesc.rasterization.cullMode        = rhi::CullMode::Back;
-        pipelineDesc.rasterization.frontFace       = rhi::FrontFace::Ccw;
-        pipelineDesc.rasterization.depthBiasEnable = false;
-        pipelineDesc.rasterization.lineWidth       = 1.0f;
-
-        pipelineDesc.depthStencil.depthTestEnable  = true;
-        pipelineDesc.depthStencil.depthWriteEnable = true;
-        pipelineDesc.depthStencil.depthCompareOp   = rhi::CompareOp::Less;
-
-        pipelineDesc.depthStencil.stencilTestEnable = false;
-
-        rhi::ColorBlendAttachmentDesc blendAttachment;
-        blendAttachment.blendEnable         = true;
-        blendAttachment.srcColorBlendFactor = rhi::BlendFactor::SrcAlpha;
-        blendAttachment.dstColorBlendFactor = rhi::BlendFactor::OneMinusSrcAlpha;
-        blendAttachment.colorBlendOp        = rhi::BlendOp::Add;
-        blendAttachment.srcAlphaBlendFactor = rhi::BlendFactor::One;
-        blendAttachment.dstAlphaBlendFactor = rhi::BlendFactor::OneMinusSrcAlpha;
-        blendAttachment.alphaBlendOp        = rhi::BlendOp::Add;
-        blendAttachment.colorWriteMask      = rhi::ColorMask::All;
-        pipelineDesc.colorBlend.attachments.push_back(blendAttachment);
-
-        pipelineDesc.multisample.rasterizationSamples = rhi::MSAASamples::Count1;
-
-        std::vector<rhi::Shader*> shaders;
-        if (m_vertexShader) {
-          shaders.push_back(m_vertexShader);
-        }
-        if (m_pixelShader) {
-          shaders.push_back(m_pixelShader);
-        }
+  m_frameResources->updateInstanceTransforms(instanceTransforms);
+}
 
-        rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(shaders);
+RenderLayer BasePass::getRenderLayer_(const ecs::Material* material) {
+  switch (material->alphaMode) {
+    case ecs::AlphaMode::Mask:
+      return RenderLayer::Masked;
+    case ecs::AlphaMode::Blend:
+      return RenderLayer::Transparent;
+    default:
+      return RenderLayer::Opaque;
+  }
+}
 
-        auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
-        pipelineDesc.setLayouts = layoutPtrs;
+rhi::GraphicsPipeline* BasePass::getOrCreatePipeline_(RenderLayer layer, bool depthEqual) {
+  StringId           pipelineKey     = "base_pipeline"_sid;
+  rhi::Shader*       pixelShader     = m_pixelShader;
+  const std::string* pixelShaderPath = &m_pixelShaderPath_;
+
+  // alpha test already happened in the pre-pass, EQUAL rejects the discarded texels
+  const bool shadeDepthEqual = depthEqual && layer != RenderLayer::Transparent;
+
+  if (shadeDepthEqual) {
+    pipelineKey = "base_pipeline_depth_equal"_sid;
+  } else if (layer == RenderLayer::Masked) {
+    pipelineKey     = "base_pipeline_masked"_sid;
+    pixelShader     = m_maskedPixelShader;
+    pixelShaderPath = &m_maskedPixelShaderPath_;
+  } else if (layer == RenderLayer::Transparent) {
+    pipelineKey     = "base_pipeline_transparent"_sid;
+    pixelShader     = m_transparentPixelShader;
+    pixelShaderPath = &m_transparentPixelShaderPath_;
+  }
 
-        pipelineDesc.renderPass = m_renderPass;
+  rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
+  if (pipeline) {
+    return pipeline;
+  }
 
-        auto pipelineObj = m_device->createGraphicsPipeline(pipelineDesc);
-        pipeline         = m_resourceManager->addPipeline(std::move(pipelineObj), pipelineKey);
+  if (!pixelShader) {
+    LOG_ERROR("Pixel shader {} is not available", *pixelShaderPath);
+    return nullptr;
+  }
 
-        m_shaderManager->registerPipelineForShader(pipeline, m_vertexShaderPath_);
-        m_shaderManager->registerPipelineForShader(pipeline, m_pixelShaderPath_);
-      }
+  rhi::GraphicsPipelineDesc pipelineDesc;
 
-      DrawData drawData;
-      drawData.pipeline                 = pipeline;
-      drawData.modelMatrixDescriptorSet = m_frameResources->getOrCreateModelMatrixDescriptorSet(renderMesh);
-      drawData.materialDescriptorSet    = materialDescriptorSet;
-      drawData.vertexBuffer             = renderMesh->gpuMesh->vertexBuffer;
-      drawData.indexBuffer              = renderMesh->gpuMesh->indexBuffer;
-      drawData.instanceBuffer           = cache.instanceBuffer;
-      drawData.indexCount               = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
-      drawData.instanceCount            = cache.count;
+  pipelineDesc.shaders.push_back(m_vertexShader);
+  pipelineDesc.shaders.push_back(pixelShader);
 
-      m_drawData.push_back(drawData);
-    }
+  if (m_vertexShader && !m_vertexShader->getMeta().vertexInputs.empty()) {
+    rhi::VertexInputBuilder::createFromReflection(m_vertexShader->getMeta().vertexInputs,
+                                                  pipelineDesc.vertexBindings,
+                                                  pipelineDesc.vertexAttributes,
+                                                  m_device->getApiType(),
+                                                  sizeof(ecs::Vertex));
+
+    LOG_INFO("Generated vertex input from shader reflection: {} bindings, {} attributes",
+             pipelineDesc.vertexBindings.size(),
+             pipelineDesc.vertexAttributes.size());
+  } else {
+    LOG_ERROR("Shader reflection vertex inputs not available - cannot create pipeline");
+    return nullptr;
   }
+
+  pipelineDesc.inputAssembly.topology               = rhi::PrimitiveType::Triangles;
+  pipelineDesc.inputAssembly.primitiveRestartEnable = false;
+
+  pipelineDesc.rasterization.polygonMode     = rhi::PolygonMode::Fill;
+  pipelineDesc.rasterization.cullMode        = rhi::CullMode::Back;
+  pipelineDesc.rasterization.frontFace       = rhi::FrontFace::Ccw;
+  pipelineDesc.rasterization.depthBiasEnable = false;
+  pipelineDesc.rasterization.lineWidth       = 1.0f;
+
+  // transparent surfaces are tested against the scene depth but do not occlude each other
+  pipelineDesc.depthStencil.depthTestEnable  = true;
+  pipelineDesc.depthStencil.depthWriteEnable = layer != RenderLayer::Transparent && !shadeDepthEqual;
+  pipelineDesc.depthStencil.depthCompareOp   = shadeDepthEqual ? rhi::CompareOp::Equal : rhi::CompareOp::Less;
+
+  pipelineDesc.depthStencil.stencilTestEnable = false;
+
+  rhi::ColorBlendAttachmentDesc blendAttachment;
+  blendAttachment.blendEnable         = layer == RenderLayer::Transparent;
+  blendAttachment.srcColorBlendFactor = rhi::BlendFactor::SrcAlpha;
+  blendAttachment.dstColorBlendFactor = rhi::BlendFactor::OneMinusSrcAlpha;
+  blendAttachment.colorBlendOp        = rhi::BlendOp::Add;
+  blendAttachment.srcAlphaBlendFactor = rhi::BlendFactor::One;
+  blendAttachment.dstAlphaBlendFactor = rhi::BlendFactor::OneMinusSrcAlpha;
+  blendAttachment.alphaBlendOp        = rhi::BlendOp::Add;
+  blendAttachment.colorWriteMask      = rhi::ColorMask::All;
+  pipelineDesc.colorBlend.attachments.push_back(blendAttachment);
+
+  pipelineDesc.multisample.rasterizationSamples = rhi::MSAASamples::Count1;
+
+  std::vector<rhi::Shader*> shaders;
+  if (m_vertexShader) {
+    shaders.push_back(m_vertexShader);
+  }
+  shaders.push_back(pixelShader);
+
+  rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+      shaders, {FrameResources::kViewUniformBufferBinding});
+
+  auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
+  pipelineDesc.setLayouts = layoutPtrs;
+
+  pipelineDesc.renderPass = m_renderPass;
+
+  auto pipelineObj = m_device->createGraphicsPipeline(pipelineDesc);
+  pipeline         = m_resourceManager->addPipeline(std::move(pipelineObj), pipelineKey);
+
+  m_shaderManager->registerPipelineForShader(pipeline, m_vertexShaderPath_);
+  m_shaderManager->registerPipelineForShader(pipeline, *pixelShaderPath);
+
+  return pipeline;
 }
 
-void BasePass::cleanupUnusedBuffers_(
-    const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances) {
-  std::vector<ecs::RenderModel*> modelsToRemove;
-  for (const auto& [model, cache] : m_instanceBufferCache) {
-    if (!currentFrameInstances.contains(model)) {
-      modelsToRemove.push_back(model);
-    }
+rhi::GraphicsPipeline* BasePass::getOrCreateDepthPrePassPipeline_(RenderLayer layer) {
+  const bool masked = layer == RenderLayer::Masked;
+
+  const StringId pipelineKey  = masked ? "depth_prepass_masked_pipeline"_sid : "depth_prepass_pipeline"_sid;
+  rhi::Shader*   vertexShader = masked ? m_depthPrePassMaskedVertexShader : m_depthPrePassVertexShader;
+  rhi::Shader*   pixelShader  = masked ? m_depthPrePassMaskedPixelShader : nullptr;
+
+  rhi::GraphicsPipeline* pipeline = m_resourceManager->getPipeline(pipelineKey);
+  if (pipeline) {
+    return pipeline;
   }
 
-  for (auto model : modelsToRemove) {
-    m_instanceBufferCache.erase(model);
+  if (!vertexShader || (masked && !pixelShader)) {
+    LOG_ERROR("Shaders for the {} depth pre-pass pipeline are not available", masked ? "masked" : "opaque");
+    return nullptr;
   }
 
-  std::unordered_set<ecs::Material*> activeMaterials;
+  rhi::GraphicsPipelineDesc pipelineDesc;
 
-  for (const auto& [model, matrices] : currentFrameInstances) {
-    for (const auto& renderMesh : model->renderMeshes) {
-      if (renderMesh->material) {
-        activeMaterials.insert(renderMesh->material);
-      }
-    }
+  pipelineDesc.shaders.push_back(vertexShader);
+  if (pixelShader) {
+    pipelineDesc.shaders.push_back(pixelShader);
+  }
+
+  // position (and texcoord for alpha test) only - the rest of the interleaved vertex is skipped by the stride
+  if (!vertexShader->getMeta().vertexInputs.empty()) {
+    rhi::VertexInputBuilder::createFromReflection(vertexShader->getMeta().vertexInputs,
+                                                  pipelineDesc.vertexBindings,
+                                                  pipelineDesc.vertexAttributes,
+                                                  m_device->getApiType(),
+                                                  sizeof(ecs::Vertex));
+  } else {
+    LOG_ERROR("Shader reflection vertex inputs not available - cannot create pipeline");
+    return nullptr;
+  }
+
+  pipelineDesc.inputAssembly.topology               = rhi::PrimitiveType::Triangles;
+  pipelineDesc.inputAssembly.primitiveRestartEnable = false;
+
+  pipelineDesc.rasterization.polygonMode     = rhi::PolygonMode::Fill;
+  pipelineDesc.rasterization.cullMode        = rhi::CullMode::Back;
+  pipelineDesc.rasterization.frontFace       = rhi::FrontFace::Ccw;
+  pipelineDesc.rasterization.depthBiasEnable = false;
+  pipelineDesc.rasterization.lineWidth       = 1.0f;
+
+  pipelineDesc.depthStencil.depthTestEnable  = true;
+  pipelineDesc.depthStencil.depthWriteEnable = true;
+  pipelineDesc.depthStencil.depthCompareOp   = rhi::CompareOp::Less;
+
+  pipelineDesc.depthStencil.stencilTestEnable = false;
+
+  pipelineDesc.multisample.rasterizationSamples = rhi::MSAASamples::Count1;
+
+  rhi::PipelineLayoutDesc reflectionLayout = rhi::pipeline_utils::generatePipelineLayoutFromShaders(
+      pipelineDesc.shaders, {FrameResources::kViewUniformBufferBinding});
+
+  auto layoutPtrs         = m_layoutManager.createAndManageLayouts(m_device, reflectionLayout);
+  pipelineDesc.setLayouts = layoutPtrs;
+
+  pipelineDesc.renderPass = m_depthPrePassRenderPass;
+
+  auto pipelineObj = m_device->createGraphicsPipeline(pipelineDesc);
+  pipeline         = m_resourceManager->addPipeline(std::move(pipelineObj), pipelineKey);
+
+  if (masked) {
+    m_shaderManager->registerPipelineForShader(pipeline, m_depthPrePassMaskedVertexShaderPath_);
+    m_shaderManager->registerPipelineForShader(pipeline, m_depthPrePassMaskedPixelShaderPath_);
+  } else {
+    m_shaderManager->registerPipelineForShader(pipeline, m_depthPrePassVertexShaderPath_);
   }
 
-  std::vector<ecs::Material*> materialsToRemove;
-  for (const auto& [material, cache] : m_materialCache) {
-    if (!activeMaterials.contains(material)) {
-      materialsToRemove.push_back(material);
+  return pipeline;
+}
+
+bool BasePass::updateMergedGeometry_() {
+  if (m_mergedGeometryDirty) {
+    CPU_ZONE_NC("Merge Geometry", color::YELLOW);
+
+    std::vector<MergedGeometry::Geometry> geometries;
+    geometries.reserve(m_instanceBatches.size());
+    for (const auto& batch : m_instanceBatches) {
+      geometries.push_back({batch.renderMesh->gpuMesh->vertexBuffer, batch.renderMesh->gpuMesh->indexBuffer});
     }
+
+    m_mergedGeometry->update(geometries);
+    m_mergedGeometryDirty = false;
   }
 
-  for (auto material : materialsToRemove) {
-    LOG_DEBUG("Removing cached material parameters for deleted material at address: {}",
-              reinterpret_cast<uintptr_t>(material));
-    m_materialCache.erase(material);
+  return m_mergedGeometry->isValid();
+}
+
+void BasePass::prepareDrawCalls_(const RenderContext& context, bool mergedGeometry) {
+  m_drawData.clear();
+
+  const bool depthPrePass = context.renderSettings.depthPrePass && m_depthPrePassRenderPass && m_depthLoadRenderPass;
+
+  for (uint32_t batchIndex = 0; batchIndex < m_instanceBatches.size(); ++batchIndex) {
+    const auto& batch = m_instanceBatches[batchIndex];
+    if (batch.matrices.empty()) {
+      continue;
+    }
+
+    ecs::RenderMesh*  renderMesh = batch.renderMesh;
+    const RenderLayer layer      = batch.layer;
+
+    // transparent surfaces neither write nor rely on pre-pass depth
+    rhi::GraphicsPipeline* depthPrePassPipeline = nullptr;
+    if (depthPrePass && layer != RenderLayer::Transparent) {
+      depthPrePassPipeline = getOrCreateDepthPrePassPipeline_(layer);
+    }
+
+    // without a pre-pass pipeline the draw falls back to the regular depth test
+    rhi::GraphicsPipeline* pipeline = getOrCreatePipeline_(layer, depthPrePassPipeline != nullptr);
+    if (!pipeline) {
+      continue;
+    }
+
+    DrawData drawData;
+    drawData.pipeline             = pipeline;
+    drawData.vertexBuffer         = renderMesh->gpuMesh->vertexBuffer;
+    drawData.indexBuffer          = renderMesh->gpuMesh->indexBuffer;
+    drawData.indexCount           = renderMesh->gpuMesh->indexBuffer->getDesc().size / sizeof(uint32_t);
+    drawData.batchIndex           = batchIndex;
+    drawData.sourceMeshCount      = batch.sourceMeshCount;
+    drawData.layer                = layer;
+    drawData.depthPrePassPipeline = depthPrePassPipeline;
+
+    // all draws bind the same buffers and differ only in their index / vertex range
+    const MergedGeometry::Range* range
+        = mergedGeometry ? m_mergedGeometry->findRange({drawData.vertexBuffer, drawData.indexBuffer}) : nullptr;
+    if (range) {
+      drawData.vertexBuffer = m_mergedGeometry->getVertexBuffer();
+      drawData.indexBuffer  = m_mergedGeometry->getIndexBuffer();
+      drawData.firstIndex   = range->firstIndex;
+      drawData.vertexOffset = range->vertexOffset;
+    }
+
+    // occluded instances split the batch into one draw per run of consecutive visible instances
+    const uint32_t instanceCount = static_cast<uint32_t>(batch.matrices.size());
+    for (uint32_t firstInstance = 0; firstInstance < instanceCount;) {
+      if (!isInstanceVisible_(batch.instanceOffset + firstInstance)) {
+        ++firstInstance;
+        continue;
+      }
+
+      uint32_t lastInstance = firstInstance + 1;
+      while (lastInstance < instanceCount && isInstanceVisible_(batch.instanceOffset + lastInstance)) {
+        ++lastInstance;
+      }
+
+      // nearest and farthest instance of the draw along the camera view direction
+      const math::Matrix4f<>& viewMatrix   = m_frameResources->getViewMatrix();
+      float                   minViewDepth = std::numeric_limits<float>::max();
+      float                   maxViewDepth = std::numeric_limits<float>::lowest();
+      for (uint32_t instance = firstInstance; instance < lastInstance; ++instance) {
+        math::Vector4f viewPosition = batch.matrices[instance].getRow<3>();
+        viewPosition               *= viewMatrix;
+        minViewDepth                = std::min(minViewDepth, viewPosition.z());
+        maxViewDepth                = std::max(maxViewDepth, viewPosition.z());
+      }
+
+      drawData.instanceCount  = lastInstance - firstInstance;
+      drawData.instanceOffset = batch.instanceOffset + firstInstance;
+      drawData.minViewDepth   = minViewDepth;
+      drawData.maxViewDepth   = maxViewDepth;
+
+      m_drawData.push_back(drawData);
+      firstInstance = lastInstance;
+    }
   }
 }
 
-rhi::DescriptorSet* BasePass::getOrCreateMaterialDescriptorSet_(ecs::Material* material) {
-  if (!material) {
-    LOG_ERROR("Material is null");
-    return nullptr;
+void BasePass::buildDrawPackets_() {
+  CPU_ZONE_NC("Sort Draw Packets", color::YELLOW);
+
+  m_drawPackets.clear();
+  m_drawPackets.reserve(m_drawData.size());
+
+  const float nearClip = m_frameResources->getNearClip();
+  const float farClip  = m_frameResources->getFarClip();
+
+  for (uint32_t drawIndex = 0; drawIndex < m_drawData.size(); ++drawIndex) {
+    const auto& drawData = m_drawData[drawIndex];
+
+    // opaque goes front-to-back by the nearest instance, blended back-to-front by the farthest one
+    const float viewDepth = drawData.layer == RenderLayer::Transparent ? drawData.maxViewDepth : drawData.minViewDepth;
+
+    const uint64_t sortKey = DrawPacket::makeKey(drawData.layer,
+                                                 getSortId_(m_pipelineSortIds, drawData.pipeline),
+                                                 getSortId_(m_geometrySortIds, drawData.vertexBuffer),
+                                                 DrawPacket::quantizeDepth(viewDepth, nearClip, farClip));
+
+    m_drawPackets.add(sortKey, drawIndex);
   }
 
-  auto it = m_materialCache.find(material);
-  if (it != m_materialCache.end() && it->second.descriptorSet) {
-    return it->second.descriptorSet;
+  m_drawPackets.sort();
+}
+
+void BasePass::writeIndirectArguments_() {
+  const auto& packets = m_drawPackets.getPackets();
+  if (packets.empty()) {
+    return;
   }
 
-  auto materialLayout = m_resourceManager->getDescriptorSetLayout("material_layout");
-  if (!materialLayout) {
-    LOG_ERROR("Material descriptor set layout not found");
-    return nullptr;
+  // if the ring is full the frame falls back to direct draws
+  m_indirectArguments
+      = m_frameResources->getUploadRing()->allocate(packets.size() * sizeof(rhi::DrawIndexedIndirectCommand));
+  if (!m_indirectArguments.isValid()) {
+    return;
   }
 
-  std::string materialKey = "material_" + std::to_string(reinterpret_cast<uintptr_t>(material));
+  auto* commands = static_cast<rhi::DrawIndexedIndirectCommand*>(m_indirectArguments.cpuAddress);
+  for (size_t packetIndex = 0; packetIndex < packets.size(); ++packetIndex) {
+    const auto& drawData = m_drawData[packets[packetIndex].drawIndex];
+
+    // the instance offset reaches the shader through drawConstant (DirectX) or firstInstance (Vulkan)
+    rhi::DrawIndexedIndirectCommand command;
+    command.drawConstant  = drawData.instanceOffset;
+    command.indexCount    = drawData.indexCount;
+    command.instanceCount = drawData.instanceCount;
+    command.firstIndex    = drawData.firstIndex;
+    command.vertexOffset  = drawData.vertexOffset;
+    command.firstInstance = drawData.instanceOffset;
+
+    commands[packetIndex] = command;
+  }
+}
 
-  auto descriptorSetPtr = m_resourceManager->getDescriptorSet(materialKey);
-  if (!descriptorSetPtr) {
-    auto descriptorSet = m_device->createDescriptorSet(materialLayout);
+void BasePass::updateCullInstances_() {
+  CPU_ZONE_NC("Update Cull Instances", color::YELLOW);
+
+  std::vector<GpuCulling::InstanceBounds> instances;
+  for (uint32_t batchIndex = 0; batchIndex < m_instanceBatches.size(); ++batchIndex) {
+    for (const auto& worldBounds : m_instanceBatches[batchIndex].worldBounds) {
+      GpuCulling::InstanceBounds instance;
+      instance.center     = math::Vector3f(0.0f);
+      instance.extents    = math::Vector3f(0.0f);
+      instance.batchIndex = batchIndex;
+
+      if (ecs::bounds::isValid(worldBounds)) {
+        instance.center  = ecs::bounds::getCenter(worldBounds);
+        instance.extents = ecs::bounds::getSize(worldBounds) * 0.5f;
+      } else {
+        instance.flags = GpuCulling::kAlwaysVisible;
+      }
 
-    // Update the descriptor set BEFORE adding it to the resource manager
-    rhi::Buffer* paramBuffer = m_frameResources->getOrCreateMaterialParamBuffer(material);
-    if (paramBuffer) {
-      descriptorSet->setUniformBuffer(0, paramBuffer);
+      instances.push_back(instance);
     }
+  }
 
-    std::vector<std::string> textureNames = {"albedo", "normal_map", "metallic_roughness"};
-    uint32_t                 binding      = 1;
+  m_gpuCulling->updateInstances(instances);
+}
 
-    bool allTexturesValid = true;
+void BasePass::cullOccludedInstances_() {
+  CPU_ZONE_NC("Software Occlusion Culling", color::YELLOW);
 
-    for (const auto& textureName : textureNames) {
-      rhi::Texture* texture = nullptr;
+  m_softwareOcclusion.beginFrame(m_frameResources->getViewProjectionMatrix());
 
-      auto textureIt = material->textures.find(textureName);
-      if (textureIt != material->textures.end() && textureIt->second) {
-        texture = textureIt->second;
-      }
+  // flagged models first, then opaque meshes by the part of the screen they cover
+  struct OccluderCandidate {
+    const ecs::Mesh*        mesh     = nullptr;
+    const math::Matrix4f<>* matrix   = nullptr;
+    float                   priority = 0.0f;
+  };
 
-      if (!texture) {
-        if (textureName == "albedo") {
-          texture = m_frameResources->getDefaultWhiteTexture();
-        } else if (textureName == "normal_map") {
-          texture = m_frameResources->getDefaultNormalTexture();
-        } else if (textureName == "metallic_roughness") {
-          texture = m_frameResources->getDefaultBlackTexture();
-        }
+  std::vector<OccluderCandidate> candidates;
+  uint32_t                       instanceCount = 0;
+  for (const auto& batch : m_instanceBatches) {
+    instanceCount += static_cast<uint32_t>(batch.matrices.size());
+
+    // alpha-tested and blended surfaces don't hide what is behind them
+    const ecs::Mesh* mesh = batch.renderMesh->sourceMesh;
+    if (!mesh || batch.layer != RenderLayer::Opaque) {
+      continue;
+    }
 
-        LOG_DEBUG("Using fallback texture for '{}' in material: {}", textureName, material->materialName);
+    for (size_t instance = 0; instance < batch.matrices.size(); ++instance) {
+      if (!ecs::bounds::isValid(batch.worldBounds[instance])) {
+        continue;
       }
 
-      if (!texture) {
-        LOG_ERROR(
-            "No texture available (including fallback) for '{}' in material: {}", textureName, material->materialName);
-        allTexturesValid = false;
-        break;
+      const float coverage = m_softwareOcclusion.getScreenCoverage(batch.worldBounds[instance]);
+      if (coverage <= 0.0f) {
+        continue;
       }
 
-      descriptorSet->setTexture(binding, texture);
-      binding++;
+      if (batch.modelInstances[instance]->occluder) {
+        candidates.push_back({mesh, &batch.matrices[instance], 1.0f + coverage});
+      } else if (coverage >= SoftwareOcclusion::kMinOccluderCoverage) {
+        candidates.push_back({mesh, &batch.matrices[instance], coverage});
+      }
     }
+  }
 
-    if (allTexturesValid) {
-      descriptorSetPtr = m_resourceManager->addDescriptorSet(std::move(descriptorSet), materialKey);
-    } else {
-      LOG_WARN("Material descriptor set creation failed due to invalid textures: {}", material->materialName);
-      return nullptr;
+  std::sort(candidates.begin(), candidates.end(), [](const OccluderCandidate& a, const OccluderCandidate& b) {
+    return a.priority > b.priority;
+  });
+
+  // occluders that don't fit into the triangle budget are skipped, smaller ones may still fit
+  for (const auto& candidate : candidates) {
+    m_softwareOcclusion.addOccluder(candidate.mesh, *candidate.matrix);
+  }
+
+  m_softwareOcclusion.rasterize();
+
+  {
+    CPU_ZONE_NC("Test Occludees", color::YELLOW);
+
+    m_instanceVisibility.assign(instanceCount, 1);
+    m_occludedInstanceCount = 0;
+    for (const auto& batch : m_instanceBatches) {
+      for (uint32_t instance = 0; instance < batch.worldBounds.size(); ++instance) {
+        const ecs::BoundingBox& worldBounds = batch.worldBounds[instance];
+        if (ecs::bounds::isValid(worldBounds) && !m_softwareOcclusion.isVisible(worldBounds)) {
+          m_instanceVisibility[batch.instanceOffset + instance] = 0;
+          ++m_occludedInstanceCount;
+        }
+      }
     }
   }
 
-  m_materialCache[material].descriptorSet = descriptorSetPtr;
-  return descriptorSetPtr;
+  m_occlusionCulled = true;
 }
+
+bool BasePass::prepareGpuCulling_(const RenderContext& context) {
+  if (!m_gpuCulling || !m_indirectArguments.isValid()) {
+    return false;
+  }
+
+  if (m_cullBoundsDirty) {
+    updateCullInstances_();
+    m_cullBoundsDirty = false;
+  }
+
+  // draw of each batch - instances of batches without a draw are skipped by the shader
+  const auto&           packets = m_drawPackets.getPackets();
+  std::vector<uint32_t> batchPackets(m_instanceBatches.size(), GpuCulling::kInvalidPacket);
+  for (uint32_t packetIndex = 0; packetIndex < packets.size(); ++packetIndex) {
+    batchPackets[m_drawData[packets[packetIndex].drawIndex].batchIndex] = packetIndex;
+  }
+
+  return m_gpuCulling->prepare(context, m_indirectArguments, static_cast<uint32_t>(packets.size()), batchPackets);
+}
+
+rhi::Buffer* BasePass::getIndirectArguments_(uint64_t& offset) const {
+  if (m_gpuCulled) {
+    offset = 0;
+    return m_gpuCulling->getDrawArguments();
+  }
+
+  offset = m_indirectArguments.offset;
+  return m_indirectArguments.buffer;
+}
+
+rhi::DescriptorSet* BasePass::getInstanceDescriptorSet_() const {
+  return m_gpuCulled ? m_gpuCulling->getInstanceDescriptorSet() : m_frameResources->getInstanceTransformDescriptorSet();
+}
+
+uint32_t BasePass::getIndirectDrawRun_(size_t firstPacket, rhi::GraphicsPipeline* DrawData::*pipeline) const {
+  const auto& packets = m_drawPackets.getPackets();
+  const auto& first   = m_drawData[packets[firstPacket].drawIndex];
+
+  size_t lastPacket = firstPacket + 1;
+  while (lastPacket < packets.size()) {
+    const auto& drawData = m_drawData[packets[lastPacket].drawIndex];
+    if (drawData.*pipeline != first.*pipeline || drawData.vertexBuffer != first.vertexBuffer
+        || drawData.indexBuffer != first.indexBuffer) {
+      break;
+    }
+    ++lastPacket;
+  }
+
+  return static_cast<uint32_t>(lastPacket - firstPacket);
+}
+
+uint32_t BasePass::getSortId_(SortIdMap& sortIds, const void* object) {
+  // compact ids keep the key fields dense; ids past the field width wrap, which only affects grouping
+  return sortIds.try_emplace(object, static_cast<uint32_t>(sortIds.size())).first->second;
+}
+
 }  // namespace renderer
 }  // namespace gfx
 }  // namespace arise
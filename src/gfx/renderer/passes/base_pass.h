@@ -1,16 +1,24 @@
 #ifndef ARISE_BASE_PASS_H
 #define ARISE_BASE_PASS_H
 
+#include "gfx/renderer/draw_packet.h"
+#include "gfx/renderer/frame_resources.h"
+#include "gfx/renderer/gpu_culling.h"
+#include "gfx/renderer/merged_geometry.h"
 #include "gfx/renderer/render_pass.h"
+#include "gfx/renderer/software_occlusion.h"
 #include "gfx/rhi/interface/render_pass.h"
 #include "gfx/rhi/shader_reflection/pipeline_layout_manager.h"
+#include "utils/memory/pool_allocator.h"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace arise {
 namespace ecs {
 struct RenderModel;
+struct RenderMesh;
 struct Material;
 }  // namespace ecs
 }  // namespace arise
@@ -45,46 +53,150 @@ class BasePass : public RenderPass {
 
   void render(RenderContext& context) override;
 
-  void endFrame() override { m_drawData.clear(); }
+  // occlusion culling of the next frame tests against the depth of this one (set by prepareFrame())
+  bool isDepthPyramidNeeded(const RenderContext& context) const {
+    return m_gpuCulled && context.renderSettings.gpuOcclusionCulling;
+  }
+
+  // records the depth pyramid build, the depth buffer is in ShaderReadOnly layout
+  void renderDepthPyramid(RenderContext& context, rhi::Texture* depthBuffer);
+
+  void endFrame() override {
+    m_drawData.clear();
+    m_drawPackets.clear();
+    m_indirectArguments = {};
+    m_gpuCulled         = false;
+    m_occlusionCulled   = false;
+  }
 
   void clearSceneResources();
   void cleanup() override;
 
   private:
-  struct ModelBufferCache {
-    rhi::Buffer* instanceBuffer = nullptr;
-    uint32_t     capacity       = 0;
-    uint32_t     count          = 0;
+  /**
+   * Meshes are merged into one instanced draw when they share geometry buffers and render layer, regardless of
+   * which RenderModel they belong to and of their material (materials are bindless, each instance carries its
+   * material index)
+   */
+  struct BatchKey {
+    rhi::Buffer* vertexBuffer = nullptr;
+    rhi::Buffer* indexBuffer  = nullptr;
+    RenderLayer  layer        = RenderLayer::Opaque;
+
+    bool operator==(const BatchKey& other) const = default;
+  };
+
+  struct BatchKeyHasher {
+    size_t operator()(const BatchKey& key) const;
+  };
+
+  struct InstanceBatch {
+    using ModelInstances = std::vector<const FrameResources::ModelInstance*>;
+
+    ecs::RenderMesh*              renderMesh = nullptr;  // first merged mesh, provides geometry
+    std::vector<math::Matrix4f<>> matrices;              // mesh local transform baked into the instance matrix
+    std::vector<uint32_t>         materialIndices;       // bindless material of each instance
+    std::vector<ecs::BoundingBox> worldBounds;           // of each instance, invalid if the mesh has no bounds
+    ModelInstances                modelInstances;        // model of each instance
+    RenderLayer                   layer           = RenderLayer::Opaque;
+    uint32_t                      sourceMeshCount = 0;
+    uint32_t                      instanceOffset  = 0;   // offset into the frame-global instance transform buffer
+  };
+
+  // push constants of the base pass and depth pre-pass vertex shaders (DrawConstants in HLSL),
+  // indirect draws push 0 and pass the offset with the draw arguments (see rhi::DrawIndexedIndirectCommand)
+  struct DrawConstants {
+    uint32_t instanceOffset = 0;
   };
 
   struct DrawData {
-    rhi::GraphicsPipeline* pipeline                 = nullptr;
-    rhi::DescriptorSet*    modelMatrixDescriptorSet = nullptr;
-    rhi::DescriptorSet*    materialDescriptorSet    = nullptr;
-    rhi::Buffer*           vertexBuffer             = nullptr;
-    rhi::Buffer*           indexBuffer              = nullptr;
-    rhi::Buffer*           instanceBuffer           = nullptr;
-    uint32_t               indexCount               = 0;
-    uint32_t               instanceCount            = 0;
+    rhi::GraphicsPipeline* pipeline             = nullptr;
+    rhi::GraphicsPipeline* depthPrePassPipeline = nullptr;  // null when the draw is skipped in the pre-pass
+    rhi::Buffer*           vertexBuffer         = nullptr;
+    rhi::Buffer*           indexBuffer          = nullptr;
+    uint32_t               indexCount           = 0;
+    uint32_t               firstIndex           = 0;  // non-zero with merged geometry
+    int32_t                vertexOffset         = 0;
+    uint32_t               instanceCount        = 0;
+    uint32_t               instanceOffset       = 0;  // base index into the instance transform buffer
+    uint32_t               batchIndex           = 0;  // index into m_instanceBatches
+    uint32_t               sourceMeshCount      = 1;
+    RenderLayer            layer                = RenderLayer::Opaque;
+    float                  minViewDepth         = 0.0f;
+    float                  maxViewDepth         = 0.0f;
   };
 
+  // compact sort ids of pipelines and geometry buffers, the nodes come from m_sortIdNodePool
+  using SortIdMap = std::unordered_map<const void*,
+                                       uint32_t,
+                                       std::hash<const void*>,
+                                       std::equal_to<const void*>,
+                                       PoolStdAllocator<std::pair<const void* const, uint32_t>>>;
+
+  // node of a SortIdMap entry in the common implementations (link, key, value and cached hash), larger nodes fall
+  // back to the heap
+  static constexpr size_t kSortIdNodeSize = 4 * sizeof(void*);
+
   void setupRenderPass_();
 
+  void setupDepthPrePass_();
+
   void createFramebuffer_(const math::Dimension2i& dimension);
 
-  void updateInstanceBuffer_(ecs::RenderModel*                    model,
-                             const std::vector<math::Matrix4f<>>& matrices,
-                             ModelBufferCache&                    cache);
+  void buildInstanceBatches_();
+
+  static RenderLayer getRenderLayer_(const ecs::Material* material);
+
+  // one pipeline per render layer: opaque (no blending), masked (alpha test), transparent (blending)
+  // with depthEqual opaque and masked geometry share a pipeline that only shades the pre-pass depth
+  rhi::GraphicsPipeline* getOrCreatePipeline_(RenderLayer layer, bool depthEqual);
+
+  rhi::GraphicsPipeline* getOrCreateDepthPrePassPipeline_(RenderLayer layer);
 
-  void prepareDrawCalls_(const RenderContext& context);
+  void renderDepthPrePass_(RenderContext& context);
 
-  void cleanupUnusedBuffers_(
-      const std::unordered_map<ecs::RenderModel*, std::vector<math::Matrix4f<>>>& currentFrameInstances);
+  // @return true if all batches can be drawn from the merged geometry buffers
+  bool updateMergedGeometry_();
 
-  const std::string m_vertexShaderPath_ = "assets/shaders/base_pass/shader_instancing.vs.hlsl";
-  const std::string m_pixelShaderPath_  = "assets/shaders/base_pass/shader.ps.hlsl";
+  void prepareDrawCalls_(const RenderContext& context, bool mergedGeometry);
 
-  rhi::DescriptorSet* getOrCreateMaterialDescriptorSet_(ecs::Material* material);
+  void buildDrawPackets_();
+
+  // draw arguments of all packets in packet order, a run of packets is then submitted with one indirect call
+  void writeIndirectArguments_();
+
+  // world bounds of all instances in instance transform buffer order
+  void updateCullInstances_();
+
+  // rasterizes the occluders of this frame and marks the instances hidden behind them in m_instanceVisibility
+  void cullOccludedInstances_();
+
+  bool isInstanceVisible_(uint32_t instanceIndex) const {
+    return !m_occlusionCulled || m_instanceVisibility[instanceIndex] != 0;
+  }
+
+  // @return true if the instance counts of this frame's indirect draws come from the GPU culling pass
+  bool prepareGpuCulling_(const RenderContext& context);
+
+  // argument buffer and byte offset of the first packet - GPU culling output or the CPU-written arguments
+  rhi::Buffer* getIndirectArguments_(uint64_t& offset) const;
+
+  // instance transforms with identity indices, or the visible instances of GPU culling
+  rhi::DescriptorSet* getInstanceDescriptorSet_() const;
+
+  // number of packets from firstPacket on that share the pipeline (given member) and geometry buffers
+  uint32_t getIndirectDrawRun_(size_t firstPacket, rhi::GraphicsPipeline* DrawData::*pipeline) const;
+
+  static uint32_t getSortId_(SortIdMap& sortIds, const void* object);
+
+  const std::string m_vertexShaderPath_           = "assets/shaders/base_pass/shader_instancing.vs.hlsl";
+  const std::string m_pixelShaderPath_            = "assets/shaders/base_pass/shader.ps.hlsl";
+  const std::string m_maskedPixelShaderPath_      = "assets/shaders/base_pass/shader_masked.ps.hlsl";
+  const std::string m_transparentPixelShaderPath_ = "assets/shaders/base_pass/shader_transparent.ps.hlsl";
+
+  const std::string m_depthPrePassVertexShaderPath_       = "assets/shaders/depth_prepass/shader_instancing.vs.hlsl";
+  const std::string m_depthPrePassMaskedVertexShaderPath_ = "assets/shaders/depth_prepass/shader_masked.vs.hlsl";
+  const std::string m_depthPrePassMaskedPixelShaderPath_  = "assets/shaders/depth_prepass/shader_masked.ps.hlsl";
 
   rhi::Device*           m_device          = nullptr;
   RenderResourceManager* m_resourceManager = nullptr;
@@ -92,20 +204,53 @@ class BasePass : public RenderPass {
 
   rhi::RenderPass*               m_renderPass = nullptr;
   std::vector<rhi::Framebuffer*> m_framebuffers;
-  rhi::Shader*                   m_vertexShader = nullptr;
-  rhi::Shader*                   m_pixelShader  = nullptr;
+  uint32_t                       m_renderTargetGeneration = 0;  // render targets of m_framebuffers
+  rhi::Shader*                   m_vertexShader           = nullptr;
+  rhi::Shader*                   m_pixelShader            = nullptr;
+  rhi::Shader*                   m_maskedPixelShader      = nullptr;
+  rhi::Shader*                   m_transparentPixelShader = nullptr;
+
+  // depth pre-pass (enabled by RenderSettings::depthPrePass)
+  rhi::RenderPass*               m_depthPrePassRenderPass = nullptr;
+  rhi::RenderPass*               m_depthLoadRenderPass    = nullptr;  // base pass on top of pre-pass depth
+  std::vector<rhi::Framebuffer*> m_depthPrePassFramebuffers;
+  rhi::Shader*                   m_depthPrePassVertexShader       = nullptr;
+  rhi::Shader*                   m_depthPrePassMaskedVertexShader = nullptr;
+  rhi::Shader*                   m_depthPrePassMaskedPixelShader  = nullptr;
 
   rhi::Viewport    m_viewport;
   rhi::ScissorRect m_scissor;
 
-  std::unordered_map<ecs::RenderModel*, ModelBufferCache> m_instanceBufferCache;
-  std::vector<DrawData>                                   m_drawData;
-
-  struct MaterialCache {
-    rhi::DescriptorSet* descriptorSet = nullptr;
-  };
-
-  std::unordered_map<ecs::Material*, MaterialCache> m_materialCache;
+  // instance transforms of all batches, rebuilt only when instances are added, removed or moved
+  std::vector<InstanceBatch>                        m_instanceBatches;
+  std::vector<const FrameResources::ModelInstance*> m_batchedInstances;
+  std::vector<DrawData>                             m_drawData;
+
+  // draw order - m_drawData is submitted through the sorted packet list
+  // (no material ids - materials are bindless and switching them is free)
+  DrawPacketList m_drawPackets;
+
+  // sort id nodes come from a pool (declared first, it outlives the maps)
+  PoolAllocator m_sortIdNodePool{kSortIdNodeSize};
+  SortIdMap     m_pipelineSortIds{SortIdMap::allocator_type(m_sortIdNodePool)};
+  SortIdMap     m_geometrySortIds{SortIdMap::allocator_type(m_sortIdNodePool)};
+
+  // indirect draw mode (enabled by RenderSettings::indirectDraw) - draws share the merged geometry buffers and their
+  // arguments are written to the upload ring, so the CPU cost per pipeline bucket doesn't depend on the draw count
+  std::unique_ptr<MergedGeometry> m_mergedGeometry;
+  bool                            m_mergedGeometryDirty = true;  // instance batches changed since the last update
+  UploadRing::Allocation          m_indirectArguments;           // invalid when the frame uses direct draws
+
+  // GPU culling of indirect draws (enabled by RenderSettings::gpuCulling), null if its shaders are unavailable
+  std::unique_ptr<GpuCulling> m_gpuCulling;
+  bool                        m_cullBoundsDirty = true;   // instance batches changed since the bounds upload
+  bool                        m_gpuCulled       = false;  // draws of this frame read the GPU culling output
+
+  // CPU occlusion culling (enabled by RenderSettings::softwareOcclusion), not combined with GPU culling
+  SoftwareOcclusion    m_softwareOcclusion;
+  std::vector<uint8_t> m_instanceVisibility;  // per instance in transform buffer order, valid if m_occlusionCulled
+  uint32_t             m_occludedInstanceCount = 0;
+  bool                 m_occlusionCulled       = false;
 
   rhi::ShaderManager* m_shaderManager = nullptr;
 
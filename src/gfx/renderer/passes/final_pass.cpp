@@ -30,6 +30,7 @@ void FinalPass::render(RenderContext& context) {
   if (renderTargets.colorBuffer && renderTargets.backBuffer) {
     CPU_ZONE_NC("Copy Texture", color::YELLOW);
     GPU_ZONE_NC(commandBuffer, "Texture Copy", color::YELLOW);
+    // the render graph puts the textures in TransferSrc / TransferDst, the copy records no transitions of its own
     commandBuffer->copyTexture(renderTargets.colorBuffer.get(), renderTargets.backBuffer);
   }
 }
@@ -12,6 +12,8 @@ namespace arise {
 namespace gfx {
 namespace renderer {
 
+class SoftwareOcclusion;
+
 /**
  * Statistics collected during frame rendering
  */
@@ -21,7 +23,10 @@ struct RenderStatistics {
   uint32_t instancesRendered = 0;
   uint32_t verticesProcessed = 0;
   uint32_t setPassCalls      = 0;  // Pipeline switches
-  uint32_t batches           = 0;  // Number of draw call batches
+  uint32_t batches           = 0;  // Number of instanced batches (geometry + material) after merging
+  uint32_t mergedMeshes      = 0;  // Meshes folded into a batch of another mesh (draw calls saved)
+  uint32_t occludedInstances = 0;  // Instances rejected by software occlusion culling
+  uint32_t occluderMeshes    = 0;  // Meshes rasterized into the software occlusion buffer
 
   void reset() {
     drawCalls         = 0;
@@ -30,6 +35,9 @@ struct RenderStatistics {
     verticesProcessed = 0;
     setPassCalls      = 0;
     batches           = 0;
+    mergedMeshes      = 0;
+    occludedInstances = 0;
+    occluderMeshes    = 0;
   }
 };
 
@@ -42,7 +50,9 @@ struct RenderContext {
   math::Dimension2i                   viewportDimension;
   RenderSettings                      renderSettings;
   uint32_t                            currentImageIndex = 0;
+  uint32_t                            currentFrameIndex = 0;  // frame in flight slot, its fence was waited
   RenderStatistics                    statistics;
+  const SoftwareOcclusion*            softwareOcclusion = nullptr;  // occlusion buffer of the frame, for debug views
 };
 
 }  // namespace renderer
@@ -0,0 +1,640 @@
+#include "gfx/renderer/render_graph.h"
+
+#include "gfx/renderer/render_context.h"
+#include "profiler/profiler.h"
+#include "utils/logger/log.h"
+#include "utils/resource/resource_deletion_manager.h"
+#include "utils/service/service_locator.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+namespace {
+
+constexpr const char* kLayoutNames[] = {
+  "Undefined",
+  "General",
+  "Uav",
+  "ColorAttachment",
+  "DepthStencilAttachment",
+  "DepthStencilReadOnly",
+  "ShaderReadOnly",
+  "TransferSrc",
+  "TransferDst",
+  "Preinitialized",
+  "DepthReadOnlyStencilAttachment",
+  "DepthAttachmentStencilReadOnly",
+  "DepthAttachment",
+  "DepthReadOnly",
+  "StencilAttachment",
+  "StencilReadOnly",
+  "PresentSrc",
+  "SharedPresent",
+  "ShadingRateNv",
+  "FragmentDensityMapExt",
+  "ReadOnly",
+  "Attachment",
+  "AccelerationStructure",
+  "IndirectArgument",
+};
+
+static_assert(sizeof(kLayoutNames) / sizeof(kLayoutNames[0]) == static_cast<size_t>(rhi::ResourceLayout::Count),
+              "layout name missing");
+
+const char* getLayoutName(rhi::ResourceLayout layout) {
+  return layout < rhi::ResourceLayout::Count ? kLayoutNames[static_cast<size_t>(layout)] : "Unknown";
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+bool isSameDesc(const rhi::TextureDesc& lhs, const rhi::TextureDesc& rhs) {
+  return lhs.type == rhs.type && lhs.format == rhs.format && lhs.createFlags == rhs.createFlags
+      && lhs.width == rhs.width && lhs.height == rhs.height && lhs.depth == rhs.depth && lhs.arraySize == rhs.arraySize
+      && lhs.mipLevels == rhs.mipLevels && lhs.sampleCount == rhs.sampleCount;
+}
+
+// ResourceDeletionManager::HandleBatchDeleter of the heaps of replaced frame slots
+void deleteHeaps(void* context, std::span<const uint64_t> handles) {
+  for (const uint64_t handle : handles) {
+    delete reinterpret_cast<rhi::MemoryHeap*>(handle);
+  }
+}
+
+}  // namespace
+
+// RenderGraphBuilder
+// ----------------------------------------------------------------------------
+
+RenderGraphResource RenderGraphBuilder::create(const std::string& name, const rhi::TextureDesc& desc) {
+  RenderGraph::Resource resource;
+  resource.name = name;
+  resource.desc = desc;
+  if (resource.desc.debugName.empty()) {
+    resource.desc.debugName = name;
+  }
+  // the first barrier of a frame starts from undefined contents
+  resource.desc.initialLayout = rhi::ResourceLayout::Undefined;
+
+  m_graph_->m_resources_.push_back(std::move(resource));
+  return RenderGraphResource{static_cast<uint32_t>(m_graph_->m_resources_.size() - 1)};
+}
+
+void RenderGraphBuilder::read(RenderGraphResource resource, rhi::ResourceLayout layout) {
+  if (!resource.isValid() || resource.index >= m_graph_->m_resources_.size()) {
+    LOG_ERROR("RenderGraph: pass '{}' reads an invalid resource", m_graph_->m_passes_[m_passIndex_].name);
+    return;
+  }
+  m_graph_->m_passes_[m_passIndex_].reads.push_back({resource.index, layout});
+}
+
+void RenderGraphBuilder::write(RenderGraphResource resource, rhi::ResourceLayout layout) {
+  if (!resource.isValid() || resource.index >= m_graph_->m_resources_.size()) {
+    LOG_ERROR("RenderGraph: pass '{}' writes an invalid resource", m_graph_->m_passes_[m_passIndex_].name);
+    return;
+  }
+  m_graph_->m_passes_[m_passIndex_].writes.push_back({resource.index, layout});
+}
+
+// RenderGraph
+// ----------------------------------------------------------------------------
+
+void RenderGraph::reset() {
+  m_passes_.clear();
+  m_resources_.clear();
+  m_finalBarriers_.clear();
+  m_statistics_ = {};
+  m_compiled_   = false;
+}
+
+RenderGraphResource RenderGraph::importTexture(const std::string& name, rhi::Texture* texture) {
+  if (!texture) {
+    LOG_ERROR("RenderGraph: imported texture '{}' is null", name);
+    return {};
+  }
+
+  Resource resource;
+  resource.name     = name;
+  resource.desc     = texture->getDesc();
+  resource.texture  = texture;
+  resource.imported = true;
+
+  m_resources_.push_back(std::move(resource));
+  return RenderGraphResource{static_cast<uint32_t>(m_resources_.size() - 1)};
+}
+
+void RenderGraph::markOutput(RenderGraphResource resource, rhi::ResourceLayout finalLayout) {
+  if (!resource.isValid() || resource.index >= m_resources_.size()) {
+    LOG_ERROR("RenderGraph: invalid output resource");
+    return;
+  }
+  m_resources_[resource.index].output      = true;
+  m_resources_[resource.index].finalLayout = finalLayout;
+}
+
+void RenderGraph::addPass(const std::string& name, const SetupCallback& setup, const ExecuteCallback& execute) {
+  const uint32_t passIndex = static_cast<uint32_t>(m_passes_.size());
+
+  Pass pass;
+  pass.name    = name;
+  pass.execute = execute;
+  m_passes_.push_back(std::move(pass));
+
+  RenderGraphBuilder builder(this, passIndex);
+  setup(builder);
+  m_passes_[passIndex].sideEffect = builder.m_sideEffect_;
+
+  m_compiled_ = false;
+}
+
+bool RenderGraph::compile(uint32_t frameIndex) {
+  CPU_ZONE_NC("RenderGraph::compile", color::YELLOW);
+
+  m_statistics_           = {};
+  m_statistics_.passCount = static_cast<uint32_t>(m_passes_.size());
+  m_finalBarriers_.clear();
+
+  cullPasses_();
+  computeLifetimes_();
+
+  if (!planBarriers_()) {
+    return false;
+  }
+
+  if (!placeTransientTextures_(frameIndex)) {
+    return false;
+  }
+
+  m_compiled_ = true;
+  return true;
+}
+
+void RenderGraph::execute(RenderContext& context) {
+  CPU_ZONE_NC("RenderGraph::execute", color::YELLOW);
+
+  if (!m_compiled_) {
+    LOG_ERROR("RenderGraph::execute: graph is not compiled");
+    return;
+  }
+
+  std::vector<rhi::ResourceBarrierDesc> batch;
+
+  // the graph owns the layout transitions of its textures, the planned layouts are recorded as they are
+  auto recordBarriers = [&](const std::vector<Barrier>& barriers) {
+    if (barriers.empty()) {
+      return;
+    }
+
+    batch.clear();
+    for (const auto& barrier : barriers) {
+      rhi::ResourceBarrierDesc desc;
+      desc.texture   = m_resources_[barrier.resource].texture;
+      desc.oldLayout = barrier.oldLayout;
+      desc.newLayout = barrier.newLayout;
+      desc.discard   = barrier.discard;
+      batch.push_back(desc);
+    }
+    context.commandBuffer->resourceBarriers(batch);
+  };
+
+  for (const auto& pass : m_passes_) {
+    if (pass.culled) {
+      continue;
+    }
+    recordBarriers(pass.barriers);
+    pass.execute(context);
+  }
+
+  recordBarriers(m_finalBarriers_);
+}
+
+rhi::Texture* RenderGraph::getTexture(RenderGraphResource resource) const {
+  if (!resource.isValid() || resource.index >= m_resources_.size()) {
+    return nullptr;
+  }
+  return m_resources_[resource.index].texture;
+}
+
+std::string RenderGraph::exportDot() const {
+  std::string dot = "digraph RenderGraph {\n  rankdir=LR;\n  node [fontname=\"Consolas\"];\n";
+
+  for (size_t i = 0; i < m_passes_.size(); ++i) {
+    const auto& pass = m_passes_[i];
+    dot += "  pass" + std::to_string(i) + " [shape=box, label=\"" + pass.name + "\"";
+    dot += pass.culled ? ", style=dashed, fontcolor=gray];\n" : ", style=filled, fillcolor=lightblue];\n";
+  }
+
+  for (size_t i = 0; i < m_resources_.size(); ++i) {
+    const auto& resource = m_resources_[i];
+
+    std::string label = resource.name + "\\n" + std::to_string(resource.desc.width) + "x"
+                      + std::to_string(resource.desc.height);
+    if (resource.aliased) {
+      label += "\\nheap +" + std::to_string(resource.heapOffset) + " (" + std::to_string(resource.size) + " B)";
+    }
+
+    dot += "  res" + std::to_string(i) + " [shape=ellipse, label=\"" + label + "\"";
+    if (resource.imported) {
+      dot += ", style=filled, fillcolor=khaki";
+    } else if (!isTransient_(resource)) {
+      dot += ", style=dashed, fontcolor=gray";
+    }
+    dot += resource.output ? ", peripheries=2];\n" : "];\n";
+  }
+
+  for (size_t i = 0; i < m_passes_.size(); ++i) {
+    const auto& pass = m_passes_[i];
+    for (const auto& access : pass.reads) {
+      dot += "  res" + std::to_string(access.resource) + " -> pass" + std::to_string(i) + " [label=\""
+           + getLayoutName(access.layout) + "\"];\n";
+    }
+    for (const auto& access : pass.writes) {
+      dot += "  pass" + std::to_string(i) + " -> res" + std::to_string(access.resource) + " [label=\""
+           + getLayoutName(access.layout) + "\", color=red];\n";
+    }
+  }
+
+  dot += "}\n";
+  return dot;
+}
+
+std::string RenderGraph::exportJson() const {
+  rapidjson::Document document;
+  document.SetObject();
+  auto& allocator = document.GetAllocator();
+
+  auto makeAccesses = [&](const std::vector<Access>& accesses) {
+    rapidjson::Value array(rapidjson::kArrayType);
+    for (const auto& access : accesses) {
+      rapidjson::Value value(rapidjson::kObjectType);
+      value.AddMember("resource", access.resource, allocator);
+      value.AddMember("layout", rapidjson::StringRef(getLayoutName(access.layout)), allocator);
+      array.PushBack(value, allocator);
+    }
+    return array;
+  };
+
+  auto makeBarriers = [&](const std::vector<Barrier>& barriers) {
+    rapidjson::Value array(rapidjson::kArrayType);
+    for (const auto& barrier : barriers) {
+      rapidjson::Value value(rapidjson::kObjectType);
+      value.AddMember("resource", barrier.resource, allocator);
+      value.AddMember("oldLayout", rapidjson::StringRef(getLayoutName(barrier.oldLayout)), allocator);
+      value.AddMember("newLayout", rapidjson::StringRef(getLayoutName(barrier.newLayout)), allocator);
+      value.AddMember("discard", barrier.discard, allocator);
+      array.PushBack(value, allocator);
+    }
+    return array;
+  };
+
+  rapidjson::Value passes(rapidjson::kArrayType);
+  for (const auto& pass : m_passes_) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember("name", rapidjson::Value(pass.name.c_str(), allocator), allocator);
+    value.AddMember("culled", pass.culled, allocator);
+    value.AddMember("sideEffect", pass.sideEffect, allocator);
+    value.AddMember("reads", makeAccesses(pass.reads), allocator);
+    value.AddMember("writes", makeAccesses(pass.writes), allocator);
+    value.AddMember("barriers", makeBarriers(pass.barriers), allocator);
+    passes.PushBack(value, allocator);
+  }
+  document.AddMember("passes", passes, allocator);
+
+  rapidjson::Value resources(rapidjson::kArrayType);
+  for (const auto& resource : m_resources_) {
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember("name", rapidjson::Value(resource.name.c_str(), allocator), allocator);
+    value.AddMember("imported", resource.imported, allocator);
+    value.AddMember("output", resource.output, allocator);
+    value.AddMember("width", resource.desc.width, allocator);
+    value.AddMember("height", resource.desc.height, allocator);
+    value.AddMember("format", static_cast<uint32_t>(resource.desc.format), allocator);
+    if (isTransient_(resource)) {
+      value.AddMember("firstPass", resource.firstPass, allocator);
+      value.AddMember("lastPass", resource.lastPass, allocator);
+      value.AddMember("aliased", resource.aliased, allocator);
+      value.AddMember("heapOffset", resource.heapOffset, allocator);
+      value.AddMember("size", resource.size, allocator);
+    }
+    resources.PushBack(value, allocator);
+  }
+  document.AddMember("resources", resources, allocator);
+
+  document.AddMember("finalBarriers", makeBarriers(m_finalBarriers_), allocator);
+
+  rapidjson::Value statistics(rapidjson::kObjectType);
+  statistics.AddMember("passCount", m_statistics_.passCount, allocator);
+  statistics.AddMember("culledPassCount", m_statistics_.culledPassCount, allocator);
+  statistics.AddMember("barrierCount", m_statistics_.barrierCount, allocator);
+  statistics.AddMember("barrierBatchCount", m_statistics_.barrierBatchCount, allocator);
+  statistics.AddMember("transientTextureCount", m_statistics_.transientTextureCount, allocator);
+  statistics.AddMember("transientMemory", m_statistics_.transientMemory, allocator);
+  statistics.AddMember("transientMemoryTotal", m_statistics_.transientMemoryTotal, allocator);
+  document.AddMember("statistics", statistics, allocator);
+
+  rapidjson::StringBuffer                          buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  return buffer.GetString();
+}
+
+void RenderGraph::cleanup() {
+  // textures first, they are placed in the heaps
+  for (auto& slot : m_frameSlots_) {
+    slot.textures.clear();
+    slot.heap.reset();
+  }
+  m_frameSlots_.clear();
+
+  for (auto& resource : m_resources_) {
+    if (!resource.imported) {
+      resource.texture = nullptr;
+    }
+  }
+  m_compiled_ = false;
+}
+
+void RenderGraph::cullPasses_() {
+  // walk back from the outputs: a pass is needed if a later needed pass (or an output) reads what it writes
+  std::vector<bool> needed(m_resources_.size(), false);
+  for (size_t i = 0; i < m_resources_.size(); ++i) {
+    needed[i] = m_resources_[i].output;
+  }
+
+  for (size_t i = m_passes_.size(); i-- > 0;) {
+    auto& pass = m_passes_[i];
+
+    bool isNeeded = pass.sideEffect;
+    for (const auto& access : pass.writes) {
+      isNeeded = isNeeded || needed[access.resource];
+    }
+
+    pass.culled = !isNeeded;
+    if (pass.culled) {
+      ++m_statistics_.culledPassCount;
+      continue;
+    }
+
+    // earlier contents are overwritten, unless the pass reads them as well
+    for (const auto& access : pass.writes) {
+      needed[access.resource] = false;
+    }
+    for (const auto& access : pass.reads) {
+      needed[access.resource] = true;
+    }
+  }
+}
+
+void RenderGraph::computeLifetimes_() {
+  for (uint32_t i = 0; i < m_passes_.size(); ++i) {
+    const auto& pass = m_passes_[i];
+    if (pass.culled) {
+      continue;
+    }
+
+    auto use = [&](const Access& access) {
+      auto& resource     = m_resources_[access.resource];
+      resource.firstPass = std::min(resource.firstPass, i);
+      resource.lastPass  = std::max(resource.lastPass, i);
+    };
+    std::for_each(pass.reads.begin(), pass.reads.end(), use);
+    std::for_each(pass.writes.begin(), pass.writes.end(), use);
+  }
+}
+
+bool RenderGraph::planBarriers_() {
+  std::vector<rhi::ResourceLayout> layouts(m_resources_.size(), rhi::ResourceLayout::Undefined);
+  std::vector<bool>                used(m_resources_.size(), false);
+  std::vector<uint32_t>            lastAccessPass(m_resources_.size(), UINT32_MAX);
+
+  for (size_t i = 0; i < m_resources_.size(); ++i) {
+    if (m_resources_[i].imported) {
+      layouts[i] = m_resources_[i].texture->getCurrentLayoutType();
+    }
+  }
+
+  for (uint32_t i = 0; i < m_passes_.size(); ++i) {
+    auto& pass = m_passes_[i];
+    pass.barriers.clear();
+    if (pass.culled) {
+      continue;
+    }
+
+    bool valid       = true;
+    auto useResource = [&](const Access& access) {
+      // a pass that both reads and writes a texture uses it in one layout
+      if (lastAccessPass[access.resource] == i) {
+        if (layouts[access.resource] != access.layout) {
+          LOG_ERROR("RenderGraph: pass '{}' uses '{}' in two layouts ({}, {})",
+                    pass.name,
+                    m_resources_[access.resource].name,
+                    getLayoutName(layouts[access.resource]),
+                    getLayoutName(access.layout));
+          valid = false;
+        }
+        return;
+      }
+      lastAccessPass[access.resource] = i;
+
+      // transient contents don't survive between frames (and the memory is shared), the first use discards them
+      const bool discard = !m_resources_[access.resource].imported && !used[access.resource];
+      if (discard || layouts[access.resource] != access.layout) {
+        pass.barriers.push_back({access.resource, layouts[access.resource], access.layout, discard});
+      }
+      layouts[access.resource] = access.layout;
+      used[access.resource]    = true;
+    };
+    std::for_each(pass.reads.begin(), pass.reads.end(), useResource);
+    std::for_each(pass.writes.begin(), pass.writes.end(), useResource);
+
+    if (!valid) {
+      return false;
+    }
+
+    m_statistics_.barrierCount      += static_cast<uint32_t>(pass.barriers.size());
+    m_statistics_.barrierBatchCount += pass.barriers.empty() ? 0 : 1;
+  }
+
+  for (uint32_t i = 0; i < m_resources_.size(); ++i) {
+    const auto& resource = m_resources_[i];
+    if (resource.output && resource.finalLayout != rhi::ResourceLayout::Undefined
+        && layouts[i] != resource.finalLayout) {
+      m_finalBarriers_.push_back({i, layouts[i], resource.finalLayout, false});
+    }
+  }
+  m_statistics_.barrierCount      += static_cast<uint32_t>(m_finalBarriers_.size());
+  m_statistics_.barrierBatchCount += m_finalBarriers_.empty() ? 0 : 1;
+
+  return true;
+}
+
+bool RenderGraph::placeTransientTextures_(uint32_t frameIndex) {
+  std::vector<uint32_t> transients;
+  std::vector<uint32_t> aliased;
+  uint32_t              memoryTypeBits = UINT32_MAX;
+
+  for (uint32_t i = 0; i < m_resources_.size(); ++i) {
+    auto& resource = m_resources_[i];
+    if (!isTransient_(resource)) {
+      continue;
+    }
+    transients.push_back(i);
+
+    // heaps hold render targets and depth-stencil textures only, other textures get their own memory
+    const auto attachmentFlags = rhi::TextureCreateFlag::Rtv | rhi::TextureCreateFlag::Dsv;
+    if ((resource.desc.createFlags & attachmentFlags) == rhi::TextureCreateFlag::None) {
+      continue;
+    }
+
+    const auto requirements = m_device_->getTextureMemoryRequirements(resource.desc);
+    if (requirements.size == 0 || (memoryTypeBits & requirements.memoryTypeBits) == 0) {
+      continue;
+    }
+
+    memoryTypeBits     &= requirements.memoryTypeBits;
+    resource.aliased    = true;
+    resource.size       = requirements.size;
+    resource.alignment  = requirements.alignment;
+
+    m_statistics_.transientMemoryTotal += requirements.size;
+    aliased.push_back(i);
+  }
+
+  // largest first, each texture goes to the lowest offset not used by a texture alive at the same time
+  std::stable_sort(aliased.begin(), aliased.end(), [this](uint32_t lhs, uint32_t rhs) {
+    return m_resources_[lhs].size > m_resources_[rhs].size;
+  });
+
+  uint64_t                                   heapSize      = 0;
+  uint64_t                                   heapAlignment = 1;
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+
+  for (size_t i = 0; i < aliased.size(); ++i) {
+    auto& resource = m_resources_[aliased[i]];
+
+    ranges.clear();
+    for (size_t j = 0; j < i; ++j) {
+      const auto& placed = m_resources_[aliased[j]];
+      if (placed.firstPass <= resource.lastPass && resource.firstPass <= placed.lastPass) {
+        ranges.emplace_back(placed.heapOffset, placed.heapOffset + placed.size);
+      }
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    uint64_t offset = 0;
+    for (const auto& range : ranges) {
+      if (alignUp(offset, resource.alignment) + resource.size <= range.first) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+
+    resource.heapOffset = alignUp(offset, resource.alignment);
+    heapSize            = std::max(heapSize, resource.heapOffset + resource.size);
+    heapAlignment       = std::max(heapAlignment, resource.alignment);
+  }
+
+  m_statistics_.transientTextureCount = static_cast<uint32_t>(transients.size());
+  m_statistics_.transientMemory       = heapSize;
+
+  if (m_frameSlots_.size() <= frameIndex) {
+    m_frameSlots_.resize(frameIndex + 1);
+  }
+  auto& slot = m_frameSlots_[frameIndex];
+
+  if (!isFrameSlotReusable_(slot, transients, heapSize)) {
+    // frames in flight may still use the previous textures of the slot
+    retireFrameSlot_(slot);
+
+    if (heapSize > 0) {
+      rhi::MemoryHeapDesc heapDesc;
+      heapDesc.size           = heapSize;
+      heapDesc.alignment      = heapAlignment;
+      heapDesc.memoryTypeBits = memoryTypeBits;
+      heapDesc.debugName      = "RenderGraph Heap " + std::to_string(frameIndex);
+
+      slot.heap = m_device_->createMemoryHeap(heapDesc);
+      if (!slot.heap) {
+        LOG_ERROR("RenderGraph: failed to create the transient heap ({} bytes)", heapSize);
+        return false;
+      }
+    }
+
+    for (uint32_t index : transients) {
+      const auto& resource = m_resources_[index];
+
+      TransientTexture transient;
+      transient.desc       = resource.desc;
+      transient.aliased    = resource.aliased;
+      transient.heapOffset = resource.heapOffset;
+      transient.texture    = resource.aliased
+                               ? m_device_->createAliasedTexture(resource.desc, slot.heap.get(), resource.heapOffset)
+                               : m_device_->createTexture(resource.desc);
+
+      if (!transient.texture) {
+        LOG_ERROR("RenderGraph: failed to create the transient texture '{}'", resource.name);
+        retireFrameSlot_(slot);
+        return false;
+      }
+      slot.textures.push_back(std::move(transient));
+    }
+  }
+
+  for (size_t i = 0; i < transients.size(); ++i) {
+    m_resources_[transients[i]].texture = slot.textures[i].texture.get();
+  }
+
+  return true;
+}
+
+void RenderGraph::retireFrameSlot_(FrameSlot& slot) {
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (!deletionManager) {
+    slot.textures.clear();
+    slot.heap.reset();
+    return;
+  }
+
+  // handles of a frame are released after its textures, so the heap outlives the textures placed in it
+  for (auto& transient : slot.textures) {
+    deletionManager->enqueueForDeletion(std::move(transient.texture));
+  }
+  slot.textures.clear();
+
+  if (slot.heap) {
+    deletionManager->enqueueHandleForDeletion(reinterpret_cast<uint64_t>(slot.heap.release()), &deleteHeaps, nullptr);
+  }
+}
+
+bool RenderGraph::isFrameSlotReusable_(const FrameSlot&            slot,
+                                       const std::vector<uint32_t>& transients,
+                                       uint64_t                     heapSize) const {
+  const uint64_t slotHeapSize = slot.heap ? slot.heap->getSize() : 0;
+  if (slot.textures.size() != transients.size() || slotHeapSize != heapSize) {
+    return false;
+  }
+
+  for (size_t i = 0; i < transients.size(); ++i) {
+    const auto& resource  = m_resources_[transients[i]];
+    const auto& transient = slot.textures[i];
+    if (!isSameDesc(transient.desc, resource.desc) || transient.aliased != resource.aliased
+        || transient.heapOffset != resource.heapOffset) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
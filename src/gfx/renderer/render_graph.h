@@ -0,0 +1,234 @@
+#ifndef ARISE_RENDER_GRAPH_H
+#define ARISE_RENDER_GRAPH_H
+
+#include "gfx/rhi/common/rhi_enums.h"
+#include "gfx/rhi/common/rhi_types.h"
+#include "gfx/rhi/interface/device.h"
+#include "gfx/rhi/interface/memory_heap.h"
+#include "gfx/rhi/interface/texture.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+struct RenderContext;
+class RenderGraph;
+
+// virtual texture of a RenderGraph, valid until the next RenderGraph::reset()
+struct RenderGraphResource {
+  static constexpr uint32_t kInvalid = UINT32_MAX;
+
+  uint32_t index = kInvalid;
+
+  bool isValid() const { return index != kInvalid; }
+};
+
+/**
+ * Declares the textures a pass uses, given to the setup callback of RenderGraph::addPass.
+ * The layout of an access is the layout the texture must be in while the pass executes.
+ */
+class RenderGraphBuilder {
+  public:
+  /**
+   * Creates a transient texture - it exists only between its first and last use in the frame and its memory is
+   * shared with transient textures that are never alive at the same time (render targets and depth-stencil textures)
+   */
+  RenderGraphResource create(const std::string& name, const rhi::TextureDesc& desc);
+
+  // the pass needs the contents of the texture
+  void read(RenderGraphResource resource, rhi::ResourceLayout layout);
+
+  // the pass writes the texture, declare a read as well if the previous contents are loaded
+  void write(RenderGraphResource resource, rhi::ResourceLayout layout);
+
+  // the pass is never culled (it has effects outside of the graph)
+  void setSideEffect() { m_sideEffect_ = true; }
+
+  private:
+  friend class RenderGraph;
+
+  RenderGraphBuilder(RenderGraph* graph, uint32_t passIndex)
+      : m_graph_(graph)
+      , m_passIndex_(passIndex) {}
+
+  RenderGraph* m_graph_      = nullptr;
+  uint32_t     m_passIndex_  = 0;
+  bool         m_sideEffect_ = false;
+};
+
+/**
+ * Frame graph of the render passes.
+ *
+ * Each frame the passes are added in execution order together with the textures they read and write (reset(),
+ * importTexture(), addPass(), markOutput()). compile() then:
+ * - culls passes whose results don't reach an output or a pass with side effects
+ * - computes the lifetime (first and last pass) of every transient texture
+ * - places the layout transitions in front of the passes - accesses in the same layout need no barrier, the
+ *   transitions of a pass are recorded as one batch (CommandBuffer::resourceBarriers)
+ * - places transient textures in a memory heap, textures with disjoint lifetimes share memory
+ *
+ * execute() records the barriers and runs the passes. The planned transitions are recorded as they are - passes leave
+ * the textures in the layouts they declared and don't transition them on their own. The compiled graph stays
+ * available for inspection until the next reset() (exportDot(), exportJson()).
+ *
+ * Transient textures are kept per frame slot (the index of the frame targets, see FrameResources::getRenderTargets())
+ * and recreated only when the placement changes, replaced textures and heaps are released with the frame delay.
+ */
+class RenderGraph {
+  public:
+  using SetupCallback   = std::function<void(RenderGraphBuilder&)>;
+  using ExecuteCallback = std::function<void(RenderContext&)>;
+
+  struct Statistics {
+    uint32_t passCount             = 0;
+    uint32_t culledPassCount       = 0;
+    uint32_t barrierCount          = 0;
+    uint32_t barrierBatchCount     = 0;
+    uint32_t transientTextureCount = 0;
+    uint64_t transientMemory       = 0;  // size of the heap (aliased)
+    uint64_t transientMemoryTotal  = 0;  // sum of the sizes of the heap textures (without aliasing)
+  };
+
+  explicit RenderGraph(rhi::Device* device)
+      : m_device_(device) {}
+
+  ~RenderGraph() { cleanup(); }
+
+  RenderGraph(const RenderGraph&)            = delete;
+  RenderGraph& operator=(const RenderGraph&) = delete;
+
+  /**
+   * Drops the passes and resources of the previous frame, transient textures are kept for reuse
+   */
+  void reset();
+
+  // a texture owned outside of the graph, its layout at compile() is where the first barrier starts
+  RenderGraphResource importTexture(const std::string& name, rhi::Texture* texture);
+
+  /**
+   * Passes writing the resource are kept. finalLayout (if not Undefined) is the layout the texture is left in after
+   * the last pass
+   */
+  void markOutput(RenderGraphResource resource, rhi::ResourceLayout finalLayout = rhi::ResourceLayout::Undefined);
+
+  void addPass(const std::string& name, const SetupCallback& setup, const ExecuteCallback& execute);
+
+  /**
+   * Culls passes, plans barriers and places the transient textures of the frame slot (their textures are available
+   * from getTexture() after compile)
+   *
+   * @return false if the graph is invalid (the frame should not be executed)
+   */
+  bool compile(uint32_t frameIndex);
+
+  // records the barriers and the passes that survived culling
+  void execute(RenderContext& context);
+
+  // physical texture of the resource, valid in the execute callbacks (transient textures) or after import
+  rhi::Texture* getTexture(RenderGraphResource resource) const;
+
+  const Statistics& getStatistics() const { return m_statistics_; }
+
+  // graph of the last compiled frame in Graphviz DOT format (passes as boxes, textures as ellipses)
+  std::string exportDot() const;
+
+  std::string exportJson() const;
+
+  // releases the transient textures and heaps of all frame slots (the GPU must be idle)
+  void cleanup();
+
+  private:
+  friend class RenderGraphBuilder;
+
+  struct Access {
+    uint32_t            resource = 0;
+    rhi::ResourceLayout layout   = rhi::ResourceLayout::Undefined;
+  };
+
+  struct Barrier {
+    uint32_t            resource  = 0;
+    rhi::ResourceLayout oldLayout = rhi::ResourceLayout::Undefined;
+    rhi::ResourceLayout newLayout = rhi::ResourceLayout::Undefined;
+    bool                discard   = false;  // first use of a transient texture
+  };
+
+  struct Pass {
+    std::string          name;
+    ExecuteCallback      execute;
+    std::vector<Access>  reads;
+    std::vector<Access>  writes;
+    std::vector<Barrier> barriers;  // recorded in front of the pass
+    bool                 sideEffect = false;
+    bool                 culled     = false;
+  };
+
+  struct Resource {
+    std::string         name;
+    rhi::TextureDesc    desc;
+    rhi::Texture*       texture     = nullptr;  // imported texture, or the physical transient texture after compile()
+    bool                imported    = false;
+    bool                output      = false;
+    rhi::ResourceLayout finalLayout = rhi::ResourceLayout::Undefined;
+
+    // transient textures
+    uint32_t firstPass  = UINT32_MAX;
+    uint32_t lastPass   = 0;
+    bool     aliased    = false;  // placed in the heap (render target / depth-stencil)
+    uint64_t heapOffset = 0;
+    uint64_t size       = 0;
+    uint64_t alignment  = 1;
+  };
+
+  // physical transient texture of a frame slot
+  struct TransientTexture {
+    rhi::TextureDesc              desc;
+    bool                          aliased    = false;
+    uint64_t                      heapOffset = 0;
+    std::unique_ptr<rhi::Texture> texture;
+  };
+
+  struct FrameSlot {
+    std::unique_ptr<rhi::MemoryHeap> heap;
+    std::vector<TransientTexture>    textures;  // in transient resource order
+  };
+
+  void cullPasses_();
+
+  void computeLifetimes_();
+
+  // false if a pass accesses a texture in two different layouts
+  bool planBarriers_();
+
+  bool placeTransientTextures_(uint32_t frameIndex);
+
+  // releases the textures and the heap of the slot once the frames in flight are done with them
+  void retireFrameSlot_(FrameSlot& slot);
+
+  // true if the slot already holds textures with the planned descs and offsets
+  bool isFrameSlotReusable_(const FrameSlot& slot, const std::vector<uint32_t>& transients, uint64_t heapSize) const;
+
+  bool isTransient_(const Resource& resource) const { return !resource.imported && resource.firstPass != UINT32_MAX; }
+
+  rhi::Device* m_device_ = nullptr;
+
+  std::vector<Pass>     m_passes_;
+  std::vector<Resource> m_resources_;
+  std::vector<Barrier>  m_finalBarriers_;  // outputs to their final layouts, recorded after the last pass
+
+  std::vector<FrameSlot> m_frameSlots_;
+
+  Statistics m_statistics_;
+  bool       m_compiled_ = false;
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_RENDER_GRAPH_H
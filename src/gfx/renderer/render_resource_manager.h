@@ -10,11 +10,13 @@
 #include "gfx/rhi/interface/sampler.h"
 #include "gfx/rhi/interface/shader.h"
 #include "gfx/rhi/interface/texture.h"
+#include "utils/resource/resource_deletion_manager.h"
+#include "utils/handle/handle_pool.h"
+#include "utils/service/service_locator.h"
+#include "utils/string_id/string_id_map.h"
 
 #include <memory>
-#include <string>
-#include <unordered_map>
-#include <vector>
+#include <type_traits>
 
 namespace arise {
 namespace gfx {
@@ -24,7 +26,8 @@ namespace renderer {
  * Handles lifetime and ownership of rendering resources.
  *
  * This class maintains separate containers for different resource types and provides methods to add, cache, and access
- * those resources in a type-safe manner.
+ * those resources in a type-safe manner. Each type is kept in a HandlePool, resources added with a cache key are also
+ * indexed by the id of the key and can be referenced by generational handles (getHandle()).
  */
 class RenderResourceManager {
   public:
@@ -34,210 +37,134 @@ class RenderResourceManager {
   //--------------------------------------------------------------------------
   // Buffer management
   //--------------------------------------------------------------------------
-  rhi::Buffer* addBuffer(std::unique_ptr<rhi::Buffer> buffer, const std::string& cacheKey = "") {
-    rhi::Buffer* ptr = buffer.get();
+  rhi::Buffer* addBuffer(std::unique_ptr<rhi::Buffer> buffer, StringId cacheKey = {}) {
+    return m_buffers.add(std::move(buffer), cacheKey);
+  }
 
-    if (cacheKey.empty()) {
-      m_buffers.push_back(std::move(buffer));
-    } else {
-      m_cachedBuffers[cacheKey] = std::move(buffer);
-    }
+  rhi::Buffer* getBuffer(StringId cacheKey) { return m_buffers.get(cacheKey); }
 
-    return ptr;
-  }
+  // frames in flight may still use the buffer, it is destroyed with the frame delay of ResourceDeletionManager
+  void removeBuffer(StringId cacheKey) {
+    auto buffer = m_buffers.remove(cacheKey);
+    if (!buffer) {
+      return;
+    }
 
-  rhi::Buffer* getBuffer(const std::string& cacheKey) {
-    auto it = m_cachedBuffers.find(cacheKey);
-    if (it != m_cachedBuffers.end()) {
-      return it->second.get();
+    auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+    if (deletionManager) {
+      deletionManager->enqueueForDeletion(std::move(buffer));
     }
-    return nullptr;
   }
 
   //--------------------------------------------------------------------------
   // Texture management
   //--------------------------------------------------------------------------
-  rhi::Texture* addTexture(std::unique_ptr<rhi::Texture> texture, const std::string& cacheKey = "") {
-    rhi::Texture* ptr = texture.get();
-
-    if (cacheKey.empty()) {
-      m_textures.push_back(std::move(texture));
-    } else {
-      m_cachedTextures[cacheKey] = std::move(texture);
-    }
-
-    return ptr;
+  rhi::Texture* addTexture(std::unique_ptr<rhi::Texture> texture, StringId cacheKey = {}) {
+    return m_textures.add(std::move(texture), cacheKey);
   }
 
-  rhi::Texture* getTexture(const std::string& cacheKey) {
-    auto it = m_cachedTextures.find(cacheKey);
-    if (it != m_cachedTextures.end()) {
-      return it->second.get();
-    }
-    return nullptr;
-  }
+  rhi::Texture* getTexture(StringId cacheKey) { return m_textures.get(cacheKey); }
 
   //--------------------------------------------------------------------------
   // Sampler management
   //--------------------------------------------------------------------------
-  rhi::Sampler* addSampler(std::unique_ptr<rhi::Sampler> sampler, const std::string& cacheKey = "") {
-    rhi::Sampler* ptr = sampler.get();
-
-    if (cacheKey.empty()) {
-      m_samplers.push_back(std::move(sampler));
-    } else {
-      m_cachedSamplers[cacheKey] = std::move(sampler);
-    }
-
-    return ptr;
+  rhi::Sampler* addSampler(std::unique_ptr<rhi::Sampler> sampler, StringId cacheKey = {}) {
+    return m_samplers.add(std::move(sampler), cacheKey);
   }
 
-  rhi::Sampler* getSampler(const std::string& cacheKey) {
-    auto it = m_cachedSamplers.find(cacheKey);
-    if (it != m_cachedSamplers.end()) {
-      return it->second.get();
-    }
-    return nullptr;
-  }
+  rhi::Sampler* getSampler(StringId cacheKey) { return m_samplers.get(cacheKey); }
 
   //--------------------------------------------------------------------------
   // DescriptorSetLayout management
   //--------------------------------------------------------------------------
   rhi::DescriptorSetLayout* addDescriptorSetLayout(std::unique_ptr<rhi::DescriptorSetLayout> layout,
-                                                   const std::string&                        cacheKey = "") {
-    rhi::DescriptorSetLayout* ptr = layout.get();
-
-    if (cacheKey.empty()) {
-      m_descriptorSetLayouts.push_back(std::move(layout));
-    } else {
-      m_cachedDescriptorSetLayouts[cacheKey] = std::move(layout);
-    }
-
-    return ptr;
+                                                   StringId                                  cacheKey = {}) {
+    return m_descriptorSetLayouts.add(std::move(layout), cacheKey);
   }
 
-  rhi::DescriptorSetLayout* getDescriptorSetLayout(const std::string& cacheKey) {
-    auto it = m_cachedDescriptorSetLayouts.find(cacheKey);
-    if (it != m_cachedDescriptorSetLayouts.end()) {
-      return it->second.get();
-    }
-    return nullptr;
-  }
+  rhi::DescriptorSetLayout* getDescriptorSetLayout(StringId cacheKey) { return m_descriptorSetLayouts.get(cacheKey); }
 
   //--------------------------------------------------------------------------
   // DescriptorSet management
   //--------------------------------------------------------------------------
-  rhi::DescriptorSet* addDescriptorSet(std::unique_ptr<rhi::DescriptorSet> set, const std::string& cacheKey = "") {
-    rhi::DescriptorSet* ptr = set.get();
-
-    if (cacheKey.empty()) {
-      m_descriptorSets.push_back(std::move(set));
-    } else {
-      m_cachedDescriptorSets[cacheKey] = std::move(set);
-    }
-
-    return ptr;
+  rhi::DescriptorSet* addDescriptorSet(std::unique_ptr<rhi::DescriptorSet> set, StringId cacheKey = {}) {
+    return m_descriptorSets.add(std::move(set), cacheKey);
   }
 
-  rhi::DescriptorSet* getDescriptorSet(const std::string& cacheKey) {
-    auto it = m_cachedDescriptorSets.find(cacheKey);
-    if (it != m_cachedDescriptorSets.end()) {
-      return it->second.get();
-    }
-    return nullptr;
-  }
+  rhi::DescriptorSet* getDescriptorSet(StringId cacheKey) { return m_descriptorSets.get(cacheKey); }
 
   //--------------------------------------------------------------------------
   // Pipeline management
   //--------------------------------------------------------------------------
-  rhi::GraphicsPipeline* addPipeline(std::unique_ptr<rhi::GraphicsPipeline> pipeline,
-                                     const std::string&                     cacheKey = "") {
-    rhi::GraphicsPipeline* ptr = pipeline.get();
+  rhi::GraphicsPipeline* addPipeline(std::unique_ptr<rhi::GraphicsPipeline> pipeline, StringId cacheKey = {}) {
+    return m_pipelines.add(std::move(pipeline), cacheKey);
+  }
 
-    if (cacheKey.empty()) {
-      m_pipelines.push_back(std::move(pipeline));
-    } else {
-      m_cachedPipelines[cacheKey] = std::move(pipeline);
-    }
+  rhi::GraphicsPipeline* getPipeline(StringId cacheKey) { return m_pipelines.get(cacheKey); }
 
-    return ptr;
+  rhi::ComputePipeline* addComputePipeline(std::unique_ptr<rhi::ComputePipeline> pipeline, StringId cacheKey = {}) {
+    return m_computePipelines.add(std::move(pipeline), cacheKey);
   }
 
-  rhi::GraphicsPipeline* getPipeline(const std::string& cacheKey) {
-    auto it = m_cachedPipelines.find(cacheKey);
-    if (it != m_cachedPipelines.end()) {
-      return it->second.get();
-    }
-    return nullptr;
-  }
+  rhi::ComputePipeline* getComputePipeline(StringId cacheKey) { return m_computePipelines.get(cacheKey); }
 
   void updateScheduledPipelines() {
-    for (auto& pipeline : m_pipelines) {
+    auto updatePipeline = [](auto, auto* pipeline) {
       pipeline->decrementUpdateCounter();
       if (pipeline->needsUpdate()) {
         pipeline->rebuild();
       }
-    }
+    };
 
-    for (auto& [key, pipeline] : m_cachedPipelines) {
-      pipeline->decrementUpdateCounter();
-      if (pipeline->needsUpdate()) {
-        pipeline->rebuild();
-      }
-    }
+    m_pipelines.pool.forEach(updatePipeline);
+    m_computePipelines.pool.forEach(updatePipeline);
   }
 
   //--------------------------------------------------------------------------
   // RenderPass management
   //--------------------------------------------------------------------------
-  rhi::RenderPass* addRenderPass(std::unique_ptr<rhi::RenderPass> renderPass, const std::string& cacheKey = "") {
-    rhi::RenderPass* ptr = renderPass.get();
-
-    if (cacheKey.empty()) {
-      m_renderPasses.push_back(std::move(renderPass));
-    } else {
-      m_cachedRenderPasses[cacheKey] = std::move(renderPass);
-    }
-
-    return ptr;
+  rhi::RenderPass* addRenderPass(std::unique_ptr<rhi::RenderPass> renderPass, StringId cacheKey = {}) {
+    return m_renderPasses.add(std::move(renderPass), cacheKey);
   }
 
-  rhi::RenderPass* getRenderPass(const std::string& cacheKey) {
-    auto it = m_cachedRenderPasses.find(cacheKey);
-    if (it != m_cachedRenderPasses.end()) {
-      return it->second.get();
-    }
-    return nullptr;
-  }
+  rhi::RenderPass* getRenderPass(StringId cacheKey) { return m_renderPasses.get(cacheKey); }
 
   //--------------------------------------------------------------------------
   // Framebuffer management
   //--------------------------------------------------------------------------
-  rhi::Framebuffer* addFramebuffer(std::unique_ptr<rhi::Framebuffer> framebuffer, const std::string& cacheKey = "") {
-    rhi::Framebuffer* ptr = framebuffer.get();
+  rhi::Framebuffer* addFramebuffer(std::unique_ptr<rhi::Framebuffer> framebuffer, StringId cacheKey = {}) {
+    return m_framebuffers.add(std::move(framebuffer), cacheKey);
+  }
 
-    if (cacheKey.empty()) {
-      m_framebuffers.push_back(std::move(framebuffer));
-    } else {
-      m_cachedFramebuffers[cacheKey] = std::move(framebuffer);
+  rhi::Framebuffer* getFramebuffer(StringId cacheKey) { return m_framebuffers.get(cacheKey); }
+
+  // frames in flight may still use the framebuffer, it is destroyed with the frame delay of ResourceDeletionManager
+  void removeFramebuffer(StringId cacheKey) {
+    auto framebuffer = m_framebuffers.remove(cacheKey);
+    if (!framebuffer) {
+      return;
     }
 
-    return ptr;
+    auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+    if (deletionManager) {
+      deletionManager->enqueueForDeletion(std::move(framebuffer));
+    }
   }
 
-  rhi::Framebuffer* getFramebuffer(const std::string& cacheKey) {
-    auto it = m_cachedFramebuffers.find(cacheKey);
-    if (it != m_cachedFramebuffers.end()) {
-      return it->second.get();
-    }
-    return nullptr;
+  //--------------------------------------------------------------------------
+  // Handles
+  //--------------------------------------------------------------------------
+
+  // handle of a cached resource, it stops resolving once the resource is replaced or removed
+  template <typename T>
+  Handle<T> getHandle(StringId cacheKey) {
+    return getStorage_<T>().getHandle(cacheKey);
   }
 
-  void removeFramebuffer(const std::string& cacheKey) {
-    auto it = m_cachedFramebuffers.find(cacheKey);
-    if (it != m_cachedFramebuffers.end()) {
-      m_cachedFramebuffers.erase(it);
-    }
+  // nullptr if the resource of the handle was replaced or removed
+  template <typename T>
+  T* get(Handle<T> handle) {
+    return getStorage_<T>().pool.get(handle);
   }
 
   // Clear all resources
@@ -248,39 +175,95 @@ class RenderResourceManager {
     m_descriptorSetLayouts.clear();
     m_descriptorSets.clear();
     m_pipelines.clear();
+    m_computePipelines.clear();
     m_renderPasses.clear();
     m_framebuffers.clear();
-
-    m_cachedBuffers.clear();
-    m_cachedTextures.clear();
-    m_cachedSamplers.clear();
-    m_cachedDescriptorSetLayouts.clear();
-    m_cachedDescriptorSets.clear();
-    m_cachedPipelines.clear();
-    m_cachedRenderPasses.clear();
-    m_cachedFramebuffers.clear();
   }
 
   private:
-  // TODO: consider leave only unordered_map (we don't need to keep unnamed resources in vector)
-  std::vector<std::unique_ptr<rhi::Buffer>>              m_buffers;
-  std::vector<std::unique_ptr<rhi::Texture>>             m_textures;
-  std::vector<std::unique_ptr<rhi::Sampler>>             m_samplers;
-  std::vector<std::unique_ptr<rhi::DescriptorSetLayout>> m_descriptorSetLayouts;
-  std::vector<std::unique_ptr<rhi::DescriptorSet>>       m_descriptorSets;
-  std::vector<std::unique_ptr<rhi::GraphicsPipeline>>    m_pipelines;
-  std::vector<std::unique_ptr<rhi::RenderPass>>          m_renderPasses;
-  std::vector<std::unique_ptr<rhi::Framebuffer>>         m_framebuffers;
-
-  // Cached resources
-  std::unordered_map<std::string, std::unique_ptr<rhi::Buffer>>              m_cachedBuffers;
-  std::unordered_map<std::string, std::unique_ptr<rhi::Texture>>             m_cachedTextures;
-  std::unordered_map<std::string, std::unique_ptr<rhi::Sampler>>             m_cachedSamplers;
-  std::unordered_map<std::string, std::unique_ptr<rhi::DescriptorSetLayout>> m_cachedDescriptorSetLayouts;
-  std::unordered_map<std::string, std::unique_ptr<rhi::DescriptorSet>>       m_cachedDescriptorSets;
-  std::unordered_map<std::string, std::unique_ptr<rhi::GraphicsPipeline>>    m_cachedPipelines;
-  std::unordered_map<std::string, std::unique_ptr<rhi::RenderPass>>          m_cachedRenderPasses;
-  std::unordered_map<std::string, std::unique_ptr<rhi::Framebuffer>>         m_cachedFramebuffers;
+  /**
+   * All resources of one type live in one pool, resources added with a cache key are also indexed by the key
+   */
+  template <typename T>
+  struct ResourceStorage {
+    HandlePool<T>          pool;
+    StringIdMap<Handle<T>> cachedHandles;
+
+    T* add(std::unique_ptr<T> resource, StringId cacheKey) {
+      T*        ptr    = resource.get();
+      Handle<T> handle = pool.add(std::move(resource));
+      if (!handle.isValid()) {
+        return nullptr;  // the pool is out of slot indices, the resource was destroyed
+      }
+
+      if (cacheKey.isValid()) {
+        // a resource cached under the same key is replaced
+        pool.remove(cachedHandles[cacheKey]);
+        cachedHandles[cacheKey] = handle;
+      }
+      return ptr;
+    }
+
+    T* get(StringId cacheKey) const {
+      const Handle<T>* handle = cachedHandles.find(cacheKey);
+      return handle ? pool.get(*handle) : nullptr;
+    }
+
+    Handle<T> getHandle(StringId cacheKey) const {
+      const Handle<T>* handle = cachedHandles.find(cacheKey);
+      return handle ? *handle : Handle<T>();
+    }
+
+    std::unique_ptr<T> remove(StringId cacheKey) {
+      const Handle<T>* handle = cachedHandles.find(cacheKey);
+      if (!handle) {
+        return nullptr;
+      }
+
+      auto resource = pool.remove(*handle);
+      cachedHandles.erase(cacheKey);
+      return resource;
+    }
+
+    void clear() {
+      pool.clear();
+      cachedHandles.clear();
+    }
+  };
+
+  template <typename T>
+  ResourceStorage<T>& getStorage_() {
+    if constexpr (std::is_same_v<T, rhi::Buffer>) {
+      return m_buffers;
+    } else if constexpr (std::is_same_v<T, rhi::Texture>) {
+      return m_textures;
+    } else if constexpr (std::is_same_v<T, rhi::Sampler>) {
+      return m_samplers;
+    } else if constexpr (std::is_same_v<T, rhi::DescriptorSetLayout>) {
+      return m_descriptorSetLayouts;
+    } else if constexpr (std::is_same_v<T, rhi::DescriptorSet>) {
+      return m_descriptorSets;
+    } else if constexpr (std::is_same_v<T, rhi::GraphicsPipeline>) {
+      return m_pipelines;
+    } else if constexpr (std::is_same_v<T, rhi::ComputePipeline>) {
+      return m_computePipelines;
+    } else if constexpr (std::is_same_v<T, rhi::RenderPass>) {
+      return m_renderPasses;
+    } else {
+      static_assert(std::is_same_v<T, rhi::Framebuffer>, "Resource type is not managed by RenderResourceManager");
+      return m_framebuffers;
+    }
+  }
+
+  ResourceStorage<rhi::Buffer>              m_buffers;
+  ResourceStorage<rhi::Texture>             m_textures;
+  ResourceStorage<rhi::Sampler>             m_samplers;
+  ResourceStorage<rhi::DescriptorSetLayout> m_descriptorSetLayouts;
+  ResourceStorage<rhi::DescriptorSet>       m_descriptorSets;
+  ResourceStorage<rhi::GraphicsPipeline>    m_pipelines;
+  ResourceStorage<rhi::ComputePipeline>     m_computePipelines;
+  ResourceStorage<rhi::RenderPass>          m_renderPasses;
+  ResourceStorage<rhi::Framebuffer>         m_framebuffers;
 };
 
 }  // namespace renderer
@@ -32,6 +32,13 @@ struct RenderSettings {
   PostProcessMode        postProcessMode         = PostProcessMode::None;
   math::Dimension2i      renderViewportDimension = math::Dimension2i(1, 1);
   arise::ApplicationMode appMode                 = arise::ApplicationMode::Standalone;
+  bool                   depthPrePass            = false;  // depth-only pass, base pass shades with depth EQUAL
+  bool                   indirectDraw            = false;  // base pass submits one multi-draw indirect per bucket
+  bool                   gpuCulling              = false;  // compute pass culls indirect draw instances
+  bool                   gpuOcclusionCulling     = true;   // GPU culling also tests the previous frame's depth
+  bool                   gpuCullingVerify        = false;  // compares GPU culling results with a CPU frustum test
+  bool                   softwareOcclusion       = false;  // CPU rasterized occluders cull base pass instances
+  bool                   softwareOcclusionView   = false;  // editor overlay with the CPU occlusion buffer
 };
 
 }  // namespace renderer
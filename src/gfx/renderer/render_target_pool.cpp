@@ -0,0 +1,64 @@
+#include "gfx/renderer/render_target_pool.h"
+
+#include "utils/resource/resource_deletion_manager.h"
+#include "utils/service/service_locator.h"
+
+#include <algorithm>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+bool RenderTargetPool::update(const math::Dimension2i& viewportDimension) {
+  const int32_t width  = std::max(viewportDimension.width(), 1);
+  const int32_t height = std::max(viewportDimension.height(), 1);
+
+  if (width == m_lastDimension_.width() && height == m_lastDimension_.height()) {
+    ++m_stableFrameCount_;
+  } else {
+    m_lastDimension_    = math::Dimension2i(width, height);
+    m_stableFrameCount_ = 0;
+  }
+
+  const int32_t bucketWidth  = s_getBucketSize(width);
+  const int32_t bucketHeight = s_getBucketSize(height);
+
+  // outgrown - reallocate now, without shrinking the other axis while the size still changes
+  if (width > m_allocatedDimension_.width() || height > m_allocatedDimension_.height()) {
+    m_allocatedDimension_ = math::Dimension2i(std::max(bucketWidth, m_allocatedDimension_.width()),
+                                              std::max(bucketHeight, m_allocatedDimension_.height()));
+    return true;
+  }
+
+  // fits a smaller bucket - shrink once the size settled
+  if (m_stableFrameCount_ == kStableFrames
+      && (bucketWidth != m_allocatedDimension_.width() || bucketHeight != m_allocatedDimension_.height())) {
+    m_allocatedDimension_ = math::Dimension2i(bucketWidth, bucketHeight);
+    return true;
+  }
+
+  return false;
+}
+
+void RenderTargetPool::reset() {
+  m_allocatedDimension_ = math::Dimension2i(0, 0);
+  m_lastDimension_      = math::Dimension2i(0, 0);
+  m_stableFrameCount_   = 0;
+}
+
+void RenderTargetPool::s_retire(std::unique_ptr<rhi::Texture> texture) {
+  if (!texture) {
+    return;
+  }
+
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (!deletionManager) {
+    return;
+  }
+
+  deletionManager->enqueueForDeletion(std::move(texture));
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
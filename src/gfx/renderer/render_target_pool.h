@@ -0,0 +1,60 @@
+#ifndef ARISE_RENDER_TARGET_POOL_H
+#define ARISE_RENDER_TARGET_POOL_H
+
+#include "gfx/rhi/interface/texture.h"
+#include "utils/math/math_util.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+/**
+ * Size policy of the per-frame color and depth targets while the viewport is resized.
+ *
+ * Targets are allocated in buckets (sizes rounded up to kBucketSize) and the passes render into the top-left
+ * viewport sized part of them (viewport / scissor), so a viewport that still fits doesn't touch the targets. They
+ * are reallocated when the viewport outgrows them, or - to give the memory back - when a smaller bucket fits and the
+ * viewport kept its size for kStableFrames frames (the user stopped dragging).
+ *
+ * Replaced targets are released with the frame delay of ResourceDeletionManager instead of draining the GPU.
+ */
+class RenderTargetPool {
+  public:
+  static constexpr int32_t  kBucketSize   = 128;
+  static constexpr uint32_t kStableFrames = 30;
+
+  /**
+   * Called every frame with the viewport size
+   *
+   * @return true if the targets have to be reallocated with getAllocatedDimension()
+   */
+  bool update(const math::Dimension2i& viewportDimension);
+
+  // size of the allocated targets, at least the viewport size
+  const math::Dimension2i& getAllocatedDimension() const { return m_allocatedDimension_; }
+
+  // the targets are gone (cleanup), the next update() allocates
+  void reset();
+
+  /**
+   * Releases a replaced target once the frames in flight that render into it are done
+   * (immediately without ResourceDeletionManager)
+   */
+  static void s_retire(std::unique_ptr<rhi::Texture> texture);
+
+  private:
+  static int32_t s_getBucketSize(int32_t size) { return (size + kBucketSize - 1) / kBucketSize * kBucketSize; }
+
+  math::Dimension2i m_allocatedDimension_ = math::Dimension2i(0, 0);
+  math::Dimension2i m_lastDimension_      = math::Dimension2i(0, 0);
+  uint32_t          m_stableFrameCount_   = 0;
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_RENDER_TARGET_POOL_H
@@ -19,6 +19,7 @@
 #include "utils/model/render_model_manager.h"
 #include "utils/resource/resource_deletion_manager.h"
 #include "utils/texture/texture_manager.h"
+#include "utils/time/frame_statistics.h"
 
 namespace arise {
 namespace gfx {
@@ -113,8 +114,15 @@ RenderContext Renderer::beginFrame(Scene* scene, const RenderSettings& renderSet
     auto  currentFrameIndex = frameManager->getCurrentFrameIndex();
     auto& fence             = m_frameFences[currentFrameIndex];
 
-    fence->wait();
+    {
+      ScopedFramePhase framePhase(FramePhase::GpuWait);
+      fence->wait();
+    }
     fence->reset();
+
+    // GPU is done with this frame slot, its transient constants and retired bindless slots can be reused
+    m_frameResources->getUploadRing()->beginFrame(currentFrameIndex);
+    m_frameResources->getBindlessMaterials()->beginFrame();
   }
 
   {
@@ -183,6 +191,7 @@ RenderContext Renderer::beginFrame(Scene* scene, const RenderSettings& renderSet
     context.viewportDimension = viewportDimension;
     context.renderSettings    = renderSettings;
     context.currentImageIndex = m_swapChain->getCurrentImageIndex();
+    context.currentFrameIndex = frameManager->getCurrentFrameIndex();
 
     m_frameResources->updatePerFrameResources(context);
 
@@ -217,10 +226,6 @@ void Renderer::renderFrame(RenderContext& context) {
   bool exclusiveMode
       = m_debugPass && context.renderSettings.renderMode != RenderMode::Solid && m_debugPass->isExclusive();
 
-  if (!exclusiveMode && m_basePass) {
-    m_basePass->render(context);
-  }
-
   auto isDebugPass = context.renderSettings.renderMode == RenderMode::Wireframe
                   || context.renderSettings.renderMode == RenderMode::ShaderOverdraw
                   || context.renderSettings.renderMode == RenderMode::VertexNormalVisualization
@@ -230,12 +235,82 @@ void Renderer::renderFrame(RenderContext& context) {
                   || context.renderSettings.renderMode == RenderMode::MeshHighlight
                   || context.renderSettings.renderMode == RenderMode::BoundingBoxVisualization;
 
+  m_renderGraph->reset();
+
+  // color and back buffer are imported, the scene depth lives only within the frame and is a transient texture
+  auto& renderTargets = m_frameResources->getRenderTargets(context.currentImageIndex);
+  auto  sceneColor    = m_renderGraph->importTexture("SceneColor", renderTargets.colorBuffer.get());
+  auto  backBuffer    = m_renderGraph->importTexture("BackBuffer", renderTargets.backBuffer);
+
+  RenderGraphResource sceneDepth;
+
+  if (!exclusiveMode && m_basePass) {
+    m_renderGraph->addPass(
+        "BasePass",
+        [&](RenderGraphBuilder& builder) {
+          sceneDepth = builder.create("SceneDepth", m_frameResources->getDepthBufferDesc());
+          builder.write(sceneColor, rhi::ResourceLayout::ColorAttachment);
+          builder.write(sceneDepth, rhi::ResourceLayout::DepthStencilAttachment);
+        },
+        [this](RenderContext& passContext) { m_basePass->render(passContext); });
+
+    if (m_basePass->isDepthPyramidNeeded(context)) {
+      m_renderGraph->addPass(
+          "DepthPyramid",
+          [&](RenderGraphBuilder& builder) {
+            builder.read(sceneDepth, rhi::ResourceLayout::ShaderReadOnly);
+            builder.setSideEffect();
+          },
+          [this, sceneDepth](RenderContext& passContext) {
+            m_basePass->renderDepthPyramid(passContext, m_renderGraph->getTexture(sceneDepth));
+          });
+    }
+  }
+
   if (m_debugPass && isDebugPass) {
-    m_debugPass->render(context);
+    m_renderGraph->addPass(
+        "DebugPass",
+        [&](RenderGraphBuilder& builder) {
+          // exclusive strategies clear the targets, the others draw over the base pass
+          if (!sceneDepth.isValid()) {
+            sceneDepth = builder.create("SceneDepth", m_frameResources->getDepthBufferDesc());
+          } else {
+            builder.read(sceneDepth, rhi::ResourceLayout::DepthStencilAttachment);
+          }
+          if (!exclusiveMode) {
+            builder.read(sceneColor, rhi::ResourceLayout::ColorAttachment);
+          }
+          builder.write(sceneColor, rhi::ResourceLayout::ColorAttachment);
+          builder.write(sceneDepth, rhi::ResourceLayout::DepthStencilAttachment);
+        },
+        [this](RenderContext& passContext) { m_debugPass->render(passContext); });
   }
 
-  if (m_finalPass && context.renderSettings.appMode == ApplicationMode::Standalone) {
-    m_finalPass->render(context);
+  if (m_finalPass) {
+    m_renderGraph->addPass(
+        "FinalPass",
+        [&](RenderGraphBuilder& builder) {
+          builder.read(sceneColor, rhi::ResourceLayout::TransferSrc);
+          builder.write(backBuffer, rhi::ResourceLayout::TransferDst);
+        },
+        [this](RenderContext& passContext) { m_finalPass->render(passContext); });
+  }
+
+  // the editor samples the scene color in its viewport, the final copy to the back buffer is culled there
+  if (context.renderSettings.appMode == ApplicationMode::Standalone) {
+    m_renderGraph->markOutput(backBuffer, rhi::ResourceLayout::PresentSrc);
+  } else {
+    m_renderGraph->markOutput(sceneColor, rhi::ResourceLayout::ShaderReadOnly);
+  }
+
+  if (m_renderGraph->compile(context.currentImageIndex)) {
+    // framebuffers reference the depth buffer, they are recreated when the graph placed a new one for the slot
+    if (sceneDepth.isValid()
+        && m_frameResources->setDepthBuffer(context.currentImageIndex, m_renderGraph->getTexture(sceneDepth))) {
+      const auto& viewport = m_frameResources->getViewport();
+      resizePasses_(math::Dimension2i(static_cast<int>(viewport.width), static_cast<int>(viewport.height)));
+    }
+    m_renderGraph->execute(context);
   }
 
   if (m_basePass) {
@@ -257,6 +332,8 @@ void Renderer::endFrame(RenderContext& context) {
     return;
   }
 
+  ScopedFramePhase framePhase(FramePhase::Present);
+
   {
     CPU_ZONE_NC("Collect GPU Profiler Data", color::PURPLE);
     GPU_ZONE_NC(context.commandBuffer.get(), "End Frame", color::PURPLE);
@@ -276,20 +353,14 @@ void Renderer::endFrame(RenderContext& context) {
   auto&    renderFinishedSemaphore = m_renderFinishedSemaphores[currentFrameIndex];
   {
     CPU_ZONE_NC("Prepare Semaphores", color::PURPLE);
-    std::vector<rhi::Semaphore*> waitSemaphores;
-    auto&                        imageAvailableSemaphore = m_imageAvailableSemaphores[currentFrameIndex];
-    if (imageAvailableSemaphore.get()) {
-      waitSemaphores.push_back(imageAvailableSemaphore.get());
-    }
+    rhi::Semaphore* waitSemaphore   = m_imageAvailableSemaphores[currentFrameIndex].get();
+    rhi::Semaphore* signalSemaphore = renderFinishedSemaphore.get();
 
-    std::vector<rhi::Semaphore*> signalSemaphores;
-
-    if (renderFinishedSemaphore.get()) {
-      signalSemaphores.push_back(renderFinishedSemaphore.get());
-    }
-
-    m_device->submitCommandBuffer(
-        context.commandBuffer.get(), m_frameFences[currentFrameIndex].get(), waitSemaphores, signalSemaphores);
+    // at most one semaphore each, an empty span when it doesn't exist
+    m_device->submitCommandBuffer(context.commandBuffer.get(),
+                                  m_frameFences[currentFrameIndex].get(),
+                                  std::span<rhi::Semaphore* const>(&waitSemaphore, waitSemaphore ? 1 : 0),
+                                  std::span<rhi::Semaphore* const>(&signalSemaphore, signalSemaphore ? 1 : 0));
   }
 
   {
@@ -310,65 +381,55 @@ bool Renderer::onWindowResize(uint32_t width, uint32_t height) {
     return false;
   }
 
-  m_frameResources->resize(math::Dimension2i(width, height));
-
-  if (m_basePass) {
-    m_basePass->resize(math::Dimension2i(width, height));
-  }
-
-  if (m_debugPass) {
-    m_debugPass->resize(math::Dimension2i(width, height));
-  }
-
-  if (m_finalPass) {
-    m_finalPass->resize(math::Dimension2i(width, height));
-  }
-
+  // render targets follow the viewport (onViewportResize() of the next frame)
   return true;
 }
 
 bool Renderer::onViewportResize(const math::Dimension2i& newDimension) {
-  const auto& currentViewport = m_frameResources->getViewport();
-
-  if (static_cast<int>(currentViewport.width) == newDimension.width()
-      && static_cast<int>(currentViewport.height) == newDimension.height()) {
-    return true;
-  }
-
-  m_device->waitIdle();
-
   auto width  = newDimension.width() > 0 ? newDimension.width() : 1;
   auto height = newDimension.height() > 0 ? newDimension.height() : 1;
 
-  LOG_INFO("Resizing viewport to {}x{}", width, height);
-
-  // this is not ideal solution, but it works for now
-  auto scene = ServiceLocator::s_get<SceneManager>()->getCurrentScene();
-  if (scene) {
-    auto& registry = scene->getEntityRegistry();
-    auto  view     = registry.view<ecs::Camera>();
-
-    if (!view.empty()) {
-      auto  entity  = view.front();
-      auto& camera  = view.get<ecs::Camera>(entity);
-      camera.width  = width;
-      camera.height = height;
+  const auto& currentViewport = m_frameResources->getViewport();
+  const bool  viewportChanged = static_cast<int>(currentViewport.width) != width
+                            || static_cast<int>(currentViewport.height) != height;
+
+  if (viewportChanged) {
+    LOG_DEBUG("Resizing viewport to {}x{}", width, height);
+
+    // this is not ideal solution, but it works for now
+    auto scene = ServiceLocator::s_get<SceneManager>()->getCurrentScene();
+    if (scene) {
+      auto& registry = scene->getEntityRegistry();
+      auto  view     = registry.view<ecs::Camera>();
+
+      if (!view.empty()) {
+        auto  entity  = view.front();
+        auto& camera  = view.get<ecs::Camera>(entity);
+        camera.width  = width;
+        camera.height = height;
+      }
     }
   }
 
-  m_frameResources->resize(math::Dimension2i(width, height));
+  // called every frame - the render targets are kept while the viewport fits into them, retired targets are
+  // released with the frame delay instead of waiting for the GPU
+  const bool targetsReallocated = m_frameResources->resize(math::Dimension2i(width, height));
 
-  if (m_basePass) {
-    m_basePass->resize(math::Dimension2i(width, height));
+  if (!viewportChanged && !targetsReallocated) {
+    return true;
   }
 
-  if (m_debugPass) {
-    m_debugPass->resize(math::Dimension2i(width, height));
+  if (targetsReallocated) {
+    const auto& targetDimension = m_frameResources->getRenderTargetDimension();
+    LOG_INFO("Render targets reallocated to {}x{} (viewport {}x{})",
+             targetDimension.width(),
+             targetDimension.height(),
+             width,
+             height);
   }
 
-  if (m_finalPass) {
-    m_finalPass->resize(math::Dimension2i(width, height));
-  }
+  // passes update their viewport, framebuffers are recreated only for reallocated targets
+  resizePasses_(math::Dimension2i(width, height));
 
   return true;
 }
@@ -486,16 +547,47 @@ void Renderer::setupRenderPasses_() {
 
   m_finalPass = std::make_unique<FinalPass>();
   m_finalPass->initialize(m_device.get(), getResourceManager(), m_frameResources.get(), m_shaderManager.get());
+
+  m_renderGraph = std::make_unique<RenderGraph>(m_device.get());
+
+  // later viewport changes come through onViewportResize()
+  const auto& viewport = m_frameResources->getViewport();
+  resizePasses_(math::Dimension2i(static_cast<int>(viewport.width), static_cast<int>(viewport.height)));
+}
+
+void Renderer::resizePasses_(const math::Dimension2i& dimension) {
+  if (m_basePass) {
+    m_basePass->resize(dimension);
+  }
+
+  if (m_debugPass) {
+    m_debugPass->resize(dimension);
+  }
+
+  if (m_finalPass) {
+    m_finalPass->resize(dimension);
+  }
 }
 
 void Renderer::cleanupResources_() {
   LOG_INFO("Cleaning up all rendering resources");
 
+  // the GPU is idle - resources retired with a frame delay go now, before the device they were created on
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (deletionManager) {
+    deletionManager->clearPendingDeletions();
+  }
+
   if (m_resourceManager) {
     m_resourceManager->clear();
     m_resourceManager.reset();
   }
 
+  if (m_renderGraph) {
+    m_renderGraph->cleanup();
+    m_renderGraph.reset();
+  }
+
   if (m_finalPass) {
     m_finalPass->cleanup();
     m_finalPass.reset();
@@ -6,6 +6,7 @@
 #include "gfx/renderer/passes/base_pass.h"
 #include "gfx/renderer/passes/debug_pass.h"
 #include "gfx/renderer/passes/final_pass.h"
+#include "gfx/renderer/render_graph.h"
 #include "gfx/renderer/render_resource_manager.h"
 #include "gfx/rhi/common/rhi_enums.h"
 #include "gfx/rhi/interface/command_buffer.h"
@@ -50,6 +51,7 @@ class Renderer {
   rhi::ShaderManager*    getShaderManager() const { return m_shaderManager.get(); }
   FrameResources*        getFrameResources() const { return m_frameResources.get(); }
   RenderResourceManager* getResourceManager() const { return m_resourceManager.get(); }
+  RenderGraph*           getRenderGraph() const { return m_renderGraph.get(); }
   gfx::rhi::RenderingApi getCurrentApi() const;
 
   void updateWindow(Window* window);
@@ -67,6 +69,9 @@ class Renderer {
 
   void setupRenderPasses_();
 
+  // updates the viewport of the passes, they recreate framebuffers whose render targets changed
+  void resizePasses_(const math::Dimension2i& dimension);
+
   void cleanupResources_();
   bool recreateResources_(gfx::rhi::RenderingApi newApi);
   void recreateResourceManagers_();
@@ -86,6 +91,9 @@ class Renderer {
   std::unique_ptr<FinalPass> m_finalPass;
   std::unique_ptr<DebugPass> m_debugPass;
 
+  // rebuilt every frame from the passes above
+  std::unique_ptr<RenderGraph> m_renderGraph;
+
   // one pool per frame in flight
   std::vector<std::vector<std::unique_ptr<rhi::CommandBuffer>>> m_commandBufferPools;
 
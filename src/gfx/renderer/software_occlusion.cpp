@@ -0,0 +1,496 @@
+#include "gfx/renderer/software_occlusion.h"
+
+#include "profiler/profiler.h"
+#include "utils/logger/log.h"
+#include "utils/thread/worker_pool.h"
+
+#ifdef ARISE_USE_MESHOPTIMIZER
+#include <meshoptimizer.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define ARISE_SOFTWARE_OCCLUSION_SSE
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+namespace {
+
+constexpr size_t kSimplifyMinTriangles = 256;    // smaller meshes are rasterized as they are
+constexpr size_t kSimplifyRatio        = 8;      // target triangle count = source / ratio
+constexpr float  kSimplifyError        = 0.01f;  // relative to the mesh extents
+constexpr size_t kMinTrianglesPerJob   = 1024;   // below that the rows are rasterized on the calling thread
+
+}  // namespace
+
+void SoftwareOcclusion::beginFrame(const math::Matrix4f<>& viewProjection) {
+  m_viewProjection_ = viewProjection;
+  m_occluders_.clear();
+  m_occluderTriangleCount_ = 0;
+
+  std::fill(m_depth_.begin(), m_depth_.end(), 1.0f);
+  std::fill(m_tileDepths_.begin(), m_tileDepths_.end(), 1.0f);
+}
+
+bool SoftwareOcclusion::addOccluder(const ecs::Mesh* mesh, const math::Matrix4f<>& worldMatrix) {
+  if (!mesh) {
+    return true;
+  }
+
+  const OccluderMesh& occluderMesh  = getOccluderMesh_(mesh);
+  const uint32_t      triangleCount = static_cast<uint32_t>(occluderMesh.indices.size() / 3);
+  if (triangleCount == 0) {
+    return true;
+  }
+
+  if (m_occluderTriangleCount_ + triangleCount > kMaxOccluderTriangles) {
+    return false;
+  }
+
+  m_occluders_.push_back({&occluderMesh, worldMatrix});
+  m_occluderTriangleCount_ += triangleCount;
+  return true;
+}
+
+void SoftwareOcclusion::rasterize() {
+  CPU_ZONE_NC("Rasterize Occluders", color::YELLOW);
+
+  setupTriangles_();
+  if (m_triangles_.empty()) {
+    return;
+  }
+
+  // each job owns a range of tile rows, so jobs never write the same pixels
+  size_t jobCount = 1;
+  if (m_triangles_.size() >= kMinTrianglesPerJob) {
+    const size_t maxJobs = std::min<size_t>(WorkerPool::s_get().getConcurrency(), kTilesY);
+    jobCount             = std::clamp<size_t>(m_triangles_.size() / kMinTrianglesPerJob, 1, maxJobs);
+  }
+  const uint32_t rowsPerJob = static_cast<uint32_t>((kTilesY + jobCount - 1) / jobCount);
+  const size_t   rowJobs    = (kTilesY + rowsPerJob - 1) / rowsPerJob;
+
+  WorkerPool::s_get().parallelFor(rowJobs, [this, rowsPerJob](size_t job) {
+    const uint32_t firstRow = static_cast<uint32_t>(job) * rowsPerJob;
+    rasterizeTileRows_(firstRow, std::min(firstRow + rowsPerJob, kTilesY));
+  });
+}
+
+bool SoftwareOcclusion::isVisible(const ecs::BoundingBox& worldBounds) const {
+  ScreenRect rect;
+  if (projectBounds_(worldBounds, rect) != Projection::Visible) {
+    // boxes at the camera can't be hidden, boxes off screen are left to frustum culling
+    return true;
+  }
+
+  const int32_t firstTileX = rect.minX / static_cast<int32_t>(kTileWidth);
+  const int32_t lastTileX  = rect.maxX / static_cast<int32_t>(kTileWidth);
+  const int32_t firstTileY = rect.minY / static_cast<int32_t>(kTileHeight);
+  const int32_t lastTileY  = rect.maxY / static_cast<int32_t>(kTileHeight);
+
+  for (int32_t tileY = firstTileY; tileY <= lastTileY; ++tileY) {
+    for (int32_t tileX = firstTileX; tileX <= lastTileX; ++tileX) {
+      // every pixel of the tile is in front of the box
+      if (m_tileDepths_[tileY * kTilesX + tileX] < rect.nearestDepth) {
+        continue;
+      }
+
+      const int32_t minX = std::max(rect.minX, tileX * static_cast<int32_t>(kTileWidth));
+      const int32_t maxX = std::min(rect.maxX, (tileX + 1) * static_cast<int32_t>(kTileWidth) - 1);
+      const int32_t minY = std::max(rect.minY, tileY * static_cast<int32_t>(kTileHeight));
+      const int32_t maxY = std::min(rect.maxY, (tileY + 1) * static_cast<int32_t>(kTileHeight) - 1);
+
+      for (int32_t y = minY; y <= maxY; ++y) {
+        const float* row = &m_depth_[y * kWidth];
+        for (int32_t x = minX; x <= maxX; ++x) {
+          if (row[x] >= rect.nearestDepth) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+float SoftwareOcclusion::getScreenCoverage(const ecs::BoundingBox& worldBounds) const {
+  ScreenRect rect;
+  switch (projectBounds_(worldBounds, rect)) {
+    case Projection::Crossing:
+      return 1.0f;
+    case Projection::Offscreen:
+      return 0.0f;
+    default:
+      return static_cast<float>((rect.maxX - rect.minX + 1) * (rect.maxY - rect.minY + 1))
+           / static_cast<float>(kWidth * kHeight);
+  }
+}
+
+void SoftwareOcclusion::clear() {
+  m_occluderMeshes_.clear();
+  m_occluders_.clear();
+  m_triangles_.clear();
+  m_occluderTriangleCount_ = 0;
+
+  std::fill(m_depth_.begin(), m_depth_.end(), 1.0f);
+  std::fill(m_tileDepths_.begin(), m_tileDepths_.end(), 1.0f);
+}
+
+const SoftwareOcclusion::OccluderMesh& SoftwareOcclusion::getOccluderMesh_(const ecs::Mesh* mesh) {
+  auto [it, inserted] = m_occluderMeshes_.try_emplace(mesh);
+  if (!inserted) {
+    return it->second;
+  }
+
+  CPU_ZONE_NC("Build Occluder Mesh", color::YELLOW);
+
+  OccluderMesh&         occluderMesh = it->second;
+  std::vector<uint32_t> indices(mesh->indices.begin(), mesh->indices.begin() + mesh->indices.size() / 3 * 3);
+
+  const size_t vertexCount = mesh->vertices.size();
+  if (std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; })) {
+    LOG_WARN("Occluder mesh {} has out of range indices, skipping", mesh->meshName);
+    indices.clear();
+  }
+
+#ifdef ARISE_USE_MESHOPTIMIZER
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount > kSimplifyMinTriangles) {
+    std::vector<float> positions;
+    positions.reserve(vertexCount * 3);
+    for (const auto& vertex : mesh->vertices) {
+      positions.insert(positions.end(), {vertex.position.x(), vertex.position.y(), vertex.position.z()});
+    }
+
+    // locked borders keep openings (doors, windows) from being closed by the simplification
+    const size_t          targetIndexCount = std::max(triangleCount / kSimplifyRatio, kSimplifyMinTriangles) * 3;
+    std::vector<uint32_t> simplified(indices.size());
+    float                 resultError = 0.0f;
+    simplified.resize(meshopt_simplify(simplified.data(),
+                                       indices.data(),
+                                       indices.size(),
+                                       positions.data(),
+                                       vertexCount,
+                                       sizeof(float) * 3,
+                                       targetIndexCount,
+                                       kSimplifyError,
+                                       meshopt_SimplifyLockBorder,
+                                       &resultError));
+
+    if (!simplified.empty()) {
+      indices.swap(simplified);
+    }
+  }
+#endif
+
+  // only vertices referenced by the occluder are transformed
+  std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+  for (uint32_t& index : indices) {
+    if (remap[index] == UINT32_MAX) {
+      const auto& position = mesh->vertices[index].position;
+      remap[index]         = static_cast<uint32_t>(occluderMesh.positions.size() / 3);
+      occluderMesh.positions.insert(occluderMesh.positions.end(), {position.x(), position.y(), position.z()});
+    }
+    index = remap[index];
+  }
+  occluderMesh.indices = std::move(indices);
+
+  LOG_DEBUG("Occluder mesh {}: {} of {} triangles",
+            mesh->meshName,
+            occluderMesh.indices.size() / 3,
+            mesh->indices.size() / 3);
+
+  return occluderMesh;
+}
+
+SoftwareOcclusion::Projection SoftwareOcclusion::projectBounds_(const ecs::BoundingBox& worldBounds,
+                                                                ScreenRect&             rect) const {
+  float minX         = std::numeric_limits<float>::max();
+  float minY         = std::numeric_limits<float>::max();
+  float maxX         = std::numeric_limits<float>::lowest();
+  float maxY         = std::numeric_limits<float>::lowest();
+  float nearestDepth = std::numeric_limits<float>::max();
+
+  for (uint32_t corner = 0; corner < 8; ++corner) {
+    math::Vector4f clipPosition((corner & 1) ? worldBounds.max.x() : worldBounds.min.x(),
+                                (corner & 2) ? worldBounds.max.y() : worldBounds.min.y(),
+                                (corner & 4) ? worldBounds.max.z() : worldBounds.min.z(),
+                                1.0f);
+    clipPosition *= m_viewProjection_;
+
+    // zero-to-one depth - in front of the near plane z >= 0
+    if (clipPosition.z() < 0.0f || clipPosition.w() <= 0.0f) {
+      return Projection::Crossing;
+    }
+
+    // NDC y points up, buffer rows go down
+    const float inverseW = 1.0f / clipPosition.w();
+    const float x        = (clipPosition.x() * inverseW * 0.5f + 0.5f) * kWidth;
+    const float y        = (0.5f - clipPosition.y() * inverseW * 0.5f) * kHeight;
+
+    minX         = std::min(minX, x);
+    maxX         = std::max(maxX, x);
+    minY         = std::min(minY, y);
+    maxY         = std::max(maxY, y);
+    nearestDepth = std::min(nearestDepth, clipPosition.z() * inverseW);
+  }
+
+  if (maxX < 0.0f || maxY < 0.0f || minX >= kWidth || minY >= kHeight || nearestDepth > 1.0f) {
+    return Projection::Offscreen;
+  }
+
+  // every pixel the rectangle touches
+  rect.minX         = static_cast<int32_t>(std::max(minX, 0.0f));
+  rect.maxX         = static_cast<int32_t>(std::min(maxX, kWidth - 1.0f));
+  rect.minY         = static_cast<int32_t>(std::max(minY, 0.0f));
+  rect.maxY         = static_cast<int32_t>(std::min(maxY, kHeight - 1.0f));
+  rect.nearestDepth = nearestDepth;
+  return Projection::Visible;
+}
+
+void SoftwareOcclusion::setupTriangles_() {
+  CPU_ZONE_NC("Setup Occluder Triangles", color::YELLOW);
+
+  m_triangles_.clear();
+  for (auto& bin : m_tileRowBins_) {
+    bin.clear();
+  }
+
+  for (const auto& occluder : m_occluders_) {
+    const OccluderMesh&    mesh                = *occluder.mesh;
+    const math::Matrix4f<> worldViewProjection = occluder.worldMatrix * m_viewProjection_;
+    const size_t           vertexCount         = mesh.positions.size() / 3;
+
+    // row vectors: clip = p * worldViewProjection
+    m_clipPositions_.resize(vertexCount * 4);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+      const float* position = &mesh.positions[vertex * 3];
+      float*       clip     = &m_clipPositions_[vertex * 4];
+      for (int column = 0; column < 4; ++column) {
+        clip[column] = position[0] * worldViewProjection(0, column) + position[1] * worldViewProjection(1, column)
+                     + position[2] * worldViewProjection(2, column) + worldViewProjection(3, column);
+      }
+    }
+
+    for (size_t index = 0; index + 2 < mesh.indices.size(); index += 3) {
+      const float* v0 = &m_clipPositions_[mesh.indices[index] * 4];
+      const float* v1 = &m_clipPositions_[mesh.indices[index + 1] * 4];
+      const float* v2 = &m_clipPositions_[mesh.indices[index + 2] * 4];
+
+      // whole triangle outside of one frustum plane (both faces are rasterized, no backface test)
+      auto outside = [&](int axis, float sign) {
+        return sign * v0[axis] > v0[3] && sign * v1[axis] > v1[3] && sign * v2[axis] > v2[3];
+      };
+      if (outside(0, -1.0f) || outside(0, 1.0f) || outside(1, -1.0f) || outside(1, 1.0f) || outside(2, 1.0f)) {
+        continue;
+      }
+
+      if (v0[2] < 0.0f || v1[2] < 0.0f || v2[2] < 0.0f) {
+        clipTriangle_(v0, v1, v2);
+      } else {
+        addScreenTriangle_(v0, v1, v2);
+      }
+    }
+  }
+}
+
+void SoftwareOcclusion::clipTriangle_(const float* v0, const float* v1, const float* v2) {
+  // one plane turns the triangle into a polygon of up to 4 vertices
+  const float* input[3] = {v0, v1, v2};
+  float        polygon[4][4];
+  uint32_t     vertexCount = 0;
+
+  for (uint32_t i = 0; i < 3; ++i) {
+    const float* a = input[i];
+    const float* b = input[(i + 1) % 3];
+
+    if (a[2] >= 0.0f) {
+      std::copy(a, a + 4, polygon[vertexCount++]);
+    }
+
+    if ((a[2] >= 0.0f) != (b[2] >= 0.0f)) {
+      const float t = a[2] / (a[2] - b[2]);
+      for (int component = 0; component < 4; ++component) {
+        polygon[vertexCount][component] = a[component] + (b[component] - a[component]) * t;
+      }
+      ++vertexCount;
+    }
+  }
+
+  for (uint32_t i = 1; i + 1 < vertexCount; ++i) {
+    addScreenTriangle_(polygon[0], polygon[i], polygon[i + 1]);
+  }
+}
+
+void SoftwareOcclusion::addScreenTriangle_(const float* v0, const float* v1, const float* v2) {
+  ScreenTriangle triangle;
+
+  const float* vertices[3] = {v0, v1, v2};
+  for (int i = 0; i < 3; ++i) {
+    if (vertices[i][3] <= 0.0f) {
+      return;
+    }
+
+    const float inverseW = 1.0f / vertices[i][3];
+    triangle.x[i]        = (vertices[i][0] * inverseW * 0.5f + 0.5f) * kWidth;
+    triangle.y[i]        = (0.5f - vertices[i][1] * inverseW * 0.5f) * kHeight;
+    triangle.z[i]        = vertices[i][2] * inverseW;
+  }
+
+  const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0])
+                   - (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+  if (std::abs(area) < 1e-6f) {
+    return;
+  }
+
+  // pixels whose center (x + 0.5, y + 0.5) is inside the bounding box of the triangle
+  const float minX = std::ceil(std::min({triangle.x[0], triangle.x[1], triangle.x[2]}) - 0.5f);
+  const float maxX = std::floor(std::max({triangle.x[0], triangle.x[1], triangle.x[2]}) - 0.5f);
+  const float minY = std::ceil(std::min({triangle.y[0], triangle.y[1], triangle.y[2]}) - 0.5f);
+  const float maxY = std::floor(std::max({triangle.y[0], triangle.y[1], triangle.y[2]}) - 0.5f);
+  if (minX > maxX || minY > maxY || maxX < 0.0f || maxY < 0.0f || minX > kWidth - 1.0f || minY > kHeight - 1.0f) {
+    return;
+  }
+
+  triangle.minX = static_cast<int32_t>(std::max(minX, 0.0f));
+  triangle.maxX = static_cast<int32_t>(std::min(maxX, kWidth - 1.0f));
+  triangle.minY = static_cast<int32_t>(std::max(minY, 0.0f));
+  triangle.maxY = static_cast<int32_t>(std::min(maxY, kHeight - 1.0f));
+
+  const uint32_t triangleIndex = static_cast<uint32_t>(m_triangles_.size());
+  m_triangles_.push_back(triangle);
+
+  for (int32_t tileRow = triangle.minY / static_cast<int32_t>(kTileHeight);
+       tileRow <= triangle.maxY / static_cast<int32_t>(kTileHeight);
+       ++tileRow) {
+    m_tileRowBins_[tileRow].push_back(triangleIndex);
+  }
+}
+
+void SoftwareOcclusion::rasterizeTileRows_(uint32_t firstTileRow, uint32_t lastTileRow) {
+  for (uint32_t tileRow = firstTileRow; tileRow < lastTileRow; ++tileRow) {
+    const int32_t firstRow = static_cast<int32_t>(tileRow * kTileHeight);
+    const int32_t lastRow  = firstRow + static_cast<int32_t>(kTileHeight) - 1;
+
+    for (uint32_t triangleIndex : m_tileRowBins_[tileRow]) {
+      rasterizeTriangle_(m_triangles_[triangleIndex], firstRow, lastRow);
+    }
+
+    // farthest depth of each tile - tests skip the pixels of tiles that are in front of the tested box
+    for (uint32_t tileX = 0; tileX < kTilesX; ++tileX) {
+      float farthestDepth = 0.0f;
+      for (int32_t y = firstRow; y <= lastRow; ++y) {
+        const float* row = &m_depth_[y * kWidth + tileX * kTileWidth];
+        farthestDepth    = std::max(farthestDepth, *std::max_element(row, row + kTileWidth));
+      }
+      m_tileDepths_[tileRow * kTilesX + tileX] = farthestDepth;
+    }
+  }
+}
+
+void SoftwareOcclusion::rasterizeTriangle_(const ScreenTriangle& triangle, int32_t firstRow, int32_t lastRow) {
+  const int32_t minY = std::max(triangle.minY, firstRow);
+  const int32_t maxY = std::min(triangle.maxY, lastRow);
+  if (minY > maxY) {
+    return;
+  }
+
+  // edge functions E(x, y) = a * x + b * y + c of the edges (i, i + 1), made positive inside
+  float edgeA[3];
+  float edgeB[3];
+  float edgeC[3];
+  for (int i = 0; i < 3; ++i) {
+    const int next = (i + 1) % 3;
+    edgeA[i]       = triangle.y[i] - triangle.y[next];
+    edgeB[i]       = triangle.x[next] - triangle.x[i];
+    edgeC[i]       = triangle.x[i] * triangle.y[next] - triangle.x[next] * triangle.y[i];
+  }
+
+  float area = edgeA[0] * triangle.x[2] + edgeB[0] * triangle.y[2] + edgeC[0];
+  if (area < 0.0f) {
+    for (int i = 0; i < 3; ++i) {
+      edgeA[i] = -edgeA[i];
+      edgeB[i] = -edgeB[i];
+      edgeC[i] = -edgeC[i];
+    }
+    area = -area;
+  }
+
+  // depth plane z(x, y) = a * x + b * y + c - edge i weights the vertex opposite to it
+  float depthA = 0.0f;
+  float depthB = 0.0f;
+  float depthC = 0.0f;
+  for (int i = 0; i < 3; ++i) {
+    const float weight  = triangle.z[(i + 2) % 3] / area;
+    depthA             += edgeA[i] * weight;
+    depthB             += edgeB[i] * weight;
+    depthC             += edgeC[i] * weight;
+  }
+
+  // groups of 4 pixels stay inside the row - the buffer width is a multiple of 4
+  const int32_t firstX = triangle.minX & ~3;
+
+#ifdef ARISE_SOFTWARE_OCCLUSION_SSE
+  const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+  const __m128 zero         = _mm_setzero_ps();
+  const __m128 edgeA0       = _mm_set1_ps(edgeA[0]);
+  const __m128 edgeA1       = _mm_set1_ps(edgeA[1]);
+  const __m128 edgeA2       = _mm_set1_ps(edgeA[2]);
+  const __m128 depthAx      = _mm_set1_ps(depthA);
+#endif
+
+  for (int32_t y = minY; y <= maxY; ++y) {
+    const float centerY = static_cast<float>(y) + 0.5f;
+    const float row0    = edgeB[0] * centerY + edgeC[0];
+    const float row1    = edgeB[1] * centerY + edgeC[1];
+    const float row2    = edgeB[2] * centerY + edgeC[2];
+    const float rowZ    = depthB * centerY + depthC;
+    float*      row     = &m_depth_[y * kWidth];
+
+#ifdef ARISE_SOFTWARE_OCCLUSION_SSE
+    const __m128 rowEdge0 = _mm_set1_ps(row0);
+    const __m128 rowEdge1 = _mm_set1_ps(row1);
+    const __m128 rowEdge2 = _mm_set1_ps(row2);
+    const __m128 rowDepth = _mm_set1_ps(rowZ);
+
+    for (int32_t x = firstX; x <= triangle.maxX; x += 4) {
+      const __m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), pixelOffsets);
+
+      const __m128 edge0  = _mm_add_ps(_mm_mul_ps(edgeA0, centerX), rowEdge0);
+      const __m128 edge1  = _mm_add_ps(_mm_mul_ps(edgeA1, centerX), rowEdge1);
+      const __m128 edge2  = _mm_add_ps(_mm_mul_ps(edgeA2, centerX), rowEdge2);
+      const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)),
+                                       _mm_cmpge_ps(edge2, zero));
+      if (_mm_movemask_ps(inside) == 0) {
+        continue;
+      }
+
+      const __m128 depth   = _mm_max_ps(_mm_add_ps(_mm_mul_ps(depthAx, centerX), rowDepth), zero);
+      const __m128 current = _mm_loadu_ps(row + x);
+      const __m128 nearest = _mm_min_ps(current, depth);
+      _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+    }
+#else
+    for (int32_t x = firstX; x <= triangle.maxX; ++x) {
+      const float centerX = static_cast<float>(x) + 0.5f;
+      if (edgeA[0] * centerX + row0 < 0.0f || edgeA[1] * centerX + row1 < 0.0f || edgeA[2] * centerX + row2 < 0.0f) {
+        continue;
+      }
+
+      const float depth = std::max(depthA * centerX + rowZ, 0.0f);
+      row[x]            = std::min(row[x], depth);
+    }
+#endif
+  }
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
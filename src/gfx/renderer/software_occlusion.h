@@ -0,0 +1,160 @@
+#ifndef ARISE_SOFTWARE_OCCLUSION_H
+#define ARISE_SOFTWARE_OCCLUSION_H
+
+#include "ecs/components/bounding_volume.h"
+#include "ecs/components/mesh.h"
+#include "utils/math/math_util.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+/**
+ * Occlusion culling on the CPU against a low resolution depth buffer filled by a software rasterizer.
+ *
+ * Occluders (large opaque meshes, simplified with meshoptimizer when it is available) are rasterized into a
+ * kWidth x kHeight buffer that keeps the nearest occluder depth of each pixel. The buffer is split into tiles of
+ * kTileWidth x kTileHeight pixels that store the farthest depth of their pixels - a candidate box is compared with
+ * the tiles under its screen rectangle first and only tiles that don't hide it on their own are resolved per pixel.
+ *
+ * Triangles are binned into tile rows, the rows are rasterized on worker threads 4 pixels at a time (SSE when the
+ * target has it). Only pixels whose center is inside a triangle are covered, so the buffer doesn't report more
+ * occlusion than the occluders provide (up to the simplification error).
+ */
+class SoftwareOcclusion {
+  public:
+  static constexpr uint32_t kWidth      = 256;
+  static constexpr uint32_t kHeight     = 144;
+  static constexpr uint32_t kTileWidth  = 32;
+  static constexpr uint32_t kTileHeight = 8;
+  static constexpr uint32_t kTilesX     = kWidth / kTileWidth;
+  static constexpr uint32_t kTilesY     = kHeight / kTileHeight;
+
+  // triangles rasterized per frame, occluders past the budget are skipped
+  static constexpr uint32_t kMaxOccluderTriangles = 64 * 1024;
+
+  // part of the screen a mesh has to cover to be picked as an occluder without ecs::OccluderTag
+  static constexpr float kMinOccluderCoverage = 0.02f;
+
+  static_assert(kWidth % kTileWidth == 0 && kHeight % kTileHeight == 0, "buffer must consist of whole tiles");
+  static_assert(kTileWidth % 4 == 0, "rows are rasterized 4 pixels at a time");
+
+  /**
+   * Clears the buffer, following occluders and tests use the given view
+   */
+  void beginFrame(const math::Matrix4f<>& viewProjection);
+
+  /**
+   * Queues a mesh for rasterize(), its simplified geometry is built on first use and cached
+   *
+   * @return false if the triangle budget of the frame is exhausted - the mesh is skipped
+   */
+  bool addOccluder(const ecs::Mesh* mesh, const math::Matrix4f<>& worldMatrix);
+
+  /**
+   * Rasterizes the queued occluders, tests are valid afterwards
+   */
+  void rasterize();
+
+  /**
+   * @return false if the box is hidden behind the rasterized occluders
+   */
+  bool isVisible(const ecs::BoundingBox& worldBounds) const;
+
+  /**
+   * Part of the screen covered by the screen rectangle of the box (0 - 1), 1 if the box reaches the camera
+   */
+  float getScreenCoverage(const ecs::BoundingBox& worldBounds) const;
+
+  // drops the cached occluder geometry (scene switch - the source meshes are about to be released)
+  void clear();
+
+  // nearest occluder depth of each pixel (row major, first row at the top), 1 where nothing was rasterized
+  const std::vector<float>& getDepthBuffer() const { return m_depth_; }
+
+  // farthest depth of each tile (row major)
+  const std::vector<float>& getTileDepths() const { return m_tileDepths_; }
+
+  uint32_t getOccluderCount() const { return static_cast<uint32_t>(m_occluders_.size()); }
+
+  uint32_t getOccluderTriangleCount() const { return m_occluderTriangleCount_; }
+
+  private:
+  // occluder geometry in mesh local space, only vertices referenced by the (simplified) indices
+  struct OccluderMesh {
+    std::vector<float>    positions;  // xyz
+    std::vector<uint32_t> indices;
+  };
+
+  struct Occluder {
+    const OccluderMesh* mesh = nullptr;
+    math::Matrix4f<>    worldMatrix;
+  };
+
+  // triangle after projection, positions in buffer pixels
+  struct ScreenTriangle {
+    float   x[3];
+    float   y[3];
+    float   z[3];
+    int32_t minX = 0;
+    int32_t maxX = 0;
+    int32_t minY = 0;
+    int32_t maxY = 0;
+  };
+
+  // pixel rectangle (inclusive) and nearest depth of a box
+  struct ScreenRect {
+    int32_t minX         = 0;
+    int32_t maxX         = 0;
+    int32_t minY         = 0;
+    int32_t maxY         = 0;
+    float   nearestDepth = 0.0f;
+  };
+
+  enum class Projection {
+    Visible,    // rect is valid
+    Offscreen,  // no pixel of the buffer is covered
+    Crossing,   // box crosses the near plane, its rect is unbounded
+  };
+
+  const OccluderMesh& getOccluderMesh_(const ecs::Mesh* mesh);
+
+  Projection projectBounds_(const ecs::BoundingBox& worldBounds, ScreenRect& rect) const;
+
+  // clip space vertices of all occluders to binned screen triangles
+  void setupTriangles_();
+
+  // splits a triangle at the near plane (clip z = 0), vertices in clip space (xyzw)
+  void clipTriangle_(const float* v0, const float* v1, const float* v2);
+
+  void addScreenTriangle_(const float* v0, const float* v1, const float* v2);
+
+  // rasterizes the triangles of the tile rows [firstTileRow, lastTileRow) and updates their tile depths
+  void rasterizeTileRows_(uint32_t firstTileRow, uint32_t lastTileRow);
+
+  void rasterizeTriangle_(const ScreenTriangle& triangle, int32_t firstRow, int32_t lastRow);
+
+  std::unordered_map<const ecs::Mesh*, OccluderMesh> m_occluderMeshes_;
+
+  math::Matrix4f<>      m_viewProjection_ = math::Matrix4f<>::Identity();
+  std::vector<Occluder> m_occluders_;
+  uint32_t              m_occluderTriangleCount_ = 0;
+
+  std::vector<float> m_depth_      = std::vector<float>(kWidth * kHeight, 1.0f);
+  std::vector<float> m_tileDepths_ = std::vector<float>(kTilesX * kTilesY, 1.0f);
+
+  // per frame scratch
+  std::vector<float>                 m_clipPositions_;  // xyzw
+  std::vector<ScreenTriangle>        m_triangles_;
+  std::vector<std::vector<uint32_t>> m_tileRowBins_ = std::vector<std::vector<uint32_t>>(kTilesY);
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_SOFTWARE_OCCLUSION_H
@@ -0,0 +1,95 @@
+#include "gfx/renderer/upload_ring.h"
+
+#include "gfx/renderer/render_resource_manager.h"
+#include "utils/logger/log.h"
+#include "utils/memory/align.h"
+
+#include <algorithm>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+UploadRing::UploadRing(rhi::Device* device, RenderResourceManager* resourceManager)
+    : m_device_(device)
+    , m_resourceManager_(resourceManager) {
+}
+
+bool UploadRing::initialize(uint32_t framesInFlight, uint64_t bytesPerFrame) {
+  if (framesInFlight == 0 || bytesPerFrame == 0) {
+    LOG_ERROR("Invalid upload ring parameters");
+    return false;
+  }
+
+  m_framesInFlight_ = framesInFlight;
+  m_bytesPerFrame_  = alignConstantBufferSize(bytesPerFrame);
+
+  rhi::BufferDesc bufferDesc;
+  bufferDesc.size        = m_bytesPerFrame_ * m_framesInFlight_;
+  bufferDesc.createFlags = rhi::BufferCreateFlag::CpuAccess | rhi::BufferCreateFlag::ConstantBuffer
+                         | rhi::BufferCreateFlag::IndirectCommand;
+  bufferDesc.type        = rhi::BufferType::Dynamic;
+  bufferDesc.debugName   = "upload_ring_buffer";
+
+  auto buffer = m_device_->createBuffer(bufferDesc);
+  if (!buffer || !buffer->getMappedData()) {
+    LOG_ERROR("Failed to create persistently mapped upload ring buffer");
+    return false;
+  }
+
+  m_mappedData_ = static_cast<uint8_t*>(buffer->getMappedData());
+  m_buffer_     = m_resourceManager_->addBuffer(std::move(buffer), "upload_ring_buffer");
+
+  beginFrame(0);
+  return true;
+}
+
+void UploadRing::cleanup() {
+  // buffer is owned by the resource manager
+  m_buffer_         = nullptr;
+  m_mappedData_     = nullptr;
+  m_framesInFlight_ = 0;
+  m_bytesPerFrame_  = 0;
+  m_regionBegin_    = 0;
+  m_regionEnd_      = 0;
+  m_head_           = 0;
+}
+
+void UploadRing::beginFrame(uint32_t frameIndex) {
+  if (m_framesInFlight_ == 0) {
+    return;
+  }
+
+  m_peakUsedBytes_ = std::max(m_peakUsedBytes_, getUsedBytes());
+
+  m_regionBegin_ = (frameIndex % m_framesInFlight_) * m_bytesPerFrame_;
+  m_regionEnd_   = m_regionBegin_ + m_bytesPerFrame_;
+  m_head_        = m_regionBegin_;
+}
+
+UploadRing::Allocation UploadRing::allocate(uint64_t size) {
+  const uint64_t alignedSize = alignConstantBufferSize(size);
+
+  if (!m_mappedData_ || size == 0 || m_head_ + alignedSize > m_regionEnd_) {
+    if (m_mappedData_ && size != 0 && !m_overflowReported_) {
+      LOG_ERROR("Upload ring frame region overflow ({} of {} bytes used, {} requested)",
+                getUsedBytes(),
+                m_bytesPerFrame_,
+                alignedSize);
+      m_overflowReported_ = true;
+    }
+    return {};
+  }
+
+  Allocation allocation;
+  allocation.cpuAddress = m_mappedData_ + m_head_;
+  allocation.buffer     = m_buffer_;
+  allocation.offset     = static_cast<uint32_t>(m_head_);
+
+  m_head_ += alignedSize;
+  return allocation;
+}
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
@@ -0,0 +1,95 @@
+#ifndef ARISE_UPLOAD_RING_H
+#define ARISE_UPLOAD_RING_H
+
+#include "gfx/rhi/interface/buffer.h"
+#include "gfx/rhi/interface/device.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace arise {
+namespace gfx {
+namespace renderer {
+
+class RenderResourceManager;
+
+/**
+ * Linear allocator for transient per-frame data (view constants, per-draw parameters, indirect draw arguments, etc.).
+ *
+ * One persistently mapped buffer is split into a region per frame in flight. Allocations bump an offset inside
+ * the region of the current frame, the region is recycled in beginFrame() - call it only after the fence of
+ * that frame was waited on, so the GPU no longer reads the data that gets overwritten.
+ *
+ * Allocations are 256-byte aligned, so the returned offset can be used directly as a dynamic offset for
+ * UniformbufferDynamic bindings.
+ */
+class UploadRing {
+  public:
+  // fits the indirect arguments of ~40k draws next to the constants
+  static constexpr uint64_t kDefaultBytesPerFrame = 1024 * 1024;
+
+  struct Allocation {
+    void*        cpuAddress = nullptr;
+    rhi::Buffer* buffer     = nullptr;
+    uint32_t     offset     = 0;  // byte offset from the start of the buffer
+
+    bool isValid() const { return cpuAddress != nullptr; }
+  };
+
+  UploadRing(rhi::Device* device, RenderResourceManager* resourceManager);
+
+  bool initialize(uint32_t framesInFlight, uint64_t bytesPerFrame = kDefaultBytesPerFrame);
+
+  void cleanup();
+
+  /**
+   * Recycles the region of the given frame, everything allocated from it before is invalid afterwards
+   */
+  void beginFrame(uint32_t frameIndex);
+
+  /**
+   * @return writable memory for the current frame or an invalid allocation if the frame region is full
+   */
+  Allocation allocate(uint64_t size);
+
+  template <typename T>
+  Allocation upload(const T& data) {
+    Allocation allocation = allocate(sizeof(T));
+    if (allocation.isValid()) {
+      std::memcpy(allocation.cpuAddress, &data, sizeof(T));
+    }
+    return allocation;
+  }
+
+  rhi::Buffer* getBuffer() const { return m_buffer_; }
+
+  uint64_t getBytesPerFrame() const { return m_bytesPerFrame_; }
+
+  // bytes allocated from the current frame region
+  uint64_t getUsedBytes() const { return m_head_ - m_regionBegin_; }
+
+  // largest getUsedBytes() seen since initialization - useful to tune bytesPerFrame
+  uint64_t getPeakUsedBytes() const { return m_peakUsedBytes_; }
+
+  private:
+  rhi::Device*           m_device_          = nullptr;
+  RenderResourceManager* m_resourceManager_ = nullptr;
+
+  rhi::Buffer* m_buffer_     = nullptr;
+  uint8_t*     m_mappedData_ = nullptr;
+
+  uint32_t m_framesInFlight_ = 0;
+  uint64_t m_bytesPerFrame_  = 0;
+  uint64_t m_regionBegin_    = 0;
+  uint64_t m_regionEnd_      = 0;
+  uint64_t m_head_           = 0;
+  uint64_t m_peakUsedBytes_  = 0;
+
+  bool m_overflowReported_ = false;
+};
+
+}  // namespace renderer
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_UPLOAD_RING_H
@@ -6,6 +6,8 @@
 #include "utils/logger/log.h"
 #include "utils/memory/align.h"
 
+#include <algorithm>
+
 namespace arise {
 namespace gfx {
 namespace rhi {
@@ -67,6 +69,16 @@ BufferDx12::BufferDx12(const BufferDesc& desc, DeviceDx12* device)
     } else {
       m_isMapped_ = true;
     }
+  } else if (isReadbackHeapBuffer_()) {
+    // readback buffers stay mapped too - the CPU reads them once the copying frame's fence was waited
+    hr = m_resource_->Map(0, nullptr, &m_mappedData_);
+
+    if (FAILED(hr)) {
+      LOG_ERROR("Failed to map readback buffer memory");
+      m_mappedData_ = nullptr;
+    } else {
+      m_isMapped_ = true;
+    }
   }
 
   if (!desc.debugName.empty() && m_resource_) {
@@ -316,8 +328,10 @@ void DescriptorBufferDx12::createConstantBufferView() {
   D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
   cbvDesc.BufferLocation                  = m_resource_->GetGPUVirtualAddress();
 
-  // Size must be aligned to 256 bytes for constant buffers
-  cbvDesc.SizeInBytes = alignConstantBufferSize(m_desc_.size);
+  // Size must be aligned to 256 bytes for constant buffers, a single view can't exceed 64KB (larger buffers
+  // like the per-frame upload ring are addressed through root CBVs with an offset instead)
+  constexpr uint64_t kMaxCbvSize = D3D12_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16;
+  cbvDesc.SizeInBytes            = static_cast<UINT>(std::min(alignConstantBufferSize(m_desc_.size), kMaxCbvSize));
 
   m_device_->getDevice()->CreateConstantBufferView(&cbvDesc, m_cbvCpuHandle_);
 }
@@ -344,14 +358,22 @@ void DescriptorBufferDx12::createUnorderedAccessView() {
   m_uavCpuHandle_ = cpuHeap->getCpuHandle(m_uavDescriptorIndex_);
 
   D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-  uavDesc.Format                           = DXGI_FORMAT_UNKNOWN;
   uavDesc.ViewDimension                    = D3D12_UAV_DIMENSION_BUFFER;
   uavDesc.Buffer.FirstElement              = 0;
-  // Size in bytes / 4 bytes per element (estimate)
-  uavDesc.Buffer.NumElements          = static_cast<UINT>(m_desc_.size / 4);
-  uavDesc.Buffer.StructureByteStride  = 0;
-  uavDesc.Buffer.CounterOffsetInBytes = 0;
-  uavDesc.Buffer.Flags                = D3D12_BUFFER_UAV_FLAG_NONE;
+  uavDesc.Buffer.CounterOffsetInBytes      = 0;
+  if (m_desc_.stride > 0) {
+    // Structured Buffer
+    uavDesc.Format                     = DXGI_FORMAT_UNKNOWN;
+    uavDesc.Buffer.StructureByteStride = m_desc_.stride;
+    uavDesc.Buffer.NumElements         = static_cast<UINT>(m_desc_.size / m_desc_.stride);
+    uavDesc.Buffer.Flags               = D3D12_BUFFER_UAV_FLAG_NONE;
+  } else {
+    // Raw Buffer (RWByteAddressBuffer) - 4 byte elements
+    uavDesc.Format                     = DXGI_FORMAT_R32_TYPELESS;
+    uavDesc.Buffer.StructureByteStride = 0;
+    uavDesc.Buffer.NumElements         = static_cast<UINT>(m_desc_.size / 4);
+    uavDesc.Buffer.Flags               = D3D12_BUFFER_UAV_FLAG_RAW;
+  }
 
   m_device_->getDevice()->CreateUnorderedAccessView(m_resource_.Get(), nullptr, &uavDesc, m_uavCpuHandle_);
 }
@@ -377,23 +399,23 @@ void DescriptorBufferDx12::createShaderResourceView() {
   m_srvCpuHandle_ = cpuHeap->getCpuHandle(m_srvDescriptorIndex_);
 
   D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-  srvDesc.Format                          = DXGI_FORMAT_UNKNOWN;
   srvDesc.ViewDimension                   = D3D12_SRV_DIMENSION_BUFFER;
   srvDesc.Shader4ComponentMapping         = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
   srvDesc.Buffer.FirstElement             = 0;
   if (m_desc_.stride > 0) {
     // Structured Buffer
+    srvDesc.Format                     = DXGI_FORMAT_UNKNOWN;
     srvDesc.Buffer.StructureByteStride = m_desc_.stride;
     srvDesc.Buffer.NumElements         = static_cast<UINT>(m_desc_.size / m_desc_.stride);
+    srvDesc.Buffer.Flags               = D3D12_BUFFER_SRV_FLAG_NONE;
   } else {
-    // Raw Buffer
+    // Raw Buffer (ByteAddressBuffer) - 4 byte elements
+    srvDesc.Format                     = DXGI_FORMAT_R32_TYPELESS;
     srvDesc.Buffer.StructureByteStride = 0;
-    // Size in bytes / 4 bytes per element (estimate)
-    srvDesc.Buffer.NumElements = static_cast<UINT>(m_desc_.size / 4);
+    srvDesc.Buffer.NumElements         = static_cast<UINT>(m_desc_.size / 4);
+    srvDesc.Buffer.Flags               = D3D12_BUFFER_SRV_FLAG_RAW;
   }
 
-  srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-
   m_device_->getDevice()->CreateShaderResourceView(m_resource_.Get(), &srvDesc, m_srvCpuHandle_);
 }
 
@@ -36,12 +36,13 @@ class BufferDx12 : public Buffer {
 
   bool isMapped() const { return m_isMapped_; }
 
-  void* getMappedData() const { return m_mappedData_; }
+  void* getMappedData() const override { return m_mappedData_; }
 
   D3D12MA::Allocation* getAllocation() const { return m_allocation_.Get(); }
 
   protected:
   friend class DeviceDx12;
+  friend class CommandBufferDx12;  // skips barriers of upload / readback heap buffers
   // update_ method is called from DeviceDx12
   bool update_(const void* data, size_t size, size_t offset);
 
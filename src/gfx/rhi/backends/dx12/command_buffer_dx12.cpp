@@ -15,6 +15,7 @@
 #include "utils/logger/log.h"
 
 #include <algorithm>
+#include <cstddef>
 
 #if defined(USE_PIX)
 #include <pix3.h>
@@ -30,15 +31,17 @@ namespace rhi {
 
 CommandBufferDx12::CommandBufferDx12(DeviceDx12*                       device,
                                      ComPtr<ID3D12GraphicsCommandList> commandList,
-                                     ID3D12CommandAllocator*           commandAllocator)
+                                     ID3D12CommandAllocator*           commandAllocator,
+                                     QueueType                         queueType)
     : m_device_(device)
     , m_commandList_(std::move(commandList))
-    , m_commandAllocator_(commandAllocator) {
+    , m_commandAllocator_(commandAllocator)
+    , m_queueType_(queueType) {
 }
 
 CommandBufferDx12::~CommandBufferDx12() {
   if (m_device_ && m_commandAllocator_) {
-    m_device_->returnCommandAllocator(m_commandAllocator_);
+    m_device_->returnCommandAllocator(m_commandAllocator_, m_queueType_);
     m_commandAllocator_ = nullptr;
   }
 }
@@ -89,10 +92,11 @@ void CommandBufferDx12::reset() {
     return;
   }
 
-  m_currentPipeline_    = nullptr;
-  m_currentRenderPass_  = nullptr;
-  m_currentFramebuffer_ = nullptr;
-  m_isRenderPassActive_ = false;
+  m_currentPipeline_       = nullptr;
+  m_pushConstantRootIndex_ = 0;
+  m_currentRenderPass_     = nullptr;
+  m_currentFramebuffer_    = nullptr;
+  m_isRenderPassActive_    = false;
 }
 
 void CommandBufferDx12::setPipeline(Pipeline* pipeline) {
@@ -101,17 +105,21 @@ void CommandBufferDx12::setPipeline(Pipeline* pipeline) {
     return;
   }
 
-  auto pipelineDx12 = dynamic_cast<GraphicsPipelineDx12*>(pipeline);
-  if (!pipelineDx12) {
-    LOG_ERROR("Invalid pipeline type");
+  if (!pipeline) {
+    LOG_ERROR("Null pipeline");
     return;
   }
 
-  m_commandList_->SetPipelineState(pipelineDx12->getPipelineState());  // PSO
-
   // root signature (graphics / compute)
-  auto pipelineType = pipelineDx12->getType();
+  auto pipelineType = pipeline->getType();
   if (pipelineType == PipelineType::Graphics) {
+    auto pipelineDx12 = dynamic_cast<GraphicsPipelineDx12*>(pipeline);
+    if (!pipelineDx12 || m_queueType_ != QueueType::Graphics) {
+      LOG_ERROR("Invalid graphics pipeline type or queue");
+      return;
+    }
+
+    m_commandList_->SetPipelineState(pipelineDx12->getPipelineState());  // PSO
     m_commandList_->SetGraphicsRootSignature(pipelineDx12->getRootSignature());
 
     m_commandList_->OMSetBlendFactor(pipelineDx12->getBlendFactors().data());
@@ -131,11 +139,22 @@ void CommandBufferDx12::setPipeline(Pipeline* pipeline) {
     D3D_PRIMITIVE_TOPOLOGY topology = g_getPrimitiveTopologyDx12(pipelineDx12->getPrimitiveType());
     m_commandList_->IASetPrimitiveTopology(topology);
 
+    m_pushConstantRootIndex_ = pipelineDx12->getPushConstantRootIndex();
+
   } else if (pipelineType == PipelineType::Compute) {
+    auto pipelineDx12 = dynamic_cast<ComputePipelineDx12*>(pipeline);
+    if (!pipelineDx12) {
+      LOG_ERROR("Invalid compute pipeline type");
+      return;
+    }
+
+    m_commandList_->SetPipelineState(pipelineDx12->getPipelineState());  // PSO
     m_commandList_->SetComputeRootSignature(pipelineDx12->getRootSignature());
+
+    m_pushConstantRootIndex_ = pipelineDx12->getPushConstantRootIndex();
   }
 
-  m_currentPipeline_ = pipelineDx12;
+  m_currentPipeline_ = pipeline;
 }
 
 void CommandBufferDx12::setViewport(const Viewport& viewport) {
@@ -220,6 +239,12 @@ void CommandBufferDx12::bindIndexBuffer(Buffer* buffer, uint64_t offset, bool us
 }
 
 void CommandBufferDx12::bindDescriptorSet(uint32_t rootParameterIndex, DescriptorSet* set) {
+  bindDescriptorSet(rootParameterIndex, set, {});
+}
+
+void CommandBufferDx12::bindDescriptorSet(uint32_t                     rootParameterIndex,
+                                          DescriptorSet*               set,
+                                          const std::vector<uint32_t>& dynamicOffsets) {
   if (!m_isRecording_) {
     LOG_ERROR("Command buffer is not recording");
     return;
@@ -242,6 +267,23 @@ void CommandBufferDx12::bindDescriptorSet(uint32_t rootParameterIndex, Descripto
     return;
   }
 
+  if (descriptorSetLayoutDx12->isRootConstantBuffer()) {
+    D3D12_GPU_VIRTUAL_ADDRESS address = descriptorSetDx12->getRootConstantBufferAddress();
+    if (!dynamicOffsets.empty()) {
+      address += dynamicOffsets[0];
+    }
+
+    switch (m_currentPipeline_->getType()) {
+      case PipelineType::Graphics:
+        m_commandList_->SetGraphicsRootConstantBufferView(rootParameterIndex, address);
+        break;
+      case PipelineType::Compute:
+        m_commandList_->SetComputeRootConstantBufferView(rootParameterIndex, address);
+        break;
+    }
+    return;
+  }
+
   // true - sampler, false - srv/cbv/uav
   auto isSampler = descriptorSetLayoutDx12->isSamplerLayout();
 
@@ -253,7 +295,6 @@ void CommandBufferDx12::bindDescriptorSet(uint32_t rootParameterIndex, Descripto
   } else {
     gpuHandle = descriptorSetDx12->getGpuSrvUavCbvHandle(currentFrameIndex);
   }
-  m_commandList_->SetGraphicsRootDescriptorTable(rootParameterIndex, gpuHandle);
 
   switch (m_currentPipeline_->getType()) {
     case PipelineType::Graphics:
@@ -265,6 +306,37 @@ void CommandBufferDx12::bindDescriptorSet(uint32_t rootParameterIndex, Descripto
   }
 }
 
+void CommandBufferDx12::pushConstants(const void* data, uint32_t size, uint32_t offset) {
+  if (!m_isRecording_) {
+    LOG_ERROR("Command buffer is not recording");
+    return;
+  }
+
+  if (!m_currentPipeline_) {
+    LOG_ERROR("No active pipeline");
+    return;
+  }
+
+  if (offset + size > m_currentPipeline_->getPushConstantSize() || (size | offset) % 4 != 0) {
+    LOG_ERROR("Push constant range [{}, {}) doesn't match the {} bytes block of the current pipeline",
+              offset,
+              offset + size,
+              m_currentPipeline_->getPushConstantSize());
+    return;
+  }
+
+  const UINT rootParameterIndex = m_pushConstantRootIndex_;
+
+  switch (m_currentPipeline_->getType()) {
+    case PipelineType::Graphics:
+      m_commandList_->SetGraphicsRoot32BitConstants(rootParameterIndex, size / 4, data, offset / 4);
+      break;
+    case PipelineType::Compute:
+      m_commandList_->SetComputeRoot32BitConstants(rootParameterIndex, size / 4, data, offset / 4);
+      break;
+  }
+}
+
 void CommandBufferDx12::draw(uint32_t vertexCount, uint32_t firstVertex) {
   if (!m_isRecording_ || !m_isRenderPassActive_) {
     LOG_ERROR("Command buffer is not recording or render pass is not active");
@@ -304,12 +376,116 @@ void CommandBufferDx12::drawIndexedInstanced(
   m_commandList_->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+void CommandBufferDx12::drawIndexedIndirect(Buffer* buffer, uint64_t offset) {
+  executeDrawIndexedIndirect_(buffer, offset, 1, sizeof(DrawIndexedIndirectCommand), nullptr, 0);
+}
+
+void CommandBufferDx12::multiDrawIndexedIndirect(Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) {
+  executeDrawIndexedIndirect_(buffer, offset, drawCount, stride, nullptr, 0);
+}
+
+void CommandBufferDx12::multiDrawIndexedIndirectCount(Buffer*  buffer,
+                                                      uint64_t offset,
+                                                      Buffer*  countBuffer,
+                                                      uint64_t countOffset,
+                                                      uint32_t maxDrawCount,
+                                                      uint32_t stride) {
+  if (!countBuffer) {
+    LOG_ERROR("Null count buffer");
+    return;
+  }
+
+  executeDrawIndexedIndirect_(buffer, offset, maxDrawCount, stride, countBuffer, countOffset);
+}
+
+void CommandBufferDx12::executeDrawIndexedIndirect_(Buffer*  buffer,
+                                                    uint64_t offset,
+                                                    uint32_t maxDrawCount,
+                                                    uint32_t stride,
+                                                    Buffer*  countBuffer,
+                                                    uint64_t countOffset) {
+  if (!m_isRecording_ || !m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is not active");
+    return;
+  }
+
+  auto pipelineDx12 = dynamic_cast<GraphicsPipelineDx12*>(m_currentPipeline_);
+  if (!pipelineDx12) {
+    LOG_ERROR("No active graphics pipeline");
+    return;
+  }
+
+  // the command signature fixes the stride of the argument records
+  if (stride != sizeof(DrawIndexedIndirectCommand)) {
+    LOG_ERROR("Indirect draw stride must be {} bytes on DirectX 12", sizeof(DrawIndexedIndirectCommand));
+    return;
+  }
+
+  BufferDx12* bufferDx12      = dynamic_cast<BufferDx12*>(buffer);
+  BufferDx12* countBufferDx12 = countBuffer ? dynamic_cast<BufferDx12*>(countBuffer) : nullptr;
+  if (!bufferDx12 || (countBuffer && !countBufferDx12)) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  // without push constants the signature reads the draw arguments only - skip drawConstant
+  const uint64_t argumentOffset
+      = pipelineDx12->getPushConstantSize() > 0 ? offset : offset + offsetof(DrawIndexedIndirectCommand, indexCount);
+
+  m_commandList_->ExecuteIndirect(pipelineDx12->getDrawIndexedCommandSignature(),
+                                  maxDrawCount,
+                                  bufferDx12->getResource(),
+                                  argumentOffset,
+                                  countBufferDx12 ? countBufferDx12->getResource() : nullptr,
+                                  countOffset);
+}
+
+void CommandBufferDx12::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+  if (!m_isRecording_ || m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is active");
+    return;
+  }
+
+  if (!m_currentPipeline_ || m_currentPipeline_->getType() != PipelineType::Compute) {
+    LOG_ERROR("No active compute pipeline");
+    return;
+  }
+
+  m_commandList_->Dispatch(groupCountX, groupCountY, groupCountZ);
+}
+
+void CommandBufferDx12::dispatchIndirect(Buffer* buffer, uint64_t offset) {
+  if (!m_isRecording_ || m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is active");
+    return;
+  }
+
+  if (!m_currentPipeline_ || m_currentPipeline_->getType() != PipelineType::Compute) {
+    LOG_ERROR("No active compute pipeline");
+    return;
+  }
+
+  BufferDx12* bufferDx12 = dynamic_cast<BufferDx12*>(buffer);
+  if (!bufferDx12) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  m_commandList_->ExecuteIndirect(
+      m_device_->getDispatchCommandSignature(), 1, bufferDx12->getResource(), offset, nullptr, 0);
+}
+
 void CommandBufferDx12::resourceBarrier(const ResourceBarrierDesc& barrier) {
   if (!m_isRecording_) {
     LOG_ERROR("Command buffer is not recording");
     return;
   }
 
+  if (barrier.buffer) {
+    bufferBarrier_(barrier);
+    return;
+  }
+
   if (!barrier.texture) {
     LOG_ERROR("Null texture");
     return;
@@ -321,9 +497,78 @@ void CommandBufferDx12::resourceBarrier(const ResourceBarrierDesc& barrier) {
     return;
   }
 
-  auto oldState = g_getResourceLayoutDx12(barrier.oldLayout);
+  if (barrier.oldLayout == ResourceLayout::Uav && barrier.newLayout == ResourceLayout::Uav) {
+    uavBarrier_(textureDx12->getResource());
+    return;
+  }
+
+  std::vector<D3D12_RESOURCE_BARRIER> barriersDx12;
+  std::vector<ID3D12Resource*>        discardedResources;
+  getTextureBarriers_(barrier, textureDx12, barriersDx12, discardedResources);
+
+  if (!barriersDx12.empty()) {
+    m_commandList_->ResourceBarrier(static_cast<UINT>(barriersDx12.size()), barriersDx12.data());
+  }
+
+  for (auto* resource : discardedResources) {
+    m_commandList_->DiscardResource(resource, nullptr);
+  }
+}
+
+void CommandBufferDx12::resourceBarriers(const std::vector<ResourceBarrierDesc>& barriers) {
+  if (!m_isRecording_) {
+    LOG_ERROR("Command buffer is not recording");
+    return;
+  }
+
+  std::vector<D3D12_RESOURCE_BARRIER> barriersDx12;
+  std::vector<ID3D12Resource*>        discardedResources;
+  barriersDx12.reserve(barriers.size());
+
+  for (const auto& barrier : barriers) {
+    // buffer and UAV barriers are recorded one by one, the batch only merges texture transitions
+    TextureDx12* textureDx12 = dynamic_cast<TextureDx12*>(barrier.texture);
+    if (!textureDx12 || barrier.buffer
+        || (barrier.oldLayout == ResourceLayout::Uav && barrier.newLayout == ResourceLayout::Uav)) {
+      resourceBarrier(barrier);
+      continue;
+    }
+
+    getTextureBarriers_(barrier, textureDx12, barriersDx12, discardedResources);
+  }
+
+  if (!barriersDx12.empty()) {
+    m_commandList_->ResourceBarrier(static_cast<UINT>(barriersDx12.size()), barriersDx12.data());
+  }
+
+  for (auto* resource : discardedResources) {
+    m_commandList_->DiscardResource(resource, nullptr);
+  }
+}
+
+void CommandBufferDx12::getTextureBarriers_(const ResourceBarrierDesc&           barrier,
+                                            TextureDx12*                         textureDx12,
+                                            std::vector<D3D12_RESOURCE_BARRIER>& barriersDx12,
+                                            std::vector<ID3D12Resource*>&        discardedResources) {
+  // discarded textures may share memory with a texture used before - the tracked state is the state they were
+  // left in, not the state of the memory
+  auto oldState = barrier.discard ? textureDx12->getResourceState() : g_getResourceLayoutDx12(barrier.oldLayout);
   auto newState = g_getResourceLayoutDx12(barrier.newLayout);
 
+  if (barrier.discard) {
+    D3D12_RESOURCE_BARRIER aliasingBarrier   = {};
+    aliasingBarrier.Type                     = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+    aliasingBarrier.Flags                    = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    aliasingBarrier.Aliasing.pResourceBefore = nullptr;  // any resource placed in the same memory
+    aliasingBarrier.Aliasing.pResourceAfter  = textureDx12->getResource();
+    barriersDx12.push_back(aliasingBarrier);
+
+    // render targets and depth-stencil textures must be initialized after aliasing (clear, copy or discard)
+    if (newState == D3D12_RESOURCE_STATE_RENDER_TARGET || newState == D3D12_RESOURCE_STATE_DEPTH_WRITE) {
+      discardedResources.push_back(textureDx12->getResource());
+    }
+  }
+
   if (oldState == newState) {
     // TODO: uncomment this if needed
     // LOG_WARN("Skipping redundant barrier, states are identical");
@@ -337,10 +582,56 @@ void CommandBufferDx12::resourceBarrier(const ResourceBarrierDesc& barrier) {
   barrierDx12.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
   barrierDx12.Transition.StateBefore = oldState;
   barrierDx12.Transition.StateAfter  = newState;
+  barriersDx12.push_back(barrierDx12);
+
+  textureDx12->updateCurrentState_(barrier.newLayout);
+}
+
+void CommandBufferDx12::bufferBarrier_(const ResourceBarrierDesc& barrier) {
+  BufferDx12* bufferDx12 = dynamic_cast<BufferDx12*>(barrier.buffer);
+  if (!bufferDx12) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  if (barrier.oldLayout == ResourceLayout::Uav && barrier.newLayout == ResourceLayout::Uav) {
+    uavBarrier_(bufferDx12->getResource());
+    return;
+  }
+
+  // upload / readback heap buffers can't leave their initial state
+  if (bufferDx12->isUploadHeapBuffer_() || bufferDx12->isReadbackHeapBuffer_()) {
+    return;
+  }
+
+  // the tracked state is used instead of oldLayout - buffers have no layout and may be in a combined read state
+  auto oldState = bufferDx12->getCurrentState();
+  auto newState = g_getResourceLayoutDx12(barrier.newLayout);
+
+  if (oldState == newState) {
+    return;
+  }
+
+  D3D12_RESOURCE_BARRIER barrierDx12 = {};
+  barrierDx12.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+  barrierDx12.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+  barrierDx12.Transition.pResource   = bufferDx12->getResource();
+  barrierDx12.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+  barrierDx12.Transition.StateBefore = oldState;
+  barrierDx12.Transition.StateAfter  = newState;
 
   m_commandList_->ResourceBarrier(1, &barrierDx12);
 
-  textureDx12->updateCurrentState_(barrier.newLayout);
+  bufferDx12->updateCurrentState(newState);
+}
+
+void CommandBufferDx12::uavBarrier_(ID3D12Resource* resource) {
+  D3D12_RESOURCE_BARRIER barrierDx12 = {};
+  barrierDx12.Type                   = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+  barrierDx12.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+  barrierDx12.UAV.pResource          = resource;
+
+  m_commandList_->ResourceBarrier(1, &barrierDx12);
 }
 
 void CommandBufferDx12::beginRenderPass(RenderPass*                    renderPass,
@@ -641,7 +932,18 @@ void CommandBufferDx12::copyTexture(Texture* srcTexture,
   dstLoc.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
   dstLoc.SubresourceIndex = dstSub;
 
-  m_commandList_->CopyTextureRegion(&dstLoc, 0, 0, 0, &srcLoc, nullptr);
+  // region both sub-resources cover, starting at the top-left corner (render targets may be larger than the
+  // back buffer they are copied to)
+  const UINT copyWidth  = std::min(srcTexDx12->getWidth() >> srcMipLevel, dstTexDx12->getWidth() >> dstMipLevel);
+  const UINT copyHeight = std::min(srcTexDx12->getHeight() >> srcMipLevel, dstTexDx12->getHeight() >> dstMipLevel);
+  const UINT copyDepth  = std::min(srcTexDx12->getDepth() >> srcMipLevel, dstTexDx12->getDepth() >> dstMipLevel);
+
+  D3D12_BOX srcBox{};
+  srcBox.right  = std::max(copyWidth, 1u);
+  srcBox.bottom = std::max(copyHeight, 1u);
+  srcBox.back   = std::max(copyDepth, 1u);
+
+  m_commandList_->CopyTextureRegion(&dstLoc, 0, 0, 0, &srcLoc, &srcBox);
 
   if (srcInitialState != D3D12_RESOURCE_STATE_COPY_SOURCE) {
     D3D12_RESOURCE_BARRIER barrier{};
@@ -827,7 +1129,7 @@ CommandAllocatorManager::~CommandAllocatorManager() {
   release();
 }
 
-bool CommandAllocatorManager::initialize(ID3D12Device* device, uint32_t allocatorCount) {
+bool CommandAllocatorManager::initialize(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, uint32_t allocatorCount) {
   if (!device) {
     LOG_ERROR("Invalid device");
     return false;
@@ -836,11 +1138,12 @@ bool CommandAllocatorManager::initialize(ID3D12Device* device, uint32_t allocato
   release();
 
   m_device = device;
+  m_type   = type;
 
   // Create the initial pool of command allocators
   for (uint32_t i = 0; i < allocatorCount; ++i) {
     ComPtr<ID3D12CommandAllocator> allocator;
-    HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator));
+    HRESULT hr = device->CreateCommandAllocator(m_type, IID_PPV_ARGS(&allocator));
 
     if (FAILED(hr)) {
       LOG_ERROR("Failed to create command allocator");
@@ -878,7 +1181,7 @@ ID3D12CommandAllocator* CommandAllocatorManager::getCommandAllocator() {
   }
 
   ComPtr<ID3D12CommandAllocator> allocator;
-  HRESULT hr = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator));
+  HRESULT hr = m_device->CreateCommandAllocator(m_type, IID_PPV_ARGS(&allocator));
 
   if (FAILED(hr)) {
     LOG_ERROR("Failed to create command allocator");
@@ -31,7 +31,7 @@ class FramebufferDx12;
  */
 class CommandBufferDx12 : public CommandBuffer {
   public:
-  CommandBufferDx12(DeviceDx12* device, ComPtr<ID3D12GraphicsCommandList> commandList, ID3D12CommandAllocator* commandAllocator);
+  CommandBufferDx12(DeviceDx12* device, ComPtr<ID3D12GraphicsCommandList> commandList, ID3D12CommandAllocator* commandAllocator, QueueType queueType = QueueType::Graphics);
   ~CommandBufferDx12();
 
   // Command buffer recording
@@ -50,15 +50,33 @@ class CommandBufferDx12 : public CommandBuffer {
   // @param rootParameterIndex: Root parameter index as defined in the root signature. 
   // @note  descriptor set should be compatible with the pipeline's root signature.
   void bindDescriptorSet(uint32_t rootParameterIndex, DescriptorSet* set) override;
+  // Dynamic offsets are applied to sets bound as root CBVs (see DescriptorSetLayoutDx12::isRootConstantBuffer)
+  void bindDescriptorSet(uint32_t rootParameterIndex, DescriptorSet* set, const std::vector<uint32_t>& dynamicOffsets) override;
+
+  // Push constants - written to the root constants parameter that follows the descriptor set parameters
+  using CommandBuffer::pushConstants;
+  void pushConstants(const void* data, uint32_t size, uint32_t offset = 0) override;
 
   // Draw commands
   void draw(uint32_t vertexCount, uint32_t firstVertex = 0) override;
   void drawIndexed(uint32_t indexCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0) override;
   void drawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
   void drawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
+
+  // Indirect draws - ExecuteIndirect with the command signature of the current graphics pipeline
+  void drawIndexedIndirect(Buffer* buffer, uint64_t offset = 0) override;
+  void multiDrawIndexedIndirect(Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+  void multiDrawIndexedIndirectCount(Buffer* buffer, uint64_t offset, Buffer* countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+  // Compute commands
+  void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) override;
+  // executed with ExecuteIndirect and the device's dispatch command signature
+  void dispatchIndirect(Buffer* buffer, uint64_t offset = 0) override;
   
   // Resource barriers
+  // Buffers transition from their tracked state (BufferDx12::getCurrentState), Uav -> Uav is a UAV barrier
   void resourceBarrier(const ResourceBarrierDesc& barrier) override;
+  void resourceBarriers(const std::vector<ResourceBarrierDesc>& barriers) override;
 
   // Render pass operations
   /**
@@ -89,6 +107,8 @@ class CommandBufferDx12 : public CommandBuffer {
 
   ID3D12CommandAllocator* getCommandAllocator() const { return m_commandAllocator_; }
 
+  QueueType getQueueType() const { return m_queueType_; }
+
   /**
    * Binds the GPU descriptor heaps (CBV/SRV/UAV heap and Sampler heap)
    * 
@@ -99,15 +119,30 @@ class CommandBufferDx12 : public CommandBuffer {
   void bindDescriptorHeaps();
 
   private:
+  void bufferBarrier_(const ResourceBarrierDesc& barrier);
+  void uavBarrier_(ID3D12Resource* resource);
+
+  // appends the aliasing (discard) and transition barriers of a texture, discarded render targets are collected for
+  // DiscardResource after the barriers
+  void getTextureBarriers_(const ResourceBarrierDesc&           barrier,
+                           TextureDx12*                         textureDx12,
+                           std::vector<D3D12_RESOURCE_BARRIER>& barriersDx12,
+                           std::vector<ID3D12Resource*>&        discardedResources);
+
+  void executeDrawIndexedIndirect_(
+      Buffer* buffer, uint64_t offset, uint32_t maxDrawCount, uint32_t stride, Buffer* countBuffer, uint64_t countOffset);
+
   DeviceDx12*                m_device_;
   ComPtr<ID3D12GraphicsCommandList> m_commandList_;
   ID3D12CommandAllocator*    m_commandAllocator_;
-
-  GraphicsPipelineDx12*    m_currentPipeline_    = nullptr;
-  RenderPassDx12*          m_currentRenderPass_  = nullptr;
-  FramebufferDx12*         m_currentFramebuffer_ = nullptr;
-  bool                     m_isRenderPassActive_ = false;
-  bool                     m_isRecording_        = false;
+  QueueType                  m_queueType_;
+
+  Pipeline*                m_currentPipeline_       = nullptr;
+  uint32_t                 m_pushConstantRootIndex_ = 0;  // root constants parameter of the current pipeline
+  RenderPassDx12*          m_currentRenderPass_     = nullptr;
+  FramebufferDx12*         m_currentFramebuffer_    = nullptr;
+  bool                     m_isRenderPassActive_    = false;
+  bool                     m_isRecording_           = false;
 };
 
 // clang-format on
@@ -117,7 +152,9 @@ class CommandAllocatorManager {
   CommandAllocatorManager() = default;
   ~CommandAllocatorManager();
 
-  bool initialize(ID3D12Device* device, uint32_t allocatorCount = 8);
+  bool initialize(ID3D12Device*           device,
+                  D3D12_COMMAND_LIST_TYPE type           = D3D12_COMMAND_LIST_TYPE_DIRECT,
+                  uint32_t                allocatorCount = 8);
   void release();
 
   ID3D12CommandAllocator* getCommandAllocator();
@@ -126,6 +163,7 @@ class CommandAllocatorManager {
 
   private:
   ID3D12Device*                               m_device = nullptr;
+  D3D12_COMMAND_LIST_TYPE                     m_type   = D3D12_COMMAND_LIST_TYPE_DIRECT;
   std::vector<ComPtr<ID3D12CommandAllocator>> m_availableAllocators;
   std::vector<ComPtr<ID3D12CommandAllocator>> m_usedAllocators;
 };
@@ -50,6 +50,17 @@ DescriptorSetLayoutDx12::DescriptorSetLayoutDx12(const DescriptorSetLayoutDesc&
     m_bindingsByType[type].push_back(binding);
   }
 
+  for (const auto& binding : desc.bindings) {
+    if (binding.type == ShaderBindingType::UniformbufferDynamic) {
+      if (desc.bindings.size() == 1 && binding.descriptorCount == 1) {
+        m_isRootConstantBuffer_ = true;
+      } else {
+        LOG_WARN("Dynamic constant buffer (binding {}) must be the only binding of its set in DX12, bound as static",
+                 binding.binding);
+      }
+    }
+  }
+
   for (auto& [type, bindings] : m_bindingsByType) {
     std::sort(bindings.begin(),
               bindings.end(),
@@ -139,6 +150,12 @@ void DescriptorSetDx12::setUniformBuffer(uint32_t binding, Buffer* buffer, uint6
     return;
   }
 
+  if (m_layout_->isRootConstantBuffer()) {
+    m_rootConstantBuffer_       = bufferDx12;
+    m_rootConstantBufferOffset_ = offset;
+    return;
+  }
+
   if (!bufferDx12->hasCbvHandle()) {
     LOG_ERROR("Buffer does not have a CBV");
     return;
@@ -175,6 +192,13 @@ void DescriptorSetDx12::setTextureSampler(uint32_t binding, Texture* texture, Sa
 }
 
 void DescriptorSetDx12::setTexture(uint32_t binding, Texture* texture, ResourceLayout layout) {
+  setTextureArrayElement(binding, 0, texture, layout);
+}
+
+void DescriptorSetDx12::setTextureArrayElement(uint32_t       binding,
+                                               uint32_t       arrayElement,
+                                               Texture*       texture,
+                                               ResourceLayout layout) {
   if (!texture) {
     LOG_ERROR("Null texture");
     return;
@@ -207,8 +231,12 @@ void DescriptorSetDx12::setTexture(uint32_t binding, Texture* texture, ResourceL
 
   uint32_t srcIndex = textureDx12->getSrvDescriptorIndex();
 
-  uint32_t bindingOffset = findBindingOffset_(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, binding);
-  uint32_t dstIndex      = m_srvUavCbvIndices_[currentFrame] + bindingOffset;
+  // array elements occupy consecutive registers (t[binding + element])
+  uint32_t bindingOffset = findBindingOffset_(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, binding + arrayElement);
+  if (bindingOffset == UINT32_MAX) {
+    return;
+  }
+  uint32_t dstIndex = m_srvUavCbvIndices_[currentFrame] + bindingOffset;
 
   gpuHeap->copyDescriptors(cpuHeap, srcIndex, dstIndex, 1);
 }
@@ -281,10 +309,19 @@ void DescriptorSetDx12::setStorageBuffer(uint32_t binding, Buffer* buffer, uint6
     return;
   }
 
+  // a buffer with both views is bound as declared by the layout - read-only bindings get the SRV
+  bool bindAsSrv = false;
+  for (const auto& bindingDesc : m_layout_->getDesc().bindings) {
+    if (bindingDesc.binding == binding) {
+      bindAsSrv = bindingDesc.type == ShaderBindingType::BufferSrv;
+      break;
+    }
+  }
+
   uint32_t                    srcIndex;
   D3D12_DESCRIPTOR_RANGE_TYPE rangeType;
 
-  if (bufferDx12->isUnorderedAccessBuffer() && bufferDx12->hasUavHandle()) {
+  if (!bindAsSrv && bufferDx12->isUnorderedAccessBuffer() && bufferDx12->hasUavHandle()) {
     srcIndex
         = uint32_t((bufferDx12->getUavCpuHandle().ptr - cpuHeap->getCpuHandle(0).ptr) / cpuHeap->getDescriptorSize());
     rangeType = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
@@ -334,6 +371,15 @@ void DescriptorSetDx12::setStorageBuffer(uint32_t binding, Buffer* buffer, uint6
   return heap->getGpuHandle(m_samplerIndices_[frame]);
 }
 
+[[nodiscard]] D3D12_GPU_VIRTUAL_ADDRESS DescriptorSetDx12::getRootConstantBufferAddress() const {
+  if (!m_rootConstantBuffer_) {
+    LOG_ERROR("No constant buffer bound to the root CBV descriptor set");
+    return 0;
+  }
+
+  return m_rootConstantBuffer_->getGPUVirtualAddress() + m_rootConstantBufferOffset_;
+}
+
 uint32_t DescriptorSetDx12::findBindingOffset_(D3D12_DESCRIPTOR_RANGE_TYPE rangeType, uint32_t binding) const {
   const auto& bindingsByType = m_layout_->getBindingsByType();
 
@@ -524,7 +570,7 @@ void DescriptorHeapDx12::copyDescriptors(const DescriptorHeapDx12* srcHeap,
 // -------------------------------------------------------------------------
 
 // TODO: Make these sizes configurable
-constexpr uint32_t FRAME_CBV_SRV_UAV_HEAP_SIZE = 2048;
+constexpr uint32_t FRAME_CBV_SRV_UAV_HEAP_SIZE = 2048 + kMaxBindlessDescriptors;  // + one bindless texture table
 constexpr uint32_t FRAME_SAMPLER_HEAP_SIZE     = 128;
 
 FrameResourcesManager::~FrameResourcesManager() {
@@ -44,6 +44,12 @@ class DescriptorSetLayoutDx12 : public DescriptorSetLayout {
 
   uint32_t getTotalDescriptors() const { return m_totalDescriptors_; }
 
+  /**
+   * A layout holding a single dynamic constant buffer becomes a root CBV instead of a descriptor table,
+   * dynamic offsets are then applied by moving the root descriptor's GPU address
+   */
+  bool isRootConstantBuffer() const { return m_isRootConstantBuffer_; }
+
   private:
   DeviceDx12* m_device_{};
 
@@ -51,8 +57,9 @@ class DescriptorSetLayoutDx12 : public DescriptorSetLayout {
 
   std::vector<D3D12_DESCRIPTOR_RANGE> m_descriptorRanges;
 
-  bool     m_isSamplerLayout   = false;
-  uint32_t m_totalDescriptors_ = 0;
+  bool     m_isSamplerLayout       = false;
+  bool     m_isRootConstantBuffer_ = false;
+  uint32_t m_totalDescriptors_     = 0;
 };
 
 /**
@@ -71,6 +78,10 @@ class DescriptorSetDx12 : public DescriptorSet {
   void setUniformBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0, uint64_t range = 0) override;
   void setTextureSampler(uint32_t binding, Texture* texture, Sampler* sampler) override;
   void setTexture(uint32_t binding, Texture* texture, ResourceLayout layout = ResourceLayout::ShaderReadOnly) override;
+  void setTextureArrayElement(uint32_t       binding,
+                              uint32_t       arrayElement,
+                              Texture*       texture,
+                              ResourceLayout layout = ResourceLayout::ShaderReadOnly) override;
   void setSampler(uint32_t binding, Sampler* sampler) override;
   void setStorageBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0, uint64_t range = 0) override;
 
@@ -82,12 +93,18 @@ class DescriptorSetDx12 : public DescriptorSet {
 
   [[nodiscard]] D3D12_GPU_DESCRIPTOR_HANDLE getGpuSamplerHandle(uint32_t frame) const;
 
+  // Only valid for root CBV layouts (see DescriptorSetLayoutDx12::isRootConstantBuffer)
+  [[nodiscard]] D3D12_GPU_VIRTUAL_ADDRESS getRootConstantBufferAddress() const;
+
   private:
   uint32_t findBindingOffset_(D3D12_DESCRIPTOR_RANGE_TYPE rangeType, uint32_t binding) const;
 
   DeviceDx12*                    m_device_ = nullptr;
   const DescriptorSetLayoutDx12* m_layout_ = nullptr;
 
+  BufferDx12* m_rootConstantBuffer_       = nullptr;
+  uint64_t    m_rootConstantBufferOffset_ = 0;
+
   // Resource references
   std::vector<uint32_t> m_srvUavCbvIndices_{};
   std::vector<uint32_t> m_samplerIndices_{};
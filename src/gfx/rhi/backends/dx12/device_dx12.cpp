@@ -8,6 +8,7 @@
 #include "gfx/rhi/backends/dx12/command_buffer_dx12.h"
 #include "gfx/rhi/backends/dx12/descriptor_dx12.h"
 #include "gfx/rhi/backends/dx12/framebuffer_dx12.h"
+#include "gfx/rhi/backends/dx12/memory_heap_dx12.h"
 #include "gfx/rhi/backends/dx12/pipeline_dx12.h"
 #include "gfx/rhi/backends/dx12/render_pass_dx12.h"
 #include "gfx/rhi/backends/dx12/rhi_enums_dx12.h"
@@ -50,7 +51,7 @@ DeviceDx12::DeviceDx12(const DeviceDesc& desc)
 #endif
 
   if (!createFactory_() || !createDevice_() || !createAllocator_() || !createCommandQueue_() || !createCommandPools_()
-      || !createDescriptorHeaps_()) {
+      || !createCommandSignatures_() || !createDescriptorHeaps_()) {
     LOG_ERROR("Failed to initialize DirectX 12 device");
   }
 }
@@ -65,6 +66,8 @@ DeviceDx12::~DeviceDx12() {
 
   m_frameResourcesManager.release();
 
+  m_dispatchCommandSignature_.Reset();
+  m_computeCommandQueue_.Reset();
   m_commandQueue_.Reset();
   m_device_.Reset();
   m_adapter_.Reset();
@@ -191,11 +194,42 @@ bool DeviceDx12::createCommandQueue_() {
     return false;
   }
 
+  queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+
+  hr = m_device_->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_computeCommandQueue_));
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to create DirectX 12 compute command queue");
+    return false;
+  }
+
   return true;
 }
 
 bool DeviceDx12::createCommandPools_() {
-  return m_commandAllocatorManager_.initialize(m_device_.Get(), COMMAND_ALLOCATOR_POOL_SIZE);
+  return m_commandAllocatorManager_.initialize(
+             m_device_.Get(), D3D12_COMMAND_LIST_TYPE_DIRECT, COMMAND_ALLOCATOR_POOL_SIZE)
+      && m_computeCommandAllocatorManager_.initialize(
+             m_device_.Get(), D3D12_COMMAND_LIST_TYPE_COMPUTE, COMMAND_ALLOCATOR_POOL_SIZE);
+}
+
+bool DeviceDx12::createCommandSignatures_() {
+  D3D12_INDIRECT_ARGUMENT_DESC argumentDesc = {};
+  argumentDesc.Type                         = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+
+  D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+  signatureDesc.ByteStride                   = sizeof(DispatchIndirectCommand);
+  signatureDesc.NumArgumentDescs             = 1;
+  signatureDesc.pArgumentDescs               = &argumentDesc;
+
+  // root signature is not needed when the arguments don't change root parameters
+  HRESULT hr
+      = m_device_->CreateCommandSignature(&signatureDesc, nullptr, IID_PPV_ARGS(&m_dispatchCommandSignature_));
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to create dispatch command signature");
+    return false;
+  }
+
+  return true;
 }
 
 bool DeviceDx12::createDescriptorHeaps_() {
@@ -264,6 +298,29 @@ std::unique_ptr<Texture> DeviceDx12::createTexture(const TextureDesc& desc) {
   return std::make_unique<TextureDx12>(desc, this);
 }
 
+std::unique_ptr<MemoryHeap> DeviceDx12::createMemoryHeap(const MemoryHeapDesc& desc) {
+  return std::make_unique<MemoryHeapDx12>(desc, this);
+}
+
+std::unique_ptr<Texture> DeviceDx12::createAliasedTexture(const TextureDesc& desc, MemoryHeap* heap, uint64_t offset) {
+  return std::make_unique<TextureDx12>(desc, this, static_cast<MemoryHeapDx12*>(heap), offset);
+}
+
+MemoryRequirements DeviceDx12::getTextureMemoryRequirements(const TextureDesc& desc) {
+  MemoryRequirements requirements;
+
+  D3D12_RESOURCE_DESC resourceDesc = {};
+  if (!TextureDx12::s_getResourceDesc(desc, resourceDesc)) {
+    return requirements;
+  }
+
+  auto allocationInfo = m_device_->GetResourceAllocationInfo(0, 1, &resourceDesc);
+
+  requirements.size      = allocationInfo.SizeInBytes;
+  requirements.alignment = allocationInfo.Alignment;
+  return requirements;
+}
+
 std::unique_ptr<Sampler> DeviceDx12::createSampler(const SamplerDesc& desc) {
   return std::make_unique<SamplerDx12>(desc, this);
 }
@@ -290,6 +347,24 @@ std::unique_ptr<GraphicsPipeline> DeviceDx12::createGraphicsPipelineWithReflecti
   return std::move(pipeline);
 }
 
+std::unique_ptr<ComputePipeline> DeviceDx12::createComputePipeline(const ComputePipelineDesc& desc) {
+  return std::make_unique<ComputePipelineDx12>(desc, PipelineLayoutDesc{}, this);
+}
+
+std::unique_ptr<ComputePipeline> DeviceDx12::createComputePipelineWithReflection(const ComputePipelineDesc& desc) {
+  PipelineLayoutDesc reflectionLayout = pipeline_utils::generatePipelineLayoutFromShaders({desc.shader});
+
+  std::vector<std::unique_ptr<DescriptorSetLayout>> ownedLayouts;
+  auto layoutPtrs = pipeline_utils::createDescriptorSetLayouts(this, reflectionLayout, ownedLayouts);
+
+  ComputePipelineDesc modifiedDesc = desc;
+  modifiedDesc.setLayouts          = layoutPtrs;
+
+  auto pipeline = std::make_unique<ComputePipelineDx12>(modifiedDesc, reflectionLayout, this);
+
+  return std::move(pipeline);
+}
+
 std::unique_ptr<DescriptorSetLayout> DeviceDx12::createDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) {
   return std::make_unique<DescriptorSetLayoutDx12>(desc, this);
 }
@@ -316,28 +391,32 @@ std::unique_ptr<CommandBuffer> DeviceDx12::createCommandBuffer(const CommandBuff
   // In a production multi-threaded engine, you would need to protect
   // the command allocator pool with a mutex.
 
-  ID3D12CommandAllocator* commandAllocator = m_commandAllocatorManager_.getCommandAllocator();
+  const bool               isCompute = desc.queueType == QueueType::Compute;
+  CommandAllocatorManager& allocatorManager
+      = isCompute ? m_computeCommandAllocatorManager_ : m_commandAllocatorManager_;
+
+  ID3D12CommandAllocator* commandAllocator = allocatorManager.getCommandAllocator();
   if (!commandAllocator) {
     return nullptr;
   }
 
+  D3D12_COMMAND_LIST_TYPE listType = desc.primary ? D3D12_COMMAND_LIST_TYPE_DIRECT : D3D12_COMMAND_LIST_TYPE_BUNDLE;
+  if (isCompute) {
+    listType = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+  }
+
   ComPtr<ID3D12GraphicsCommandList> commandList;
-  HRESULT                           hr
-      = m_device_->CreateCommandList(0,
-                                     desc.primary ? D3D12_COMMAND_LIST_TYPE_DIRECT : D3D12_COMMAND_LIST_TYPE_BUNDLE,
-                                     commandAllocator,
-                                     nullptr,
-                                     IID_PPV_ARGS(&commandList));
+  HRESULT hr = m_device_->CreateCommandList(0, listType, commandAllocator, nullptr, IID_PPV_ARGS(&commandList));
 
   if (FAILED(hr)) {
     LOG_ERROR("Failed to create command list");
-    m_commandAllocatorManager_.returnCommandAllocator(commandAllocator);
+    allocatorManager.returnCommandAllocator(commandAllocator);
     return nullptr;
   }
 
   commandList->Close();
 
-  return std::make_unique<CommandBufferDx12>(this, std::move(commandList), commandAllocator);
+  return std::make_unique<CommandBufferDx12>(this, std::move(commandList), commandAllocator, desc.queueType);
 }
 
 std::unique_ptr<Fence> DeviceDx12::createFence(const FenceDesc& desc) {
@@ -422,33 +501,45 @@ void DeviceDx12::updateTexture(
   textureDx12->update(data, dataSize, mipLevel, arrayLayer);
 }
 
-void DeviceDx12::submitCommandBuffer(CommandBuffer*                 cmdBuffer,
-                                     Fence*                         signalFence,
-                                     const std::vector<Semaphore*>& waitSemaphores,
-                                     const std::vector<Semaphore*>& signalSemaphores) {
+void DeviceDx12::submitCommandBuffer(CommandBuffer*              cmdBuffer,
+                                     Fence*                      signalFence,
+                                     std::span<Semaphore* const> waitSemaphores,
+                                     std::span<Semaphore* const> signalSemaphores) {
   CommandBufferDx12* cmdBufferDx12 = dynamic_cast<CommandBufferDx12*>(cmdBuffer);
   if (!cmdBufferDx12) {
     return;
   }
 
+  ID3D12CommandQueue* queue
+      = cmdBufferDx12->getQueueType() == QueueType::Compute ? m_computeCommandQueue_.Get() : m_commandQueue_.Get();
+
   ID3D12CommandList* ppCommandLists[] = {cmdBufferDx12->getCommandList()};
 
   {
     std::lock_guard<std::mutex> lock(m_queueSubmitMutex);
-    m_commandQueue_->ExecuteCommandLists(std::size(ppCommandLists), ppCommandLists);
+
+    // GPU side wait - the queue doesn't start the command list until the semaphores are signaled
+    for (Semaphore* semaphore : waitSemaphores) {
+      SemaphoreDx12* semaphoreDx12 = dynamic_cast<SemaphoreDx12*>(semaphore);
+      if (semaphoreDx12) {
+        semaphoreDx12->wait(queue);
+      }
+    }
+
+    queue->ExecuteCommandLists(std::size(ppCommandLists), ppCommandLists);
   }
 
   if (signalFence) {
     FenceDx12* fenceDx12 = dynamic_cast<FenceDx12*>(signalFence);
     if (fenceDx12) {
-      fenceDx12->signal(m_commandQueue_.Get());
+      fenceDx12->signal(queue);
     }
   }
 
   for (Semaphore* semaphore : signalSemaphores) {
     SemaphoreDx12* semaphoreDx12 = dynamic_cast<SemaphoreDx12*>(semaphore);
     if (semaphoreDx12) {
-      semaphoreDx12->signal(m_commandQueue_.Get());
+      semaphoreDx12->signal(queue);
     }
   }
 }
@@ -465,9 +556,15 @@ void DeviceDx12::waitIdle() {
     return;
   }
 
-  const UINT64 fenceValue = 1;
+  // the compute queue signals only after the graphics queue drained, so the last value covers both queues
+  UINT64 fenceValue = 1;
   m_commandQueue_->Signal(fence.Get(), fenceValue);
 
+  if (m_computeCommandQueue_) {
+    m_computeCommandQueue_->Wait(fence.Get(), fenceValue);
+    m_computeCommandQueue_->Signal(fence.Get(), ++fenceValue);
+  }
+
   if (fence->GetCompletedValue() < fenceValue) {
     fence->SetEventOnCompletion(fenceValue, eventHandle);
     WaitForSingleObject(eventHandle, INFINITE);
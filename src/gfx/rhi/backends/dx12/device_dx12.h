@@ -30,6 +30,8 @@ class DeviceDx12 : public Device {
   std::unique_ptr<Shader>              createShader(const ShaderDesc& desc) override;
   std::unique_ptr<GraphicsPipeline>    createGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
   std::unique_ptr<GraphicsPipeline>    createGraphicsPipelineWithReflection(const GraphicsPipelineDesc& desc) override;
+  std::unique_ptr<ComputePipeline>     createComputePipeline(const ComputePipelineDesc& desc) override;
+  std::unique_ptr<ComputePipeline>     createComputePipelineWithReflection(const ComputePipelineDesc& desc) override;
   std::unique_ptr<DescriptorSetLayout> createDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) override;
   std::unique_ptr<DescriptorSet>       createDescriptorSet(const DescriptorSetLayout* layout) override;
   std::unique_ptr<RenderPass>          createRenderPass(const RenderPassDesc& desc) override;
@@ -38,6 +40,9 @@ class DeviceDx12 : public Device {
   std::unique_ptr<Fence>               createFence(const FenceDesc& desc = FenceDesc()) override;
   std::unique_ptr<Semaphore>           createSemaphore() override;
   std::unique_ptr<SwapChain>           createSwapChain(const SwapchainDesc& desc) override;
+  std::unique_ptr<MemoryHeap>          createMemoryHeap(const MemoryHeapDesc& desc) override;
+  std::unique_ptr<Texture>             createAliasedTexture(const TextureDesc& desc, MemoryHeap* heap, uint64_t offset) override;
+  MemoryRequirements                   getTextureMemoryRequirements(const TextureDesc& desc) override;
   // clang-format on
 
   void updateBuffer(Buffer* buffer, const void* data, size_t size, size_t offset = 0) override;
@@ -48,13 +53,22 @@ class DeviceDx12 : public Device {
    * The command buffer must already be in the "closed" state (end() - ID3D12GraphicsCommandList::Close() must have been
    * called)
    */
-  void submitCommandBuffer(CommandBuffer*                 cmdBuffer,
-                           Fence*                         signalFence      = nullptr,
-                           const std::vector<Semaphore*>& waitSemaphores   = {},
-                           const std::vector<Semaphore*>& signalSemaphores = {}) override;
+  void submitCommandBuffer(CommandBuffer*              cmdBuffer,
+                           Fence*                      signalFence      = nullptr,
+                           std::span<Semaphore* const> waitSemaphores   = {},
+                           std::span<Semaphore* const> signalSemaphores = {}) override;
 
   void waitIdle() override;
 
+  // DirectX 12 always exposes compute queues (hardware may still execute them on the same engine)
+  bool isAsyncComputeSupported() const override { return true; }
+
+  // ExecuteIndirect always accepts a count buffer
+  bool isDrawIndirectCountSupported() const override { return true; }
+
+  // ExecuteIndirect always honors StartInstanceLocation
+  bool isDrawIndirectFirstInstanceSupported() const override { return true; }
+
   IDXGIFactory6* getFactory() const { return m_factory_.Get(); }
 
   ID3D12Device* getDevice() const { return m_device_.Get(); }
@@ -63,6 +77,11 @@ class DeviceDx12 : public Device {
 
   ID3D12CommandQueue* getCommandQueue() const { return m_commandQueue_.Get(); }
 
+  ID3D12CommandQueue* getComputeCommandQueue() const { return m_computeCommandQueue_.Get(); }
+
+  // command signature of ExecuteIndirect with a single DispatchIndirectCommand argument
+  ID3D12CommandSignature* getDispatchCommandSignature() const { return m_dispatchCommandSignature_.Get(); }
+
   DescriptorHeapDx12* getCpuRtvHeap() { return &m_cpuRtvHeap; }
 
   DescriptorHeapDx12* getCpuDsvHeap() { return &m_cpuDsvHeap; }
@@ -73,8 +92,12 @@ class DeviceDx12 : public Device {
 
   DescriptorHeapDx12* getCpuSamplerHeap() { return &m_cpuSamplerHeap; }
 
-  void returnCommandAllocator(ID3D12CommandAllocator* allocator) {
-    m_commandAllocatorManager_.returnCommandAllocator(allocator);
+  void returnCommandAllocator(ID3D12CommandAllocator* allocator, QueueType queueType = QueueType::Graphics) {
+    if (queueType == QueueType::Compute) {
+      m_computeCommandAllocatorManager_.returnCommandAllocator(allocator);
+    } else {
+      m_commandAllocatorManager_.returnCommandAllocator(allocator);
+    }
   }
 
   private:
@@ -82,6 +105,7 @@ class DeviceDx12 : public Device {
   bool createDevice_();
   bool createCommandQueue_();
   bool createCommandPools_();
+  bool createCommandSignatures_();
   bool createDescriptorHeaps_();
   bool createAllocator_();
 
@@ -92,8 +116,11 @@ class DeviceDx12 : public Device {
   ComPtr<ID3D12Device>  m_device_;
 
   ComPtr<ID3D12CommandQueue> m_commandQueue_;
+  ComPtr<ID3D12CommandQueue> m_computeCommandQueue_;
   std::mutex                 m_queueSubmitMutex;
 
+  ComPtr<ID3D12CommandSignature> m_dispatchCommandSignature_;
+
   ComPtr<D3D12MA::Allocator> m_allocator_;
 
   DescriptorHeapDx12 m_cpuRtvHeap;
@@ -106,6 +133,7 @@ class DeviceDx12 : public Device {
   FrameResourcesManager m_frameResourcesManager;
 
   CommandAllocatorManager m_commandAllocatorManager_;
+  CommandAllocatorManager m_computeCommandAllocatorManager_;
 };
 
 }  // namespace rhi
@@ -267,6 +267,16 @@ gfx::rhi::ShaderMeta DxcUtil::reflectDxil_(const std::shared_ptr<IDxcBlob>& shad
       continue;
     }
 
+    // push constants are root constants on DX12, they are not part of any descriptor set
+    if (bindDesc.Type == D3D_SIT_CBUFFER && bindDesc.Space == gfx::rhi::kPushConstantRegisterSpace) {
+      ID3D12ShaderReflectionConstantBuffer* cbuffer = reflection->GetConstantBufferByName(bindDesc.Name);
+      D3D12_SHADER_BUFFER_DESC              bufferDesc;
+      if (cbuffer && SUCCEEDED(cbuffer->GetDesc(&bufferDesc))) {
+        meta.pushConstantSize = std::max(meta.pushConstantSize, static_cast<uint32_t>(bufferDesc.Size));
+      }
+      continue;
+    }
+
     gfx::rhi::ShaderResourceBinding binding;
     binding.name            = bindDesc.Name;
     binding.binding         = bindDesc.BindPoint;
@@ -329,7 +339,13 @@ gfx::rhi::ShaderMeta DxcUtil::reflectDxil_(const std::shared_ptr<IDxcBlob>& shad
             vertexInput.format = gfx::rhi::VertexFormat::Rgba32f;
           }
           break;
-          // TODO: add other types (int, uint) apart from float
+        // TODO: add vector integer formats (only scalars are needed for now)
+        case D3D_REGISTER_COMPONENT_UINT32:
+          vertexInput.format = gfx::rhi::VertexFormat::R32ui;
+          break;
+        case D3D_REGISTER_COMPONENT_SINT32:
+          vertexInput.format = gfx::rhi::VertexFormat::R32si;
+          break;
         default:
           vertexInput.format = gfx::rhi::VertexFormat::Rgba32f;
           break;
@@ -351,26 +367,6 @@ gfx::rhi::ShaderMeta DxcUtil::reflectDxil_(const std::shared_ptr<IDxcBlob>& shad
     LOG_INFO("Extracted {} vertex inputs total", meta.vertexInputs.size());
   }
 
-  // Extract push constants
-  for (UINT i = 0; i < shaderDesc.ConstantBuffers; ++i) {
-    ID3D12ShaderReflectionConstantBuffer* cbuffer = reflection->GetConstantBufferByIndex(i);
-    if (!cbuffer) {
-      continue;
-    }
-
-    D3D12_SHADER_BUFFER_DESC bufferDesc;
-    if (SUCCEEDED(cbuffer->GetDesc(&bufferDesc))) {
-      // Simple heuristic: if CB is named like push constants and size is small, treat as push constant
-      std::string cbName      = bufferDesc.Name ? bufferDesc.Name : "";
-      std::string lowerCbName = cbName;
-      std::transform(lowerCbName.begin(), lowerCbName.end(), lowerCbName.begin(), ::tolower);
-
-      if (lowerCbName.find("push") != std::string::npos) {
-        meta.pushConstantSize = std::max(meta.pushConstantSize, bufferDesc.Size);
-      }
-    }
-  }
-
   LOG_INFO("Extracted {} resource bindings from DXIL shader.", meta.bindings.size());
 
   return meta;
@@ -505,6 +501,12 @@ gfx::rhi::ShaderMeta DxcUtil::reflectSpirv_(const std::shared_ptr<IDxcBlob>& sha
                 }
                 break;
             }
+
+            // integer scalars
+            if ((typeDesc->type_flags & SPV_REFLECT_TYPE_FLAG_INT) && componentCount == 1) {
+              vertexInput.format = typeDesc->traits.numeric.scalar.signedness ? gfx::rhi::VertexFormat::R32si
+                                                                              : gfx::rhi::VertexFormat::R32ui;
+            }
           }
 
           // TODO: dirty solution - should be done in a more robust way
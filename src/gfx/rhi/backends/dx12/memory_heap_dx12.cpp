@@ -0,0 +1,45 @@
+#include "gfx/rhi/backends/dx12/memory_heap_dx12.h"
+
+#ifdef ARISE_USE_DX12
+
+#include "gfx/rhi/backends/dx12/device_dx12.h"
+#include "utils/logger/log.h"
+
+namespace arise {
+namespace gfx {
+namespace rhi {
+
+MemoryHeapDx12::MemoryHeapDx12(const MemoryHeapDesc& desc, DeviceDx12* device)
+    : MemoryHeap(desc)
+    , m_device_(device) {
+  D3D12MA::ALLOCATION_DESC allocationDesc = {};
+  allocationDesc.HeapType                 = D3D12_HEAP_TYPE_DEFAULT;
+  allocationDesc.ExtraHeapFlags           = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;  // resource heap tier 1
+
+  D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = {};
+  allocationInfo.SizeInBytes                    = desc.size;
+  allocationInfo.Alignment                      = desc.alignment;
+
+  HRESULT hr = m_device_->getAllocator()->AllocateMemory(&allocationDesc, &allocationInfo, &m_allocation_);
+
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to allocate memory heap '{}' ({} bytes)", desc.debugName, desc.size);
+    return;
+  }
+
+  if (!desc.debugName.empty()) {
+    // string -> wstring
+    int size = MultiByteToWideChar(CP_UTF8, 0, desc.debugName.c_str(), -1, nullptr, 0);
+    if (size > 0) {
+      std::wstring wideName(size, 0);
+      MultiByteToWideChar(CP_UTF8, 0, desc.debugName.c_str(), -1, &wideName[0], size);
+      m_allocation_->SetName(wideName.c_str());
+    }
+  }
+}
+
+}  // namespace rhi
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_USE_DX12
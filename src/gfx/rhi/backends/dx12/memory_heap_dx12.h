@@ -0,0 +1,38 @@
+#ifndef ARISE_MEMORY_HEAP_DX12_H
+#define ARISE_MEMORY_HEAP_DX12_H
+
+#include "gfx/rhi/interface/memory_heap.h"
+#include "platform/windows/windows_platform_setup.h"
+
+#include <D3D12MemAlloc.h>
+
+#ifdef ARISE_USE_DX12
+
+namespace arise {
+namespace gfx {
+namespace rhi {
+
+class DeviceDx12;
+
+class MemoryHeapDx12 : public MemoryHeap {
+  public:
+  MemoryHeapDx12(const MemoryHeapDesc& desc, DeviceDx12* device);
+  ~MemoryHeapDx12() override = default;
+
+  MemoryHeapDx12(const MemoryHeapDx12&)            = delete;
+  MemoryHeapDx12& operator=(const MemoryHeapDx12&) = delete;
+
+  // DirectX 12-specific methods
+  D3D12MA::Allocation* getAllocation() const { return m_allocation_.Get(); }
+
+  private:
+  DeviceDx12*                 m_device_;
+  ComPtr<D3D12MA::Allocation> m_allocation_;
+};
+
+}  // namespace rhi
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_USE_DX12
+#endif  // ARISE_MEMORY_HEAP_DX12_H
@@ -7,6 +7,7 @@
 #include "gfx/rhi/backends/dx12/render_pass_dx12.h"
 #include "gfx/rhi/backends/dx12/rhi_enums_dx12.h"
 #include "gfx/rhi/backends/dx12/shader_dx12.h"
+#include "gfx/rhi/shader_reflection/pipeline_utils.h"
 #include "utils/logger/log.h"
 
 #include <d3dcompiler.h>
@@ -15,6 +16,10 @@ namespace arise {
 namespace gfx {
 namespace rhi {
 
+//-------------------------------------------------------------------------
+// GraphicsPipelineDx12 implementation
+//-------------------------------------------------------------------------
+
 GraphicsPipelineDx12::GraphicsPipelineDx12(const GraphicsPipelineDesc& desc,
                                            const PipelineLayoutDesc&   reflectionLayout,
                                            DeviceDx12*                 device)
@@ -64,6 +69,46 @@ bool GraphicsPipelineDx12::initialize_() {
     return false;
   }
 
+  if (!createCommandSignature_()) {
+    LOG_ERROR("Failed to create draw indexed command signature for DX12 pipeline");
+    return false;
+  }
+
+  return true;
+}
+
+bool GraphicsPipelineDx12::createCommandSignature_() {
+  std::vector<D3D12_INDIRECT_ARGUMENT_DESC> argumentDescs;
+
+  // DrawIndexedIndirectCommand::drawConstant goes to the first push constant, so draws of one ExecuteIndirect can
+  // address different data. The constant argument changes a root parameter, hence the root signature is required
+  if (m_pushConstantSize_ > 0) {
+    D3D12_INDIRECT_ARGUMENT_DESC constantDesc     = {};
+    constantDesc.Type                             = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+    constantDesc.Constant.RootParameterIndex      = m_pushConstantRootIndex_;
+    constantDesc.Constant.DestOffsetIn32BitValues = 0;
+    constantDesc.Constant.Num32BitValuesToSet     = 1;
+    argumentDescs.push_back(constantDesc);
+  }
+
+  D3D12_INDIRECT_ARGUMENT_DESC drawDesc = {};
+  drawDesc.Type                         = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+  argumentDescs.push_back(drawDesc);
+
+  D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+  signatureDesc.ByteStride                   = sizeof(DrawIndexedIndirectCommand);
+  signatureDesc.NumArgumentDescs             = static_cast<UINT>(argumentDescs.size());
+  signatureDesc.pArgumentDescs               = argumentDescs.data();
+
+  ID3D12RootSignature* rootSignature = m_pushConstantSize_ > 0 ? m_rootSignature_.Get() : nullptr;
+
+  HRESULT hr = m_device_->getDevice()->CreateCommandSignature(
+      &signatureDesc, rootSignature, IID_PPV_ARGS(&m_drawIndexedCommandSignature_));
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to create draw indexed command signature");
+    return false;
+  }
+
   return true;
 }
 
@@ -90,6 +135,17 @@ bool GraphicsPipelineDx12::createRootSignature_() {
       return false;
     }
 
+    if (layout->isRootConstantBuffer()) {
+      D3D12_ROOT_PARAMETER rootParam      = {};
+      rootParam.ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
+      rootParam.ShaderVisibility          = determineShaderVisibility_(layout->getDesc().bindings);
+      rootParam.Descriptor.ShaderRegister = layout->getDesc().bindings[0].binding;
+      rootParam.Descriptor.RegisterSpace  = static_cast<UINT>(i);
+
+      rootParameters.push_back(rootParam);
+      continue;
+    }
+
     const auto& originalRanges = layout->getDescriptorRanges();
     if (originalRanges.empty()) {
       continue;
@@ -117,6 +173,21 @@ bool GraphicsPipelineDx12::createRootSignature_() {
     rootParameters.push_back(rootParam);
   }
 
+  // push constants are emulated with root constants, placed after the descriptor set parameters so the set
+  // indices used by bindDescriptorSet stay the same
+  m_pushConstantSize_ = pipeline_utils::getPushConstantSize(m_desc_.shaders);
+  if (m_pushConstantSize_ > 0) {
+    D3D12_ROOT_PARAMETER rootParam     = {};
+    rootParam.ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParam.ShaderVisibility         = D3D12_SHADER_VISIBILITY_ALL;
+    rootParam.Constants.ShaderRegister = 0;
+    rootParam.Constants.RegisterSpace  = kPushConstantRegisterSpace;
+    rootParam.Constants.Num32BitValues = m_pushConstantSize_ / 4;
+
+    m_pushConstantRootIndex_ = static_cast<uint32_t>(rootParameters.size());
+    rootParameters.push_back(rootParam);
+  }
+
   // TODO: add static samplers (if needed)
   std::vector<D3D12_STATIC_SAMPLER_DESC> staticSamplers;
 
@@ -408,6 +479,184 @@ D3D12_SHADER_VISIBILITY GraphicsPipelineDx12::determineShaderVisibility_(
   return g_getShaderVisibilityDx12(commonFlag);
 }
 
+//-------------------------------------------------------------------------
+// ComputePipelineDx12 implementation
+//-------------------------------------------------------------------------
+
+ComputePipelineDx12::ComputePipelineDx12(const ComputePipelineDesc& desc,
+                                         const PipelineLayoutDesc&  reflectionLayout,
+                                         DeviceDx12*                device)
+    : ComputePipeline(desc, reflectionLayout)
+    , m_device_(device) {
+  m_ownedLayouts_.reserve(desc.setLayouts.size());
+  std::vector<const DescriptorSetLayout*> ownedLayoutPtrs;
+  ownedLayoutPtrs.reserve(desc.setLayouts.size());
+
+  for (const auto* layout : desc.setLayouts) {
+    if (layout) {
+      auto copiedLayout = m_device_->createDescriptorSetLayout(layout->getDesc());
+      ownedLayoutPtrs.push_back(copiedLayout.get());
+      m_ownedLayouts_.push_back(std::move(copiedLayout));
+    } else {
+      ownedLayoutPtrs.push_back(nullptr);
+    }
+  }
+
+  m_desc_.setLayouts = ownedLayoutPtrs;
+
+  if (!initialize_()) {
+    LOG_ERROR("Failed to initialize DirectX 12 compute pipeline");
+  }
+}
+
+bool ComputePipelineDx12::rebuild() {
+  m_pipelineState_.Reset();
+  if (createPipelineState_()) {
+    LOG_INFO("Successfully rebuilt DirectX 12 compute pipeline");
+    m_updateFrame = -1;
+    return true;
+  } else {
+    LOG_ERROR("Failed to rebuild DirectX 12 compute pipeline");
+    return false;
+  }
+}
+
+bool ComputePipelineDx12::initialize_() {
+  if (!createRootSignature_()) {
+    LOG_ERROR("Failed to create root signature for DX12 compute pipeline");
+    return false;
+  }
+
+  if (!createPipelineState_()) {
+    LOG_ERROR("Failed to create pipeline state object for DX12 compute pipeline");
+    return false;
+  }
+
+  return true;
+}
+
+bool ComputePipelineDx12::createRootSignature_() {
+  // same parameter layout as the graphics root signature (one parameter per set, register space = set index),
+  // compute has a single stage so every parameter is visible to all
+  std::vector<D3D12_ROOT_PARAMETER> rootParameters;
+
+  std::vector<std::vector<D3D12_DESCRIPTOR_RANGE>> allRanges;
+  allRanges.reserve(m_desc_.setLayouts.size());
+
+  for (size_t i = 0; i < m_desc_.setLayouts.size(); ++i) {
+    const auto* layout = dynamic_cast<const DescriptorSetLayoutDx12*>(m_desc_.setLayouts[i]);
+    if (!layout) {
+      LOG_ERROR("Invalid descriptor set layout type for DX12 compute pipeline");
+      return false;
+    }
+
+    if (layout->isRootConstantBuffer()) {
+      D3D12_ROOT_PARAMETER rootParam      = {};
+      rootParam.ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
+      rootParam.ShaderVisibility          = D3D12_SHADER_VISIBILITY_ALL;
+      rootParam.Descriptor.ShaderRegister = layout->getDesc().bindings[0].binding;
+      rootParam.Descriptor.RegisterSpace  = static_cast<UINT>(i);
+
+      rootParameters.push_back(rootParam);
+      continue;
+    }
+
+    const auto& originalRanges = layout->getDescriptorRanges();
+    if (originalRanges.empty()) {
+      continue;
+    }
+
+    std::vector<D3D12_DESCRIPTOR_RANGE> newRanges;
+    newRanges.reserve(originalRanges.size());
+
+    for (const auto& originalRange : originalRanges) {
+      D3D12_DESCRIPTOR_RANGE newRange = originalRange;
+      newRange.RegisterSpace          = static_cast<UINT>(i);
+      newRanges.push_back(newRange);
+    }
+
+    allRanges.push_back(std::move(newRanges));
+
+    D3D12_ROOT_PARAMETER rootParam                = {};
+    rootParam.ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    rootParam.ShaderVisibility                    = D3D12_SHADER_VISIBILITY_ALL;
+    rootParam.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(allRanges.back().size());
+    rootParam.DescriptorTable.pDescriptorRanges   = allRanges.back().data();
+
+    rootParameters.push_back(rootParam);
+  }
+
+  m_pushConstantSize_ = pipeline_utils::getPushConstantSize({m_desc_.shader});
+  if (m_pushConstantSize_ > 0) {
+    D3D12_ROOT_PARAMETER rootParam     = {};
+    rootParam.ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParam.ShaderVisibility         = D3D12_SHADER_VISIBILITY_ALL;
+    rootParam.Constants.ShaderRegister = 0;
+    rootParam.Constants.RegisterSpace  = kPushConstantRegisterSpace;
+    rootParam.Constants.Num32BitValues = m_pushConstantSize_ / 4;
+
+    m_pushConstantRootIndex_ = static_cast<uint32_t>(rootParameters.size());
+    rootParameters.push_back(rootParam);
+  }
+
+  D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
+  rootSignatureDesc.NumParameters             = static_cast<UINT>(rootParameters.size());
+  rootSignatureDesc.pParameters               = rootParameters.empty() ? nullptr : rootParameters.data();
+  rootSignatureDesc.NumStaticSamplers         = 0;
+  rootSignatureDesc.pStaticSamplers           = nullptr;
+  rootSignatureDesc.Flags                     = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+  ComPtr<ID3DBlob> signature;
+  ComPtr<ID3DBlob> error;
+
+  HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+
+  if (FAILED(hr)) {
+    std::string errorMsg = "Failed to serialize compute root signature: ";
+    if (error) {
+      errorMsg += std::string(static_cast<const char*>(error->GetBufferPointer()), error->GetBufferSize());
+    }
+    LOG_ERROR(errorMsg);
+    return false;
+  }
+
+  hr = m_device_->getDevice()->CreateRootSignature(
+      0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&m_rootSignature_));
+
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to create compute root signature");
+    return false;
+  }
+
+  return true;
+}
+
+bool ComputePipelineDx12::createPipelineState_() {
+  ShaderDx12* shaderDx12 = dynamic_cast<ShaderDx12*>(m_desc_.shader);
+  if (!shaderDx12 || shaderDx12->getStage() != ShaderStageFlag::Compute) {
+    LOG_ERROR("DX12 compute pipeline requires a compute shader");
+    return false;
+  }
+
+  ID3DBlob* computeShader = shaderDx12->getShaderBlob();
+
+  D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
+  psoDesc.pRootSignature                    = m_rootSignature_.Get();
+  psoDesc.CS.pShaderBytecode                = computeShader->GetBufferPointer();
+  psoDesc.CS.BytecodeLength                 = computeShader->GetBufferSize();
+  psoDesc.NodeMask                          = 0;
+  psoDesc.Flags                             = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+  HRESULT hr = m_device_->getDevice()->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&m_pipelineState_));
+
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to create compute pipeline state object");
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
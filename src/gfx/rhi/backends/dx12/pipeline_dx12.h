@@ -39,11 +39,21 @@ class GraphicsPipelineDx12 : public GraphicsPipeline {
 
   ID3D12RootSignature* getRootSignature() const { return m_rootSignature_.Get(); }
 
+  // valid only if getPushConstantSize() > 0
+  uint32_t getPushConstantRootIndex() const { return m_pushConstantRootIndex_; }
+
+  /**
+   * Command signature of indexed indirect draws with this root signature (stride of DrawIndexedIndirectCommand).
+   * With push constants drawConstant is written into the first push constant, otherwise the arguments start after it
+   */
+  ID3D12CommandSignature* getDrawIndexedCommandSignature() const { return m_drawIndexedCommandSignature_.Get(); }
+
   private:
   bool initialize_();
 
   bool createRootSignature_();
   bool createPipelineState_();
+  bool createCommandSignature_();
 
   bool collectShaders_(ComPtr<ID3DBlob>& vertexShader,
                        ComPtr<ID3DBlob>& pixelShader,
@@ -55,8 +65,11 @@ class GraphicsPipelineDx12 : public GraphicsPipeline {
 
   DeviceDx12* m_device_;
 
-  ComPtr<ID3D12PipelineState> m_pipelineState_;
-  ComPtr<ID3D12RootSignature> m_rootSignature_;
+  ComPtr<ID3D12PipelineState>    m_pipelineState_;
+  ComPtr<ID3D12RootSignature>    m_rootSignature_;
+  ComPtr<ID3D12CommandSignature> m_drawIndexedCommandSignature_;
+
+  uint32_t m_pushConstantRootIndex_ = 0;
 
   // Store blend factors separately since D3D12 doesn't include them in the blend state
   std::array<float, 4> m_blendFactors_;
@@ -64,6 +77,42 @@ class GraphicsPipelineDx12 : public GraphicsPipeline {
   std::vector<std::unique_ptr<DescriptorSetLayout>> m_ownedLayouts_;  // to avoid dangling pointers
 };
 
+class ComputePipelineDx12 : public ComputePipeline {
+  public:
+  ComputePipelineDx12(const ComputePipelineDesc& desc,
+                      const PipelineLayoutDesc&  reflectionLayout,
+                      DeviceDx12*                device);
+  ~ComputePipelineDx12() = default;
+
+  ComputePipelineDx12(const ComputePipelineDx12&)            = delete;
+  ComputePipelineDx12& operator=(const ComputePipelineDx12&) = delete;
+
+  bool rebuild() override;
+
+  // DirectX 12-specific methods
+  ID3D12PipelineState* getPipelineState() const { return m_pipelineState_.Get(); }
+
+  ID3D12RootSignature* getRootSignature() const { return m_rootSignature_.Get(); }
+
+  // valid only if getPushConstantSize() > 0
+  uint32_t getPushConstantRootIndex() const { return m_pushConstantRootIndex_; }
+
+  private:
+  bool initialize_();
+
+  bool createRootSignature_();
+  bool createPipelineState_();
+
+  DeviceDx12* m_device_;
+
+  ComPtr<ID3D12PipelineState> m_pipelineState_;
+  ComPtr<ID3D12RootSignature> m_rootSignature_;
+
+  uint32_t m_pushConstantRootIndex_ = 0;
+
+  std::vector<std::unique_ptr<DescriptorSetLayout>> m_ownedLayouts_;  // to avoid dangling pointers
+};
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
@@ -224,7 +224,8 @@ static const std::unordered_map<ResourceLayout, D3D12_RESOURCE_STATES> resourceL
   { ResourceLayout::FragmentDensityMapExt,          D3D12_RESOURCE_STATE_COMMON                                                                                                   },
   { ResourceLayout::ReadOnly,                       D3D12_RESOURCE_STATE_GENERIC_READ                                                                                             },
   { ResourceLayout::Attachment,                     D3D12_RESOURCE_STATE_RENDER_TARGET                                                                                            },
-  { ResourceLayout::AccelerationStructure,          D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE                                                                        }
+  { ResourceLayout::AccelerationStructure,          D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE                                                                        },
+  { ResourceLayout::IndirectArgument,               D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT                                                                                        }
 };
 
 // clang-format on
@@ -128,6 +128,17 @@ void SemaphoreDx12::wait() {
   }
 }
 
+void SemaphoreDx12::wait(ID3D12CommandQueue* queue) {
+  if (m_value_ == 0) {
+    return;
+  }
+
+  HRESULT hr = queue->Wait(m_fence_.Get(), m_value_);
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to wait for DirectX12 semaphore on queue");
+  }
+}
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
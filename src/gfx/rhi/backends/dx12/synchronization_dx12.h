@@ -56,10 +56,12 @@ class SemaphoreDx12 : public Semaphore {
   // DirectX12-specific methods
   void signal(ID3D12CommandQueue* queue);
 
-  // TODO: not true GPU-GPU synchronization (currently CPU-GPU). consider either to wait/signal on queue or directly
-  // wait in command buffer
+  // CPU wait for the last signaled value
   void wait();
 
+  // GPU wait - work submitted to the queue afterwards starts once the last signaled value is reached
+  void wait(ID3D12CommandQueue* queue);
+
   private:
   DeviceDx12*         m_device_ = nullptr;
   ComPtr<ID3D12Fence> m_fence_;
@@ -5,6 +5,7 @@
 #include "gfx/rhi/backends/dx12/command_buffer_dx12.h"
 #include "gfx/rhi/backends/dx12/descriptor_dx12.h"
 #include "gfx/rhi/backends/dx12/device_dx12.h"
+#include "gfx/rhi/backends/dx12/memory_heap_dx12.h"
 #include "gfx/rhi/backends/dx12/rhi_enums_dx12.h"
 #include "gfx/rhi/backends/dx12/synchronization_dx12.h"
 #include "utils/logger/log.h"
@@ -23,15 +24,21 @@ TextureDx12::TextureDx12(const TextureDesc& desc, DeviceDx12* device)
     LOG_ERROR("Failed to create DirectX 12 texture");
   }
 
-  if (!desc.debugName.empty() && m_resource_) {
-    // string -> wstring
-    int size = MultiByteToWideChar(CP_UTF8, 0, desc.debugName.c_str(), -1, nullptr, 0);
-    if (size > 0) {
-      std::wstring wideName(size, 0);
-      MultiByteToWideChar(CP_UTF8, 0, desc.debugName.c_str(), -1, &wideName[0], size);
-      m_resource_->SetName(wideName.c_str());
-    }
+  setDebugName_();
+}
+
+TextureDx12::TextureDx12(const TextureDesc& desc, DeviceDx12* device, MemoryHeapDx12* heap, uint64_t heapOffset)
+    : Texture(desc)
+    , m_device_(device) {
+  m_dxgiFormat_ = g_getTextureFormatDx12(desc.format);
+
+  m_currentLayout_ = desc.initialLayout;
+
+  if (!createAliasedResource_(heap, heapOffset) || !createViews_()) {
+    LOG_ERROR("Failed to create aliased DirectX 12 texture");
   }
+
+  setDebugName_();
 }
 
 TextureDx12::TextureDx12(DeviceDx12*                 device,
@@ -83,8 +90,82 @@ TextureDx12::~TextureDx12() {
 
 bool TextureDx12::createResource_() {
   D3D12_RESOURCE_DESC resourceDesc = {};
+  if (!s_getResourceDesc(m_desc_, resourceDesc)) {
+    return false;
+  }
 
-  switch (m_desc_.type) {
+  D3D12MA::ALLOCATION_DESC allocationDesc = {};
+  allocationDesc.HeapType                 = D3D12_HEAP_TYPE_DEFAULT;  // Textures typically use DEFAULT heap
+
+  D3D12_CLEAR_VALUE  optimizedClearValue = {};
+  D3D12_CLEAR_VALUE* clearValue          = getOptimizedClearValue_(optimizedClearValue);
+
+  HRESULT hr = m_device_->getAllocator()->CreateResource(
+      &allocationDesc, &resourceDesc, getResourceState(), clearValue, &m_allocation_, IID_PPV_ARGS(&m_resource_));
+
+  if (FAILED(hr)) {
+    LOG_ERROR("Failed to create DirectX 12 texture resource with D3D12MA");
+    return false;
+  }
+
+  return true;
+}
+
+bool TextureDx12::createAliasedResource_(MemoryHeapDx12* heap, uint64_t heapOffset) {
+  if (!heap || !heap->getAllocation()) {
+    LOG_ERROR("Invalid memory heap for aliased texture");
+    return false;
+  }
+
+  D3D12_RESOURCE_DESC resourceDesc = {};
+  if (!s_getResourceDesc(m_desc_, resourceDesc)) {
+    return false;
+  }
+
+  D3D12_CLEAR_VALUE  optimizedClearValue = {};
+  D3D12_CLEAR_VALUE* clearValue          = getOptimizedClearValue_(optimizedClearValue);
+
+  // the heap allocation is shared, m_allocation_ stays null
+  HRESULT hr = m_device_->getAllocator()->CreateAliasingResource(
+      heap->getAllocation(), heapOffset, &resourceDesc, getResourceState(), clearValue, IID_PPV_ARGS(&m_resource_));
+
+  if (FAILED(hr)) {
+    LOG_ERROR(
+        "Failed to create aliased texture at offset {} of memory heap '{}'", heapOffset, heap->getDesc().debugName);
+    return false;
+  }
+
+  return true;
+}
+
+D3D12_CLEAR_VALUE* TextureDx12::getOptimizedClearValue_(D3D12_CLEAR_VALUE& optimizedClearValue) const {
+  if (hasRtvUsage()) {
+    optimizedClearValue.Format   = m_dxgiFormat_;
+    optimizedClearValue.Color[0] = 0.0f;
+    optimizedClearValue.Color[1] = 0.0f;
+    optimizedClearValue.Color[2] = 0.0f;
+    optimizedClearValue.Color[3] = 1.0f;
+    return &optimizedClearValue;
+  }
+
+  if (hasDsvUsage()) {
+    optimizedClearValue.Format               = m_dxgiFormat_;
+    optimizedClearValue.DepthStencil.Depth   = 1.0f;
+    optimizedClearValue.DepthStencil.Stencil = 0;
+    return &optimizedClearValue;
+  }
+
+  return nullptr;
+}
+
+bool TextureDx12::s_getResourceDesc(const TextureDesc& desc, D3D12_RESOURCE_DESC& resourceDesc) {
+  const bool hasRtvUsage = (desc.createFlags & TextureCreateFlag::Rtv) != TextureCreateFlag::None;
+  const bool hasDsvUsage = (desc.createFlags & TextureCreateFlag::Dsv) != TextureCreateFlag::None;
+  const bool hasUavUsage = (desc.createFlags & TextureCreateFlag::Uav) != TextureCreateFlag::None;
+
+  resourceDesc = {};
+
+  switch (desc.type) {
     case TextureType::Texture1D:
     case TextureType::Texture1DArray:
       resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
@@ -103,71 +184,46 @@ bool TextureDx12::createResource_() {
       return false;
   }
 
-  resourceDesc.Format           = m_dxgiFormat_;
-  resourceDesc.Width            = m_desc_.width;
-  resourceDesc.Height           = m_desc_.height;
-  resourceDesc.DepthOrArraySize = (m_desc_.type == TextureType::TextureCube)
+  resourceDesc.Format           = g_getTextureFormatDx12(desc.format);
+  resourceDesc.Width            = desc.width;
+  resourceDesc.Height           = desc.height;
+  resourceDesc.DepthOrArraySize = (desc.type == TextureType::TextureCube)
                                     ? 6
-                                    : ((m_desc_.type == TextureType::Texture3D) ? m_desc_.depth : m_desc_.arraySize);
-  resourceDesc.MipLevels        = m_desc_.mipLevels;
+                                    : ((desc.type == TextureType::Texture3D) ? desc.depth : desc.arraySize);
+  resourceDesc.MipLevels        = desc.mipLevels;
 
   resourceDesc.SampleDesc.Count   = 1;
   resourceDesc.SampleDesc.Quality = 0;
 
-  if (m_desc_.sampleCount == MSAASamples::Count2) {
+  if (desc.sampleCount == MSAASamples::Count2) {
     resourceDesc.SampleDesc.Count = 2;
-  } else if (m_desc_.sampleCount == MSAASamples::Count4) {
+  } else if (desc.sampleCount == MSAASamples::Count4) {
     resourceDesc.SampleDesc.Count = 4;
-  } else if (m_desc_.sampleCount == MSAASamples::Count8) {
+  } else if (desc.sampleCount == MSAASamples::Count8) {
     resourceDesc.SampleDesc.Count = 8;
-  } else if (m_desc_.sampleCount == MSAASamples::Count16) {
+  } else if (desc.sampleCount == MSAASamples::Count16) {
     resourceDesc.SampleDesc.Count = 16;
   }
 
   resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
   resourceDesc.Flags  = D3D12_RESOURCE_FLAG_NONE;
 
-  if (hasRtvUsage()) {
+  if (hasRtvUsage) {
     resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
   }
 
-  if (hasDsvUsage()) {
+  if (hasDsvUsage) {
     resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-  }
-
-  if (hasUavUsage()) {
-    resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-  }
-
-  D3D12MA::ALLOCATION_DESC allocationDesc = {};
-  allocationDesc.HeapType                 = D3D12_HEAP_TYPE_DEFAULT;  // Textures typically use DEFAULT heap
-
-  D3D12_CLEAR_VALUE* clearValue          = nullptr;
-  D3D12_CLEAR_VALUE  optimizedClearValue = {};
 
-  if (hasRtvUsage()) {
-    optimizedClearValue.Format   = m_dxgiFormat_;
-    optimizedClearValue.Color[0] = 0.0f;
-    optimizedClearValue.Color[1] = 0.0f;
-    optimizedClearValue.Color[2] = 0.0f;
-    optimizedClearValue.Color[3] = 1.0f;
-    clearValue                   = &optimizedClearValue;
-
-    optimizedClearValue.Format = m_dxgiFormat_;
-    clearValue                 = &optimizedClearValue;
-  } else if (hasDsvUsage()) {
-    optimizedClearValue.Format               = m_dxgiFormat_;
-    optimizedClearValue.DepthStencil.Depth   = 1.0f;
-    optimizedClearValue.DepthStencil.Stencil = 0;
-    clearValue                               = &optimizedClearValue;
+    // typeless resource, so the SRV can read the depth plane (the DSV keeps the depth format)
+    if (g_isDepthFormat(desc.format)) {
+      DXGI_FORMAT srvFormat;
+      g_getDepthFormatForSRV(resourceDesc.Format, srvFormat, g_getTextureFormatDx12(desc.format));
+    }
   }
 
-  HRESULT hr = m_device_->getAllocator()->CreateResource(
-      &allocationDesc, &resourceDesc, getResourceState(), clearValue, &m_allocation_, IID_PPV_ARGS(&m_resource_));
-
-  if (FAILED(hr)) {
-    LOG_ERROR("Failed to create DirectX 12 texture resource with D3D12MA");
-    return false;
+  if (hasUavUsage) {
+    resourceDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
   }
 
   return true;
@@ -610,6 +666,20 @@ void TextureDx12::update(const void* data, size_t dataSize, uint32_t mipLevel, u
   fence->wait();
 }
 
+void TextureDx12::setDebugName_() {
+  if (m_desc_.debugName.empty() || !m_resource_) {
+    return;
+  }
+
+  // string -> wstring
+  int size = MultiByteToWideChar(CP_UTF8, 0, m_desc_.debugName.c_str(), -1, nullptr, 0);
+  if (size > 0) {
+    std::wstring wideName(size, 0);
+    MultiByteToWideChar(CP_UTF8, 0, m_desc_.debugName.c_str(), -1, &wideName[0], size);
+    m_resource_->SetName(wideName.c_str());
+  }
+}
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
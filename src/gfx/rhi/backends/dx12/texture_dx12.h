@@ -14,6 +14,7 @@ namespace gfx {
 namespace rhi {
 
 class DeviceDx12;
+class MemoryHeapDx12;
 
 class TextureDx12 : public Texture {
   public:
@@ -27,6 +28,11 @@ class TextureDx12 : public Texture {
    * to free them when destroyed. The owner (SwapChain) remains responsible
    * for freeing these resources.
    */
+  /**
+   * Create a texture placed at heapOffset of the heap memory (aliased textures, see Device::createAliasedTexture)
+   */
+  TextureDx12(const TextureDesc& desc, DeviceDx12* device, MemoryHeapDx12* heap, uint64_t heapOffset);
+
   TextureDx12(DeviceDx12*                 device,
               const TextureDesc&          desc,
               ID3D12Resource*             existingResource,
@@ -59,14 +65,23 @@ class TextureDx12 : public Texture {
   // Updates texture data (for staging uploads)
   void update(const void* data, size_t dataSize, uint32_t mipLevel = 0, uint32_t arrayLayer = 0);
 
+  // resource description of a texture with the given desc (typeless format for depth textures)
+  static bool s_getResourceDesc(const TextureDesc& desc, D3D12_RESOURCE_DESC& resourceDesc);
+
   private:
   friend class CommandBufferDx12;
   // Only CommandBufferDx12 should update state through barriers
   void updateCurrentState_(ResourceLayout state);
 
   bool createResource_();
+  bool createAliasedResource_(MemoryHeapDx12* heap, uint64_t heapOffset);
   bool createViews_();
 
+  // fills the optimized clear value of render targets and depth-stencil textures, null for other textures
+  D3D12_CLEAR_VALUE* getOptimizedClearValue_(D3D12_CLEAR_VALUE& optimizedClearValue) const;
+
+  void setDebugName_();
+
   DeviceDx12* m_device_;
 
   ComPtr<ID3D12Resource>      m_resource_;
@@ -19,10 +19,8 @@ BufferVk::BufferVk(const BufferDesc& desc, DeviceVk* device)
     return;
   }
 
-  // If this is a CPU-accessible and dynamic buffer, the memory is already mapped by VMA
-  if ((memProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
-      && (m_desc_.type == BufferType::Dynamic
-          || ((m_desc_.createFlags & BufferCreateFlag::CpuAccess) != BufferCreateFlag::None))) {
+  // If this is a CPU-accessible, dynamic or readback buffer, the memory is already mapped by VMA
+  if ((memProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && isPersistentlyMapped_()) {
     if (m_allocationInfo_.pMappedData != nullptr) {
       m_mappedData_ = m_allocationInfo_.pMappedData;
       m_isMapped_   = true;
@@ -130,19 +128,31 @@ bool BufferVk::createBuffer_(VkBufferUsageFlags usage, VkMemoryPropertyFlags pro
   bufferInfo.usage              = usage;
   bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
 
+  // buffers written on the async compute queue and read on the graphics queue (or vice versa) are shared
+  // concurrently instead of transferring queue family ownership on every frame
+  QueueFamilyIndices indices              = m_device_->getQueueFamilyIndices();
+  uint32_t           queueFamilyIndices[] = {indices.graphicsFamily.value(), indices.computeFamily.value()};
+
+  if (m_device_->isAsyncComputeSupported()
+      && (usage & (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))) {
+    bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+    bufferInfo.queueFamilyIndexCount = 2;
+    bufferInfo.pQueueFamilyIndices   = queueFamilyIndices;
+  }
+
   VmaAllocationCreateInfo allocInfo = {};
 
   if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
-    if (properties & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) {
-      // For CPU reads (readback)
-      allocInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+    if ((m_desc_.createFlags & BufferCreateFlag::Readback) != BufferCreateFlag::None) {
+      // For CPU reads (readback) - cached memory is much faster to read, coherency spares the invalidates
+      allocInfo.usage          = VMA_MEMORY_USAGE_GPU_TO_CPU;
+      allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
     } else {
       // For CPU writes to GPU
       allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
     }
 
-    if (m_desc_.type == BufferType::Dynamic
-        || (m_desc_.createFlags & BufferCreateFlag::CpuAccess) != BufferCreateFlag::None) {
+    if (isPersistentlyMapped_()) {
       allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
     }
   } else {
@@ -160,12 +170,18 @@ bool BufferVk::createBuffer_(VkBufferUsageFlags usage, VkMemoryPropertyFlags pro
 VkBufferUsageFlags BufferVk::getBufferUsageFlags_() const {
   VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-  if ((m_desc_.createFlags & BufferCreateFlag::Readback) != BufferCreateFlag::None) {
+  // host-written buffers double as staging sources for copies into GPU-only buffers
+  if ((m_desc_.createFlags & (BufferCreateFlag::Readback | BufferCreateFlag::CpuAccess)) != BufferCreateFlag::None) {
     usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
   }
 
+  if ((m_desc_.createFlags & BufferCreateFlag::ConstantBuffer) != BufferCreateFlag::None) {
+    usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+  }
+
+  // geometry can be copied into shared buffers (merged geometry of indirect draws)
   if ((m_desc_.createFlags & BufferCreateFlag::VertexBuffer) != BufferCreateFlag::None) {
-    usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
   }
 
   if ((m_desc_.createFlags & BufferCreateFlag::InstanceBuffer) != BufferCreateFlag::None) {
@@ -173,11 +189,12 @@ VkBufferUsageFlags BufferVk::getBufferUsageFlags_() const {
   }
 
   if ((m_desc_.createFlags & BufferCreateFlag::IndexBuffer) != BufferCreateFlag::None) {
-    usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
   }
 
+  // GPU-written buffers can be copied into readback buffers
   if ((m_desc_.createFlags & BufferCreateFlag::Uav) != BufferCreateFlag::None) {
-    usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
   }
 
   if ((m_desc_.createFlags & BufferCreateFlag::ShaderResource) != BufferCreateFlag::None) {
@@ -228,12 +245,17 @@ VkMemoryPropertyFlags BufferVk::getMemoryPropertyFlags_() const {
   }
 
   if ((m_desc_.createFlags & BufferCreateFlag::Readback) != BufferCreateFlag::None) {
-    props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
   }
 
   return props;
 }
 
+bool BufferVk::isPersistentlyMapped_() const {
+  return m_desc_.type == BufferType::Dynamic
+      || (m_desc_.createFlags & (BufferCreateFlag::CpuAccess | BufferCreateFlag::Readback)) != BufferCreateFlag::None;
+}
+
 uint32_t BufferVk::findMemoryType_(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
   VkPhysicalDeviceMemoryProperties memProperties;
   vkGetPhysicalDeviceMemoryProperties(m_device_->getPhysicalDevice(), &memProperties);
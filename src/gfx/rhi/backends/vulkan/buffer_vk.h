@@ -25,7 +25,7 @@ class BufferVk : public Buffer {
 
   bool isMapped() const { return m_isMapped_; }
 
-  void* getMappedData() const { return m_mappedData_; }
+  void* getMappedData() const override { return m_mappedData_; }
 
   private:
   friend class DeviceVk;
@@ -41,6 +41,9 @@ class BufferVk : public Buffer {
 
   VkMemoryPropertyFlags getMemoryPropertyFlags_() const;
 
+  // dynamic, CPU-accessible and readback buffers stay mapped for their whole lifetime
+  bool isPersistentlyMapped_() const;
+
   uint32_t findMemoryType_(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
 
   DeviceVk*         m_device_     = nullptr;
@@ -13,6 +13,8 @@
 #include "utils/color/color.h"
 #include "utils/logger/log.h"
 
+#include <cstddef>
+
 namespace arise {
 namespace gfx {
 namespace rhi {
@@ -21,10 +23,14 @@ namespace rhi {
 // CommandBufferVk implementation
 //-------------------------------------------------------------------------
 
-CommandBufferVk::CommandBufferVk(DeviceVk* device, VkCommandBuffer commandBuffer, VkCommandPool commandPool)
+CommandBufferVk::CommandBufferVk(DeviceVk*       device,
+                                 VkCommandBuffer commandBuffer,
+                                 VkCommandPool   commandPool,
+                                 QueueType       queueType)
     : m_device_(device)
     , m_commandBuffer_(commandBuffer)
-    , m_commandPool_(commandPool) {
+    , m_commandPool_(commandPool)
+    , m_queueType_(queueType) {
 }
 
 void CommandBufferVk::begin() {
@@ -78,10 +84,11 @@ void CommandBufferVk::reset() {
     return;
   }
 
-  m_currentPipeline_    = nullptr;
-  m_currentRenderPass_  = nullptr;
-  m_currentFramebuffer_ = nullptr;
-  m_isRenderPassActive_ = false;
+  m_currentPipeline_       = nullptr;
+  m_currentPipelineLayout_ = VK_NULL_HANDLE;
+  m_currentRenderPass_     = nullptr;
+  m_currentFramebuffer_    = nullptr;
+  m_isRenderPassActive_    = false;
 }
 
 void CommandBufferVk::setPipeline(Pipeline* pipeline) {
@@ -90,29 +97,47 @@ void CommandBufferVk::setPipeline(Pipeline* pipeline) {
     return;
   }
 
-  auto pipelineVk = dynamic_cast<GraphicsPipelineVk*>(pipeline);
-  if (!pipelineVk) {
-    LOG_ERROR("Invalid pipeline type");
+  if (!pipeline) {
+    LOG_ERROR("Null pipeline");
     return;
   }
 
+  VkPipeline          vkPipeline       = VK_NULL_HANDLE;
+  VkPipelineLayout    vkPipelineLayout = VK_NULL_HANDLE;
   VkPipelineBindPoint bindPoint;
-  switch (pipelineVk->getType()) {
-    case PipelineType::Graphics:
-      bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  switch (pipeline->getType()) {
+    case PipelineType::Graphics: {
+      auto pipelineVk = dynamic_cast<GraphicsPipelineVk*>(pipeline);
+      if (!pipelineVk || m_queueType_ != QueueType::Graphics) {
+        LOG_ERROR("Invalid graphics pipeline type or queue");
+        return;
+      }
+      vkPipeline       = pipelineVk->getPipeline();
+      vkPipelineLayout = pipelineVk->getPipelineLayout();
+      bindPoint        = VK_PIPELINE_BIND_POINT_GRAPHICS;
       break;
-    case PipelineType::Compute:
-      bindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+    }
+    case PipelineType::Compute: {
+      auto pipelineVk = dynamic_cast<ComputePipelineVk*>(pipeline);
+      if (!pipelineVk) {
+        LOG_ERROR("Invalid compute pipeline type");
+        return;
+      }
+      vkPipeline       = pipelineVk->getPipeline();
+      vkPipelineLayout = pipelineVk->getPipelineLayout();
+      bindPoint        = VK_PIPELINE_BIND_POINT_COMPUTE;
       break;
+    }
     default:
       LOG_ERROR("Invalid pipeline type");
       return;
   }
 
-  vkCmdBindPipeline(m_commandBuffer_, bindPoint, pipelineVk->getPipeline());
+  vkCmdBindPipeline(m_commandBuffer_, bindPoint, vkPipeline);
 
-  m_currentPipeline_  = pipelineVk;
-  m_currentBindPoint_ = bindPoint;
+  m_currentPipeline_       = pipeline;
+  m_currentPipelineLayout_ = vkPipelineLayout;
+  m_currentBindPoint_      = bindPoint;
 }
 
 void CommandBufferVk::setViewport(const Viewport& viewport) {
@@ -180,6 +205,12 @@ void CommandBufferVk::bindIndexBuffer(Buffer* buffer, uint64_t offset, bool use3
 }
 
 void CommandBufferVk::bindDescriptorSet(uint32_t setIndex, DescriptorSet* set) {
+  bindDescriptorSet(setIndex, set, {});
+}
+
+void CommandBufferVk::bindDescriptorSet(uint32_t                     setIndex,
+                                        DescriptorSet*               set,
+                                        const std::vector<uint32_t>& dynamicOffsets) {
   if (!m_isRecording_) {
     LOG_ERROR("Command buffer is not recording");
     return;
@@ -200,15 +231,58 @@ void CommandBufferVk::bindDescriptorSet(uint32_t setIndex, DescriptorSet* set) {
     return;
   }
 
+  // Vulkan requires exactly one offset per dynamic binding
+  const uint32_t dynamicBindingCount = descriptorSetVk->getLayoutVk()->getDynamicBindingCount();
+
+  std::vector<uint32_t> zeroOffsets;
+  const auto*           offsets = &dynamicOffsets;
+  if (dynamicOffsets.size() != dynamicBindingCount) {
+    if (!dynamicOffsets.empty()) {
+      LOG_ERROR("Descriptor set has {} dynamic bindings, but {} dynamic offsets were provided",
+                dynamicBindingCount,
+                dynamicOffsets.size());
+      return;
+    }
+    zeroOffsets.resize(dynamicBindingCount, 0);
+    offsets = &zeroOffsets;
+  }
+
   VkDescriptorSet vkDescriptorSet = descriptorSetVk->getDescriptorSet();
   vkCmdBindDescriptorSets(m_commandBuffer_,
                           m_currentBindPoint_,
-                          m_currentPipeline_->getPipelineLayout(),
+                          m_currentPipelineLayout_,
                           setIndex,
                           1,
                           &vkDescriptorSet,
-                          0,
-                          nullptr);
+                          static_cast<uint32_t>(offsets->size()),
+                          offsets->empty() ? nullptr : offsets->data());
+}
+
+void CommandBufferVk::pushConstants(const void* data, uint32_t size, uint32_t offset) {
+  if (!m_isRecording_) {
+    LOG_ERROR("Command buffer is not recording");
+    return;
+  }
+
+  if (!m_currentPipeline_) {
+    LOG_ERROR("No active pipeline");
+    return;
+  }
+
+  if (offset + size > m_currentPipeline_->getPushConstantSize() || (size | offset) % 4 != 0) {
+    LOG_ERROR("Push constant range [{}, {}) doesn't match the {} bytes block of the current pipeline",
+              offset,
+              offset + size,
+              m_currentPipeline_->getPushConstantSize());
+    return;
+  }
+
+  // must match the stage flags of the push constant range in the pipeline layout
+  const VkShaderStageFlags stageFlags = m_currentBindPoint_ == VK_PIPELINE_BIND_POINT_COMPUTE
+                                        ? VK_SHADER_STAGE_COMPUTE_BIT
+                                        : VK_SHADER_STAGE_ALL_GRAPHICS;
+
+  vkCmdPushConstants(m_commandBuffer_, m_currentPipelineLayout_, stageFlags, offset, size, data);
 }
 
 void CommandBufferVk::draw(uint32_t vertexCount, uint32_t firstVertex) {
@@ -251,33 +325,201 @@ void CommandBufferVk::drawIndexedInstanced(
   vkCmdDrawIndexed(m_commandBuffer_, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+void CommandBufferVk::drawIndexedIndirect(Buffer* buffer, uint64_t offset) {
+  multiDrawIndexedIndirect(buffer, offset, 1);
+}
+
+void CommandBufferVk::multiDrawIndexedIndirect(Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride) {
+  if (!m_isRecording_ || !m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is not active");
+    return;
+  }
+
+  BufferVk* bufferVk = dynamic_cast<BufferVk*>(buffer);
+  if (!bufferVk) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  const VkDeviceSize argumentOffset = offset + offsetof(DrawIndexedIndirectCommand, indexCount);
+
+  if (drawCount <= 1 || m_device_->isMultiDrawIndirectSupported()) {
+    vkCmdDrawIndexedIndirect(m_commandBuffer_, bufferVk->getBuffer(), argumentOffset, drawCount, stride);
+    return;
+  }
+
+  // without the multiDrawIndirect feature drawCount must be 0 or 1
+  for (uint32_t drawIndex = 0; drawIndex < drawCount; ++drawIndex) {
+    vkCmdDrawIndexedIndirect(
+        m_commandBuffer_, bufferVk->getBuffer(), argumentOffset + uint64_t(drawIndex) * stride, 1, stride);
+  }
+}
+
+void CommandBufferVk::multiDrawIndexedIndirectCount(Buffer*  buffer,
+                                                    uint64_t offset,
+                                                    Buffer*  countBuffer,
+                                                    uint64_t countOffset,
+                                                    uint32_t maxDrawCount,
+                                                    uint32_t stride) {
+  if (!m_isRecording_ || !m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is not active");
+    return;
+  }
+
+  if (!m_device_->isDrawIndirectCountSupported()) {
+    LOG_ERROR("drawIndirectCount is not supported by the device");
+    return;
+  }
+
+  BufferVk* bufferVk      = dynamic_cast<BufferVk*>(buffer);
+  BufferVk* countBufferVk = dynamic_cast<BufferVk*>(countBuffer);
+  if (!bufferVk || !countBufferVk) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  vkCmdDrawIndexedIndirectCount(m_commandBuffer_,
+                                bufferVk->getBuffer(),
+                                offset + offsetof(DrawIndexedIndirectCommand, indexCount),
+                                countBufferVk->getBuffer(),
+                                countOffset,
+                                maxDrawCount,
+                                stride);
+}
+
+void CommandBufferVk::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+  if (!m_isRecording_ || m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is active");
+    return;
+  }
+
+  if (!m_currentPipeline_ || m_currentPipeline_->getType() != PipelineType::Compute) {
+    LOG_ERROR("No active compute pipeline");
+    return;
+  }
+
+  vkCmdDispatch(m_commandBuffer_, groupCountX, groupCountY, groupCountZ);
+}
+
+void CommandBufferVk::dispatchIndirect(Buffer* buffer, uint64_t offset) {
+  if (!m_isRecording_ || m_isRenderPassActive_) {
+    LOG_ERROR("Command buffer is not recording or render pass is active");
+    return;
+  }
+
+  if (!m_currentPipeline_ || m_currentPipeline_->getType() != PipelineType::Compute) {
+    LOG_ERROR("No active compute pipeline");
+    return;
+  }
+
+  BufferVk* bufferVk = dynamic_cast<BufferVk*>(buffer);
+  if (!bufferVk) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  vkCmdDispatchIndirect(m_commandBuffer_, bufferVk->getBuffer(), offset);
+}
+
 void CommandBufferVk::resourceBarrier(const ResourceBarrierDesc& barrier) {
   if (!m_isRecording_) {
     LOG_ERROR("Command buffer is not recording");
     return;
   }
 
+  if (barrier.buffer) {
+    bufferBarrier_(barrier);
+    return;
+  }
+
   if (!barrier.texture) {
     LOG_ERROR("Null texture");
     return;
   }
 
+  if (barrier.oldLayout == ResourceLayout::Uav && barrier.newLayout == ResourceLayout::Uav) {
+    uavBarrier_(barrier);
+    return;
+  }
+
+  VkImageMemoryBarrier imageBarrier = {};
+  VkPipelineStageFlags srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+  VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+  if (getImageBarrier_(barrier, imageBarrier, srcStageMask, dstStageMask)) {
+    vkCmdPipelineBarrier(m_commandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+  }
+}
+
+void CommandBufferVk::resourceBarriers(const std::vector<ResourceBarrierDesc>& barriers) {
+  if (!m_isRecording_) {
+    LOG_ERROR("Command buffer is not recording");
+    return;
+  }
+
+  std::vector<VkImageMemoryBarrier> imageBarriers;
+  imageBarriers.reserve(barriers.size());
+
+  VkPipelineStageFlags srcStageMask = 0;
+  VkPipelineStageFlags dstStageMask = 0;
+
+  for (const auto& barrier : barriers) {
+    // buffer and UAV barriers are recorded one by one, the batch only merges image layout transitions
+    if (!barrier.texture || barrier.buffer
+        || (barrier.oldLayout == ResourceLayout::Uav && barrier.newLayout == ResourceLayout::Uav)) {
+      resourceBarrier(barrier);
+      continue;
+    }
+
+    VkImageMemoryBarrier imageBarrier     = {};
+    VkPipelineStageFlags barrierSrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkPipelineStageFlags barrierDstStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+    if (getImageBarrier_(barrier, imageBarrier, barrierSrcStages, barrierDstStages)) {
+      imageBarriers.push_back(imageBarrier);
+      srcStageMask |= barrierSrcStages;
+      dstStageMask |= barrierDstStages;
+    }
+  }
+
+  if (imageBarriers.empty()) {
+    return;
+  }
+
+  vkCmdPipelineBarrier(m_commandBuffer_,
+                       srcStageMask,
+                       dstStageMask,
+                       0,
+                       0,
+                       nullptr,
+                       0,
+                       nullptr,
+                       static_cast<uint32_t>(imageBarriers.size()),
+                       imageBarriers.data());
+}
+
+bool CommandBufferVk::getImageBarrier_(const ResourceBarrierDesc& barrier,
+                                       VkImageMemoryBarrier&      imageBarrier,
+                                       VkPipelineStageFlags&      srcStageMask,
+                                       VkPipelineStageFlags&      dstStageMask) {
   TextureVk* textureVk = dynamic_cast<TextureVk*>(barrier.texture);
   if (!textureVk) {
     LOG_ERROR("Invalid texture type");
-    return;
+    return false;
   }
 
-  VkImageLayout oldLayout = g_getImageLayoutVk(barrier.oldLayout);
+  // discarded contents don't need to be preserved by the transition
+  VkImageLayout oldLayout = barrier.discard ? VK_IMAGE_LAYOUT_UNDEFINED : g_getImageLayoutVk(barrier.oldLayout);
   VkImageLayout newLayout = g_getImageLayoutVk(barrier.newLayout);
 
   if (oldLayout == newLayout) {
     // TODO: uncomment this if needed
     // LOG_WARN("Skipping redundant barrier, states are identical");
-    return;
+    return false;
   }
 
-  VkImageMemoryBarrier imageBarrier = {};
+  imageBarrier = {};
+
   imageBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
   imageBarrier.oldLayout            = oldLayout;
   imageBarrier.newLayout            = newLayout;
@@ -328,8 +570,14 @@ void CommandBufferVk::resourceBarrier(const ResourceBarrierDesc& barrier) {
     imageBarrier.dstAccessMask = 0;
   }
 
-  VkPipelineStageFlags srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-  VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+  srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+  dstStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+  // sampled textures are read by fragment and compute shaders, compute queues only have the compute stage
+  const VkPipelineStageFlags shaderReadStages
+      = m_queueType_ == QueueType::Compute
+          ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+          : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 
   if (imageBarrier.srcAccessMask & VK_ACCESS_TRANSFER_WRITE_BIT) {
     srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
@@ -340,7 +588,7 @@ void CommandBufferVk::resourceBarrier(const ResourceBarrierDesc& barrier) {
   } else if (imageBarrier.srcAccessMask & VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT) {
     srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
   } else if (imageBarrier.srcAccessMask & VK_ACCESS_SHADER_READ_BIT) {
-    srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    srcStageMask = shaderReadStages;
   }
 
   if (imageBarrier.dstAccessMask & VK_ACCESS_TRANSFER_WRITE_BIT) {
@@ -353,14 +601,106 @@ void CommandBufferVk::resourceBarrier(const ResourceBarrierDesc& barrier) {
              & (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)) {
     dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
   } else if (imageBarrier.dstAccessMask & VK_ACCESS_SHADER_READ_BIT) {
-    dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dstStageMask = shaderReadStages;
   } else if (newLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR) {
     dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
   }
 
-  vkCmdPipelineBarrier(m_commandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
-
   textureVk->updateCurrentLayout_(barrier.newLayout);
+  return true;
+}
+
+void CommandBufferVk::bufferBarrier_(const ResourceBarrierDesc& barrier) {
+  BufferVk* bufferVk = dynamic_cast<BufferVk*>(barrier.buffer);
+  if (!bufferVk) {
+    LOG_ERROR("Invalid buffer type");
+    return;
+  }
+
+  VkBufferMemoryBarrier bufferBarrier = {};
+  bufferBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+  bufferBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+  bufferBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
+  bufferBarrier.buffer                = bufferVk->getBuffer();
+  bufferBarrier.offset                = 0;
+  bufferBarrier.size                  = VK_WHOLE_SIZE;
+
+  VkPipelineStageFlags srcStageMask = 0;
+  VkPipelineStageFlags dstStageMask = 0;
+  getAccessAndStages_(barrier.oldLayout, bufferBarrier.srcAccessMask, srcStageMask);
+  getAccessAndStages_(barrier.newLayout, bufferBarrier.dstAccessMask, dstStageMask);
+
+  vkCmdPipelineBarrier(m_commandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+}
+
+void CommandBufferVk::uavBarrier_(const ResourceBarrierDesc& barrier) {
+  TextureVk* textureVk = dynamic_cast<TextureVk*>(barrier.texture);
+  if (!textureVk) {
+    LOG_ERROR("Invalid texture type");
+    return;
+  }
+
+  // storage images stay in the general layout, the barrier only orders the shader accesses
+  VkImageMemoryBarrier imageBarrier            = {};
+  imageBarrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  imageBarrier.oldLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+  imageBarrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+  imageBarrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+  imageBarrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+  imageBarrier.image                           = textureVk->getImage();
+  imageBarrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+  imageBarrier.subresourceRange.baseMipLevel   = 0;
+  imageBarrier.subresourceRange.levelCount     = textureVk->getMipLevels();
+  imageBarrier.subresourceRange.baseArrayLayer = 0;
+  imageBarrier.subresourceRange.layerCount     = textureVk->getArraySize();
+
+  VkPipelineStageFlags stageMask = 0;
+  getAccessAndStages_(ResourceLayout::Uav, imageBarrier.dstAccessMask, stageMask);
+  imageBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+
+  vkCmdPipelineBarrier(m_commandBuffer_, stageMask, stageMask, 0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+}
+
+void CommandBufferVk::getAccessAndStages_(ResourceLayout        layout,
+                                          VkAccessFlags&        accessMask,
+                                          VkPipelineStageFlags& stageMask) const {
+  // compute queues don't support graphics stages
+  const VkPipelineStageFlags shaderStages
+      = m_queueType_ == QueueType::Compute
+          ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+          : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+                | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+  switch (layout) {
+    case ResourceLayout::Undefined:
+      accessMask = 0;
+      stageMask  = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+      break;
+    case ResourceLayout::Uav:
+      accessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+      stageMask  = shaderStages;
+      break;
+    case ResourceLayout::ShaderReadOnly:
+      accessMask = VK_ACCESS_SHADER_READ_BIT;
+      stageMask  = shaderStages;
+      break;
+    case ResourceLayout::IndirectArgument:
+      accessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+      stageMask  = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+      break;
+    case ResourceLayout::TransferSrc:
+      accessMask = VK_ACCESS_TRANSFER_READ_BIT;
+      stageMask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+      break;
+    case ResourceLayout::TransferDst:
+      accessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      stageMask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+      break;
+    default:
+      accessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+      stageMask  = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+      break;
+  }
 }
 
 void CommandBufferVk::beginRenderPass(RenderPass*                    renderPass,
@@ -631,10 +971,15 @@ void CommandBufferVk::copyTexture(Texture* srcTexture,
   region.dstSubresource.baseArrayLayer = dstArrayLayer;
   region.dstSubresource.layerCount     = 1;
 
-  // full sub‑resource
-  region.extent.width  = std::max<uint32_t>(1, dstTexVk->getWidth() >> dstMipLevel);
-  region.extent.height = std::max<uint32_t>(1, dstTexVk->getHeight() >> dstMipLevel);
-  region.extent.depth  = std::max<uint32_t>(1, dstTexVk->getDepth() >> dstMipLevel);
+  // region both sub-resources cover, starting at the top-left corner (render targets may be larger than the
+  // back buffer they are copied to)
+  const uint32_t copyWidth  = std::min(srcTexVk->getWidth() >> srcMipLevel, dstTexVk->getWidth() >> dstMipLevel);
+  const uint32_t copyHeight = std::min(srcTexVk->getHeight() >> srcMipLevel, dstTexVk->getHeight() >> dstMipLevel);
+  const uint32_t copyDepth  = std::min(srcTexVk->getDepth() >> srcMipLevel, dstTexVk->getDepth() >> dstMipLevel);
+
+  region.extent.width  = std::max<uint32_t>(1, copyWidth);
+  region.extent.height = std::max<uint32_t>(1, copyHeight);
+  region.extent.depth  = std::max<uint32_t>(1, copyDepth);
 
   vkCmdCopyImage(m_commandBuffer_,
                  srcTexVk->getImage(),
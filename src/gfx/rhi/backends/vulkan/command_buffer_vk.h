@@ -13,6 +13,7 @@ namespace rhi {
 
 class DeviceVk;
 class GraphicsPipelineVk;
+class ComputePipelineVk;
 class BufferVk;
 class TextureVk;
 class DescriptorSetVk;
@@ -28,7 +29,7 @@ class FramebufferVk;
  */
 class CommandBufferVk : public CommandBuffer {
   public:
-  CommandBufferVk(DeviceVk* device, VkCommandBuffer commandBuffer, VkCommandPool commandPool);
+  CommandBufferVk(DeviceVk* device, VkCommandBuffer commandBuffer, VkCommandPool commandPool, QueueType queueType = QueueType::Graphics);
   ~CommandBufferVk() = default;
 
   // Command buffer recording
@@ -46,6 +47,12 @@ class CommandBufferVk : public CommandBuffer {
   void bindIndexBuffer(Buffer* buffer, uint64_t offset = 0, bool use32BitIndices = false) override;
   // @param setIndex: Descriptor set slot as declared in the shader (e.g. "layout(set = N, ...)" in GLSL).
   void bindDescriptorSet(uint32_t setIndex, DescriptorSet* set) override;
+  // Sets with dynamic bindings that are bound without offsets read from the start of their buffers
+  void bindDescriptorSet(uint32_t setIndex, DescriptorSet* set, const std::vector<uint32_t>& dynamicOffsets) override;
+
+  // Push constants
+  using CommandBuffer::pushConstants;
+  void pushConstants(const void* data, uint32_t size, uint32_t offset = 0) override;
 
   // Draw commands
   void draw(uint32_t vertexCount, uint32_t firstVertex = 0) override;
@@ -53,8 +60,18 @@ class CommandBufferVk : public CommandBuffer {
   void drawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
   void drawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
 
+  // Indirect draws (drawConstant of DrawIndexedIndirectCommand is skipped - arguments are read from offset + 4)
+  void drawIndexedIndirect(Buffer* buffer, uint64_t offset = 0) override;
+  void multiDrawIndexedIndirect(Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+  void multiDrawIndexedIndirectCount(Buffer* buffer, uint64_t offset, Buffer* countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+  // Compute dispatch
+  void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) override;
+  void dispatchIndirect(Buffer* buffer, uint64_t offset = 0) override;
+
   // Resource barriers
   void resourceBarrier(const ResourceBarrierDesc& barrier) override;
+  void resourceBarriers(const std::vector<ResourceBarrierDesc>& barriers) override;
 
   // Render pass operations
   void beginRenderPass(RenderPass* renderPass, Framebuffer* framebuffer, const std::vector<ClearValue>& clearValues) override;
@@ -78,18 +95,31 @@ class CommandBufferVk : public CommandBuffer {
   // Vulkan-specific methods
   const VkCommandBuffer& getCommandBuffer() const { return m_commandBuffer_; }
 
+  QueueType getQueueType() const { return m_queueType_; }
+
   private:
+  void bufferBarrier_(const ResourceBarrierDesc& barrier);
+  void uavBarrier_(const ResourceBarrierDesc& barrier);
+
+  // fills the layout transition of a texture barrier and updates the tracked layout, false if nothing to record
+  bool getImageBarrier_(const ResourceBarrierDesc& barrier, VkImageMemoryBarrier& imageBarrier, VkPipelineStageFlags& srcStageMask, VkPipelineStageFlags& dstStageMask);
+
+  // access and pipeline stages of a buffer / UAV in the given layout, limited to the stages of the queue
+  void getAccessAndStages_(ResourceLayout layout, VkAccessFlags& accessMask, VkPipelineStageFlags& stageMask) const;
+
   DeviceVk*       m_device_;
   VkCommandBuffer m_commandBuffer_;
   VkCommandPool   m_commandPool_;
+  QueueType       m_queueType_;
 
   // Current state tracking
-  GraphicsPipelineVk* m_currentPipeline_    = nullptr;
-  RenderPassVk*       m_currentRenderPass_  = nullptr;
-  FramebufferVk*      m_currentFramebuffer_ = nullptr;
-  bool                m_isRenderPassActive_ = false;
-  bool                m_isRecording_        = false;
-  VkPipelineBindPoint m_currentBindPoint_   = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  Pipeline*           m_currentPipeline_       = nullptr;
+  VkPipelineLayout    m_currentPipelineLayout_ = VK_NULL_HANDLE;
+  RenderPassVk*       m_currentRenderPass_     = nullptr;
+  FramebufferVk*      m_currentFramebuffer_    = nullptr;
+  bool                m_isRenderPassActive_    = false;
+  bool                m_isRecording_           = false;
+  VkPipelineBindPoint m_currentBindPoint_      = VK_PIPELINE_BIND_POINT_GRAPHICS;
 };
 
 // clang-format on
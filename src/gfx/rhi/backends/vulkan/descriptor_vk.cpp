@@ -32,9 +32,19 @@ DescriptorSetLayoutVk::DescriptorSetLayoutVk(const DescriptorSetLayoutDesc& desc
     layoutBindings.push_back(vkBinding);
   }
 
-  // Add binding flags to allow updating descriptor sets while in use
+  // Add binding flags to allow updating descriptor sets while in use (not allowed for dynamic buffers)
   std::vector<VkDescriptorBindingFlags> bindingFlags(layoutBindings.size(),
                                                      VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT);
+  for (size_t i = 0; i < layoutBindings.size(); ++i) {
+    if (layoutBindings[i].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+        || layoutBindings[i].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) {
+      bindingFlags[i]        = 0;
+      m_dynamicBindingCount_ += layoutBindings[i].descriptorCount;
+    } else if (layoutBindings[i].descriptorCount > 1) {
+      // bindless arrays: elements that no shader reads don't have to be written
+      bindingFlags[i] |= VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+    }
+  }
 
   VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
   bindingFlagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
@@ -60,6 +70,16 @@ DescriptorSetLayoutVk::~DescriptorSetLayoutVk() {
   }
 }
 
+bool DescriptorSetLayoutVk::isDynamicBinding(uint32_t binding) const {
+  for (const auto& bindingDesc : m_desc_.bindings) {
+    if (bindingDesc.binding == binding) {
+      return bindingDesc.type == ShaderBindingType::UniformbufferDynamic
+          || bindingDesc.type == ShaderBindingType::BufferUavDynamic;
+    }
+  }
+  return false;
+}
+
 //-------------------------------------------------------------------------
 // DescriptorSetVk implementation
 //-------------------------------------------------------------------------
@@ -90,6 +110,9 @@ void DescriptorSetVk::setUniformBuffer(uint32_t binding, Buffer* buffer, uint64_
     return;
   }
 
+  // for dynamic bindings the range is the size of one sub-allocation, the bind time offset selects which one
+  const bool isDynamic = m_layout_->isDynamicBinding(binding);
+
   VkDescriptorBufferInfo bufferInfo = {};
   bufferInfo.buffer                 = bufferVk->getBuffer();
   bufferInfo.offset                 = offset;
@@ -100,7 +123,8 @@ void DescriptorSetVk::setUniformBuffer(uint32_t binding, Buffer* buffer, uint64_
   descriptorWrite.dstSet               = m_descriptorSet_;
   descriptorWrite.dstBinding           = binding;
   descriptorWrite.dstArrayElement      = 0;
-  descriptorWrite.descriptorType       = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  descriptorWrite.descriptorType
+      = isDynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
   descriptorWrite.descriptorCount      = 1;
   descriptorWrite.pBufferInfo          = &bufferInfo;
 
@@ -123,7 +147,7 @@ void DescriptorSetVk::setTextureSampler(uint32_t binding, Texture* texture, Samp
 
   VkDescriptorImageInfo imageInfo = {};
   imageInfo.imageLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-  imageInfo.imageView             = textureVk->getImageView();
+  imageInfo.imageView             = textureVk->getSampledImageView();
   imageInfo.sampler               = samplerVk->getSampler();
 
   VkWriteDescriptorSet descriptorWrite = {};
@@ -139,6 +163,13 @@ void DescriptorSetVk::setTextureSampler(uint32_t binding, Texture* texture, Samp
 }
 
 void DescriptorSetVk::setTexture(uint32_t binding, Texture* texture, ResourceLayout layout) {
+  setTextureArrayElement(binding, 0, texture, layout);
+}
+
+void DescriptorSetVk::setTextureArrayElement(uint32_t       binding,
+                                             uint32_t       arrayElement,
+                                             Texture*       texture,
+                                             ResourceLayout layout) {
   if (!texture) {
     LOG_ERROR("Null texture in setTexture");
     return;
@@ -150,16 +181,26 @@ void DescriptorSetVk::setTexture(uint32_t binding, Texture* texture, ResourceLay
     return;
   }
 
+  for (const auto& bindingDesc : m_layout_->getDesc().bindings) {
+    if (bindingDesc.binding == binding && arrayElement >= bindingDesc.descriptorCount) {
+      LOG_ERROR("Array element {} is out of range of binding {} ({} descriptors)",
+                arrayElement,
+                binding,
+                bindingDesc.descriptorCount);
+      return;
+    }
+  }
+
   VkDescriptorImageInfo imageInfo = {};
   imageInfo.imageLayout           = g_getImageLayoutVk(layout);
-  imageInfo.imageView             = textureVk->getImageView();
+  imageInfo.imageView             = textureVk->getSampledImageView();
   imageInfo.sampler               = VK_NULL_HANDLE;
 
   VkWriteDescriptorSet descriptorWrite = {};
   descriptorWrite.sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
   descriptorWrite.dstSet               = m_descriptorSet_;
   descriptorWrite.dstBinding           = binding;
-  descriptorWrite.dstArrayElement      = 0;
+  descriptorWrite.dstArrayElement      = arrayElement;
   descriptorWrite.descriptorType       = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
   descriptorWrite.descriptorCount      = 1;
   descriptorWrite.pImageInfo           = &imageInfo;
@@ -278,6 +319,9 @@ bool DescriptorPoolManager::createPool() {
     {      VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, m_maxSets_}
   };
 
+  // room for one bindless texture table on top (sizes of the same type add up)
+  poolSizes.push_back({VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, kMaxBindlessDescriptors});
+
   VkDescriptorPoolCreateInfo poolInfo = {};
   poolInfo.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
   poolInfo.poolSizeCount              = static_cast<uint32_t>(poolSizes.size());
@@ -31,9 +31,15 @@ class DescriptorSetLayoutVk : public DescriptorSetLayout {
   // Vulkan-specific methods
   VkDescriptorSetLayout getLayout() const { return m_layout_; }
 
+  // Number of UniformbufferDynamic / BufferUavDynamic bindings - each needs an offset at bind time
+  uint32_t getDynamicBindingCount() const { return m_dynamicBindingCount_; }
+
+  bool isDynamicBinding(uint32_t binding) const;
+
   private:
   DeviceVk*             m_device_;
-  VkDescriptorSetLayout m_layout_ = VK_NULL_HANDLE;
+  VkDescriptorSetLayout m_layout_              = VK_NULL_HANDLE;
+  uint32_t              m_dynamicBindingCount_ = 0;
 };
 
 /**
@@ -52,6 +58,10 @@ class DescriptorSetVk : public DescriptorSet {
   void setUniformBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0, uint64_t range = 0) override;
   void setTextureSampler(uint32_t binding, Texture* texture, Sampler* sampler) override;
   void setTexture(uint32_t binding, Texture* texture, ResourceLayout layout = ResourceLayout::ShaderReadOnly) override;
+  void setTextureArrayElement(uint32_t       binding,
+                              uint32_t       arrayElement,
+                              Texture*       texture,
+                              ResourceLayout layout = ResourceLayout::ShaderReadOnly) override;
   void setSampler(uint32_t binding, Sampler* sampler) override;
   void setStorageBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0, uint64_t range = 0) override;
 
@@ -60,6 +70,8 @@ class DescriptorSetVk : public DescriptorSet {
   // Vulkan-specific methods
   VkDescriptorSet getDescriptorSet() const { return m_descriptorSet_; }
 
+  const DescriptorSetLayoutVk* getLayoutVk() const { return m_layout_; }
+
   private:
   DeviceVk*                    m_device_;
   const DescriptorSetLayoutVk* m_layout_;
@@ -4,6 +4,7 @@
 #include "gfx/rhi/backends/vulkan/command_buffer_vk.h"
 #include "gfx/rhi/backends/vulkan/descriptor_vk.h"
 #include "gfx/rhi/backends/vulkan/framebuffer_vk.h"
+#include "gfx/rhi/backends/vulkan/memory_heap_vk.h"
 #include "gfx/rhi/backends/vulkan/pipeline_vk.h"
 #include "gfx/rhi/backends/vulkan/render_pass_vk.h"
 #include "gfx/rhi/backends/vulkan/rhi_enums_vk.h"
@@ -16,6 +17,7 @@
 #include "platform/common/window.h"
 #include "profiler/backends/gpu_profiler.h"
 #include "utils/logger/log.h"
+#include "utils/memory/linear_allocator.h"
 #include "utils/service/service_locator.h"
 
 #include <SDL_vulkan.h>
@@ -55,6 +57,7 @@ DeviceVk::~DeviceVk() {
   waitIdle();
 
   m_descriptorPoolManager_.release();
+  m_computeCommandPoolManager_.release();
   m_commandPoolManager_.release();
 
   if (m_allocator_) {
@@ -256,18 +259,40 @@ bool DeviceVk::createLogicalDevice_() {
   deviceFeatures.fillModeNonSolid         = VK_TRUE;
   deviceFeatures.geometryShader           = VK_TRUE;
 
-  VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures = {};
-  descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
-  descriptorIndexingFeatures.descriptorBindingUniformBufferUpdateAfterBind = VK_TRUE;
-  descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
-  descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
-  descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
-  descriptorIndexingFeatures.descriptorBindingPartiallyBound               = VK_TRUE;
-  descriptorIndexingFeatures.runtimeDescriptorArray                        = VK_TRUE;
+  // optional, indirect draws fall back to one call per draw / firstInstance 0 without them
+  deviceFeatures.multiDrawIndirect         = m_deviceFeatures_.multiDrawIndirect;
+  deviceFeatures.drawIndirectFirstInstance = m_deviceFeatures_.drawIndirectFirstInstance;
+
+  VkPhysicalDeviceVulkan12Features supportedVulkan12Features = {};
+  supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+  VkPhysicalDeviceFeatures2 supportedFeatures = {};
+  supportedFeatures.sType                     = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  supportedFeatures.pNext                     = &supportedVulkan12Features;
+  vkGetPhysicalDeviceFeatures2(m_physicalDevice_, &supportedFeatures);
+
+  // descriptor indexing is part of the Vulkan 1.2 features (the standalone struct can't be chained together with them)
+  VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+  vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+  vulkan12Features.descriptorIndexing                            = VK_TRUE;
+  vulkan12Features.descriptorBindingUniformBufferUpdateAfterBind = VK_TRUE;
+  vulkan12Features.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+  vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+  vulkan12Features.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+  vulkan12Features.descriptorBindingPartiallyBound               = VK_TRUE;
+  vulkan12Features.runtimeDescriptorArray                        = VK_TRUE;
+  vulkan12Features.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+  vulkan12Features.drawIndirectCount                             = supportedVulkan12Features.drawIndirectCount;
+
+  m_drawIndirectCountSupported_ = supportedVulkan12Features.drawIndirectCount == VK_TRUE;
+
+  if (!m_deviceFeatures_.drawIndirectFirstInstance) {
+    LOG_WARN("drawIndirectFirstInstance is not supported, indirect draws fall back to direct draws");
+  }
 
   VkDeviceCreateInfo createInfo      = {};
   createInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-  createInfo.pNext                   = &descriptorIndexingFeatures;
+  createInfo.pNext                   = &vulkan12Features;
   createInfo.queueCreateInfoCount    = static_cast<uint32_t>(queueCreateInfos.size());
   createInfo.pQueueCreateInfos       = queueCreateInfos.data();
   createInfo.pEnabledFeatures        = &deviceFeatures;
@@ -293,7 +318,8 @@ bool DeviceVk::createLogicalDevice_() {
 }
 
 bool DeviceVk::createCommandPools_() {
-  return m_commandPoolManager_.initialize(m_device_, m_queueFamilyIndices_.graphicsFamily.value());
+  return m_commandPoolManager_.initialize(m_device_, m_queueFamilyIndices_.graphicsFamily.value())
+      && m_computeCommandPoolManager_.initialize(m_device_, m_queueFamilyIndices_.computeFamily.value());
 }
 
 bool DeviceVk::createDescriptorPools_() {
@@ -367,6 +393,19 @@ std::unique_ptr<Texture> DeviceVk::createTexture(const TextureDesc& desc) {
   return texture;
 }
 
+std::unique_ptr<MemoryHeap> DeviceVk::createMemoryHeap(const MemoryHeapDesc& desc) {
+  return std::make_unique<MemoryHeapVk>(desc, this);
+}
+
+std::unique_ptr<Texture> DeviceVk::createAliasedTexture(const TextureDesc& desc, MemoryHeap* heap, uint64_t offset) {
+  // the first use transitions the texture from the undefined layout, initialLayout is not applied here
+  return std::make_unique<TextureVk>(desc, this, static_cast<MemoryHeapVk*>(heap), offset);
+}
+
+MemoryRequirements DeviceVk::getTextureMemoryRequirements(const TextureDesc& desc) {
+  return TextureVk::s_getMemoryRequirements(this, desc);
+}
+
 std::unique_ptr<Sampler> DeviceVk::createSampler(const SamplerDesc& desc) {
   return std::make_unique<SamplerVk>(desc, this);
 }
@@ -393,6 +432,24 @@ std::unique_ptr<GraphicsPipeline> DeviceVk::createGraphicsPipelineWithReflection
   return std::move(pipeline);
 }
 
+std::unique_ptr<ComputePipeline> DeviceVk::createComputePipeline(const ComputePipelineDesc& desc) {
+  return std::make_unique<ComputePipelineVk>(desc, PipelineLayoutDesc{}, this);
+}
+
+std::unique_ptr<ComputePipeline> DeviceVk::createComputePipelineWithReflection(const ComputePipelineDesc& desc) {
+  PipelineLayoutDesc reflectionLayout = pipeline_utils::generatePipelineLayoutFromShaders({desc.shader});
+
+  std::vector<std::unique_ptr<DescriptorSetLayout>> ownedLayouts;
+  auto layoutPtrs = pipeline_utils::createDescriptorSetLayouts(this, reflectionLayout, ownedLayouts);
+
+  ComputePipelineDesc modifiedDesc = desc;
+  modifiedDesc.setLayouts          = layoutPtrs;
+
+  auto pipeline = std::make_unique<ComputePipelineVk>(modifiedDesc, reflectionLayout, this);
+
+  return std::move(pipeline);
+}
+
 std::unique_ptr<DescriptorSetLayout> DeviceVk::createDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) {
   return std::make_unique<DescriptorSetLayoutVk>(desc, this);
 }
@@ -415,9 +472,13 @@ std::unique_ptr<Framebuffer> DeviceVk::createFramebuffer(const FramebufferDesc&
 }
 
 std::unique_ptr<CommandBuffer> DeviceVk::createCommandBuffer(const CommandBufferDesc& desc) {
+  // without a dedicated compute family compute command buffers are submitted to the graphics queue
+  const bool useComputeQueue = desc.queueType == QueueType::Compute && isAsyncComputeSupported();
+
   VkCommandBufferAllocateInfo allocInfo = {};
   allocInfo.sType                       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  allocInfo.commandPool                 = m_commandPoolManager_.getPool();
+  allocInfo.commandPool
+      = useComputeQueue ? m_computeCommandPoolManager_.getPool() : m_commandPoolManager_.getPool();
   allocInfo.level              = desc.primary ? VK_COMMAND_BUFFER_LEVEL_PRIMARY : VK_COMMAND_BUFFER_LEVEL_SECONDARY;
   allocInfo.commandBufferCount = 1;
 
@@ -426,7 +487,7 @@ std::unique_ptr<CommandBuffer> DeviceVk::createCommandBuffer(const CommandBuffer
     return nullptr;
   }
 
-  return std::make_unique<CommandBufferVk>(this, commandBuffer, allocInfo.commandPool);
+  return std::make_unique<CommandBufferVk>(this, commandBuffer, allocInfo.commandPool, desc.queueType);
 }
 
 std::unique_ptr<Fence> DeviceVk::createFence(const FenceDesc& desc) {
@@ -509,31 +570,48 @@ void DeviceVk::updateTexture(
   textureVk->update(data, dataSize, mipLevel, arrayLayer);
 }
 
-void DeviceVk::submitCommandBuffer(CommandBuffer*                 cmdBuffer,
-                                   Fence*                         signalFence,
-                                   const std::vector<Semaphore*>& waitSemaphores,
-                                   const std::vector<Semaphore*>& signalSemaphores) {
+void DeviceVk::submitCommandBuffer(CommandBuffer*              cmdBuffer,
+                                   Fence*                      signalFence,
+                                   std::span<Semaphore* const> waitSemaphores,
+                                   std::span<Semaphore* const> signalSemaphores) {
   CommandBufferVk* cmdBufferVk = dynamic_cast<CommandBufferVk*>(cmdBuffer);
   if (!cmdBufferVk) {
     return;
   }
 
-  std::vector<VkSemaphore>          waitSemaphoresVk;
-  std::vector<VkPipelineStageFlags> waitStages;
+  const bool useComputeQueue = cmdBufferVk->getQueueType() == QueueType::Compute && isAsyncComputeSupported();
+  VkQueue    queue           = useComputeQueue ? m_computeQueue_ : m_graphicsQueue_;
+
+  // submitted every frame, the scratch arrays live on the frame allocator of the calling thread
+  LinearAllocatorScope scope;
+
+  FrameVector<VkSemaphore>          waitSemaphoresVk;
+  FrameVector<VkPipelineStageFlags> waitStages;
+  waitSemaphoresVk.reserve(waitSemaphores.size());
+  waitStages.reserve(waitSemaphores.size());
 
   for (Semaphore* semaphore : waitSemaphores) {
     SemaphoreVk* semaphoreVk = dynamic_cast<SemaphoreVk*>(semaphore);
     if (semaphoreVk) {
       waitSemaphoresVk.push_back(semaphoreVk->getSemaphore());
-      waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+      // results of the compute queue may be consumed by any stage (e.g. indirect arguments, vertex shader reads)
+      if (useComputeQueue) {
+        waitStages.push_back(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+      } else if (semaphoreVk->getSignalQueueType() == QueueType::Compute) {
+        waitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+      } else {
+        waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+      }
     }
   }
 
-  std::vector<VkSemaphore> signalSemaphoresVk;
+  FrameVector<VkSemaphore> signalSemaphoresVk;
+  signalSemaphoresVk.reserve(signalSemaphores.size());
   for (Semaphore* semaphore : signalSemaphores) {
     SemaphoreVk* semaphoreVk = dynamic_cast<SemaphoreVk*>(semaphore);
     if (semaphoreVk) {
       signalSemaphoresVk.push_back(semaphoreVk->getSemaphore());
+      semaphoreVk->setSignalQueueType(useComputeQueue ? QueueType::Compute : QueueType::Graphics);
     }
   }
 
@@ -565,7 +643,7 @@ void DeviceVk::submitCommandBuffer(CommandBuffer*                 cmdBuffer,
     // TODO: I have threading issue here - both main thread and worker thread (for loading assets) are using queue even
     // though there's already mutex here
     std::lock_guard<std::mutex> lock(m_queueSubmitMutex);
-    if (vkQueueSubmit(m_graphicsQueue_, 1, &submitInfo, fenceVk) != VK_SUCCESS) {
+    if (vkQueueSubmit(queue, 1, &submitInfo, fenceVk) != VK_SUCCESS) {
       LOG_ERROR("Failed to submit command buffer");
     }
   }
@@ -577,6 +655,11 @@ void DeviceVk::waitIdle() {
   }
 }
 
+bool DeviceVk::isAsyncComputeSupported() const {
+  return m_computeQueue_ != VK_NULL_HANDLE
+      && m_queueFamilyIndices_.computeFamily.value() != m_queueFamilyIndices_.graphicsFamily.value();
+}
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
\ No newline at end of file
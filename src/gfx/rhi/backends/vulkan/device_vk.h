@@ -33,6 +33,8 @@ class DeviceVk : public Device {
   std::unique_ptr<Shader>              createShader(const ShaderDesc& desc) override;
   std::unique_ptr<GraphicsPipeline>    createGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
   std::unique_ptr<GraphicsPipeline>    createGraphicsPipelineWithReflection(const GraphicsPipelineDesc& desc) override;
+  std::unique_ptr<ComputePipeline>     createComputePipeline(const ComputePipelineDesc& desc) override;
+  std::unique_ptr<ComputePipeline>     createComputePipelineWithReflection(const ComputePipelineDesc& desc) override;
   std::unique_ptr<DescriptorSetLayout> createDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) override;
   std::unique_ptr<DescriptorSet>       createDescriptorSet(const DescriptorSetLayout* layout) override;
   std::unique_ptr<RenderPass>          createRenderPass(const RenderPassDesc& desc) override;
@@ -41,6 +43,9 @@ class DeviceVk : public Device {
   std::unique_ptr<Fence>               createFence(const FenceDesc& desc = FenceDesc()) override;
   std::unique_ptr<Semaphore>           createSemaphore() override;
   std::unique_ptr<SwapChain>           createSwapChain(const SwapchainDesc& desc) override;
+  std::unique_ptr<MemoryHeap>          createMemoryHeap(const MemoryHeapDesc& desc) override;
+  std::unique_ptr<Texture>             createAliasedTexture(const TextureDesc& desc, MemoryHeap* heap, uint64_t offset) override;
+  MemoryRequirements                   getTextureMemoryRequirements(const TextureDesc& desc) override;
   // clang-format on
 
   void updateBuffer(Buffer* buffer, const void* data, size_t size, size_t offset = 0) override;
@@ -50,13 +55,32 @@ class DeviceVk : public Device {
   /**
    * The command buffer must already be in the "closed" state (end() - vkEndCommandBuffer must have been called)
    */
-  void submitCommandBuffer(CommandBuffer*                 cmdBuffer,
-                           Fence*                         signalFence      = nullptr,
-                           const std::vector<Semaphore*>& waitSemaphores   = {},
-                           const std::vector<Semaphore*>& signalSemaphores = {}) override;
+  void submitCommandBuffer(CommandBuffer*              cmdBuffer,
+                           Fence*                      signalFence      = nullptr,
+                           std::span<Semaphore* const> waitSemaphores   = {},
+                           std::span<Semaphore* const> signalSemaphores = {}) override;
 
   void waitIdle() override;
 
+  /**
+   * True when the device exposes a compute queue family separate from the graphics one
+   */
+  bool isAsyncComputeSupported() const override;
+
+  /**
+   * True when the drawIndirectCount feature (Vulkan 1.2) is available and enabled
+   */
+  bool isDrawIndirectCountSupported() const override { return m_drawIndirectCountSupported_; }
+
+  /**
+   * True when the drawIndirectFirstInstance feature is available and enabled
+   */
+  bool isDrawIndirectFirstInstanceSupported() const override {
+    return m_deviceFeatures_.drawIndirectFirstInstance == VK_TRUE;
+  }
+
+  bool isMultiDrawIndirectSupported() const { return m_deviceFeatures_.multiDrawIndirect == VK_TRUE; }
+
   VkInstance                        getInstance() const { return m_instance_; }
   VkPhysicalDevice                  getPhysicalDevice() const { return m_physicalDevice_; }
   VkDevice                          getDevice() const { return m_device_; }
@@ -72,6 +96,7 @@ class DeviceVk : public Device {
   std::mutex& getQueueMutex() { return m_queueSubmitMutex; }
 
   CommandPoolManager&    getCommandPoolManager() { return m_commandPoolManager_; }
+  CommandPoolManager&    getComputeCommandPoolManager() { return m_computeCommandPoolManager_; }
   DescriptorPoolManager& getDescriptorPoolManager() { return m_descriptorPoolManager_; }
 
   VkBuffer createStagingBuffer(const void* data, size_t size, VmaAllocation& allocation);
@@ -94,6 +119,7 @@ class DeviceVk : public Device {
   VkPhysicalDeviceProperties m_deviceProperties_{};
   VkPhysicalDeviceFeatures   m_deviceFeatures_{};
   QueueFamilyIndices         m_queueFamilyIndices_;
+  bool                       m_drawIndirectCountSupported_ = false;
 
   VkDevice   m_device_        = VK_NULL_HANDLE;
   VkQueue    m_graphicsQueue_ = VK_NULL_HANDLE;
@@ -105,6 +131,7 @@ class DeviceVk : public Device {
 
   // Resource management
   CommandPoolManager    m_commandPoolManager_;
+  CommandPoolManager    m_computeCommandPoolManager_;
   DescriptorPoolManager m_descriptorPoolManager_;
 
   // Validation layers
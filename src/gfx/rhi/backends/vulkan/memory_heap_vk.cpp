@@ -0,0 +1,39 @@
+#include "gfx/rhi/backends/vulkan/memory_heap_vk.h"
+
+#include "gfx/rhi/backends/vulkan/device_vk.h"
+#include "utils/logger/log.h"
+
+namespace arise {
+namespace gfx {
+namespace rhi {
+
+MemoryHeapVk::MemoryHeapVk(const MemoryHeapDesc& desc, DeviceVk* device)
+    : MemoryHeap(desc)
+    , m_device_(device) {
+  VkMemoryRequirements memoryRequirements = {};
+  memoryRequirements.size                 = desc.size;
+  memoryRequirements.alignment            = desc.alignment;
+  memoryRequirements.memoryTypeBits       = desc.memoryTypeBits;
+
+  VmaAllocationCreateInfo allocInfo = {};
+  allocInfo.usage                   = VMA_MEMORY_USAGE_GPU_ONLY;
+
+  VkResult result = vmaAllocateMemory(
+      m_device_->getAllocator(), &memoryRequirements, &allocInfo, &m_allocation_, &m_allocationInfo_);
+
+  if (result != VK_SUCCESS) {
+    LOG_ERROR("Failed to allocate memory heap '{}' ({} bytes)", desc.debugName, desc.size);
+    m_allocation_ = VK_NULL_HANDLE;
+  }
+}
+
+MemoryHeapVk::~MemoryHeapVk() {
+  if (m_device_ && m_allocation_ != VK_NULL_HANDLE) {
+    vmaFreeMemory(m_device_->getAllocator(), m_allocation_);
+    m_allocation_ = VK_NULL_HANDLE;
+  }
+}
+
+}  // namespace rhi
+}  // namespace gfx
+}  // namespace arise
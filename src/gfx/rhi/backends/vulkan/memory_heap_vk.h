@@ -0,0 +1,39 @@
+#ifndef ARISE_MEMORY_HEAP_VK_H
+#define ARISE_MEMORY_HEAP_VK_H
+
+#include "gfx/rhi/interface/memory_heap.h"
+
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace arise {
+namespace gfx {
+namespace rhi {
+
+class DeviceVk;
+
+class MemoryHeapVk : public MemoryHeap {
+  public:
+  MemoryHeapVk(const MemoryHeapDesc& desc, DeviceVk* device);
+  ~MemoryHeapVk() override;
+
+  MemoryHeapVk(const MemoryHeapVk&)            = delete;
+  MemoryHeapVk& operator=(const MemoryHeapVk&) = delete;
+
+  // Vulkan-specific methods
+  VmaAllocation getAllocation() const { return m_allocation_; }
+
+  // memory type the heap was allocated from (index into VkPhysicalDeviceMemoryProperties::memoryTypes)
+  uint32_t getMemoryType() const { return m_allocationInfo_.memoryType; }
+
+  private:
+  DeviceVk*         m_device_;
+  VmaAllocation     m_allocation_ = VK_NULL_HANDLE;
+  VmaAllocationInfo m_allocationInfo_{};
+};
+
+}  // namespace rhi
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_MEMORY_HEAP_VK_H
@@ -5,12 +5,43 @@
 #include "gfx/rhi/backends/vulkan/render_pass_vk.h"
 #include "gfx/rhi/backends/vulkan/rhi_enums_vk.h"
 #include "gfx/rhi/backends/vulkan/shader_vk.h"
+#include "gfx/rhi/shader_reflection/pipeline_utils.h"
 #include "utils/logger/log.h"
+#include "utils/resource/resource_deletion_manager.h"
+#include "utils/service/service_locator.h"
 
 namespace arise {
 namespace gfx {
 namespace rhi {
 
+namespace {
+
+// ResourceDeletionManager::HandleBatchDeleter of pipelines replaced on rebuild
+void destroyPipelines(void* context, std::span<const uint64_t> handles) {
+  auto deviceVk = static_cast<DeviceVk*>(context);
+  for (const uint64_t handle : handles) {
+    vkDestroyPipeline(deviceVk->getDevice(), reinterpret_cast<VkPipeline>(handle), nullptr);
+  }
+}
+
+// destroys the pipeline once the frames in flight that may use it have completed
+void retirePipeline(DeviceVk* device, VkPipeline pipeline) {
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (!deletionManager) {
+    device->waitIdle();
+    vkDestroyPipeline(device->getDevice(), pipeline, nullptr);
+    return;
+  }
+
+  deletionManager->enqueueHandleForDeletion(reinterpret_cast<uint64_t>(pipeline), &destroyPipelines, device);
+}
+
+}  // namespace
+
+//-------------------------------------------------------------------------
+// GraphicsPipelineVk implementation
+//-------------------------------------------------------------------------
+
 GraphicsPipelineVk::GraphicsPipelineVk(const GraphicsPipelineDesc& desc,
                                        const PipelineLayoutDesc&   reflectionLayout,
                                        DeviceVk*                   device)
@@ -150,11 +181,9 @@ bool GraphicsPipelineVk::createPipeline_() {
   pipelineInfo.basePipelineHandle           = VK_NULL_HANDLE;
   pipelineInfo.basePipelineIndex            = -1;
 
-  // Destroy existing pipeline if it exists
+  // frames in flight may still use the existing pipeline
   if (m_pipeline_ != VK_NULL_HANDLE) {
-    // TODO: temp, dirty fix. Consider add delayed destroy for old pipeline
-    m_device_->waitIdle();
-    vkDestroyPipeline(m_device_->getDevice(), m_pipeline_, nullptr);
+    retirePipeline(m_device_, m_pipeline_);
     m_pipeline_ = VK_NULL_HANDLE;
   }
 
@@ -326,7 +355,8 @@ bool GraphicsPipelineVk::createColorBlendState_(VkPipelineColorBlendStateCreateI
     colorBlendAttachments.push_back(attachmentState);
   }
 
-  if (colorBlendAttachments.empty()) {
+  // depth-only render passes have no color attachments, so there is nothing to default
+  if (colorBlendAttachments.empty() && m_desc_.renderPass && m_desc_.renderPass->getColorAttachmentCount() > 0) {
     LOG_WARN("No color blend attachments provided, using default attachment");
     VkPipelineColorBlendAttachmentState defaultAttachment = {};
     defaultAttachment.blendEnable                         = VK_FALSE;
@@ -362,14 +392,20 @@ bool GraphicsPipelineVk::createPipelineLayout_() {
     vkDescriptorSetLayouts.push_back(setLayoutVk->getLayout());
   }
 
-  // TODO: add push constant ranges
+  // single range visible to all graphics stages, so CommandBufferVk::pushConstants doesn't need stage flags
+  m_pushConstantSize_ = pipeline_utils::getPushConstantSize(m_desc_.shaders);
+
+  VkPushConstantRange pushConstantRange = {};
+  pushConstantRange.stageFlags          = VK_SHADER_STAGE_ALL_GRAPHICS;
+  pushConstantRange.offset              = 0;
+  pushConstantRange.size                = m_pushConstantSize_;
 
   VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
   pipelineLayoutInfo.sType                      = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
   pipelineLayoutInfo.setLayoutCount             = static_cast<uint32_t>(vkDescriptorSetLayouts.size());
   pipelineLayoutInfo.pSetLayouts                = vkDescriptorSetLayouts.data();
-  pipelineLayoutInfo.pushConstantRangeCount     = 0;
-  pipelineLayoutInfo.pPushConstantRanges        = nullptr;
+  pipelineLayoutInfo.pushConstantRangeCount     = m_pushConstantSize_ > 0 ? 1 : 0;
+  pipelineLayoutInfo.pPushConstantRanges        = m_pushConstantSize_ > 0 ? &pushConstantRange : nullptr;
 
   if (vkCreatePipelineLayout(m_device_->getDevice(), &pipelineLayoutInfo, nullptr, &m_pipelineLayout_) != VK_SUCCESS) {
     LOG_ERROR("Failed to create pipeline layout");
@@ -379,6 +415,138 @@ bool GraphicsPipelineVk::createPipelineLayout_() {
   return true;
 }
 
+//-------------------------------------------------------------------------
+// ComputePipelineVk implementation
+//-------------------------------------------------------------------------
+
+ComputePipelineVk::ComputePipelineVk(const ComputePipelineDesc& desc,
+                                     const PipelineLayoutDesc&  reflectionLayout,
+                                     DeviceVk*                  device)
+    : ComputePipeline(desc, reflectionLayout)
+    , m_device_(device) {
+  m_ownedLayouts_.reserve(desc.setLayouts.size());
+  std::vector<const DescriptorSetLayout*> ownedLayoutPtrs;
+  ownedLayoutPtrs.reserve(desc.setLayouts.size());
+
+  for (const auto* layout : desc.setLayouts) {
+    if (layout) {
+      auto copiedLayout = m_device_->createDescriptorSetLayout(layout->getDesc());
+      ownedLayoutPtrs.push_back(copiedLayout.get());
+      m_ownedLayouts_.push_back(std::move(copiedLayout));
+    } else {
+      ownedLayoutPtrs.push_back(nullptr);
+    }
+  }
+
+  m_desc_.setLayouts = ownedLayoutPtrs;
+
+  if (!initialize_()) {
+    LOG_ERROR("Failed to initialize Vulkan compute pipeline");
+  }
+}
+
+ComputePipelineVk::~ComputePipelineVk() {
+  if (m_pipeline_ != VK_NULL_HANDLE) {
+    vkDestroyPipeline(m_device_->getDevice(), m_pipeline_, nullptr);
+    m_pipeline_ = VK_NULL_HANDLE;
+  }
+
+  if (m_pipelineLayout_ != VK_NULL_HANDLE) {
+    vkDestroyPipelineLayout(m_device_->getDevice(), m_pipelineLayout_, nullptr);
+    m_pipelineLayout_ = VK_NULL_HANDLE;
+  }
+}
+
+bool ComputePipelineVk::rebuild() {
+  if (createPipeline_()) {
+    LOG_INFO("Successfully rebuilt Vulkan compute pipeline");
+    m_updateFrame = -1;
+    return true;
+  }
+
+  LOG_ERROR("Failed to rebuild Vulkan compute pipeline");
+  return false;
+}
+
+bool ComputePipelineVk::initialize_() {
+  if (!createPipelineLayout_()) {
+    LOG_ERROR("Failed to create compute pipeline layout");
+    return false;
+  }
+
+  return createPipeline_();
+}
+
+bool ComputePipelineVk::createPipeline_() {
+  ShaderVk* shaderVk = dynamic_cast<ShaderVk*>(m_desc_.shader);
+  if (!shaderVk || shaderVk->getStage() != ShaderStageFlag::Compute) {
+    LOG_ERROR("Vulkan compute pipeline requires a compute shader");
+    return false;
+  }
+
+  VkPipelineShaderStageCreateInfo shaderStageInfo = {};
+  shaderStageInfo.sType                           = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  shaderStageInfo.stage                           = VK_SHADER_STAGE_COMPUTE_BIT;
+  shaderStageInfo.module                          = shaderVk->getShaderModule();
+  shaderStageInfo.pName                           = shaderVk->getEntryPoint().c_str();
+
+  VkComputePipelineCreateInfo pipelineInfo = {};
+  pipelineInfo.sType                       = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipelineInfo.stage                       = shaderStageInfo;
+  pipelineInfo.layout                      = m_pipelineLayout_;
+  pipelineInfo.basePipelineHandle          = VK_NULL_HANDLE;
+  pipelineInfo.basePipelineIndex           = -1;
+
+  // frames in flight may still use the existing pipeline
+  if (m_pipeline_ != VK_NULL_HANDLE) {
+    retirePipeline(m_device_, m_pipeline_);
+    m_pipeline_ = VK_NULL_HANDLE;
+  }
+
+  if (vkCreateComputePipelines(m_device_->getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline_)
+      != VK_SUCCESS) {
+    LOG_ERROR("Failed to create compute pipeline");
+    return false;
+  }
+
+  return true;
+}
+
+bool ComputePipelineVk::createPipelineLayout_() {
+  std::vector<VkDescriptorSetLayout> vkDescriptorSetLayouts;
+
+  for (const auto& setLayout : m_desc_.setLayouts) {
+    const DescriptorSetLayoutVk* setLayoutVk = dynamic_cast<const DescriptorSetLayoutVk*>(setLayout);
+    if (!setLayoutVk) {
+      LOG_ERROR("Invalid descriptor set layout type for Vulkan pipeline");
+      return false;
+    }
+
+    vkDescriptorSetLayouts.push_back(setLayoutVk->getLayout());
+  }
+
+  m_pushConstantSize_ = pipeline_utils::getPushConstantSize({m_desc_.shader});
+
+  VkPushConstantRange pushConstantRange = {};
+  pushConstantRange.stageFlags          = VK_SHADER_STAGE_COMPUTE_BIT;
+  pushConstantRange.offset              = 0;
+  pushConstantRange.size                = m_pushConstantSize_;
+
+  VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+  pipelineLayoutInfo.sType                      = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  pipelineLayoutInfo.setLayoutCount             = static_cast<uint32_t>(vkDescriptorSetLayouts.size());
+  pipelineLayoutInfo.pSetLayouts                = vkDescriptorSetLayouts.data();
+  pipelineLayoutInfo.pushConstantRangeCount     = m_pushConstantSize_ > 0 ? 1 : 0;
+  pipelineLayoutInfo.pPushConstantRanges        = m_pushConstantSize_ > 0 ? &pushConstantRange : nullptr;
+
+  if (vkCreatePipelineLayout(m_device_->getDevice(), &pipelineLayoutInfo, nullptr, &m_pipelineLayout_) != VK_SUCCESS) {
+    LOG_ERROR("Failed to create compute pipeline layout");
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
\ No newline at end of file
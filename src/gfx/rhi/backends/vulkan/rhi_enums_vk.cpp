@@ -211,7 +211,8 @@ static const std::unordered_map<ResourceLayout, VkImageLayout> imageLayoutMappin
   { ResourceLayout::FragmentDensityMapExt,          VK_IMAGE_LAYOUT_FRAGMENT_DENSITY_MAP_OPTIMAL_EXT           },
   { ResourceLayout::ReadOnly,                       VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR                      },
   { ResourceLayout::Attachment,                     VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR                     },
-  { ResourceLayout::AccelerationStructure,          VK_IMAGE_LAYOUT_GENERAL                                    } 
+  { ResourceLayout::AccelerationStructure,          VK_IMAGE_LAYOUT_GENERAL                                    },
+  { ResourceLayout::IndirectArgument,               VK_IMAGE_LAYOUT_GENERAL                                    }
 };
 
 // clang-format on
@@ -46,9 +46,16 @@ class SemaphoreVk : public Semaphore {
    */
   void signal(VkQueue queue);
 
+  /**
+   * Queue of the last submission that signals the semaphore, decides the wait stage of the consumer submission
+   */
+  QueueType getSignalQueueType() const { return m_signalQueueType_; }
+  void      setSignalQueueType(QueueType queueType) { m_signalQueueType_ = queueType; }
+
   private:
-  DeviceVk*   m_device_    = nullptr;
-  VkSemaphore m_semaphore_ = VK_NULL_HANDLE;
+  DeviceVk*   m_device_          = nullptr;
+  VkSemaphore m_semaphore_       = VK_NULL_HANDLE;
+  QueueType   m_signalQueueType_ = QueueType::Graphics;
 };
 
 }  // namespace rhi
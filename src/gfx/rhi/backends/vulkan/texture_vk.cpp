@@ -2,6 +2,7 @@
 
 #include "gfx/rhi/backends/vulkan/command_buffer_vk.h"
 #include "gfx/rhi/backends/vulkan/device_vk.h"
+#include "gfx/rhi/backends/vulkan/memory_heap_vk.h"
 #include "gfx/rhi/backends/vulkan/rhi_enums_vk.h"
 #include "gfx/rhi/backends/vulkan/synchronization_vk.h"
 #include "utils/logger/log.h"
@@ -21,20 +22,21 @@ TextureVk::TextureVk(const TextureDesc& desc, DeviceVk* device)
     LOG_ERROR("Failed to create Vulkan texture");
   }
 
-  if (!desc.debugName.empty() && m_image_ != VK_NULL_HANDLE) {
-    VkDebugUtilsObjectNameInfoEXT nameInfo{};
-    nameInfo.sType        = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
-    nameInfo.objectType   = VK_OBJECT_TYPE_IMAGE;
-    nameInfo.objectHandle = (uint64_t)m_image_;
-    nameInfo.pObjectName  = desc.debugName.c_str();
+  setDebugName_();
+}
 
-    auto fpSetDebugUtilsObjectName
-        = (PFN_vkSetDebugUtilsObjectNameEXT)vkGetDeviceProcAddr(m_device_->getDevice(), "vkSetDebugUtilsObjectNameEXT");
+TextureVk::TextureVk(const TextureDesc& desc, DeviceVk* device, MemoryHeapVk* heap, uint64_t heapOffset)
+    : Texture(desc)
+    , m_device_(device) {
+  m_vkFormat_ = g_getTextureFormatVk(desc.format);
 
-    if (fpSetDebugUtilsObjectName) {
-      fpSetDebugUtilsObjectName(m_device_->getDevice(), &nameInfo);
-    }
+  m_currentLayout_ = ResourceLayout::Undefined;
+
+  if (!createAliasedImage_(heap, heapOffset) || !createImageView_()) {
+    LOG_ERROR("Failed to create aliased Vulkan texture");
   }
+
+  setDebugName_();
 }
 
 TextureVk::TextureVk(DeviceVk* device, const TextureDesc& desc, VkImage existingImage, VkImageView existingImageView)
@@ -58,6 +60,11 @@ TextureVk::~TextureVk() {
         m_imageView_ = VK_NULL_HANDLE;
       }
 
+      if (m_sampledImageView_ != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, m_sampledImageView_, nullptr);
+        m_sampledImageView_ = VK_NULL_HANDLE;
+      }
+
       if (m_image_ != VK_NULL_HANDLE) {
         vmaDestroyImage(m_device_->getAllocator(), m_image_, m_allocation_);
         m_image_      = VK_NULL_HANDLE;
@@ -80,10 +87,75 @@ void TextureVk::transitionToInitialLayout(CommandBuffer* cmdBuffer) {
 }
 
 bool TextureVk::createImage_() {
-  VkImageCreateInfo imageInfo = {};
-  imageInfo.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  VkImageCreateInfo imageInfo             = {};
+  uint32_t          queueFamilyIndices[2] = {};
+  if (!s_getImageCreateInfo(m_device_, m_desc_, imageInfo, queueFamilyIndices)) {
+    return false;
+  }
 
-  switch (m_desc_.type) {
+  VmaAllocationCreateInfo allocInfo = {};
+  allocInfo.usage                   = VMA_MEMORY_USAGE_GPU_ONLY;  // Textures typically use GPU-only memory
+
+  VkResult result = vmaCreateImage(
+      m_device_->getAllocator(), &imageInfo, &allocInfo, &m_image_, &m_allocation_, &m_allocationInfo_);
+
+  if (result != VK_SUCCESS) {
+    LOG_ERROR("Failed to create image with VMA");
+    return false;
+  }
+
+  return true;
+}
+
+bool TextureVk::createAliasedImage_(MemoryHeapVk* heap, uint64_t heapOffset) {
+  if (!heap || heap->getAllocation() == VK_NULL_HANDLE) {
+    LOG_ERROR("Invalid memory heap for aliased texture");
+    return false;
+  }
+
+  VkImageCreateInfo imageInfo             = {};
+  uint32_t          queueFamilyIndices[2] = {};
+  if (!s_getImageCreateInfo(m_device_, m_desc_, imageInfo, queueFamilyIndices)) {
+    return false;
+  }
+
+  if (vkCreateImage(m_device_->getDevice(), &imageInfo, nullptr, &m_image_) != VK_SUCCESS) {
+    LOG_ERROR("Failed to create aliased image");
+    return false;
+  }
+
+  VkMemoryRequirements memoryRequirements;
+  vkGetImageMemoryRequirements(m_device_->getDevice(), m_image_, &memoryRequirements);
+
+  const bool fits = heapOffset % memoryRequirements.alignment == 0
+                 && heapOffset + memoryRequirements.size <= heap->getSize()
+                 && (memoryRequirements.memoryTypeBits & (1u << heap->getMemoryType())) != 0;
+
+  // the image is bound to the heap allocation, m_allocation_ stays null - the destructor only destroys the image
+  if (!fits
+      || vmaBindImageMemory2(m_device_->getAllocator(), heap->getAllocation(), heapOffset, m_image_, nullptr)
+             != VK_SUCCESS) {
+    LOG_ERROR("Failed to bind aliased image at offset {} of memory heap '{}'", heapOffset, heap->getDesc().debugName);
+    vkDestroyImage(m_device_->getDevice(), m_image_, nullptr);
+    m_image_ = VK_NULL_HANDLE;
+    return false;
+  }
+
+  return true;
+}
+
+bool TextureVk::s_getImageCreateInfo(DeviceVk*          device,
+                                     const TextureDesc& desc,
+                                     VkImageCreateInfo& imageInfo,
+                                     uint32_t (&queueFamilyIndices)[2]) {
+  const bool hasRtvUsage = (desc.createFlags & TextureCreateFlag::Rtv) != TextureCreateFlag::None;
+  const bool hasDsvUsage = (desc.createFlags & TextureCreateFlag::Dsv) != TextureCreateFlag::None;
+  const bool hasUavUsage = (desc.createFlags & TextureCreateFlag::Uav) != TextureCreateFlag::None;
+
+  imageInfo       = {};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+
+  switch (desc.type) {
     case TextureType::Texture1D:
     case TextureType::Texture1DArray:
       imageInfo.imageType = VK_IMAGE_TYPE_1D;
@@ -102,26 +174,26 @@ bool TextureVk::createImage_() {
       return false;
   }
 
-  imageInfo.format        = m_vkFormat_;
-  imageInfo.extent.width  = m_desc_.width;
-  imageInfo.extent.height = m_desc_.height;
-  imageInfo.extent.depth  = m_desc_.depth;
-  imageInfo.mipLevels     = m_desc_.mipLevels;
-  imageInfo.arrayLayers   = m_desc_.arraySize;
+  imageInfo.format        = g_getTextureFormatVk(desc.format);
+  imageInfo.extent.width  = desc.width;
+  imageInfo.extent.height = desc.height;
+  imageInfo.extent.depth  = desc.depth;
+  imageInfo.mipLevels     = desc.mipLevels;
+  imageInfo.arrayLayers   = desc.arraySize;
 
-  if (m_desc_.type == TextureType::TextureCube) {
+  if (desc.type == TextureType::TextureCube) {
     imageInfo.arrayLayers  = 6;
     imageInfo.flags       |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
   }
 
   imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-  if (m_desc_.sampleCount == MSAASamples::Count2) {
+  if (desc.sampleCount == MSAASamples::Count2) {
     imageInfo.samples = VK_SAMPLE_COUNT_2_BIT;
-  } else if (m_desc_.sampleCount == MSAASamples::Count4) {
+  } else if (desc.sampleCount == MSAASamples::Count4) {
     imageInfo.samples = VK_SAMPLE_COUNT_4_BIT;
-  } else if (m_desc_.sampleCount == MSAASamples::Count8) {
+  } else if (desc.sampleCount == MSAASamples::Count8) {
     imageInfo.samples = VK_SAMPLE_COUNT_8_BIT;
-  } else if (m_desc_.sampleCount == MSAASamples::Count16) {
+  } else if (desc.sampleCount == MSAASamples::Count16) {
     imageInfo.samples = VK_SAMPLE_COUNT_16_BIT;
   }
 
@@ -129,41 +201,86 @@ bool TextureVk::createImage_() {
 
   imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
 
-  if (hasRtvUsage()) {
+  if (hasRtvUsage) {
     imageInfo.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
   }
 
-  if (hasDsvUsage()) {
+  if (hasDsvUsage) {
     imageInfo.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
   }
 
-  if (hasUavUsage()) {
+  if (hasUavUsage) {
     imageInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
   }
 
   imageInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
-  if (m_desc_.mipLevels > 1 || ((m_desc_.createFlags & TextureCreateFlag::TransferSrc) != TextureCreateFlag::None)) {
+  if (desc.mipLevels > 1 || ((desc.createFlags & TextureCreateFlag::TransferSrc) != TextureCreateFlag::None)) {
     imageInfo.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
   }
 
   imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
   imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-  VmaAllocationCreateInfo allocInfo = {};
-  allocInfo.usage                   = VMA_MEMORY_USAGE_GPU_ONLY;  // Textures typically use GPU-only memory
+  // storage images may be written on the async compute queue, see BufferVk::createBuffer_
+  QueueFamilyIndices indices = device->getQueueFamilyIndices();
+  queueFamilyIndices[0]      = indices.graphicsFamily.value();
+  queueFamilyIndices[1]      = indices.computeFamily.value();
 
-  VkResult result = vmaCreateImage(
-      m_device_->getAllocator(), &imageInfo, &allocInfo, &m_image_, &m_allocation_, &m_allocationInfo_);
-
-  if (result != VK_SUCCESS) {
-    LOG_ERROR("Failed to create image with VMA");
-    return false;
+  if (hasUavUsage && device->isAsyncComputeSupported()) {
+    imageInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+    imageInfo.queueFamilyIndexCount = 2;
+    imageInfo.pQueueFamilyIndices   = queueFamilyIndices;
   }
 
   return true;
 }
 
+MemoryRequirements TextureVk::s_getMemoryRequirements(DeviceVk* device, const TextureDesc& desc) {
+  MemoryRequirements requirements;
+
+  VkImageCreateInfo imageInfo             = {};
+  uint32_t          queueFamilyIndices[2] = {};
+  if (!s_getImageCreateInfo(device, desc, imageInfo, queueFamilyIndices)) {
+    return requirements;
+  }
+
+  // requirements of a temporary image without memory (vkGetDeviceImageMemoryRequirements needs Vulkan 1.3)
+  VkImage image = VK_NULL_HANDLE;
+  if (vkCreateImage(device->getDevice(), &imageInfo, nullptr, &image) != VK_SUCCESS) {
+    LOG_ERROR("Failed to create image for memory requirements");
+    return requirements;
+  }
+
+  VkMemoryRequirements memoryRequirements;
+  vkGetImageMemoryRequirements(device->getDevice(), image, &memoryRequirements);
+  vkDestroyImage(device->getDevice(), image, nullptr);
+
+  requirements.size           = memoryRequirements.size;
+  requirements.alignment      = memoryRequirements.alignment;
+  requirements.memoryTypeBits = memoryRequirements.memoryTypeBits;
+  return requirements;
+}
+
+void TextureVk::setDebugName_() {
+  if (m_desc_.debugName.empty() || m_image_ == VK_NULL_HANDLE) {
+    return;
+  }
+
+  VkDebugUtilsObjectNameInfoEXT nameInfo{};
+  nameInfo.sType        = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+  nameInfo.objectType   = VK_OBJECT_TYPE_IMAGE;
+  nameInfo.objectHandle = (uint64_t)m_image_;
+  nameInfo.pObjectName  = m_desc_.debugName.c_str();
+
+  auto fpSetDebugUtilsObjectName
+      = (PFN_vkSetDebugUtilsObjectNameEXT)vkGetDeviceProcAddr(m_device_->getDevice(), "vkSetDebugUtilsObjectNameEXT");
+
+  if (fpSetDebugUtilsObjectName) {
+    fpSetDebugUtilsObjectName(m_device_->getDevice(), &nameInfo);
+  }
+}
+
 bool TextureVk::createImageView_() {
   VkImageViewCreateInfo viewInfo = {};
   viewInfo.sType                 = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -223,6 +340,15 @@ bool TextureVk::createImageView_() {
     return false;
   }
 
+  // a sampled view may only select one aspect, depth-stencil textures are read as depth
+  if (viewInfo.subresourceRange.aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) {
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if (vkCreateImageView(m_device_->getDevice(), &viewInfo, nullptr, &m_sampledImageView_) != VK_SUCCESS) {
+      LOG_ERROR("Failed to create Vulkan depth sampled image view");
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -12,6 +12,7 @@ namespace gfx {
 namespace rhi {
 
 class DeviceVk;
+class MemoryHeapVk;
 
 class TextureVk : public Texture {
   public:
@@ -22,6 +23,11 @@ class TextureVk : public Texture {
    */
   TextureVk(DeviceVk* device, const TextureDesc& desc, VkImage existingImage, VkImageView existingImageView);
 
+  /**
+   * Create a texture bound to heapOffset of the heap memory (aliased textures, see Device::createAliasedTexture)
+   */
+  TextureVk(const TextureDesc& desc, DeviceVk* device, MemoryHeapVk* heap, uint64_t heapOffset);
+
   ~TextureVk() override;
 
   TextureVk(const TextureVk&)            = delete;
@@ -34,6 +40,11 @@ class TextureVk : public Texture {
 
   VkImageView getImageView() const { return m_imageView_; }
 
+  // view for shader reads - depth aspect only for depth-stencil formats, the full view otherwise
+  VkImageView getSampledImageView() const {
+    return m_sampledImageView_ != VK_NULL_HANDLE ? m_sampledImageView_ : m_imageView_;
+  }
+
   VkFormat getVkFormat() const { return m_vkFormat_; }
 
   VkImageLayout getImageLayout() const { return g_getImageLayoutVk(m_currentLayout_); }
@@ -41,6 +52,9 @@ class TextureVk : public Texture {
   // Updates texture data (for staging uploads)
   void update(const void* data, size_t dataSize, uint32_t mipLevel = 0, uint32_t arrayLayer = 0);
 
+  // memory a texture with the given desc needs when it is bound to a memory heap
+  static MemoryRequirements s_getMemoryRequirements(DeviceVk* device, const TextureDesc& desc);
+
   private:
   friend class CommandBufferVk;
   friend class FramebufferVk;
@@ -48,15 +62,25 @@ class TextureVk : public Texture {
   void updateCurrentLayout_(ResourceLayout layout);
 
   bool createImage_();
+  bool createAliasedImage_(MemoryHeapVk* heap, uint64_t heapOffset);
   bool createImageView_();
 
+  void setDebugName_();
+
+  // queueFamilyIndices is referenced by imageInfo (concurrent sharing of storage images)
+  static bool s_getImageCreateInfo(DeviceVk*          device,
+                                   const TextureDesc& desc,
+                                   VkImageCreateInfo& imageInfo,
+                                   uint32_t (&queueFamilyIndices)[2]);
+
   DeviceVk* m_device_;
 
   // Vulkan resources
   VkImage           m_image_      = VK_NULL_HANDLE;
   VmaAllocation     m_allocation_ = VK_NULL_HANDLE;
   VmaAllocationInfo m_allocationInfo_{};
-  VkImageView       m_imageView_ = VK_NULL_HANDLE;
+  VkImageView       m_imageView_        = VK_NULL_HANDLE;
+  VkImageView       m_sampledImageView_ = VK_NULL_HANDLE;
 
   // Track if we own these resources (false for swapchain images)
   bool m_ownsResources_ = true;
@@ -379,6 +379,7 @@ enum class ResourceLayout : uint8_t {
   ReadOnly,
   Attachment,
   AccelerationStructure,
+  IndirectArgument,  // buffers only - argument buffer of indirect draws / dispatches
   Count
 };
 
@@ -387,6 +388,11 @@ enum class PipelineType {
   Compute
 };
 
+enum class QueueType {
+  Graphics,  // graphics, compute and copy commands
+  Compute    // async compute - compute and copy commands only
+};
+
 enum class BufferCreateFlag : uint32_t {
   None                            = 0,
   CpuAccess                       = 0x00'00'00'01,
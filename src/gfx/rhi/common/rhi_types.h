@@ -59,6 +59,24 @@ struct TextureDesc {
   std::string       debugName     = "";
 };
 
+// memory a texture occupies when it is placed in a MemoryHeap (see Device::getTextureMemoryRequirements)
+struct MemoryRequirements {
+  uint64_t size           = 0;
+  uint64_t alignment      = 1;
+  uint32_t memoryTypeBits = UINT32_MAX;  // Vulkan memory types the texture can be bound to, all bits on DX12
+};
+
+/**
+ * Device memory shared by aliased textures (see Device::createAliasedTexture). A heap only holds render target and
+ * depth-stencil textures, which keeps it usable on DX12 resource heap tier 1
+ */
+struct MemoryHeapDesc {
+  uint64_t    size           = 0;
+  uint64_t    alignment      = 1;           // largest alignment of the placed textures
+  uint32_t    memoryTypeBits = UINT32_MAX;  // intersection of the memoryTypeBits of the placed textures
+  std::string debugName      = "";
+};
+
 struct SamplerDesc {
   TextureFilter      minFilter        = TextureFilter::Linear;
   TextureFilter      magFilter        = TextureFilter::Linear;
@@ -193,6 +211,11 @@ struct MultisampleStateDesc {
 //------------------------------------------------------
 // Descriptor set layout
 //------------------------------------------------------
+
+// Largest descriptor array (bindless table) a binding may declare - backends reserve pool / heap space for it.
+// Array bindings (descriptorCount > 1) may be partially bound, unused elements are never accessed
+constexpr uint32_t kMaxBindlessDescriptors = 1024;
+
 struct DescriptorSetLayoutBindingDesc {
   uint32_t          binding         = 0;
   ShaderBindingType type            = ShaderBindingType::Uniformbuffer;
@@ -224,6 +247,11 @@ struct GraphicsPipelineDesc {
   uint32_t                                subpass    = 0;
 };
 
+struct ComputePipelineDesc {
+  Shader*                                 shader = nullptr;
+  std::vector<const DescriptorSetLayout*> setLayouts;
+};
+
 //------------------------------------------------------
 // Render pass and framebuffer
 //------------------------------------------------------
@@ -262,7 +290,8 @@ struct SwapchainDesc {
 };
 
 struct CommandBufferDesc {
-  bool primary = true;
+  bool      primary   = true;
+  QueueType queueType = QueueType::Graphics;  // queue the command buffer is submitted to
 };
 
 struct FenceDesc {
@@ -272,10 +301,43 @@ struct FenceDesc {
 //------------------------------------------------------
 // Other structures
 //------------------------------------------------------
+/**
+ * Either texture or buffer is set. For buffers the layouts only describe how the buffer is accessed before and after
+ * the barrier (Uav, ShaderReadOnly, IndirectArgument, TransferSrc...).
+ * oldLayout == newLayout == Uav is a UAV barrier - shader writes before it are visible to the shaders after it.
+ * discard drops the previous contents of a texture - required on the first use of an aliased texture after another
+ * texture used its memory (transition from the undefined layout on Vulkan, aliasing barrier on DX12)
+ */
 struct ResourceBarrierDesc {
   Texture*       texture   = nullptr;
+  Buffer*        buffer    = nullptr;
   ResourceLayout oldLayout = ResourceLayout::Undefined;
   ResourceLayout newLayout = ResourceLayout::General;
+  bool           discard   = false;
+};
+
+// layout of the arguments read by CommandBuffer::dispatchIndirect (VkDispatchIndirectCommand, D3D12_DISPATCH_ARGUMENTS)
+struct DispatchIndirectCommand {
+  uint32_t groupCountX = 1;
+  uint32_t groupCountY = 1;
+  uint32_t groupCountZ = 1;
+};
+
+/**
+ * Layout of the arguments read by CommandBuffer::drawIndexedIndirect / multiDrawIndexedIndirect.
+ *
+ * drawConstant precedes the draw arguments (VkDrawIndexedIndirectCommand, D3D12_DRAW_INDEXED_ARGUMENTS):
+ * DirectX writes it into the first push constant of the draw, Vulkan skips it (the draw reads from offset + 4).
+ * Shaders that need a per-draw value in both APIs therefore use drawConstant == firstInstance and add
+ * SV_InstanceID (which includes firstInstance in Vulkan only) to a push constant that is 0 for indirect draws.
+ */
+struct DrawIndexedIndirectCommand {
+  uint32_t drawConstant  = 0;
+  uint32_t indexCount    = 0;
+  uint32_t instanceCount = 1;
+  uint32_t firstIndex    = 0;
+  int32_t  vertexOffset  = 0;
+  uint32_t firstInstance = 0;
 };
 
 union ClearValue {
@@ -32,6 +32,11 @@ class Buffer {
 
   const BufferDesc& getDesc() const { return m_desc_; }
 
+  /**
+   * CPU address of persistently mapped buffers (CpuAccess, Dynamic or Readback), nullptr for GPU-only ones
+   */
+  virtual void* getMappedData() const { return nullptr; }
+
   protected:
   BufferDesc m_desc_;
 };
@@ -40,6 +40,15 @@ class CommandBuffer {
   virtual void bindVertexBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0)            = 0;
   virtual void bindIndexBuffer(Buffer* buffer, uint64_t offset = 0, bool use32BitIndices = false) = 0;
   virtual void bindDescriptorSet(uint32_t setIndex, DescriptorSet* set)                           = 0;
+  // dynamicOffsets - one byte offset per dynamic binding of the set, ordered by binding index
+  virtual void bindDescriptorSet(uint32_t setIndex, DescriptorSet* set, const std::vector<uint32_t>& dynamicOffsets) = 0;
+
+  // Push constants - small per-draw data written directly into the command stream (root constants on DX12).
+  // size and offset must be multiples of 4 and fit into the push constant block of the current pipeline
+  virtual void pushConstants(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+  template <typename T>
+  void pushConstants(const T& data) { pushConstants(&data, sizeof(T)); }
 
   // Draw commands
   virtual void draw(uint32_t vertexCount, uint32_t firstVertex = 0)                                                                                             = 0;
@@ -48,10 +57,22 @@ class CommandBuffer {
   virtual void drawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) = 0;
   // TODO: add more draw commands if needed
 
-  // TODO: in future add 'Compute dispatch' section
+  // Indirect draws - buffer holds DrawIndexedIndirectCommand records and must be created with BufferCreateFlag::IndirectCommand.
+  // The multi-draw variants submit drawCount records (stride bytes apart) with one call; the count variant reads the
+  // number of draws (uint32_t) from countBuffer on the GPU and clamps it to maxDrawCount (see Device::isDrawIndirectCountSupported)
+  virtual void drawIndexedIndirect(Buffer* buffer, uint64_t offset = 0)                                                                                          = 0;
+  virtual void multiDrawIndexedIndirect(Buffer* buffer, uint64_t offset, uint32_t drawCount, uint32_t stride = sizeof(DrawIndexedIndirectCommand))               = 0;
+  virtual void multiDrawIndexedIndirectCount(Buffer* buffer, uint64_t offset, Buffer* countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride = sizeof(DrawIndexedIndirectCommand)) = 0;
+
+  // Compute dispatch - outside of render passes, with a compute pipeline set
+  virtual void dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1) = 0;
+  // buffer holds a DispatchIndirectCommand at offset and must be created with BufferCreateFlag::IndirectCommand
+  virtual void dispatchIndirect(Buffer* buffer, uint64_t offset = 0)                              = 0;
 
-  // Resource barriers
+  // Resource barriers - texture layout transitions, buffer access transitions and UAV barriers (see ResourceBarrierDesc)
   virtual void resourceBarrier(const ResourceBarrierDesc& barrier) = 0;
+  // Several barriers recorded as one batch (a single vkCmdPipelineBarrier / ResourceBarrier call for the textures)
+  virtual void resourceBarriers(const std::vector<ResourceBarrierDesc>& barriers) = 0;
 
   // Render pass operations
   virtual void beginRenderPass(RenderPass* renderPass, Framebuffer* framebuffer, const std::vector<ClearValue>& clearValues) = 0;
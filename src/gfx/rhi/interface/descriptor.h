@@ -48,6 +48,8 @@ class DescriptorSet {
   virtual void setUniformBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0, uint64_t range = 0) = 0;
   virtual void setTextureSampler(uint32_t binding, Texture* texture, Sampler* sampler) = 0;
   virtual void setTexture(uint32_t binding, Texture* texture, ResourceLayout layout = ResourceLayout::ShaderReadOnly) = 0;
+  // writes one element of a texture array binding (bindless tables), setTexture() writes element 0
+  virtual void setTextureArrayElement(uint32_t binding, uint32_t arrayElement, Texture* texture, ResourceLayout layout = ResourceLayout::ShaderReadOnly) = 0;
   virtual void setSampler(uint32_t binding, Sampler* sampler) = 0;
   virtual void setStorageBuffer(uint32_t binding, Buffer* buffer, uint64_t offset = 0, uint64_t range = 0) = 0;
 
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -17,9 +18,11 @@ namespace rhi {
 
 class Buffer;
 class Texture;
+class MemoryHeap;
 class Sampler;
 class Shader;
 class GraphicsPipeline;
+class ComputePipeline;
 class DescriptorSetLayout;
 class DescriptorSet;
 class RenderPass;
@@ -57,6 +60,11 @@ class Device {
    * Create graphics pipeline with automatic shader reflection
    */
   virtual std::unique_ptr<GraphicsPipeline>    createGraphicsPipelineWithReflection(const GraphicsPipelineDesc& desc) = 0;
+  virtual std::unique_ptr<ComputePipeline>     createComputePipeline(const ComputePipelineDesc& desc)                   = 0;
+  /**
+   * Create compute pipeline with set layouts generated from the compute shader reflection
+   */
+  virtual std::unique_ptr<ComputePipeline>     createComputePipelineWithReflection(const ComputePipelineDesc& desc)     = 0;
   virtual std::unique_ptr<DescriptorSetLayout> createDescriptorSetLayout(const DescriptorSetLayoutDesc& desc)           = 0;
   virtual std::unique_ptr<DescriptorSet>       createDescriptorSet(const DescriptorSetLayout* layout)                   = 0;
   virtual std::unique_ptr<RenderPass>          createRenderPass(const RenderPassDesc& desc)                             = 0;
@@ -65,17 +73,40 @@ class Device {
   virtual std::unique_ptr<Fence>               createFence(const FenceDesc& desc = FenceDesc())                         = 0;
   virtual std::unique_ptr<Semaphore>           createSemaphore()                                                        = 0;
   virtual std::unique_ptr<SwapChain>           createSwapChain(const SwapchainDesc& desc)                               = 0;
+  virtual std::unique_ptr<MemoryHeap>          createMemoryHeap(const MemoryHeapDesc& desc)                             = 0;
+
+  /**
+   * Create a texture placed at offset in the heap - its memory may be shared with other textures placed in the same range.
+   * desc must have Rtv or Dsv usage. The contents are undefined when another texture used the range before, the first
+   * barrier of the texture must discard them then (ResourceBarrierDesc::discard)
+   */
+  virtual std::unique_ptr<Texture>             createAliasedTexture(const TextureDesc& desc, MemoryHeap* heap, uint64_t offset) = 0;
+
+  // size, alignment and memory types of a texture placed in a MemoryHeap
+  virtual MemoryRequirements                   getTextureMemoryRequirements(const TextureDesc& desc)                    = 0;
 
   virtual void updateBuffer(Buffer* buffer, const void* data, size_t size, size_t offset = 0)                                     = 0;
   virtual void updateTexture(Texture* texture, const void* data, size_t dataSize, uint32_t mipLevel = 0, uint32_t arrayLayer = 0) = 0;
 
   /**
    * @param cmdBuffer The command buffer to submit. MUST be in the "closed" state (end() must have been called prior to this method)
+   *
+   * The command buffer is executed on the queue it was created for (CommandBufferDesc::queueType). Submissions to
+   * different queues are ordered only through the wait / signal semaphores
    */
-  virtual void submitCommandBuffer(CommandBuffer* cmdBuffer, Fence* signalFence = nullptr, const std::vector<Semaphore*>& waitSemaphores = {}, const std::vector<Semaphore*>& signalSemaphores = {}) = 0;
+  virtual void submitCommandBuffer(CommandBuffer* cmdBuffer, Fence* signalFence = nullptr, std::span<Semaphore* const> waitSemaphores = {}, std::span<Semaphore* const> signalSemaphores = {}) = 0;
 
   virtual void waitIdle() = 0;
 
+  // true if QueueType::Compute submissions run on a separate queue and may overlap graphics work
+  virtual bool isAsyncComputeSupported() const = 0;
+
+  // true if CommandBuffer::multiDrawIndexedIndirectCount can be used (GPU-written draw count)
+  virtual bool isDrawIndirectCountSupported() const = 0;
+
+  // true if indirect draws may use a non-zero firstInstance (DrawIndexedIndirectCommand::firstInstance)
+  virtual bool isDrawIndirectFirstInstanceSupported() const = 0;
+
   private:
   // TODO: change constness if needed
   const Window* const m_window_;
@@ -0,0 +1,36 @@
+#ifndef ARISE_MEMORY_HEAP_H
+#define ARISE_MEMORY_HEAP_H
+
+#include "gfx/rhi/common/rhi_enums.h"
+#include "gfx/rhi/common/rhi_types.h"
+
+namespace arise {
+namespace gfx {
+namespace rhi {
+
+/**
+ * A block of device memory that aliased textures are placed in.
+ *
+ * Textures placed in overlapping ranges of the heap share memory, only one of them may be used at a time
+ * (see Device::createAliasedTexture). The heap must outlive the textures placed in it.
+ */
+class MemoryHeap {
+  public:
+  MemoryHeap(const MemoryHeapDesc& desc)
+      : m_desc_(desc) {}
+
+  virtual ~MemoryHeap() = default;
+
+  const MemoryHeapDesc& getDesc() const { return m_desc_; }
+
+  uint64_t getSize() const { return m_desc_.size; }
+
+  protected:
+  MemoryHeapDesc m_desc_;
+};
+
+}  // namespace rhi
+}  // namespace gfx
+}  // namespace arise
+
+#endif  // ARISE_MEMORY_HEAP_H
@@ -34,8 +34,12 @@ class Pipeline {
 
   virtual bool rebuild() = 0;
 
+  // size in bytes of the push constant block the pipeline layout was created with (0 - no push constants)
+  uint32_t getPushConstantSize() const { return m_pushConstantSize_; }
+
   protected:
   std::atomic<int32_t> m_updateFrame{-1};
+  uint32_t             m_pushConstantSize_ = 0;
 };
 
 /**
@@ -63,6 +67,29 @@ class GraphicsPipeline : public Pipeline {
   PipelineLayoutDesc   m_reflectionLayout_;
 };
 
+/**
+ * Represents a compute pipeline state object - a single compute shader and the layout of the resources it accesses.
+ * Bound with CommandBuffer::setPipeline and executed with dispatch / dispatchIndirect.
+ */
+class ComputePipeline : public Pipeline {
+  public:
+  ComputePipeline(const ComputePipelineDesc& desc, const PipelineLayoutDesc& reflectionLayout = {})
+      : m_desc_(desc)
+      , m_reflectionLayout_(reflectionLayout) {}
+
+  virtual ~ComputePipeline() = default;
+
+  PipelineType getType() const { return PipelineType::Compute; }
+
+  const ComputePipelineDesc& getDesc() const { return m_desc_; }
+
+  const PipelineLayoutDesc& getReflectionLayout() const { return m_reflectionLayout_; }
+
+  protected:
+  ComputePipelineDesc m_desc_;
+  PipelineLayoutDesc  m_reflectionLayout_;
+};
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
@@ -28,6 +28,8 @@ class RenderPass {
 
   virtual bool shouldClearStencil() const = 0;
 
+  uint32_t getColorAttachmentCount() const { return static_cast<uint32_t>(m_desc_.colorAttachments.size()); }
+
   protected:
   RenderPassDesc m_desc_;
 };
@@ -23,10 +23,36 @@ void PipelineLayoutBuilder::addShader(const ShaderMeta& meta) {
   }
 }
 
+void PipelineLayoutBuilder::addDynamicUniformBuffer(const DynamicUniformBufferBinding& location) {
+  m_dynamicUniformBuffers.push_back(location);
+}
+
 PipelineLayoutDesc PipelineLayoutBuilder::build() {
   PipelineLayoutDesc desc;
   desc.pushConstantSize = m_maxPushConstantSize;
 
+  for (const auto& location : m_dynamicUniformBuffers) {
+    auto setIt = m_setBindings.find(location.set);
+    if (setIt == m_setBindings.end()) {
+      continue;
+    }
+
+    auto bindingIt = setIt->second.find(location.binding);
+    if (bindingIt == setIt->second.end()) {
+      continue;
+    }
+
+    ShaderResourceBinding& binding = bindingIt->second;
+    if (binding.type != ShaderBindingType::Uniformbuffer) {
+      LOG_WARN("Set {} binding {} ('{}') is requested as dynamic uniform buffer but is not a uniform buffer",
+               location.set,
+               location.binding,
+               binding.name);
+      continue;
+    }
+    binding.type = ShaderBindingType::UniformbufferDynamic;
+  }
+
   // Build descriptor set layouts for each set
   for (const auto& [setIndex, bindings] : m_setBindings) {
     if (bindings.empty()) {
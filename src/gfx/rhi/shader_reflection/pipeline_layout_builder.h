@@ -5,6 +5,7 @@
 #include "shader_reflection_types.h"
 
 #include <map>
+#include <vector>
 
 namespace arise {
 namespace gfx {
@@ -17,11 +18,15 @@ class PipelineLayoutBuilder {
   public:
   void addShader(const ShaderMeta& meta);
 
+  // the uniform buffer at this location is bound with a dynamic offset (ignored if no shader declares it)
+  void addDynamicUniformBuffer(const DynamicUniformBufferBinding& location);
+
   PipelineLayoutDesc build();
 
   private:
   std::map<uint32_t, std::map<uint32_t, ShaderResourceBinding>> m_setBindings;  // set -> binding -> resource
   uint32_t                                                      m_maxPushConstantSize = 0;
+  std::vector<DynamicUniformBufferBinding>                      m_dynamicUniformBuffers;
 
   void mergeBinding_(ShaderResourceBinding& existing, const ShaderResourceBinding& newBinding);
 };
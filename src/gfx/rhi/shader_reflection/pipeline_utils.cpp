@@ -7,14 +7,21 @@
 #include "gfx/rhi/shader_reflection/shader_reflection_utils.h"
 #include "utils/logger/log.h"
 
+#include <algorithm>
+
 namespace arise {
 namespace gfx {
 namespace rhi {
 namespace pipeline_utils {
 
-PipelineLayoutDesc generatePipelineLayoutFromShaders(const std::vector<Shader*>& shaders) {
+PipelineLayoutDesc generatePipelineLayoutFromShaders(
+    const std::vector<Shader*>& shaders, const std::vector<DynamicUniformBufferBinding>& dynamicUniformBuffers) {
   PipelineLayoutBuilder builder;
 
+  for (const auto& location : dynamicUniformBuffers) {
+    builder.addDynamicUniformBuffer(location);
+  }
+
   for (const auto* shader : shaders) {
     if (shader) {
       builder.addShader(shader->getMeta());
@@ -29,6 +36,24 @@ PipelineLayoutDesc generatePipelineLayoutFromShaders(const std::vector<Shader*>&
   return result;
 }
 
+uint32_t getPushConstantSize(const std::vector<Shader*>& shaders) {
+  uint32_t size = 0;
+  for (const auto* shader : shaders) {
+    if (shader) {
+      size = std::max(size, shader->getMeta().pushConstantSize);
+    }
+  }
+
+  size = (size + 3) & ~3u;
+
+  if (size > kMaxPushConstantSize) {
+    LOG_ERROR("Push constant block of {} bytes exceeds the {} bytes limit", size, kMaxPushConstantSize);
+    return 0;
+  }
+
+  return size;
+}
+
 std::vector<const DescriptorSetLayout*> createDescriptorSetLayouts(
     Device*                                            device,
     const PipelineLayoutDesc&                          pipelineLayout,
@@ -16,7 +16,18 @@ class DescriptorSetLayout;
 
 namespace pipeline_utils {
 
-PipelineLayoutDesc generatePipelineLayoutFromShaders(const std::vector<Shader*>& shaders);
+/**
+ * @param dynamicUniformBuffers uniform buffers the pipeline binds with dynamic offsets, reflection reports them as
+ *                              regular uniform buffers
+ */
+PipelineLayoutDesc generatePipelineLayoutFromShaders(
+    const std::vector<Shader*>& shaders, const std::vector<DynamicUniformBufferBinding>& dynamicUniformBuffers = {});
+
+/**
+ * Push constant blocks of all stages share one range starting at offset 0
+ * @return size of the largest block rounded up to 4 bytes, 0 if it exceeds kMaxPushConstantSize
+ */
+uint32_t getPushConstantSize(const std::vector<Shader*>& shaders);
 
 std::vector<const DescriptorSetLayout*> createDescriptorSetLayouts(
     Device*                                            device,
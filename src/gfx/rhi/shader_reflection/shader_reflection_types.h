@@ -88,6 +88,35 @@ inline uint32_t getLocationForSemantic(const std::string& semanticName) {
   return (it != kVertexSemanticToLocation.end()) ? it->second : UINT32_MAX;
 }
 
+//------------------------------------------------------
+// Constant buffers bound with dynamic offsets
+//------------------------------------------------------
+
+/**
+ * Constant buffer sub-allocated from the per-frame upload ring. Reflection can't tell it from a regular uniform
+ * buffer, so the pipeline requests the promotion to UniformbufferDynamic by location to match the layout created on
+ * CPU side
+ */
+struct DynamicUniformBufferBinding {
+  uint32_t set     = 0;
+  uint32_t binding = 0;
+};
+
+//------------------------------------------------------
+// Push constants
+//------------------------------------------------------
+
+/**
+ * Push constant blocks are declared with PUSH_CONSTANTS() from push_constants.hlsli. On DX12 they are root
+ * constants in this register space, so reflection reports them as push constants instead of a descriptor set
+ */
+inline constexpr uint32_t kPushConstantRegisterSpace = 100;
+
+/**
+ * Minimum maxPushConstantsSize guaranteed by Vulkan, also keeps DX12 root signatures well below their 64 DWORD limit
+ */
+inline constexpr uint32_t kMaxPushConstantSize = 128;
+
 }  // namespace rhi
 }  // namespace gfx
 }  // namespace arise
@@ -35,6 +35,8 @@ const char* bindingTypeToString(ShaderBindingType type) {
       return "TextureUav";
     case ShaderBindingType::Uniformbuffer:
       return "UniformBuffer";
+    case ShaderBindingType::UniformbufferDynamic:
+      return "UniformBufferDynamic";
     case ShaderBindingType::BufferSrv:
       return "BufferSrv";
     default:
@@ -240,10 +240,10 @@ VertexFormat VertexInputBuilder::getFormatForLocation_(const ShaderVertexInput&
         return VertexFormat::Rgba32f;
     }
   } else {
-    LOG_WARN("Non-float vertex input format detected. Defaulting to Rgba32f for multi-location inputs.");
     if (locationIndex == 0 && totalComponents <= 4) {
       return input.format;
     } else {
+      LOG_WARN("Non-float vertex input format detected. Defaulting to Rgba32f for multi-location inputs.");
       return VertexFormat::Rgba32f;
     }
   }
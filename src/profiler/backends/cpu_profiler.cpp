@@ -0,0 +1,358 @@
+#include "profiler/backends/cpu_profiler.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace arise {
+namespace cpu {
+
+namespace {
+
+// zone buffer of the current thread, retired when the thread exits
+struct ThreadBuffer {
+  std::shared_ptr<ZoneEventBuffer> buffer;
+
+  ~ThreadBuffer() {
+    if (buffer) {
+      buffer->retire();
+    }
+  }
+};
+
+thread_local ThreadBuffer s_threadBuffer;
+
+constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+bool isSameZone(const char* lhs, const char* rhs) {
+  // the same literal may have different addresses in different translation units
+  return lhs == rhs || (lhs && rhs && std::strcmp(lhs, rhs) == 0);
+}
+
+// zone tree where the children of a node are merged by name, flattened to ZoneNode pre-order
+class ZoneTreeBuilder {
+  public:
+  static constexpr uint32_t kRoot = 0;
+
+  // the root isn't part of the flattened tree, its children are the threads
+  ZoneTreeBuilder() { m_nodes_.emplace_back(); }
+
+  // child of the parent with the name, created on first use
+  uint32_t getChild(uint32_t parent, const char* name, uint32_t threadId) {
+    uint32_t lastChild = kInvalidIndex;
+    for (uint32_t child = m_nodes_[parent].firstChild; child != kInvalidIndex; child = m_nodes_[child].nextSibling) {
+      if (m_nodes_[child].zone.threadId == threadId && isSameZone(m_nodes_[child].zone.name, name)) {
+        return child;
+      }
+      lastChild = child;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_nodes_.size());
+
+    Node node;
+    node.zone.name     = name;
+    node.zone.threadId = threadId;
+    m_nodes_.push_back(node);
+
+    if (lastChild == kInvalidIndex) {
+      m_nodes_[parent].firstChild = index;
+    } else {
+      m_nodes_[lastChild].nextSibling = index;
+    }
+    return index;
+  }
+
+  ZoneNode& getZone(uint32_t index) { return m_nodes_[index].zone; }
+
+  void flatten(std::vector<ZoneNode>& nodes) const {
+    nodes.clear();
+    for (uint32_t child = m_nodes_[kRoot].firstChild; child != kInvalidIndex; child = m_nodes_[child].nextSibling) {
+      flatten_(child, 0, nodes);
+    }
+  }
+
+  private:
+  struct Node {
+    ZoneNode zone;
+    uint32_t firstChild  = kInvalidIndex;
+    uint32_t nextSibling = kInvalidIndex;
+  };
+
+  void flatten_(uint32_t index, uint32_t depth, std::vector<ZoneNode>& nodes) const {
+    const size_t position = nodes.size();
+    nodes.push_back(m_nodes_[index].zone);
+    nodes[position].depth = depth;
+
+    for (uint32_t child = m_nodes_[index].firstChild; child != kInvalidIndex; child = m_nodes_[child].nextSibling) {
+      flatten_(child, depth + 1, nodes);
+    }
+
+    nodes[position].subtreeSize = static_cast<uint32_t>(nodes.size() - position);
+  }
+
+  std::vector<Node> m_nodes_;
+};
+
+}  // namespace
+
+CpuProfiler& CpuProfiler::s_get() {
+  static CpuProfiler instance;
+  return instance;
+}
+
+CpuProfiler::CpuProfiler()
+    : m_frames_(kFrameWindow)
+    , m_frameBegin_(s_now())
+    , m_epoch_(m_frameBegin_) {}
+
+uint64_t CpuProfiler::s_now() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+void CpuProfiler::s_recordZone(const ZoneEvent& event) {
+  ZoneEventBuffer* buffer = s_threadBuffer.buffer.get();
+  if (!buffer) {
+    buffer = s_get().registerThreadBuffer_();
+  }
+  buffer->push(event);
+}
+
+ZoneEventBuffer* CpuProfiler::registerThreadBuffer_() {
+  std::lock_guard<std::mutex> lock(m_buffersMutex_);
+  s_threadBuffer.buffer = std::make_shared<ZoneEventBuffer>(kThreadBufferCapacity, m_nextThreadId_++);
+  m_buffers_.push_back(s_threadBuffer.buffer);
+  return s_threadBuffer.buffer.get();
+}
+
+void CpuProfiler::endFrame() {
+  const uint64_t now = s_now();
+
+  // the thread that closes the frames is the main thread
+  if (m_mainThreadId_ == UINT32_MAX) {
+    ZoneEventBuffer* buffer = s_threadBuffer.buffer ? s_threadBuffer.buffer.get() : registerThreadBuffer_();
+    m_mainThreadId_         = buffer->getThreadId();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_buffersMutex_);
+    m_drainedBuffers_.assign(m_buffers_.begin(), m_buffers_.end());
+  }
+
+  // while paused the buffers are still drained, so they don't overflow
+  Frame* frame = nullptr;
+  if (!m_paused_) {
+    frame        = &m_frames_[m_nextFrameIndex_ % kFrameWindow];
+    frame->begin = m_frameBegin_;
+    frame->end   = now;
+    frame->index = m_nextFrameIndex_;
+    frame->events.clear();
+  }
+
+  for (const auto& buffer : m_drainedBuffers_) {
+    const uint32_t threadId = buffer->getThreadId();
+    buffer->drain([frame, threadId](const ZoneEvent& event) {
+      if (frame) {
+        frame->events.push_back(TraceEvent{event, threadId});
+      }
+    });
+    m_droppedCount_ += buffer->takeDroppedCount();
+  }
+
+  if (frame) {
+    buildFrameTree_(*frame);
+    ++m_nextFrameIndex_;
+    m_frameCount_ = std::min(m_frameCount_ + 1, kFrameWindow);
+  }
+
+  // buffers of exited threads are released once they're drained
+  {
+    std::lock_guard<std::mutex> lock(m_buffersMutex_);
+    std::erase_if(m_buffers_, [](const std::shared_ptr<ZoneEventBuffer>& buffer) {
+      return buffer->isRetired() && buffer->isEmpty();
+    });
+  }
+  m_drainedBuffers_.clear();
+
+  m_frameBegin_ = now;
+}
+
+void CpuProfiler::buildFrameTree_(Frame& frame) {
+  // a parent begins before its children (or with them, at a lower depth)
+  std::sort(frame.events.begin(), frame.events.end(), [](const TraceEvent& lhs, const TraceEvent& rhs) {
+    if (lhs.threadId != rhs.threadId) {
+      return lhs.threadId < rhs.threadId;
+    }
+    if (lhs.event.begin != rhs.event.begin) {
+      return lhs.event.begin < rhs.event.begin;
+    }
+    return lhs.event.depth < rhs.event.depth;
+  });
+
+  struct OpenZone {
+    uint64_t end   = 0;
+    uint32_t depth = 0;
+    uint32_t node  = 0;
+  };
+
+  ZoneTreeBuilder       builder;
+  std::vector<OpenZone> openZones;
+  uint32_t              threadNode = kInvalidIndex;
+  uint32_t              threadId   = 0;
+
+  for (const auto& traceEvent : frame.events) {
+    const ZoneEvent& event = traceEvent.event;
+
+    if (threadNode == kInvalidIndex || traceEvent.threadId != threadId) {
+      threadId   = traceEvent.threadId;
+      threadNode = builder.getChild(ZoneTreeBuilder::kRoot, nullptr, threadId);
+      openZones.clear();
+    }
+
+    // zones that don't contain this one are closed. A parent that is still running at the end of the frame isn't
+    // drained yet, its children become top-level zones of this frame
+    while (!openZones.empty() && (openZones.back().depth >= event.depth || openZones.back().end < event.end)) {
+      openZones.pop_back();
+    }
+
+    const bool     isTopLevel = openZones.empty();
+    const uint32_t parent     = isTopLevel ? threadNode : openZones.back().node;
+    const uint32_t node       = builder.getChild(parent, event.name, threadId);
+    const uint64_t duration   = event.end - event.begin;
+
+    ZoneNode& zone      = builder.getZone(node);
+    zone.callCount     += 1;
+    zone.inclusiveTime += duration;
+    zone.exclusiveTime += duration;
+
+    if (isTopLevel) {
+      builder.getZone(threadNode).inclusiveTime += duration;
+    } else {
+      builder.getZone(parent).exclusiveTime -= duration;
+    }
+
+    openZones.push_back(OpenZone{event.end, event.depth, node});
+  }
+
+  builder.flatten(frame.nodes);
+}
+
+void CpuProfiler::getWindowSummary(std::vector<ZoneNode>& nodes) const {
+  ZoneTreeBuilder       builder;
+  std::vector<uint32_t> path;  // node of the builder for every depth of the current frame node
+
+  const uint64_t firstFrame = m_nextFrameIndex_ - m_frameCount_;
+  for (uint64_t frameIndex = firstFrame; frameIndex < m_nextFrameIndex_; ++frameIndex) {
+    const Frame& frame = m_frames_[frameIndex % kFrameWindow];
+
+    path.clear();
+    for (const auto& frameNode : frame.nodes) {
+      path.resize(frameNode.depth);
+
+      const uint32_t parent = path.empty() ? ZoneTreeBuilder::kRoot : path.back();
+      const uint32_t node   = builder.getChild(parent, frameNode.name, frameNode.threadId);
+
+      ZoneNode& zone      = builder.getZone(node);
+      zone.callCount     += frameNode.callCount;
+      zone.inclusiveTime += frameNode.inclusiveTime;
+      zone.exclusiveTime += frameNode.exclusiveTime;
+
+      path.push_back(node);
+    }
+  }
+
+  builder.flatten(nodes);
+}
+
+std::string CpuProfiler::getThreadName(uint32_t threadId) const {
+  if (threadId == m_mainThreadId_) {
+    return "Main thread";
+  }
+  return "Thread " + std::to_string(threadId);
+}
+
+std::string CpuProfiler::exportChromeTrace() const {
+  rapidjson::StringBuffer                    buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+  // microseconds since the start of the profiler (zones that began before it are negative)
+  auto toMicroseconds = [this](uint64_t time) {
+    return (static_cast<double>(time) - static_cast<double>(m_epoch_)) / 1000.0;
+  };
+
+  auto writeCompleteEvent = [&](const char* name, uint64_t begin, uint64_t end, uint32_t threadId) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(name);
+    writer.Key("ph");
+    writer.String("X");
+    writer.Key("ts");
+    writer.Double(toMicroseconds(begin));
+    writer.Key("dur");
+    writer.Double(static_cast<double>(end - begin) / 1000.0);
+    writer.Key("pid");
+    writer.Uint(0);
+    writer.Key("tid");
+    writer.Uint(threadId);
+    writer.EndObject();
+  };
+
+  std::vector<uint32_t> threadIds;
+
+  writer.StartObject();
+  writer.Key("displayTimeUnit");
+  writer.String("ms");
+  writer.Key("traceEvents");
+  writer.StartArray();
+
+  const uint64_t firstFrame = m_nextFrameIndex_ - m_frameCount_;
+  for (uint64_t frameIndex = firstFrame; frameIndex < m_nextFrameIndex_; ++frameIndex) {
+    const Frame& frame = m_frames_[frameIndex % kFrameWindow];
+
+    // on the main thread the frame contains the zones
+    writeCompleteEvent("Frame", frame.begin, frame.end, m_mainThreadId_);
+
+    for (const auto& traceEvent : frame.events) {
+      writeCompleteEvent(traceEvent.event.name, traceEvent.event.begin, traceEvent.event.end, traceEvent.threadId);
+      threadIds.push_back(traceEvent.threadId);
+    }
+  }
+
+  if (m_frameCount_ > 0) {
+    threadIds.push_back(m_mainThreadId_);
+  }
+  std::sort(threadIds.begin(), threadIds.end());
+  threadIds.erase(std::unique(threadIds.begin(), threadIds.end()), threadIds.end());
+
+  for (const uint32_t threadId : threadIds) {
+    const std::string threadName = getThreadName(threadId);
+
+    writer.StartObject();
+    writer.Key("name");
+    writer.String("thread_name");
+    writer.Key("ph");
+    writer.String("M");
+    writer.Key("pid");
+    writer.Uint(0);
+    writer.Key("tid");
+    writer.Uint(threadId);
+    writer.Key("args");
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(threadName.c_str());
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  writer.EndArray();
+  writer.EndObject();
+
+  return buffer.GetString();
+}
+
+}  // namespace cpu
+}  // namespace arise
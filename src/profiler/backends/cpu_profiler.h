@@ -0,0 +1,217 @@
+#ifndef ARISE_CPU_PROFILER_H
+#define ARISE_CPU_PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace arise {
+namespace cpu {
+
+// zone finished by a thread, timestamps are nanoseconds of the steady clock
+struct ZoneEvent {
+  const char* name  = nullptr;  // string literal of the call site
+  uint64_t    begin = 0;
+  uint64_t    end   = 0;
+  uint32_t    depth = 0;  // zones open on the thread when this one began
+};
+
+/**
+ * Fixed-capacity ring of the zones finished by one thread. The thread pushes, CpuProfiler::endFrame() drains it on the
+ * main thread (single producer / single consumer, no locks). Zones finished while it's full are dropped and counted.
+ */
+class ZoneEventBuffer {
+  public:
+  // capacity must be a power of two
+  ZoneEventBuffer(size_t capacity, uint32_t threadId)
+      : m_events_(new ZoneEvent[capacity])
+      , m_capacity_(capacity)
+      , m_mask_(capacity - 1)
+      , m_threadId_(threadId) {}
+
+  ZoneEventBuffer(const ZoneEventBuffer&)            = delete;
+  ZoneEventBuffer& operator=(const ZoneEventBuffer&) = delete;
+
+  // producer
+  void push(const ZoneEvent& event) {
+    const uint64_t writePosition = m_writePosition_.load(std::memory_order_relaxed);
+    if (writePosition - m_readPosition_.load(std::memory_order_acquire) == m_capacity_) {
+      m_droppedCount_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    m_events_[writePosition & m_mask_] = event;
+    m_writePosition_.store(writePosition + 1, std::memory_order_release);
+  }
+
+  // consumer: calls callback(const ZoneEvent&) for every pushed event and frees their slots
+  template <typename Callback>
+  void drain(Callback&& callback) {
+    const uint64_t writePosition = m_writePosition_.load(std::memory_order_acquire);
+    uint64_t       readPosition  = m_readPosition_.load(std::memory_order_relaxed);
+    for (; readPosition != writePosition; ++readPosition) {
+      callback(m_events_[readPosition & m_mask_]);
+    }
+    m_readPosition_.store(readPosition, std::memory_order_release);
+  }
+
+  uint64_t takeDroppedCount() { return m_droppedCount_.exchange(0, std::memory_order_relaxed); }
+
+  uint32_t getThreadId() const { return m_threadId_; }
+
+  bool isEmpty() const {
+    return m_readPosition_.load(std::memory_order_acquire) == m_writePosition_.load(std::memory_order_acquire);
+  }
+
+  // the owning thread exited, the buffer is released once it's drained
+  void retire() { m_retired_.store(true, std::memory_order_release); }
+
+  bool isRetired() const { return m_retired_.load(std::memory_order_acquire); }
+
+  private:
+  std::unique_ptr<ZoneEvent[]> m_events_;
+  const size_t                 m_capacity_;
+  const size_t                 m_mask_;
+  const uint32_t               m_threadId_;
+
+  // separate cache lines for the producer and the consumer
+  alignas(64) std::atomic<uint64_t> m_writePosition_{0};
+  alignas(64) std::atomic<uint64_t> m_readPosition_{0};
+
+  std::atomic<uint64_t> m_droppedCount_{0};
+  std::atomic<bool>     m_retired_{false};
+};
+
+/**
+ * Node of an aggregated zone tree - zones of a thread with the same name and the same parent are merged. Nodes are
+ * stored in pre-order, the nodes at depth 0 are threads (name is nullptr, inclusiveTime sums their top-level zones).
+ */
+struct ZoneNode {
+  const char* name          = nullptr;
+  uint32_t    threadId      = 0;
+  uint32_t    depth         = 0;
+  uint32_t    subtreeSize   = 1;  // the node and its descendants, skip them with index += subtreeSize
+  uint32_t    callCount     = 0;
+  uint64_t    inclusiveTime = 0;  // nanoseconds, children included
+  uint64_t    exclusiveTime = 0;  // nanoseconds, children excluded
+};
+
+/**
+ * Built-in hierarchical CPU profiler, independent of Tracy (see CPU_ZONE* in profiler/cpu.h).
+ *
+ * Every thread records its finished zones into its own ZoneEventBuffer. endFrame() (PROFILE_FRAME) drains the buffers
+ * on the main thread and aggregates the zones into a tree per thread, so zones of other threads count for the frame in
+ * which they finished. The trees and the zones of the last kFrameWindow frames are kept for the editor and for the
+ * Chrome trace export.
+ *
+ * Apart from the zone recording, the profiler is used from the main thread only.
+ */
+class CpuProfiler {
+  public:
+  static constexpr size_t kThreadBufferCapacity = 16 * 1024;  // zones per thread between two frames
+  static constexpr size_t kFrameWindow          = 120;
+
+  static CpuProfiler& s_get();
+
+  CpuProfiler(const CpuProfiler&)            = delete;
+  CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+  static uint64_t s_now();
+
+  // records a finished zone of the calling thread
+  static void s_recordZone(const ZoneEvent& event);
+
+  // closes the current frame, main thread
+  void endFrame();
+
+  // while paused, finished frames are discarded and the window stays as is
+  void setPaused(bool paused) { m_paused_ = paused; }
+
+  bool isPaused() const { return m_paused_; }
+
+  // number of frames in the window (at most kFrameWindow)
+  size_t getFrameCount() const { return m_frameCount_; }
+
+  // tree of the window - times and call counts are summed over getFrameCount() frames
+  void getWindowSummary(std::vector<ZoneNode>& nodes) const;
+
+  std::string getThreadName(uint32_t threadId) const;
+
+  // zones dropped because a thread buffer was full, since the start
+  uint64_t getDroppedCount() const { return m_droppedCount_; }
+
+  // Chrome trace event JSON (chrome://tracing, Perfetto) of the frames in the window
+  std::string exportChromeTrace() const;
+
+  private:
+  struct TraceEvent {
+    ZoneEvent event;
+    uint32_t  threadId = 0;
+  };
+
+  struct Frame {
+    uint64_t                begin = 0;
+    uint64_t                end   = 0;
+    uint64_t                index = 0;
+    std::vector<ZoneNode>   nodes;
+    std::vector<TraceEvent> events;
+  };
+
+  CpuProfiler();
+
+  ZoneEventBuffer* registerThreadBuffer_();
+
+  // aggregates the drained events into the nodes of the frame
+  void buildFrameTree_(Frame& frame);
+
+  std::mutex                                    m_buffersMutex_;
+  std::vector<std::shared_ptr<ZoneEventBuffer>> m_buffers_;
+  uint32_t                                      m_nextThreadId_ = 0;
+
+  // main thread only
+  std::vector<std::shared_ptr<ZoneEventBuffer>> m_drainedBuffers_;
+  std::vector<Frame>                            m_frames_;  // circular, frame i is at i % kFrameWindow
+  size_t                                        m_frameCount_     = 0;
+  uint64_t                                      m_nextFrameIndex_ = 0;
+  uint64_t                                      m_frameBegin_     = 0;
+  uint64_t                                      m_epoch_          = 0;
+  uint64_t                                      m_droppedCount_   = 0;
+  bool                                          m_paused_         = false;
+  uint32_t                                      m_mainThreadId_   = UINT32_MAX;
+};
+
+/**
+ * Scoped zone of the built-in profiler, the name must outlive the profiler (string literal).
+ */
+class ProfileZone {
+  public:
+  explicit ProfileZone(const char* name)
+      : m_name_(name)
+      , m_depth_(s_depth++)
+      , m_begin_(CpuProfiler::s_now()) {}
+
+  ~ProfileZone() {
+    const uint64_t end = CpuProfiler::s_now();
+    --s_depth;
+    CpuProfiler::s_recordZone(ZoneEvent{m_name_, m_begin_, end, m_depth_});
+  }
+
+  ProfileZone(const ProfileZone&)            = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+
+  private:
+  const char* m_name_;
+  uint32_t    m_depth_;
+  uint64_t    m_begin_;
+
+  static inline thread_local uint32_t s_depth = 0;
+};
+
+}  // namespace cpu
+}  // namespace arise
+
+#endif  // ARISE_CPU_PROFILER_H
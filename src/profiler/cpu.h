@@ -3,17 +3,36 @@
 
 #include "profiler/backends/config.h"
 
+// built-in profiler (profiler/backends/cpu_profiler.h), records the zones next to Tracy or without it
+#ifdef ARISE_USE_BUILTIN_CPU_PROFILING
+#include "profiler/backends/cpu_profiler.h"
+
+#define ARISE_CPU_CONCAT_(a, b)      a##b
+#define ARISE_CPU_CONCAT(a, b)       ARISE_CPU_CONCAT_(a, b)
+#define ARISE_BUILTIN_CPU_ZONE(name) arise::cpu::ProfileZone ARISE_CPU_CONCAT(cpuZone, __LINE__)(name)
+#else
+#define ARISE_BUILTIN_CPU_ZONE(name)
+#endif
+
 #ifdef ARISE_USE_CPU_PROFILING
 #include "utils/color/color.h"
 
 #include <tracy/Tracy.hpp>
 
-#define CPU_ZONE()                         ZoneScoped
-#define CPU_ZONE_N(name)                   ZoneScopedN(name)
+#define CPU_ZONE() \
+  ZoneScoped;      \
+  ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
+#define CPU_ZONE_N(name) \
+  ZoneScopedN(name);     \
+  ARISE_BUILTIN_CPU_ZONE(name)
 
 // for color you can use predefined colors or g_toFloatArray function from color namespace
-#define CPU_ZONE_C(color)                  ZoneScopedC((color) >> 8)
-#define CPU_ZONE_NC(name, color)           ZoneScopedNC(name, (color) >> 8)
+#define CPU_ZONE_C(color)    \
+  ZoneScopedC((color) >> 8); \
+  ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
+#define CPU_ZONE_NC(name, color)    \
+  ZoneScopedNC(name, (color) >> 8); \
+  ARISE_BUILTIN_CPU_ZONE(name)
 
 // Lockable objects tracking
 #define CPU_LOCKABLE(type, varname)        TracyLockable(type, varname)
@@ -23,23 +42,25 @@
 #define CPU_LOCK_MARK(varname)             LockMark(varname)
 
 // Automatic function profiling
-#define CPU_FUNCTION() \
-  ZoneScoped;          \
-  ZoneName(__FUNCTION__, strlen(__FUNCTION__))
-#define CPU_METHOD() \
-  ZoneScoped;        \
-  ZoneName(__PRETTY_FUNCTION__, strlen(__PRETTY_FUNCTION__))
+#define CPU_FUNCTION()                          \
+  ZoneScoped;                                   \
+  ZoneName(__FUNCTION__, strlen(__FUNCTION__)); \
+  ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
+#define CPU_METHOD()                                          \
+  ZoneScoped;                                                 \
+  ZoneName(__PRETTY_FUNCTION__, strlen(__PRETTY_FUNCTION__)); \
+  ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
 
 #else
-#define CPU_ZONE()
-#define CPU_ZONE_N(name)
-#define CPU_ZONE_C(color)
-#define CPU_ZONE_NC(name, color)
+#define CPU_ZONE()                         ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
+#define CPU_ZONE_N(name)                   ARISE_BUILTIN_CPU_ZONE(name)
+#define CPU_ZONE_C(color)                  ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
+#define CPU_ZONE_NC(name, color)           ARISE_BUILTIN_CPU_ZONE(name)
 #define CPU_LOCKABLE(type, varname)
 #define CPU_SHARED_LOCKABLE(type, varname)
 #define CPU_LOCK_MARK(varname)
-#define CPU_FUNCTION()
-#define CPU_METHOD()
+#define CPU_FUNCTION()                     ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
+#define CPU_METHOD()                       ARISE_BUILTIN_CPU_ZONE(__FUNCTION__)
 
 #endif
 
@@ -4,11 +4,20 @@
 #include "profiler/cpu.h"
 #include "profiler/gpu.h"
 
+// closes the frame of the built-in CPU profiler
+#ifdef ARISE_USE_BUILTIN_CPU_PROFILING
+#define ARISE_BUILTIN_PROFILE_FRAME() arise::cpu::CpuProfiler::s_get().endFrame()
+#else
+#define ARISE_BUILTIN_PROFILE_FRAME()
+#endif
+
 #if defined(ARISE_USE_PROFILING) && defined(ARISE_USE_TRACY)
 
 #include <tracy/Tracy.hpp>
 
-#define PROFILE_FRAME()                                         FrameMark
+#define PROFILE_FRAME() \
+  FrameMark;            \
+  ARISE_BUILTIN_PROFILE_FRAME()
 
 // memory tracking
 #define PROFILE_ALLOC(ptr, size)                                TracyAlloc(ptr, size)
@@ -29,7 +38,7 @@
 #define PROFILE_FRAME_IMAGE(image, width, height, offset, flip) FrameImage(image, width, height, offset, flip)
 
 #else
-#define PROFILE_FRAME()
+#define PROFILE_FRAME() ARISE_BUILTIN_PROFILE_FRAME()
 #define PROFILE_ALLOC(ptr, size)
 #define PROFILE_FREE(ptr)
 #define PROFILE_PLOT(name, value)
@@ -66,8 +66,14 @@ std::unique_ptr<ecs::Material> CgltfMaterialLoader::processMaterial(const cgltf_
   }
 
   if (material->alpha_mode == cgltf_alpha_mode_opaque) {
+    outMaterial->alphaMode                   = ecs::AlphaMode::Opaque;
     outMaterial->scalarParameters["opacity"] = 1.0f;
+  } else if (material->alpha_mode == cgltf_alpha_mode_mask) {
+    outMaterial->alphaMode                   = ecs::AlphaMode::Mask;
+    outMaterial->alphaCutoff                 = material->alpha_cutoff;
+    outMaterial->scalarParameters["opacity"] = material->pbr_metallic_roughness.base_color_factor[3];
   } else if (material->alpha_mode == cgltf_alpha_mode_blend) {
+    outMaterial->alphaMode                   = ecs::AlphaMode::Blend;
     outMaterial->scalarParameters["opacity"] = material->pbr_metallic_roughness.base_color_factor[3];
   }
 
@@ -93,7 +99,7 @@ void CgltfMaterialLoader::loadTextures(const cgltf_material*        material,
     if (image) {
       auto textureResource = loadTexture(image, basePath, "albedo");
       if (textureResource) {
-        outMaterial->textures["albedo"] = textureResource;
+        outMaterial->textures[StringId::s_intern("albedo")] = textureResource;
       }
     }
   }
@@ -112,7 +118,7 @@ void CgltfMaterialLoader::loadTextures(const cgltf_material*        material,
     if (image) {
       auto textureResource = loadTexture(image, basePath, "metallic_roughness");
       if (textureResource) {
-        outMaterial->textures["metallic_roughness"] = textureResource;
+        outMaterial->textures[StringId::s_intern("metallic_roughness")] = textureResource;
       }
     }
   }
@@ -131,7 +137,7 @@ void CgltfMaterialLoader::loadTextures(const cgltf_material*        material,
     if (image) {
       auto textureResource = loadTexture(image, basePath, "normal_map");
       if (textureResource) {
-        outMaterial->textures["normal_map"] = textureResource;
+        outMaterial->textures[StringId::s_intern("normal_map")] = textureResource;
       }
     }
   }
@@ -172,12 +178,8 @@ gfx::rhi::Texture* CgltfMaterialLoader::loadTexture(const cgltf_image*
 
   std::string uniqueTextureName = texturePath.filename().string();
 
-  auto texturePtr = textureManager->getTexture(uniqueTextureName);
-  if (!texturePtr) {
-    texturePtr = textureManager->createTexture(imagePtr, uniqueTextureName);
-  }
-
-  return texturePtr;
+  // TextureManager deduplicates by image content, so every material slot holds its own reference
+  return textureManager->createTexture(imagePtr, uniqueTextureName);
 }
 
 }  // namespace arise
@@ -96,17 +96,6 @@ std::unique_ptr<ecs::RenderModel> CgltfRenderModelLoader::loadRenderModel(const
 
       auto renderMeshPtr = renderMeshManager->addRenderMesh(gpuMeshPtr, materialPtr, meshPtr);
 
-      std::string bufferName = "transform_matrix_" + meshPtr->meshName;
-      if (bufferManager) {
-        renderMeshPtr->transformMatrixBuffer
-            = bufferManager->createUniformBuffer(sizeof(math::Matrix4f<>), &meshPtr->transformMatrix, bufferName);
-        if (renderMeshPtr->transformMatrixBuffer) {
-          LOG_DEBUG("Created transform matrix buffer for mesh {}", meshPtr->meshName);
-        } else {
-          LOG_WARN("Failed to create transform matrix buffer for mesh {}", meshPtr->meshName);
-        }
-      }
-
       renderModel->renderMeshes.push_back(renderMeshPtr);
     }
   }
@@ -124,6 +113,7 @@ std::unique_ptr<ecs::RenderGeometryMesh> CgltfRenderModelLoader::createRenderGeo
 
   renderGeometryMesh->vertexBuffer = createVertexBuffer(mesh);
   renderGeometryMesh->indexBuffer  = createIndexBuffer(mesh);
+  renderGeometryMesh->boundingBox  = mesh->boundingBox;
 
   return renderGeometryMesh;
 }
@@ -8,6 +8,7 @@
 #include "ecs/components/movement.h"
 #include "ecs/components/transform.h"
 #include "utils/logger/log.h"
+#include "utils/memory/allocation_tracker.h"
 #include "utils/model/render_model_manager.h"
 #include "utils/path_manager/path_manager.h"
 #include "utils/service/service_locator.h"
@@ -24,6 +25,8 @@ Scene* SceneLoader::loadScene(const std::string& sceneName, SceneManager* sceneM
 Scene* SceneLoader::loadSceneFromFile(const std::filesystem::path& configPath,
                                       SceneManager*                sceneManager,
                                       const std::string&           customSceneName) {
+  MemoryTagScope memoryTag(MemoryTag::Loader);
+
   auto configManager = ServiceLocator::s_get<ConfigManager>();
   auto config        = configManager->getConfig(configPath);
 
@@ -3,6 +3,7 @@
 
 #include "profiler/profiler.h"
 #include "utils/logger/log.h"
+#include "utils/memory/allocation_tracker.h"
 #include "utils/model/model_manager.h"
 #include "utils/model/render_model_manager.h"
 #include "utils/service/service_locator.h"
@@ -205,6 +206,8 @@ class AssetLoader {
   };
 
   void workerFunction() {
+    MemoryTagScope memoryTag(MemoryTag::Loader);
+
     while (m_running) {
       AssetRequest request;
       bool         hasRequest = false;
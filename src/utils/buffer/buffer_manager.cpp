@@ -5,6 +5,9 @@
 #include "utils/memory/align.h"
 #include "utils/resource/resource_deletion_manager.h"
 #include "utils/service/service_locator.h"
+#include "utils/third_party/xxhash_util.h"
+
+#include <algorithm>
 
 namespace arise {
 
@@ -21,9 +24,12 @@ BufferManager::~BufferManager() {
     LOG_INFO("BufferManager destroyed, releasing {} buffers", m_buffers.size());
 
     for (const auto& [name, buffer] : m_buffers) {
-      LOG_INFO("Released buffer: {}", name);
+      LOG_INFO("Released buffer: {}", name.toString());
     }
   }
+  if (!m_sharedBuffers_.empty()) {
+    LOG_INFO("BufferManager destroyed, releasing {} shared buffers", m_sharedBuffers_.size());
+  }
   release();
 }
 
@@ -50,13 +56,20 @@ gfx::rhi::Buffer* BufferManager::createVertexBuffer(const void*        data,
   bufferDesc.stride      = vertexStride;
   bufferDesc.debugName   = name.empty() ? "unnamed_vertex_buffer" : name;
 
-  std::string bufferName = name.empty() ? generateUniqueName_("VertexBuffer") : name;
+  const std::string bufferName = name.empty() ? generateUniqueName_("VertexBuffer") : name;
+
+  // stride and usage are part of the seed so equal bytes with a different layout are not shared
+  const uint64_t layoutSeed  = XXH64(vertexStride, static_cast<uint64_t>(bufferDesc.createFlags));
+  const uint64_t contentHash = XXH64Bytes(data, bufferSize, layoutSeed);
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_buffers.contains(bufferName)) {
-    LOG_WARN("Buffer with name '{}' already exists, will be replaced", bufferName);
-    m_buffers.erase(bufferName);
+  if (auto sharedBuffer = m_contentRegistry_.acquire(contentHash)) {
+    bindSharedBuffer_(bufferName, sharedBuffer);
+    LOG_DEBUG("Reusing vertex buffer with identical content for '{}' (refs: {})",
+              bufferName,
+              m_contentRegistry_.getRefCount(sharedBuffer));
+    return sharedBuffer;
   }
 
   auto buffer = m_device->createBuffer(bufferDesc);
@@ -68,7 +81,9 @@ gfx::rhi::Buffer* BufferManager::createVertexBuffer(const void*        data,
   m_device->updateBuffer(buffer.get(), data, bufferSize);
 
   gfx::rhi::Buffer* bufferPtr = buffer.get();
-  m_buffers[bufferName]       = std::move(buffer);
+  m_sharedBuffers_[bufferPtr] = std::move(buffer);
+  m_contentRegistry_.add(contentHash, bufferPtr);
+  bindSharedBuffer_(bufferName, bufferPtr);
 
   LOG_INFO("Created vertex buffer '{}' with {} vertices", bufferName, vertexCount);
 
@@ -97,13 +112,20 @@ gfx::rhi::Buffer* BufferManager::createIndexBuffer(const void*        data,
   bufferDesc.createFlags = gfx::rhi::BufferCreateFlag::IndexBuffer;
   bufferDesc.debugName   = name.empty() ? "unnamed_index_buffer" : name;
 
-  std::string bufferName = name.empty() ? generateUniqueName_("IndexBuffer") : name;
+  const std::string bufferName = name.empty() ? generateUniqueName_("IndexBuffer") : name;
+
+  // stride and usage are part of the seed so equal bytes with a different layout are not shared
+  const uint64_t layoutSeed  = XXH64(indexSize, static_cast<uint64_t>(bufferDesc.createFlags));
+  const uint64_t contentHash = XXH64Bytes(data, bufferSize, layoutSeed);
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_buffers.contains(bufferName)) {
-    LOG_WARN("Buffer with name '{}' already exists, will be replaced", bufferName);
-    m_buffers.erase(bufferName);
+  if (auto sharedBuffer = m_contentRegistry_.acquire(contentHash)) {
+    bindSharedBuffer_(bufferName, sharedBuffer);
+    LOG_DEBUG("Reusing index buffer with identical content for '{}' (refs: {})",
+              bufferName,
+              m_contentRegistry_.getRefCount(sharedBuffer));
+    return sharedBuffer;
   }
 
   auto buffer = m_device->createBuffer(bufferDesc);
@@ -115,7 +137,9 @@ gfx::rhi::Buffer* BufferManager::createIndexBuffer(const void*        data,
   m_device->updateBuffer(buffer.get(), data, bufferSize);
 
   gfx::rhi::Buffer* bufferPtr = buffer.get();
-  m_buffers[bufferName]       = std::move(buffer);
+  m_sharedBuffers_[bufferPtr] = std::move(buffer);
+  m_contentRegistry_.add(contentHash, bufferPtr);
+  bindSharedBuffer_(bufferName, bufferPtr);
 
   LOG_INFO("Created index buffer '{}' with {} indices", bufferName, indexCount);
 
@@ -143,9 +167,9 @@ gfx::rhi::Buffer* BufferManager::createUniformBuffer(size_t size, const void* da
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_buffers.contains(bufferName)) {
+  if (m_buffers.contains(StringId(bufferName))) {
     LOG_WARN("Buffer with name '{}' already exists, will be replaced", bufferName);
-    m_buffers.erase(bufferName);
+    m_buffers.erase(StringId(bufferName));
   }
 
   auto buffer = m_device->createBuffer(bufferDesc);
@@ -158,8 +182,9 @@ gfx::rhi::Buffer* BufferManager::createUniformBuffer(size_t size, const void* da
     m_device->updateBuffer(buffer.get(), data, size);
   }
 
+  const StringId    bufferId  = StringId::s_intern(bufferName);
   gfx::rhi::Buffer* bufferPtr = buffer.get();
-  m_buffers[bufferName]       = std::move(buffer);
+  m_buffers[bufferId]         = std::move(buffer);
 
   LOG_INFO("Created uniform buffer '{}' with size {} bytes", bufferName, size);
 
@@ -190,9 +215,9 @@ gfx::rhi::Buffer* BufferManager::createStorageBuffer(size_t size, const void* da
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_buffers.contains(bufferName)) {
+  if (m_buffers.contains(StringId(bufferName))) {
     LOG_WARN("Buffer with name '{}' already exists, will be replaced", bufferName);
-    m_buffers.erase(bufferName);
+    m_buffers.erase(StringId(bufferName));
   }
 
   auto buffer = m_device->createBuffer(bufferDesc);
@@ -205,8 +230,9 @@ gfx::rhi::Buffer* BufferManager::createStorageBuffer(size_t size, const void* da
     m_device->updateBuffer(buffer.get(), data, size);
   }
 
+  const StringId    bufferId  = StringId::s_intern(bufferName);
   gfx::rhi::Buffer* bufferPtr = buffer.get();
-  m_buffers[bufferName]       = std::move(buffer);
+  m_buffers[bufferId]         = std::move(buffer);
 
   LOG_INFO("Created storage buffer '{}' with size {} bytes", bufferName, size);
 
@@ -223,41 +249,41 @@ gfx::rhi::Buffer* BufferManager::addBuffer(std::unique_ptr<gfx::rhi::Buffer> buf
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_buffers.contains(bufferName)) {
+  if (m_buffers.contains(StringId(bufferName))) {
     LOG_WARN("Buffer with name '{}' already exists, will be replaced", bufferName);
-    m_buffers.erase(bufferName);
+    m_buffers.erase(StringId(bufferName));
   }
 
+  const StringId    bufferId  = StringId::s_intern(bufferName);
   gfx::rhi::Buffer* bufferPtr = buffer.get();
-  m_buffers[bufferName]       = std::move(buffer);
+  m_buffers[bufferId]         = std::move(buffer);
 
   LOG_INFO("Added external buffer '{}'", bufferName);
 
   return bufferPtr;
 }
 
-gfx::rhi::Buffer* BufferManager::getBuffer(const std::string& name) const {
+gfx::rhi::Buffer* BufferManager::getBuffer(StringId name) const {
   std::lock_guard<std::mutex> lock(m_mutex);
-
-  auto it = m_buffers.find(name);
-  if (it != m_buffers.end()) {
-    return it->second.get();
-  }
-
-  return nullptr;
+  return findBuffer_(name);
 }
 
-bool BufferManager::removeBuffer(const std::string& name) {
+bool BufferManager::removeBuffer(StringId name) {
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  auto it = m_buffers.find(name);
-  if (it != m_buffers.end()) {
-    LOG_INFO("Removing buffer '{}'", name);
-    m_buffers.erase(it);
+  if (auto sharedBuffers = m_sharedBufferNames_.find(name)) {
+    releaseSharedBuffer_(name, sharedBuffers->back());
     return true;
   }
 
-  LOG_WARN("Attempted to remove non-existent buffer '{}'", name);
+  auto buffer = m_buffers.find(name);
+  if (buffer) {
+    LOG_INFO("Removing buffer '{}'", name.toString());
+    m_buffers.erase(name);
+    return true;
+  }
+
+  LOG_WARN("Attempted to remove non-existent buffer '{}'", name.toString());
   return false;
 }
 
@@ -269,25 +295,23 @@ bool BufferManager::removeBuffer(gfx::rhi::Buffer* buffer) {
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
+  for (const auto& [name, sharedBuffers] : m_sharedBufferNames_) {
+    if (std::find(sharedBuffers.begin(), sharedBuffers.end(), buffer) != sharedBuffers.end()) {
+      releaseSharedBuffer_(name, buffer);
+      return true;
+    }
+  }
+
   for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it) {
-    if (it->second.get() == buffer) {
+    if (it->value.get() == buffer) {
+      // frames in flight may still use the buffer, it is destroyed with the frame delay of ResourceDeletionManager
       auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
       if (deletionManager) {
-        std::string bufferName = it->first;
-
-        deletionManager->enqueueForDeletion<gfx::rhi::Buffer>(
-            buffer,
-            [this, bufferName](gfx::rhi::Buffer*) {
-              std::lock_guard<std::mutex> lock(m_mutex);
-              LOG_INFO("Buffer '{}' deleted", bufferName);
-              m_buffers.erase(bufferName);
-            },
-            bufferName,
-            "Buffer");
-
+        deletionManager->enqueueForDeletion(std::move(it->value));
+        m_buffers.erase(it);
         return true;
       } else {
-        LOG_INFO("Removing buffer: {}", it->first);
+        LOG_INFO("Removing buffer: {}", it->key.toString());
         m_buffers.erase(it);
         return true;
       }
@@ -298,7 +322,7 @@ bool BufferManager::removeBuffer(gfx::rhi::Buffer* buffer) {
   return false;
 }
 
-bool BufferManager::updateBuffer(const std::string& name, const void* data, size_t size, size_t offset) {
+bool BufferManager::updateBuffer(StringId name, const void* data, size_t size, size_t offset) {
   if (!m_device || !data || size == 0) {
     LOG_ERROR("Invalid update buffer parameters");
     return false;
@@ -306,13 +330,13 @@ bool BufferManager::updateBuffer(const std::string& name, const void* data, size
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  auto it = m_buffers.find(name);
-  if (it == m_buffers.end()) {
-    LOG_ERROR("Cannot update buffer '{}', not found", name);
+  auto buffer = findBuffer_(name);
+  if (!buffer) {
+    LOG_ERROR("Cannot update buffer '{}', not found", name.toString());
     return false;
   }
 
-  m_device->updateBuffer(it->second.get(), data, size, offset);
+  m_device->updateBuffer(buffer, data, size, offset);
   return true;
 }
 
@@ -324,8 +348,7 @@ bool BufferManager::updateBuffer(gfx::rhi::Buffer* buffer, const void* data, siz
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  auto it = findBuffer_(buffer);
-  if (it == m_buffers.end()) {
+  if (!ownsBuffer_(buffer)) {
     LOG_WARN("Updating buffer not managed by this BufferManager");
   }
 
@@ -336,8 +359,11 @@ bool BufferManager::updateBuffer(gfx::rhi::Buffer* buffer, const void* data, siz
 void BufferManager::release() {
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  LOG_INFO("Releasing {} buffers", m_buffers.size());
+  LOG_INFO("Releasing {} buffers", m_buffers.size() + m_sharedBuffers_.size());
 
+  m_contentRegistry_.clear();
+  m_sharedBufferNames_.clear();
+  m_sharedBuffers_.clear();
   m_buffers.clear();
 }
 
@@ -345,19 +371,62 @@ std::string BufferManager::generateUniqueName_(const std::string& prefix) {
   return prefix + "_" + std::to_string(m_bufferCounter++);
 }
 
-std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Buffer>>::iterator BufferManager::findBuffer_(
-    const std::string& name) {
-  return m_buffers.find(name);
+gfx::rhi::Buffer* BufferManager::findBuffer_(StringId name) const {
+  if (auto sharedBuffers = m_sharedBufferNames_.find(name)) {
+    return sharedBuffers->back();
+  }
+
+  auto buffer = m_buffers.find(name);
+  return buffer ? buffer->get() : nullptr;
 }
 
-std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Buffer>>::iterator BufferManager::findBuffer_(
-    const gfx::rhi::Buffer* buffer) {
-  for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it) {
-    if (it->second.get() == buffer) {
-      return it;
+bool BufferManager::ownsBuffer_(const gfx::rhi::Buffer* buffer) const {
+  if (m_sharedBuffers_.contains(buffer)) {
+    return true;
+  }
+
+  for (const auto& [name, ownedBuffer] : m_buffers) {
+    if (ownedBuffer.get() == buffer) {
+      return true;
     }
   }
-  return m_buffers.end();
+  return false;
+}
+
+void BufferManager::bindSharedBuffer_(const std::string& name, gfx::rhi::Buffer* buffer) {
+  auto& sharedBuffers = m_sharedBufferNames_[StringId::s_intern(name)];
+  if (!sharedBuffers.empty() && sharedBuffers.back() != buffer) {
+    // both buffers stay alive, getBuffer() returns the latest one until its references under the name are gone
+    LOG_DEBUG("Buffer name '{}' is bound to buffers with different content", name);
+  }
+  sharedBuffers.push_back(buffer);
+}
+
+void BufferManager::releaseSharedBuffer_(StringId name, gfx::rhi::Buffer* buffer) {
+  auto& sharedBuffers = *m_sharedBufferNames_.find(name);
+  sharedBuffers.erase(std::find(sharedBuffers.rbegin(), sharedBuffers.rend(), buffer).base() - 1);
+  if (sharedBuffers.empty()) {
+    m_sharedBufferNames_.erase(name);
+  }
+
+  if (!m_contentRegistry_.release(buffer)) {
+    LOG_DEBUG("Buffer '{}' is still shared, dropped one reference", name.toString());
+    return;
+  }
+
+  auto it = m_sharedBuffers_.find(buffer);
+  if (it == m_sharedBuffers_.end()) {
+    return;
+  }
+
+  // frames in flight may still use the buffer, it is destroyed with the frame delay of ResourceDeletionManager
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (deletionManager) {
+    deletionManager->enqueueForDeletion(std::move(it->second));
+  } else {
+    LOG_INFO("Removing buffer '{}'", name.toString());
+  }
+  m_sharedBuffers_.erase(it);
 }
 
 }  // namespace arise
\ No newline at end of file
@@ -2,11 +2,14 @@
 #define ARISE_BUFFER_MANAGER_H
 
 #include "gfx/rhi/interface/buffer.h"
+#include "utils/resource/content_hash_registry.h"
+#include "utils/string_id/string_id_map.h"
 
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace arise::gfx::rhi {
 class Device;
@@ -21,6 +24,10 @@ class BufferManager {
   ~BufferManager();
 
   /**
+   * Vertex and index buffers are deduplicated by content hash - identical data returns the already uploaded
+   * buffer with an additional reference. Every call binds the name to the buffer and the binding holds that
+   * reference, it is dropped by removeBuffer() with either the name or the pointer.
+   *
    * @param vertexStride Size of each vertex in bytes
    */
   gfx::rhi::Buffer* createVertexBuffer(const void*        data,
@@ -48,9 +55,10 @@ class BufferManager {
 
   gfx::rhi::Buffer* addBuffer(std::unique_ptr<gfx::rhi::Buffer> buffer, const std::string& name);
 
-  gfx::rhi::Buffer* getBuffer(const std::string& name) const;
+  // for names bound to several shared buffers the latest one is returned
+  gfx::rhi::Buffer* getBuffer(StringId name) const;
 
-  bool removeBuffer(const std::string& name);
+  bool removeBuffer(StringId name);
 
   bool removeBuffer(gfx::rhi::Buffer* buffer);
 
@@ -58,7 +66,7 @@ class BufferManager {
    * @param size Size of the data in bytes
    * @param offset Offset into the buffer in bytes
    */
-  bool updateBuffer(const std::string& name, const void* data, size_t size, size_t offset = 0);
+  bool updateBuffer(StringId name, const void* data, size_t size, size_t offset = 0);
 
   /**
    * @param size Size of the data in bytes
@@ -68,20 +76,35 @@ class BufferManager {
 
   void release();
 
+  const ContentHashRegistry<gfx::rhi::Buffer>& getContentRegistry() const { return m_contentRegistry_; }
+
   private:
+  // keyed by the interned buffer name
+  using BufferMap = StringIdMap<std::unique_ptr<gfx::rhi::Buffer>>;
+
   std::string generateUniqueName_(const std::string& prefix);
 
-  // TODO: not used, consider remove
-  std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Buffer>>::iterator findBuffer_(const std::string& name);
+  gfx::rhi::Buffer* findBuffer_(StringId name) const;
+
+  bool ownsBuffer_(const gfx::rhi::Buffer* buffer) const;
 
-  std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Buffer>>::iterator findBuffer_(
-      const gfx::rhi::Buffer* buffer);
+  void bindSharedBuffer_(const std::string& name, gfx::rhi::Buffer* buffer);
+
+  // drops the binding of the name and its reference, destroys the buffer with the last one
+  void releaseSharedBuffer_(StringId name, gfx::rhi::Buffer* buffer);
 
   private:
-  gfx::rhi::Device*                                                  m_device;
-  mutable std::mutex                                                 m_mutex;
-  std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Buffer>> m_buffers;
-  uint32_t m_bufferCounter;  // Counter for generating unique names
+  gfx::rhi::Device*  m_device;
+  mutable std::mutex m_mutex;
+  BufferMap          m_buffers;
+  uint32_t           m_bufferCounter;  // Counter for generating unique names
+
+  ContentHashRegistry<gfx::rhi::Buffer> m_contentRegistry_;
+
+  // deduplicated buffers, owned apart from m_buffers since they are not tied to a single name
+  std::unordered_map<const gfx::rhi::Buffer*, std::unique_ptr<gfx::rhi::Buffer>> m_sharedBuffers_;
+  // name -> shared buffers requested under it, one entry per reference
+  StringIdMap<std::vector<gfx::rhi::Buffer*>> m_sharedBufferNames_;
 };
 
 }  // namespace arise
@@ -0,0 +1,52 @@
+#ifndef ARISE_HANDLE_H
+#define ARISE_HANDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace arise {
+
+/**
+ * Typed 32-bit reference to an object in a HandlePool: 20 bits of slot index and 12 bits of slot generation.
+ *
+ * The generation of a slot changes when its object is removed, so a handle to a removed object no longer resolves,
+ * even after the slot was reused (unlike a pointer to a freed object, whose address may be handed out again).
+ * Generations start at 1, the zero handle is invalid.
+ */
+template <typename T>
+class Handle {
+  public:
+  static constexpr uint32_t kIndexBits      = 20;
+  static constexpr uint32_t kGenerationBits = 12;
+  static constexpr uint32_t kMaxIndex       = (1u << kIndexBits) - 1;
+  static constexpr uint32_t kMaxGeneration  = (1u << kGenerationBits) - 1;
+
+  constexpr Handle() = default;
+
+  constexpr Handle(uint32_t index, uint32_t generation)
+      : m_value_((generation << kIndexBits) | (index & kMaxIndex)) {}
+
+  constexpr uint32_t getIndex() const { return m_value_ & kMaxIndex; }
+
+  constexpr uint32_t getGeneration() const { return m_value_ >> kIndexBits; }
+
+  // unique among the live objects of the pool, e.g. for sort keys
+  constexpr uint32_t getValue() const { return m_value_; }
+
+  constexpr bool isValid() const { return m_value_ != 0; }
+
+  constexpr bool operator==(const Handle&) const = default;
+
+  private:
+  uint32_t m_value_ = 0;
+};
+
+}  // namespace arise
+
+template <typename T>
+struct std::hash<arise::Handle<T>> {
+  size_t operator()(arise::Handle<T> handle) const noexcept { return static_cast<size_t>(handle.getValue()); }
+};
+
+#endif  // ARISE_HANDLE_H
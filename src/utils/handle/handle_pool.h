@@ -0,0 +1,128 @@
+#ifndef ARISE_HANDLE_POOL_H
+#define ARISE_HANDLE_POOL_H
+
+#include "utils/handle/handle.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Owns objects of one type in a dense slot array and hands out generational handles to them. Lookups by handle are
+ * an index plus a generation compare, removed slots go to a free list and are reused by the next add().
+ *
+ * The objects themselves are heap allocated, so pointers to them stay valid until they are removed (callers that
+ * hold raw pointers keep working while the slot array grows).
+ */
+template <typename T>
+class HandlePool {
+  public:
+  using HandleType = Handle<T>;
+
+  // returns an invalid handle if all slot indices are in use
+  HandleType add(std::unique_ptr<T> object) {
+    if (!object) {
+      return {};
+    }
+
+    uint32_t index;
+    if (!m_freeIndices_.empty()) {
+      index = m_freeIndices_.back();
+      m_freeIndices_.pop_back();
+    } else {
+      if (m_slots_.size() > HandleType::kMaxIndex) {
+        return {};
+      }
+      index = static_cast<uint32_t>(m_slots_.size());
+      m_slots_.emplace_back();
+    }
+
+    Slot& slot  = m_slots_[index];
+    slot.object = std::move(object);
+    ++m_size_;
+    return HandleType(index, slot.generation);
+  }
+
+  // nullptr if the handle is invalid or its object was removed
+  T* get(HandleType handle) const {
+    const Slot* slot = findSlot_(handle);
+    return slot ? slot->object.get() : nullptr;
+  }
+
+  bool contains(HandleType handle) const { return findSlot_(handle) != nullptr; }
+
+  // gives up ownership of the object (e.g. for a delayed destruction), nullptr for a stale handle
+  std::unique_ptr<T> remove(HandleType handle) {
+    Slot* slot = findSlot_(handle);
+    if (!slot) {
+      return nullptr;
+    }
+
+    std::unique_ptr<T> object = std::move(slot->object);
+    retireSlot_(*slot, handle.getIndex());
+    return object;
+  }
+
+  // destroys all objects, handles given out before no longer resolve
+  void clear() {
+    for (uint32_t index = 0; index < m_slots_.size(); ++index) {
+      Slot& slot = m_slots_[index];
+      if (slot.object) {
+        slot.object.reset();
+        retireSlot_(slot, index);
+      }
+    }
+  }
+
+  uint32_t size() const { return m_size_; }
+
+  bool empty() const { return m_size_ == 0; }
+
+  // function(HandleType, T*) for every live object in slot order
+  template <typename Function>
+  void forEach(Function&& function) const {
+    for (uint32_t index = 0; index < m_slots_.size(); ++index) {
+      const Slot& slot = m_slots_[index];
+      if (slot.object) {
+        function(HandleType(index, slot.generation), slot.object.get());
+      }
+    }
+  }
+
+  private:
+  struct Slot {
+    std::unique_ptr<T> object;
+    uint32_t           generation = 1;
+  };
+
+  Slot* findSlot_(HandleType handle) {
+    return const_cast<Slot*>(static_cast<const HandlePool*>(this)->findSlot_(handle));
+  }
+
+  const Slot* findSlot_(HandleType handle) const {
+    if (!handle.isValid() || handle.getIndex() >= m_slots_.size()) {
+      return nullptr;
+    }
+
+    const Slot& slot = m_slots_[handle.getIndex()];
+    return slot.object && slot.generation == handle.getGeneration() ? &slot : nullptr;
+  }
+
+  void retireSlot_(Slot& slot, uint32_t index) {
+    // 0 is reserved for the invalid handle
+    slot.generation = slot.generation == HandleType::kMaxGeneration ? 1 : slot.generation + 1;
+    m_freeIndices_.push_back(index);
+    --m_size_;
+  }
+
+  std::vector<Slot>     m_slots_;
+  std::vector<uint32_t> m_freeIndices_;
+  uint32_t              m_size_ = 0;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_HANDLE_POOL_H
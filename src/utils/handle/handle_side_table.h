@@ -0,0 +1,146 @@
+#ifndef ARISE_HANDLE_SIDE_TABLE_H
+#define ARISE_HANDLE_SIDE_TABLE_H
+
+#include "utils/handle/handle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Per-object data of a system (caches, per-frame state) indexed by the slot index of a Handle, so a lookup is an
+ * array access instead of hashing a pointer.
+ *
+ * Every entry remembers the full handle it was created for. When the object is removed and its slot reused, the
+ * new handle does not match the entry: find() misses and findStale() returns the old entry, so the owner can release
+ * it instead of silently using data of another object.
+ */
+template <typename T, typename V>
+class HandleSideTable {
+  public:
+  using HandleType = Handle<T>;
+
+  struct Entry {
+    HandleType handle;  // invalid for unused entries
+    V          value;
+  };
+
+  template <bool Const>
+  class Iterator {
+    public:
+    using TableType = std::conditional_t<Const, const HandleSideTable, HandleSideTable>;
+    using EntryType = std::conditional_t<Const, const Entry, Entry>;
+
+    Iterator(TableType* table, size_t index)
+        : m_table_(table)
+        , m_index_(index) {
+      skipUnused_();
+    }
+
+    EntryType& operator*() const { return m_table_->m_entries_[m_index_]; }
+
+    EntryType* operator->() const { return &m_table_->m_entries_[m_index_]; }
+
+    Iterator& operator++() {
+      ++m_index_;
+      skipUnused_();
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const { return m_index_ == other.m_index_; }
+
+    private:
+    void skipUnused_() {
+      while (m_index_ < m_table_->m_entries_.size() && !m_table_->m_entries_[m_index_].handle.isValid()) {
+        ++m_index_;
+      }
+    }
+
+    TableType* m_table_;
+    size_t     m_index_;
+  };
+
+  using iterator       = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  V* find(HandleType handle) {
+    Entry* entry = findEntry_(handle);
+    return entry && entry->handle == handle ? &entry->value : nullptr;
+  }
+
+  const V* find(HandleType handle) const { return const_cast<HandleSideTable*>(this)->find(handle); }
+
+  bool contains(HandleType handle) const { return find(handle) != nullptr; }
+
+  // entry left by an object that used the slot of the handle before (erase it with its own handle), nullptr if none
+  Entry* findStale(HandleType handle) {
+    Entry* entry = findEntry_(handle);
+    return entry && entry->handle.isValid() && entry->handle != handle ? entry : nullptr;
+  }
+
+  // value-initializes the entry if it is missing or stale, the handle must be valid
+  V& operator[](HandleType handle) {
+    const uint32_t index = handle.getIndex();
+    if (index >= m_entries_.size()) {
+      m_entries_.resize(index + 1);
+    }
+
+    Entry& entry = m_entries_[index];
+    if (entry.handle != handle) {
+      if (!entry.handle.isValid()) {
+        ++m_size_;
+      }
+      entry.handle = handle;
+      entry.value  = V{};
+    }
+    return entry.value;
+  }
+
+  // valid while iterating, the entries are not moved
+  bool erase(HandleType handle) {
+    Entry* entry = findEntry_(handle);
+    if (!entry || entry->handle != handle) {
+      return false;
+    }
+
+    entry->handle = {};
+    entry->value  = V{};
+    --m_size_;
+    return true;
+  }
+
+  void clear() {
+    m_entries_.clear();
+    m_size_ = 0;
+  }
+
+  size_t size() const { return m_size_; }
+
+  bool empty() const { return m_size_ == 0; }
+
+  iterator begin() { return iterator(this, 0); }
+
+  iterator end() { return iterator(this, m_entries_.size()); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  const_iterator end() const { return const_iterator(this, m_entries_.size()); }
+
+  private:
+  Entry* findEntry_(HandleType handle) {
+    if (!handle.isValid() || handle.getIndex() >= m_entries_.size()) {
+      return nullptr;
+    }
+    return &m_entries_[handle.getIndex()];
+  }
+
+  std::vector<Entry> m_entries_;
+  size_t             m_size_ = 0;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_HANDLE_SIDE_TABLE_H
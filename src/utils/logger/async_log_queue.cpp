@@ -0,0 +1,188 @@
+#include "utils/logger/async_log_queue.h"
+
+#include "utils/logger/log_record.h"
+#include "utils/memory/allocation_tracker.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+
+namespace arise {
+
+namespace {
+
+// ring buffer of the current thread, retired when the thread exits
+struct ThreadBuffer {
+  std::shared_ptr<LogRingBuffer> buffer;
+  uint32_t                       generation = 0;
+
+  ~ThreadBuffer() {
+    if (buffer) {
+      buffer->retire();
+    }
+  }
+};
+
+thread_local ThreadBuffer s_threadBuffer;
+
+}  // namespace
+
+AsyncLogQueue::AsyncLogQueue(DispatchCallback dispatch)
+    : m_dispatch_(std::move(dispatch))
+    , m_generation_(s_generation.fetch_add(1, std::memory_order_relaxed) + 1) {
+  m_thread_ = std::thread(&AsyncLogQueue::run_, this);
+  s_instance.store(this, std::memory_order_release);
+}
+
+AsyncLogQueue::~AsyncLogQueue() {
+  s_instance.store(nullptr, std::memory_order_release);
+
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex_);
+    m_stopRequested_ = true;
+  }
+  m_wakeCondition_.notify_one();
+
+  if (m_thread_.joinable()) {
+    m_thread_.join();
+  }
+}
+
+void AsyncLogQueue::flush() {
+  // a logger that logs a fatal error would wait for itself
+  if (std::this_thread::get_id() == m_thread_.get_id()) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_wakeMutex_);
+  const uint64_t               request = ++m_flushRequested_;
+  m_wakeCondition_.notify_one();
+  m_flushCondition_.wait(lock, [this, request] { return m_flushCompleted_ >= request || m_stopRequested_; });
+}
+
+LogRingBuffer* AsyncLogQueue::s_getThreadBuffer() {
+  AsyncLogQueue* queue = s_instance.load(std::memory_order_acquire);
+  if (!queue) {
+    return nullptr;
+  }
+
+  if (s_threadBuffer.generation != queue->m_generation_) {
+    return queue->registerThreadBuffer_();
+  }
+
+  return s_threadBuffer.buffer.get();
+}
+
+void AsyncLogQueue::s_pushFormatted(LogMessage&& message) {
+  AsyncLogQueue* queue = s_instance.load(std::memory_order_acquire);
+  if (!queue) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(queue->m_buffersMutex_);
+  queue->m_formattedMessages_.push_back(std::move(message));
+}
+
+LogRingBuffer* AsyncLogQueue::registerThreadBuffer_() {
+  MemoryTagScope memoryTag(MemoryTag::Logger);
+
+  // the buffer of a previous queue is abandoned, that queue is gone
+  s_threadBuffer.buffer     = std::make_shared<LogRingBuffer>(kThreadBufferSize);
+  s_threadBuffer.generation = m_generation_;
+
+  std::lock_guard<std::mutex> lock(m_buffersMutex_);
+  m_buffers_.push_back(s_threadBuffer.buffer);
+  return s_threadBuffer.buffer.get();
+}
+
+void AsyncLogQueue::run_() {
+  // the loggers keep their entries (e.g. MemoryLogger) on this thread
+  MemoryTagScope memoryTag(MemoryTag::Logger);
+
+  while (true) {
+    uint64_t flushRequest = 0;
+    bool     stop         = false;
+    {
+      std::unique_lock<std::mutex> lock(m_wakeMutex_);
+      m_wakeCondition_.wait_for(
+          lock, kPollInterval, [this] { return m_stopRequested_ || m_flushRequested_ != m_flushCompleted_; });
+      flushRequest = m_flushRequested_;
+      stop         = m_stopRequested_;
+    }
+
+    // everything committed before the flush request (or the stop) is visible to this pass
+    processPass_();
+
+    {
+      std::lock_guard<std::mutex> lock(m_wakeMutex_);
+      m_flushCompleted_ = flushRequest;
+    }
+    m_flushCondition_.notify_all();
+
+    if (stop) {
+      break;
+    }
+  }
+}
+
+void AsyncLogQueue::processPass_() {
+  {
+    std::lock_guard<std::mutex> lock(m_buffersMutex_);
+    m_processedBuffers_.assign(m_buffers_.begin(), m_buffers_.end());
+    for (auto& message : m_formattedMessages_) {
+      m_batch_.push_back(std::move(message));
+    }
+    m_formattedMessages_.clear();
+  }
+
+  for (const auto& buffer : m_processedBuffers_) {
+    while (std::byte* record = buffer->peek()) {
+      auto header = std::launder(reinterpret_cast<detail::LogRecordHeader*>(record));
+
+      LogMessage message;
+      message.level     = header->level;
+      message.location  = header->location;
+      message.timestamp = header->timestamp;
+      message.text      = header->formatFunction(header->format, record + sizeof(detail::LogRecordHeader));
+      detail::appendSuppressedCount(message.text, header->suppressedCount);
+
+      const uint32_t size = header->size;
+      header->~LogRecordHeader();
+      buffer->pop(size);
+
+      m_batch_.push_back(std::move(message));
+    }
+  }
+
+  const uint64_t droppedCount = s_droppedCount.exchange(0, std::memory_order_relaxed);
+  if (droppedCount > 0) {
+    LogMessage message;
+    message.level     = LogLevel::Warning;
+    message.location  = std::source_location::current();
+    message.timestamp = std::chrono::system_clock::now();
+    message.text      = fmt::format("{} log messages dropped, the log buffer of the thread was full", droppedCount);
+    m_batch_.push_back(std::move(message));
+  }
+
+  // threads are drained one after another, restore the order in which the messages were logged
+  std::stable_sort(m_batch_.begin(), m_batch_.end(), [](const LogMessage& lhs, const LogMessage& rhs) {
+    return lhs.timestamp < rhs.timestamp;
+  });
+
+  for (const auto& message : m_batch_) {
+    m_dispatch_(message);
+  }
+
+  m_batch_.clear();
+
+  // buffers of exited threads are released once they're drained
+  {
+    std::lock_guard<std::mutex> lock(m_buffersMutex_);
+    std::erase_if(m_buffers_, [](const std::shared_ptr<LogRingBuffer>& buffer) {
+      return buffer->isRetired() && buffer->isEmpty();
+    });
+  }
+  m_processedBuffers_.clear();
+}
+
+}  // namespace arise
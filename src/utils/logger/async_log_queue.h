@@ -0,0 +1,106 @@
+#ifndef ARISE_ASYNC_LOG_QUEUE_H
+#define ARISE_ASYNC_LOG_QUEUE_H
+
+#include "utils/logger/i_logger.h"
+#include "utils/logger/log_ring_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace arise {
+
+// formatted log message, what the backend thread hands to the loggers
+struct LogMessage {
+  LogLevel                              level = LogLevel::Info;
+  std::source_location                  location;
+  std::chrono::system_clock::time_point timestamp;
+  std::string                           text;
+};
+
+/**
+ * Backend of GlobalLogger - every thread that logs gets its own LogRingBuffer, the calling thread only copies the
+ * unformatted arguments into it (see detail::enqueueLog in log.h). A background thread formats the records, orders
+ * the messages of all threads by timestamp and dispatches them.
+ *
+ * When a buffer is full, messages below Warning are dropped (the backend reports how many), more severe ones are
+ * formatted on the calling thread and handed over through a locked queue.
+ *
+ * At most one queue exists at a time, no thread may log while it's destroyed.
+ */
+class AsyncLogQueue {
+  public:
+  using DispatchCallback = std::function<void(const LogMessage&)>;
+
+  static constexpr size_t                    kThreadBufferSize = 256 * 1024;
+  static constexpr std::chrono::milliseconds kPollInterval{5};
+
+  explicit AsyncLogQueue(DispatchCallback dispatch);
+
+  // processes the remaining records and stops the backend thread
+  ~AsyncLogQueue();
+
+  AsyncLogQueue(const AsyncLogQueue&)            = delete;
+  AsyncLogQueue& operator=(const AsyncLogQueue&) = delete;
+
+  // blocks until the messages the calling thread logged so far are dispatched
+  void flush();
+
+  /**
+   * Ring buffer of the calling thread, created on the first call
+   *
+   * @return nullptr if no queue exists (the message is dispatched synchronously)
+   */
+  static LogRingBuffer* s_getThreadBuffer();
+
+  // slow path for messages that don't fit the ring buffer
+  static void s_pushFormatted(LogMessage&& message);
+
+  // a message was dropped because the ring buffer was full
+  static void s_countDropped() { s_droppedCount.fetch_add(1, std::memory_order_relaxed); }
+
+  private:
+  void run_();
+
+  // drains all buffers once
+  void processPass_();
+
+  LogRingBuffer* registerThreadBuffer_();
+
+  DispatchCallback m_dispatch_;
+
+  std::mutex                                  m_buffersMutex_;
+  std::vector<std::shared_ptr<LogRingBuffer>> m_buffers_;
+  std::vector<LogMessage>                     m_formattedMessages_;  // s_pushFormatted, guarded by m_buffersMutex_
+
+  // backend thread only
+  std::vector<std::shared_ptr<LogRingBuffer>> m_processedBuffers_;
+  std::vector<LogMessage>                     m_batch_;
+
+  std::mutex              m_wakeMutex_;
+  std::condition_variable m_wakeCondition_;
+  std::condition_variable m_flushCondition_;
+  uint64_t                m_flushRequested_ = 0;
+  uint64_t                m_flushCompleted_ = 0;
+  bool                    m_stopRequested_  = false;
+
+  std::thread m_thread_;
+
+  uint32_t m_generation_ = 0;  // thread buffers registered with an older queue are replaced
+
+  static inline std::atomic<AsyncLogQueue*> s_instance{nullptr};
+  static inline std::atomic<uint32_t>       s_generation{0};
+  static inline std::atomic<uint64_t>       s_droppedCount{0};
+};
+
+}  // namespace arise
+
+#endif  // ARISE_ASYNC_LOG_QUEUE_H
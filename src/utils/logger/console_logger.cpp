@@ -85,8 +85,11 @@ ConsoleLogger::~ConsoleLogger() {
   }
 }
 
-void ConsoleLogger::log(LogLevel logLevel, const std::string& message, const std::source_location& loc) {
-  if (!m_logger_) {
+void ConsoleLogger::log(LogLevel                              logLevel,
+                        const std::string&                    message,
+                        const std::source_location&           loc,
+                        std::chrono::system_clock::time_point timestamp) {
+  if (!m_logger_ || logLevel == LogLevel::Off) {
     return;
   }
 
@@ -104,26 +107,8 @@ void ConsoleLogger::log(LogLevel logLevel, const std::string& message, const std
 
   auto fullMsg = fmt::format("{}:{} | {}() | {}", file, loc.line(), functionName, message);
 
-  switch (logLevel) {
-    case LogLevel::Fatal:
-      m_logger_->critical(fullMsg);
-      break;
-    case LogLevel::Error:
-      m_logger_->error(fullMsg);
-      break;
-    case LogLevel::Warning:
-      m_logger_->warn(fullMsg);
-      break;
-    case LogLevel::Info:
-      m_logger_->info(fullMsg);
-      break;
-    case LogLevel::Debug:
-      m_logger_->debug(fullMsg);
-      break;
-    case LogLevel::Trace:
-      m_logger_->trace(fullMsg);
-      break;
-  }
+  // the time the message was logged, not when the backend thread got to it
+  m_logger_->log(timestamp, spdlog::source_loc{}, toSpdlogLevel(logLevel), fullMsg);
 }
 
 auto ConsoleLogger::getPattern() const -> const std::string& {
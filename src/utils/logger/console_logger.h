@@ -5,6 +5,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <memory>
 
 namespace arise {
@@ -26,9 +27,10 @@ class ConsoleLogger : public ILogger {
 
   ~ConsoleLogger() override;
 
-  void log(LogLevel                    level,
-           const std::string&          message,
-           const std::source_location& location = std::source_location::current()) override;
+  void log(LogLevel                              level,
+           const std::string&                    message,
+           const std::source_location&           location  = std::source_location::current(),
+           std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) override;
 
   [[nodiscard]] const std::string& getPattern() const;
   [[nodiscard]] LogLevel           getLogLevel() const;
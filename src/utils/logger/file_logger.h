@@ -5,6 +5,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -21,9 +22,10 @@ class FileLogger : public ILogger {
 
   ~FileLogger() override;
 
-  void log(LogLevel                    level,
-           const std::string&          message,
-           const std::source_location& loc = std::source_location::current()) override;
+  void log(LogLevel                              level,
+           const std::string&                    message,
+           const std::source_location&           loc       = std::source_location::current(),
+           std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) override;
 
   [[nodiscard]] const std::string& getPattern() const;
   [[nodiscard]] LogLevel           getLogLevel() const;
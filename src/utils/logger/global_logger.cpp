@@ -3,16 +3,35 @@
 namespace arise {
 
 void GlobalLogger::AddLogger(std::unique_ptr<ILogger> logger) {
-  s_loggers.push_back(std::move(logger));
+  {
+    std::lock_guard<std::mutex> lock(s_loggersMutex);
+    s_loggers.push_back(std::move(logger));
+  }
+
+  if (!s_queue) {
+    s_queue = std::make_unique<AsyncLogQueue>(&GlobalLogger::Dispatch);
+  }
 }
 
 void GlobalLogger::Log(LogLevel logLevel, const std::string& message, const std::source_location& loc) {
+  detail::enqueueLog(logLevel, loc, 0, std::chrono::system_clock::now(), "{}", std::string_view(message));
+}
+
+void GlobalLogger::Dispatch(const LogMessage& message) {
+  std::lock_guard<std::mutex> lock(s_loggersMutex);
   for (auto& logger : s_loggers) {
-    logger->log(logLevel, message, loc);
+    logger->log(message.level, message.text, message.location, message.timestamp);
+  }
+}
+
+void GlobalLogger::Flush() {
+  if (s_queue) {
+    s_queue->flush();
   }
 }
 
 ILogger* GlobalLogger::GetLogger(const std::string& name) {
+  std::lock_guard<std::mutex> lock(s_loggersMutex);
   for (const auto& logger : s_loggers) {
     if (logger->getLoggerName() == name) {
       return logger.get();
@@ -22,7 +41,11 @@ ILogger* GlobalLogger::GetLogger(const std::string& name) {
 }
 
 void GlobalLogger::Shutdown() {
+  // dispatches what is still queued
+  s_queue.reset();
+
+  std::lock_guard<std::mutex> lock(s_loggersMutex);
   s_loggers.clear();
 }
 
-}  // namespace arise
\ No newline at end of file
+}  // namespace arise
@@ -1,15 +1,23 @@
 #ifndef ARISE_GLOBAL_LOGGER_H
 #define ARISE_GLOBAL_LOGGER_H
 
+#include "utils/logger/async_log_queue.h"
 #include "utils/logger/i_logger.h"
 
 #include <spdlog/fmt/fmt.h>
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace arise {
 
+/**
+ * Fans the log messages out to the added loggers.
+ *
+ * Messages are dispatched by the background thread of an AsyncLogQueue, which is started with the first logger and
+ * stopped (after dispatching the remaining messages) by Shutdown().
+ */
 class GlobalLogger {
   public:
   static void AddLogger(std::unique_ptr<ILogger> logger);
@@ -26,14 +34,22 @@ class GlobalLogger {
     GlobalLogger::Log(level, fmt::format(fmtStr, std::forward<Args>(args)...), loc);
   }
 
+  // hands a formatted message to every logger (called from the backend thread)
+  static void Dispatch(const LogMessage& message);
+
+  // blocks until the messages logged by the calling thread reached the loggers
+  static void Flush();
+
   static ILogger* GetLogger(const std::string& name);
 
   static void Shutdown();
 
   private:
+  static inline std::mutex                            s_loggersMutex;
   static inline std::vector<std::unique_ptr<ILogger>> s_loggers;
+  static inline std::unique_ptr<AsyncLogQueue>        s_queue;
 };
 
 }  // namespace arise
 
-#endif  // ARISE_GLOBAL_LOGGER_H
\ No newline at end of file
+#endif  // ARISE_GLOBAL_LOGGER_H
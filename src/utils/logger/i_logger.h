@@ -1,6 +1,7 @@
 #ifndef ARISE_I_LOGGER_H
 #define ARISE_I_LOGGER_H
 
+#include <chrono>
 #include <source_location>
 #include <string>
 
@@ -29,9 +30,11 @@ class ILogger {
   auto operator=(const ILogger&) -> ILogger& = delete;
   auto operator=(ILogger&&) -> ILogger&      = delete;
 
-  virtual void log(LogLevel                    level,
-                   const std::string&          message,
-                   const std::source_location& loc = std::source_location::current())
+  // timestamp is the time the message was logged, loggers are called later from the logging thread
+  virtual void log(LogLevel                              level,
+                   const std::string&                    message,
+                   const std::source_location&           loc       = std::source_location::current(),
+                   std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now())
       = 0;
 
   auto getLoggerName() const -> const std::string& { return loggerName; }
@@ -1,65 +1,239 @@
 #ifndef ARISE_LOG_H
 #define ARISE_LOG_H
 
+#include "utils/logger/async_log_queue.h"
 #include "utils/logger/global_logger.h"
+#include "utils/logger/log_record.h"
 
+#include <atomic>
+#include <chrono>
 #include <source_location>
 
+// levels for ARISE_LOG_ACTIVE_LEVEL, LOG_* macros below the active level compile to nothing
+#define ARISE_LOG_LEVEL_TRACE 0
+#define ARISE_LOG_LEVEL_DEBUG 1
+#define ARISE_LOG_LEVEL_INFO  2
+#define ARISE_LOG_LEVEL_WARN  3
+#define ARISE_LOG_LEVEL_ERROR 4
+#define ARISE_LOG_LEVEL_FATAL 5
+#define ARISE_LOG_LEVEL_OFF   6
+
+#ifdef ARISE_DISABLE_LOGGING
+#undef ARISE_LOG_ACTIVE_LEVEL
+#define ARISE_LOG_ACTIVE_LEVEL ARISE_LOG_LEVEL_OFF
+#endif
+
+#ifndef ARISE_LOG_ACTIVE_LEVEL
+#define ARISE_LOG_ACTIVE_LEVEL ARISE_LOG_LEVEL_TRACE
+#endif
+
 namespace arise {
 
 namespace detail {
 
-inline void Log(LogLevel level, const std::source_location& loc, const std::string& msg) {
-  GlobalLogger::Log(level, msg, loc);
+/**
+ * Static state of a LOG_* call site - its level and location, and the rate limit: a call site logs at most
+ * kRateLimitCount messages per kRateLimitWindow, the next admitted message reports how many were suppressed.
+ * Error and fatal messages are never suppressed, the limit only keeps per-frame warnings and below from flooding.
+ */
+struct LogSite {
+  static constexpr uint32_t             kRateLimitCount = 32;
+  static constexpr std::chrono::seconds kRateLimitWindow{1};
+
+  constexpr LogSite(LogLevel level, const std::source_location& location)
+      : level(level)
+      , location(location) {}
+
+  // false if the message exceeds the rate limit, suppressedCount receives the count to report otherwise
+  bool admit(std::chrono::system_clock::time_point timestamp, uint32_t& suppressedCount) {
+    if (level >= LogLevel::Error) {
+      return true;
+    }
+
+    // races between threads only make the limit approximate
+    const auto now         = timestamp.time_since_epoch().count();
+    auto       windowStart = m_windowStart.load(std::memory_order_relaxed);
+    if (now - windowStart >= std::chrono::system_clock::duration(kRateLimitWindow).count()
+        && m_windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+      m_windowCount.store(0, std::memory_order_relaxed);
+    }
+
+    if (m_windowCount.fetch_add(1, std::memory_order_relaxed) >= kRateLimitCount) {
+      m_suppressedCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    suppressedCount = m_suppressedCount.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+  const LogLevel             level;
+  const std::source_location location;
+
+  private:
+  std::atomic<std::chrono::system_clock::rep> m_windowStart{0};
+  std::atomic<uint32_t>                       m_windowCount{0};
+  std::atomic<uint32_t>                       m_suppressedCount{0};
+};
+
+/**
+ * Copies the message into the ring buffer of the calling thread, the arguments are the ones of toLogArgument()
+ * (strings as views). Without a queue (no logger added yet, or after shutdown) the message is dispatched right away.
+ */
+template <typename... Args>
+void enqueueLog(LogLevel                              level,
+                const std::source_location&           location,
+                uint32_t                              suppressedCount,
+                std::chrono::system_clock::time_point timestamp,
+                std::string_view                      format,
+                const Args&... arguments) {
+  LogRingBuffer* buffer = AsyncLogQueue::s_getThreadBuffer();
+
+  size_t argumentsSize = 0;
+  ((argumentsSize = getLogArgumentEnd(argumentsSize, arguments)), ...);
+  const size_t recordSize = LogRingBuffer::s_alignRecordSize(sizeof(LogRecordHeader) + argumentsSize);
+
+  std::byte* record = nullptr;
+  if (buffer && recordSize <= buffer->getMaxRecordSize()) {
+    record = buffer->prepare(recordSize);
+    if (!record && level < LogLevel::Warning) {
+      AsyncLogQueue::s_countDropped();
+      return;
+    }
+  }
+
+  // slow path - no queue, a record too large for the ring buffer or a severe message while it's full
+  if (!record) {
+    LogMessage message{level, location, timestamp, fmt::format(fmt::runtime(format), arguments...)};
+    appendSuppressedCount(message.text, suppressedCount);
+    if (buffer) {
+      AsyncLogQueue::s_pushFormatted(std::move(message));
+    } else {
+      GlobalLogger::Dispatch(message);
+    }
+    return;
+  }
+
+  auto header             = new (record) LogRecordHeader();
+  header->size            = static_cast<uint32_t>(recordSize);
+  header->level           = level;
+  header->suppressedCount = suppressedCount;
+  header->timestamp       = timestamp;
+  header->location        = location;
+  header->format          = format;
+  header->formatFunction  = &formatLogRecord<Args...>;
+
+  size_t offset = 0;
+  (writeLogArgument(record + sizeof(LogRecordHeader), offset, arguments), ...);
+
+  buffer->commit(recordSize);
 }
 
 template <typename... Args>
-inline void Log(LogLevel level, const std::source_location& loc, fmt::format_string<Args...> fmtStr, Args&&... args) {
-  GlobalLogger::Log(level, fmt::format(fmtStr, std::forward<Args>(args)...), loc);
+inline void Log(LogSite& site, fmt::format_string<Args...> fmtStr, Args&&... args) {
+  const auto timestamp       = std::chrono::system_clock::now();
+  uint32_t   suppressedCount = 0;
+  if (!site.admit(timestamp, suppressedCount)) {
+    return;
+  }
+
+  const fmt::string_view format = fmtStr.get();
+  enqueueLog<LogArgumentType<Args>...>(site.level,
+                                       site.location,
+                                       suppressedCount,
+                                       timestamp,
+                                       std::string_view(format.data(), format.size()),
+                                       toLogArgument(args)...);
+
+  if (site.level == LogLevel::Fatal) {
+    GlobalLogger::Flush();
+  }
+}
+
+// message without arguments (not a format string)
+inline void Log(LogSite& site, std::string_view message) {
+  const auto timestamp       = std::chrono::system_clock::now();
+  uint32_t   suppressedCount = 0;
+  if (!site.admit(timestamp, suppressedCount)) {
+    return;
+  }
+
+  enqueueLog(site.level, site.location, suppressedCount, timestamp, "{}", message);
+
+  if (site.level == LogLevel::Fatal) {
+    GlobalLogger::Flush();
+  }
 }
 
 }  // namespace detail
 
 inline void LogTrace(const std::string& msg, const std::source_location& loc = std::source_location::current()) {
-  detail::Log(LogLevel::Trace, loc, msg);
+  GlobalLogger::Log(LogLevel::Trace, msg, loc);
 }
 
 inline void LogDebug(const std::string& msg, const std::source_location& loc = std::source_location::current()) {
-  detail::Log(LogLevel::Debug, loc, msg);
+  GlobalLogger::Log(LogLevel::Debug, msg, loc);
 }
 
 inline void LogInfo(const std::string& msg, const std::source_location& loc = std::source_location::current()) {
-  detail::Log(LogLevel::Info, loc, msg);
+  GlobalLogger::Log(LogLevel::Info, msg, loc);
 }
 
 inline void LogWarn(const std::string& msg, const std::source_location& loc = std::source_location::current()) {
-  detail::Log(LogLevel::Warning, loc, msg);
+  GlobalLogger::Log(LogLevel::Warning, msg, loc);
 }
 
 inline void LogError(const std::string& msg, const std::source_location& loc = std::source_location::current()) {
-  detail::Log(LogLevel::Error, loc, msg);
+  GlobalLogger::Log(LogLevel::Error, msg, loc);
 }
 
 inline void LogFatal(const std::string& msg, const std::source_location& loc = std::source_location::current()) {
-  detail::Log(LogLevel::Fatal, loc, msg);
+  GlobalLogger::Log(LogLevel::Fatal, msg, loc);
 }
 
 }  // namespace arise
 
-#ifndef ARISE_DISABLE_LOGGING
-#define LOG_TRACE(...) arise::detail::Log(LogLevel::Trace, std::source_location::current(), __VA_ARGS__)
-#define LOG_DEBUG(...) arise::detail::Log(LogLevel::Debug, std::source_location::current(), __VA_ARGS__)
-#define LOG_INFO(...)  arise::detail::Log(LogLevel::Info, std::source_location::current(), __VA_ARGS__)
-#define LOG_WARN(...)  arise::detail::Log(LogLevel::Warning, std::source_location::current(), __VA_ARGS__)
-#define LOG_ERROR(...) arise::detail::Log(LogLevel::Error, std::source_location::current(), __VA_ARGS__)
-#define LOG_FATAL(...) arise::detail::Log(LogLevel::Fatal, std::source_location::current(), __VA_ARGS__)
+// every call site owns a static LogSite, the calling thread only copies the arguments (no formatting)
+#define ARISE_LOG_(level, ...)                                                       \
+  do {                                                                               \
+    static arise::detail::LogSite s_logSite(level, std::source_location::current()); \
+    arise::detail::Log(s_logSite, __VA_ARGS__);                                      \
+  } while (0)
+
+#if ARISE_LOG_ACTIVE_LEVEL <= ARISE_LOG_LEVEL_TRACE
+#define LOG_TRACE(...) ARISE_LOG_(arise::LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if ARISE_LOG_ACTIVE_LEVEL <= ARISE_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) ARISE_LOG_(arise::LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if ARISE_LOG_ACTIVE_LEVEL <= ARISE_LOG_LEVEL_INFO
+#define LOG_INFO(...) ARISE_LOG_(arise::LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if ARISE_LOG_ACTIVE_LEVEL <= ARISE_LOG_LEVEL_WARN
+#define LOG_WARN(...) ARISE_LOG_(arise::LogLevel::Warning, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if ARISE_LOG_ACTIVE_LEVEL <= ARISE_LOG_LEVEL_ERROR
+#define LOG_ERROR(...) ARISE_LOG_(arise::LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if ARISE_LOG_ACTIVE_LEVEL <= ARISE_LOG_LEVEL_FATAL
+#define LOG_FATAL(...) ARISE_LOG_(arise::LogLevel::Fatal, __VA_ARGS__)
 #else
-#define LOG_TRACE(...)
-#define LOG_DEBUG(...)
-#define LOG_INFO(...)
-#define LOG_WARN(...)
-#define LOG_ERROR(...)
-#define LOG_FATAL(...)
+#define LOG_FATAL(...) ((void)0)
 #endif
 
-#endif  // ARISE_LOG_H
\ No newline at end of file
+#endif  // ARISE_LOG_H
@@ -0,0 +1,158 @@
+#ifndef ARISE_LOG_RECORD_H
+#define ARISE_LOG_RECORD_H
+
+#include "utils/logger/i_logger.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace arise {
+namespace detail {
+
+// formats the arguments stored behind a record header and destroys them, instantiated per argument list
+using LogFormatFunction = std::string (*)(std::string_view format, std::byte* arguments);
+
+/**
+ * Header of a log message in a LogRingBuffer, followed by the arguments of the message (unformatted).
+ *
+ * Strings are stored as their size and characters, arithmetic types, enums and pointers as their bytes, other types
+ * are copy constructed into the record and destroyed by the format function. The header size keeps the arguments
+ * aligned.
+ */
+struct alignas(std::max_align_t) LogRecordHeader {
+  uint32_t                              size            = 0;  // whole record (header and arguments), never 0
+  LogLevel                              level           = LogLevel::Info;
+  uint32_t                              suppressedCount = 0;  // messages of the call site dropped by the rate limit
+  std::chrono::system_clock::time_point timestamp;
+  std::source_location                  location;
+  std::string_view                      format;  // points to the format string literal of the call site
+  LogFormatFunction                     formatFunction = nullptr;
+};
+
+inline void appendSuppressedCount(std::string& message, uint32_t suppressedCount) {
+  if (suppressedCount > 0) {
+    message += fmt::format(" ({} similar messages suppressed)", suppressedCount);
+  }
+}
+
+template <typename T>
+inline constexpr bool kIsLogString = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+inline constexpr bool kIsLogTrivial
+    = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> || std::is_null_pointer_v<T>;
+
+inline size_t alignLogOffset(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+// what the call site stores for an argument - a string view for strings, the argument itself otherwise
+template <typename T>
+decltype(auto) toLogArgument(const T& argument) {
+  if constexpr (kIsLogString<T>) {
+    if constexpr (std::is_pointer_v<T>) {
+      // fmt rejects null C strings
+      return argument ? std::string_view(argument) : std::string_view("(null)");
+    } else {
+      return std::string_view(argument);
+    }
+  } else {
+    return argument;
+  }
+}
+
+template <typename T>
+using LogArgumentType = std::remove_cvref_t<decltype(toLogArgument(std::declval<const T&>()))>;
+
+template <typename T>
+size_t getLogArgumentEnd(size_t offset, const T& argument) {
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    return alignLogOffset(offset, alignof(uint32_t)) + sizeof(uint32_t) + argument.size();
+  } else {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned log arguments are not supported");
+    return alignLogOffset(offset, alignof(T)) + sizeof(T);
+  }
+}
+
+template <typename T>
+void writeLogArgument(std::byte* arguments, size_t& offset, const T& argument) {
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    offset              = alignLogOffset(offset, alignof(uint32_t));
+    const uint32_t size = static_cast<uint32_t>(argument.size());
+    std::memcpy(arguments + offset, &size, sizeof(size));
+    std::memcpy(arguments + offset + sizeof(size), argument.data(), argument.size());
+    offset += sizeof(size) + argument.size();
+  } else if constexpr (kIsLogTrivial<T>) {
+    offset = alignLogOffset(offset, alignof(T));
+    std::memcpy(arguments + offset, &argument, sizeof(T));
+    offset += sizeof(T);
+  } else {
+    offset = alignLogOffset(offset, alignof(T));
+    new (arguments + offset) T(argument);
+    offset += sizeof(T);
+  }
+}
+
+// string_view and trivial arguments are read by value, others by reference (they live in the record)
+template <typename T>
+using LogReadType = std::conditional_t<std::is_same_v<T, std::string_view> || kIsLogTrivial<T>, T, T&>;
+
+template <typename T>
+LogReadType<T> readLogArgument(std::byte* arguments, size_t& offset) {
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    offset        = alignLogOffset(offset, alignof(uint32_t));
+    uint32_t size = 0;
+    std::memcpy(&size, arguments + offset, sizeof(size));
+    std::string_view argument(reinterpret_cast<const char*>(arguments + offset + sizeof(size)), size);
+    offset += sizeof(size) + size;
+    return argument;
+  } else if constexpr (kIsLogTrivial<T>) {
+    offset = alignLogOffset(offset, alignof(T));
+    T argument;
+    std::memcpy(&argument, arguments + offset, sizeof(T));
+    offset += sizeof(T);
+    return argument;
+  } else {
+    offset     = alignLogOffset(offset, alignof(T));
+    T* pointer = std::launder(reinterpret_cast<T*>(arguments + offset));
+    offset += sizeof(T);
+    return *pointer;
+  }
+}
+
+template <typename T>
+void destroyLogArgument(T& argument) {
+  if constexpr (!std::is_same_v<T, std::string_view> && !kIsLogTrivial<T>) {
+    argument.~T();
+  }
+}
+
+template <typename... Args>
+std::string formatLogRecord(std::string_view format, std::byte* arguments) {
+  size_t offset = 0;
+
+  // braced initialization reads the arguments in order
+  std::tuple<LogReadType<Args>...> decoded{readLogArgument<Args>(arguments, offset)...};
+
+  std::string message = std::apply(
+      [format](const auto&... values) { return fmt::format(fmt::runtime(format), values...); }, decoded);
+
+  std::apply([](auto&... values) { (destroyLogArgument(values), ...); }, decoded);
+
+  return message;
+}
+
+}  // namespace detail
+}  // namespace arise
+
+#endif  // ARISE_LOG_RECORD_H
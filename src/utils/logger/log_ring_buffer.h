@@ -0,0 +1,129 @@
+#ifndef ARISE_LOG_RING_BUFFER_H
+#define ARISE_LOG_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace arise {
+
+/**
+ * Single producer / single consumer byte ring buffer of one logging thread (AsyncLogQueue).
+ *
+ * The thread reserves a contiguous record (prepare()), writes it and publishes it (commit()), the backend thread reads
+ * the published records (peek()) and gives the space back once they're processed (pop()). Positions only grow, the
+ * offset in the buffer is the position modulo the capacity. A record that doesn't fit in front of the end of the buffer
+ * starts at the beginning, the unused end is marked with a zero record size.
+ */
+class LogRingBuffer {
+  public:
+  // records and the capacity are multiples of it, so every record starts aligned
+  static constexpr size_t kRecordAlignment = alignof(std::max_align_t);
+
+  // capacity must be a power of two (new[] aligns the data for kRecordAlignment)
+  explicit LogRingBuffer(size_t capacity)
+      : m_capacity_(capacity)
+      , m_mask_(capacity - 1)
+      , m_dataStorage_(new std::byte[capacity])
+      , m_data_(m_dataStorage_.get()) {}
+
+  LogRingBuffer(const LogRingBuffer&)            = delete;
+  LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+  static size_t s_alignRecordSize(size_t size) { return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1); }
+
+  // largest record prepare() accepts, larger ones would block the buffer for too long
+  size_t getMaxRecordSize() const { return m_capacity_ / 4; }
+
+  /**
+   * Producer: reserves size bytes (aligned with s_alignRecordSize) for the next record
+   *
+   * @return nullptr if the backend hasn't made room yet
+   */
+  std::byte* prepare(size_t size) {
+    size_t       writePosition = m_writePosition_.load(std::memory_order_relaxed);
+    const size_t offset        = writePosition & m_mask_;
+    const size_t tail          = m_capacity_ - offset;
+    const size_t required      = size > tail ? size + tail : size;
+
+    if (writePosition + required - m_cachedReadPosition_ > m_capacity_) {
+      m_cachedReadPosition_ = m_readPosition_.load(std::memory_order_acquire);
+      if (writePosition + required - m_cachedReadPosition_ > m_capacity_) {
+        return nullptr;
+      }
+    }
+
+    if (size > tail) {
+      const uint32_t wrapMarker = 0;
+      std::memcpy(m_data_ + offset, &wrapMarker, sizeof(wrapMarker));
+      writePosition += tail;
+    }
+
+    m_preparedPosition_ = writePosition;
+    return m_data_ + (writePosition & m_mask_);
+  }
+
+  // producer: publishes the record returned by the last prepare()
+  void commit(size_t size) { m_writePosition_.store(m_preparedPosition_ + size, std::memory_order_release); }
+
+  /**
+   * Consumer: the next published record (its first 4 bytes hold its size), skips the unused end of the buffer
+   *
+   * @return nullptr if there is no record
+   */
+  std::byte* peek() {
+    const size_t writePosition = m_writePosition_.load(std::memory_order_acquire);
+
+    while (m_consumerPosition_ != writePosition) {
+      std::byte* record = m_data_ + (m_consumerPosition_ & m_mask_);
+
+      uint32_t recordSize = 0;
+      std::memcpy(&recordSize, record, sizeof(recordSize));
+      if (recordSize != 0) {
+        return record;
+      }
+
+      m_consumerPosition_ += m_capacity_ - (m_consumerPosition_ & m_mask_);
+    }
+
+    return nullptr;
+  }
+
+  // consumer: releases the record returned by peek()
+  void pop(size_t size) {
+    m_consumerPosition_ += size;
+    m_readPosition_.store(m_consumerPosition_, std::memory_order_release);
+  }
+
+  bool isEmpty() const {
+    return m_writePosition_.load(std::memory_order_acquire) == m_readPosition_.load(std::memory_order_acquire);
+  }
+
+  // the owning thread exited, the buffer is dropped once it's drained
+  void retire() { m_retired_.store(true, std::memory_order_release); }
+
+  bool isRetired() const { return m_retired_.load(std::memory_order_acquire); }
+
+  private:
+  const size_t                 m_capacity_;
+  const size_t                 m_mask_;
+  std::unique_ptr<std::byte[]> m_dataStorage_;
+  std::byte*                   m_data_;
+
+  // producer side
+  alignas(64) std::atomic<size_t> m_writePosition_{0};
+  size_t m_preparedPosition_   = 0;
+  size_t m_cachedReadPosition_ = 0;
+
+  // consumer side
+  alignas(64) std::atomic<size_t> m_readPosition_{0};
+  size_t m_consumerPosition_ = 0;
+
+  std::atomic<bool> m_retired_{false};
+};
+
+}  // namespace arise
+
+#endif  // ARISE_LOG_RING_BUFFER_H
@@ -1,41 +1,176 @@
 #include "utils/logger/memory_logger.h"
 
 #include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <functional>
 
 namespace arise {
 
-void MemoryLogger::log(LogLevel logLevel, const std::string& message, const std::source_location& loc) {
-  auto file = std::filesystem::path(loc.file_name()).filename().string();
+void LogFilterView::setFilter(LogLevel minLevel, std::string_view text) {
+  if (minLevel == m_minLevel_ && text == m_text_) {
+    return;
+  }
 
-  std::string functionName{loc.function_name()};
-  // strip off the parameter list (remove everything from '(' onward)
-  if (auto p = functionName.find('('); p != std::string::npos) {
-    functionName.erase(p);
+  m_minLevel_ = minLevel;
+  m_text_     = text;
+  m_sequences_.clear();
+  m_nextSequence_ = 0;
+}
+
+size_t MemoryLogger::CallSiteKeyHash::operator()(const CallSiteKey& key) const {
+  size_t hash = std::hash<const void*>()(key.file);
+  hash ^= std::hash<const void*>()(key.function) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= std::hash<uint64_t>()((uint64_t(key.line) << 32) | key.column) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= std::hash<int>()(static_cast<int>(key.level)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+MemoryLogger::MemoryLogger(std::string loggerName, size_t maxEntries)
+    : ILogger(std::move(loggerName))
+    , m_records_(std::max<size_t>(maxEntries, 1)) {}
+
+void MemoryLogger::log(LogLevel                              logLevel,
+                       const std::string&                    message,
+                       const std::source_location&           loc,
+                       std::chrono::system_clock::time_point timestamp) {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  if (m_nextSequence_ - m_oldestSequence_ == m_records_.size()) {
+    evictOldest_();
   }
-  // strip off any namespace qualifiers (remove up to the last "::")
-  if (auto ns = functionName.rfind("::"); ns != std::string::npos) {
-    functionName.erase(0, ns + 2);
+
+  // longer messages are truncated
+  const size_t size = std::min(message.size(), kChunkSize);
+  char*        text = allocateMessage_(size);
+  std::memcpy(text, message.data(), size);
+
+  Record& record   = m_records_[m_nextSequence_ % m_records_.size()];
+  record.timestamp = timestamp;
+  record.callSite  = internCallSite_(logLevel, loc);
+  record.message   = text;
+  record.size      = static_cast<uint32_t>(size);
+
+  ++m_nextSequence_;
+}
+
+void MemoryLogger::updateView(LogFilterView& view) const {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  while (!view.m_sequences_.empty() && view.m_sequences_.front() < m_oldestSequence_) {
+    view.m_sequences_.pop_front();
   }
 
-  LogEntry entry{std::chrono::system_clock::now(), logLevel, file, static_cast<int>(loc.line()), functionName, message};
+  for (uint64_t sequence = std::max(view.m_nextSequence_, m_oldestSequence_); sequence < m_nextSequence_; ++sequence) {
+    const Record& record = m_records_[sequence % m_records_.size()];
+    if (record.callSite->level < view.m_minLevel_) {
+      continue;
+    }
+
+    if (!view.m_text_.empty()
+        && std::string_view(record.message, record.size).find(view.m_text_) == std::string_view::npos) {
+      continue;
+    }
 
-  m_entries_.push_back(std::move(entry));
-  if (m_maxEntries_ > 0 && m_entries_.size() > m_maxEntries_) {
-    m_entries_.erase(m_entries_.begin());
+    view.m_sequences_.push_back(sequence);
   }
+
+  view.m_nextSequence_ = m_nextSequence_;
 }
 
-const std::vector<LogEntry>& MemoryLogger::getLogEntries() const {
-  return m_entries_;
+void MemoryLogger::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  // sequence numbers keep growing, views drop the cleared entries on their next update
+  m_oldestSequence_ = m_nextSequence_;
+
+  for (auto& chunk : m_chunks_) {
+    m_freeChunks_.push_back(std::move(chunk.data));
+  }
+  m_chunks_.clear();
 }
 
 void MemoryLogger::setMaxEntries(size_t maxEntries) {
-  m_maxEntries_ = maxEntries;
+  clear();
+
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  m_records_.assign(std::max<size_t>(maxEntries, 1), Record());
 }
 
 size_t MemoryLogger::getMaxEntries() const {
-  return m_maxEntries_;
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  return m_records_.size();
+}
+
+size_t MemoryLogger::getEntryCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  return static_cast<size_t>(m_nextSequence_ - m_oldestSequence_);
+}
+
+const LogCallSite* MemoryLogger::internCallSite_(LogLevel level, const std::source_location& location) {
+  const CallSiteKey key{location.file_name(), location.function_name(), location.line(), location.column(), level};
+
+  auto it = m_callSites_.find(key);
+  if (it != m_callSites_.end()) {
+    return &it->second;
+  }
+
+  LogCallSite callSite;
+  callSite.file  = std::filesystem::path(location.file_name()).filename().string();
+  callSite.line  = location.line();
+  callSite.level = level;
+
+  std::string_view functionName{location.function_name()};
+  // strip off the parameter list (remove everything from '(' onward)
+  if (auto p = functionName.find('('); p != std::string_view::npos) {
+    functionName.remove_suffix(functionName.size() - p);
+  }
+  // strip off any namespace qualifiers (remove up to the last "::")
+  if (auto ns = functionName.rfind("::"); ns != std::string_view::npos) {
+    functionName.remove_prefix(ns + 2);
+  }
+  callSite.function = functionName;
+
+  return &m_callSites_.emplace(key, std::move(callSite)).first->second;
+}
+
+char* MemoryLogger::allocateMessage_(size_t size) {
+  if (m_chunks_.empty() || m_chunks_.back().used + size > kChunkSize) {
+    // chunks whose entries are all evicted are reused
+    while (!m_chunks_.empty() && m_chunks_.front().lastSequence < m_oldestSequence_) {
+      m_freeChunks_.push_back(std::move(m_chunks_.front().data));
+      m_chunks_.pop_front();
+    }
+
+    // all chunks in use (long messages) - evict the entries of the oldest chunk early
+    if (m_chunks_.size() >= kMaxChunks) {
+      while (m_oldestSequence_ <= m_chunks_.front().lastSequence) {
+        evictOldest_();
+      }
+      m_freeChunks_.push_back(std::move(m_chunks_.front().data));
+      m_chunks_.pop_front();
+    }
+
+    Chunk chunk;
+    if (m_freeChunks_.empty()) {
+      chunk.data = std::make_unique<char[]>(kChunkSize);
+    } else {
+      chunk.data = std::move(m_freeChunks_.back());
+      m_freeChunks_.pop_back();
+    }
+    m_chunks_.push_back(std::move(chunk));
+  }
+
+  Chunk& chunk       = m_chunks_.back();
+  char*  text        = chunk.data.get() + chunk.used;
+  chunk.lastSequence = m_nextSequence_;
+
+  chunk.used += size;
+  return text;
+}
+
+void MemoryLogger::evictOldest_() {
+  ++m_oldestSequence_;
 }
 
 }  // namespace arise
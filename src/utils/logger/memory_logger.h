@@ -3,40 +3,162 @@
 
 #include "i_logger.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace arise {
 
+// metadata of a logging call site, interned once per source location and level
+struct LogCallSite {
+  std::string file;      // file name without the directory
+  std::string function;  // without namespaces and parameters
+  uint32_t    line  = 0;
+  LogLevel    level = LogLevel::Info;
+};
+
+// entry of a MemoryLogger, the message is valid while the entry is visited
 struct LogEntry {
   std::chrono::system_clock::time_point timestamp;
-  LogLevel                              level;
-  std::string                           file;
-  int                                   line;
-  std::string                           function;
-  std::string                           message;
+  const LogCallSite*                    callSite = nullptr;
+  std::string_view                      message;
+  uint64_t                              sequence = 0;
+};
+
+/**
+ * Entries of a MemoryLogger that pass a filter (minimum level, substring of the message).
+ *
+ * MemoryLogger::updateView() only scans the entries logged since the last update and drops the evicted ones from the
+ * front, a changed filter rebuilds the view once.
+ */
+class LogFilterView {
+  public:
+  // the view is rebuilt on the next update if the filter changed
+  void setFilter(LogLevel minLevel, std::string_view text);
+
+  // sequence numbers of the matching entries, oldest first
+  const std::deque<uint64_t>& getSequences() const { return m_sequences_; }
+
+  size_t getSize() const { return m_sequences_.size(); }
+
+  private:
+  friend class MemoryLogger;
+
+  LogLevel             m_minLevel_ = LogLevel::Trace;
+  std::string          m_text_;
+  std::deque<uint64_t> m_sequences_;
+  uint64_t             m_nextSequence_ = 0;  // first entry not scanned yet
 };
 
+/**
+ * Keeps the last maxEntries log messages in memory (e.g. for the editor log window).
+ *
+ * Entries live in a fixed-capacity circular buffer - the oldest entry is overwritten once it's full. Message text is
+ * stored in chunks of kChunkSize bytes, a chunk is reused once the entries pointing into it are evicted (at most
+ * kMaxChunks chunks, older entries are evicted early when messages are long). File, line, function and level are
+ * interned per call site.
+ *
+ * log() is called from the logging backend thread, the entries are read through visitEntries().
+ */
 class MemoryLogger : public ILogger {
   public:
-  // maxEntries = 0 means no limit
-  MemoryLogger(std::string loggerName, size_t maxEntries = 0)
-      : ILogger(std::move(loggerName))
-      , m_maxEntries_(maxEntries) {}
+  static constexpr size_t kDefaultMaxEntries = 16 * 1024;
+  static constexpr size_t kChunkSize         = 64 * 1024;
+  static constexpr size_t kMaxChunks         = 64;
+
+  MemoryLogger(std::string loggerName, size_t maxEntries = kDefaultMaxEntries);
+
+  void log(LogLevel                              level,
+           const std::string&                    message,
+           const std::source_location&           location  = std::source_location::current(),
+           std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) override;
+
+  // appends the entries logged since the last update that pass the filter of the view
+  void updateView(LogFilterView& view) const;
+
+  /**
+   * Calls visitor(const LogEntry&) for the entries at [first, first + count) of the view that are still stored,
+   * the logger is locked meanwhile
+   */
+  template <typename Visitor>
+  void visitEntries(const LogFilterView& view, size_t first, size_t count, Visitor&& visitor) const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
 
-  void log(LogLevel                    level,
-           const std::string&          message,
-           const std::source_location& location = std::source_location::current()) override;
+    const size_t last = std::min(first + count, view.m_sequences_.size());
+    for (size_t i = first; i < last; ++i) {
+      const uint64_t sequence = view.m_sequences_[i];
+      if (sequence >= m_oldestSequence_ && sequence < m_nextSequence_) {
+        visitor(getEntry_(sequence));
+      }
+    }
+  }
 
-  const std::vector<LogEntry>& getLogEntries() const;
+  void clear();
 
+  // clears the log
   void                 setMaxEntries(size_t maxEntries);
   [[nodiscard]] size_t getMaxEntries() const;
 
+  [[nodiscard]] size_t getEntryCount() const;
+
   private:
-  std::vector<LogEntry> m_entries_;
-  size_t                m_maxEntries_{0};
+  struct CallSiteKey {
+    const char* file     = nullptr;
+    const char* function = nullptr;
+    uint32_t    line     = 0;
+    uint32_t    column   = 0;
+    LogLevel    level    = LogLevel::Info;
+
+    bool operator==(const CallSiteKey&) const = default;
+  };
+
+  struct CallSiteKeyHash {
+    size_t operator()(const CallSiteKey& key) const;
+  };
+
+  struct Record {
+    std::chrono::system_clock::time_point timestamp;
+    const LogCallSite*                    callSite = nullptr;
+    const char*                           message  = nullptr;
+    uint32_t                              size     = 0;
+  };
+
+  struct Chunk {
+    std::unique_ptr<char[]> data;
+    size_t                  used         = 0;
+    uint64_t                lastSequence = 0;  // newest entry with its message in the chunk
+  };
+
+  const LogCallSite* internCallSite_(LogLevel level, const std::source_location& location);
+
+  // space for the message of entry m_nextSequence_, evicts entries if all chunks are in use
+  char* allocateMessage_(size_t size);
+
+  // drops the oldest entry
+  void evictOldest_();
+
+  LogEntry getEntry_(uint64_t sequence) const {
+    const Record& record = m_records_[sequence % m_records_.size()];
+    return LogEntry{record.timestamp, record.callSite, std::string_view(record.message, record.size), sequence};
+  }
+
+  mutable std::mutex m_mutex_;
+
+  std::vector<Record> m_records_;  // circular, entry s is at s % size
+  uint64_t            m_oldestSequence_ = 0;
+  uint64_t            m_nextSequence_   = 0;
+
+  std::deque<Chunk>                    m_chunks_;  // oldest first, messages are appended to the last one
+  std::vector<std::unique_ptr<char[]>> m_freeChunks_;
+
+  std::unordered_map<CallSiteKey, LogCallSite, CallSiteKeyHash> m_callSites_;
 };
 
 }  // namespace arise
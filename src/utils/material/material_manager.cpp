@@ -4,6 +4,9 @@
 #include "utils/material/material_loader_manager.h"
 #include "utils/service/service_locator.h"
 #include "utils/texture/texture_manager.h"
+#include "utils/third_party/xxhash_util.h"
+
+#include <map>
 
 namespace arise {
 MaterialManager::~MaterialManager() {
@@ -17,8 +20,8 @@ MaterialManager::~MaterialManager() {
     LOG_INFO("MaterialManager destroyed, releasing {} materials from {} files", totalMaterials, materialCache_.size());
 
     for (const auto& [path, materials] : materialCache_) {
-      for (const auto& material : materials) {
-        LOG_INFO("Released material: {} from {}", material->materialName, path.filename().string());
+      for (const auto& handle : materials) {
+        LOG_INFO("Released material: {} from {}", m_materialPool_.get(handle)->materialName, path.filename().string());
       }
     }
   }
@@ -27,13 +30,9 @@ MaterialManager::~MaterialManager() {
 std::vector<ecs::Material*> MaterialManager::getMaterials(const std::filesystem::path& filepath) {
   std::lock_guard<std::mutex> lock(m_mutex_);
 
-  auto it = materialCache_.find(filepath);
-  if (it != materialCache_.end()) {
-    std::vector<ecs::Material*> result;
-    for (const auto& material : it->second) {
-      result.push_back(material.get());
-    }
-    return result;
+  auto it = m_fileMaterials_.find(filepath);
+  if (it != m_fileMaterials_.end()) {
+    return it->second;
   }
 
   auto materialLoaderManager = ServiceLocator::s_get<MaterialLoaderManager>();
@@ -46,14 +45,36 @@ std::vector<ecs::Material*> MaterialManager::getMaterials(const std::filesystem:
   if (!materials.empty()) {
     std::vector<ecs::Material*> result;
 
-    auto& cacheEntry = materialCache_[filepath];
-
     for (auto& material : materials) {
-      result.push_back(material.get());
+      const uint64_t contentHash = computeContentHash_(material.get());
+
+      // references are counted per render mesh (see retainMaterial), so only look up here
+      auto sharedMaterial = m_contentRegistry_.find(contentHash);
+      if (sharedMaterial) {
+        LOG_DEBUG("Material '{}' from {} has the same content as '{}', reusing it",
+                  material->materialName,
+                  filepath.filename().string(),
+                  sharedMaterial->materialName);
+        releaseTextures_(material.get());
+        result.push_back(sharedMaterial);
+        continue;
+      }
+
+      ecs::Material* materialPtr = material.get();
+      materialPtr->handle        = m_materialPool_.add(std::move(material));
+      if (!materialPtr->handle.isValid()) {
+        LOG_ERROR("Material pool is full, cannot add materials from {}", filepath.string());
+        break;
+      }
 
-      cacheEntry.push_back(std::move(material));
+      m_contentRegistry_.add(contentHash, materialPtr, 0);
+      result.push_back(materialPtr);
+
+      materialCache_[filepath].push_back(materialPtr->handle);
     }
 
+    m_fileMaterials_[filepath] = result;
+
     return result;
   }
 
@@ -61,6 +82,14 @@ std::vector<ecs::Material*> MaterialManager::getMaterials(const std::filesystem:
   return {};
 }
 
+void MaterialManager::retainMaterial(ecs::Material* material) {
+  if (!material) {
+    return;
+  }
+
+  m_contentRegistry_.retain(material);
+}
+
 bool MaterialManager::removeMaterial(ecs::Material* material) {
   if (!material) {
     LOG_ERROR("Cannot remove null material");
@@ -69,25 +98,24 @@ bool MaterialManager::removeMaterial(ecs::Material* material) {
 
   std::lock_guard<std::mutex> lock(m_mutex_);
 
+  if (!m_contentRegistry_.release(material)) {
+    LOG_DEBUG("Material '{}' is still in use, dropped one reference", material->materialName);
+    return true;
+  }
+
   for (auto it = materialCache_.begin(); it != materialCache_.end(); ++it) {
     auto& materialVec = it->second;
-    auto  materialIt  = std::find_if(materialVec.begin(),
-                                   materialVec.end(),
-                                   [material](const std::unique_ptr<ecs::Material>& m) { return m.get() == material; });
+    auto  materialIt  = std::find(materialVec.begin(), materialVec.end(), material->handle);
 
     if (materialIt != materialVec.end()) {
       LOG_INFO("Removing material: {}", material->materialName);
 
-      auto textureManager = ServiceLocator::s_get<TextureManager>();
-      if (textureManager) {
-        for (const auto& [textureName, texturePtr] : material->textures) {
-          if (texturePtr) {
-            LOG_DEBUG("Releasing texture '{}' from material '{}'", textureName, material->materialName);
-            textureManager->removeTexture(texturePtr);
-          }
-        }
-      } else {
-        LOG_WARN("TextureManager not available, textures may not be properly released");
+      releaseTextures_(material);
+
+      for (auto fileIt = m_fileMaterials_.begin(); fileIt != m_fileMaterials_.end();) {
+        auto& fileMaterials = fileIt->second;
+        std::erase(fileMaterials, material);
+        fileIt = fileMaterials.empty() ? m_fileMaterials_.erase(fileIt) : std::next(fileIt);
       }
 
       LOG_INFO("Material '{}' deleted", material->materialName);
@@ -96,6 +124,7 @@ bool MaterialManager::removeMaterial(ecs::Material* material) {
       if (materialVec.empty()) {
         materialCache_.erase(it);
       }
+      m_materialPool_.remove(material->handle);
       return true;
     }
   }
@@ -103,4 +132,55 @@ bool MaterialManager::removeMaterial(ecs::Material* material) {
   LOG_DEBUG("Material not found in manager (may have been removed already)");
   return false;
 }
+
+uint64_t MaterialManager::computeContentHash_(const ecs::Material* material) {
+  // parameter maps are unordered, iterate them in key order to get a stable hash
+  std::map<std::string, float>           scalarParameters;
+  std::map<std::string, math::Vector4f>  vectorParameters;
+  std::map<StringId, gfx::rhi::Texture*> textures;
+
+  scalarParameters.insert(material->scalarParameters.begin(), material->scalarParameters.end());
+  vectorParameters.insert(material->vectorParameters.begin(), material->vectorParameters.end());
+  for (const auto& [name, texture] : material->textures) {
+    textures.emplace(name, texture);
+  }
+
+  uint64_t hash = XXH64(material->alphaMode);
+  hash          = XXH64(material->alphaCutoff, hash);
+
+  for (const auto& [name, value] : scalarParameters) {
+    hash = XXH64Bytes(name.data(), name.size(), hash);
+    hash = XXH64(value, hash);
+  }
+
+  for (const auto& [name, value] : vectorParameters) {
+    const float components[4] = {value.x(), value.y(), value.z(), value.w()};
+    hash                      = XXH64Bytes(name.data(), name.size(), hash);
+    hash                      = XXH64Bytes(components, sizeof(components), hash);
+  }
+
+  // textures are already deduplicated by TextureManager, so equal pointers mean equal content
+  for (const auto& [name, texture] : textures) {
+    hash = XXH64(name.getHash(), hash);
+    hash = XXH64(reinterpret_cast<uintptr_t>(texture), hash);
+  }
+
+  return hash;
+}
+
+void MaterialManager::releaseTextures_(const ecs::Material* material) {
+  auto textureManager = ServiceLocator::s_get<TextureManager>();
+  if (!textureManager) {
+    LOG_WARN("TextureManager not available, textures may not be properly released");
+    return;
+  }
+
+  for (const auto& [textureName, texturePtr] : material->textures) {
+    if (texturePtr) {
+      LOG_DEBUG("Releasing texture '{}' from material '{}'", textureName.toString(), material->materialName);
+      textureManager->removeTexture(texturePtr);
+    }
+  }
+}
+
 }  // namespace arise
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define ARISE_MATERIAL_MANAGER_H
 
 #include "ecs/components/material.h"
+#include "utils/handle/handle_pool.h"
+#include "utils/resource/content_hash_registry.h"
 
 #include <filesystem>
 #include <memory>
@@ -16,13 +18,33 @@ class MaterialManager {
   MaterialManager() = default;
   ~MaterialManager();
 
+  /**
+   * Materials whose parameters and textures match an already loaded material (from any file) are
+   * replaced by that material, so the returned list may point to materials owned by other files.
+   */
   std::vector<ecs::Material*> getMaterials(const std::filesystem::path& filepath);
 
+  /**
+   * @brief Adds a user reference (one per render mesh), dropped by removeMaterial()
+   */
+  void retainMaterial(ecs::Material* material);
+
   bool removeMaterial(ecs::Material* material);
 
+  const ContentHashRegistry<ecs::Material>& getContentRegistry() const { return m_contentRegistry_; }
+
   private:
-  std::unordered_map<std::filesystem::path, std::vector<std::unique_ptr<ecs::Material>>> materialCache_;
-  std::mutex                                                                             m_mutex_;
+  static uint64_t computeContentHash_(const ecs::Material* material);
+
+  void releaseTextures_(const ecs::Material* material);
+
+  HandlePool<ecs::Material> m_materialPool_;
+  // materials owned by the file they were first loaded from
+  std::unordered_map<std::filesystem::path, std::vector<Handle<ecs::Material>>> materialCache_;
+  // material list of each file in source order (entries may be shared with other files)
+  std::unordered_map<std::filesystem::path, std::vector<ecs::Material*>>        m_fileMaterials_;
+  ContentHashRegistry<ecs::Material>                                            m_contentRegistry_;
+  std::mutex                                                                    m_mutex_;
 };
 
 }  // namespace arise
@@ -0,0 +1,250 @@
+#include "utils/memory/allocation_tracker.h"
+
+#include "utils/logger/log.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace arise {
+
+namespace {
+
+// linear probing stops here, the allocation is counted in the "other" call site
+constexpr uint32_t kMaxCallSiteProbes = 32;
+
+// call sites listed per tag in the leak report
+constexpr size_t kMaxReportedCallSites = 16;
+
+uint32_t hashCallSite(MemoryTag tag, const char* scope, const void* returnAddress) {
+  uint64_t hash = reinterpret_cast<uintptr_t>(returnAddress);
+  hash          = (hash ^ reinterpret_cast<uintptr_t>(scope)) * 0x9E3779B97F4A7C15ull;
+  hash          = (hash ^ static_cast<uint64_t>(tag)) * 0x9E3779B97F4A7C15ull;
+  return static_cast<uint32_t>(hash >> 32);
+}
+
+}  // namespace
+
+std::array<AllocationTracker::TagCounters, static_cast<size_t>(MemoryTag::Count)> AllocationTracker::s_counters;
+std::array<AllocationTracker::CallSite, AllocationTracker::kMaxCallSites>          AllocationTracker::s_callSites;
+
+const char* g_getMemoryTagName(MemoryTag tag) {
+  switch (tag) {
+    case MemoryTag::Untagged:
+      return "Untagged";
+    case MemoryTag::Loader:
+      return "Loader";
+    case MemoryTag::Renderer:
+      return "Renderer";
+    case MemoryTag::Ecs:
+      return "ECS";
+    case MemoryTag::Editor:
+      return "Editor";
+    case MemoryTag::Logger:
+      return "Logger";
+    default:
+      return "Unknown";
+  }
+}
+
+uint32_t AllocationTracker::s_getCallSite(MemoryTag tag, const void* returnAddress) noexcept {
+  const char*    scope = s_currentScope;
+  const uint32_t hash  = hashCallSite(tag, scope, returnAddress);
+
+  for (uint32_t probe = 0; probe < kMaxCallSiteProbes; ++probe) {
+    // the "other" site is never claimed
+    const uint32_t index = 1 + (hash + probe) % (kMaxCallSites - 1);
+    CallSite&      site  = s_callSites[index];
+
+    uint32_t state = site.state.load(std::memory_order_acquire);
+    if (state == CallSite::kEmpty) {
+      if (site.state.compare_exchange_strong(state, CallSite::kClaiming, std::memory_order_acquire)) {
+        site.tag           = tag;
+        site.scope         = scope;
+        site.returnAddress = returnAddress;
+        site.state.store(CallSite::kReady, std::memory_order_release);
+        return index;
+      }
+    }
+
+    // another thread is writing the key of the site
+    while (state == CallSite::kClaiming) {
+      state = site.state.load(std::memory_order_acquire);
+    }
+
+    if (site.tag == tag && site.scope == scope && site.returnAddress == returnAddress) {
+      return index;
+    }
+  }
+  return kOtherCallSite;
+}
+
+void AllocationTracker::s_recordAllocation(MemoryTag tag, uint32_t callSite, uint64_t size) noexcept {
+  CallSite& site = s_callSites[callSite < kMaxCallSites ? callSite : kOtherCallSite];
+  site.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+  site.liveBytes.fetch_add(size, std::memory_order_relaxed);
+
+  TagCounters& counters = s_counters[static_cast<size_t>(tag)];
+
+  counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+  counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+
+  const uint64_t liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  uint64_t       peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+  while (liveBytes > peakBytes
+         && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {
+  }
+}
+
+void AllocationTracker::s_recordDeallocation(MemoryTag tag, uint32_t callSite, uint64_t size) noexcept {
+  CallSite& site = s_callSites[callSite < kMaxCallSites ? callSite : kOtherCallSite];
+  site.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+  site.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+
+  TagCounters& counters = s_counters[static_cast<size_t>(tag)];
+
+  counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+  counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void AllocationTracker::s_endFrame() {
+  for (auto& counters : s_counters) {
+    const uint64_t allocations    = counters.totalAllocations.load(std::memory_order_relaxed);
+    const uint64_t allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+
+    counters.frameAllocations      = allocations - counters.frameStartAllocations;
+    counters.frameAllocatedBytes   = allocatedBytes - counters.frameStartBytes;
+    counters.frameStartAllocations = allocations;
+    counters.frameStartBytes       = allocatedBytes;
+  }
+}
+
+MemoryTagStats AllocationTracker::s_getStats(MemoryTag tag) {
+  const TagCounters& counters = s_counters[static_cast<size_t>(tag)];
+
+  MemoryTagStats stats;
+  stats.tag                 = tag;
+  stats.liveBytes           = counters.liveBytes.load(std::memory_order_relaxed);
+  stats.peakBytes           = counters.peakBytes.load(std::memory_order_relaxed);
+  stats.liveAllocations     = counters.liveAllocations.load(std::memory_order_relaxed);
+  stats.totalAllocations    = counters.totalAllocations.load(std::memory_order_relaxed);
+  stats.frameAllocations    = counters.frameAllocations;
+  stats.frameAllocatedBytes = counters.frameAllocatedBytes;
+  return stats;
+}
+
+std::string AllocationTracker::s_createReport() {
+  std::string report = fmt::format("{:<10} {:>14} {:>14} {:>12} {:>14} {:>12} {:>16}\n",
+                                   "Tag",
+                                   "Live (KB)",
+                                   "Peak (KB)",
+                                   "Live allocs",
+                                   "Total allocs",
+                                   "Allocs/frame",
+                                   "Bytes/frame");
+
+  MemoryTagStats total;
+  for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+    const MemoryTagStats stats = s_getStats(static_cast<MemoryTag>(i));
+
+    report += fmt::format("{:<10} {:>14.1f} {:>14.1f} {:>12} {:>14} {:>12} {:>16}\n",
+                          g_getMemoryTagName(stats.tag),
+                          stats.liveBytes / 1024.0,
+                          stats.peakBytes / 1024.0,
+                          stats.liveAllocations,
+                          stats.totalAllocations,
+                          stats.frameAllocations,
+                          stats.frameAllocatedBytes);
+
+    total.liveBytes           += stats.liveBytes;
+    total.liveAllocations     += stats.liveAllocations;
+    total.totalAllocations    += stats.totalAllocations;
+    total.frameAllocations    += stats.frameAllocations;
+    total.frameAllocatedBytes += stats.frameAllocatedBytes;
+  }
+
+  // the peaks of the tags don't necessarily coincide, so there's no total peak
+  report += fmt::format("{:<10} {:>14.1f} {:>14} {:>12} {:>14} {:>12} {:>16}\n",
+                        "Total",
+                        total.liveBytes / 1024.0,
+                        "-",
+                        total.liveAllocations,
+                        total.totalAllocations,
+                        total.frameAllocations,
+                        total.frameAllocatedBytes);
+  return report;
+}
+
+void AllocationTracker::s_reportLeaks() {
+  if (!s_isEnabled()) {
+    return;
+  }
+
+  struct LeakedCallSite {
+    uint32_t index;
+    uint64_t liveBytes;
+    uint64_t liveAllocations;
+  };
+
+  std::vector<LeakedCallSite> callSites;
+
+  bool leaked = false;
+  for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+    const MemoryTagStats stats = s_getStats(static_cast<MemoryTag>(i));
+    // untagged memory includes the static objects that are released after the engine, the logger still runs
+    if (stats.liveAllocations == 0 || stats.tag == MemoryTag::Untagged || stats.tag == MemoryTag::Logger) {
+      continue;
+    }
+
+    LOG_WARN("Memory leak: {} allocations ({:.1f} KB) of tag {} are still alive at shutdown",
+             stats.liveAllocations,
+             stats.liveBytes / 1024.0,
+             g_getMemoryTagName(stats.tag));
+    leaked = true;
+
+    callSites.clear();
+    for (uint32_t index = 1; index < kMaxCallSites; ++index) {
+      const CallSite& site = s_callSites[index];
+      if (site.state.load(std::memory_order_acquire) != CallSite::kReady || site.tag != stats.tag) {
+        continue;
+      }
+
+      const uint64_t liveAllocations = site.liveAllocations.load(std::memory_order_relaxed);
+      if (liveAllocations > 0) {
+        callSites.push_back({index, site.liveBytes.load(std::memory_order_relaxed), liveAllocations});
+      }
+    }
+
+    std::sort(callSites.begin(), callSites.end(), [](const LeakedCallSite& lhs, const LeakedCallSite& rhs) {
+      return lhs.liveBytes > rhs.liveBytes;
+    });
+
+    for (size_t j = 0; j < std::min(callSites.size(), kMaxReportedCallSites); ++j) {
+      const CallSite& site = s_callSites[callSites[j].index];
+      LOG_WARN("  {} allocations ({:.1f} KB) from {} in scope {}",
+               callSites[j].liveAllocations,
+               callSites[j].liveBytes / 1024.0,
+               site.returnAddress,
+               site.scope ? site.scope : "(none)");
+    }
+    if (callSites.size() > kMaxReportedCallSites) {
+      LOG_WARN("  ... and {} more call sites", callSites.size() - kMaxReportedCallSites);
+    }
+  }
+
+  // the "other" site collects every tag, including the ones skipped above
+  const CallSite& other = s_callSites[kOtherCallSite];
+  if (leaked && other.liveAllocations.load(std::memory_order_relaxed) > 0) {
+    LOG_WARN("{} allocations ({:.1f} KB) of any tag come from call sites that didn't fit the call site table",
+             other.liveAllocations.load(std::memory_order_relaxed),
+             other.liveBytes.load(std::memory_order_relaxed) / 1024.0);
+  }
+
+  if (!leaked) {
+    LOG_INFO("No tagged memory is alive at shutdown");
+  }
+}
+
+}  // namespace arise
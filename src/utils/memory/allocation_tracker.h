@@ -0,0 +1,150 @@
+#ifndef ARISE_ALLOCATION_TRACKER_H
+#define ARISE_ALLOCATION_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <source_location>
+#include <string>
+
+namespace arise {
+
+// subsystem a heap allocation is attributed to, set per thread with MemoryTagScope
+enum class MemoryTag : uint8_t {
+  Untagged,
+  Loader,
+  Renderer,
+  Ecs,
+  Editor,
+  Logger,
+  Count,
+};
+
+const char* g_getMemoryTagName(MemoryTag tag);
+
+struct MemoryTagStats {
+  MemoryTag tag;
+  uint64_t  liveBytes           = 0;
+  uint64_t  peakBytes           = 0;  // of liveBytes since the start
+  uint64_t  liveAllocations     = 0;
+  uint64_t  totalAllocations    = 0;
+  uint64_t  frameAllocations    = 0;  // of the last complete frame
+  uint64_t  frameAllocatedBytes = 0;  // of the last complete frame
+};
+
+/**
+ * Attributes heap memory (global operator new, which the EASTL allocation hooks forward to) to the MemoryTag that is
+ * current on the allocating thread. The allocation functions are replaced with the USE_ALLOCATION_TRACKING option,
+ * otherwise all stats stay 0.
+ *
+ * Every allocation carries a small header with its tag, size and call site, so a free is attributed to the tag of
+ * the allocation regardless of the thread and tag that release it. A call site is the return address of operator new
+ * together with the MemoryTagScope that was current, the leak report groups the memory still alive by call site.
+ */
+class AllocationTracker {
+  public:
+  static constexpr bool s_isEnabled() {
+#ifdef ARISE_USE_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // call sites beyond the table are counted in kOtherCallSite
+  static constexpr uint32_t kMaxCallSites  = 1024;
+  static constexpr uint32_t kOtherCallSite = 0;
+
+  static MemoryTag s_getCurrentTag() noexcept { return s_currentTag; }
+
+  static void s_setCurrentTag(MemoryTag tag) noexcept { s_currentTag = tag; }
+
+  // function of the innermost MemoryTagScope of the calling thread, nullptr outside of scopes
+  static const char* s_getCurrentScope() noexcept { return s_currentScope; }
+
+  static void s_setCurrentScope(const char* scope) noexcept { s_currentScope = scope; }
+
+  // index of the call site (returnAddress in the current scope with the given tag), registered on first use
+  static uint32_t s_getCallSite(MemoryTag tag, const void* returnAddress) noexcept;
+
+  // called by the global allocation functions
+  static void s_recordAllocation(MemoryTag tag, uint32_t callSite, uint64_t size) noexcept;
+  static void s_recordDeallocation(MemoryTag tag, uint32_t callSite, uint64_t size) noexcept;
+
+  // closes the current frame, called by the engine once per frame
+  static void s_endFrame();
+
+  static MemoryTagStats s_getStats(MemoryTag tag);
+
+  // plain text table of all tags, for the dump to file
+  static std::string s_createReport();
+
+  // logs the tags with memory that is still allocated and their call sites, called at shutdown after the engine
+  // services are released
+  static void s_reportLeaks();
+
+  private:
+  struct TagCounters {
+    std::atomic<uint64_t> liveBytes{0};
+    std::atomic<uint64_t> peakBytes{0};
+    std::atomic<uint64_t> liveAllocations{0};
+    std::atomic<uint64_t> totalAllocations{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+
+    uint64_t frameStartAllocations = 0;
+    uint64_t frameStartBytes       = 0;
+    uint64_t frameAllocations      = 0;
+    uint64_t frameAllocatedBytes   = 0;
+  };
+
+  struct CallSite {
+    static constexpr uint32_t kEmpty    = 0;
+    static constexpr uint32_t kClaiming = 1;
+    static constexpr uint32_t kReady    = 2;
+
+    std::atomic<uint32_t> state{kEmpty};  // key fields are written once, before state becomes kReady
+    MemoryTag             tag           = MemoryTag::Untagged;
+    const char*           scope         = nullptr;
+    const void*           returnAddress = nullptr;
+
+    std::atomic<uint64_t> liveBytes{0};
+    std::atomic<uint64_t> liveAllocations{0};
+  };
+
+  // constant-initialized, allocations may happen before any dynamic initialization
+  static std::array<TagCounters, static_cast<size_t>(MemoryTag::Count)> s_counters;
+  static std::array<CallSite, kMaxCallSites>                            s_callSites;
+
+  static inline thread_local MemoryTag   s_currentTag   = MemoryTag::Untagged;
+  static inline thread_local const char* s_currentScope = nullptr;
+};
+
+/**
+ * Sets the memory tag of the calling thread for its lifetime, scopes nest.
+ * The function that opens the scope names the call sites of the allocations within it.
+ */
+class MemoryTagScope {
+  public:
+  explicit MemoryTagScope(MemoryTag tag, const std::source_location& location = std::source_location::current())
+      : m_previousTag_(AllocationTracker::s_getCurrentTag())
+      , m_previousScope_(AllocationTracker::s_getCurrentScope()) {
+    AllocationTracker::s_setCurrentTag(tag);
+    AllocationTracker::s_setCurrentScope(location.function_name());
+  }
+
+  ~MemoryTagScope() {
+    AllocationTracker::s_setCurrentTag(m_previousTag_);
+    AllocationTracker::s_setCurrentScope(m_previousScope_);
+  }
+
+  MemoryTagScope(const MemoryTagScope&)            = delete;
+  MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+  private:
+  MemoryTag   m_previousTag_;
+  const char* m_previousScope_;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_ALLOCATION_TRACKER_H
@@ -0,0 +1,172 @@
+// replacements of the global allocation functions for HeapAllocationCounter and AllocationTracker
+
+#if defined(ARISE_USE_HEAP_ALLOCATION_COUNTING) || defined(ARISE_USE_ALLOCATION_TRACKING)
+
+#include "utils/memory/allocation_tracker.h"
+#include "utils/memory/heap_allocation_counter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define ARISE_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define ARISE_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+namespace {
+
+constexpr std::size_t kDefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+#ifdef ARISE_USE_ALLOCATION_TRACKING
+
+// precedes the returned memory, offset is the distance from the start of the system allocation
+struct alignas(kDefaultAlignment) AllocationHeader {
+  std::size_t      size;
+  uint32_t         offset;
+  uint16_t         callSite;
+  arise::MemoryTag tag;
+};
+
+static_assert(arise::AllocationTracker::kMaxCallSites <= UINT16_MAX, "call site index doesn't fit the header");
+
+#endif
+
+// every form of new and delete goes through the same system allocate / free pair, so mismatched forms stay valid.
+// caller is the return address of operator new (the call site of the allocation)
+void* hookedAllocate(std::size_t size, std::size_t alignment, const void* caller) {
+  if constexpr (arise::HeapAllocationCounter::s_isEnabled()) {
+    arise::HeapAllocationCounter::s_recordAllocation(size);
+  }
+
+#ifdef ARISE_USE_ALLOCATION_TRACKING
+  const std::size_t offset         = std::max(sizeof(AllocationHeader), alignment);
+  const std::size_t blockAlignment = std::max(alignment, kDefaultAlignment);
+
+  auto block = static_cast<std::byte*>(arise::HeapAllocationCounter::s_systemAllocate(offset + size, blockAlignment));
+  if (!block) {
+    return nullptr;
+  }
+
+  std::byte* memory = block + offset;
+  auto       header = reinterpret_cast<AllocationHeader*>(memory) - 1;
+  header->size      = size;
+  header->offset    = static_cast<uint32_t>(offset);
+  header->tag       = arise::AllocationTracker::s_getCurrentTag();
+  header->callSite  = static_cast<uint16_t>(arise::AllocationTracker::s_getCallSite(header->tag, caller));
+  arise::AllocationTracker::s_recordAllocation(header->tag, header->callSite, size);
+  return memory;
+#else
+  (void)caller;
+  return arise::HeapAllocationCounter::s_systemAllocate(size, alignment);
+#endif
+}
+
+void hookedFree(void* memory) noexcept {
+  if (!memory) {
+    return;
+  }
+
+#ifdef ARISE_USE_ALLOCATION_TRACKING
+  auto header = static_cast<AllocationHeader*>(memory) - 1;
+  arise::AllocationTracker::s_recordDeallocation(header->tag, header->callSite, header->size);
+  arise::HeapAllocationCounter::s_systemFree(static_cast<std::byte*>(memory) - header->offset);
+#else
+  arise::HeapAllocationCounter::s_systemFree(memory);
+#endif
+}
+
+void* allocateOrThrow(std::size_t size, std::size_t alignment, const void* caller) {
+  void* memory = hookedAllocate(size, alignment, caller);
+  if (!memory) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return allocateOrThrow(size, kDefaultAlignment, ARISE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size) {
+  return allocateOrThrow(size, kDefaultAlignment, ARISE_RETURN_ADDRESS());
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, static_cast<std::size_t>(alignment), ARISE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, static_cast<std::size_t>(alignment), ARISE_RETURN_ADDRESS());
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return hookedAllocate(size, kDefaultAlignment, ARISE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return hookedAllocate(size, kDefaultAlignment, ARISE_RETURN_ADDRESS());
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return hookedAllocate(size, static_cast<std::size_t>(alignment), ARISE_RETURN_ADDRESS());
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return hookedAllocate(size, static_cast<std::size_t>(alignment), ARISE_RETURN_ADDRESS());
+}
+
+void operator delete(void* memory) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+  hookedFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+  hookedFree(memory);
+}
+
+#endif  // ARISE_USE_HEAP_ALLOCATION_COUNTING || ARISE_USE_ALLOCATION_TRACKING
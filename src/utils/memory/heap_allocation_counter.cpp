@@ -0,0 +1,43 @@
+#include "utils/memory/heap_allocation_counter.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace arise {
+
+void HeapAllocationCounter::s_endFrame() {
+  const uint64_t allocationCount = s_allocationCount.load(std::memory_order_relaxed);
+  const uint64_t allocatedBytes  = s_allocatedBytes.load(std::memory_order_relaxed);
+
+  s_frameAllocationCount      = allocationCount - s_frameStartAllocationCount;
+  s_frameAllocatedBytes       = allocatedBytes - s_frameStartAllocatedBytes;
+  s_frameStartAllocationCount = allocationCount;
+  s_frameStartAllocatedBytes  = allocatedBytes;
+}
+
+void* HeapAllocationCounter::s_systemAllocate(size_t size, size_t alignment) noexcept {
+  size = std::max<size_t>(size, 1);
+#ifdef _WIN32
+  return _aligned_malloc(size, alignment);
+#else
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return std::malloc(size);
+  }
+  // aligned_alloc requires a multiple of the alignment
+  return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+void HeapAllocationCounter::s_systemFree(void* memory) noexcept {
+#ifdef _WIN32
+  _aligned_free(memory);
+#else
+  std::free(memory);
+#endif
+}
+
+}  // namespace arise
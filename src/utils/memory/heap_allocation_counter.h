@@ -0,0 +1,59 @@
+#ifndef ARISE_HEAP_ALLOCATION_COUNTER_H
+#define ARISE_HEAP_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace arise {
+
+/**
+ * Counts general-purpose heap allocations (global operator new) of all threads. The counting operators are compiled
+ * in with the USE_HEAP_ALLOCATION_COUNTING option (see global_allocation_hooks.cpp), otherwise the counts stay 0.
+ */
+class HeapAllocationCounter {
+  public:
+  static constexpr bool s_isEnabled() {
+#ifdef ARISE_USE_HEAP_ALLOCATION_COUNTING
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  static void s_recordAllocation(uint64_t size) noexcept {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  // closes the current frame, called by the engine once per frame
+  static void s_endFrame();
+
+  // since the start
+  static uint64_t s_getAllocationCount() { return s_allocationCount.load(std::memory_order_relaxed); }
+
+  // of the last complete frame
+  static uint64_t s_getFrameAllocationCount() { return s_frameAllocationCount; }
+  static uint64_t s_getFrameAllocatedBytes() { return s_frameAllocatedBytes; }
+
+  /**
+   * System allocation behind every form of the replaced global new and delete. Memory of any alignment is released
+   * with s_systemFree, so mismatched forms (e.g. an aligned allocation of the EASTL hooks released with plain
+   * delete[]) stay valid - on Windows aligned memory can't be passed to free().
+   */
+  static void* s_systemAllocate(size_t size, size_t alignment) noexcept;
+  static void  s_systemFree(void* memory) noexcept;
+
+  private:
+  static inline std::atomic<uint64_t> s_allocationCount{0};
+  static inline std::atomic<uint64_t> s_allocatedBytes{0};
+
+  static inline uint64_t s_frameStartAllocationCount = 0;
+  static inline uint64_t s_frameStartAllocatedBytes  = 0;
+  static inline uint64_t s_frameAllocationCount      = 0;
+  static inline uint64_t s_frameAllocatedBytes       = 0;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_HEAP_ALLOCATION_COUNTER_H
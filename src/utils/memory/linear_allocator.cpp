@@ -0,0 +1,111 @@
+#include "utils/memory/linear_allocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace arise {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+LinearAllocator::LinearAllocator(size_t blockSize)
+    : m_blockSize_(std::max(blockSize, kBlockAlignment)) {}
+
+LinearAllocator::~LinearAllocator() {
+  releaseBlocks_();
+}
+
+void* LinearAllocator::allocate(size_t size, size_t alignment) {
+  assert((alignment & (alignment - 1)) == 0 && "Alignment must be a power of two");
+
+  size = std::max<size_t>(size, 1);
+
+  while (m_currentBlock_ < m_blocks_.size()) {
+    const Block&    block   = m_blocks_[m_currentBlock_];
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block.data) + m_offset_;
+    const size_t    offset  = m_offset_ + (alignUp(address, alignment) - address);
+
+    if (offset + size <= block.size) {
+      m_usedBytes_ += offset + size - m_offset_;
+      m_offset_     = offset + size;
+      m_peakBytes_  = std::max(m_peakBytes_, m_usedBytes_);
+      return block.data + offset;
+    }
+
+    // the tail of the block stays unused until the next reset
+    m_usedBytes_ += block.size - m_offset_;
+    ++m_currentBlock_;
+    m_offset_ = 0;
+  }
+
+  addBlock_(size + alignment);
+  return allocate(size, alignment);
+}
+
+void LinearAllocator::rewind(const Marker& marker) {
+  assert(marker.block <= m_currentBlock_ && marker.used <= m_usedBytes_ && "Marker is newer than the allocator");
+
+  m_currentBlock_ = marker.block;
+  m_offset_       = marker.offset;
+  m_usedBytes_    = marker.used;
+}
+
+void LinearAllocator::reset() {
+  // the peak didn't fit in one block, the next frames get a single block of that size
+  if (m_blocks_.size() > 1) {
+    const size_t blockSize = alignUp(m_peakBytes_, kBlockAlignment);
+    releaseBlocks_();
+    addBlock_(blockSize);
+  }
+
+  m_currentBlock_ = 0;
+  m_offset_       = 0;
+  m_usedBytes_    = 0;
+}
+
+size_t LinearAllocator::getCapacity() const {
+  size_t capacity = 0;
+  for (const auto& block : m_blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+void LinearAllocator::addBlock_(size_t minimumSize) {
+  Block block;
+  block.size = std::max(m_blockSize_, alignUp(minimumSize, kBlockAlignment));
+  block.data = static_cast<std::byte*>(::operator new(block.size, std::align_val_t(kBlockAlignment)));
+  m_blocks_.push_back(block);
+  ++m_blockAllocationCount_;
+}
+
+void LinearAllocator::releaseBlocks_() {
+  for (const auto& block : m_blocks_) {
+    ::operator delete(block.data, std::align_val_t(kBlockAlignment));
+  }
+  m_blocks_.clear();
+}
+
+LinearAllocator& g_getFrameAllocator() {
+  thread_local LinearAllocator allocator;
+  return allocator;
+}
+
+void* LinearEastlAllocator::allocate(size_t size, size_t alignment, size_t offset, int /*flags*/) {
+  if (offset == 0) {
+    return m_allocator_->allocate(size, alignment);
+  }
+
+  // the padding before the returned address aligns the address plus offset
+  std::byte*      memory  = static_cast<std::byte*>(m_allocator_->allocate(size + alignment, 1));
+  const uintptr_t address = reinterpret_cast<uintptr_t>(memory) + offset;
+  return memory + (alignUp(address, alignment) - address);
+}
+
+}  // namespace arise
@@ -0,0 +1,187 @@
+#ifndef ARISE_LINEAR_ALLOCATOR_H
+#define ARISE_LINEAR_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Bump allocator over a list of blocks. Memory is released all at once with reset() or rewind(), deallocation of
+ * single allocations is a no-op. reset() replaces the blocks with one block of the peak usage, so a steady workload
+ * is served from a single block without touching the heap.
+ *
+ * Not thread-safe.
+ */
+class LinearAllocator {
+  public:
+  static constexpr size_t kDefaultBlockSize = 256 * 1024;
+  static constexpr size_t kBlockAlignment   = 64;
+
+  // position to rewind to
+  struct Marker {
+    size_t block  = 0;
+    size_t offset = 0;
+    size_t used   = 0;
+  };
+
+  explicit LinearAllocator(size_t blockSize = kDefaultBlockSize);
+  ~LinearAllocator();
+
+  LinearAllocator(const LinearAllocator&)            = delete;
+  LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+  // never returns nullptr, alignment must be a power of two
+  void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  template <typename T>
+  T* allocateArray(size_t count) {
+    return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  Marker getMarker() const { return Marker{m_currentBlock_, m_offset_, m_usedBytes_}; }
+
+  // releases the allocations made after the marker
+  void rewind(const Marker& marker);
+
+  // releases all allocations
+  void reset();
+
+  size_t getUsedBytes() const { return m_usedBytes_; }
+  size_t getPeakBytes() const { return m_peakBytes_; }
+  size_t getCapacity() const;
+
+  // blocks allocated from the heap since the start
+  uint64_t getBlockAllocationCount() const { return m_blockAllocationCount_; }
+
+  private:
+  struct Block {
+    std::byte* data = nullptr;
+    size_t     size = 0;
+  };
+
+  void addBlock_(size_t minimumSize);
+
+  void releaseBlocks_();
+
+  std::vector<Block> m_blocks_;
+  size_t             m_blockSize_;
+  size_t             m_currentBlock_         = 0;
+  size_t             m_offset_               = 0;  // in the current block
+  size_t             m_usedBytes_            = 0;  // including the alignment padding and the unused block tails
+  size_t             m_peakBytes_            = 0;
+  uint64_t           m_blockAllocationCount_ = 0;
+};
+
+// linear allocator of the calling thread. On the main thread the engine resets it at the start of every frame, on
+// other threads allocations are released with LinearAllocatorScope
+LinearAllocator& g_getFrameAllocator();
+
+// rewinds a linear allocator to its position at construction
+class LinearAllocatorScope {
+  public:
+  explicit LinearAllocatorScope(LinearAllocator& allocator = g_getFrameAllocator())
+      : m_allocator_(allocator)
+      , m_marker_(allocator.getMarker()) {}
+
+  ~LinearAllocatorScope() { m_allocator_.rewind(m_marker_); }
+
+  LinearAllocatorScope(const LinearAllocatorScope&)            = delete;
+  LinearAllocatorScope& operator=(const LinearAllocatorScope&) = delete;
+
+  private:
+  LinearAllocator&        m_allocator_;
+  LinearAllocator::Marker m_marker_;
+};
+
+/**
+ * std allocator over a LinearAllocator (the frame allocator of the calling thread by default). deallocate() is a
+ * no-op, so a container must not outlive the reset of its allocator.
+ */
+template <typename T>
+class LinearStdAllocator {
+  public:
+  using value_type = T;
+
+  LinearStdAllocator() noexcept
+      : m_allocator_(&g_getFrameAllocator()) {}
+
+  explicit LinearStdAllocator(LinearAllocator& allocator) noexcept
+      : m_allocator_(&allocator) {}
+
+  template <typename U>
+  LinearStdAllocator(const LinearStdAllocator<U>& other) noexcept
+      : m_allocator_(other.getAllocator()) {}
+
+  T* allocate(size_t count) { return m_allocator_->allocateArray<T>(count); }
+
+  void deallocate(T*, size_t) noexcept {}
+
+  LinearAllocator* getAllocator() const noexcept { return m_allocator_; }
+
+  template <typename U>
+  bool operator==(const LinearStdAllocator<U>& other) const noexcept {
+    return m_allocator_ == other.getAllocator();
+  }
+
+  private:
+  LinearAllocator* m_allocator_;
+};
+
+// containers for transient data of the current frame
+template <typename T>
+using FrameVector = std::vector<T, LinearStdAllocator<T>>;
+
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using FrameUnorderedSet = std::unordered_set<Key, Hash, KeyEqual, LinearStdAllocator<Key>>;
+
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using FrameUnorderedMap = std::unordered_map<Key, T, Hash, KeyEqual, LinearStdAllocator<std::pair<const Key, T>>>;
+
+/**
+ * EASTL allocator over a LinearAllocator (the frame allocator of the calling thread by default), e.g.
+ * eastl::vector<T, LinearEastlAllocator>. The same lifetime rules as for LinearStdAllocator apply.
+ */
+class LinearEastlAllocator {
+  public:
+  explicit LinearEastlAllocator(const char* name = "LinearEastlAllocator")
+      : m_allocator_(&g_getFrameAllocator())
+      , m_name_(name) {}
+
+  LinearEastlAllocator(LinearAllocator& allocator, const char* name = "LinearEastlAllocator")
+      : m_allocator_(&allocator)
+      , m_name_(name) {}
+
+  LinearEastlAllocator(const LinearEastlAllocator& other, const char* name)
+      : m_allocator_(other.m_allocator_)
+      , m_name_(name) {}
+
+  void* allocate(size_t size, int /*flags*/ = 0) { return m_allocator_->allocate(size); }
+
+  // the returned address plus offset is aligned
+  void* allocate(size_t size, size_t alignment, size_t offset, int /*flags*/ = 0);
+
+  void deallocate(void*, size_t) {}
+
+  const char* get_name() const { return m_name_; }
+
+  void set_name(const char* name) { m_name_ = name; }
+
+  friend bool operator==(const LinearEastlAllocator& lhs, const LinearEastlAllocator& rhs) {
+    return lhs.m_allocator_ == rhs.m_allocator_;
+  }
+
+  friend bool operator!=(const LinearEastlAllocator& lhs, const LinearEastlAllocator& rhs) { return !(lhs == rhs); }
+
+  private:
+  LinearAllocator* m_allocator_;
+  const char*      m_name_;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_LINEAR_ALLOCATOR_H
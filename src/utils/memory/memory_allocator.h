@@ -8,7 +8,9 @@
 // These overloads are defined globally to handle EASTL's custom memory
 // allocation requirements. They are currently implemented to mirror the
 // behavior of the standard global operator new[], but can be modified for
-// custom allocation strategies or debugging purposes.
+// custom allocation strategies or debugging purposes. Forwarding to the global
+// operators keeps EASTL containers visible to HeapAllocationCounter and
+// AllocationTracker.
 
 inline void* operator new[](std::size_t size,
                             const char* /*name*/,
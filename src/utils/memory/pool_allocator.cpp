@@ -0,0 +1,61 @@
+#include "utils/memory/pool_allocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace arise {
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blockAlignment, size_t blocksPerChunk)
+    : m_blockAlignment_(std::max(blockAlignment, alignof(FreeBlock)))
+    , m_blocksPerChunk_(std::max<size_t>(blocksPerChunk, 1)) {
+  assert((blockAlignment & (blockAlignment - 1)) == 0 && "Alignment must be a power of two");
+
+  // a free block holds the free list link, every block of a chunk stays aligned
+  blockSize    = std::max(blockSize, sizeof(FreeBlock));
+  m_blockSize_ = (blockSize + m_blockAlignment_ - 1) & ~(m_blockAlignment_ - 1);
+}
+
+PoolAllocator::~PoolAllocator() {
+  assert(m_liveCount_ == 0 && "Pool destroyed with live blocks");
+
+  for (std::byte* chunk : m_chunks_) {
+    ::operator delete(chunk, std::align_val_t(m_blockAlignment_));
+  }
+}
+
+void* PoolAllocator::allocate() {
+  if (!m_freeList_) {
+    addChunk_();
+  }
+
+  FreeBlock* block = m_freeList_;
+  m_freeList_      = block->next;
+  ++m_liveCount_;
+  return block;
+}
+
+void PoolAllocator::deallocate(void* block) {
+  if (!block) {
+    return;
+  }
+
+  auto freeBlock  = static_cast<FreeBlock*>(block);
+  freeBlock->next = m_freeList_;
+  m_freeList_     = freeBlock;
+  --m_liveCount_;
+}
+
+void PoolAllocator::addChunk_() {
+  auto chunk
+      = static_cast<std::byte*>(::operator new(m_blockSize_ * m_blocksPerChunk_, std::align_val_t(m_blockAlignment_)));
+  m_chunks_.push_back(chunk);
+
+  // linked in address order, so the first allocations are contiguous
+  for (size_t i = m_blocksPerChunk_; i > 0; --i) {
+    auto block  = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_blockSize_);
+    block->next = m_freeList_;
+    m_freeList_ = block;
+  }
+}
+
+}  // namespace arise
@@ -0,0 +1,103 @@
+#ifndef ARISE_POOL_ALLOCATOR_H
+#define ARISE_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Fixed-size block allocator for recurring small objects (e.g. container nodes). Blocks are carved from chunks of
+ * blocksPerChunk blocks and recycled through a free list, chunks are released with the pool only.
+ *
+ * Not thread-safe.
+ */
+class PoolAllocator {
+  public:
+  static constexpr size_t kDefaultBlocksPerChunk = 256;
+
+  PoolAllocator(size_t blockSize,
+                size_t blockAlignment = alignof(std::max_align_t),
+                size_t blocksPerChunk = kDefaultBlocksPerChunk);
+  ~PoolAllocator();
+
+  PoolAllocator(const PoolAllocator&)            = delete;
+  PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+  // never returns nullptr
+  void* allocate();
+
+  // the block must come from this pool
+  void deallocate(void* block);
+
+  // whether objects of the size and alignment fit in a block
+  bool fits(size_t size, size_t alignment) const { return size <= m_blockSize_ && alignment <= m_blockAlignment_; }
+
+  size_t getBlockSize() const { return m_blockSize_; }
+  size_t getLiveCount() const { return m_liveCount_; }
+  size_t getCapacity() const { return m_chunks_.size() * m_blocksPerChunk_; }
+
+  private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  void addChunk_();
+
+  std::vector<std::byte*> m_chunks_;
+  FreeBlock*              m_freeList_ = nullptr;
+  size_t                  m_blockSize_;
+  size_t                  m_blockAlignment_;
+  size_t                  m_blocksPerChunk_;
+  size_t                  m_liveCount_ = 0;
+};
+
+/**
+ * std allocator that takes single objects (e.g. the nodes of a map or list) from a PoolAllocator, arrays and objects
+ * that don't fit in a block come from the heap. The pool must outlive the container.
+ */
+template <typename T>
+class PoolStdAllocator {
+  public:
+  using value_type = T;
+
+  explicit PoolStdAllocator(PoolAllocator& pool) noexcept
+      : m_pool_(&pool) {}
+
+  template <typename U>
+  PoolStdAllocator(const PoolStdAllocator<U>& other) noexcept
+      : m_pool_(other.getPool()) {}
+
+  T* allocate(size_t count) {
+    if (usesPool_(count)) {
+      return static_cast<T*>(m_pool_->allocate());
+    }
+    return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+  }
+
+  void deallocate(T* object, size_t count) noexcept {
+    if (usesPool_(count)) {
+      m_pool_->deallocate(object);
+    } else {
+      ::operator delete(object, std::align_val_t(alignof(T)));
+    }
+  }
+
+  PoolAllocator* getPool() const noexcept { return m_pool_; }
+
+  template <typename U>
+  bool operator==(const PoolStdAllocator<U>& other) const noexcept {
+    return m_pool_ == other.getPool();
+  }
+
+  private:
+  bool usesPool_(size_t count) const { return count == 1 && m_pool_->fits(sizeof(T), alignof(T)); }
+
+  PoolAllocator* m_pool_;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_POOL_ALLOCATOR_H
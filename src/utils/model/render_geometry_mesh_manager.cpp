@@ -56,6 +56,7 @@ bool RenderGeometryMeshManager::removeRenderGeometryMesh(ecs::RenderGeometryMesh
 
   LOG_INFO("Removing render geometry mesh");
 
+  // buffers can be shared with other meshes of identical content, BufferManager keeps them until the last reference
   auto bufferManager = ServiceLocator::s_get<BufferManager>();
 
   if (bufferManager) {
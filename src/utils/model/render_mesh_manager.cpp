@@ -1,6 +1,5 @@
 #include "utils/model/render_mesh_manager.h"
 
-#include "utils/buffer/buffer_manager.h"
 #include "utils/logger/log.h"
 #include "utils/material/material_manager.h"
 #include "utils/model/render_geometry_mesh_manager.h"
@@ -32,9 +31,17 @@ ecs::RenderMesh* RenderMeshManager::addRenderMesh(ecs::RenderGeometryMesh* gpuMe
     LOG_WARN("Render mesh already exists for this mesh. Overwriting.");
   }
 
-  auto renderMesh      = std::make_unique<ecs::RenderMesh>();
-  renderMesh->gpuMesh  = gpuMesh;
-  renderMesh->material = material;
+  // every render mesh holds its own reference, released in removeRenderMesh()
+  auto materialManager = ServiceLocator::s_get<MaterialManager>();
+  if (materialManager && material) {
+    materialManager->retainMaterial(material);
+  }
+
+  auto renderMesh             = std::make_unique<ecs::RenderMesh>();
+  renderMesh->gpuMesh         = gpuMesh;
+  renderMesh->material        = material;
+  renderMesh->transformMatrix = sourceMesh->transformMatrix;
+  renderMesh->sourceMesh      = sourceMesh;
 
   ecs::RenderMesh* meshPtr = renderMesh.get();
 
@@ -64,7 +71,6 @@ bool RenderMeshManager::removeRenderMesh(ecs::RenderMesh* renderMesh) {
   LOG_INFO("Removing render mesh");
 
   auto renderGeometryMeshManager = ServiceLocator::s_get<RenderGeometryMeshManager>();
-  auto bufferManager             = ServiceLocator::s_get<BufferManager>();
   auto materialManager           = ServiceLocator::s_get<MaterialManager>();
 
   if (renderGeometryMeshManager && renderMesh->gpuMesh) {
@@ -75,10 +81,6 @@ bool RenderMeshManager::removeRenderMesh(ecs::RenderMesh* renderMesh) {
     materialManager->removeMaterial(renderMesh->material);
   }
 
-  if (bufferManager && renderMesh->transformMatrixBuffer) {
-    bufferManager->removeBuffer(renderMesh->transformMatrixBuffer);
-  }
-
   std::lock_guard<std::mutex> lock(m_mutex);
 
   ecs::Mesh* sourceMesh = nullptr;
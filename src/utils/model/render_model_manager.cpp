@@ -11,7 +11,7 @@ RenderModelManager::~RenderModelManager() {
   if (!renderModelCache_.empty()) {
     LOG_INFO("RenderModelManager destroyed, releasing {} render models", renderModelCache_.size());
 
-    for (const auto& [path, renderModel] : renderModelCache_) {
+    for (const auto& [path, handle] : renderModelCache_) {
       LOG_INFO("Released render model: {}", path.string());
     }
   }
@@ -32,7 +32,7 @@ ecs::RenderModel* RenderModelManager::getRenderModel(const std::filesystem::path
           *outModel = nullptr;
         }
       }
-      return it->second.get();
+      return renderModelPool_.get(it->second);
     }
   }
 
@@ -51,9 +51,16 @@ ecs::RenderModel* RenderModelManager::getRenderModel(const std::filesystem::path
 
       auto it = renderModelCache_.find(filepath);
       if (it != renderModelCache_.end()) {
-        return it->second.get();
+        return renderModelPool_.get(it->second);
       }
-      renderModelCache_[filepath] = std::move(renderModel);
+
+      const Handle<ecs::RenderModel> handle = renderModelPool_.add(std::move(renderModel));
+      if (!handle.isValid()) {
+        LOG_ERROR("Render model pool is full, cannot add: {}", filepath.string());
+        return nullptr;
+      }
+      modelPtr->handle            = handle;
+      renderModelCache_[filepath] = handle;
     }
     return modelPtr;
   }
@@ -87,17 +94,21 @@ bool RenderModelManager::removeRenderModel(ecs::RenderModel* renderModel) {
 
   std::unique_lock<std::shared_mutex> writeLock(mutex_);
 
-  auto it = std::find_if(renderModelCache_.begin(), renderModelCache_.end(), [renderModel](const auto& pair) {
-    return pair.second.get() == renderModel;
-  });
-
-  if (it != renderModelCache_.end()) {
-    renderModelCache_.erase(it);
-    return true;
+  // a stale handle means the model was already removed (or never belonged to this manager)
+  const Handle<ecs::RenderModel> handle = renderModel->handle;
+  if (renderModelPool_.get(handle) != renderModel) {
+    LOG_WARN("Render model not found in manager");
+    return false;
   }
 
-  LOG_WARN("Render model not found in manager");
-  return false;
+  std::erase_if(renderModelCache_, [handle](const auto& pair) { return pair.second == handle; });
+  renderModelPool_.remove(handle);
+  return true;
+}
+
+ecs::RenderModel* RenderModelManager::getRenderModel(Handle<ecs::RenderModel> handle) const {
+  std::shared_lock<std::shared_mutex> readLock(mutex_);
+  return renderModelPool_.get(handle);
 }
 
 }  // namespace arise
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef ARISE_RENDER_MODEL_MANAGER_H
 #define ARISE_RENDER_MODEL_MANAGER_H
 
+#include "utils/handle/handle_pool.h"
 #include "utils/model/render_model_loader_manager.h"
 #include "utils/service/service_locator.h"
 
@@ -22,9 +23,13 @@ class RenderModelManager {
 
   bool removeRenderModel(ecs::RenderModel* renderModel);
 
+  // nullptr if the model of the handle was removed
+  ecs::RenderModel* getRenderModel(Handle<ecs::RenderModel> handle) const;
+
   private:
-  std::unordered_map<std::filesystem::path, std::unique_ptr<ecs::RenderModel>> renderModelCache_;
-  mutable std::shared_mutex                                                    mutex_;
+  HandlePool<ecs::RenderModel>                                        renderModelPool_;
+  std::unordered_map<std::filesystem::path, Handle<ecs::RenderModel>> renderModelCache_;
+  mutable std::shared_mutex                                           mutex_;
 };
 
 }  // namespace arise
@@ -0,0 +1,141 @@
+#ifndef ARISE_CONTENT_HASH_REGISTRY_H
+#define ARISE_CONTENT_HASH_REGISTRY_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace arise {
+
+/**
+ * @brief Maps content hashes to shared resources and counts how many owners reference each of them
+ *
+ * The registry does not own the resources - the manager that created a resource keeps ownership and asks
+ * the registry on removal whether the last reference is gone. Resources that were never registered are
+ * treated as unshared, so release() reports them as free to destroy.
+ */
+template <typename T>
+class ContentHashRegistry {
+  public:
+  /**
+   * @return the resource registered under the hash (with its reference count incremented) or nullptr
+   */
+  T* acquire(uint64_t contentHash) {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    auto it = m_entries_.find(contentHash);
+    if (it == m_entries_.end()) {
+      return nullptr;
+    }
+
+    ++it->second.refCount;
+    ++m_reuseCount_;
+    return it->second.resource;
+  }
+
+  /**
+   * @return the resource registered under the hash without touching its reference count, or nullptr
+   */
+  T* find(uint64_t contentHash) const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    auto it = m_entries_.find(contentHash);
+    return it != m_entries_.end() ? it->second.resource : nullptr;
+  }
+
+  void add(uint64_t contentHash, T* resource, uint32_t initialRefCount = 1) {
+    if (!resource) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    m_entries_[contentHash]     = {resource, initialRefCount};
+    m_hashByResource_[resource] = contentHash;
+  }
+
+  /**
+   * @brief Adds a reference to an already registered resource (no-op for unregistered ones)
+   */
+  void retain(const T* resource) {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    auto hashIt = m_hashByResource_.find(resource);
+    if (hashIt != m_hashByResource_.end()) {
+      ++m_entries_[hashIt->second].refCount;
+    }
+  }
+
+  /**
+   * @return true if the caller dropped the last reference and should destroy the resource
+   */
+  bool release(const T* resource) {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    auto hashIt = m_hashByResource_.find(resource);
+    if (hashIt == m_hashByResource_.end()) {
+      return true;
+    }
+
+    auto entryIt = m_entries_.find(hashIt->second);
+    if (entryIt != m_entries_.end() && entryIt->second.refCount > 1) {
+      --entryIt->second.refCount;
+      return false;
+    }
+
+    if (entryIt != m_entries_.end()) {
+      m_entries_.erase(entryIt);
+    }
+    m_hashByResource_.erase(hashIt);
+    return true;
+  }
+
+  bool contains(uint64_t contentHash) const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_entries_.contains(contentHash);
+  }
+
+  uint32_t getRefCount(const T* resource) const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+
+    auto hashIt = m_hashByResource_.find(resource);
+    if (hashIt == m_hashByResource_.end()) {
+      return 0;
+    }
+
+    auto entryIt = m_entries_.find(hashIt->second);
+    return entryIt != m_entries_.end() ? entryIt->second.refCount : 0;
+  }
+
+  size_t getUniqueCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_entries_.size();
+  }
+
+  // Number of times an existing resource was handed out instead of creating a duplicate
+  uint64_t getReuseCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_reuseCount_;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_entries_.clear();
+    m_hashByResource_.clear();
+  }
+
+  private:
+  struct Entry {
+    T*       resource = nullptr;
+    uint32_t refCount = 0;
+  };
+
+  std::unordered_map<uint64_t, Entry>    m_entries_;
+  std::unordered_map<const T*, uint64_t> m_hashByResource_;
+  uint64_t                               m_reuseCount_ = 0;
+  mutable std::mutex                     m_mutex_;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_CONTENT_HASH_REGISTRY_H
@@ -0,0 +1,144 @@
+#include "utils/resource/resource_deletion_manager.h"
+
+#include "utils/logger/log.h"
+
+#include <algorithm>
+
+namespace arise {
+
+const char* g_getDeletionQueueName(DeletionQueue queue) {
+  switch (queue) {
+    case DeletionQueue::Buffer:
+      return "Buffer";
+    case DeletionQueue::Texture:
+      return "Texture";
+    case DeletionQueue::Framebuffer:
+      return "Framebuffer";
+    case DeletionQueue::DescriptorSet:
+      return "Descriptor set";
+    case DeletionQueue::Pipeline:
+      return "Pipeline";
+    case DeletionQueue::Handle:
+      return "Handle";
+    default:
+      return "Unknown";
+  }
+}
+
+void ResourceDeletionManager::setDefaultFrameDelay(uint32_t frameDelay) {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  m_defaultFrameDelay_ = std::clamp(frameDelay, 1u, kMaxFrameDelay);
+}
+
+void ResourceDeletionManager::setCurrentFrame(uint64_t currentFrame) {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  if (currentFrame <= m_currentFrame_) {
+    return;
+  }
+
+  // after a jump of more than kMaxFrameDelay frames every bucket is due
+  const uint64_t dueFrameCount = std::min<uint64_t>(currentFrame - m_currentFrame_, kMaxFrameDelay);
+  for (uint64_t frame = m_currentFrame_ + 1; frame <= m_currentFrame_ + dueFrameCount; ++frame) {
+    releaseBucket_(m_buckets_[frame % kMaxFrameDelay]);
+  }
+
+  m_currentFrame_ = currentFrame;
+}
+
+void ResourceDeletionManager::enqueueHandleForDeletion(uint64_t           handle,
+                                                       HandleBatchDeleter deleter,
+                                                       void*              context,
+                                                       uint32_t           frameDelay) {
+  if (!deleter) {
+    LOG_ERROR("Handle deleter is null");
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  getBucket_(frameDelay).handles.push_back(HandleDeletion{deleter, context, handle});
+  ++m_pendingCounts_[static_cast<size_t>(DeletionQueue::Handle)];
+}
+
+void ResourceDeletionManager::clearPendingDeletions() {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  // in the order they would be released
+  for (uint32_t i = 1; i <= kMaxFrameDelay; ++i) {
+    releaseBucket_(m_buckets_[(m_currentFrame_ + i) % kMaxFrameDelay]);
+  }
+}
+
+size_t ResourceDeletionManager::getPendingDeletionCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+
+  size_t count = 0;
+  for (const size_t pendingCount : m_pendingCounts_) {
+    count += pendingCount;
+  }
+  return count;
+}
+
+size_t ResourceDeletionManager::getPendingDeletionCount(DeletionQueue queue) const {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  return m_pendingCounts_[static_cast<size_t>(queue)];
+}
+
+uint64_t ResourceDeletionManager::getReleasedCount(DeletionQueue queue) const {
+  std::lock_guard<std::mutex> lock(m_mutex_);
+  return m_releasedCounts_[static_cast<size_t>(queue)];
+}
+
+ResourceDeletionManager::Bucket& ResourceDeletionManager::getBucket_(uint32_t frameDelay) {
+  if (frameDelay == 0) {
+    frameDelay = m_defaultFrameDelay_;
+  } else if (frameDelay > kMaxFrameDelay) {
+    LOG_WARN("Deletion frame delay {} exceeds the maximum of {}", frameDelay, kMaxFrameDelay);
+    frameDelay = kMaxFrameDelay;
+  }
+
+  return m_buckets_[(m_currentFrame_ + frameDelay) % kMaxFrameDelay];
+}
+
+void ResourceDeletionManager::releaseBucket_(Bucket& bucket) {
+  // users before the resources they reference
+  releaseQueue_(bucket.framebuffers);
+  releaseQueue_(bucket.descriptorSets);
+  releaseQueue_(bucket.pipelines);
+  releaseQueue_(bucket.textures);
+  releaseQueue_(bucket.buffers);
+  releaseHandles_(bucket.handles);
+}
+
+void ResourceDeletionManager::releaseHandles_(std::vector<HandleDeletion>& handles) {
+  if (handles.empty()) {
+    return;
+  }
+
+  std::sort(handles.begin(), handles.end(), [](const HandleDeletion& lhs, const HandleDeletion& rhs) {
+    if (lhs.deleter != rhs.deleter) {
+      return std::less<HandleBatchDeleter>()(lhs.deleter, rhs.deleter);
+    }
+    return std::less<void*>()(lhs.context, rhs.context);
+  });
+
+  for (size_t begin = 0; begin < handles.size();) {
+    const HandleDeletion& first = handles[begin];
+
+    m_handleBatch_.clear();
+    size_t end = begin;
+    while (end < handles.size() && handles[end].deleter == first.deleter && handles[end].context == first.context) {
+      m_handleBatch_.push_back(handles[end].handle);
+      ++end;
+    }
+
+    first.deleter(first.context, m_handleBatch_);
+    begin = end;
+  }
+
+  m_releasedCounts_[static_cast<size_t>(DeletionQueue::Handle)] += handles.size();
+  m_pendingCounts_[static_cast<size_t>(DeletionQueue::Handle)]  -= handles.size();
+  handles.clear();
+}
+
+}  // namespace arise
@@ -2,123 +2,162 @@
 #ifndef ARISE_RESOURCE_DELETION_MANAGER_H
 #define ARISE_RESOURCE_DELETION_MANAGER_H
 
-#include "utils/logger/log.h"
-
-#include <functional>
-#include <string>
+#include "gfx/rhi/interface/buffer.h"
+#include "gfx/rhi/interface/descriptor.h"
+#include "gfx/rhi/interface/framebuffer.h"
+#include "gfx/rhi/interface/pipeline.h"
+#include "gfx/rhi/interface/texture.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 namespace arise {
 
+// queues of ResourceDeletionManager, one per kind of resource
+enum class DeletionQueue : uint8_t {
+  Buffer,
+  Texture,
+  Framebuffer,
+  DescriptorSet,
+  Pipeline,
+  Handle,  // backend handles that aren't RHI objects (e.g. ImGui descriptor sets)
+  Count
+};
+
+inline constexpr size_t kDeletionQueueCount = static_cast<size_t>(DeletionQueue::Count);
+
+const char* g_getDeletionQueueName(DeletionQueue queue);
+
 /**
  * @brief Manages deferred deletion of GPU resources to ensure they are not deleted while in use
+ *
+ * @details
+ * - Enqueued resources are owned by the manager. They are kept in a ring of kMaxFrameDelay per-frame buckets with one
+ *   queue per resource type, and a bucket is released as a whole once setCurrentFrame() reaches its frame (after the
+ *   fence of that frame was waited on).
+ * - Handles are released with one deleter call per deleter and context in a bucket.
+ * - Resources may be enqueued from any thread. Resource destructors and handle deleters must not enqueue deletions.
  */
 class ResourceDeletionManager {
   public:
+  static constexpr uint32_t kMaxFrameDelay = 8;
+
+  // releases the handles of one context (e.g. vkFreeDescriptorSets from one pool)
+  using HandleBatchDeleter = void (*)(void* context, std::span<const uint64_t> handles);
+
   ResourceDeletionManager()  = default;
-  ~ResourceDeletionManager() = default;
+  ~ResourceDeletionManager() = default;  // owned RHI objects are destroyed, handle deleters aren't called
 
-  void setDefaultFrameDelay(uint32_t frameDelay) { m_defaultFrameDelay = frameDelay; }
+  // clamped to [1, kMaxFrameDelay]
+  void setDefaultFrameDelay(uint32_t frameDelay);
 
-  void setCurrentFrame(uint64_t currentFrame) {
-    m_currentFrame = currentFrame;
-    processPendingDeletions();
-  }
+  // releases the buckets of the frames up to currentFrame (monotonic frame counter)
+  void setCurrentFrame(uint64_t currentFrame);
 
+  // frameDelay 0 uses the default frame delay
   template <typename T>
-  void enqueueForDeletion(T*                      resource,
-                          std::function<void(T*)> deleter,
-                          const std::string&      resourceName,
-                          const std::string&      resourceType,
-                          uint32_t                frameDelay = 0) {
+  void enqueueForDeletion(std::unique_ptr<T> resource, uint32_t frameDelay = 0) {
     if (!resource) {
       return;
     }
 
-    if (frameDelay == 0) {
-      frameDelay = m_defaultFrameDelay;
-    }
-
-    auto deletionCallback = [deleter, resource, resourceName, resourceType]() {
-      deleter(resource);
-      LOG_INFO("{} '{}' has been deleted", resourceType, resourceName);
-    };
-
-    m_pendingDeletions.push_back({m_currentFrame + frameDelay, deletionCallback, resourceName, resourceType});
-
-    LOG_DEBUG("{} '{}' scheduled for deletion in {} frames (frame {})",
-              resourceType,
-              resourceName,
-              frameDelay,
-              m_currentFrame + frameDelay);
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    getQueue_<T>(getBucket_(frameDelay)).push_back(std::move(resource));
+    ++m_pendingCounts_[static_cast<size_t>(s_getDeletionQueue<T>())];
   }
 
-  void processPendingDeletions() {
-    if (m_pendingDeletions.empty()) {
-      return;
-    }
+  void enqueueHandleForDeletion(uint64_t handle, HandleBatchDeleter deleter, void* context, uint32_t frameDelay = 0);
 
-    size_t initialSize = m_pendingDeletions.size();
+  // releases everything now, the GPU must be idle
+  void clearPendingDeletions();
 
-    std::vector<PendingDeletion> remainingDeletions;
-    remainingDeletions.reserve(initialSize);
+  size_t getPendingDeletionCount() const;
+  size_t getPendingDeletionCount(DeletionQueue queue) const;
 
-    size_t deletionCount = 0;
+  // since the start
+  uint64_t getReleasedCount(DeletionQueue queue) const;
 
-    for (const auto& deletion : m_pendingDeletions) {
-      if (deletion.frameToDelete <= m_currentFrame) {
-        deletion.deletionCallback();
-        deletionCount++;
-      } else {
-        remainingDeletions.push_back(deletion);
-      }
+  template <typename T>
+  static constexpr DeletionQueue s_getDeletionQueue() {
+    if constexpr (std::is_base_of_v<gfx::rhi::Buffer, T>) {
+      return DeletionQueue::Buffer;
+    } else if constexpr (std::is_base_of_v<gfx::rhi::Texture, T>) {
+      return DeletionQueue::Texture;
+    } else if constexpr (std::is_base_of_v<gfx::rhi::Framebuffer, T>) {
+      return DeletionQueue::Framebuffer;
+    } else if constexpr (std::is_base_of_v<gfx::rhi::DescriptorSet, T>) {
+      return DeletionQueue::DescriptorSet;
+    } else {
+      static_assert(std::is_base_of_v<gfx::rhi::Pipeline, T>, "No deletion queue for the resource type");
+      return DeletionQueue::Pipeline;
     }
+  }
 
-    m_pendingDeletions = std::move(remainingDeletions);
+  private:
+  struct HandleDeletion {
+    HandleBatchDeleter deleter;
+    void*              context;
+    uint64_t           handle;
+  };
 
-    if (deletionCount > 0) {
-      LOG_DEBUG("Deleted {} resources, {} still pending (current frame: {})",
-                deletionCount,
-                m_pendingDeletions.size(),
-                m_currentFrame);
+  struct Bucket {
+    std::vector<std::unique_ptr<gfx::rhi::Buffer>>        buffers;
+    std::vector<std::unique_ptr<gfx::rhi::Texture>>       textures;
+    std::vector<std::unique_ptr<gfx::rhi::Framebuffer>>   framebuffers;
+    std::vector<std::unique_ptr<gfx::rhi::DescriptorSet>> descriptorSets;
+    std::vector<std::unique_ptr<gfx::rhi::Pipeline>>      pipelines;
+    std::vector<HandleDeletion>                           handles;
+  };
+
+  template <typename T>
+  static auto& getQueue_(Bucket& bucket) {
+    constexpr DeletionQueue queue = s_getDeletionQueue<T>();
+    if constexpr (queue == DeletionQueue::Buffer) {
+      return bucket.buffers;
+    } else if constexpr (queue == DeletionQueue::Texture) {
+      return bucket.textures;
+    } else if constexpr (queue == DeletionQueue::Framebuffer) {
+      return bucket.framebuffers;
+    } else if constexpr (queue == DeletionQueue::DescriptorSet) {
+      return bucket.descriptorSets;
+    } else {
+      return bucket.pipelines;
     }
   }
 
-  std::vector<std::string> getPendingResourceNames() const {
-    std::vector<std::string> pendingResourceNames;
-    pendingResourceNames.reserve(m_pendingDeletions.size());
+  // bucket of the frame the resource is released at
+  Bucket& getBucket_(uint32_t frameDelay);
 
-    for (const auto& deletion : m_pendingDeletions) {
-      pendingResourceNames.push_back(deletion.resourceType + ": " + deletion.resourceName + " (at frame "
-                                     + std::to_string(deletion.frameToDelete) + ")");
-    }
-    return pendingResourceNames;
-  }
+  // destroys the resources in the bucket, keeps the capacity of the queues
+  void releaseBucket_(Bucket& bucket);
 
-  void clearPendingDeletions(bool executeCallbacks = true) {
-    if (executeCallbacks) {
-      for (const auto& deletion : m_pendingDeletions) {
-        deletion.deletionCallback();
-      }
-    }
-    m_pendingDeletions.clear();
+  void releaseHandles_(std::vector<HandleDeletion>& handles);
+
+  template <typename T>
+  void releaseQueue_(std::vector<std::unique_ptr<T>>& queue) {
+    m_releasedCounts_[static_cast<size_t>(s_getDeletionQueue<T>())] += queue.size();
+    m_pendingCounts_[static_cast<size_t>(s_getDeletionQueue<T>())]  -= queue.size();
+    queue.clear();
   }
 
-  size_t getPendingDeletionCount() const { return m_pendingDeletions.size(); }
+  mutable std::mutex m_mutex_;
 
-  private:
-  struct PendingDeletion {
-    uint64_t              frameToDelete;
-    std::function<void()> deletionCallback;
-    std::string           resourceName;
-    std::string           resourceType;
-  };
+  // frame f is released from m_buckets_[f % kMaxFrameDelay]
+  std::array<Bucket, kMaxFrameDelay> m_buckets_;
+  std::vector<uint64_t>              m_handleBatch_;
+
+  std::array<size_t, kDeletionQueueCount>   m_pendingCounts_{};
+  std::array<uint64_t, kDeletionQueueCount> m_releasedCounts_{};
 
-  std::vector<PendingDeletion> m_pendingDeletions;
-  uint64_t                     m_currentFrame      = 0;
-  uint32_t                     m_defaultFrameDelay = 2;
+  uint64_t m_currentFrame_      = 0;
+  uint32_t m_defaultFrameDelay_ = 2;
 };
 
 }  // namespace arise
 
-#endif  // ARISE_RESOURCE_DELETION_MANAGER_H
\ No newline at end of file
+#endif  // ARISE_RESOURCE_DELETION_MANAGER_H
@@ -0,0 +1,103 @@
+#ifndef ARISE_RADIX_SORT_H
+#define ARISE_RADIX_SORT_H
+
+#include "utils/thread/worker_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Stable LSD radix sort on a 64-bit key (8 passes of 8 bits).
+ *
+ * Passes whose digit is identical for every element are skipped. Inputs larger than kParallelThreshold
+ * are split into chunks - per-chunk histograms and scatters run on the WorkerPool, the prefix sum over
+ * (digit, chunk) keeps the result stable.
+ *
+ * @param items   elements to sort in place
+ * @param scratch temporary storage, resized to items.size() (keep it around to avoid reallocations)
+ * @param getKey  callable returning uint64_t sort key for an element
+ */
+template <typename T, typename KeyFunc>
+void radixSort64(std::vector<T>& items, std::vector<T>& scratch, KeyFunc&& getKey) {
+  constexpr size_t kRadixBits          = 8;
+  constexpr size_t kRadixSize          = 1 << kRadixBits;
+  constexpr size_t kPassCount          = sizeof(uint64_t) * 8 / kRadixBits;
+  constexpr size_t kParallelThreshold  = 16 * 1024;
+  constexpr size_t kMinElementsInChunk = 4 * 1024;
+
+  const size_t count = items.size();
+  if (count < 2) {
+    return;
+  }
+
+  scratch.resize(count);
+
+  size_t chunkCount = 1;
+  if (count >= kParallelThreshold) {
+    chunkCount = std::clamp<size_t>(count / kMinElementsInChunk, 1, WorkerPool::s_get().getConcurrency());
+  }
+  const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+  auto runChunks = [&](auto&& chunkFunc) {
+    WorkerPool::s_get().parallelFor(chunkCount, [&](size_t chunk) {
+      chunkFunc(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+    });
+  };
+
+  // bits that differ between keys - passes over constant digits are skipped
+  const uint64_t firstKey = getKey(items[0]);
+  uint64_t       diffMask = 0;
+  for (size_t i = 1; i < count; ++i) {
+    diffMask |= getKey(items[i]) ^ firstKey;
+  }
+
+  std::vector<std::array<size_t, kRadixSize>> offsets(chunkCount);
+
+  T* source      = items.data();
+  T* destination = scratch.data();
+
+  for (size_t pass = 0; pass < kPassCount; ++pass) {
+    const size_t shift = pass * kRadixBits;
+    if (((diffMask >> shift) & (kRadixSize - 1)) == 0) {
+      continue;
+    }
+
+    runChunks([&](size_t chunk, size_t begin, size_t end) {
+      auto& histogram = offsets[chunk];
+      histogram.fill(0);
+      for (size_t i = begin; i < end; ++i) {
+        ++histogram[(getKey(source[i]) >> shift) & (kRadixSize - 1)];
+      }
+    });
+
+    size_t offset = 0;
+    for (size_t digit = 0; digit < kRadixSize; ++digit) {
+      for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const size_t digitCount = offsets[chunk][digit];
+        offsets[chunk][digit]   = offset;
+        offset                 += digitCount;
+      }
+    }
+
+    runChunks([&](size_t chunk, size_t begin, size_t end) {
+      auto& chunkOffsets = offsets[chunk];
+      for (size_t i = begin; i < end; ++i) {
+        destination[chunkOffsets[(getKey(source[i]) >> shift) & (kRadixSize - 1)]++] = std::move(source[i]);
+      }
+    });
+
+    std::swap(source, destination);
+  }
+
+  if (source != items.data()) {
+    items.swap(scratch);
+  }
+}
+
+}  // namespace arise
+
+#endif  // ARISE_RADIX_SORT_H
@@ -0,0 +1,63 @@
+#include "utils/string_id/string_id.h"
+
+#include "utils/logger/log.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace arise {
+
+namespace {
+
+struct InternTable {
+  std::mutex                                mutex;
+  std::unordered_map<uint64_t, std::string> names;
+};
+
+InternTable& getInternTable() {
+  static InternTable table;
+  return table;
+}
+
+}  // namespace
+
+StringId StringId::s_intern(std::string_view name) {
+  const uint64_t hash = s_hash(name);
+  s_recordName_(hash, name);
+  return s_fromHash(hash);
+}
+
+void StringId::s_recordName_(uint64_t hash, std::string_view name) {
+  if (hash == 0) {
+    return;
+  }
+
+  InternTable&                table = getInternTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+
+  auto [it, inserted] = table.names.try_emplace(hash, name);
+  if (!inserted && it->second != name) {
+    LOG_ERROR("StringId collision: '{}' and '{}' have the same hash {:#x}", it->second, name, hash);
+  }
+}
+
+std::string_view StringId::getName() const {
+  InternTable&                table = getInternTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+
+  // the names are never removed, so the view stays valid
+  auto it = table.names.find(m_hash_);
+  return it != table.names.end() ? std::string_view(it->second) : std::string_view();
+}
+
+std::string StringId::toString() const {
+  const std::string_view name = getName();
+  if (!name.empty()) {
+    return std::string(name);
+  }
+  return fmt::format("#{:016x}", m_hash_);
+}
+
+}  // namespace arise
@@ -0,0 +1,109 @@
+#ifndef ARISE_STRING_ID_H
+#define ARISE_STRING_ID_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace arise {
+
+/**
+ * 64-bit FNV-1a hash of a name, used as a cache key instead of the string. Literals ("name"_sid) are hashed at compile
+ * time, other strings on construction without any allocation. The empty string is the invalid id.
+ *
+ * Names are kept in a global intern table for debugging: s_intern() always records the name, constructions from
+ * runtime strings only in debug builds. Ids that are never interned are printed as their hash.
+ */
+class StringId {
+  public:
+  constexpr StringId() = default;
+
+  constexpr StringId(std::string_view name)
+      : m_hash_(s_hash(name)) {
+#ifndef NDEBUG
+    if (!std::is_constant_evaluated()) {
+      s_recordName_(m_hash_, name);
+    }
+#endif
+  }
+
+  constexpr StringId(const char* name)
+      : StringId(std::string_view(name)) {}
+
+  constexpr StringId(const std::string& name)
+      : StringId(std::string_view(name)) {}
+
+  static constexpr StringId s_fromHash(uint64_t hash) {
+    StringId id;
+    id.m_hash_ = hash;
+    return id;
+  }
+
+  // records the name for getName(), e.g. for names that are shown in the editor
+  static StringId s_intern(std::string_view name);
+
+  static constexpr uint64_t s_hash(std::string_view name) {
+    if (name.empty()) {
+      return 0;
+    }
+
+    uint64_t hash = kOffsetBasis;
+    for (char c : name) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= kPrime;
+    }
+    // 0 is reserved for the invalid id
+    return hash ? hash : 1;
+  }
+
+  // id of the pair, e.g. a name combined with an object address
+  // ("instance_buffer"_sid.combine(reinterpret_cast<uintptr_t>(model)))
+  constexpr StringId combine(uint64_t value) const {
+    uint64_t hash = m_hash_ ? m_hash_ : kOffsetBasis;
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (i * 8)) & 0xff;
+      hash *= kPrime;
+    }
+    return s_fromHash(hash ? hash : 1);
+  }
+
+  constexpr StringId combine(StringId other) const { return combine(other.m_hash_); }
+
+  constexpr uint64_t getHash() const { return m_hash_; }
+
+  constexpr bool isValid() const { return m_hash_ != 0; }
+
+  // interned name, empty if the id was never interned
+  std::string_view getName() const;
+
+  // the interned name or the hash in hex
+  std::string toString() const;
+
+  constexpr bool operator==(const StringId&) const  = default;
+  constexpr auto operator<=>(const StringId&) const = default;
+
+  private:
+  static constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+  static constexpr uint64_t kPrime       = 1099511628211ull;
+
+  static void s_recordName_(uint64_t hash, std::string_view name);
+
+  uint64_t m_hash_ = 0;
+};
+
+consteval StringId operator""_sid(const char* name, size_t length) {
+  return StringId::s_fromHash(StringId::s_hash(std::string_view(name, length)));
+}
+
+}  // namespace arise
+
+template <>
+struct std::hash<arise::StringId> {
+  size_t operator()(arise::StringId id) const noexcept { return static_cast<size_t>(id.getHash()); }
+};
+
+#endif  // ARISE_STRING_ID_H
@@ -0,0 +1,235 @@
+#ifndef ARISE_STRING_ID_MAP_H
+#define ARISE_STRING_ID_MAP_H
+
+#include "utils/string_id/string_id.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Open addressing hash map keyed by StringId. Entries are stored inline in one array (no node allocations) and
+ * probed linearly, the id is already a hash and only gets mixed into the slot index.
+ *
+ * Erased slots become tombstones, so erasing while iterating is valid. Insertions may move the entries, pointers and
+ * iterators into the map are invalidated by operator[].
+ */
+template <typename T>
+class StringIdMap {
+  public:
+  struct Entry {
+    StringId key;
+    T        value;
+  };
+
+  template <bool Const>
+  class Iterator {
+    public:
+    using MapType   = std::conditional_t<Const, const StringIdMap, StringIdMap>;
+    using EntryType = std::conditional_t<Const, const Entry, Entry>;
+
+    Iterator(MapType* map, size_t index)
+        : m_map_(map)
+        , m_index_(index) {
+      skipFree_();
+    }
+
+    EntryType& operator*() const { return m_map_->m_entries_[m_index_]; }
+
+    EntryType* operator->() const { return &m_map_->m_entries_[m_index_]; }
+
+    Iterator& operator++() {
+      ++m_index_;
+      skipFree_();
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const { return m_index_ == other.m_index_; }
+
+    size_t getIndex() const { return m_index_; }
+
+    private:
+    void skipFree_() {
+      while (m_index_ < m_map_->m_states_.size() && m_map_->m_states_[m_index_] != SlotState::Occupied) {
+        ++m_index_;
+      }
+    }
+
+    MapType* m_map_;
+    size_t   m_index_;
+  };
+
+  using iterator       = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  T* find(StringId key) {
+    const size_t index = findIndex_(key);
+    return index != kNotFound ? &m_entries_[index].value : nullptr;
+  }
+
+  const T* find(StringId key) const {
+    const size_t index = findIndex_(key);
+    return index != kNotFound ? &m_entries_[index].value : nullptr;
+  }
+
+  bool contains(StringId key) const { return findIndex_(key) != kNotFound; }
+
+  // inserts a value-initialized entry if the key is missing
+  T& operator[](StringId key) {
+    if ((m_size_ + m_deletedCount_ + 1) * kMaxLoadDenominator > m_states_.size() * kMaxLoadNumerator) {
+      // tombstones are dropped by the rehash, the capacity only grows for live entries
+      rehash_(std::max(kMinCapacity, s_roundUpToPowerOfTwo_((m_size_ + 1) * 2)));
+    }
+
+    const size_t mask      = m_states_.size() - 1;
+    size_t       index     = s_getSlot_(key, mask);
+    size_t       tombstone = kNotFound;
+
+    while (m_states_[index] != SlotState::Empty) {
+      if (m_states_[index] == SlotState::Occupied && m_entries_[index].key == key) {
+        return m_entries_[index].value;
+      }
+      if (m_states_[index] == SlotState::Deleted && tombstone == kNotFound) {
+        tombstone = index;
+      }
+      index = (index + 1) & mask;
+    }
+
+    if (tombstone != kNotFound) {
+      index = tombstone;
+      --m_deletedCount_;
+    }
+
+    m_states_[index]        = SlotState::Occupied;
+    m_entries_[index].key   = key;
+    m_entries_[index].value = T{};
+    ++m_size_;
+    return m_entries_[index].value;
+  }
+
+  bool erase(StringId key) {
+    const size_t index = findIndex_(key);
+    if (index == kNotFound) {
+      return false;
+    }
+    eraseIndex_(index);
+    return true;
+  }
+
+  // returns the iterator to the next entry
+  iterator erase(iterator it) {
+    eraseIndex_(it.getIndex());
+    return ++it;
+  }
+
+  // keeps the capacity
+  void clear() {
+    for (size_t i = 0; i < m_states_.size(); ++i) {
+      if (m_states_[i] == SlotState::Occupied) {
+        m_entries_[i].value = T{};
+      }
+      m_states_[i] = SlotState::Empty;
+    }
+    m_size_         = 0;
+    m_deletedCount_ = 0;
+  }
+
+  size_t size() const { return m_size_; }
+
+  bool empty() const { return m_size_ == 0; }
+
+  iterator begin() { return iterator(this, 0); }
+
+  iterator end() { return iterator(this, m_states_.size()); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  const_iterator end() const { return const_iterator(this, m_states_.size()); }
+
+  private:
+  enum class SlotState : uint8_t {
+    Empty,
+    Occupied,
+    Deleted,
+  };
+
+  static constexpr size_t kNotFound           = static_cast<size_t>(-1);
+  static constexpr size_t kMinCapacity        = 16;
+  static constexpr size_t kMaxLoadNumerator   = 3;  // at most 3/4 of the slots are occupied or deleted
+  static constexpr size_t kMaxLoadDenominator = 4;
+
+  static size_t s_roundUpToPowerOfTwo_(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  static size_t s_getSlot_(StringId key, size_t mask) {
+    // Fibonacci hashing, the upper bits of the product depend on all bits of the id
+    return static_cast<size_t>((key.getHash() * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+  }
+
+  size_t findIndex_(StringId key) const {
+    if (m_size_ == 0) {
+      return kNotFound;
+    }
+
+    const size_t mask  = m_states_.size() - 1;
+    size_t       index = s_getSlot_(key, mask);
+
+    while (m_states_[index] != SlotState::Empty) {
+      if (m_states_[index] == SlotState::Occupied && m_entries_[index].key == key) {
+        return index;
+      }
+      index = (index + 1) & mask;
+    }
+    return kNotFound;
+  }
+
+  void eraseIndex_(size_t index) {
+    // the value is released right away (e.g. a resource owned through unique_ptr)
+    m_entries_[index].value = T{};
+    m_states_[index]        = SlotState::Deleted;
+    --m_size_;
+    ++m_deletedCount_;
+  }
+
+  void rehash_(size_t capacity) {
+    std::vector<Entry>     entries(capacity);
+    std::vector<SlotState> states(capacity, SlotState::Empty);
+    const size_t           mask = capacity - 1;
+
+    for (size_t i = 0; i < m_states_.size(); ++i) {
+      if (m_states_[i] != SlotState::Occupied) {
+        continue;
+      }
+
+      size_t index = s_getSlot_(m_entries_[i].key, mask);
+      while (states[index] != SlotState::Empty) {
+        index = (index + 1) & mask;
+      }
+      states[index]  = SlotState::Occupied;
+      entries[index] = std::move(m_entries_[i]);
+    }
+
+    m_entries_      = std::move(entries);
+    m_states_       = std::move(states);
+    m_deletedCount_ = 0;
+  }
+
+  std::vector<Entry>     m_entries_;
+  std::vector<SlotState> m_states_;
+  size_t                 m_size_         = 0;
+  size_t                 m_deletedCount_ = 0;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_STRING_ID_MAP_H
@@ -6,6 +6,9 @@
 #include "utils/logger/log.h"
 #include "utils/resource/resource_deletion_manager.h"
 #include "utils/service/service_locator.h"
+#include "utils/third_party/xxhash_util.h"
+
+#include <algorithm>
 
 namespace arise {
 
@@ -25,6 +28,9 @@ TextureManager::~TextureManager() {
       LOG_INFO("Released texture: {}", name);
     }
   }
+  if (!m_sharedTextures_.empty()) {
+    LOG_INFO("TextureManager destroyed, releasing {} shared textures", m_sharedTextures_.size());
+  }
   release();
 }
 
@@ -50,13 +56,18 @@ gfx::rhi::Texture* TextureManager::createTexture(Image* image, const std::string
   desc.createFlags = gfx::rhi::TextureCreateFlag::TransferDst;
   desc.debugName   = name.empty() ? "unnamed_loaded_texture" : name.c_str();
 
-  std::string textureName = name.empty() ? generateUniqueName_("Texture") : name;
+  const std::string textureName = name.empty() ? generateUniqueName_("Texture") : name;
+
+  const uint64_t contentHash = computeContentHash_(image);
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_textures.contains(textureName)) {
-    LOG_WARN("Texture with name '{}' already exists, will be replaced", textureName);
-    m_textures.erase(textureName);
+  if (auto sharedTexture = m_contentRegistry_.acquire(contentHash)) {
+    bindSharedTexture_(textureName, sharedTexture);
+    LOG_DEBUG("Reusing texture with identical content for '{}' (refs: {})",
+              textureName,
+              m_contentRegistry_.getRefCount(sharedTexture));
+    return sharedTexture;
   }
 
   auto texture = m_device->createTexture(desc);
@@ -105,7 +116,9 @@ gfx::rhi::Texture* TextureManager::createTexture(Image* image, const std::string
   }
 
   gfx::rhi::Texture* texturePtr = texture.get();
-  m_textures[textureName]       = std::move(texture);
+  m_sharedTextures_[texturePtr] = std::move(texture);
+  m_contentRegistry_.add(contentHash, texturePtr);
+  bindSharedTexture_(textureName, texturePtr);
 
   LOG_INFO("Created texture '{}' with dimensions {}x{}", textureName, desc.width, desc.height);
 
@@ -257,40 +270,23 @@ gfx::rhi::Texture* TextureManager::addTexture(std::unique_ptr<gfx::rhi::Texture>
 
 gfx::rhi::Texture* TextureManager::getTexture(const std::string& name) const {
   std::lock_guard<std::mutex> lock(m_mutex);
-
-  auto it = m_textures.find(name);
-  if (it != m_textures.end()) {
-    return it->second.get();
-  }
-
-  return nullptr;
+  return findTextureByName_(name);
 }
 
 bool TextureManager::removeTexture(const std::string& name) {
   std::lock_guard<std::mutex> lock(m_mutex);
 
+  auto sharedIt = m_sharedTextureNames_.find(name);
+  if (sharedIt != m_sharedTextureNames_.end()) {
+    releaseSharedTexture_(name, sharedIt->second.back());
+    return true;
+  }
+
   auto it = m_textures.find(name);
   if (it != m_textures.end()) {
-    auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
-    if (deletionManager) {
-      gfx::rhi::Texture* texturePtr = it->second.get();
-
-      deletionManager->enqueueForDeletion<gfx::rhi::Texture>(
-          texturePtr,
-          [this, name](gfx::rhi::Texture*) {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            LOG_INFO("Texture '{}' deleted", name);
-            m_textures.erase(name);
-          },
-          name,
-          "Texture");
-
-      return true;
-    } else {
-      LOG_INFO("Removing texture '{}'", name);
-      m_textures.erase(it);
-      return true;
-    }
+    destroyTexture_(std::move(it->second), name);
+    m_textures.erase(it);
+    return true;
   }
 
   LOG_WARN("Attempted to remove non-existent texture '{}'", name);
@@ -304,51 +300,63 @@ bool TextureManager::removeTexture(gfx::rhi::Texture* texture) {
   }
 
   std::lock_guard<std::mutex> lock(m_mutex);
-  auto                        it = findTexture_(texture);
-  if (it != m_textures.end()) {
-    std::string textureName = it->first;
-
-    auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
-    if (deletionManager) {
-      deletionManager->enqueueForDeletion<gfx::rhi::Texture>(
-          texture,
-          [this, textureName](gfx::rhi::Texture*) {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            LOG_INFO("Texture '{}' deleted", textureName);
-            m_textures.erase(textureName);
-          },
-          textureName,
-          "Texture");
-      return true;
-    } else {
-      LOG_INFO("Removing texture '{}'", textureName);
-      m_textures.erase(it);
+
+  for (const auto& [name, sharedTextures] : m_sharedTextureNames_) {
+    if (std::find(sharedTextures.begin(), sharedTextures.end(), texture) != sharedTextures.end()) {
+      // copied, the binding may be erased together with the key
+      releaseSharedTexture_(std::string(name), texture);
       return true;
     }
   }
 
+  auto it = findTexture_(texture);
+  if (it != m_textures.end()) {
+    destroyTexture_(std::move(it->second), it->first);
+    m_textures.erase(it);
+    return true;
+  }
+
   LOG_WARN("Texture not found in manager");
   return false;
 }
 
 bool TextureManager::hasTexture(const std::string& name) const {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_textures.contains(name);
+  return m_sharedTextureNames_.contains(name) || m_textures.contains(name);
 }
 
 size_t TextureManager::getTextureCount() const {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_textures.size();
+  return m_textures.size() + m_sharedTextures_.size();
 }
 
 void TextureManager::release() {
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  LOG_INFO("Releasing {} textures", m_textures.size());
+  LOG_INFO("Releasing {} textures", m_textures.size() + m_sharedTextures_.size());
 
+  m_contentRegistry_.clear();
+  m_sharedTextureNames_.clear();
+  m_sharedTextures_.clear();
   m_textures.clear();
 }
 
+uint64_t TextureManager::computeContentHash_(const Image* image) {
+  // description goes into the seed, so the same bytes interpreted with another format / size are not shared
+  const uint64_t descFields[] = {
+    image->width,
+    image->height,
+    image->depth,
+    image->mipLevels,
+    image->arraySize,
+    static_cast<uint64_t>(image->format),
+    static_cast<uint64_t>(image->dimension),
+  };
+
+  const uint64_t descSeed = XXH64Bytes(descFields, sizeof(descFields));
+  return XXH64Bytes(image->pixels, descSeed);
+}
+
 std::string TextureManager::generateUniqueName_(const std::string& prefix) {
   return prefix + "_" + std::to_string(m_textureCounter++);
 }
@@ -368,4 +376,53 @@ std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Texture>>::iterator Te
   return m_textures.end();
 }
 
+gfx::rhi::Texture* TextureManager::findTextureByName_(const std::string& name) const {
+  auto sharedIt = m_sharedTextureNames_.find(name);
+  if (sharedIt != m_sharedTextureNames_.end()) {
+    return sharedIt->second.back();
+  }
+
+  auto it = m_textures.find(name);
+  return it != m_textures.end() ? it->second.get() : nullptr;
+}
+
+void TextureManager::bindSharedTexture_(const std::string& name, gfx::rhi::Texture* texture) {
+  auto& sharedTextures = m_sharedTextureNames_[name];
+  if (!sharedTextures.empty() && sharedTextures.back() != texture) {
+    // same name but different content (e.g. equal file names in different folders) - both textures stay alive,
+    // getTexture() returns the latest one until its references under the name are gone
+    LOG_DEBUG("Texture name '{}' is bound to textures with different content", name);
+  }
+  sharedTextures.push_back(texture);
+}
+
+void TextureManager::releaseSharedTexture_(const std::string& name, gfx::rhi::Texture* texture) {
+  auto& sharedTextures = m_sharedTextureNames_[name];
+  sharedTextures.erase(std::find(sharedTextures.rbegin(), sharedTextures.rend(), texture).base() - 1);
+  if (sharedTextures.empty()) {
+    m_sharedTextureNames_.erase(name);
+  }
+
+  if (!m_contentRegistry_.release(texture)) {
+    LOG_DEBUG("Texture '{}' is still shared, dropped one reference", name);
+    return;
+  }
+
+  auto it = m_sharedTextures_.find(texture);
+  if (it != m_sharedTextures_.end()) {
+    destroyTexture_(std::move(it->second), name);
+    m_sharedTextures_.erase(it);
+  }
+}
+
+void TextureManager::destroyTexture_(std::unique_ptr<gfx::rhi::Texture> texture, const std::string& name) {
+  // frames in flight may still use the texture, it is destroyed with the frame delay of ResourceDeletionManager
+  auto deletionManager = ServiceLocator::s_get<ResourceDeletionManager>();
+  if (deletionManager) {
+    deletionManager->enqueueForDeletion(std::move(texture));
+  } else {
+    LOG_INFO("Removing texture '{}'", name);
+  }
+}
+
 }  // namespace arise
\ No newline at end of file
@@ -4,12 +4,14 @@
 #include "gfx/rhi/interface/device.h"
 #include "gfx/rhi/interface/texture.h"
 #include "resources/image.h"
+#include "utils/resource/content_hash_registry.h"
 
 #include <filesystem>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace arise {
 
@@ -19,6 +21,11 @@ class TextureManager {
 
   ~TextureManager();
 
+  /**
+   * Textures are deduplicated by the hash of the image payload and description - uploading identical
+   * content again returns the existing texture with an additional reference. Every call binds the name to the
+   * texture and the binding holds that reference, it is dropped by removeTexture() with either the name or the pointer.
+   */
   gfx::rhi::Texture* createTexture(Image* image, const std::string& name = "");
   gfx::rhi::Texture* createTextureFromFile(const std::filesystem::path& filepath, const std::string& name = "");
   gfx::rhi::Texture* createRenderTarget(uint32_t                width,
@@ -32,6 +39,7 @@ class TextureManager {
 
   gfx::rhi::Texture* addTexture(std::unique_ptr<gfx::rhi::Texture> texture, const std::string& name);
 
+  // for names bound to several shared textures the latest one is returned
   gfx::rhi::Texture* getTexture(const std::string& name) const;
 
   bool removeTexture(const std::string& name);
@@ -43,7 +51,11 @@ class TextureManager {
 
   void release();
 
+  const ContentHashRegistry<gfx::rhi::Texture>& getContentRegistry() const { return m_contentRegistry_; }
+
   private:
+  static uint64_t computeContentHash_(const Image* image);
+
   std::string generateUniqueName_(const std::string& prefix);
 
   // TODO: not used, consider remove
@@ -52,11 +64,27 @@ class TextureManager {
   std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Texture>>::iterator findTexture_(
       const gfx::rhi::Texture* texture);
 
+  gfx::rhi::Texture* findTextureByName_(const std::string& name) const;
+
+  void bindSharedTexture_(const std::string& name, gfx::rhi::Texture* texture);
+
+  // drops the binding of the name and its reference, destroys the texture with the last one
+  void releaseSharedTexture_(const std::string& name, gfx::rhi::Texture* texture);
+
+  void destroyTexture_(std::unique_ptr<gfx::rhi::Texture> texture, const std::string& name);
+
   private:
   gfx::rhi::Device*                                                   m_device;
   mutable std::mutex                                                  m_mutex;
   std::unordered_map<std::string, std::unique_ptr<gfx::rhi::Texture>> m_textures;
   uint32_t m_textureCounter;  // Counter for generating unique names
+
+  ContentHashRegistry<gfx::rhi::Texture> m_contentRegistry_;
+
+  // deduplicated textures, owned apart from m_textures since they are not tied to a single name
+  std::unordered_map<const gfx::rhi::Texture*, std::unique_ptr<gfx::rhi::Texture>> m_sharedTextures_;
+  // name -> shared textures requested under it, one entry per reference
+  std::unordered_map<std::string, std::vector<gfx::rhi::Texture*>> m_sharedTextureNames_;
 };
 
 }  // namespace arise
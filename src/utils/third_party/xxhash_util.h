@@ -3,7 +3,9 @@
 
 #include <xxhash.h>
 
+#include <cstddef>
 #include <type_traits>
+#include <vector>
 
 namespace arise {
 
@@ -14,6 +16,19 @@ uint64_t XXH64(const T& data, uint64_t seed = 0) {
   return ::XXH64(&data, sizeof(T), seed);
 }
 
+/**
+ * @brief Hashes a raw memory blob (vertex / index data, image payloads, etc.)
+ */
+inline uint64_t XXH64Bytes(const void* data, size_t size, uint64_t seed = 0) {
+  return ::XXH64(data, size, seed);
+}
+
+template <typename T>
+uint64_t XXH64Bytes(const std::vector<T>& data, uint64_t seed = 0) {
+  static_assert(std::is_trivially_copyable<T>::value, "Hashed vector elements should be trivially copyable.");
+  return ::XXH64(data.data(), data.size() * sizeof(T), seed);
+}
+
 }  // namespace arise
 
 #endif  // ARISE_THIRD_PARTY_UTIL_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "utils/thread/worker_pool.h"
+
+#include <algorithm>
+
+namespace arise {
+
+WorkerPool& WorkerPool::s_get() {
+  static WorkerPool instance;
+  return instance;
+}
+
+WorkerPool::WorkerPool() {
+  // the calling thread of a batch is the remaining one
+  const size_t workerCount = std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1;
+
+  m_workers_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    m_workers_.emplace_back(&WorkerPool::run_, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_stop_ = true;
+  }
+  m_wakeCondition_.notify_all();
+
+  for (auto& worker : m_workers_) {
+    worker.join();
+  }
+}
+
+void WorkerPool::parallelFor(size_t jobCount, const std::function<void(size_t)>& function) {
+  if (jobCount == 0) {
+    return;
+  }
+
+  if (jobCount == 1 || m_workers_.empty()) {
+    for (size_t job = 0; job < jobCount; ++job) {
+      function(job);
+    }
+    return;
+  }
+
+  Batch batch;
+  batch.function = &function;
+  batch.jobCount = jobCount;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_batches_.push_back(&batch);
+  }
+  m_wakeCondition_.notify_all();
+
+  s_runJobs_(batch);
+
+  // every job is taken at this point, wait for the workers that still run one
+  std::unique_lock<std::mutex> lock(m_mutex_);
+  auto                         it = std::find(m_batches_.begin(), m_batches_.end(), &batch);
+  if (it != m_batches_.end()) {
+    m_batches_.erase(it);
+  }
+  m_doneCondition_.wait(lock, [&batch] { return batch.activeWorkers == 0; });
+}
+
+void WorkerPool::run_() {
+  while (true) {
+    Batch* batch = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex_);
+      m_wakeCondition_.wait(lock, [this] { return m_stop_ || !m_batches_.empty(); });
+      if (m_batches_.empty()) {
+        return;
+      }
+
+      batch = m_batches_.front();
+      ++batch->activeWorkers;
+    }
+
+    s_runJobs_(*batch);
+
+    bool batchDone = false;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex_);
+      // all jobs are taken, workers that wake up later go to the next batch
+      if (!m_batches_.empty() && m_batches_.front() == batch) {
+        m_batches_.pop_front();
+      }
+      batchDone = --batch->activeWorkers == 0;
+    }
+
+    // the batch may be gone once the lock is released, only the pool is touched
+    if (batchDone) {
+      m_doneCondition_.notify_all();
+    }
+  }
+}
+
+void WorkerPool::s_runJobs_(Batch& batch) {
+  for (size_t job = batch.nextJob.fetch_add(1); job < batch.jobCount; job = batch.nextJob.fetch_add(1)) {
+    (*batch.function)(job);
+  }
+}
+
+}  // namespace arise
@@ -0,0 +1,65 @@
+#ifndef ARISE_WORKER_POOL_H
+#define ARISE_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arise {
+
+/**
+ * Process-wide set of worker threads for short data-parallel jobs within a frame (sorting, rasterization). The
+ * threads are started once on first use, so splitting work doesn't create an OS thread per job.
+ *
+ * The calling thread takes jobs of its own batch as well, so a batch always completes, even when all workers are busy
+ * or parallelFor() is called from a worker.
+ */
+class WorkerPool {
+  public:
+  static WorkerPool& s_get();
+
+  WorkerPool(const WorkerPool&)            = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // joins the workers, pending batches are finished by their callers
+  ~WorkerPool();
+
+  /**
+   * Runs function(job) for every job in [0, jobCount) and blocks until all of them are done. Jobs run concurrently
+   * in no particular order.
+   */
+  void parallelFor(size_t jobCount, const std::function<void(size_t)>& function);
+
+  // number of threads that can run jobs at the same time, including the caller
+  size_t getConcurrency() const { return m_workers_.size() + 1; }
+
+  private:
+  struct Batch {
+    const std::function<void(size_t)>* function = nullptr;
+    size_t                             jobCount = 0;
+    std::atomic<size_t>                nextJob{0};
+    size_t                             activeWorkers = 0;  // guarded by m_mutex_
+  };
+
+  WorkerPool();
+
+  void run_();
+
+  static void s_runJobs_(Batch& batch);
+
+  std::vector<std::thread> m_workers_;
+  std::deque<Batch*>       m_batches_;
+  std::mutex               m_mutex_;
+  std::condition_variable  m_wakeCondition_;
+  std::condition_variable  m_doneCondition_;
+  bool                     m_stop_ = false;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_WORKER_POOL_H
@@ -0,0 +1,387 @@
+#include "utils/time/frame_statistics.h"
+
+#include "file_loader/file_system_manager.h"
+#include "profiler/profiler.h"
+#include "utils/logger/log.h"
+#include "utils/path_manager/path_manager.h"
+#include "utils/service/service_locator.h"
+#include "utils/time/timing_manager.h"
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace arise {
+
+namespace {
+
+int64_t getMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double toMilliseconds(uint64_t microseconds) {
+  return static_cast<double>(microseconds) / 1000.0;
+}
+
+}  // namespace
+
+const char* g_getFramePhaseName(FramePhase phase) {
+  switch (phase) {
+    case FramePhase::Events:
+      return "Events";
+    case FramePhase::Update:
+      return "Update";
+    case FramePhase::RenderRecord:
+      return "Render record";
+    case FramePhase::Present:
+      return "Submit / present";
+    case FramePhase::GpuWait:
+      return "GPU wait";
+    default:
+      return "Unknown";
+  }
+}
+
+// FrameTimeHistogram
+// ----------------------------------------------------------------------------
+
+uint32_t FrameTimeHistogram::s_getBucketIndex(uint64_t value) {
+  value = std::min(value, kMaxValue);
+  if (value < kSubBucketCount) {
+    return static_cast<uint32_t>(value);
+  }
+
+  // value >> exponent keeps the kSubBucketBits significant bits, its top bit is always set
+  const uint32_t exponent = static_cast<uint32_t>(std::bit_width(value)) - kSubBucketBits;
+  const uint32_t subIndex = static_cast<uint32_t>(value >> exponent) - kHalfSubBucketCount;
+  return kSubBucketCount + (exponent - 1) * kHalfSubBucketCount + subIndex;
+}
+
+uint64_t FrameTimeHistogram::s_getBucketUpperBound(uint32_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+
+  const uint32_t exponent    = (index - kSubBucketCount) / kHalfSubBucketCount + 1;
+  const uint64_t significand = (index - kSubBucketCount) % kHalfSubBucketCount + kHalfSubBucketCount;
+  return ((significand + 1) << exponent) - 1;
+}
+
+void FrameTimeHistogram::add(uint64_t value) {
+  ++m_counts_[s_getBucketIndex(value)];
+  ++m_count_;
+}
+
+void FrameTimeHistogram::remove(uint64_t value) {
+  --m_counts_[s_getBucketIndex(value)];
+  --m_count_;
+}
+
+void FrameTimeHistogram::clear() {
+  m_counts_.fill(0);
+  m_count_ = 0;
+}
+
+uint64_t FrameTimeHistogram::getPercentile(double percentile) const {
+  if (m_count_ == 0) {
+    return 0;
+  }
+
+  const double   clamped = std::clamp(percentile, 0.0, 100.0);
+  const uint64_t target  = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * m_count_)));
+
+  uint64_t count = 0;
+  for (uint32_t i = 0; i < kBucketCount; ++i) {
+    count += m_counts_[i];
+    if (count >= target) {
+      return s_getBucketUpperBound(i);
+    }
+  }
+  return kMaxValue;
+}
+
+void FrameTimeHistogram::getDistribution(uint64_t binWidth, std::span<float> bins) const {
+  std::fill(bins.begin(), bins.end(), 0.0f);
+  if (bins.empty() || binWidth == 0) {
+    return;
+  }
+
+  // a bucket is counted in the bin of its upper bound
+  for (uint32_t i = 0; i < kBucketCount; ++i) {
+    if (m_counts_[i] > 0) {
+      const size_t bin  = std::min<uint64_t>(s_getBucketUpperBound(i) / binWidth, bins.size() - 1);
+      bins[bin]        += static_cast<float>(m_counts_[i]);
+    }
+  }
+}
+
+// FrameStatistics
+// ----------------------------------------------------------------------------
+
+FrameStatistics::FrameStatistics()
+    : m_discardFrame_(true)  // the first frame starts before the first endFrame()
+    , m_history_(kLongWindow) {
+  m_windows_[static_cast<size_t>(Window::Short)].size = kShortWindow;
+  m_windows_[static_cast<size_t>(Window::Long)].size  = kLongWindow;
+}
+
+void FrameStatistics::addPhaseTime(FramePhase phase, int64_t microseconds) {
+  m_phaseTimes_[static_cast<size_t>(phase)] += microseconds;
+}
+
+uint32_t FrameStatistics::s_getMetricValue(const FrameSample& sample, size_t metric) {
+  return metric == 0 ? sample.frameTime : sample.phaseTimes[metric - 1];
+}
+
+void FrameStatistics::endFrame(uint64_t frameTime) {
+  pollHitchWrite_();
+
+  const bool discard = m_discardFrame_;
+  m_discardFrame_    = false;
+
+  FrameSample sample;
+  sample.frameTime = static_cast<uint32_t>(std::min<uint64_t>(frameTime, UINT32_MAX));
+  for (size_t i = 0; i < kFramePhaseCount; ++i) {
+    sample.phaseTimes[i] = static_cast<uint32_t>(std::clamp<int64_t>(m_phaseTimes_[i], 0, UINT32_MAX));
+  }
+  m_phaseTimes_.fill(0);
+
+  if (discard) {
+    return;
+  }
+
+  // checked against the median before this frame is added
+  const bool isHitch = isHitch_(frameTime);
+
+  const uint64_t frame = m_frameCount_;
+  for (auto& window : m_windows_) {
+    const bool evict = frame >= window.size;
+    for (size_t metric = 0; metric < kMetricCount; ++metric) {
+      auto& state = window.metrics[metric];
+      if (evict) {
+        const uint32_t evicted = s_getMetricValue(getSample_(frame - window.size), metric);
+        state.histogram.remove(evicted);
+        state.maxDirty = state.maxDirty || evicted >= state.max;
+      }
+
+      const uint32_t value = s_getMetricValue(sample, metric);
+      state.histogram.add(value);
+      if (value >= state.max) {
+        state.max      = value;
+        state.maxDirty = false;
+      }
+    }
+  }
+
+  m_history_[frame % m_history_.size()] = sample;
+  ++m_frameCount_;
+
+  if (isHitch) {
+    ++m_hitchCount_;
+
+    const bool coolingDown = m_lastHitchFrame_ != 0 && frame - m_lastHitchFrame_ < kHitchCooldownFrames;
+    // a capture still being written isn't waited for, the hitch is only counted
+    const bool writing = m_hitchWrite_.valid();
+    if (!coolingDown && !writing && m_hitchCount_ <= kMaxHitchCaptures) {
+      m_lastHitchFrame_ = frame;
+
+      LOG_WARN("Hitch: frame {} took {:.2f} ms, writing a capture", frame, toMilliseconds(frameTime));
+      captureHitch_(frame);
+    }
+  }
+}
+
+bool FrameStatistics::isHitch_(uint64_t frameTime) const {
+  // the median isn't meaningful before the short window is full
+  if (m_frameCount_ < kShortWindow) {
+    return false;
+  }
+
+  const double frameTimeMs = toMilliseconds(frameTime);
+  const double medianMs    = toMilliseconds(getPercentile(Window::Short, 50.0));
+  return frameTimeMs >= m_hitchMinimumTime_ && frameTimeMs >= medianMs * m_hitchMedianFactor_;
+}
+
+size_t FrameStatistics::getFrameCount(Window window) const {
+  return static_cast<size_t>(m_windows_[static_cast<size_t>(window)].metrics[0].histogram.getCount());
+}
+
+uint64_t FrameStatistics::getPercentile(Window window, double percentile) const {
+  return m_windows_[static_cast<size_t>(window)].metrics[0].histogram.getPercentile(percentile);
+}
+
+uint64_t FrameStatistics::getPhasePercentile(Window window, FramePhase phase, double percentile) const {
+  const size_t metric = 1 + static_cast<size_t>(phase);
+  return m_windows_[static_cast<size_t>(window)].metrics[metric].histogram.getPercentile(percentile);
+}
+
+uint64_t FrameStatistics::getMax(Window window) const {
+  return getMax_(window, 0);
+}
+
+uint64_t FrameStatistics::getPhaseMax(Window window, FramePhase phase) const {
+  return getMax_(window, 1 + static_cast<size_t>(phase));
+}
+
+uint64_t FrameStatistics::getMax_(Window window, size_t metric) const {
+  const auto& state       = m_windows_[static_cast<size_t>(window)];
+  const auto& metricState = state.metrics[metric];
+
+  if (metricState.maxDirty) {
+    const uint64_t frameCount = std::min<uint64_t>(m_frameCount_, state.size);
+
+    metricState.max = 0;
+    for (uint64_t frame = m_frameCount_ - frameCount; frame < m_frameCount_; ++frame) {
+      metricState.max = std::max<uint64_t>(metricState.max, s_getMetricValue(getSample_(frame), metric));
+    }
+    metricState.maxDirty = false;
+  }
+
+  return metricState.max;
+}
+
+const FrameTimeHistogram& FrameStatistics::getHistogram(Window window) const {
+  return m_windows_[static_cast<size_t>(window)].metrics[0].histogram;
+}
+
+void FrameStatistics::captureHitch_(uint64_t frame) {
+  CPU_ZONE_NC("FrameStatistics::captureHitch", color::RED);
+
+  rapidjson::StringBuffer                          buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+  writer.StartObject();
+  writer.Key("frame");
+  writer.Uint64(frame);
+  writer.Key("frameTimeMs");
+  writer.Double(toMilliseconds(getSample_(frame).frameTime));
+  writer.Key("hitchMinimumTimeMs");
+  writer.Double(m_hitchMinimumTime_);
+  writer.Key("hitchMedianFactor");
+  writer.Double(m_hitchMedianFactor_);
+
+  // frame time percentiles of the short window, the hitch included
+  writer.Key("percentilesMs");
+  writer.StartObject();
+  for (const double percentile : {50.0, 95.0, 99.0}) {
+    const std::string key = "p" + std::to_string(static_cast<int>(percentile));
+    writer.Key(key.c_str());
+    writer.Double(toMilliseconds(getPercentile(Window::Short, percentile)));
+  }
+  writer.Key("max");
+  writer.Double(toMilliseconds(getMax(Window::Short)));
+  writer.EndObject();
+
+  // the frames before the hitch, oldest first
+  writer.Key("frames");
+  writer.StartArray();
+  const uint64_t frameCount = std::min<uint64_t>(m_frameCount_, kHitchCaptureFrames);
+  for (uint64_t index = m_frameCount_ - frameCount; index < m_frameCount_; ++index) {
+    const auto& sample = getSample_(index);
+
+    writer.StartObject();
+    writer.Key("frame");
+    writer.Uint64(index);
+    writer.Key("frameTimeMs");
+    writer.Double(toMilliseconds(sample.frameTime));
+    for (size_t phase = 0; phase < kFramePhaseCount; ++phase) {
+      writer.Key(g_getFramePhaseName(static_cast<FramePhase>(phase)));
+      writer.Double(toMilliseconds(sample.phaseTimes[phase]));
+    }
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  std::string trace;
+#ifdef ARISE_USE_BUILTIN_CPU_PROFILING
+  // zones of the last frames, the hitch frame was closed by PROFILE_FRAME before the timing update. The profiler
+  // keeps recording, so the trace is exported here rather than on the writing thread
+  trace = cpu::CpuProfiler::s_get().exportChromeTrace();
+#endif
+
+  // the path manager reads the config, the directory is resolved here and only the file system work is deferred
+  m_hitchWrite_ = std::async(std::launch::async,
+                             &FrameStatistics::s_writeHitchCapture_,
+                             PathManager::s_getDebugPath() / "hitches",
+                             frame,
+                             std::string(buffer.GetString()),
+                             std::move(trace));
+}
+
+void FrameStatistics::pollHitchWrite_() {
+  if (!m_hitchWrite_.valid() || m_hitchWrite_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+
+  auto capture = m_hitchWrite_.get();
+  if (!capture.empty()) {
+    m_lastHitchCapture_ = std::move(capture);
+  }
+}
+
+std::filesystem::path FrameStatistics::s_writeHitchCapture_(const std::filesystem::path& directory,
+                                                            uint64_t                     frame,
+                                                            const std::string&           capture,
+                                                            const std::string&           trace) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    LOG_ERROR("Failed to create the hitch directory {}: {}", directory.string(), error.message());
+    return {};
+  }
+
+  const auto path = directory / ("hitch_" + std::to_string(frame) + ".json");
+  if (!FileSystemManager::writeFile(path, capture)) {
+    LOG_ERROR("Failed to write the hitch capture {}", path.string());
+    return {};
+  }
+
+  if (!trace.empty()) {
+    const auto tracePath = directory / ("hitch_" + std::to_string(frame) + "_trace.json");
+    if (!FileSystemManager::writeFile(tracePath, trace)) {
+      LOG_ERROR("Failed to write the hitch trace {}", tracePath.string());
+    }
+  }
+
+  LOG_INFO("Hitch capture written to {}", path.string());
+  return path;
+}
+
+// ScopedFramePhase
+// ----------------------------------------------------------------------------
+
+ScopedFramePhase::ScopedFramePhase(FramePhase phase)
+    : m_phase_(phase)
+    , m_parentPhase_(s_activePhase) {
+  auto timingManager = ServiceLocator::s_get<TimingManager>();
+  if (!timingManager) {
+    return;
+  }
+
+  m_statistics_ = &timingManager->getFrameStatistics();
+  m_begin_      = getMicroseconds();
+  s_activePhase = phase;
+}
+
+ScopedFramePhase::~ScopedFramePhase() {
+  if (!m_statistics_) {
+    return;
+  }
+
+  const int64_t elapsed = getMicroseconds() - m_begin_;
+  m_statistics_->addPhaseTime(m_phase_, elapsed);
+  if (m_parentPhase_ != FramePhase::Count) {
+    m_statistics_->addPhaseTime(m_parentPhase_, -elapsed);
+  }
+
+  s_activePhase = m_parentPhase_;
+}
+
+}  // namespace arise
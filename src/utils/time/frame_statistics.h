@@ -0,0 +1,210 @@
+#ifndef ARISE_FRAME_STATISTICS_H
+#define ARISE_FRAME_STATISTICS_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace arise {
+
+// parts of a frame measured with ScopedFramePhase, a phase excludes the phases nested in it
+enum class FramePhase : uint8_t {
+  Events,        // window and input events
+  Update,        // input processing and the game / editor update
+  RenderRecord,  // scene and editor command recording
+  Present,       // command buffer submission and present
+  GpuWait,       // CPU blocked on the frame fence - stands in for the GPU time (the RHI has no timestamp queries)
+  Count
+};
+
+inline constexpr size_t kFramePhaseCount = static_cast<size_t>(FramePhase::Count);
+
+const char* g_getFramePhaseName(FramePhase phase);
+
+/**
+ * Fixed-memory log-linear histogram (HDR style) of durations in microseconds. Values below kSubBucketCount are
+ * counted exactly, larger ones with kSubBucketBits significant bits (less than 1% error), values above kMaxValue are
+ * clamped.
+ */
+class FrameTimeHistogram {
+  public:
+  static constexpr uint32_t kSubBucketBits      = 8;
+  static constexpr uint32_t kSubBucketCount     = 1u << kSubBucketBits;
+  static constexpr uint32_t kHalfSubBucketCount = kSubBucketCount / 2;
+  static constexpr uint32_t kMaxExponent        = 20;  // up to ~268 s
+  static constexpr uint32_t kBucketCount        = kSubBucketCount + kMaxExponent * kHalfSubBucketCount;
+  static constexpr uint64_t kMaxValue           = (uint64_t(kSubBucketCount) << kMaxExponent) - 1;
+
+  void add(uint64_t value);
+
+  // the value must have been added before
+  void remove(uint64_t value);
+
+  void clear();
+
+  uint64_t getCount() const { return m_count_; }
+
+  // smallest bucket bound with at least percentile (0-100) percent of the values at or below it, 0 if empty
+  uint64_t getPercentile(double percentile) const;
+
+  // counts of the values in [i * binWidth, (i + 1) * binWidth), the last bin also counts the larger values
+  void getDistribution(uint64_t binWidth, std::span<float> bins) const;
+
+  static uint32_t s_getBucketIndex(uint64_t value);
+
+  // largest value of the bucket
+  static uint64_t s_getBucketUpperBound(uint32_t index);
+
+  private:
+  std::array<uint32_t, kBucketCount> m_counts_{};
+  uint64_t                           m_count_ = 0;
+};
+
+// durations of one frame in microseconds
+struct FrameSample {
+  uint32_t                               frameTime = 0;
+  std::array<uint32_t, kFramePhaseCount> phaseTimes{};
+};
+
+/**
+ * Frame time and phase time statistics over sliding windows of the last kShortWindow and kLongWindow frames
+ * (percentiles from FrameTimeHistogram, exact maximum), and a hitch detector.
+ *
+ * A frame whose time exceeds both the minimum hitch time and hitchMedianFactor times the median of the short window
+ * is a hitch. The last kHitchCaptureFrames frame samples (and the zones of the built-in CPU profiler, if enabled) are
+ * then written to the hitches directory of the debug path, at most once per kHitchCooldownFrames frames and
+ * kMaxHitchCaptures times per run. The capture is built in the hitch frame and written on a background thread, so
+ * the file writes don't add to the following frames.
+ *
+ * Used from the main thread only.
+ */
+class FrameStatistics {
+  public:
+  enum class Window : uint8_t {
+    Short,
+    Long,
+    Count
+  };
+
+  static constexpr size_t   kShortWindow         = 300;
+  static constexpr size_t   kLongWindow          = 3600;
+  static constexpr size_t   kHitchCaptureFrames  = 120;
+  static constexpr uint64_t kHitchCooldownFrames = 120;
+  static constexpr uint32_t kMaxHitchCaptures    = 32;
+
+  FrameStatistics();
+
+  // adds the time of a phase to the current frame (negative for the parent of a nested phase)
+  void addPhaseTime(FramePhase phase, int64_t microseconds);
+
+  // the current frame isn't recorded (e.g. the window is minimized and the loop sleeps)
+  void discardFrame() { m_discardFrame_ = true; }
+
+  // closes the current frame with its total time and starts the next one
+  void endFrame(uint64_t frameTime);
+
+  // number of frames in the window
+  size_t getFrameCount(Window window) const;
+
+  // percentile (0-100) in microseconds of the frame time, or of a phase
+  uint64_t getPercentile(Window window, double percentile) const;
+  uint64_t getPhasePercentile(Window window, FramePhase phase, double percentile) const;
+
+  // exact maximum in microseconds
+  uint64_t getMax(Window window) const;
+  uint64_t getPhaseMax(Window window, FramePhase phase) const;
+
+  const FrameTimeHistogram& getHistogram(Window window) const;
+
+  void  setHitchMinimumTime(float milliseconds) { m_hitchMinimumTime_ = milliseconds; }
+  float getHitchMinimumTime() const { return m_hitchMinimumTime_; }
+
+  void  setHitchMedianFactor(float factor) { m_hitchMedianFactor_ = factor; }
+  float getHitchMedianFactor() const { return m_hitchMedianFactor_; }
+
+  uint32_t getHitchCount() const { return m_hitchCount_; }
+
+  // file of the last written capture, empty if none was written yet
+  const std::filesystem::path& getLastHitchCapture() const { return m_lastHitchCapture_; }
+
+  private:
+  // frame time and the phases
+  static constexpr size_t kMetricCount = 1 + kFramePhaseCount;
+
+  struct Metric {
+    FrameTimeHistogram histogram;
+    mutable uint64_t   max      = 0;
+    mutable bool       maxDirty = false;  // the maximum was evicted, recomputed on the next query
+  };
+
+  struct WindowState {
+    size_t                           size = 0;
+    std::array<Metric, kMetricCount> metrics;
+  };
+
+  static uint32_t s_getMetricValue(const FrameSample& sample, size_t metric);
+
+  const FrameSample& getSample_(uint64_t frame) const { return m_history_[frame % m_history_.size()]; }
+
+  uint64_t getMax_(Window window, size_t metric) const;
+
+  bool isHitch_(uint64_t frameTime) const;
+
+  // builds the capture of the last frames and starts writing it to the hitches directory
+  void captureHitch_(uint64_t frame);
+
+  // picks up the result of a finished capture write
+  void pollHitchWrite_();
+
+  // runs on the background thread, returns the path of the capture or an empty path on failure
+  static std::filesystem::path s_writeHitchCapture_(const std::filesystem::path& directory,
+                                                    uint64_t                     frame,
+                                                    const std::string&           capture,
+                                                    const std::string&           trace);
+
+  std::array<int64_t, kFramePhaseCount> m_phaseTimes_{};  // of the current frame
+  bool                                  m_discardFrame_ = false;
+
+  std::vector<FrameSample> m_history_;  // circular, frame i is at i % kLongWindow
+  uint64_t                 m_frameCount_ = 0;
+
+  std::array<WindowState, static_cast<size_t>(Window::Count)> m_windows_;
+
+  float                 m_hitchMinimumTime_  = 33.3f;  // milliseconds
+  float                 m_hitchMedianFactor_ = 2.5f;
+  uint32_t              m_hitchCount_        = 0;
+  uint64_t              m_lastHitchFrame_    = 0;
+  std::filesystem::path m_lastHitchCapture_;
+
+  // write of the last capture, its destructor waits for the files on shutdown
+  std::future<std::filesystem::path> m_hitchWrite_;
+};
+
+/**
+ * Adds the time of its scope to a phase of the current frame in the FrameStatistics of the TimingManager. A phase
+ * opened inside another one is subtracted from the outer phase.
+ */
+class ScopedFramePhase {
+  public:
+  explicit ScopedFramePhase(FramePhase phase);
+  ~ScopedFramePhase();
+
+  ScopedFramePhase(const ScopedFramePhase&)            = delete;
+  ScopedFramePhase& operator=(const ScopedFramePhase&) = delete;
+
+  private:
+  FrameStatistics* m_statistics_ = nullptr;
+  FramePhase       m_phase_;
+  FramePhase       m_parentPhase_;  // FramePhase::Count at the top level
+  int64_t          m_begin_ = 0;
+
+  static inline FramePhase s_activePhase = FramePhase::Count;
+};
+
+}  // namespace arise
+
+#endif  // ARISE_FRAME_STATISTICS_H
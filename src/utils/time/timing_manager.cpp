@@ -15,6 +15,8 @@ void TimingManager::update() {
 
   m_cachedFrameTime_ = m_deltaTime_.elapsedTime<DeltaTime::DurationFloat<std::milli>>();
 
+  m_frameStatistics_.endFrame(m_deltaTime_.elapsedTime<DeltaTime::DurationMicro>());
+
   m_deltaTime_.reset();
   m_deltaTime_.start();
 }
@@ -1,6 +1,7 @@
 #ifndef ARISE_TIMING_MANAGER_H
 #define ARISE_TIMING_MANAGER_H
 
+#include "utils/time/frame_statistics.h"
 #include "utils/time/stopwatch.h"
 
 #include <chrono>
@@ -43,6 +44,13 @@ class TimingManager {
     return m_totalElapsedTime_.elapsedTime<ElapsedTime::DurationFloat<>>();
   }
 
+  /**
+   * Frame time percentiles, phase times and hitch detection over the recent frames.
+   * update() closes the frame of the statistics.
+   */
+  FrameStatistics&       getFrameStatistics() { return m_frameStatistics_; }
+  const FrameStatistics& getFrameStatistics() const { return m_frameStatistics_; }
+
   private:
   ElapsedTime m_totalElapsedTime_;
 
@@ -51,6 +59,8 @@ class TimingManager {
   float m_cachedDeltaTime_;
   float m_cachedFPS_;
   float m_cachedFrameTime_;
+
+  FrameStatistics m_frameStatistics_;
 };
 
 }  // namespace arise
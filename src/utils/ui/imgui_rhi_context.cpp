@@ -10,7 +10,9 @@
 #include "gfx/rhi/backends/vulkan/sampler_vk.h"
 #include "gfx/rhi/backends/vulkan/texture_vk.h"
 #include "profiler/profiler.h"
+#include "utils/frame_manager/frame_manager.h"
 #include "utils/logger/log.h"
+#include "utils/service/service_locator.h"
 
 #include <imgui_impl_dx12.h>
 #include <imgui_impl_sdl2.h>
@@ -173,7 +175,10 @@ void ImGuiRHIContext::endFrame(rhi::CommandBuffer*      cmdBuffer,
 
   ImGui::Render();
 
-  updateFrame(static_cast<uint64_t>(currentFrameIndex));
+  // the frame index cycles through the frames in flight, deletions need the monotonic frame count
+  if (auto frameManager = ServiceLocator::s_get<FrameManager>()) {
+    updateFrame(frameManager->getTotalFrameCount());
+  }
 
   GPU_ZONE_NC(cmdBuffer, "ImGui Render", color::ORANGE);
 
@@ -275,21 +280,10 @@ void ImGuiRHIContext::releaseTextureID(ImTextureID textureID) {
   }
 
   if (m_renderingApi == rhi::RenderingApi::Vulkan) {
-    auto deviceVk = static_cast<rhi::DeviceVk*>(m_device);
-
-    VkDescriptorSet  set  = reinterpret_cast<VkDescriptorSet>(textureID);
-    VkDescriptorPool pool = m_imguiPoolManager->getPool();
+    const uint32_t frameDelay = m_framesInFlight + 1;
 
-    uint32_t frameDelay = m_framesInFlight + 1;
-
-    m_deletionManager.enqueueForDeletion<VkDescriptorSet>(
-        &set,
-        [deviceVk, pool](VkDescriptorSet* descriptorSet) {
-          vkFreeDescriptorSets(deviceVk->getDevice(), pool, 1, descriptorSet);
-        },
-        "ImGui_DescriptorSet_" + std::to_string(reinterpret_cast<uintptr_t>(set)),
-        "VkDescriptorSet",
-        frameDelay);
+    m_deletionManager.enqueueHandleForDeletion(
+        reinterpret_cast<uint64_t>(textureID), &ImGuiRHIContext::s_freeDescriptorSetsVk, this, frameDelay);
   }
 
   // For DirectX 12, we don't need to do anything special since we're
@@ -303,6 +297,22 @@ void ImGuiRHIContext::updateFrame(uint64_t currentFrame) {
   m_deletionManager.setCurrentFrame(currentFrame);
 }
 
+void ImGuiRHIContext::s_freeDescriptorSetsVk(void* context, std::span<const uint64_t> handles) {
+  auto imguiContext = static_cast<ImGuiRHIContext*>(context);
+  auto deviceVk     = static_cast<rhi::DeviceVk*>(imguiContext->m_device);
+
+  std::vector<VkDescriptorSet> descriptorSets;
+  descriptorSets.reserve(handles.size());
+  for (const uint64_t handle : handles) {
+    descriptorSets.push_back(reinterpret_cast<VkDescriptorSet>(handle));
+  }
+
+  vkFreeDescriptorSets(deviceVk->getDevice(),
+                       imguiContext->m_imguiPoolManager->getPool(),
+                       static_cast<uint32_t>(descriptorSets.size()),
+                       descriptorSets.data());
+}
+
 bool ImGuiRHIContext::initializeVulkan(rhi::Device* device, uint32_t swapChainBufferCount) {
   auto deviceVk     = static_cast<rhi::DeviceVk*>(device);
   auto renderPassVk = static_cast<rhi::RenderPassVk*>(m_renderPass.get());
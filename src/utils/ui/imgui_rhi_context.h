@@ -17,6 +17,7 @@
 #include <imgui.h>
 
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -52,6 +53,9 @@ class ImGuiRHIContext {
   void updateFrame(uint64_t currentFrame);
 
   private:
+  // ResourceDeletionManager::HandleBatchDeleter of the ImGui texture descriptor sets
+  static void s_freeDescriptorSetsVk(void* context, std::span<const uint64_t> handles);
+
   bool initializeVulkan(rhi::Device* device, uint32_t swapChainBufferCount);
   bool initializeDx12(rhi::Device* device, uint32_t swapChainBufferCount);
 